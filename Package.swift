@@ -38,18 +38,36 @@ let package = Package(
                 .brew(["ibm-messaging/ibmmq/ibmmq"])
             ]
         ),
+        // In-process MQI simulator the stub MQI functions forward to when the
+        // IBM MQ Client is not installed; inert with the real client
+        .target(
+            name: "CMQCSimulator",
+            path: "Sources/CMQCSimulator"
+        ),
+        // Process-wide heap allocation counter for the benchmarks
+        .target(
+            name: "CAllocationCounter",
+            path: "Sources/CAllocationCounter"
+        ),
         // Main executable target
         .executableTarget(
             name: "MQMate",
-            dependencies: ["CMQC"],
+            dependencies: ["CMQC", "CMQCSimulator"],
             path: "Sources/MQMate",
             linkerSettings: linkerSettings
         ),
         // Test target
         .testTarget(
             name: "MQMateTests",
-            dependencies: ["MQMate"],
+            dependencies: ["MQMate", "CMQC", "CMQCSimulator"],
             path: "Tests/MQMateTests"
+        ),
+        // Benchmarks of the MQService hot paths against the simulator or a queue manager
+        // Run: MQMATE_BENCHMARK=1 swift test -c release --filter MQMateBenchmarks
+        .testTarget(
+            name: "MQMateBenchmarks",
+            dependencies: ["MQMate", "CMQC", "CMQCSimulator", "CAllocationCounter"],
+            path: "Tests/MQMateBenchmarks"
         )
     ]
 )
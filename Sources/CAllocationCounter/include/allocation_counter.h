@@ -0,0 +1,22 @@
+// Allocation Counter
+// Counts heap allocations made by the whole process, for the benchmarks'
+// allocations-per-message figures. On macOS it hooks malloc_logger, the
+// callback libmalloc invokes on every allocation for Instruments; other
+// platforms report the counter as unavailable.
+
+#ifndef MQMATE_ALLOCATION_COUNTER_H
+#define MQMATE_ALLOCATION_COUNTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Start counting; returns false where allocations cannot be counted
+bool mqmate_allocation_counter_start(void);
+
+// Stop counting and restore any logger that was installed before
+void mqmate_allocation_counter_stop(void);
+
+// Allocations (malloc, calloc, realloc and friends) since the counter started
+uint64_t mqmate_allocation_count(void);
+
+#endif
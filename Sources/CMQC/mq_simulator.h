@@ -0,0 +1,130 @@
+// In-Process MQI Simulator
+// A queue manager simulated in memory, which the stub MQI functions of
+// mq_stubs.h forward to when the IBM MQ client is not installed. It runs the
+// real marshalling, PCF and browse code of MQMate without a queue manager,
+// for tests and benchmarks on machines without /opt/mqm.
+//
+// The simulator is off until enabled: every MQCONNX then fails with
+// MQRC_Q_MGR_NOT_AVAILABLE, as the stubs always did. Enable it with
+// mqmate_sim_enable(), or set MQMATE_SIMULATOR=1 in the environment (and
+// optionally MQMATE_SIMULATOR_LATENCY_US) to run the app against it.
+//
+// Simulated:
+//   - Local, model, alias and remote queues; temporary dynamic queues from
+//     model queues, deleted when closed
+//   - MQGET: destructive get, BROWSE_FIRST/NEXT/MSG_UNDER_CURSOR, matching on
+//     MsgId, CorrelId and MsgToken, truncation, WAIT
+//   - MQPUT: generated MsgIds, context, MAXDEPTH, inhibited queues, async
+//     put responses collected by MQSTAT
+//   - Units of work: MQGMO/MQPMO_SYNCPOINT, MQCMIT, MQBACK; MQDISC commits
+//   - MQINQ of the queue attributes MQMate reads
+//   - A command server on SYSTEM.ADMIN.COMMAND.QUEUE answering INQUIRE_Q,
+//     INQUIRE_Q_STATUS, CREATE_Q, CHANGE_Q, DELETE_Q and CLEAR_Q with real
+//     PCF response messages
+//   - MQCB/MQCTL message consumers, called on a delivery thread per connection
+//   - A fixed round-trip latency plus deterministic jitter on every call,
+//     as a client channel over a WAN would add
+//
+// Not simulated: priority order (messages are delivered FIFO), expiry, data
+// conversion, message properties, groups and segmentation, authorisation.
+// Any queue manager name connects to the one simulated queue manager.
+//
+// Requires the MQI types: included by mq_stubs.h before the stub functions.
+// With the real client the functions exist but the simulator cannot be
+// enabled, since MQI calls go to the client library.
+
+#ifndef MQ_SIMULATOR_H
+#define MQ_SIMULATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// MARK: - Call Counters
+
+// Verbs counted by mqmate_sim_call_count()
+#define MQMATE_SIM_CALL_ALL 0
+#define MQMATE_SIM_CALL_CONNX 1
+#define MQMATE_SIM_CALL_DISC 2
+#define MQMATE_SIM_CALL_OPEN 3
+#define MQMATE_SIM_CALL_CLOSE 4
+#define MQMATE_SIM_CALL_GET 5
+#define MQMATE_SIM_CALL_PUT 6
+#define MQMATE_SIM_CALL_INQ 7
+#define MQMATE_SIM_CALL_CMIT 8
+#define MQMATE_SIM_CALL_BACK 9
+#define MQMATE_SIM_CALL_STAT 10
+#define MQMATE_SIM_CALL_CB 11
+#define MQMATE_SIM_CALL_CTL 12
+#define MQMATE_SIM_CALL_COUNT 13
+
+// MARK: - Configuration
+
+// Start a fresh simulated queue manager: no connections, the SYSTEM queues
+// MQMate uses (command, model and dead-letter queues) and nothing else.
+// Returns false if MQI calls go to the real client instead
+bool mqmate_sim_enable(const char *queueManagerName);
+
+// Stop the simulator and free every queue and message; calls on existing
+// connections then fail with MQRC_Q_MGR_NOT_AVAILABLE, and a get waiting at
+// the time with MQRC_CONNECTION_BROKEN
+void mqmate_sim_disable(void);
+
+// Whether MQI calls are currently answered by the simulator
+bool mqmate_sim_is_enabled(void);
+
+// Round-trip latency added to every MQI call, in microseconds, plus up to
+// jitterMicroseconds more from a generator seeded by mqmate_sim_enable(), so
+// runs are reproducible. Puts with MQPMO_ASYNC_RESPONSE add none
+void mqmate_sim_set_latency(MQLONG roundTripMicroseconds, MQLONG jitterMicroseconds);
+
+// Stop or restart the command server; requests put while it is stopped stay
+// on the command queue unanswered, as with a queue manager whose command
+// server is not running. mqmate_sim_enable() starts it
+void mqmate_sim_set_command_server_running(bool running);
+
+// MARK: - Queue Setup
+// Direct access to the simulated queue manager, without latency and outside
+// any connection, for setting up test and benchmark scenarios
+
+// Define a queue; maxDepth 0 uses the default of 5000.
+// Returns MQRC_NONE or the reason the command server would report
+MQLONG mqmate_sim_define_queue(const char *queueName, MQLONG queueType, MQLONG maxDepth);
+
+// Put count copies of a payload as datagrams, each with its own MsgId; a
+// NULL format puts them as MQSTR. Returns MQRC_NONE or the reason of the
+// first failed put
+MQLONG mqmate_sim_put_messages(const char *queueName, MQLONG count, const void *payload, MQLONG length, const char *format);
+
+// Set MQIA_INHIBIT_GET and MQIA_INHIBIT_PUT of a queue
+MQLONG mqmate_sim_set_inhibited(const char *queueName, bool getInhibited, bool putInhibited);
+
+// Number of messages on a queue, counting uncommitted ones; -1 if it does not exist
+MQLONG mqmate_sim_queue_depth(const char *queueName);
+
+// MQI calls answered since the simulator was enabled, for one MQMATE_SIM_CALL_* verb or all
+uint64_t mqmate_sim_call_count(MQLONG call);
+
+// MQGMO Options of the last MQGET that reached the queue; 0 before the first one
+MQLONG mqmate_sim_last_get_options(void);
+
+// MARK: - MQI Entry Points
+// Called by the stub MQI functions
+
+void mqmate_sim_connx(MQCHAR *QMgrName, MQCNO *pConnectOpts, MQHCONN *pHconn, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_disc(MQHCONN *pHconn, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_open(MQHCONN Hconn, MQOD *pObjDesc, MQLONG Options, MQHOBJ *pHobj, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_close(MQHCONN Hconn, MQHOBJ *pHobj, MQLONG Options, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_get(MQHCONN Hconn, MQHOBJ Hobj, MQMD *pMsgDesc, MQGMO *pGetMsgOpts, MQLONG BufferLength,
+                    void *pBuffer, MQLONG *pDataLength, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_put(MQHCONN Hconn, MQHOBJ Hobj, MQMD *pMsgDesc, MQPMO *pPutMsgOpts, MQLONG BufferLength,
+                    void *pBuffer, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_inq(MQHCONN Hconn, MQHOBJ Hobj, MQLONG SelectorCount, MQLONG *pSelectors, MQLONG IntAttrCount,
+                    MQLONG *pIntAttrs, MQLONG CharAttrLength, MQCHAR *pCharAttrs, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_cmit(MQHCONN Hconn, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_back(MQHCONN Hconn, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_stat(MQHCONN Hconn, MQLONG Type, MQSTS *pStatus, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_cb(MQHCONN Hconn, MQLONG Operation, MQCBD *pCallbackDesc, MQHOBJ Hobj, MQMD *pMsgDesc,
+                   MQGMO *pGetMsgOpts, MQLONG *pCompCode, MQLONG *pReason);
+void mqmate_sim_ctl(MQHCONN Hconn, MQLONG Operation, MQCTLO *pControlOpts, MQLONG *pCompCode, MQLONG *pReason);
+
+#endif
@@ -6,6 +6,7 @@
 #ifndef MQ_STUBS_H
 #define MQ_STUBS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 // MARK: - Basic MQ Types
@@ -45,6 +46,7 @@ typedef MQLONG MQHOBJ;
 #define MQRC_GET_INHIBITED 2016
 #define MQRC_OBJECT_IN_USE 2042
 #define MQRC_OBJECT_CHANGED 2041
+#define MQRC_UNKNOWN_OBJECT_NAME 2085
 
 // MARK: - Field Length Constants
 
@@ -54,6 +56,7 @@ typedef MQLONG MQHOBJ;
 #define MQ_CONN_NAME_LENGTH 264
 #define MQ_MSG_ID_LENGTH 24
 #define MQ_CORREL_ID_LENGTH 24
+#define MQ_MSG_TOKEN_LENGTH 16
 #define MQ_FORMAT_LENGTH 8
 #define MQ_PUT_APPL_NAME_LENGTH 28
 #define MQ_PUT_DATE_LENGTH 8
@@ -75,13 +78,22 @@ typedef MQLONG MQHOBJ;
 
 // MARK: - Open Options
 
+#define MQOO_INPUT_AS_Q_DEF 1
 #define MQOO_INPUT_SHARED 2
 #define MQOO_INPUT_EXCLUSIVE 4
 #define MQOO_BROWSE 8
 #define MQOO_OUTPUT 16
 #define MQOO_INQUIRE 32
 #define MQOO_SET 64
+#define MQOO_SAVE_ALL_CONTEXT 128
+#define MQOO_PASS_IDENTITY_CONTEXT 256
+#define MQOO_PASS_ALL_CONTEXT 512
+#define MQOO_SET_IDENTITY_CONTEXT 1024
+#define MQOO_SET_ALL_CONTEXT 2048
 #define MQOO_FAIL_IF_QUIESCING 8192
+#define MQOO_READ_AHEAD_AS_Q_DEF 0
+#define MQOO_NO_READ_AHEAD 524288
+#define MQOO_READ_AHEAD 1048576
 
 // MARK: - Close Options
 
@@ -98,6 +110,7 @@ typedef MQLONG MQHOBJ;
 #define MQGMO_BROWSE_FIRST 16
 #define MQGMO_BROWSE_NEXT 32
 #define MQGMO_ACCEPT_TRUNCATED_MSG 64
+#define MQGMO_BROWSE_MSG_UNDER_CURSOR 2048
 #define MQGMO_FAIL_IF_QUIESCING 8192
 #define MQGMO_CONVERT 16384
 
@@ -107,12 +120,22 @@ typedef MQLONG MQHOBJ;
 #define MQPMO_NO_SYNCPOINT 4
 #define MQPMO_NEW_MSG_ID 64
 #define MQPMO_NEW_CORREL_ID 128
+#define MQPMO_PASS_IDENTITY_CONTEXT 256
+#define MQPMO_PASS_ALL_CONTEXT 512
+#define MQPMO_SET_IDENTITY_CONTEXT 1024
+#define MQPMO_SET_ALL_CONTEXT 2048
+#define MQPMO_DEFAULT_CONTEXT 32
+#define MQPMO_FAIL_IF_QUIESCING 8192
+#define MQPMO_RESPONSE_AS_Q_DEF 0
+#define MQPMO_ASYNC_RESPONSE 65536
+#define MQPMO_SYNC_RESPONSE 131072
 
 // MARK: - Match Options
 
 #define MQMO_NONE 0
 #define MQMO_MATCH_MSG_ID 1
 #define MQMO_MATCH_CORREL_ID 2
+#define MQMO_MATCH_MSG_TOKEN 32
 
 // MARK: - Message Types
 
@@ -147,6 +170,10 @@ typedef MQLONG MQHOBJ;
 
 #define MQOD_VERSION_4 4
 
+// MARK: - Variable-Length Strings
+
+#define MQVS_NUL_TERMINATED (-1)
+
 // MARK: - Message Descriptor
 
 #define MQMD_VERSION_2 2
@@ -154,11 +181,49 @@ typedef MQLONG MQHOBJ;
 // MARK: - Get Message Options Version
 
 #define MQGMO_VERSION_2 2
+#define MQGMO_VERSION_3 3
 
 // MARK: - Put Message Options Version
 
 #define MQPMO_VERSION_2 2
 
+// MARK: - Status Information
+
+#define MQSTS_VERSION_1 1
+#define MQSTAT_TYPE_ASYNC_ERROR 0
+
+// MARK: - Asynchronous Consume
+
+#define MQCBD_VERSION_1 1
+#define MQCTLO_VERSION_1 1
+#define MQCBD_FULL_MSG_LENGTH (-1)
+#define MQWI_UNLIMITED (-1)
+
+#define MQOP_START 1
+#define MQOP_START_WAIT 2
+#define MQOP_STOP 4
+#define MQOP_REGISTER 256
+#define MQOP_DEREGISTER 512
+#define MQOP_SUSPEND 65536
+#define MQOP_RESUME 131072
+
+#define MQCBT_MESSAGE_CONSUMER 1
+#define MQCBT_EVENT_HANDLER 2
+
+#define MQCBDO_NONE 0
+#define MQCBDO_FAIL_IF_QUIESCING 8192
+
+#define MQCTLO_NONE 0
+#define MQCTLO_FAIL_IF_QUIESCING 8192
+
+#define MQCBCT_START_CALL 1
+#define MQCBCT_STOP_CALL 2
+#define MQCBCT_REGISTER_CALL 3
+#define MQCBCT_DEREGISTER_CALL 4
+#define MQCBCT_EVENT_CALL 5
+#define MQCBCT_MSG_REMOVED 6
+#define MQCBCT_MSG_NOT_REMOVED 7
+
 // MARK: - Queue Attribute Selectors (Integer)
 
 #define MQIA_Q_TYPE 20
@@ -166,7 +231,7 @@ typedef MQLONG MQHOBJ;
 #define MQIA_MAX_Q_DEPTH 15
 #define MQIA_OPEN_INPUT_COUNT 17
 #define MQIA_OPEN_OUTPUT_COUNT 18
-#define MQIA_INHIBIT_GET 8
+#define MQIA_INHIBIT_GET 9
 #define MQIA_INHIBIT_PUT 10
 
 // MARK: - Queue Attribute Selectors (Character)
@@ -183,6 +248,7 @@ typedef MQLONG MQHOBJ;
 // MARK: - Coded Character Set
 
 #define MQCCSI_DEFAULT 0
+#define MQCCSI_APPL (-3)
 
 // MARK: - PCF Constants
 
@@ -198,6 +264,8 @@ typedef MQLONG MQHOBJ;
 
 #define MQCFIN_STRUC_LENGTH 16
 #define MQCFST_STRUC_LENGTH_FIXED 20
+#define MQCFIL_STRUC_LENGTH_FIXED 16
+#define MQCFSL_STRUC_LENGTH_FIXED 24
 
 #define MQCFC_LAST 1
 #define MQCFC_NOT_LAST 0
@@ -206,6 +274,16 @@ typedef MQLONG MQHOBJ;
 #define MQCMD_CREATE_Q 5
 #define MQCMD_DELETE_Q 6
 #define MQCMD_CHANGE_Q 8
+#define MQCMD_CLEAR_Q 9
+#define MQCMD_INQUIRE_Q_STATUS 41
+
+// MARK: - PCF Parameter Identifiers
+
+#define MQIACF_Q_ATTRS 1002
+#define MQIACF_ALL 1009
+#define MQIACF_Q_STATUS_ATTRS 1026
+#define MQIACF_Q_STATUS_TYPE 1103
+#define MQIACF_Q_STATUS 1105
 
 // MARK: - Additional Reason Codes
 
@@ -342,6 +420,15 @@ typedef struct tagMQCSP {
 } MQCSP;
 
 // Object Descriptor (MQOD)
+// Variable-length string (MQCHARV)
+typedef struct tagMQCHARV {
+    void* VSPtr;
+    MQLONG VSOffset;
+    MQLONG VSBufSize;
+    MQLONG VSLength;
+    MQLONG VSCCSID;
+} MQCHARV;
+
 typedef struct tagMQOD {
     MQCHAR StrucId[4];
     MQLONG Version;
@@ -361,9 +448,9 @@ typedef struct tagMQOD {
     MQBYTE AlternateSecurityId[40];
     MQCHAR ResolvedQName[48];
     MQCHAR ResolvedQMgrName[48];
-    MQCHAR ObjectString[256];
-    MQCHAR SelectionString[256];
-    MQCHAR ResObjectString[256];
+    MQCHARV ObjectString;
+    MQCHARV SelectionString;
+    MQCHARV ResObjectString;
     MQLONG ResolvedType;
 } MQOD;
 
@@ -444,6 +531,60 @@ typedef struct tagMQPMO {
     MQLONG PubLevel;
 } MQPMO;
 
+// Status Information (MQSTS), version 1 fields
+typedef struct tagMQSTS {
+    MQCHAR StrucId[4];
+    MQLONG Version;
+    MQLONG CompCode;
+    MQLONG Reason;
+    MQLONG PutSuccessCount;
+    MQLONG PutWarningCount;
+    MQLONG PutFailureCount;
+    MQLONG ObjectType;
+    MQCHAR ObjectName[48];
+    MQCHAR ObjectQMgrName[48];
+    MQCHAR ResolvedObjectName[48];
+    MQCHAR ResolvedQMgrName[48];
+} MQSTS;
+
+// Callback Descriptor (MQCBD)
+typedef struct tagMQCBD {
+    MQCHAR StrucId[4];
+    MQLONG Version;
+    MQLONG CallbackType;
+    MQLONG Options;
+    void* CallbackArea;
+    void* CallbackFunction;
+    MQCHAR CallbackName[128];
+    MQLONG MaxMsgLength;
+} MQCBD;
+
+// Callback Context (MQCBC), passed to every callback invocation
+typedef struct tagMQCBC {
+    MQCHAR StrucId[4];
+    MQLONG Version;
+    MQLONG CallType;
+    MQHOBJ Hobj;
+    void* CallbackArea;
+    void* ConnectionArea;
+    MQLONG CompCode;
+    MQLONG Reason;
+    MQLONG State;
+    MQLONG DataLength;
+    MQLONG BufferLength;
+    MQLONG Flags;
+    MQLONG ReconnectDelay;
+} MQCBC;
+
+// Control Options (MQCTLO)
+typedef struct tagMQCTLO {
+    MQCHAR StrucId[4];
+    MQLONG Version;
+    MQLONG Options;
+    MQLONG Reserved;
+    void* ConnectionArea;
+} MQCTLO;
+
 // PCF Header (MQCFH)
 typedef struct tagMQCFH {
     MQLONG Type;
@@ -475,9 +616,98 @@ typedef struct tagMQCFST {
     MQCHAR String[1];
 } MQCFST;
 
+// PCF Integer List Parameter (MQCFIL)
+typedef struct tagMQCFIL {
+    MQLONG Type;
+    MQLONG StrucLength;
+    MQLONG Parameter;
+    MQLONG Count;
+    MQLONG Values[1];
+} MQCFIL;
+
+// PCF String List Parameter (MQCFSL)
+typedef struct tagMQCFSL {
+    MQLONG Type;
+    MQLONG StrucLength;
+    MQLONG Parameter;
+    MQLONG CodedCharSetId;
+    MQLONG Count;
+    MQLONG StringLength;
+    MQCHAR Strings[1];
+} MQCFSL;
+
 // MARK: - MQ API Function Declarations (Stubs)
 
+// MARK: - Structure Defaults
+// Initial values of the MQI structures, as defined by cmqc.h
+
+#define MQMD_STRUC_ID_ARRAY 'M','D',' ',' '
+#define MQGMO_STRUC_ID_ARRAY 'G','M','O',' '
+#define MQPMO_STRUC_ID_ARRAY 'P','M','O',' '
+#define MQOD_STRUC_ID_ARRAY 'O','D',' ',' '
+#define MQSTS_STRUC_ID_ARRAY 'S','T','A','T'
+
+#define MQMD_VERSION_1 1
+#define MQGMO_VERSION_1 1
+#define MQPMO_VERSION_1 1
+#define MQOD_VERSION_1 1
+
+#define MQRO_NONE 0
+#define MQFB_NONE 0
+#define MQEI_UNLIMITED (-1)
+#define MQENC_NATIVE 0x00000222
+#define MQCCSI_Q_MGR 0
+#define MQFMT_NONE_ARRAY ' ',' ',' ',' ',' ',' ',' ',' '
+#define MQPRI_PRIORITY_AS_Q_DEF (-1)
+#define MQMI_NONE_ARRAY '\0'
+#define MQCI_NONE_ARRAY '\0'
+#define MQACT_NONE_ARRAY '\0'
+#define MQGI_NONE_ARRAY '\0'
+#define MQMTOK_NONE_ARRAY '\0'
+#define MQSID_NONE_ARRAY '\0'
+#define MQAT_NO_CONTEXT 0
+#define MQMF_NONE 0
+#define MQOL_UNDEFINED (-1)
+#define MQGS_NOT_IN_GROUP ' '
+#define MQSS_NOT_A_SEGMENT ' '
+#define MQSEG_INHIBITED ' '
+#define MQRL_UNDEFINED (-1)
+#define MQHM_NONE 0
+#define MQPMO_NONE 0
+#define MQACTP_NEW 0
+#define MQOT_NONE 0
+
+#define MQCHARV_DEFAULT NULL, 0, 0, 0, MQCCSI_APPL
+
+#define MQMD_DEFAULT {MQMD_STRUC_ID_ARRAY}, MQMD_VERSION_1, MQRO_NONE, \
+    MQMT_DATAGRAM, MQEI_UNLIMITED, MQFB_NONE, MQENC_NATIVE, MQCCSI_Q_MGR, \
+    {MQFMT_NONE_ARRAY}, MQPRI_PRIORITY_AS_Q_DEF, MQPER_PERSISTENCE_AS_Q_DEF, \
+    {MQMI_NONE_ARRAY}, {MQCI_NONE_ARRAY}, 0, {""}, {""}, {""}, \
+    {MQACT_NONE_ARRAY}, {""}, MQAT_NO_CONTEXT, {""}, {""}, {""}, {""}, \
+    {MQGI_NONE_ARRAY}, 1, 0, MQMF_NONE, MQOL_UNDEFINED
+
+#define MQGMO_DEFAULT {MQGMO_STRUC_ID_ARRAY}, MQGMO_VERSION_1, MQGMO_NO_WAIT, \
+    0, 0, 0, {""}, (MQMO_MATCH_MSG_ID | MQMO_MATCH_CORREL_ID), \
+    MQGS_NOT_IN_GROUP, MQSS_NOT_A_SEGMENT, MQSEG_INHIBITED, ' ', \
+    {MQMTOK_NONE_ARRAY}, MQRL_UNDEFINED, 0, MQHM_NONE
+
+#define MQPMO_DEFAULT {MQPMO_STRUC_ID_ARRAY}, MQPMO_VERSION_1, MQPMO_NONE, \
+    (-1), 0, 0, 0, 0, {""}, {""}, 0, 0, 0, 0, NULL, NULL, \
+    MQHM_NONE, MQHM_NONE, MQACTP_NEW, 9
+
+#define MQOD_DEFAULT {MQOD_STRUC_ID_ARRAY}, MQOD_VERSION_1, MQOT_Q, \
+    {""}, {""}, {"AMQ.*"}, {""}, 0, 0, 0, 0, 0, 0, NULL, NULL, \
+    {MQSID_NONE_ARRAY}, {""}, {""}, {MQCHARV_DEFAULT}, {MQCHARV_DEFAULT}, \
+    {MQCHARV_DEFAULT}, MQOT_NONE
+
+#define MQSTS_DEFAULT {MQSTS_STRUC_ID_ARRAY}, MQSTS_VERSION_1, MQCC_OK, \
+    MQRC_NONE, 0, 0, 0, MQOT_NONE, {""}, {""}, {""}, {""}
+
 // Note: These are stub declarations. The real implementations come from the MQ client library.
+// Without it, every call is answered by the in-process simulator, which fails
+// with MQRC_Q_MGR_NOT_AVAILABLE unless it has been enabled
+
+#include "mq_simulator.h"
 
 static inline void MQCONNX(
     MQCHAR* QMgrName,
@@ -486,10 +716,7 @@ static inline void MQCONNX(
     MQLONG* pCompCode,
     MQLONG* pReason
 ) {
-    // Stub implementation - always fail with "not available"
-    *pHconn = MQHC_UNUSABLE_HCONN;
-    *pCompCode = MQCC_FAILED;
-    *pReason = MQRC_Q_MGR_NOT_AVAILABLE;
+    mqmate_sim_connx(QMgrName, pConnectOpts, pHconn, pCompCode, pReason);
 }
 
 static inline void MQDISC(
@@ -497,10 +724,7 @@ static inline void MQDISC(
     MQLONG* pCompCode,
     MQLONG* pReason
 ) {
-    // Stub implementation
-    *pHconn = MQHC_UNUSABLE_HCONN;
-    *pCompCode = MQCC_OK;
-    *pReason = MQRC_NONE;
+    mqmate_sim_disc(pHconn, pCompCode, pReason);
 }
 
 static inline void MQOPEN(
@@ -511,10 +735,7 @@ static inline void MQOPEN(
     MQLONG* pCompCode,
     MQLONG* pReason
 ) {
-    // Stub implementation
-    *pHobj = MQHO_UNUSABLE_HOBJ;
-    *pCompCode = MQCC_FAILED;
-    *pReason = MQRC_Q_MGR_NOT_AVAILABLE;
+    mqmate_sim_open(Hconn, pObjDesc, Options, pHobj, pCompCode, pReason);
 }
 
 static inline void MQCLOSE(
@@ -524,10 +745,7 @@ static inline void MQCLOSE(
     MQLONG* pCompCode,
     MQLONG* pReason
 ) {
-    // Stub implementation
-    *pHobj = MQHO_UNUSABLE_HOBJ;
-    *pCompCode = MQCC_OK;
-    *pReason = MQRC_NONE;
+    mqmate_sim_close(Hconn, pHobj, Options, pCompCode, pReason);
 }
 
 static inline void MQGET(
@@ -541,10 +759,7 @@ static inline void MQGET(
     MQLONG* pCompCode,
     MQLONG* pReason
 ) {
-    // Stub implementation
-    *pDataLength = 0;
-    *pCompCode = MQCC_FAILED;
-    *pReason = MQRC_Q_MGR_NOT_AVAILABLE;
+    mqmate_sim_get(Hconn, Hobj, pMsgDesc, pGetMsgOpts, BufferLength, pBuffer, pDataLength, pCompCode, pReason);
 }
 
 static inline void MQPUT(
@@ -557,9 +772,7 @@ static inline void MQPUT(
     MQLONG* pCompCode,
     MQLONG* pReason
 ) {
-    // Stub implementation
-    *pCompCode = MQCC_FAILED;
-    *pReason = MQRC_Q_MGR_NOT_AVAILABLE;
+    mqmate_sim_put(Hconn, Hobj, pMsgDesc, pPutMsgOpts, BufferLength, pBuffer, pCompCode, pReason);
 }
 
 static inline void MQINQ(
@@ -574,9 +787,57 @@ static inline void MQINQ(
     MQLONG* pCompCode,
     MQLONG* pReason
 ) {
-    // Stub implementation
-    *pCompCode = MQCC_FAILED;
-    *pReason = MQRC_Q_MGR_NOT_AVAILABLE;
+    mqmate_sim_inq(Hconn, Hobj, SelectorCount, pSelectors, IntAttrCount, pIntAttrs,
+                   CharAttrLength, pCharAttrs, pCompCode, pReason);
+}
+
+static inline void MQCMIT(
+    MQHCONN Hconn,
+    MQLONG* pCompCode,
+    MQLONG* pReason
+) {
+    mqmate_sim_cmit(Hconn, pCompCode, pReason);
+}
+
+static inline void MQBACK(
+    MQHCONN Hconn,
+    MQLONG* pCompCode,
+    MQLONG* pReason
+) {
+    mqmate_sim_back(Hconn, pCompCode, pReason);
+}
+
+static inline void MQSTAT(
+    MQHCONN Hconn,
+    MQLONG Type,
+    MQSTS* pStatus,
+    MQLONG* pCompCode,
+    MQLONG* pReason
+) {
+    mqmate_sim_stat(Hconn, Type, pStatus, pCompCode, pReason);
+}
+
+static inline void MQCB(
+    MQHCONN Hconn,
+    MQLONG Operation,
+    MQCBD* pCallbackDesc,
+    MQHOBJ Hobj,
+    MQMD* pMsgDesc,
+    MQGMO* pGetMsgOpts,
+    MQLONG* pCompCode,
+    MQLONG* pReason
+) {
+    mqmate_sim_cb(Hconn, Operation, pCallbackDesc, Hobj, pMsgDesc, pGetMsgOpts, pCompCode, pReason);
+}
+
+static inline void MQCTL(
+    MQHCONN Hconn,
+    MQLONG Operation,
+    MQCTLO* pControlOpts,
+    MQLONG* pCompCode,
+    MQLONG* pReason
+) {
+    mqmate_sim_ctl(Hconn, Operation, pControlOpts, pCompCode, pReason);
 }
 
 #endif /* MQ_STUBS_H */
@@ -0,0 +1,74 @@
+// MQI Structure Marshalling
+// Default-initialised MQI structures and bulk copies in and out of their
+// fixed-length fields. Swift imports those fields as tuples, which it can
+// only fill or read element by element; these helpers do each field with one
+// memcpy/memset and no temporary arrays
+
+#ifndef MQMATE_MARSHAL_H
+#define MQMATE_MARSHAL_H
+
+#include <stddef.h>
+#include <string.h>
+
+// MARK: - Default Structures
+// The MQxx_DEFAULT initialisers of cmqc.h, as values Swift can copy
+
+static inline MQMD mqmate_md_default(void) {
+    MQMD md = {MQMD_DEFAULT};
+    return md;
+}
+
+static inline MQGMO mqmate_gmo_default(void) {
+    MQGMO gmo = {MQGMO_DEFAULT};
+    return gmo;
+}
+
+static inline MQPMO mqmate_pmo_default(void) {
+    MQPMO pmo = {MQPMO_DEFAULT};
+    return pmo;
+}
+
+static inline MQOD mqmate_od_default(void) {
+    MQOD od = {MQOD_DEFAULT};
+    return od;
+}
+
+static inline MQSTS mqmate_sts_default(void) {
+    MQSTS sts = {MQSTS_DEFAULT};
+    return sts;
+}
+
+// MARK: - Character Fields
+
+// Copy a string into a character field, padding it with blanks; a longer
+// string is cut at the field length
+static inline void mqmate_set_chars(void *field, size_t fieldLength, const void *value, size_t valueLength) {
+    size_t copied = valueLength < fieldLength ? valueLength : fieldLength;
+    if (copied > 0) {
+        memcpy(field, value, copied);
+    }
+    memset((char *)field + copied, ' ', fieldLength - copied);
+}
+
+// Length of a character field without its trailing blanks and nulls
+static inline size_t mqmate_chars_length(const void *field, size_t fieldLength) {
+    const char *chars = (const char *)field;
+    while (fieldLength > 0 && (chars[fieldLength - 1] == ' ' || chars[fieldLength - 1] == '\0')) {
+        fieldLength--;
+    }
+    return fieldLength;
+}
+
+// MARK: - Byte Fields
+
+// Copy bytes into a byte field such as MsgId or CorrelId, padding it with
+// zeros; longer values are cut at the field length
+static inline void mqmate_set_bytes(void *field, size_t fieldLength, const void *value, size_t valueLength) {
+    size_t copied = valueLength < fieldLength ? valueLength : fieldLength;
+    if (copied > 0) {
+        memcpy(field, value, copied);
+    }
+    memset((unsigned char *)field + copied, 0, fieldLength - copied);
+}
+
+#endif
@@ -11,6 +11,7 @@
     // Real IBM MQ Client headers available
     #include "/opt/mqm/inc/cmqc.h"
     #include "/opt/mqm/inc/cmqxc.h"
+    #include "/opt/mqm/inc/cmqcfc.h"
     #define MQ_CLIENT_AVAILABLE 1
 #else
     // Use stub headers for development/compilation
@@ -18,4 +19,50 @@
     #define MQ_CLIENT_AVAILABLE 0
 #endif
 
+// Configuration of the in-process MQI simulator (already included with the stubs)
+#include "mq_simulator.h"
+
+// Default structures and fixed-length field copies for the MQI structures
+#include "mqmate_marshal.h"
+
+// Atomic operations on 64-bit counters for lock-free structures in Swift
+// (Swift 5.9 on macOS 14 has no standard atomics); compiler builtins keep
+// the counters plain uint64_t so Swift can allocate them
+#include <stdbool.h>
+#include <stdint.h>
+
+static inline uint64_t mqmate_atomic_load_relaxed(const uint64_t *value) {
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t mqmate_atomic_load_acquire(const uint64_t *value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static inline void mqmate_atomic_store_release(uint64_t *value, uint64_t desired) {
+    __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+}
+
+static inline uint64_t mqmate_atomic_exchange(uint64_t *value, uint64_t desired) {
+    return __atomic_exchange_n(value, desired, __ATOMIC_ACQ_REL);
+}
+
+// Weak compare-and-swap; on failure *expected is set to the current value
+static inline bool mqmate_atomic_compare_exchange(uint64_t *value, uint64_t *expected, uint64_t desired) {
+    return __atomic_compare_exchange_n(value, expected, desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+// Relaxed increment for statistics counters; returns the previous value
+static inline uint64_t mqmate_atomic_fetch_add(uint64_t *value, uint64_t delta) {
+    return __atomic_fetch_add(value, delta, __ATOMIC_RELAXED);
+}
+
+// Raise *value to at least candidate (relaxed); used for running maximums
+static inline void mqmate_atomic_store_max(uint64_t *value, uint64_t candidate) {
+    uint64_t current = __atomic_load_n(value, __ATOMIC_RELAXED);
+    while (current < candidate &&
+           !__atomic_compare_exchange_n(value, &current, candidate, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
 #endif
@@ -0,0 +1,2385 @@
+// In-Process MQI Simulator
+// Implementation of the simulated queue manager declared in CMQC's
+// mq_simulator.h. All state lives behind one mutex: the connection threads
+// of MQMate call in concurrently, as they would call the client library, and
+// the cost that matters for measurements is the injected latency, not lock
+// contention. MQGMO_WAIT and message consumers wait on one condition that is
+// broadcast whenever a message becomes available.
+
+// clock_gettime, nanosleep and gmtime_r are POSIX, not ISO C
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "../CMQC/shim.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !MQ_CLIENT_AVAILABLE
+
+// MARK: - Constants
+// Reason codes and values the stubs do not define, as in cmqc.h and cmqcfc.h
+
+#ifndef MQRC_BUFFER_ERROR
+#define MQRC_BUFFER_ERROR 2004
+#endif
+#ifndef MQRC_BUFFER_LENGTH_ERROR
+#define MQRC_BUFFER_LENGTH_ERROR 2005
+#endif
+#ifndef MQRC_CHAR_ATTR_LENGTH_ERROR
+#define MQRC_CHAR_ATTR_LENGTH_ERROR 2006
+#endif
+#ifndef MQRC_CHAR_ATTRS_TOO_SHORT
+#define MQRC_CHAR_ATTRS_TOO_SHORT 2008
+#endif
+#ifndef MQRC_DYNAMIC_Q_NAME_ERROR
+#define MQRC_DYNAMIC_Q_NAME_ERROR 2011
+#endif
+#ifndef MQRC_HANDLE_NOT_AVAILABLE
+#define MQRC_HANDLE_NOT_AVAILABLE 2017
+#endif
+#ifndef MQRC_HCONN_ERROR
+#define MQRC_HCONN_ERROR 2018
+#endif
+#ifndef MQRC_HOBJ_ERROR
+#define MQRC_HOBJ_ERROR 2019
+#endif
+#ifndef MQRC_INT_ATTR_COUNT_ERROR
+#define MQRC_INT_ATTR_COUNT_ERROR 2021
+#endif
+#ifndef MQRC_INT_ATTR_COUNT_TOO_SMALL
+#define MQRC_INT_ATTR_COUNT_TOO_SMALL 2022
+#endif
+#ifndef MQRC_MAX_CONNS_LIMIT_REACHED
+#define MQRC_MAX_CONNS_LIMIT_REACHED 2025
+#endif
+#ifndef MQRC_MD_ERROR
+#define MQRC_MD_ERROR 2026
+#endif
+#ifndef MQRC_MSG_TOO_BIG_FOR_Q
+#define MQRC_MSG_TOO_BIG_FOR_Q 2030
+#endif
+#ifndef MQRC_NO_MSG_UNDER_CURSOR
+#define MQRC_NO_MSG_UNDER_CURSOR 2034
+#endif
+#ifndef MQRC_NOT_OPEN_FOR_BROWSE
+#define MQRC_NOT_OPEN_FOR_BROWSE 2036
+#endif
+#ifndef MQRC_NOT_OPEN_FOR_INPUT
+#define MQRC_NOT_OPEN_FOR_INPUT 2037
+#endif
+#ifndef MQRC_NOT_OPEN_FOR_INQUIRE
+#define MQRC_NOT_OPEN_FOR_INQUIRE 2038
+#endif
+#ifndef MQRC_NOT_OPEN_FOR_OUTPUT
+#define MQRC_NOT_OPEN_FOR_OUTPUT 2039
+#endif
+#ifndef MQRC_OBJECT_TYPE_ERROR
+#define MQRC_OBJECT_TYPE_ERROR 2043
+#endif
+#ifndef MQRC_OD_ERROR
+#define MQRC_OD_ERROR 2044
+#endif
+#ifndef MQRC_OPTIONS_ERROR
+#define MQRC_OPTIONS_ERROR 2046
+#endif
+#ifndef MQRC_Q_DELETED
+#define MQRC_Q_DELETED 2052
+#endif
+#ifndef MQRC_Q_NOT_EMPTY
+#define MQRC_Q_NOT_EMPTY 2055
+#endif
+#ifndef MQRC_Q_TYPE_ERROR
+#define MQRC_Q_TYPE_ERROR 2057
+#endif
+#ifndef MQRC_SELECTOR_COUNT_ERROR
+#define MQRC_SELECTOR_COUNT_ERROR 2065
+#endif
+#ifndef MQRC_SELECTOR_ERROR
+#define MQRC_SELECTOR_ERROR 2067
+#endif
+#ifndef MQRC_SELECTOR_NOT_FOR_TYPE
+#define MQRC_SELECTOR_NOT_FOR_TYPE 2068
+#endif
+#ifndef MQRC_STORAGE_NOT_AVAILABLE
+#define MQRC_STORAGE_NOT_AVAILABLE 2071
+#endif
+#ifndef MQRC_UNKNOWN_ALIAS_BASE_Q
+#define MQRC_UNKNOWN_ALIAS_BASE_Q 2082
+#endif
+#ifndef MQRC_PMO_ERROR
+#define MQRC_PMO_ERROR 2173
+#endif
+#ifndef MQRC_GMO_ERROR
+#define MQRC_GMO_ERROR 2186
+#endif
+#ifndef MQRC_UNKNOWN_XMIT_Q
+#define MQRC_UNKNOWN_XMIT_Q 2196
+#endif
+#ifndef MQRC_STS_ERROR
+#define MQRC_STS_ERROR 2426
+#endif
+#ifndef MQRC_STAT_TYPE_ERROR
+#define MQRC_STAT_TYPE_ERROR 2430
+#endif
+#ifndef MQRC_CBD_ERROR
+#define MQRC_CBD_ERROR 2444
+#endif
+#ifndef MQRCCF_CFH_TYPE_ERROR
+#define MQRCCF_CFH_TYPE_ERROR 3001
+#endif
+#ifndef MQRCCF_CFH_COMMAND_ERROR
+#define MQRCCF_CFH_COMMAND_ERROR 3007
+#endif
+#ifndef MQRCCF_PARM_COUNT_TOO_SMALL
+#define MQRCCF_PARM_COUNT_TOO_SMALL 3015
+#endif
+
+#ifndef MQGMO_MSG_UNDER_CURSOR
+#define MQGMO_MSG_UNDER_CURSOR 256
+#endif
+#ifndef MQPMO_NO_CONTEXT
+#define MQPMO_NO_CONTEXT 16384
+#endif
+#ifndef MQCA_Q_MGR_NAME
+#define MQCA_Q_MGR_NAME 2015
+#endif
+#ifndef MQIACF_PURGE
+#define MQIACF_PURGE 1019
+#endif
+#ifndef MQPO_YES
+#define MQPO_YES 1
+#endif
+#ifndef MQIAV_NOT_APPLICABLE
+#define MQIAV_NOT_APPLICABLE (-1)
+#endif
+#ifndef MQAT_UNIX
+#define MQAT_UNIX 6
+#endif
+#ifndef MQCBC_VERSION_1
+#define MQCBC_VERSION_1 1
+#endif
+
+// Queue defaults, as defined for a new queue manager
+#define SIM_DEFAULT_MAX_DEPTH 5000
+#define SIM_MAX_MSG_LENGTH 4194304
+
+// The model queue's MAXDEPTH; a reply queue must hold one response per
+// queue of the largest listing a benchmark asks for
+#define SIM_MODEL_MAX_DEPTH 999999999
+
+#define SIM_COMMAND_QUEUE "SYSTEM.ADMIN.COMMAND.QUEUE"
+#define SIM_MAX_CONNECTIONS 256
+#define SIM_MAX_LIST_VALUES 64
+
+// Longest wait between checks that the simulator is still enabled
+#define SIM_WAIT_SLICE_MS 100
+
+// Message states
+#define SIM_MSG_AVAILABLE 0
+#define SIM_MSG_PUT_PENDING 1   // put under syncpoint, not yet committed
+#define SIM_MSG_GET_PENDING 2   // got under syncpoint, not yet committed
+
+// MARK: - Types
+
+typedef struct SimMessage {
+    struct SimMessage *prev;
+    struct SimMessage *next;
+    MQMD md;
+    MQBYTE token[MQ_MSG_TOKEN_LENGTH];
+    MQLONG state;
+    MQLONG length;
+    unsigned char data[];
+} SimMessage;
+
+typedef struct SimQueue {
+    char name[MQ_Q_NAME_LENGTH + 1];
+    MQLONG type;
+    MQLONG maxDepth;
+    MQLONG inhibitGet;
+    MQLONG inhibitPut;
+    MQLONG depth;
+    MQLONG openInput;
+    MQLONG openOutput;
+    MQLONG openHandles;
+    MQLONG browsers;        // handles with a browse cursor
+    MQLONG pending;         // messages in a unit of work
+    bool exclusive;         // open for exclusive input
+    bool temporary;         // temporary dynamic queue, deleted when closed
+    bool deleted;           // no longer defined, freed with its last handle
+    SimMessage *head;
+    SimMessage *tail;
+} SimQueue;
+
+typedef struct SimPending {
+    SimQueue *queue;
+    SimMessage *message;
+} SimPending;
+
+typedef struct SimConnection {
+    bool inUse;
+
+    // Unit of work
+    SimPending *pending;
+    size_t pendingCount;
+    size_t pendingCapacity;
+
+    // Asynchronous put responses since the last MQSTAT
+    MQLONG putSuccessCount;
+    MQLONG putFailureCount;
+    MQLONG firstCompCode;
+    MQLONG firstReason;
+    char firstObjectName[MQ_Q_NAME_LENGTH + 1];
+
+    // Message consumers
+    bool started;
+    bool stopping;
+    bool suspended;
+    bool hasThread;
+    bool detachThread;
+    pthread_t thread;
+} SimConnection;
+
+typedef struct SimHandle {
+    bool inUse;
+    MQHCONN hconn;
+    SimQueue *queue;        // NULL for the queue manager object
+    MQLONG options;
+    bool createdQueue;      // the handle that created a temporary dynamic queue
+
+    // Browse cursor: the message last browsed, NULL before the first
+    SimMessage *cursor;
+    bool cursorValid;       // whether that message is still on the queue
+
+    // Context of the last message got, for MQPMO_PASS_*_CONTEXT
+    MQMD context;
+    bool hasContext;
+
+    // Message consumer registered with MQCB
+    bool consumer;
+    bool consumerSuspended;
+    MQCBD callback;
+    MQMD consumerMD;
+    MQGMO consumerGMO;
+} SimHandle;
+
+typedef void (*SimCallbackFunction)(MQHCONN, void *, void *, void *, MQCBC *);
+
+// MARK: - State
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t arrival;
+    bool enabled;
+    uint32_t epoch;
+    char queueManagerName[MQ_Q_MGR_NAME_LENGTH + 1];
+
+    SimQueue **queues;
+    size_t queueCount;
+    size_t queueCapacity;
+
+    SimConnection connections[SIM_MAX_CONNECTIONS];
+
+    SimHandle *handles;
+    size_t handleCapacity;
+
+    uint64_t idCounter;
+    uint64_t dynamicQueueCounter;
+
+    MQLONG latency;
+    MQLONG jitter;
+    uint64_t random;
+
+    bool commandServerStopped;
+
+    uint64_t calls[MQMATE_SIM_CALL_COUNT];
+    MQLONG lastGetOptions;
+} sim = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .arrival = PTHREAD_COND_INITIALIZER
+};
+
+static pthread_once_t simEnvironmentOnce = PTHREAD_ONCE_INIT;
+
+// MARK: - Helpers
+
+static bool sim_is_warning(MQLONG reason) {
+    return reason == MQRC_TRUNCATED_MSG_ACCEPTED
+        || reason == MQRC_TRUNCATED_MSG_FAILED
+        || reason == MQRC_INT_ATTR_COUNT_TOO_SMALL
+        || reason == MQRC_CHAR_ATTRS_TOO_SHORT
+        || reason == MQRC_SELECTOR_NOT_FOR_TYPE;
+}
+
+static void sim_result(MQLONG reason, MQLONG *pCompCode, MQLONG *pReason) {
+    *pReason = reason;
+    if (reason == MQRC_NONE) {
+        *pCompCode = MQCC_OK;
+    } else {
+        *pCompCode = sim_is_warning(reason) ? MQCC_WARNING : MQCC_FAILED;
+    }
+}
+
+// Copy a character field into a NUL-terminated name without its padding
+static void sim_name(char *name, size_t capacity, const MQCHAR *field, size_t fieldLength) {
+    size_t length = mqmate_chars_length(field, fieldLength);
+    if (length >= capacity) {
+        length = capacity - 1;
+    }
+    memcpy(name, field, length);
+    name[length] = '\0';
+}
+
+static void sim_set_name(MQCHAR *field, size_t fieldLength, const char *name) {
+    mqmate_set_chars(field, fieldLength, name, strlen(name));
+}
+
+static bool sim_is_zero(const MQBYTE *bytes, size_t length) {
+    for (size_t index = 0; index < length; index++) {
+        if (bytes[index] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void sim_store_big_endian(MQBYTE *bytes, uint64_t value) {
+    for (int index = 7; index >= 0; index--) {
+        bytes[index] = (MQBYTE)(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+// xorshift64*, seeded on enable so that jitter repeats from run to run
+static uint64_t sim_next_random(void) {
+    sim.random ^= sim.random >> 12;
+    sim.random ^= sim.random << 25;
+    sim.random ^= sim.random >> 27;
+    return sim.random * 0x2545F4914F6CDD1DULL;
+}
+
+static void sim_sleep_microseconds(long microseconds) {
+    struct timespec delay = { microseconds / 1000000, (microseconds % 1000000) * 1000 };
+    while (nanosleep(&delay, &delay) != 0 && errno == EINTR) {
+    }
+}
+
+// Wait for a message to arrive, at most until deadline
+// Returns false once the deadline has passed
+static bool sim_wait(const struct timespec *deadline, bool unlimited) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    struct timespec slice = now;
+    slice.tv_nsec += (long)SIM_WAIT_SLICE_MS * 1000000L;
+    if (slice.tv_nsec >= 1000000000L) {
+        slice.tv_sec += 1;
+        slice.tv_nsec -= 1000000000L;
+    }
+
+    if (!unlimited) {
+        if (now.tv_sec > deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec)) {
+            return false;
+        }
+        if (deadline->tv_sec < slice.tv_sec || (deadline->tv_sec == slice.tv_sec && deadline->tv_nsec < slice.tv_nsec)) {
+            slice = *deadline;
+        }
+    }
+    pthread_cond_timedwait(&sim.arrival, &sim.lock, &slice);
+    return true;
+}
+
+static struct timespec sim_deadline(MQLONG waitInterval) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += waitInterval / 1000;
+    deadline.tv_nsec += (long)(waitInterval % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return deadline;
+}
+
+// MARK: - Round Trips
+
+// Count a call and wait out its round trip, before the call takes the lock
+static void sim_round_trip(MQLONG call, bool addsLatency) {
+    long delay = 0;
+
+    pthread_mutex_lock(&sim.lock);
+    sim.calls[MQMATE_SIM_CALL_ALL]++;
+    sim.calls[call]++;
+    if (sim.enabled && addsLatency) {
+        delay = sim.latency;
+        if (sim.jitter > 0) {
+            delay += (long)(sim_next_random() % (uint64_t)(sim.jitter + 1));
+        }
+    }
+    pthread_mutex_unlock(&sim.lock);
+
+    if (delay > 0) {
+        sim_sleep_microseconds(delay);
+    }
+}
+
+// Connection of a handle from the current epoch, NULL if there is none
+static SimConnection *sim_connection(MQHCONN hconn) {
+    if (hconn <= 0 || (uint32_t)hconn >> 16 != sim.epoch) {
+        return NULL;
+    }
+    size_t index = (size_t)(hconn & 0xFFFF) - 1;
+    if (index >= SIM_MAX_CONNECTIONS || !sim.connections[index].inUse) {
+        return NULL;
+    }
+    return &sim.connections[index];
+}
+
+static SimHandle *sim_handle(MQHCONN hconn, MQHOBJ hobj) {
+    if (hobj <= 0 || (size_t)hobj > sim.handleCapacity) {
+        return NULL;
+    }
+    SimHandle *handle = &sim.handles[hobj - 1];
+    return handle->inUse && handle->hconn == hconn ? handle : NULL;
+}
+
+// Begin a call on a connection: count it, wait its round trip and take the
+// lock. Returns the connection with the lock held, or NULL with the result set
+static SimConnection *sim_begin(MQLONG call, MQHCONN hconn, bool addsLatency, MQLONG *pCompCode, MQLONG *pReason) {
+    sim_round_trip(call, addsLatency);
+
+    pthread_mutex_lock(&sim.lock);
+    if (!sim.enabled) {
+        pthread_mutex_unlock(&sim.lock);
+        sim_result(MQRC_Q_MGR_NOT_AVAILABLE, pCompCode, pReason);
+        return NULL;
+    }
+    SimConnection *connection = sim_connection(hconn);
+    if (connection == NULL) {
+        pthread_mutex_unlock(&sim.lock);
+        sim_result(MQRC_HCONN_ERROR, pCompCode, pReason);
+        return NULL;
+    }
+    sim_result(MQRC_NONE, pCompCode, pReason);
+    return connection;
+}
+
+// MARK: - Queues
+
+static SimQueue *sim_find_queue(const char *name) {
+    for (size_t index = 0; index < sim.queueCount; index++) {
+        if (strcmp(sim.queues[index]->name, name) == 0) {
+            return sim.queues[index];
+        }
+    }
+    return NULL;
+}
+
+static MQLONG sim_add_queue(const char *name, MQLONG type, MQLONG maxDepth, SimQueue **created) {
+    size_t length = strlen(name);
+    if (length == 0 || length > MQ_Q_NAME_LENGTH) {
+        return MQRC_UNKNOWN_OBJECT_NAME;
+    }
+    if (type != MQQT_LOCAL && type != MQQT_MODEL && type != MQQT_ALIAS && type != MQQT_REMOTE) {
+        return MQRC_Q_TYPE_ERROR;
+    }
+    if (sim_find_queue(name) != NULL) {
+        return MQRC_OBJECT_ALREADY_EXISTS;
+    }
+
+    if (sim.queueCount == sim.queueCapacity) {
+        size_t capacity = sim.queueCapacity == 0 ? 64 : sim.queueCapacity * 2;
+        SimQueue **queues = realloc(sim.queues, capacity * sizeof(SimQueue *));
+        if (queues == NULL) {
+            return MQRC_STORAGE_NOT_AVAILABLE;
+        }
+        sim.queues = queues;
+        sim.queueCapacity = capacity;
+    }
+
+    SimQueue *queue = calloc(1, sizeof(SimQueue));
+    if (queue == NULL) {
+        return MQRC_STORAGE_NOT_AVAILABLE;
+    }
+    memcpy(queue->name, name, length + 1);
+    queue->type = type;
+    queue->maxDepth = maxDepth > 0 ? maxDepth : SIM_DEFAULT_MAX_DEPTH;
+    queue->inhibitGet = MQQA_GET_ALLOWED;
+    queue->inhibitPut = MQQA_PUT_ALLOWED;
+
+    sim.queues[sim.queueCount++] = queue;
+    if (created != NULL) {
+        *created = queue;
+    }
+    return MQRC_NONE;
+}
+
+// Take a queue out of the queue manager; its handles see MQRC_Q_DELETED
+static void sim_remove_queue(SimQueue *queue) {
+    for (size_t index = 0; index < sim.queueCount; index++) {
+        if (sim.queues[index] == queue) {
+            sim.queues[index] = sim.queues[--sim.queueCount];
+            break;
+        }
+    }
+    queue->deleted = true;
+}
+
+// Free a queue that has no handles left, and drop its messages from every unit of work
+static void sim_free_queue(SimQueue *queue) {
+    if (queue->pending > 0) {
+        for (size_t index = 0; index < SIM_MAX_CONNECTIONS; index++) {
+            SimConnection *connection = &sim.connections[index];
+            size_t kept = 0;
+            for (size_t entry = 0; entry < connection->pendingCount; entry++) {
+                if (connection->pending[entry].queue != queue) {
+                    connection->pending[kept++] = connection->pending[entry];
+                }
+            }
+            connection->pendingCount = kept;
+        }
+    }
+
+    SimMessage *message = queue->head;
+    while (message != NULL) {
+        SimMessage *next = message->next;
+        free(message);
+        message = next;
+    }
+    free(queue);
+}
+
+// Whether an integer attribute is defined for the queue's type, and its value
+static bool sim_queue_attribute(const SimQueue *queue, MQLONG selector, MQLONG *value) {
+    bool local = queue->type == MQQT_LOCAL;
+    bool model = queue->type == MQQT_MODEL;
+    bool alias = queue->type == MQQT_ALIAS;
+
+    switch (selector) {
+    case MQIA_Q_TYPE:
+        *value = queue->type;
+        return true;
+    case MQIA_CURRENT_Q_DEPTH:
+        *value = queue->depth;
+        return local;
+    case MQIA_MAX_Q_DEPTH:
+        *value = queue->maxDepth;
+        return local || model;
+    case MQIA_OPEN_INPUT_COUNT:
+        *value = queue->openInput;
+        return local;
+    case MQIA_OPEN_OUTPUT_COUNT:
+        *value = queue->openOutput;
+        return local;
+    case MQIA_INHIBIT_GET:
+        *value = queue->inhibitGet;
+        return local || model || alias;
+    case MQIA_INHIBIT_PUT:
+        *value = queue->inhibitPut;
+        return true;
+    default:
+        *value = MQIAV_NOT_APPLICABLE;
+        return false;
+    }
+}
+
+static bool sim_is_queue_selector(MQLONG selector) {
+    MQLONG value;
+    SimQueue local = { .type = MQQT_LOCAL };
+    return sim_queue_attribute(&local, selector, &value);
+}
+
+// Whether a name matches a PCF name filter: exact, or a prefix ending in '*'
+static bool sim_matches_filter(const char *name, const char *filter) {
+    size_t length = strlen(filter);
+    if (length > 0 && filter[length - 1] == '*') {
+        return strncmp(name, filter, length - 1) == 0;
+    }
+    return strcmp(name, filter) == 0;
+}
+
+static int sim_compare_queues(const void *left, const void *right) {
+    return strcmp((*(SimQueue *const *)left)->name, (*(SimQueue *const *)right)->name);
+}
+
+// MARK: - Messages
+
+static void sim_unique_id(MQBYTE *id) {
+    memcpy(id, "AMQ ", 4);
+    mqmate_set_chars(id + 4, 12, sim.queueManagerName, strlen(sim.queueManagerName));
+    sim_store_big_endian(id + 16, ++sim.idCounter);
+}
+
+static void sim_set_put_date_time(MQMD *md) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    struct tm utc;
+    time_t seconds = now.tv_sec;
+    gmtime_r(&seconds, &utc);
+
+    // Room for any int the fields could hold; a time outside the fixed
+    // widths leaves the date and time blank rather than misaligned
+    char text[64];
+    int length = snprintf(text, sizeof(text), "%04d%02d%02d%02d%02d%02d%02ld",
+                          (utc.tm_year + 1900) % 10000, utc.tm_mon + 1, utc.tm_mday,
+                          utc.tm_hour, utc.tm_min, utc.tm_sec, now.tv_nsec / 10000000L);
+    if (length != MQ_PUT_DATE_LENGTH + MQ_PUT_TIME_LENGTH) {
+        memset(md->PutDate, ' ', MQ_PUT_DATE_LENGTH);
+        memset(md->PutTime, ' ', MQ_PUT_TIME_LENGTH);
+        return;
+    }
+    memcpy(md->PutDate, text, MQ_PUT_DATE_LENGTH);
+    memcpy(md->PutTime, text + MQ_PUT_DATE_LENGTH, MQ_PUT_TIME_LENGTH);
+}
+
+static void sim_set_identity_context(MQMD *md, const MQMD *source) {
+    if (source != NULL) {
+        memcpy(md->UserIdentifier, source->UserIdentifier, sizeof(md->UserIdentifier));
+        memcpy(md->AccountingToken, source->AccountingToken, sizeof(md->AccountingToken));
+        memcpy(md->ApplIdentityData, source->ApplIdentityData, sizeof(md->ApplIdentityData));
+    } else {
+        sim_set_name(md->UserIdentifier, sizeof(md->UserIdentifier), "mqmate");
+        memset(md->AccountingToken, 0, sizeof(md->AccountingToken));
+        memset(md->ApplIdentityData, ' ', sizeof(md->ApplIdentityData));
+    }
+}
+
+static void sim_set_origin_context(MQMD *md, const MQMD *source) {
+    if (source != NULL) {
+        md->PutApplType = source->PutApplType;
+        memcpy(md->PutApplName, source->PutApplName, sizeof(md->PutApplName));
+        memcpy(md->PutDate, source->PutDate, sizeof(md->PutDate));
+        memcpy(md->PutTime, source->PutTime, sizeof(md->PutTime));
+        memcpy(md->ApplOriginData, source->ApplOriginData, sizeof(md->ApplOriginData));
+    } else {
+        md->PutApplType = MQAT_UNIX;
+        sim_set_name(md->PutApplName, sizeof(md->PutApplName), "MQMate");
+        sim_set_put_date_time(md);
+        memset(md->ApplOriginData, ' ', sizeof(md->ApplOriginData));
+    }
+}
+
+static void sim_clear_context(MQMD *md) {
+    memset(md->UserIdentifier, ' ', sizeof(md->UserIdentifier));
+    memset(md->AccountingToken, 0, sizeof(md->AccountingToken));
+    memset(md->ApplIdentityData, ' ', sizeof(md->ApplIdentityData));
+    md->PutApplType = MQAT_NO_CONTEXT;
+    memset(md->PutApplName, ' ', sizeof(md->PutApplName));
+    memset(md->PutDate, ' ', sizeof(md->PutDate));
+    memset(md->PutTime, ' ', sizeof(md->PutTime));
+    memset(md->ApplOriginData, ' ', sizeof(md->ApplOriginData));
+}
+
+// Take a message off its queue and free it; browse cursors on it move back
+// to the message before, so that BROWSE_NEXT continues with the one after
+static void sim_unlink_message(SimQueue *queue, SimMessage *message) {
+    if (queue->browsers > 0) {
+        for (size_t index = 0; index < sim.handleCapacity; index++) {
+            SimHandle *handle = &sim.handles[index];
+            if (handle->inUse && handle->queue == queue && handle->cursor == message) {
+                handle->cursor = message->prev;
+                handle->cursorValid = false;
+            }
+        }
+    }
+
+    if (message->prev != NULL) {
+        message->prev->next = message->next;
+    } else {
+        queue->head = message->next;
+    }
+    if (message->next != NULL) {
+        message->next->prev = message->prev;
+    } else {
+        queue->tail = message->prev;
+    }
+    queue->depth--;
+    free(message);
+}
+
+static MQLONG sim_add_pending(SimConnection *connection, SimQueue *queue, SimMessage *message) {
+    if (connection->pendingCount == connection->pendingCapacity) {
+        size_t capacity = connection->pendingCapacity == 0 ? 64 : connection->pendingCapacity * 2;
+        SimPending *pending = realloc(connection->pending, capacity * sizeof(SimPending));
+        if (pending == NULL) {
+            return MQRC_STORAGE_NOT_AVAILABLE;
+        }
+        connection->pending = pending;
+        connection->pendingCapacity = capacity;
+    }
+    connection->pending[connection->pendingCount++] = (SimPending){ queue, message };
+    queue->pending++;
+    return MQRC_NONE;
+}
+
+static void sim_process_command(SimQueue *commandQueue, SimMessage *request);
+
+// A message became available to other applications
+static void sim_message_available(SimQueue *queue, SimMessage *message) {
+    pthread_cond_broadcast(&sim.arrival);
+    if (strcmp(queue->name, SIM_COMMAND_QUEUE) == 0 && !sim.commandServerStopped) {
+        sim_process_command(queue, message);
+    }
+}
+
+// Put a message on a queue
+// - md: Descriptor to put; MsgId, CorrelId and context are returned in it
+// - options: MQPMO_* options
+// - context: Descriptor of the message got on the MQPMO Context handle, or NULL
+// - connection: Connection whose unit of work a syncpoint put joins, or NULL
+static MQLONG sim_put_message(
+    SimQueue *queue,
+    MQMD *md,
+    MQLONG options,
+    const MQMD *context,
+    const void *data,
+    MQLONG length,
+    SimConnection *connection
+) {
+    if (queue->inhibitPut == MQQA_PUT_INHIBITED) {
+        return MQRC_PUT_INHIBITED;
+    }
+    if (length > SIM_MAX_MSG_LENGTH) {
+        return MQRC_MSG_TOO_BIG_FOR_Q;
+    }
+    if (queue->depth >= queue->maxDepth) {
+        return MQRC_Q_FULL;
+    }
+    bool syncpoint = (options & MQPMO_SYNCPOINT) != 0 && connection != NULL;
+
+    SimMessage *message = malloc(sizeof(SimMessage) + (size_t)length);
+    if (message == NULL) {
+        return MQRC_STORAGE_NOT_AVAILABLE;
+    }
+    message->md = *md;
+    message->length = length;
+    if (length > 0) {
+        memcpy(message->data, data, (size_t)length);
+    }
+
+    MQMD *stored = &message->md;
+    memcpy(stored->StrucId, "MD  ", sizeof(stored->StrucId));
+    stored->Version = MQMD_VERSION_2;
+    stored->BackoutCount = 0;
+    if (stored->Priority == MQPRI_PRIORITY_AS_Q_DEF) {
+        stored->Priority = 0;
+    }
+    if (stored->Persistence == MQPER_PERSISTENCE_AS_Q_DEF) {
+        stored->Persistence = MQPER_NOT_PERSISTENT;
+    }
+    if ((options & MQPMO_NEW_MSG_ID) != 0 || sim_is_zero(stored->MsgId, sizeof(stored->MsgId))) {
+        sim_unique_id(stored->MsgId);
+    }
+    if ((options & MQPMO_NEW_CORREL_ID) != 0) {
+        sim_unique_id(stored->CorrelId);
+    }
+
+    if ((options & MQPMO_NO_CONTEXT) != 0) {
+        sim_clear_context(stored);
+    } else if ((options & MQPMO_SET_ALL_CONTEXT) != 0) {
+        // Every context field as given
+    } else if ((options & MQPMO_SET_IDENTITY_CONTEXT) != 0) {
+        sim_set_origin_context(stored, NULL);
+    } else if ((options & MQPMO_PASS_ALL_CONTEXT) != 0) {
+        sim_set_identity_context(stored, context);
+        sim_set_origin_context(stored, context);
+    } else if ((options & MQPMO_PASS_IDENTITY_CONTEXT) != 0) {
+        sim_set_identity_context(stored, context);
+        sim_set_origin_context(stored, NULL);
+    } else {
+        sim_set_identity_context(stored, NULL);
+        sim_set_origin_context(stored, NULL);
+    }
+
+    memset(message->token, 0, sizeof(message->token));
+    sim_store_big_endian(message->token, sim.epoch);
+    sim_store_big_endian(message->token + 8, ++sim.idCounter);
+
+    message->state = syncpoint ? SIM_MSG_PUT_PENDING : SIM_MSG_AVAILABLE;
+    if (syncpoint && sim_add_pending(connection, queue, message) != MQRC_NONE) {
+        free(message);
+        return MQRC_STORAGE_NOT_AVAILABLE;
+    }
+
+    message->next = NULL;
+    message->prev = queue->tail;
+    if (queue->tail != NULL) {
+        queue->tail->next = message;
+    } else {
+        queue->head = message;
+    }
+    queue->tail = message;
+    queue->depth++;
+
+    // Output fields of the caller's descriptor
+    *md = *stored;
+    md->Version = md->Version > MQMD_VERSION_2 ? md->Version : MQMD_VERSION_2;
+
+    if (!syncpoint) {
+        sim_message_available(queue, message);
+    }
+    return MQRC_NONE;
+}
+
+// MARK: - Command Server
+
+// A PCF command decoded from its request message
+typedef struct SimCommand {
+    MQLONG command;
+    char name[MQ_Q_NAME_LENGTH + 1];
+    bool hasName;
+    MQLONG queueType;
+    bool hasQueueType;
+    MQLONG maxDepth;
+    bool hasMaxDepth;
+    MQLONG inhibitGet;
+    bool hasInhibitGet;
+    MQLONG inhibitPut;
+    bool hasInhibitPut;
+    MQLONG purge;
+    MQLONG attributes[SIM_MAX_LIST_VALUES];
+    MQLONG attributeCount;  // -1 when no attribute list was given
+} SimCommand;
+
+// One PCF response message being built
+typedef struct SimResponse {
+    unsigned char *bytes;
+    size_t length;
+    size_t capacity;
+    MQLONG parameterCount;
+    bool failed;
+} SimResponse;
+
+static void sim_response_append(SimResponse *response, const void *bytes, size_t length) {
+    if (response->failed) {
+        return;
+    }
+    if (response->length + length > response->capacity) {
+        size_t capacity = response->capacity == 0 ? 512 : response->capacity;
+        while (response->length + length > capacity) {
+            capacity *= 2;
+        }
+        unsigned char *grown = realloc(response->bytes, capacity);
+        if (grown == NULL) {
+            response->failed = true;
+            return;
+        }
+        response->bytes = grown;
+        response->capacity = capacity;
+    }
+    memcpy(response->bytes + response->length, bytes, length);
+    response->length += length;
+}
+
+static void sim_response_begin(SimResponse *response, MQLONG command, MQLONG sequence, bool last,
+                               MQLONG compCode, MQLONG reason) {
+    MQCFH header;
+    memset(&header, 0, sizeof(header));
+    header.Type = MQCFT_RESPONSE;
+    header.StrucLength = MQCFH_STRUC_LENGTH;
+    header.Version = MQCFH_VERSION_1;
+    header.Command = command;
+    header.MsgSeqNumber = sequence;
+    header.Control = last ? MQCFC_LAST : MQCFC_NOT_LAST;
+    header.CompCode = compCode;
+    header.Reason = reason;
+
+    response->length = 0;
+    response->parameterCount = 0;
+    sim_response_append(response, &header, MQCFH_STRUC_LENGTH);
+}
+
+static void sim_response_integer(SimResponse *response, MQLONG parameter, MQLONG value) {
+    MQLONG structure[4] = { MQCFT_INTEGER, MQCFIN_STRUC_LENGTH, parameter, value };
+    sim_response_append(response, structure, sizeof(structure));
+    response->parameterCount++;
+}
+
+static void sim_response_string(SimResponse *response, MQLONG parameter, const char *value, MQLONG length) {
+    MQLONG fixed[5] = { MQCFT_STRING, MQCFST_STRUC_LENGTH_FIXED + length, parameter, MQCCSI_DEFAULT, length };
+    sim_response_append(response, fixed, sizeof(fixed));
+
+    char padded[MQ_Q_NAME_LENGTH];
+    mqmate_set_chars(padded, (size_t)length, value, strlen(value));
+    sim_response_append(response, padded, (size_t)length);
+    response->parameterCount++;
+}
+
+// Put a finished response on the request's reply queue; undeliverable
+// responses are discarded, as there is no dead-letter handling
+static void sim_response_send(SimResponse *response, const MQMD *request) {
+    if (response->failed) {
+        return;
+    }
+    memcpy(response->bytes + 32, &response->parameterCount, sizeof(MQLONG));
+
+    char replyQueueName[MQ_Q_NAME_LENGTH + 1];
+    sim_name(replyQueueName, sizeof(replyQueueName), request->ReplyToQ, sizeof(request->ReplyToQ));
+    SimQueue *replyQueue = sim_find_queue(replyQueueName);
+    if (replyQueue == NULL || replyQueue->type != MQQT_LOCAL || strcmp(replyQueueName, SIM_COMMAND_QUEUE) == 0) {
+        return;
+    }
+
+    MQMD md = mqmate_md_default();
+    md.Version = MQMD_VERSION_2;
+    md.MsgType = MQMT_REPLY;
+    md.Persistence = request->Persistence;
+    md.Encoding = request->Encoding;
+    memcpy(md.Format, "MQADMIN ", MQ_FORMAT_LENGTH);
+    memcpy(md.CorrelId, request->MsgId, sizeof(md.CorrelId));
+    sim_put_message(replyQueue, &md, MQPMO_NO_SYNCPOINT | MQPMO_NEW_MSG_ID, NULL,
+                    response->bytes, (MQLONG)response->length, NULL);
+}
+
+// Answer a command with a single response without parameters
+static void sim_respond(SimResponse *response, const SimCommand *command, const MQMD *request, MQLONG reason) {
+    sim_response_begin(response, command->command, 1, true, reason == MQRC_NONE ? MQCC_OK : MQCC_FAILED, reason);
+    sim_response_send(response, request);
+}
+
+// Decode the parameters of a PCF command
+static MQLONG sim_decode_command(const unsigned char *bytes, MQLONG length, SimCommand *command) {
+    memset(command, 0, sizeof(*command));
+    command->attributeCount = -1;
+
+    if (length < MQCFH_STRUC_LENGTH) {
+        return MQRCCF_CFH_TYPE_ERROR;
+    }
+    MQCFH header;
+    memcpy(&header, bytes, sizeof(header));
+    command->command = header.Command;
+    if (header.Type != MQCFT_COMMAND) {
+        return MQRCCF_CFH_TYPE_ERROR;
+    }
+
+    size_t offset = header.StrucLength >= MQCFH_STRUC_LENGTH ? (size_t)header.StrucLength : MQCFH_STRUC_LENGTH;
+    for (MQLONG index = 0; index < header.ParameterCount && offset + 8 <= (size_t)length; index++) {
+        MQLONG fields[6] = { 0 };
+        size_t available = (size_t)length - offset;
+        memcpy(fields, bytes + offset, available < sizeof(fields) ? available : sizeof(fields));
+        MQLONG type = fields[0];
+        MQLONG structureLength = fields[1];
+        MQLONG parameter = fields[2];
+        if (structureLength < 12 || (size_t)structureLength > available) {
+            break;
+        }
+
+        switch (type) {
+        case MQCFT_INTEGER:
+            switch (parameter) {
+            case MQIA_Q_TYPE: command->queueType = fields[3]; command->hasQueueType = true; break;
+            case MQIA_MAX_Q_DEPTH: command->maxDepth = fields[3]; command->hasMaxDepth = true; break;
+            case MQIA_INHIBIT_GET: command->inhibitGet = fields[3]; command->hasInhibitGet = true; break;
+            case MQIA_INHIBIT_PUT: command->inhibitPut = fields[3]; command->hasInhibitPut = true; break;
+            case MQIACF_PURGE: command->purge = fields[3]; break;
+            default: break;
+            }
+            break;
+
+        case MQCFT_STRING:
+            if (parameter == MQCA_Q_NAME && structureLength >= MQCFST_STRUC_LENGTH_FIXED
+                && fields[4] >= 0 && MQCFST_STRUC_LENGTH_FIXED + fields[4] <= structureLength) {
+                sim_name(command->name, sizeof(command->name),
+                         (const MQCHAR *)(bytes + offset + MQCFST_STRUC_LENGTH_FIXED), (size_t)fields[4]);
+                command->hasName = true;
+            }
+            break;
+
+        case MQCFT_INTEGER_LIST:
+            if (parameter == MQIACF_Q_ATTRS || parameter == MQIACF_Q_STATUS_ATTRS) {
+                MQLONG count = fields[3];
+                if (count < 0 || MQCFIL_STRUC_LENGTH_FIXED + (size_t)count * sizeof(MQLONG) > (size_t)structureLength) {
+                    break;
+                }
+                command->attributeCount = count < SIM_MAX_LIST_VALUES ? count : SIM_MAX_LIST_VALUES;
+                memcpy(command->attributes, bytes + offset + MQCFIL_STRUC_LENGTH_FIXED,
+                       (size_t)command->attributeCount * sizeof(MQLONG));
+            }
+            break;
+
+        default:
+            break;
+        }
+        offset += (size_t)structureLength;
+    }
+    return MQRC_NONE;
+}
+
+// Whether a command asks for an attribute: listed, MQIACF_ALL, or no list
+static bool sim_wants_attribute(const SimCommand *command, MQLONG selector) {
+    if (command->attributeCount < 0) {
+        return true;
+    }
+    for (MQLONG index = 0; index < command->attributeCount; index++) {
+        if (command->attributes[index] == selector || command->attributes[index] == MQIACF_ALL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Queues matching a command's name filter (and type), sorted by name; NULL if none
+static SimQueue **sim_matching_queues(const SimCommand *command, bool localOnly, size_t *count) {
+    *count = 0;
+    SimQueue **matches = malloc((sim.queueCount > 0 ? sim.queueCount : 1) * sizeof(SimQueue *));
+    if (matches == NULL) {
+        return NULL;
+    }
+    MQLONG queueType = command->hasQueueType ? command->queueType : MQQT_ALL;
+    for (size_t index = 0; index < sim.queueCount; index++) {
+        SimQueue *queue = sim.queues[index];
+        if (!sim_matches_filter(queue->name, command->name)) {
+            continue;
+        }
+        if (localOnly ? queue->type != MQQT_LOCAL : (queueType != MQQT_ALL && queue->type != queueType)) {
+            continue;
+        }
+        matches[(*count)++] = queue;
+    }
+    if (*count == 0) {
+        free(matches);
+        return NULL;
+    }
+    qsort(matches, *count, sizeof(SimQueue *), sim_compare_queues);
+    return matches;
+}
+
+// MQCMD_INQUIRE_Q and MQCMD_INQUIRE_Q_STATUS: one response per matching queue
+static void sim_inquire_queues(SimResponse *response, const SimCommand *command, const MQMD *request, bool status) {
+    static const MQLONG statusSelectors[] = { MQIA_CURRENT_Q_DEPTH, MQIA_OPEN_INPUT_COUNT, MQIA_OPEN_OUTPUT_COUNT };
+    static const MQLONG queueSelectors[] = {
+        MQIA_CURRENT_Q_DEPTH, MQIA_MAX_Q_DEPTH, MQIA_OPEN_INPUT_COUNT, MQIA_OPEN_OUTPUT_COUNT,
+        MQIA_INHIBIT_GET, MQIA_INHIBIT_PUT
+    };
+    const MQLONG *selectors = status ? statusSelectors : queueSelectors;
+    size_t selectorCount = status
+        ? sizeof(statusSelectors) / sizeof(MQLONG)
+        : sizeof(queueSelectors) / sizeof(MQLONG);
+
+    size_t count;
+    SimQueue **queues = sim_matching_queues(command, status, &count);
+    if (queues == NULL) {
+        sim_respond(response, command, request, MQRC_UNKNOWN_OBJECT_NAME);
+        return;
+    }
+
+    for (size_t index = 0; index < count; index++) {
+        const SimQueue *queue = queues[index];
+        sim_response_begin(response, command->command, (MQLONG)index + 1, index + 1 == count, MQCC_OK, MQRC_NONE);
+        sim_response_string(response, MQCA_Q_NAME, queue->name, MQ_Q_NAME_LENGTH);
+        if (status) {
+            sim_response_integer(response, MQIACF_Q_STATUS_TYPE, MQIACF_Q_STATUS);
+        } else {
+            sim_response_integer(response, MQIA_Q_TYPE, queue->type);
+        }
+        for (size_t selector = 0; selector < selectorCount; selector++) {
+            MQLONG value;
+            if (sim_wants_attribute(command, selectors[selector])
+                && sim_queue_attribute(queue, selectors[selector], &value)) {
+                sim_response_integer(response, selectors[selector], value);
+            }
+        }
+        sim_response_send(response, request);
+    }
+    free(queues);
+}
+
+static MQLONG sim_create_queue(const SimCommand *command) {
+    if (!command->hasName || !command->hasQueueType) {
+        return MQRCCF_PARM_COUNT_TOO_SMALL;
+    }
+    SimQueue *queue = NULL;
+    MQLONG reason = sim_add_queue(command->name, command->queueType,
+                                  command->hasMaxDepth ? command->maxDepth : 0, &queue);
+    if (reason == MQRC_NONE) {
+        if (command->hasInhibitGet) {
+            queue->inhibitGet = command->inhibitGet;
+        }
+        if (command->hasInhibitPut) {
+            queue->inhibitPut = command->inhibitPut;
+        }
+    }
+    return reason;
+}
+
+static MQLONG sim_change_queue(const SimCommand *command) {
+    if (!command->hasName) {
+        return MQRCCF_PARM_COUNT_TOO_SMALL;
+    }
+    SimQueue *queue = sim_find_queue(command->name);
+    if (queue == NULL) {
+        return MQRC_UNKNOWN_OBJECT_NAME;
+    }
+    if (command->hasMaxDepth && command->maxDepth > 0) {
+        queue->maxDepth = command->maxDepth;
+    }
+    if (command->hasInhibitGet) {
+        queue->inhibitGet = command->inhibitGet;
+    }
+    if (command->hasInhibitPut) {
+        queue->inhibitPut = command->inhibitPut;
+    }
+    return MQRC_NONE;
+}
+
+static MQLONG sim_delete_queue(const SimCommand *command) {
+    if (!command->hasName) {
+        return MQRCCF_PARM_COUNT_TOO_SMALL;
+    }
+    SimQueue *queue = sim_find_queue(command->name);
+    if (queue == NULL) {
+        return MQRC_UNKNOWN_OBJECT_NAME;
+    }
+    if (queue->openHandles > 0 || queue->pending > 0) {
+        return MQRC_OBJECT_IN_USE;
+    }
+    if (queue->depth > 0 && command->purge != MQPO_YES) {
+        return MQRC_Q_NOT_EMPTY;
+    }
+    sim_remove_queue(queue);
+    sim_free_queue(queue);
+    return MQRC_NONE;
+}
+
+static MQLONG sim_clear_queue(const SimCommand *command) {
+    if (!command->hasName) {
+        return MQRCCF_PARM_COUNT_TOO_SMALL;
+    }
+    SimQueue *queue = sim_find_queue(command->name);
+    if (queue == NULL) {
+        return MQRC_UNKNOWN_OBJECT_NAME;
+    }
+    if (queue->type != MQQT_LOCAL) {
+        return MQRC_Q_TYPE_ERROR;
+    }
+    if (queue->openInput > 0 || queue->pending > 0) {
+        return MQRC_OBJECT_IN_USE;
+    }
+    while (queue->head != NULL) {
+        sim_unlink_message(queue, queue->head);
+    }
+    return MQRC_NONE;
+}
+
+// Run the command in a message that arrived on the command queue, then remove it
+static void sim_process_command(SimQueue *commandQueue, SimMessage *request) {
+    MQMD md = request->md;
+    SimCommand command;
+    MQLONG reason = MQRC_NONE;
+    bool isAdmin = memcmp(md.Format, "MQADMIN ", MQ_FORMAT_LENGTH) == 0;
+    if (isAdmin) {
+        reason = sim_decode_command(request->data, request->length, &command);
+    }
+    sim_unlink_message(commandQueue, request);
+    if (!isAdmin) {
+        return;
+    }
+
+    SimResponse response = { 0 };
+    if (reason != MQRC_NONE) {
+        sim_respond(&response, &command, &md, reason);
+    } else {
+        switch (command.command) {
+        case MQCMD_INQUIRE_Q:
+            sim_inquire_queues(&response, &command, &md, false);
+            break;
+        case MQCMD_INQUIRE_Q_STATUS:
+            sim_inquire_queues(&response, &command, &md, true);
+            break;
+        case MQCMD_CREATE_Q:
+            sim_respond(&response, &command, &md, sim_create_queue(&command));
+            break;
+        case MQCMD_CHANGE_Q:
+            sim_respond(&response, &command, &md, sim_change_queue(&command));
+            break;
+        case MQCMD_DELETE_Q:
+            sim_respond(&response, &command, &md, sim_delete_queue(&command));
+            break;
+        case MQCMD_CLEAR_Q:
+            sim_respond(&response, &command, &md, sim_clear_queue(&command));
+            break;
+        default:
+            sim_respond(&response, &command, &md, MQRCCF_CFH_COMMAND_ERROR);
+            break;
+        }
+    }
+    free(response.bytes);
+}
+
+// MARK: - Get
+
+// What a get looks for, copied from its descriptor and options before they
+// are overwritten with the message found
+typedef struct SimMatch {
+    MQLONG options;
+    MQLONG matchOptions;
+    MQBYTE msgId[MQ_MSG_ID_LENGTH];
+    MQBYTE correlId[MQ_CORREL_ID_LENGTH];
+    MQBYTE token[MQ_MSG_TOKEN_LENGTH];
+} SimMatch;
+
+static SimMatch sim_match(const MQMD *md, const MQGMO *gmo) {
+    SimMatch match;
+    match.options = gmo->Options;
+    match.matchOptions = gmo->Version >= MQGMO_VERSION_2
+        ? gmo->MatchOptions
+        : (MQMO_MATCH_MSG_ID | MQMO_MATCH_CORREL_ID);
+    if (gmo->Version < MQGMO_VERSION_3) {
+        match.matchOptions &= ~MQMO_MATCH_MSG_TOKEN;
+    }
+    memcpy(match.msgId, md->MsgId, sizeof(match.msgId));
+    memcpy(match.correlId, md->CorrelId, sizeof(match.correlId));
+    memcpy(match.token, gmo->MsgToken, sizeof(match.token));
+    return match;
+}
+
+static bool sim_matches(const SimMessage *message, const SimMatch *match) {
+    if (message->state != SIM_MSG_AVAILABLE) {
+        return false;
+    }
+    if ((match->matchOptions & MQMO_MATCH_MSG_ID) != 0 && !sim_is_zero(match->msgId, sizeof(match->msgId))
+        && memcmp(message->md.MsgId, match->msgId, sizeof(match->msgId)) != 0) {
+        return false;
+    }
+    if ((match->matchOptions & MQMO_MATCH_CORREL_ID) != 0 && !sim_is_zero(match->correlId, sizeof(match->correlId))
+        && memcmp(message->md.CorrelId, match->correlId, sizeof(match->correlId)) != 0) {
+        return false;
+    }
+    if ((match->matchOptions & MQMO_MATCH_MSG_TOKEN) != 0
+        && memcmp(message->token, match->token, sizeof(match->token)) != 0) {
+        return false;
+    }
+    return true;
+}
+
+static bool sim_is_browse(MQLONG options) {
+    return (options & (MQGMO_BROWSE_FIRST | MQGMO_BROWSE_NEXT | MQGMO_BROWSE_MSG_UNDER_CURSOR)) != 0;
+}
+
+static bool sim_uses_cursor(MQLONG options) {
+    return (options & (MQGMO_BROWSE_MSG_UNDER_CURSOR | MQGMO_MSG_UNDER_CURSOR)) != 0;
+}
+
+// Check that a handle can be read with the options of a get
+static MQLONG sim_check_get(const SimHandle *handle, MQLONG options) {
+    const SimQueue *queue = handle->queue;
+    MQLONG browseOptions = options & (MQGMO_BROWSE_FIRST | MQGMO_BROWSE_NEXT | MQGMO_BROWSE_MSG_UNDER_CURSOR);
+    if (browseOptions != 0 && (browseOptions & (browseOptions - 1)) != 0) {
+        return MQRC_OPTIONS_ERROR;
+    }
+    if (sim_is_browse(options) && (options & MQGMO_SYNCPOINT) != 0) {
+        return MQRC_OPTIONS_ERROR;
+    }
+    if (queue == NULL) {
+        return MQRC_NOT_OPEN_FOR_INPUT;
+    }
+    if (queue->deleted) {
+        return MQRC_Q_DELETED;
+    }
+    if ((sim_is_browse(options) || sim_uses_cursor(options)) && (handle->options & MQOO_BROWSE) == 0) {
+        return MQRC_NOT_OPEN_FOR_BROWSE;
+    }
+    if (!sim_is_browse(options) && (handle->options & (MQOO_INPUT_SHARED | MQOO_INPUT_EXCLUSIVE)) == 0) {
+        return MQRC_NOT_OPEN_FOR_INPUT;
+    }
+    if (queue->inhibitGet == MQQA_GET_INHIBITED) {
+        return MQRC_GET_INHIBITED;
+    }
+    return MQRC_NONE;
+}
+
+// Find the message a get returns, without changing anything
+static MQLONG sim_find_message(const SimHandle *handle, const SimMatch *match, SimMessage **found) {
+    *found = NULL;
+    if (sim_uses_cursor(match->options)) {
+        if (!handle->cursorValid || handle->cursor == NULL || handle->cursor->state != SIM_MSG_AVAILABLE) {
+            return MQRC_NO_MSG_UNDER_CURSOR;
+        }
+        *found = handle->cursor;
+        return MQRC_NONE;
+    }
+
+    SimMessage *message = handle->queue->head;
+    if ((match->options & MQGMO_BROWSE_NEXT) != 0 && handle->cursor != NULL) {
+        message = handle->cursor->next;
+    }
+    for (; message != NULL; message = message->next) {
+        if (sim_matches(message, match)) {
+            *found = message;
+            return MQRC_NONE;
+        }
+    }
+    return MQRC_NO_MSG_AVAILABLE;
+}
+
+// Return a message found by sim_find_message: copy it out, move the browse
+// cursor, or take it off the queue
+// - bufferLength: Bytes the caller can receive; the data length is always the full one
+static MQLONG sim_receive_message(
+    SimConnection *connection,
+    SimHandle *handle,
+    SimMessage *message,
+    MQLONG options,
+    MQMD *md,
+    MQGMO *gmo,
+    MQLONG bufferLength,
+    void *buffer,
+    MQLONG *dataLength
+) {
+    SimQueue *queue = handle->queue;
+    bool browse = sim_is_browse(options);
+    MQLONG copied = message->length < bufferLength ? message->length : bufferLength;
+
+    size_t descriptorLength = md->Version >= MQMD_VERSION_2 ? sizeof(MQMD) : offsetof(MQMD, GroupId);
+    memcpy(md, &message->md, descriptorLength);
+    sim_set_name(gmo->ResolvedQName, sizeof(gmo->ResolvedQName), queue->name);
+    if (gmo->Version >= MQGMO_VERSION_3) {
+        memcpy(gmo->MsgToken, message->token, sizeof(gmo->MsgToken));
+        gmo->ReturnedLength = copied;
+    }
+    if (copied > 0) {
+        memcpy(buffer, message->data, (size_t)copied);
+    }
+    *dataLength = message->length;
+
+    bool truncated = message->length > bufferLength;
+    if (browse || (truncated && (options & MQGMO_ACCEPT_TRUNCATED_MSG) == 0)) {
+        // A message too long to accept stays on the queue; a browse is positioned on it
+        if (browse) {
+            handle->cursor = message;
+            handle->cursorValid = true;
+        }
+        if (truncated) {
+            return (options & MQGMO_ACCEPT_TRUNCATED_MSG) != 0 ? MQRC_TRUNCATED_MSG_ACCEPTED : MQRC_TRUNCATED_MSG_FAILED;
+        }
+        return MQRC_NONE;
+    }
+
+    handle->context = message->md;
+    handle->hasContext = true;
+    if ((options & MQGMO_SYNCPOINT) != 0) {
+        if (sim_add_pending(connection, queue, message) != MQRC_NONE) {
+            return MQRC_STORAGE_NOT_AVAILABLE;
+        }
+        message->state = SIM_MSG_GET_PENDING;
+    } else {
+        sim_unlink_message(queue, message);
+    }
+    return truncated ? MQRC_TRUNCATED_MSG_ACCEPTED : MQRC_NONE;
+}
+
+// MARK: - Units of Work
+
+static void sim_end_unit_of_work(SimConnection *connection, bool commit) {
+    // Entries are taken off first: a command committed to the command queue
+    // puts responses, which must not see its own unit of work half done
+    SimPending *pending = connection->pending;
+    size_t count = connection->pendingCount;
+    connection->pending = NULL;
+    connection->pendingCount = 0;
+    connection->pendingCapacity = 0;
+
+    for (size_t index = 0; index < count; index++) {
+        SimQueue *queue = pending[index].queue;
+        SimMessage *message = pending[index].message;
+        queue->pending--;
+
+        if (message->state == SIM_MSG_PUT_PENDING) {
+            if (commit) {
+                message->state = SIM_MSG_AVAILABLE;
+                sim_message_available(queue, message);
+            } else {
+                sim_unlink_message(queue, message);
+            }
+        } else if (message->state == SIM_MSG_GET_PENDING) {
+            if (commit) {
+                sim_unlink_message(queue, message);
+            } else {
+                message->state = SIM_MSG_AVAILABLE;
+                message->md.BackoutCount++;
+            }
+        }
+    }
+    free(pending);
+    pthread_cond_broadcast(&sim.arrival);
+}
+
+// MARK: - Handles
+
+static void sim_close_handle(SimHandle *handle) {
+    SimQueue *queue = handle->queue;
+    handle->inUse = false;
+    handle->consumer = false;
+    if (queue == NULL) {
+        return;
+    }
+
+    if ((handle->options & (MQOO_INPUT_SHARED | MQOO_INPUT_EXCLUSIVE)) != 0) {
+        queue->openInput--;
+        if ((handle->options & MQOO_INPUT_EXCLUSIVE) != 0) {
+            queue->exclusive = false;
+        }
+    }
+    if ((handle->options & MQOO_OUTPUT) != 0) {
+        queue->openOutput--;
+    }
+    if ((handle->options & MQOO_BROWSE) != 0) {
+        queue->browsers--;
+    }
+    queue->openHandles--;
+
+    // A temporary dynamic queue ends with the handle that created it
+    if (handle->createdQueue && !queue->deleted) {
+        sim_remove_queue(queue);
+    }
+    if (queue->deleted && queue->openHandles == 0) {
+        sim_free_queue(queue);
+    }
+}
+
+static MQLONG sim_allocate_handle(MQHOBJ *pHobj) {
+    for (size_t index = 0; index < sim.handleCapacity; index++) {
+        if (!sim.handles[index].inUse) {
+            *pHobj = (MQHOBJ)index + 1;
+            return MQRC_NONE;
+        }
+    }
+    size_t capacity = sim.handleCapacity == 0 ? 64 : sim.handleCapacity * 2;
+    if (capacity > 0x7FFFFFFF) {
+        return MQRC_HANDLE_NOT_AVAILABLE;
+    }
+    SimHandle *handles = realloc(sim.handles, capacity * sizeof(SimHandle));
+    if (handles == NULL) {
+        return MQRC_STORAGE_NOT_AVAILABLE;
+    }
+    memset(handles + sim.handleCapacity, 0, (capacity - sim.handleCapacity) * sizeof(SimHandle));
+    *pHobj = (MQHOBJ)sim.handleCapacity + 1;
+    sim.handles = handles;
+    sim.handleCapacity = capacity;
+    return MQRC_NONE;
+}
+
+// Create a temporary dynamic queue from a model queue
+static MQLONG sim_create_dynamic_queue(const SimQueue *model, MQOD *od, SimQueue **created) {
+    char pattern[MQ_Q_NAME_LENGTH + 1];
+    sim_name(pattern, sizeof(pattern), od->DynamicQName, sizeof(od->DynamicQName));
+    size_t length = strlen(pattern);
+    if (length == 0) {
+        return MQRC_DYNAMIC_Q_NAME_ERROR;
+    }
+
+    char name[MQ_Q_NAME_LENGTH + 17];
+    if (pattern[length - 1] == '*') {
+        // The '*' becomes a name unique within the queue manager
+        pattern[length - 1] = '\0';
+        snprintf(name, sizeof(name), "%s%08X%08X", pattern, sim.epoch, (unsigned)++sim.dynamicQueueCounter);
+        name[MQ_Q_NAME_LENGTH] = '\0';
+    } else {
+        memcpy(name, pattern, length + 1);
+    }
+
+    MQLONG reason = sim_add_queue(name, MQQT_LOCAL, model->maxDepth, created);
+    if (reason != MQRC_NONE) {
+        return reason;
+    }
+    (*created)->temporary = true;
+    (*created)->inhibitGet = model->inhibitGet;
+    (*created)->inhibitPut = model->inhibitPut;
+    sim_set_name(od->ObjectName, sizeof(od->ObjectName), name);
+    return MQRC_NONE;
+}
+
+static MQLONG sim_open(MQHCONN hconn, MQOD *od, MQLONG options, MQHOBJ *pHobj) {
+    if (od == NULL) {
+        return MQRC_OD_ERROR;
+    }
+    MQLONG accessOptions = MQOO_INPUT_SHARED | MQOO_INPUT_EXCLUSIVE | MQOO_BROWSE | MQOO_OUTPUT | MQOO_INQUIRE | MQOO_SET;
+    if ((options & accessOptions) == 0
+        || (options & (MQOO_INPUT_SHARED | MQOO_INPUT_EXCLUSIVE)) == (MQOO_INPUT_SHARED | MQOO_INPUT_EXCLUSIVE)) {
+        return MQRC_OPTIONS_ERROR;
+    }
+
+    SimQueue *queue = NULL;
+    bool createdQueue = false;
+
+    if (od->ObjectType == MQOT_Q_MGR) {
+        if ((options & accessOptions & ~MQOO_INQUIRE) != 0) {
+            return MQRC_OPTIONS_ERROR;
+        }
+    } else if (od->ObjectType == MQOT_Q) {
+        char name[MQ_Q_NAME_LENGTH + 1];
+        sim_name(name, sizeof(name), od->ObjectName, sizeof(od->ObjectName));
+        queue = sim_find_queue(name);
+        if (queue == NULL) {
+            return MQRC_UNKNOWN_OBJECT_NAME;
+        }
+
+        bool inquireOnly = (options & accessOptions & ~MQOO_INQUIRE) == 0;
+        if (queue->type == MQQT_MODEL) {
+            MQLONG reason = sim_create_dynamic_queue(queue, od, &queue);
+            if (reason != MQRC_NONE) {
+                return reason;
+            }
+            createdQueue = true;
+        } else if (queue->type == MQQT_ALIAS && !inquireOnly) {
+            return MQRC_UNKNOWN_ALIAS_BASE_Q;
+        } else if (queue->type == MQQT_REMOTE && !inquireOnly) {
+            return MQRC_UNKNOWN_XMIT_Q;
+        }
+
+        bool input = (options & (MQOO_INPUT_SHARED | MQOO_INPUT_EXCLUSIVE)) != 0;
+        if (input && (queue->exclusive || ((options & MQOO_INPUT_EXCLUSIVE) != 0 && queue->openInput > 0))) {
+            return MQRC_OBJECT_IN_USE;
+        }
+    } else {
+        return MQRC_OBJECT_TYPE_ERROR;
+    }
+
+    MQLONG reason = sim_allocate_handle(pHobj);
+    if (reason != MQRC_NONE) {
+        if (createdQueue) {
+            sim_remove_queue(queue);
+            sim_free_queue(queue);
+        }
+        return reason;
+    }
+
+    SimHandle *handle = &sim.handles[*pHobj - 1];
+    memset(handle, 0, sizeof(*handle));
+    handle->inUse = true;
+    handle->hconn = hconn;
+    handle->queue = queue;
+    handle->options = options;
+    handle->createdQueue = createdQueue;
+
+    if (queue != NULL) {
+        queue->openHandles++;
+        if ((options & (MQOO_INPUT_SHARED | MQOO_INPUT_EXCLUSIVE)) != 0) {
+            queue->openInput++;
+            queue->exclusive = (options & MQOO_INPUT_EXCLUSIVE) != 0;
+        }
+        if ((options & MQOO_OUTPUT) != 0) {
+            queue->openOutput++;
+        }
+        if ((options & MQOO_BROWSE) != 0) {
+            queue->browsers++;
+        }
+        if (od->Version >= 3) {
+            sim_set_name(od->ResolvedQName, sizeof(od->ResolvedQName), queue->name);
+        }
+    }
+    return MQRC_NONE;
+}
+
+// MARK: - Message Consumers
+
+// Deliver at most one message to each started consumer of a connection
+// Called and returns with the lock held; releases it around each callback
+static bool sim_deliver_messages(MQHCONN hconn) {
+    bool delivered = false;
+
+    for (size_t index = 0; index < sim.handleCapacity; index++) {
+        SimConnection *connection = sim_connection(hconn);
+        if (connection == NULL || connection->stopping || connection->suspended) {
+            break;
+        }
+        SimHandle *handle = &sim.handles[index];
+        if (!handle->inUse || handle->hconn != hconn || !handle->consumer || handle->consumerSuspended) {
+            continue;
+        }
+
+        MQMD md = handle->consumerMD;
+        MQGMO gmo = handle->consumerGMO;
+        SimMatch match = sim_match(&md, &gmo);
+        SimMessage *message;
+        MQLONG reason = sim_check_get(handle, match.options);
+        if (reason == MQRC_NONE) {
+            reason = sim_find_message(handle, &match, &message);
+            if (reason == MQRC_NO_MSG_AVAILABLE) {
+                continue;
+            }
+        }
+
+        MQLONG bufferLength = 0;
+        void *buffer = NULL;
+        MQLONG dataLength = 0;
+        if (reason == MQRC_NONE) {
+            MQLONG maxLength = handle->callback.MaxMsgLength;
+            bufferLength = maxLength == MQCBD_FULL_MSG_LENGTH || maxLength > message->length ? message->length : maxLength;
+            buffer = malloc(bufferLength > 0 ? (size_t)bufferLength : 1);
+            if (buffer == NULL) {
+                reason = MQRC_STORAGE_NOT_AVAILABLE;
+            } else {
+                reason = sim_receive_message(connection, handle, message, match.options, &md, &gmo,
+                                             bufferLength, buffer, &dataLength);
+            }
+        }
+
+        // A message that cannot be delivered would be offered again at once
+        if (reason != MQRC_NONE && reason != MQRC_TRUNCATED_MSG_ACCEPTED) {
+            handle->consumerSuspended = true;
+        }
+
+        MQCBC context;
+        memset(&context, 0, sizeof(context));
+        memcpy(context.StrucId, "CBC ", sizeof(context.StrucId));
+        context.Version = MQCBC_VERSION_1;
+        context.CallType = sim_is_browse(match.options) ? MQCBCT_MSG_NOT_REMOVED : MQCBCT_MSG_REMOVED;
+        context.Hobj = (MQHOBJ)index + 1;
+        context.CallbackArea = handle->callback.CallbackArea;
+        sim_result(reason, &context.CompCode, &context.Reason);
+        context.DataLength = dataLength;
+        context.BufferLength = dataLength < bufferLength ? dataLength : bufferLength;
+        SimCallbackFunction function = (SimCallbackFunction)handle->callback.CallbackFunction;
+
+        pthread_mutex_unlock(&sim.lock);
+        function(hconn, &md, &gmo, buffer, &context);
+        free(buffer);
+        pthread_mutex_lock(&sim.lock);
+        delivered = true;
+    }
+    return delivered;
+}
+
+// Deliver messages until the connection stops; called with the lock held
+static void sim_run_consumers(MQHCONN hconn) {
+    for (;;) {
+        SimConnection *connection = sim_connection(hconn);
+        if (!sim.enabled || connection == NULL || connection->stopping) {
+            break;
+        }
+        if (!sim_deliver_messages(hconn)) {
+            sim_wait(NULL, true);
+        }
+    }
+}
+
+static void *sim_consumer_thread(void *argument) {
+    MQHCONN hconn = (MQHCONN)(intptr_t)argument;
+
+    pthread_mutex_lock(&sim.lock);
+    sim_run_consumers(hconn);
+    SimConnection *connection = sim_connection(hconn);
+    if (connection != NULL && connection->detachThread) {
+        // Stopped from a callback on this thread, so nobody joins it
+        connection->hasThread = false;
+        connection->detachThread = false;
+        pthread_detach(pthread_self());
+    }
+    pthread_mutex_unlock(&sim.lock);
+    return NULL;
+}
+
+// Stop a connection's consumers and wait for a callback in progress
+// Called with the lock held, which it releases while waiting
+static void sim_stop_consumers(SimConnection *connection) {
+    connection->stopping = true;
+    pthread_cond_broadcast(&sim.arrival);
+
+    if (connection->hasThread) {
+        if (pthread_equal(connection->thread, pthread_self())) {
+            connection->detachThread = true;
+        } else {
+            pthread_t thread = connection->thread;
+            connection->hasThread = false;
+            pthread_mutex_unlock(&sim.lock);
+            pthread_join(thread, NULL);
+            pthread_mutex_lock(&sim.lock);
+        }
+    }
+    connection->started = false;
+    connection->stopping = false;
+}
+
+// MARK: - Connections
+
+static void sim_disconnect(MQHCONN hconn, SimConnection *connection) {
+    if (connection->started) {
+        sim_stop_consumers(connection);
+    }
+
+    // A normal disconnect commits the unit of work
+    sim_end_unit_of_work(connection, true);
+
+    for (size_t index = 0; index < sim.handleCapacity; index++) {
+        if (sim.handles[index].inUse && sim.handles[index].hconn == hconn) {
+            sim_close_handle(&sim.handles[index]);
+        }
+    }
+    free(connection->pending);
+    memset(connection, 0, sizeof(*connection));
+}
+
+// Free every queue, handle and connection; called with the lock held and
+// no consumer threads left
+static void sim_free_all(void) {
+    for (size_t index = 0; index < SIM_MAX_CONNECTIONS; index++) {
+        free(sim.connections[index].pending);
+    }
+    memset(sim.connections, 0, sizeof(sim.connections));
+    for (size_t index = 0; index < sim.queueCount; index++) {
+        sim.queues[index]->pending = 0;
+        sim_free_queue(sim.queues[index]);
+    }
+
+    // Deleted queues still open are only reachable through their handles
+    for (size_t index = 0; index < sim.handleCapacity; index++) {
+        SimQueue *queue = sim.handles[index].inUse ? sim.handles[index].queue : NULL;
+        if (queue != NULL && queue->deleted) {
+            for (size_t other = index + 1; other < sim.handleCapacity; other++) {
+                if (sim.handles[other].queue == queue) {
+                    sim.handles[other].inUse = false;
+                }
+            }
+            queue->pending = 0;
+            sim_free_queue(queue);
+        }
+    }
+    free(sim.queues);
+    free(sim.handles);
+    sim.queues = NULL;
+    sim.queueCount = 0;
+    sim.queueCapacity = 0;
+    sim.handles = NULL;
+    sim.handleCapacity = 0;
+}
+
+// Stop every consumer thread; called with the lock held, released while joining
+static void sim_stop_all_consumers(void) {
+    for (size_t index = 0; index < SIM_MAX_CONNECTIONS; index++) {
+        SimConnection *connection = &sim.connections[index];
+        if (connection->inUse && connection->started) {
+            sim_stop_consumers(connection);
+        }
+    }
+}
+
+// MARK: - Configuration
+
+static void sim_enable_from_environment(void) {
+    const char *setting = getenv("MQMATE_SIMULATOR");
+    if (setting == NULL || setting[0] == '\0' || strcmp(setting, "0") == 0) {
+        return;
+    }
+    mqmate_sim_enable(NULL);
+
+    const char *latency = getenv("MQMATE_SIMULATOR_LATENCY_US");
+    if (latency != NULL) {
+        mqmate_sim_set_latency((MQLONG)strtol(latency, NULL, 10), 0);
+    }
+}
+
+bool mqmate_sim_enable(const char *queueManagerName) {
+    pthread_mutex_lock(&sim.lock);
+    if (sim.enabled) {
+        sim.enabled = false;
+        sim_stop_all_consumers();
+        sim_free_all();
+    }
+
+    // Handles of the previous run no longer match any connection
+    sim.epoch = sim.epoch % 0x7FFF + 1;
+    const char *name = queueManagerName != NULL && queueManagerName[0] != '\0' ? queueManagerName : "QM1";
+    snprintf(sim.queueManagerName, sizeof(sim.queueManagerName), "%s", name);
+    sim.idCounter = 0;
+    sim.dynamicQueueCounter = 0;
+    sim.latency = 0;
+    sim.jitter = 0;
+    sim.random = 0x9E3779B97F4A7C15ULL;
+    sim.commandServerStopped = false;
+    memset(sim.calls, 0, sizeof(sim.calls));
+    sim.lastGetOptions = 0;
+
+    sim_add_queue(SIM_COMMAND_QUEUE, MQQT_LOCAL, 0, NULL);
+    sim_add_queue("SYSTEM.DEFAULT.MODEL.QUEUE", MQQT_MODEL, SIM_MODEL_MAX_DEPTH, NULL);
+    sim_add_queue("SYSTEM.DEFAULT.LOCAL.QUEUE", MQQT_LOCAL, 0, NULL);
+    sim_add_queue("SYSTEM.DEAD.LETTER.QUEUE", MQQT_LOCAL, 0, NULL);
+    sim.enabled = true;
+    pthread_mutex_unlock(&sim.lock);
+    return true;
+}
+
+void mqmate_sim_disable(void) {
+    pthread_mutex_lock(&sim.lock);
+    if (sim.enabled) {
+        sim.enabled = false;
+        pthread_cond_broadcast(&sim.arrival);
+        sim_stop_all_consumers();
+        sim_free_all();
+    }
+    pthread_mutex_unlock(&sim.lock);
+}
+
+bool mqmate_sim_is_enabled(void) {
+    pthread_mutex_lock(&sim.lock);
+    bool enabled = sim.enabled;
+    pthread_mutex_unlock(&sim.lock);
+    return enabled;
+}
+
+void mqmate_sim_set_latency(MQLONG roundTripMicroseconds, MQLONG jitterMicroseconds) {
+    pthread_mutex_lock(&sim.lock);
+    sim.latency = roundTripMicroseconds > 0 ? roundTripMicroseconds : 0;
+    sim.jitter = jitterMicroseconds > 0 ? jitterMicroseconds : 0;
+    pthread_mutex_unlock(&sim.lock);
+}
+
+void mqmate_sim_set_command_server_running(bool running) {
+    pthread_mutex_lock(&sim.lock);
+    sim.commandServerStopped = !running;
+    pthread_mutex_unlock(&sim.lock);
+}
+
+// MARK: - Queue Setup
+
+MQLONG mqmate_sim_define_queue(const char *queueName, MQLONG queueType, MQLONG maxDepth) {
+    pthread_mutex_lock(&sim.lock);
+    MQLONG reason = sim.enabled ? sim_add_queue(queueName, queueType, maxDepth, NULL) : MQRC_Q_MGR_NOT_AVAILABLE;
+    pthread_mutex_unlock(&sim.lock);
+    return reason;
+}
+
+MQLONG mqmate_sim_put_messages(const char *queueName, MQLONG count, const void *payload, MQLONG length, const char *format) {
+    pthread_mutex_lock(&sim.lock);
+    MQLONG reason = MQRC_NONE;
+    SimQueue *queue = sim.enabled ? sim_find_queue(queueName) : NULL;
+    if (!sim.enabled) {
+        reason = MQRC_Q_MGR_NOT_AVAILABLE;
+    } else if (queue == NULL) {
+        reason = MQRC_UNKNOWN_OBJECT_NAME;
+    } else if (queue->type != MQQT_LOCAL) {
+        reason = MQRC_Q_TYPE_ERROR;
+    }
+
+    for (MQLONG index = 0; index < count && reason == MQRC_NONE; index++) {
+        MQMD md = mqmate_md_default();
+        const char *messageFormat = format != NULL ? format : "MQSTR";
+        mqmate_set_chars(md.Format, sizeof(md.Format), messageFormat, strlen(messageFormat));
+        reason = sim_put_message(queue, &md, MQPMO_NEW_MSG_ID, NULL, payload, length, NULL);
+    }
+    pthread_mutex_unlock(&sim.lock);
+    return reason;
+}
+
+MQLONG mqmate_sim_set_inhibited(const char *queueName, bool getInhibited, bool putInhibited) {
+    pthread_mutex_lock(&sim.lock);
+    SimQueue *queue = sim.enabled ? sim_find_queue(queueName) : NULL;
+    if (queue != NULL) {
+        queue->inhibitGet = getInhibited ? MQQA_GET_INHIBITED : MQQA_GET_ALLOWED;
+        queue->inhibitPut = putInhibited ? MQQA_PUT_INHIBITED : MQQA_PUT_ALLOWED;
+    }
+    pthread_mutex_unlock(&sim.lock);
+    return queue != NULL ? MQRC_NONE : MQRC_UNKNOWN_OBJECT_NAME;
+}
+
+MQLONG mqmate_sim_queue_depth(const char *queueName) {
+    pthread_mutex_lock(&sim.lock);
+    SimQueue *queue = sim.enabled ? sim_find_queue(queueName) : NULL;
+    MQLONG depth = queue != NULL ? queue->depth : -1;
+    pthread_mutex_unlock(&sim.lock);
+    return depth;
+}
+
+uint64_t mqmate_sim_call_count(MQLONG call) {
+    if (call < 0 || call >= MQMATE_SIM_CALL_COUNT) {
+        return 0;
+    }
+    pthread_mutex_lock(&sim.lock);
+    uint64_t count = sim.calls[call];
+    pthread_mutex_unlock(&sim.lock);
+    return count;
+}
+
+MQLONG mqmate_sim_last_get_options(void) {
+    pthread_mutex_lock(&sim.lock);
+    MQLONG options = sim.lastGetOptions;
+    pthread_mutex_unlock(&sim.lock);
+    return options;
+}
+
+// MARK: - MQI Entry Points
+
+void mqmate_sim_connx(MQCHAR *QMgrName, MQCNO *pConnectOpts, MQHCONN *pHconn, MQLONG *pCompCode, MQLONG *pReason) {
+    (void)QMgrName;
+    (void)pConnectOpts;
+    pthread_once(&simEnvironmentOnce, sim_enable_from_environment);
+    sim_round_trip(MQMATE_SIM_CALL_CONNX, true);
+
+    pthread_mutex_lock(&sim.lock);
+    MQLONG reason = MQRC_MAX_CONNS_LIMIT_REACHED;
+    *pHconn = MQHC_UNUSABLE_HCONN;
+    if (!sim.enabled) {
+        reason = MQRC_Q_MGR_NOT_AVAILABLE;
+    } else {
+        for (size_t index = 0; index < SIM_MAX_CONNECTIONS; index++) {
+            if (!sim.connections[index].inUse) {
+                memset(&sim.connections[index], 0, sizeof(SimConnection));
+                sim.connections[index].inUse = true;
+                *pHconn = (MQHCONN)((sim.epoch << 16) | (uint32_t)(index + 1));
+                reason = MQRC_NONE;
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&sim.lock);
+    sim_result(reason, pCompCode, pReason);
+}
+
+void mqmate_sim_disc(MQHCONN *pHconn, MQLONG *pCompCode, MQLONG *pReason) {
+    sim_round_trip(MQMATE_SIM_CALL_DISC, true);
+
+    pthread_mutex_lock(&sim.lock);
+    SimConnection *connection = sim.enabled ? sim_connection(*pHconn) : NULL;
+    MQLONG reason = MQRC_NONE;
+    if (connection != NULL) {
+        sim_disconnect(*pHconn, connection);
+    } else if (sim.enabled) {
+        reason = MQRC_HCONN_ERROR;
+    }
+    pthread_mutex_unlock(&sim.lock);
+
+    *pHconn = MQHC_UNUSABLE_HCONN;
+    sim_result(reason, pCompCode, pReason);
+}
+
+void mqmate_sim_open(MQHCONN Hconn, MQOD *pObjDesc, MQLONG Options, MQHOBJ *pHobj, MQLONG *pCompCode, MQLONG *pReason) {
+    *pHobj = MQHO_UNUSABLE_HOBJ;
+    if (sim_begin(MQMATE_SIM_CALL_OPEN, Hconn, true, pCompCode, pReason) == NULL) {
+        return;
+    }
+    MQLONG reason = sim_open(Hconn, pObjDesc, Options, pHobj);
+    if (reason != MQRC_NONE) {
+        *pHobj = MQHO_UNUSABLE_HOBJ;
+    }
+    pthread_mutex_unlock(&sim.lock);
+    sim_result(reason, pCompCode, pReason);
+}
+
+void mqmate_sim_close(MQHCONN Hconn, MQHOBJ *pHobj, MQLONG Options, MQLONG *pCompCode, MQLONG *pReason) {
+    (void)Options;
+    sim_round_trip(MQMATE_SIM_CALL_CLOSE, true);
+
+    pthread_mutex_lock(&sim.lock);
+    MQLONG reason = MQRC_NONE;
+    if (sim.enabled) {
+        SimHandle *handle = sim_connection(Hconn) != NULL ? sim_handle(Hconn, *pHobj) : NULL;
+        if (handle != NULL) {
+            sim_close_handle(handle);
+        } else {
+            reason = sim_connection(Hconn) != NULL ? MQRC_HOBJ_ERROR : MQRC_HCONN_ERROR;
+        }
+    }
+    pthread_mutex_unlock(&sim.lock);
+
+    *pHobj = MQHO_UNUSABLE_HOBJ;
+    sim_result(reason, pCompCode, pReason);
+}
+
+void mqmate_sim_get(MQHCONN Hconn, MQHOBJ Hobj, MQMD *pMsgDesc, MQGMO *pGetMsgOpts, MQLONG BufferLength,
+                    void *pBuffer, MQLONG *pDataLength, MQLONG *pCompCode, MQLONG *pReason) {
+    *pDataLength = 0;
+    SimConnection *connection = sim_begin(MQMATE_SIM_CALL_GET, Hconn, true, pCompCode, pReason);
+    if (connection == NULL) {
+        return;
+    }
+
+    MQLONG reason = MQRC_NONE;
+    if (pMsgDesc == NULL) {
+        reason = MQRC_MD_ERROR;
+    } else if (pGetMsgOpts == NULL) {
+        reason = MQRC_GMO_ERROR;
+    } else if (BufferLength < 0) {
+        reason = MQRC_BUFFER_LENGTH_ERROR;
+    } else if (BufferLength > 0 && pBuffer == NULL) {
+        reason = MQRC_BUFFER_ERROR;
+    }
+
+    if (reason == MQRC_NONE) {
+        sim.lastGetOptions = pGetMsgOpts->Options;
+        SimMatch match = sim_match(pMsgDesc, pGetMsgOpts);
+        bool waits = (match.options & MQGMO_WAIT) != 0 && pGetMsgOpts->WaitInterval != 0;
+        bool unlimited = pGetMsgOpts->WaitInterval == MQWI_UNLIMITED;
+        struct timespec deadline = sim_deadline(unlimited ? 0 : pGetMsgOpts->WaitInterval);
+
+        for (;;) {
+            // Everything is looked up again after a wait, which released the lock
+            connection = sim.enabled ? sim_connection(Hconn) : NULL;
+            SimHandle *handle = connection != NULL ? sim_handle(Hconn, Hobj) : NULL;
+            if (connection == NULL) {
+                reason = sim.enabled ? MQRC_HCONN_ERROR : MQRC_CONNECTION_BROKEN;
+                break;
+            }
+            if (handle == NULL) {
+                reason = MQRC_HOBJ_ERROR;
+                break;
+            }
+            reason = sim_check_get(handle, match.options);
+            if (reason != MQRC_NONE) {
+                break;
+            }
+
+            SimMessage *message;
+            reason = sim_find_message(handle, &match, &message);
+            if (reason == MQRC_NONE) {
+                reason = sim_receive_message(connection, handle, message, match.options, pMsgDesc, pGetMsgOpts,
+                                             BufferLength, pBuffer, pDataLength);
+                break;
+            }
+            if (reason != MQRC_NO_MSG_AVAILABLE || !waits || !sim_wait(&deadline, unlimited)) {
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&sim.lock);
+    sim_result(reason, pCompCode, pReason);
+}
+
+void mqmate_sim_put(MQHCONN Hconn, MQHOBJ Hobj, MQMD *pMsgDesc, MQPMO *pPutMsgOpts, MQLONG BufferLength,
+                    void *pBuffer, MQLONG *pCompCode, MQLONG *pReason) {
+    bool async = pPutMsgOpts != NULL && (pPutMsgOpts->Options & MQPMO_ASYNC_RESPONSE) != 0;
+    SimConnection *connection = sim_begin(MQMATE_SIM_CALL_PUT, Hconn, !async, pCompCode, pReason);
+    if (connection == NULL) {
+        return;
+    }
+
+    MQLONG reason = MQRC_NONE;
+    SimHandle *handle = sim_handle(Hconn, Hobj);
+    if (handle == NULL) {
+        reason = MQRC_HOBJ_ERROR;
+    } else if (pMsgDesc == NULL) {
+        reason = MQRC_MD_ERROR;
+    } else if (pPutMsgOpts == NULL) {
+        reason = MQRC_PMO_ERROR;
+    } else if (BufferLength < 0) {
+        reason = MQRC_BUFFER_LENGTH_ERROR;
+    } else if (BufferLength > 0 && pBuffer == NULL) {
+        reason = MQRC_BUFFER_ERROR;
+    } else if (handle->queue == NULL || (handle->options & MQOO_OUTPUT) == 0) {
+        reason = MQRC_NOT_OPEN_FOR_OUTPUT;
+    } else if (handle->queue->deleted) {
+        reason = MQRC_Q_DELETED;
+    }
+
+    if (reason == MQRC_NONE) {
+        const MQMD *context = NULL;
+        if ((pPutMsgOpts->Options & (MQPMO_PASS_ALL_CONTEXT | MQPMO_PASS_IDENTITY_CONTEXT)) != 0) {
+            SimHandle *contextHandle = sim_handle(Hconn, pPutMsgOpts->Context);
+            if (contextHandle == NULL) {
+                reason = MQRC_HOBJ_ERROR;
+            } else if (contextHandle->hasContext) {
+                context = &contextHandle->context;
+            }
+        }
+
+        if (reason == MQRC_NONE) {
+            SimQueue *queue = handle->queue;
+            reason = sim_put_message(queue, pMsgDesc, pPutMsgOpts->Options, context, pBuffer, BufferLength, connection);
+            sim_set_name(pPutMsgOpts->ResolvedQName, sizeof(pPutMsgOpts->ResolvedQName), queue->name);
+
+            // The queue manager's answer to an asynchronous put comes with the next MQSTAT
+            if (async) {
+                if (reason == MQRC_NONE) {
+                    connection->putSuccessCount++;
+                } else {
+                    if (connection->putFailureCount == 0) {
+                        connection->firstCompCode = MQCC_FAILED;
+                        connection->firstReason = reason;
+                        snprintf(connection->firstObjectName, sizeof(connection->firstObjectName), "%s", queue->name);
+                    }
+                    connection->putFailureCount++;
+                    reason = MQRC_NONE;
+                }
+            }
+        }
+    }
+    pthread_mutex_unlock(&sim.lock);
+    sim_result(reason, pCompCode, pReason);
+}
+
+void mqmate_sim_inq(MQHCONN Hconn, MQHOBJ Hobj, MQLONG SelectorCount, MQLONG *pSelectors, MQLONG IntAttrCount,
+                    MQLONG *pIntAttrs, MQLONG CharAttrLength, MQCHAR *pCharAttrs, MQLONG *pCompCode, MQLONG *pReason) {
+    if (sim_begin(MQMATE_SIM_CALL_INQ, Hconn, true, pCompCode, pReason) == NULL) {
+        return;
+    }
+
+    MQLONG reason = MQRC_NONE;
+    SimHandle *handle = sim_handle(Hconn, Hobj);
+    if (handle == NULL) {
+        reason = MQRC_HOBJ_ERROR;
+    } else if ((handle->options & MQOO_INQUIRE) == 0) {
+        reason = MQRC_NOT_OPEN_FOR_INQUIRE;
+    } else if (handle->queue != NULL && handle->queue->deleted) {
+        reason = MQRC_Q_DELETED;
+    } else if (SelectorCount < 0 || SelectorCount > 256) {
+        reason = MQRC_SELECTOR_COUNT_ERROR;
+    } else if (IntAttrCount < 0) {
+        reason = MQRC_INT_ATTR_COUNT_ERROR;
+    } else if (CharAttrLength < 0) {
+        reason = MQRC_CHAR_ATTR_LENGTH_ERROR;
+    }
+
+    MQLONG warning = MQRC_NONE;
+    MQLONG intIndex = 0;
+    MQLONG charOffset = 0;
+    for (MQLONG index = 0; index < SelectorCount && reason == MQRC_NONE; index++) {
+        MQLONG selector = pSelectors[index];
+        const SimQueue *queue = handle->queue;
+
+        if (selector == MQCA_Q_NAME || selector == MQCA_Q_MGR_NAME) {
+            if ((selector == MQCA_Q_NAME) != (queue != NULL)) {
+                reason = MQRC_SELECTOR_ERROR;
+                break;
+            }
+            if (charOffset + MQ_Q_NAME_LENGTH > CharAttrLength) {
+                warning = MQRC_CHAR_ATTRS_TOO_SHORT;
+            } else {
+                sim_set_name(pCharAttrs + charOffset, MQ_Q_NAME_LENGTH, queue != NULL ? queue->name : sim.queueManagerName);
+            }
+            charOffset += MQ_Q_NAME_LENGTH;
+            continue;
+        }
+
+        if (queue == NULL || !sim_is_queue_selector(selector)) {
+            reason = MQRC_SELECTOR_ERROR;
+            break;
+        }
+        MQLONG value;
+        if (!sim_queue_attribute(queue, selector, &value) && warning == MQRC_NONE) {
+            warning = MQRC_SELECTOR_NOT_FOR_TYPE;
+        }
+        if (intIndex < IntAttrCount) {
+            pIntAttrs[intIndex] = value;
+        } else {
+            warning = MQRC_INT_ATTR_COUNT_TOO_SMALL;
+        }
+        intIndex++;
+    }
+    pthread_mutex_unlock(&sim.lock);
+    sim_result(reason != MQRC_NONE ? reason : warning, pCompCode, pReason);
+}
+
+void mqmate_sim_cmit(MQHCONN Hconn, MQLONG *pCompCode, MQLONG *pReason) {
+    SimConnection *connection = sim_begin(MQMATE_SIM_CALL_CMIT, Hconn, true, pCompCode, pReason);
+    if (connection == NULL) {
+        return;
+    }
+    sim_end_unit_of_work(connection, true);
+    pthread_mutex_unlock(&sim.lock);
+}
+
+void mqmate_sim_back(MQHCONN Hconn, MQLONG *pCompCode, MQLONG *pReason) {
+    SimConnection *connection = sim_begin(MQMATE_SIM_CALL_BACK, Hconn, true, pCompCode, pReason);
+    if (connection == NULL) {
+        return;
+    }
+    sim_end_unit_of_work(connection, false);
+    pthread_mutex_unlock(&sim.lock);
+}
+
+void mqmate_sim_stat(MQHCONN Hconn, MQLONG Type, MQSTS *pStatus, MQLONG *pCompCode, MQLONG *pReason) {
+    SimConnection *connection = sim_begin(MQMATE_SIM_CALL_STAT, Hconn, true, pCompCode, pReason);
+    if (connection == NULL) {
+        return;
+    }
+
+    MQLONG reason = MQRC_NONE;
+    if (Type != MQSTAT_TYPE_ASYNC_ERROR) {
+        reason = MQRC_STAT_TYPE_ERROR;
+    } else if (pStatus == NULL) {
+        reason = MQRC_STS_ERROR;
+    } else {
+        memcpy(pStatus->StrucId, "STAT", sizeof(pStatus->StrucId));
+        pStatus->CompCode = connection->putFailureCount > 0 ? connection->firstCompCode : MQCC_OK;
+        pStatus->Reason = connection->putFailureCount > 0 ? connection->firstReason : MQRC_NONE;
+        pStatus->PutSuccessCount = connection->putSuccessCount;
+        pStatus->PutWarningCount = 0;
+        pStatus->PutFailureCount = connection->putFailureCount;
+        pStatus->ObjectType = MQOT_Q;
+        sim_set_name(pStatus->ObjectName, sizeof(pStatus->ObjectName), connection->firstObjectName);
+        memset(pStatus->ObjectQMgrName, ' ', sizeof(pStatus->ObjectQMgrName));
+        sim_set_name(pStatus->ResolvedObjectName, sizeof(pStatus->ResolvedObjectName), connection->firstObjectName);
+        memset(pStatus->ResolvedQMgrName, ' ', sizeof(pStatus->ResolvedQMgrName));
+
+        connection->putSuccessCount = 0;
+        connection->putFailureCount = 0;
+        connection->firstCompCode = MQCC_OK;
+        connection->firstReason = MQRC_NONE;
+        connection->firstObjectName[0] = '\0';
+    }
+    pthread_mutex_unlock(&sim.lock);
+    sim_result(reason, pCompCode, pReason);
+}
+
+void mqmate_sim_cb(MQHCONN Hconn, MQLONG Operation, MQCBD *pCallbackDesc, MQHOBJ Hobj, MQMD *pMsgDesc,
+                   MQGMO *pGetMsgOpts, MQLONG *pCompCode, MQLONG *pReason) {
+    if (sim_begin(MQMATE_SIM_CALL_CB, Hconn, true, pCompCode, pReason) == NULL) {
+        return;
+    }
+
+    MQLONG reason = MQRC_NONE;
+    bool eventHandler = (Operation & MQOP_REGISTER) != 0 && pCallbackDesc != NULL
+        && pCallbackDesc->CallbackType == MQCBT_EVENT_HANDLER;
+    SimHandle *handle = sim_handle(Hconn, Hobj);
+
+    if (eventHandler) {
+        // Event handlers are accepted; the simulator raises no events
+    } else if (handle == NULL) {
+        reason = MQRC_HOBJ_ERROR;
+    } else if ((Operation & MQOP_REGISTER) != 0) {
+        if (pCallbackDesc == NULL || pCallbackDesc->CallbackFunction == NULL
+            || pCallbackDesc->CallbackType != MQCBT_MESSAGE_CONSUMER) {
+            reason = MQRC_CBD_ERROR;
+        } else {
+            MQMD md = pMsgDesc != NULL ? *pMsgDesc : mqmate_md_default();
+            MQGMO gmo = pGetMsgOpts != NULL ? *pGetMsgOpts : mqmate_gmo_default();
+            reason = sim_check_get(handle, gmo.Options);
+            if (reason == MQRC_NONE) {
+                handle->consumer = true;
+                handle->consumerSuspended = false;
+                handle->callback = *pCallbackDesc;
+                handle->consumerMD = md;
+                handle->consumerGMO = gmo;
+                pthread_cond_broadcast(&sim.arrival);
+            }
+        }
+    } else if ((Operation & MQOP_DEREGISTER) != 0) {
+        handle->consumer = false;
+    } else if ((Operation & MQOP_SUSPEND) != 0) {
+        handle->consumerSuspended = true;
+    } else if ((Operation & MQOP_RESUME) != 0) {
+        handle->consumerSuspended = false;
+        pthread_cond_broadcast(&sim.arrival);
+    } else {
+        reason = MQRC_OPTIONS_ERROR;
+    }
+    pthread_mutex_unlock(&sim.lock);
+    sim_result(reason, pCompCode, pReason);
+}
+
+void mqmate_sim_ctl(MQHCONN Hconn, MQLONG Operation, MQCTLO *pControlOpts, MQLONG *pCompCode, MQLONG *pReason) {
+    (void)pControlOpts;
+    SimConnection *connection = sim_begin(MQMATE_SIM_CALL_CTL, Hconn, true, pCompCode, pReason);
+    if (connection == NULL) {
+        return;
+    }
+
+    MQLONG reason = MQRC_NONE;
+    switch (Operation) {
+    case MQOP_START:
+        if (!connection->started) {
+            connection->started = true;
+            connection->suspended = false;
+            if (pthread_create(&connection->thread, NULL, sim_consumer_thread, (void *)(intptr_t)Hconn) == 0) {
+                connection->hasThread = true;
+            } else {
+                connection->started = false;
+                reason = MQRC_STORAGE_NOT_AVAILABLE;
+            }
+        }
+        break;
+
+    case MQOP_START_WAIT:
+        // Delivers on the calling thread until a callback stops the connection
+        if (!connection->started) {
+            connection->started = true;
+            connection->suspended = false;
+            sim_run_consumers(Hconn);
+            connection = sim_connection(Hconn);
+            if (connection != NULL) {
+                connection->started = false;
+            }
+        }
+        break;
+
+    case MQOP_STOP:
+        if (connection->started) {
+            sim_stop_consumers(connection);
+        }
+        break;
+
+    case MQOP_SUSPEND:
+        connection->suspended = true;
+        break;
+
+    case MQOP_RESUME:
+        connection->suspended = false;
+        pthread_cond_broadcast(&sim.arrival);
+        break;
+
+    default:
+        reason = MQRC_OPTIONS_ERROR;
+        break;
+    }
+    pthread_mutex_unlock(&sim.lock);
+    sim_result(reason, pCompCode, pReason);
+}
+
+#else
+
+// MARK: - Real Client
+// MQI calls go to the IBM MQ client library; the simulator cannot be enabled
+
+bool mqmate_sim_enable(const char *queueManagerName) {
+    (void)queueManagerName;
+    return false;
+}
+
+void mqmate_sim_disable(void) {
+}
+
+bool mqmate_sim_is_enabled(void) {
+    return false;
+}
+
+void mqmate_sim_set_latency(MQLONG roundTripMicroseconds, MQLONG jitterMicroseconds) {
+    (void)roundTripMicroseconds;
+    (void)jitterMicroseconds;
+}
+
+void mqmate_sim_set_command_server_running(bool running) {
+    (void)running;
+}
+
+MQLONG mqmate_sim_define_queue(const char *queueName, MQLONG queueType, MQLONG maxDepth) {
+    (void)queueName;
+    (void)queueType;
+    (void)maxDepth;
+    return MQRC_Q_MGR_NOT_AVAILABLE;
+}
+
+MQLONG mqmate_sim_put_messages(const char *queueName, MQLONG count, const void *payload, MQLONG length, const char *format) {
+    (void)queueName;
+    (void)count;
+    (void)payload;
+    (void)length;
+    (void)format;
+    return MQRC_Q_MGR_NOT_AVAILABLE;
+}
+
+MQLONG mqmate_sim_set_inhibited(const char *queueName, bool getInhibited, bool putInhibited) {
+    (void)queueName;
+    (void)getInhibited;
+    (void)putInhibited;
+    return MQRC_Q_MGR_NOT_AVAILABLE;
+}
+
+MQLONG mqmate_sim_queue_depth(const char *queueName) {
+    (void)queueName;
+    return -1;
+}
+
+uint64_t mqmate_sim_call_count(MQLONG call) {
+    (void)call;
+    return 0;
+}
+
+MQLONG mqmate_sim_last_get_options(void) {
+    return 0;
+}
+
+#endif
@@ -15,7 +15,7 @@ struct ContentView: View {
     @State private var queueViewModel = QueueViewModel()
 
     /// The message view model for the detail column
-    @State private var messageViewModel = MessageViewModel()
+    @State private var messageViewModel = MessageViewModel(auditService: AuditService.shared)
 
     /// Selected connection ID (for sidebar)
     @State private var selectedConnectionId: UUID?
@@ -29,6 +29,13 @@ struct ContentView: View {
     /// Column visibility state for NavigationSplitView
     @State private var columnVisibility: NavigationSplitViewVisibility = .all
 
+    /// Whether previously used connections are reopened on launch
+    @AppStorage("autoConnectOnLaunch") private var autoConnectOnLaunch: Bool = false
+
+    /// Payload spill settings, applied to every browse
+    @AppStorage("payloadSpillThresholdKB") private var payloadSpillThresholdKB: Int = 64
+    @AppStorage("payloadMemoryBudgetMB") private var payloadMemoryBudgetMB: Int = 256
+
     // MARK: - Initialization
 
     init(connectionManager: ConnectionManager? = nil) {
@@ -76,6 +83,14 @@ struct ContentView: View {
         .onReceive(NotificationCenter.default.publisher(for: .refreshQueuesRequested)) { _ in
             handleRefreshQueuesRequest()
         }
+        .onAppear {
+            connectionManager.onQueuesUpdated = { connectionId, changedQueues in
+                handleQueuesUpdated(changedQueues, for: connectionId)
+            }
+        }
+        .task {
+            await reconnectOnLaunch()
+        }
     }
 
     // MARK: - Toolbar Buttons
@@ -84,9 +99,7 @@ struct ContentView: View {
     private var connectButton: some View {
         Button {
             guard let connectionId = selectedConnectionId else { return }
-            Task {
-                try? await connectionManager.connect(id: connectionId)
-            }
+            connectAndShowQueues(connectionId)
         } label: {
             Image(systemName: "bolt")
         }
@@ -143,17 +156,52 @@ struct ContentView: View {
             try? await connectionManager.refreshQueues(for: connectionId)
             // Update queue view model with refreshed queues
             let queues = connectionManager.queues(for: connectionId)
-            queueViewModel.setQueues(queues)
+            queueViewModel.setQueues(queues, histories: connectionManager.depthHistories(for: connectionId))
+        }
+    }
+
+    /// Select the most recently used connection at launch, if enabled in settings
+    /// Its saved queue list shows at once and it connects in the background;
+    /// other connections are only opened once they are selected
+    private func reconnectOnLaunch() async {
+        guard autoConnectOnLaunch, selectedConnectionId == nil else { return }
+
+        let lastUsed = connectionManager.savedConnections
+            .filter { $0.lastConnectedAt != nil }
+            .max { ($0.lastConnectedAt ?? .distantPast) < ($1.lastConnectedAt ?? .distantPast) }
+        selectedConnectionId = lastUsed?.id
+    }
+
+    /// Connect to a queue manager and, if it is still selected, replace the shown queues with live ones
+    /// - Parameter connectionId: The connection configuration ID
+    private func connectAndShowQueues(_ connectionId: UUID) {
+        Task {
+            guard (try? await connectionManager.connect(id: connectionId)) != nil,
+                  connectionId == selectedConnectionId else {
+                return
+            }
+            queueViewModel.reconcileQueues(
+                connectionManager.queues(for: connectionId),
+                histories: connectionManager.depthHistories(for: connectionId)
+            )
         }
     }
 
+    /// Handle queues whose depth changed, as reported by the connection's depth monitor
+    /// Only the changed rows of the selected connection are replaced
+    private func handleQueuesUpdated(_ changedQueues: [Queue], for connectionId: UUID) {
+        guard connectionId == selectedConnectionId else { return }
+        queueViewModel.updateQueues(changedQueues, histories: connectionManager.depthHistories(for: connectionId))
+    }
+
     // MARK: - Subviews
 
     /// Queue list content view
     @ViewBuilder
     private var queueListContent: some View {
         if let connectionId = selectedConnectionId,
-           connectionManager.isConnected(id: connectionId) {
+           connectionManager.isConnected(id: connectionId) || isShowingSnapshot(of: connectionId) {
+            // Live queues, or the last known ones while the connection is opened
             QueueListView(
                 queueViewModel: queueViewModel,
                 selection: $selectedQueueId
@@ -167,6 +215,12 @@ struct ContentView: View {
         }
     }
 
+    /// Whether a saved queue list stands in for a connection that is not open yet
+    /// A failed connection shows its error instead
+    private func isShowingSnapshot(of connectionId: UUID) -> Bool {
+        queueViewModel.snapshotDate != nil && connectionManager.connectionState(for: connectionId) != .error
+    }
+
     /// Message browser detail view
     @ViewBuilder
     private var messageBrowserDetail: some View {
@@ -219,9 +273,7 @@ struct ContentView: View {
                     }
                 } actions: {
                     Button {
-                        Task {
-                            try? await connectionManager.connect(id: connectionId)
-                        }
+                        connectAndShowQueues(connectionId)
                     } label: {
                         Text("Connect")
                     }
@@ -259,9 +311,7 @@ struct ContentView: View {
                     }
                 } actions: {
                     Button {
-                        Task {
-                            try? await connectionManager.connect(id: connectionId)
-                        }
+                        connectAndShowQueues(connectionId)
                     } label: {
                         Text("Retry")
                     }
@@ -298,10 +348,23 @@ struct ContentView: View {
         if connectionManager.isConnected(id: newConnectionId) {
             // Get queues from the queue manager
             let queues = connectionManager.queues(for: newConnectionId)
-            queueViewModel.setQueues(queues)
+            queueViewModel.setQueues(queues, histories: connectionManager.depthHistories(for: newConnectionId))
+            return
+        }
+
+        // Otherwise show the last known queues until the connection is open
+        if let snapshot = connectionManager.queueSnapshot(for: newConnectionId) {
+            queueViewModel.showSnapshot(snapshot)
         } else {
             queueViewModel.clearQueues()
         }
+
+        // Connections used before are opened lazily, once selected
+        let state = connectionManager.connectionState(for: newConnectionId)
+        let config = connectionManager.savedConnections.first { $0.id == newConnectionId }
+        if autoConnectOnLaunch, state == .disconnected, config?.lastConnectedAt != nil {
+            connectAndShowQueues(newConnectionId)
+        }
     }
 
     /// Handle queue selection changes
@@ -317,6 +380,10 @@ struct ContentView: View {
         }
 
         // Browse messages for the selected queue
+        messageViewModel.payloadSpillPolicy = PayloadSpillPolicy(
+            payloadThreshold: payloadSpillThresholdKB * 1024,
+            memoryBudget: payloadMemoryBudgetMB * 1024 * 1024
+        )
         Task {
             try? await messageViewModel.browseMessages(queueName: queueName)
         }
@@ -214,9 +214,9 @@ public enum MQQueueType: MQLong {
     /// Remote queue
     case remote = 6
     /// Model queue
-    case model = 7
+    case model = 2
     /// Cluster queue
-    case cluster = 8
+    case cluster = 7
 
     /// Unknown queue type
     case unknown = -1
@@ -226,9 +226,9 @@ public enum MQQueueType: MQLong {
         switch rawValue {
         case 1: self = .local
         case 3: self = .alias
+        case 2: self = .model
         case 6: self = .remote
-        case 7: self = .model
-        case 8: self = .cluster
+        case 7: self = .cluster
         default: self = .unknown
         }
     }
@@ -290,6 +290,10 @@ public struct MQOpenOptions: OptionSet {
     public static let setAttributes = MQOpenOptions(rawValue: 32)
     /// Fail if quiescing
     public static let failIfQuiescing = MQOpenOptions(rawValue: 8192)
+    /// Never send non-persistent messages ahead of the application
+    public static let noReadAhead = MQOpenOptions(rawValue: 524288)
+    /// Let the queue manager stream non-persistent messages to the client ahead of MQGET
+    public static let readAhead = MQOpenOptions(rawValue: 1048576)
 
     // C constant values
     public static let MQOO_INQUIRE: MQLong = 1
@@ -299,6 +303,9 @@ public struct MQOpenOptions: OptionSet {
     public static let MQOO_OUTPUT: MQLong = 16
     public static let MQOO_SET: MQLong = 32
     public static let MQOO_FAIL_IF_QUIESCING: MQLong = 8192
+    public static let MQOO_READ_AHEAD_AS_Q_DEF: MQLong = 0
+    public static let MQOO_NO_READ_AHEAD: MQLong = 524288
+    public static let MQOO_READ_AHEAD: MQLong = 1048576
 }
 
 // MARK: - Get Message Options
@@ -337,6 +344,52 @@ public struct MQGetMessageOptions: OptionSet {
     public static let MQGMO_FAIL_IF_QUIESCING: MQLong = 8192
 }
 
+// MARK: - Put Message Options
+
+/// MQ Put Message Options
+/// Maps to MQPMO_* constants from cmqc.h
+public struct MQPutMessageOptions: OptionSet {
+    public let rawValue: MQLong
+
+    public init(rawValue: MQLong) {
+        self.rawValue = rawValue
+    }
+
+    /// Put within a unit of work
+    public static let syncpoint = MQPutMessageOptions(rawValue: 2)
+    /// Put outside any unit of work
+    public static let noSyncpoint = MQPutMessageOptions(rawValue: 4)
+    /// Generate a new message ID
+    public static let newMessageId = MQPutMessageOptions(rawValue: 64)
+    /// Generate a new correlation ID
+    public static let newCorrelationId = MQPutMessageOptions(rawValue: 128)
+    /// Fail if quiescing
+    public static let failIfQuiescing = MQPutMessageOptions(rawValue: 8192)
+    /// Return without waiting for the queue manager; errors are collected with MQSTAT
+    public static let asyncResponse = MQPutMessageOptions(rawValue: 65536)
+    /// Wait for the queue manager to confirm every put
+    public static let syncResponse = MQPutMessageOptions(rawValue: 131072)
+
+    // C constant values
+    public static let MQPMO_SYNCPOINT: MQLong = 2
+    public static let MQPMO_NO_SYNCPOINT: MQLong = 4
+    public static let MQPMO_NEW_MSG_ID: MQLong = 64
+    public static let MQPMO_NEW_CORREL_ID: MQLong = 128
+    public static let MQPMO_FAIL_IF_QUIESCING: MQLong = 8192
+    public static let MQPMO_RESPONSE_AS_Q_DEF: MQLong = 0
+    public static let MQPMO_ASYNC_RESPONSE: MQLong = 65536
+    public static let MQPMO_SYNC_RESPONSE: MQLong = 131072
+}
+
+// MARK: - Status Types
+
+/// MQSTAT status types
+/// Maps to MQSTAT_TYPE_* constants from cmqc.h
+public enum MQStatusType {
+    /// Errors of asynchronous puts since the last MQSTAT
+    public static let MQSTAT_TYPE_ASYNC_ERROR: MQLong = 0
+}
+
 // MARK: - Connection Options
 
 /// MQ Connection Options
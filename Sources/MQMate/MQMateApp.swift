@@ -83,6 +83,12 @@ struct MQMateApp: App {
             }
         }
 
+        // MQI call statistics, listed in the Window menu
+        Window("MQI Diagnostics", id: "mqi-diagnostics") {
+            DiagnosticsView()
+        }
+        .defaultSize(width: 900, height: 420)
+
         // Settings window (Cmd+,)
         Settings {
             SettingsView()
@@ -183,13 +189,16 @@ struct GeneralSettingsTab: View {
     @AppStorage("autoConnectOnLaunch") private var autoConnectOnLaunch: Bool = false
     @AppStorage("refreshIntervalSeconds") private var refreshIntervalSeconds: Int = 30
     @AppStorage("confirmDestructiveActions") private var confirmDestructiveActions: Bool = true
+    @AppStorage("payloadSpillThresholdKB") private var payloadSpillThresholdKB: Int = 64
+    @AppStorage("payloadMemoryBudgetMB") private var payloadMemoryBudgetMB: Int = 256
 
     // MARK: - Body
 
     var body: some View {
         Form {
             Section {
-                Toggle("Auto-connect to last used connection on launch", isOn: $autoConnectOnLaunch)
+                Toggle("Reconnect to previously used connections on launch", isOn: $autoConnectOnLaunch)
+                    .help("Only the most recently used connection reconnects at launch; others connect when selected")
 
                 Toggle("Confirm destructive actions", isOn: $confirmDestructiveActions)
                     .help("Show confirmation dialogs before deleting connections or clearing queues")
@@ -205,6 +214,26 @@ struct GeneralSettingsTab: View {
                 }
                 .pickerStyle(.menu)
             }
+
+            Section("Message Memory") {
+                Picker("Spill payloads larger than:", selection: $payloadSpillThresholdKB) {
+                    Text("16 KB").tag(16)
+                    Text("64 KB").tag(64)
+                    Text("256 KB").tag(256)
+                    Text("1 MB").tag(1024)
+                }
+                .pickerStyle(.menu)
+                .help("Payloads of this size are kept in a temporary file instead of memory")
+
+                Picker("Keep in memory up to:", selection: $payloadMemoryBudgetMB) {
+                    Text("64 MB").tag(64)
+                    Text("256 MB").tag(256)
+                    Text("1 GB").tag(1024)
+                    Text("4 GB").tag(4096)
+                }
+                .pickerStyle(.menu)
+                .help("Once a browse holds this much payload data in memory, further payloads go to the temporary file")
+            }
         }
         .formStyle(.grouped)
         .padding()
@@ -48,6 +48,12 @@ public struct AuditEntry: Identifiable, Codable, Sendable, Equatable, Hashable {
         /// A message was sent to a queue
         case messageSent = "message_sent"
 
+        /// Messages were moved from a queue to another
+        case messagesMoved = "messages_moved"
+
+        /// Messages were copied from a queue to another
+        case messagesCopied = "messages_copied"
+
         /// Human-readable description of the action
         public var displayName: String {
             switch self {
@@ -61,6 +67,10 @@ public struct AuditEntry: Identifiable, Codable, Sendable, Equatable, Hashable {
                 return "Queue Created"
             case .messageSent:
                 return "Message Sent"
+            case .messagesMoved:
+                return "Messages Moved"
+            case .messagesCopied:
+                return "Messages Copied"
             }
         }
 
@@ -77,15 +87,19 @@ public struct AuditEntry: Identifiable, Codable, Sendable, Equatable, Hashable {
                 return "plus.rectangle"
             case .messageSent:
                 return "paperplane"
+            case .messagesMoved:
+                return "arrow.right.doc.on.clipboard"
+            case .messagesCopied:
+                return "doc.on.doc"
             }
         }
 
         /// Whether this action is considered destructive
         public var isDestructive: Bool {
             switch self {
-            case .messageDeleted, .queuePurged, .queueDeleted:
+            case .messageDeleted, .queuePurged, .queueDeleted, .messagesMoved:
                 return true
-            case .queueCreated, .messageSent:
+            case .queueCreated, .messageSent, .messagesCopied:
                 return false
             }
         }
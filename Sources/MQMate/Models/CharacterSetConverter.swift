@@ -0,0 +1,333 @@
+import Foundation
+
+// MARK: - Character Set Converter
+
+/// Client-side conversion of message data by CodedCharSetId and Encoding
+///
+/// Lets a browse skip MQGMO_CONVERT, so the queue manager sends payloads
+/// unchanged and only the payloads actually shown are converted. Converters
+/// are built once per CCSID and Encoding and cached.
+///
+/// EBCDIC code pages 037 and 500 (and their euro variants 1140 and 1148) map
+/// one-to-one onto Latin-1, so decoding is a lookup in a precomputed 256-entry
+/// table. EBCDIC text is mostly letters, digits and punctuation, which land in
+/// ASCII; the translated bytes are checked 16 at a time with SIMD and, when
+/// they are all ASCII, become a String without a further transcoding pass.
+/// UTF-8 and ASCII payloads are checked the same way before being decoded.
+public struct CharacterSetConverter: Sendable {
+
+    // MARK: - Types
+
+    /// How the bytes of a character set are decoded
+    private enum Decoding: Sendable {
+        case utf8
+        case latin1
+        case windows1252
+        case utf16(bigEndian: Bool)
+        case ebcdic(EBCDICTable)
+    }
+
+    /// Key of a cached converter
+    fileprivate struct Key: Hashable {
+        let ccsid: Int32
+        let integerEncoding: Int32
+    }
+
+    // MARK: - Constants
+
+    /// MQCCSI_Q_MGR: data in the queue manager's CCSID, unknown here
+    public static let queueManagerCCSID: Int32 = 0
+
+    /// UTF-8
+    public static let utf8CCSID: Int32 = 1208
+
+    /// MQENC_NATIVE on x86-64 and ARM64: reversed integers, IEEE reversed floats
+    public static let nativeEncoding: Int32 = 546
+
+    /// MQENC_INTEGER_REVERSED: little-endian integers, and UTF-16 code units
+    private static let integerReversed: Int32 = 0x2
+
+    /// MQENC_INTEGER_MASK
+    private static let integerMask: Int32 = 0xF
+
+    // MARK: - Properties
+
+    /// CodedCharSetId the converter reads
+    public let ccsid: Int32
+
+    /// Encoding the converter reads; only its integer part matters, for UTF-16
+    public let encoding: Int32
+
+    /// How bytes are decoded
+    private let decoding: Decoding
+
+    /// Converters built so far
+    private static let cache = ConverterCache()
+
+    // MARK: - Initialization
+
+    /// Build a converter, nil if the character set is not supported
+    private init?(ccsid: Int32, encoding: Int32) {
+        self.ccsid = ccsid
+        self.encoding = encoding
+
+        switch ccsid {
+        case Self.utf8CCSID, 367:
+            // ASCII (367) is a subset of UTF-8
+            decoding = .utf8
+        case 819:
+            decoding = .latin1
+        case 1252:
+            decoding = .windows1252
+        case 1200, 1202:
+            decoding = .utf16(bigEndian: encoding & Self.integerMask != Self.integerReversed)
+        case 37, 1140:
+            decoding = .ebcdic(.codePage037(withEuro: ccsid == 1140))
+        case 500, 1148:
+            decoding = .ebcdic(.codePage500(withEuro: ccsid == 1148))
+        default:
+            return nil
+        }
+    }
+
+    /// The cached converter for a CCSID and Encoding
+    /// - Parameters:
+    ///   - ccsid: CodedCharSetId of the data
+    ///   - encoding: Encoding of the data
+    /// - Returns: The converter, or nil if the character set is not supported
+    public static func converter(ccsid: Int32, encoding: Int32) -> CharacterSetConverter? {
+        let key = Key(ccsid: ccsid, integerEncoding: encoding & integerMask)
+        return cache.converter(for: key) {
+            CharacterSetConverter(ccsid: ccsid, encoding: encoding)
+        }
+    }
+
+    // MARK: - Decoding
+
+    /// Decode data in the converter's character set
+    /// - Parameter data: Bytes to decode
+    /// - Returns: The text, or nil if the bytes are not valid in the character set
+    public func decode(_ data: Data) -> String? {
+        switch decoding {
+        case .utf8:
+            return data.withUnsafeBytes { bytes in
+                Self.isASCII(bytes)
+                    ? String(decoding: bytes, as: UTF8.self)
+                    : String(validatingUTF8Bytes: bytes)
+            }
+        case .latin1:
+            return data.withUnsafeBytes { bytes in
+                Self.isASCII(bytes) ? String(decoding: bytes, as: UTF8.self) : String(data: data, encoding: .isoLatin1)
+            }
+        case .windows1252:
+            return String(data: data, encoding: .windowsCP1252)
+        case .utf16(let bigEndian):
+            return String(data: data, encoding: bigEndian ? .utf16BigEndian : .utf16LittleEndian)
+        case .ebcdic(let table):
+            return table.decode(data)
+        }
+    }
+
+    /// Encode text into the converter's character set
+    /// - Parameter string: Text to encode
+    /// - Returns: The bytes, or nil if a character cannot be represented
+    public func encode(_ string: String) -> Data? {
+        switch decoding {
+        case .utf8:
+            return Data(string.utf8)
+        case .latin1:
+            return string.data(using: .isoLatin1)
+        case .windows1252:
+            return string.data(using: .windowsCP1252)
+        case .utf16(let bigEndian):
+            return string.data(using: bigEndian ? .utf16BigEndian : .utf16LittleEndian)
+        case .ebcdic(let table):
+            return table.encode(string)
+        }
+    }
+
+    // MARK: - SIMD
+
+    /// Whether every byte is ASCII, testing 16 bytes per step
+    static func isASCII(_ bytes: UnsafeRawBufferPointer) -> Bool {
+        var combined = SIMD16<UInt8>(repeating: 0)
+        var offset = 0
+        while offset + 16 <= bytes.count {
+            combined |= bytes.loadUnaligned(fromByteOffset: offset, as: SIMD16<UInt8>.self)
+            offset += 16
+        }
+
+        var tail: UInt8 = 0
+        while offset < bytes.count {
+            tail |= bytes[offset]
+            offset += 1
+        }
+        return (combined.max() | tail) < 0x80
+    }
+}
+
+// MARK: - EBCDIC Table
+
+/// Lookup tables between one EBCDIC code page and Latin-1
+private final class EBCDICTable: Sendable {
+
+    /// Latin-1 byte of every EBCDIC byte
+    let toLatin1: [UInt8]
+
+    /// EBCDIC byte of every Latin-1 byte
+    let fromLatin1: [UInt8]
+
+    /// Whether 0x9F is the euro sign (CCSIDs 1140 and 1148) instead of the currency sign
+    let hasEuro: Bool
+
+    /// EBCDIC byte of the euro sign in the euro variants
+    static let euroByte: UInt8 = 0x9F
+
+    private init(toLatin1: [UInt8], hasEuro: Bool) {
+        self.toLatin1 = toLatin1
+        var fromLatin1 = [UInt8](repeating: 0, count: 256)
+        for (ebcdic, latin1) in toLatin1.enumerated() {
+            fromLatin1[Int(latin1)] = UInt8(ebcdic)
+        }
+        self.fromLatin1 = fromLatin1
+        self.hasEuro = hasEuro
+    }
+
+    private static let codePage037 = EBCDICTable(toLatin1: latin1Of037, hasEuro: false)
+    private static let codePage1140 = EBCDICTable(toLatin1: latin1Of037, hasEuro: true)
+    private static let codePage500 = EBCDICTable(toLatin1: latin1Of500, hasEuro: false)
+    private static let codePage1148 = EBCDICTable(toLatin1: latin1Of500, hasEuro: true)
+
+    static func codePage037(withEuro: Bool) -> EBCDICTable {
+        withEuro ? codePage1140 : codePage037
+    }
+
+    static func codePage500(withEuro: Bool) -> EBCDICTable {
+        withEuro ? codePage1148 : codePage500
+    }
+
+    // MARK: - Conversion
+
+    /// Decode EBCDIC bytes
+    func decode(_ data: Data) -> String? {
+        let translated = [UInt8](unsafeUninitializedCapacity: data.count) { buffer, initializedCount in
+            data.withUnsafeBytes { source in
+                toLatin1.withUnsafeBufferPointer { table in
+                    for index in 0..<source.count {
+                        buffer[index] = table[Int(source[index])]
+                    }
+                }
+            }
+            initializedCount = data.count
+        }
+
+        let isASCII = translated.withUnsafeBytes { CharacterSetConverter.isASCII($0) }
+        if isASCII {
+            return String(decoding: translated, as: UTF8.self)
+        }
+
+        // Latin-1 bytes are Unicode scalars below 256; only the euro sign lies outside
+        var scalars = String.UnicodeScalarView()
+        scalars.reserveCapacity(translated.count)
+        for (index, latin1) in translated.enumerated() {
+            if hasEuro && data[data.startIndex + index] == Self.euroByte {
+                scalars.append("\u{20AC}")
+            } else {
+                scalars.append(Unicode.Scalar(latin1))
+            }
+        }
+        return String(scalars)
+    }
+
+    /// Encode text as EBCDIC bytes
+    func encode(_ string: String) -> Data? {
+        var bytes = [UInt8]()
+        bytes.reserveCapacity(string.utf8.count)
+        for scalar in string.unicodeScalars {
+            if hasEuro && scalar == "\u{20AC}" {
+                bytes.append(Self.euroByte)
+            } else if scalar.value < 256 && !(hasEuro && scalar.value == 0xA4) {
+                bytes.append(fromLatin1[Int(scalar.value)])
+            } else {
+                return nil
+            }
+        }
+        return Data(bytes)
+    }
+
+    // MARK: - Tables
+
+    /// Latin-1 byte of every byte of CCSID 037 (EBCDIC US/Canada)
+    private static let latin1Of037: [UInt8] = [
+        0x00, 0x01, 0x02, 0x03, 0x9C, 0x09, 0x86, 0x7F, 0x97, 0x8D, 0x8E, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+        0x10, 0x11, 0x12, 0x13, 0x9D, 0x85, 0x08, 0x87, 0x18, 0x19, 0x92, 0x8F, 0x1C, 0x1D, 0x1E, 0x1F,
+        0x80, 0x81, 0x82, 0x83, 0x84, 0x0A, 0x17, 0x1B, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x05, 0x06, 0x07,
+        0x90, 0x91, 0x16, 0x93, 0x94, 0x95, 0x96, 0x04, 0x98, 0x99, 0x9A, 0x9B, 0x14, 0x15, 0x9E, 0x1A,
+        0x20, 0xA0, 0xE2, 0xE4, 0xE0, 0xE1, 0xE3, 0xE5, 0xE7, 0xF1, 0xA2, 0x2E, 0x3C, 0x28, 0x2B, 0x7C,
+        0x26, 0xE9, 0xEA, 0xEB, 0xE8, 0xED, 0xEE, 0xEF, 0xEC, 0xDF, 0x21, 0x24, 0x2A, 0x29, 0x3B, 0xAC,
+        0x2D, 0x2F, 0xC2, 0xC4, 0xC0, 0xC1, 0xC3, 0xC5, 0xC7, 0xD1, 0xA6, 0x2C, 0x25, 0x5F, 0x3E, 0x3F,
+        0xF8, 0xC9, 0xCA, 0xCB, 0xC8, 0xCD, 0xCE, 0xCF, 0xCC, 0x60, 0x3A, 0x23, 0x40, 0x27, 0x3D, 0x22,
+        0xD8, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0xAB, 0xBB, 0xF0, 0xFD, 0xFE, 0xB1,
+        0xB0, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F, 0x70, 0x71, 0x72, 0xAA, 0xBA, 0xE6, 0xB8, 0xC6, 0xA4,
+        0xB5, 0x7E, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0xA1, 0xBF, 0xD0, 0xDD, 0xDE, 0xAE,
+        0x5E, 0xA3, 0xA5, 0xB7, 0xA9, 0xA7, 0xB6, 0xBC, 0xBD, 0xBE, 0x5B, 0x5D, 0xAF, 0xA8, 0xB4, 0xD7,
+        0x7B, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0xAD, 0xF4, 0xF6, 0xF2, 0xF3, 0xF5,
+        0x7D, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, 0x50, 0x51, 0x52, 0xB9, 0xFB, 0xFC, 0xF9, 0xFA, 0xFF,
+        0x5C, 0xF7, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0xB2, 0xD4, 0xD6, 0xD2, 0xD3, 0xD5,
+        0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0xB3, 0xDB, 0xDC, 0xD9, 0xDA, 0x9F
+    ]
+
+    /// Latin-1 byte of every byte of CCSID 500 (EBCDIC International), which
+    /// differs from 037 only in where some punctuation sits
+    private static let latin1Of500: [UInt8] = {
+        var table = latin1Of037
+        let differences: [Int: UInt8] = [
+        0x4A: 0x5B,
+        0x4F: 0x21,
+        0x5A: 0x5D,
+        0x5F: 0x5E,
+        0xB0: 0xA2,
+        0xBA: 0xAC,
+        0xBB: 0x7C
+        ]
+        for (ebcdic, latin1) in differences {
+            table[ebcdic] = latin1
+        }
+        return table
+    }()
+}
+
+// MARK: - Converter Cache
+
+/// Converters by CCSID and integer encoding, shared by all threads
+private final class ConverterCache: @unchecked Sendable {
+
+    /// Guards converters
+    private let lock = NSLock()
+
+    /// Converters built so far; nil for unsupported character sets
+    private var converters: [CharacterSetConverter.Key: CharacterSetConverter?] = [:]
+
+    /// The cached converter for a key, built on first use
+    func converter(for key: CharacterSetConverter.Key, make: () -> CharacterSetConverter?) -> CharacterSetConverter? {
+        lock.lock()
+        defer { lock.unlock() }
+
+        if let converter = converters[key] {
+            return converter
+        }
+        let converter = make()
+        converters[key] = converter
+        return converter
+    }
+}
+
+// MARK: - UTF-8 Validation
+
+private extension String {
+    /// Decode UTF-8 bytes, nil if they are not valid UTF-8
+    init?(validatingUTF8Bytes bytes: UnsafeRawBufferPointer) {
+        guard let string = String(bytes: bytes, encoding: .utf8) else { return nil }
+        self = string
+    }
+}
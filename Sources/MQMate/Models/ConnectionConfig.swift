@@ -30,6 +30,16 @@ public struct ConnectionConfig: Identifiable, Codable, Sendable, Equatable, Hash
     /// Password is stored separately in Keychain using the connection ID as the key
     public var username: String?
 
+    /// Number of messages a browse stream reads ahead of the viewer (nil or 0 for none)
+    /// When set, the stream's queue is opened with MQOO_READ_AHEAD so the queue
+    /// manager sends non-persistent messages without waiting for each MQGET
+    public var readAheadDepth: Int?
+
+    /// Whether browses ask the queue manager to convert payloads (nil for yes)
+    /// Turning it off delivers payloads as stored, to be decoded on the client
+    /// by their CodedCharSetId and Encoding
+    public var convertsBrowsedData: Bool?
+
     /// Date when this configuration was created
     public let createdAt: Date
 
@@ -50,6 +60,8 @@ public struct ConnectionConfig: Identifiable, Codable, Sendable, Equatable, Hash
     ///   - port: Port number (defaults to 1414)
     ///   - channel: Server connection channel name
     ///   - username: Optional username for authentication
+    ///   - readAheadDepth: Messages a browse stream reads ahead (nil for none)
+    ///   - convertsBrowsedData: Whether browses use MQGMO_CONVERT (nil for yes)
     public init(
         id: UUID = UUID(),
         name: String,
@@ -57,7 +69,9 @@ public struct ConnectionConfig: Identifiable, Codable, Sendable, Equatable, Hash
         hostname: String,
         port: Int = 1414,
         channel: String,
-        username: String? = nil
+        username: String? = nil,
+        readAheadDepth: Int? = nil,
+        convertsBrowsedData: Bool? = nil
     ) {
         self.id = id
         self.name = name
@@ -66,6 +80,8 @@ public struct ConnectionConfig: Identifiable, Codable, Sendable, Equatable, Hash
         self.port = port
         self.channel = channel
         self.username = username
+        self.readAheadDepth = readAheadDepth
+        self.convertsBrowsedData = convertsBrowsedData
         self.createdAt = Date()
         self.modifiedAt = Date()
         self.lastConnectedAt = nil
@@ -95,6 +111,7 @@ public struct ConnectionConfig: Identifiable, Codable, Sendable, Equatable, Hash
         case portInvalid = "Port must be between 1 and 65535"
         case channelEmpty = "Channel name cannot be empty"
         case channelTooLong = "Channel name cannot exceed 20 characters"
+        case readAheadDepthInvalid = "Read-ahead depth cannot be negative"
 
         public var localizedDescription: String {
             rawValue
@@ -137,6 +154,11 @@ public struct ConnectionConfig: Identifiable, Codable, Sendable, Equatable, Hash
             errors.append(.channelTooLong)
         }
 
+        // Validate read-ahead depth
+        if let readAheadDepth, readAheadDepth < 0 {
+            errors.append(.readAheadDepthInvalid)
+        }
+
         return ValidationResult(isValid: errors.isEmpty, errors: errors)
     }
 
@@ -196,7 +218,9 @@ public struct ConnectionConfig: Identifiable, Codable, Sendable, Equatable, Hash
             hostname: hostname,
             port: port,
             channel: channel,
-            username: username
+            username: username,
+            readAheadDepth: readAheadDepth,
+            convertsBrowsedData: convertsBrowsedData
         )
     }
 }
@@ -212,6 +236,8 @@ extension ConnectionConfig {
         case port
         case channel
         case username
+        case readAheadDepth
+        case convertsBrowsedData
         case createdAt
         case modifiedAt
         case lastConnectedAt
@@ -297,6 +297,79 @@ public enum MQError: Error, LocalizedError, Equatable, Sendable {
         }
     }
 
+    // MARK: - Classification
+
+    /// Whether the error means the connection handle itself is no longer usable
+    /// A connection pool discards the connection instead of reusing it
+    public var isConnectionLost: Bool {
+        switch self {
+        case .connectionBroken, .connectionQuiescing:
+            return true
+        case .operationFailed(_, _, let reasonCode), .unknown(let reasonCode):
+            switch reasonCode {
+            case MQError.MQRC_CONNECTION_BROKEN, MQError.MQRC_HCONN_ERROR,
+                 MQError.MQRC_CONNECTION_QUIESCING, MQError.MQRC_CONNECTION_STOPPING,
+                 MQError.MQRC_Q_MGR_NOT_AVAILABLE:
+                return true
+            default:
+                return false
+            }
+        default:
+            return false
+        }
+    }
+
+    /// Whether the error means no message matched a get, e.g. one consumed since it was browsed
+    public var isNoMessageAvailable: Bool {
+        switch self {
+        case .noMessageAvailable:
+            return true
+        case .operationFailed(_, _, let reasonCode), .unknown(let reasonCode):
+            return reasonCode == MQError.MQRC_NO_MSG_AVAILABLE
+        default:
+            return false
+        }
+    }
+
+    /// Whether the error means a PCF command was not carried out although the MQI
+    /// may still do the same work: no command server answered, the command queue
+    /// takes no more commands, or the command was refused for an open or alias queue
+    /// Errors the MQI would hit as well, such as MQRC_NOT_AUTHORIZED, are not included
+    public var isCommandUnavailable: Bool {
+        switch self {
+        case .noMessageAvailable, .objectInUse:
+            return true
+        case .operationFailed(_, _, let reasonCode), .unknown(let reasonCode):
+            switch reasonCode {
+            case MQError.MQRC_NO_MSG_AVAILABLE, MQError.MQRC_OBJECT_IN_USE, MQError.MQRC_Q_TYPE_ERROR,
+                 MQError.MQRC_PUT_INHIBITED, MQError.MQRC_Q_FULL:
+                return true
+            default:
+                return false
+            }
+        default:
+            return false
+        }
+    }
+
+    /// Whether the error means an open object handle can no longer be used
+    /// True for a lost connection and for objects changed or deleted since
+    /// MQOPEN; the handle must then be closed and the object reopened
+    public var invalidatesObjectHandle: Bool {
+        if isConnectionLost {
+            return true
+        }
+        guard case .operationFailed(_, _, let reasonCode) = self else {
+            return false
+        }
+        switch reasonCode {
+        case MQError.MQRC_OBJECT_CHANGED, MQError.MQRC_HOBJ_ERROR, MQError.MQRC_Q_DELETED:
+            return true
+        default:
+            return false
+        }
+    }
+
     // MARK: - Factory Methods
 
     /// Create an MQError from an IBM MQ reason code with context
@@ -546,6 +619,10 @@ public enum MQError: Error, LocalizedError, Equatable, Sendable {
             return "TLS/SSL peer name mismatch"
         case MQRC_SSL_PEER_NAME_ERROR:
             return "TLS/SSL peer name error"
+        case MQRC_SELECTOR_SYNTAX_ERROR:
+            return "Message selector syntax error"
+        case MQRC_SELECTION_STRING_ERROR:
+            return "Selection string error"
         default:
             return "Unknown reason code (\(reasonCode))"
         }
@@ -828,4 +905,10 @@ public enum MQError: Error, LocalizedError, Equatable, Sendable {
 
     /// SSL peer name error (2399)
     public static let MQRC_SSL_PEER_NAME_ERROR: Int32 = 2399
+
+    /// Message selector syntax error (2459)
+    public static let MQRC_SELECTOR_SYNTAX_ERROR: Int32 = 2459
+
+    /// Selection string error (2519)
+    public static let MQRC_SELECTION_STRING_ERROR: Int32 = 2519
 }
@@ -158,8 +158,13 @@ public struct Message: Identifiable, Sendable, Equatable, Hashable {
     public let messageFormat: MessageFormat
 
     /// Message payload as raw data
+    /// For a message listed from a preview browse this holds only the first
+    /// bytes; see isPayloadTruncated
     public let payload: Data
 
+    /// Full length of the message data on the queue
+    public let payloadLength: Int
+
     /// Timestamp when message was put to the queue
     public let putDateTime: Date?
 
@@ -187,6 +192,12 @@ public struct Message: Identifiable, Sendable, Equatable, Hashable {
     /// Position of this message in the queue (0-based index)
     public let position: Int
 
+    /// CodedCharSetId of the payload
+    public let codedCharSetId: Int32
+
+    /// Encoding of the payload (byte order of integers and UTF-16 text)
+    public let encoding: Int32
+
     // MARK: - Initialization
 
     /// Create a new Message instance with all properties
@@ -195,6 +206,7 @@ public struct Message: Identifiable, Sendable, Equatable, Hashable {
     ///   - correlationId: Correlation ID bytes (24 bytes)
     ///   - format: Message format string
     ///   - payload: Message payload data
+    ///   - payloadLength: Full length of the message data (defaults to the payload size)
     ///   - putDateTime: When the message was put to the queue
     ///   - putApplicationName: Application that put the message
     ///   - messageType: Type of message
@@ -204,11 +216,14 @@ public struct Message: Identifiable, Sendable, Equatable, Hashable {
     ///   - replyToQueueManager: Reply-to queue manager name
     ///   - messageSequenceNumber: Sequence number in group
     ///   - position: Position in queue
+    ///   - codedCharSetId: CodedCharSetId of the payload
+    ///   - encoding: Encoding of the payload
     public init(
         messageId: [UInt8],
         correlationId: [UInt8],
         format: String,
         payload: Data,
+        payloadLength: Int? = nil,
         putDateTime: Date?,
         putApplicationName: String,
         messageType: MessageType = .datagram,
@@ -217,7 +232,9 @@ public struct Message: Identifiable, Sendable, Equatable, Hashable {
         replyToQueue: String = "",
         replyToQueueManager: String = "",
         messageSequenceNumber: Int32 = 1,
-        position: Int = 0
+        position: Int = 0,
+        codedCharSetId: Int32 = CharacterSetConverter.utf8CCSID,
+        encoding: Int32 = CharacterSetConverter.nativeEncoding
     ) {
         self.messageId = messageId
         self.correlationId = correlationId
@@ -225,6 +242,7 @@ public struct Message: Identifiable, Sendable, Equatable, Hashable {
         self.format = format
         self.messageFormat = MessageFormat(formatString: format)
         self.payload = payload
+        self.payloadLength = max(payloadLength ?? payload.count, payload.count)
         self.putDateTime = putDateTime
         self.putApplicationName = putApplicationName
         self.messageType = messageType
@@ -234,6 +252,8 @@ public struct Message: Identifiable, Sendable, Equatable, Hashable {
         self.replyToQueueManager = replyToQueueManager
         self.messageSequenceNumber = messageSequenceNumber
         self.position = position
+        self.codedCharSetId = codedCharSetId
+        self.encoding = encoding
     }
 
     // MARK: - Computed Properties
@@ -263,24 +283,48 @@ public struct Message: Identifiable, Sendable, Equatable, Hashable {
         !correlationId.allSatisfy { $0 == 0 }
     }
 
-    /// Payload as a UTF-8 string (if decodable)
+    /// Payload as a string, decoded by its CCSID (if decodable)
+    /// Payloads in a character set without a converter, or in the queue
+    /// manager's CCSID, are read as UTF-8
     public var payloadString: String? {
-        String(data: payload, encoding: .utf8)
+        let converter = CharacterSetConverter.converter(ccsid: codedCharSetId, encoding: encoding)
+            ?? CharacterSetConverter.converter(ccsid: CharacterSetConverter.utf8CCSID, encoding: encoding)
+        if let string = converter?.decode(payload) {
+            return string
+        }
+        // A preview may end partway through a multi-byte character
+        guard isPayloadTruncated, !payload.isEmpty else { return nil }
+        for dropped in 1...min(3, payload.count) {
+            if let string = converter?.decode(payload.dropLast(dropped)) {
+                return string
+            }
+        }
+        return nil
+    }
+
+    /// Whether only the first part of the payload has been loaded
+    public var isPayloadTruncated: Bool {
+        payloadLength > payload.count
     }
 
-    /// Payload size in bytes
+    /// Payload size in bytes (of the full message, even when only a preview is loaded)
     public var payloadSize: Int {
-        payload.count
+        payloadLength
     }
 
     /// Formatted payload size for display (e.g., "1.2 KB")
     public var payloadSizeFormatted: String {
-        ByteCountFormatter.string(fromByteCount: Int64(payload.count), countStyle: .file)
+        ByteCountFormatter.string(fromByteCount: Int64(payloadSize), countStyle: .file)
     }
 
     /// Check if payload appears to be binary (contains non-printable characters)
     public var isBinaryPayload: Bool {
-        guard let string = payloadString else { return true }
+        Self.isBinary(decoded: payloadString)
+    }
+
+    /// Whether decoded payload text looks binary: undecodable, or less than 80% printable
+    static func isBinary(decoded string: String?) -> Bool {
+        guard let string else { return true }
         // Check if the string contains mostly printable characters
         let printableSet = CharacterSet.alphanumerics
             .union(.punctuationCharacters)
@@ -292,34 +336,68 @@ public struct Message: Identifiable, Sendable, Equatable, Hashable {
 
     /// Payload as hex dump for binary content
     public var payloadHexDump: String {
+        Self.hexDump(of: payload, in: 0..<payload.count)
+    }
+
+    /// Hex dump of a range of payload bytes: per 16 bytes, the offset, the
+    /// bytes in hex and their printable ASCII characters
+    /// - Parameters:
+    ///   - payload: The payload, indexed from zero
+    ///   - range: The bytes to dump; lines start at its lower bound
+    /// - Returns: The lines, separated by newlines
+    static func hexDump(of payload: Data, in range: Range<Int>) -> String {
         let bytesPerLine = 16
-        var lines: [String] = []
+        let digits = Array("0123456789ABCDEF".utf8)
+        let space = UInt8(ascii: " ")
 
-        for offset in stride(from: 0, to: payload.count, by: bytesPerLine) {
-            let lineBytes = payload[offset..<min(offset + bytesPerLine, payload.count)]
+        // Built as bytes: formatting every byte as a String is what makes
+        // dumps of large payloads slow
+        var output: [UInt8] = []
+        output.reserveCapacity((range.count + bytesPerLine - 1) / bytesPerLine * (12 + 4 * bytesPerLine))
+
+        for offset in stride(from: range.lowerBound, to: range.upperBound, by: bytesPerLine) {
+            if offset > range.lowerBound {
+                output.append(UInt8(ascii: "\n"))
+            }
+            let lineBytes = payload[offset..<min(offset + bytesPerLine, range.upperBound)]
 
-            // Hex part
-            let hex = lineBytes.map { String(format: "%02X", $0) }.joined(separator: " ")
+            // Offset
+            for shift in stride(from: 28, through: 0, by: -4) {
+                output.append(digits[(offset >> shift) & 0xF])
+            }
+            output.append(contentsOf: [space, space])
+
+            // Hex part, padded to a full line
+            for (column, byte) in lineBytes.enumerated() {
+                if column > 0 {
+                    output.append(space)
+                }
+                output.append(digits[Int(byte >> 4)])
+                output.append(digits[Int(byte & 0xF)])
+            }
+            output.append(contentsOf: repeatElement(space, count: 3 * (bytesPerLine - lineBytes.count)))
 
             // ASCII part
-            let ascii = lineBytes.map { byte -> String in
-                let char = Character(UnicodeScalar(byte))
-                return char.isASCII && !char.isNewline && byte >= 32 && byte < 127
-                    ? String(char)
-                    : "."
-            }.joined()
-
-            // Offset + hex + padding + ASCII
-            let padding = String(repeating: "   ", count: max(0, bytesPerLine - lineBytes.count))
-            lines.append(String(format: "%08X  %@%@  |%@|", offset, hex, padding, ascii))
+            output.append(contentsOf: [space, space, UInt8(ascii: "|")])
+            output.append(contentsOf: lineBytes.map { (32..<127).contains($0) ? $0 : UInt8(ascii: ".") })
+            output.append(UInt8(ascii: "|"))
         }
 
-        return lines.joined(separator: "\n")
+        return String(decoding: output, as: UTF8.self)
     }
 
     /// Payload preview (first 100 characters or hex if binary)
     public var payloadPreview: String {
-        if let string = payloadString, !isBinaryPayload {
+        let string = payloadString
+        return Self.preview(of: payload, text: Self.isBinary(decoded: string) ? nil : string)
+    }
+
+    /// Preview of a payload: the first 100 characters of its text, or its first 50 bytes in hex
+    /// - Parameters:
+    ///   - payload: The payload
+    ///   - text: The decoded payload, nil if it is binary
+    static func preview(of payload: Data, text: String?) -> String {
+        if let string = text {
             let preview = string.prefix(100)
             return preview.count < string.count ? "\(preview)..." : String(preview)
         } else {
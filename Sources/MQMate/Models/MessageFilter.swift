@@ -0,0 +1,164 @@
+import Foundation
+
+// MARK: - Message Filter
+
+/// Message list filter parsed from the filter bar
+///
+/// Terms the queue manager can evaluate are compiled into an
+/// MQService.MessageSelector, so a browse transfers only matching messages;
+/// whatever is left is free text matched against the messages already loaded.
+///
+/// Recognised terms, separated by whitespace:
+/// - `msgid:<hex>` and `correlid:<hex>`, matched with MQMO_MATCH_MSG_ID/MQMO_MATCH_CORREL_ID
+/// - `type:<datagram|request|reply|report>`, `format:<name>` and `priority:<0-9>`,
+///   compiled into a message selector on the MQMD fields
+/// - `where:<selector>`, which takes the rest of the text as a selection string
+///
+/// Anything else, including a term whose value is malformed, stays free text.
+public struct MessageFilter: Equatable, Sendable {
+
+    // MARK: - Properties
+
+    /// Criteria for the queue manager
+    public private(set) var selector = MQService.MessageSelector()
+
+    /// Remaining text, matched on the client
+    public private(set) var text = ""
+
+    // MARK: - Initialization
+
+    /// Parse the text of the filter bar
+    /// - Parameter searchText: Text as typed by the user
+    public init(searchText: String) {
+        var messageId: [UInt8]?
+        var correlationId: [UInt8]?
+        var clauses: [String] = []
+        var textTerms: [String] = []
+        var remainder = Substring(searchText)
+
+        while let term = Self.nextTerm(in: &remainder) {
+            let lowered = term.lowercased()
+
+            if lowered.hasPrefix("where:") {
+                // The selector runs to the end of the text, spaces included
+                let expression = (term.dropFirst("where:".count) + remainder)
+                    .trimmingCharacters(in: .whitespaces)
+                if !expression.isEmpty {
+                    clauses.append("(\(expression))")
+                }
+                break
+            } else if let id = Self.hexValue(of: term, prefix: "msgid:") {
+                messageId = id
+            } else if let id = Self.hexValue(of: term, prefix: "correlid:") {
+                correlationId = id
+            } else if let clause = Self.descriptorClause(for: lowered) {
+                clauses.append(clause)
+            } else {
+                textTerms.append(String(term))
+            }
+        }
+
+        selector = MQService.MessageSelector(
+            messageId: messageId,
+            correlationId: correlationId,
+            selectionString: clauses.isEmpty ? nil : clauses.joined(separator: " AND ")
+        )
+        text = textTerms.joined(separator: " ")
+    }
+
+    // MARK: - Matching
+
+    /// Whether any term has to be evaluated by the queue manager
+    public var hasServerCriteria: Bool {
+        !selector.isEmpty
+    }
+
+    /// Whether a loaded message matches the free text
+    /// - Parameter message: Message to test
+    /// - Returns: true if the text is empty or found in one of the searched fields
+    public func matchesText(_ message: Message) -> Bool {
+        guard !text.isEmpty else { return true }
+        return Self.searchKey(for: message).contains(text.lowercased())
+    }
+
+    /// Lowercased text of the fields free text is searched in
+    /// The fields are joined with a unit separator, which typed text never
+    /// contains, so a match cannot span two fields
+    /// - Parameter message: Message to describe
+    /// - Returns: Message ID, payload, put application, format and reply-to queue
+    public static func searchKey(for message: Message) -> String {
+        return [
+            message.id,
+            message.payloadString ?? "",
+            message.putApplicationName,
+            message.format,
+            message.replyToQueue
+        ].joined(separator: "\u{1F}").lowercased()
+    }
+
+    /// Whether a loaded message matches the selector's IDs
+    /// Lets a list that was not browsed with the selector be narrowed until it is
+    /// - Parameter message: Message to test
+    public func matchesIds(_ message: Message) -> Bool {
+        // The selector pads the IDs to 24 bytes, as MQPUT stores a shorter one
+        return (selector.messageId == nil || selector.messageId == message.messageId)
+            && (selector.correlationId == nil || selector.correlationId == message.correlationId)
+    }
+
+    // MARK: - Parsing
+
+    /// Remove and return the next whitespace-separated term
+    private static func nextTerm(in text: inout Substring) -> Substring? {
+        let trimmed = text.drop { $0.isWhitespace }
+        guard !trimmed.isEmpty else { return nil }
+
+        let term = trimmed.prefix { !$0.isWhitespace }
+        text = trimmed[term.endIndex...]
+        return term
+    }
+
+    /// Decode the hex value of a `prefix:<hex>` term
+    /// - Returns: The bytes, or nil if the term has another prefix or is not 1-24 bytes of hex
+    private static func hexValue(of term: Substring, prefix: String) -> [UInt8]? {
+        guard term.lowercased().hasPrefix(prefix) else { return nil }
+
+        let hex = Array(term.dropFirst(prefix.count))
+        guard !hex.isEmpty, hex.count % 2 == 0, hex.count <= 48 else { return nil }
+
+        var bytes: [UInt8] = []
+        bytes.reserveCapacity(hex.count / 2)
+        for index in stride(from: 0, to: hex.count, by: 2) {
+            guard let byte = UInt8(String(hex[index...index + 1]), radix: 16) else { return nil }
+            bytes.append(byte)
+        }
+        return bytes
+    }
+
+    /// Compile a `type:`, `format:` or `priority:` term into a selector clause on the MQMD
+    private static func descriptorClause(for term: String) -> String? {
+        if term.hasPrefix("type:") {
+            let name = term.dropFirst("type:".count)
+            guard let type = MessageType.allCases.first(where: {
+                $0 != .unknown && $0.displayName.lowercased() == name
+            }) else { return nil }
+            return "Root.MQMD.MsgType = \(type.rawValue)"
+        }
+
+        if term.hasPrefix("format:") {
+            let name = term.dropFirst("format:".count).uppercased()
+            // MQMD.Format is 8 characters, padded with blanks
+            guard !name.isEmpty, name.count <= 8,
+                  name.allSatisfy({ $0.isLetter || $0.isNumber || $0 == "_" }) else { return nil }
+            return "Root.MQMD.Format = '\(name.padding(toLength: 8, withPad: " ", startingAt: 0))'"
+        }
+
+        if term.hasPrefix("priority:") {
+            guard let priority = Int(term.dropFirst("priority:".count)), (0...9).contains(priority) else {
+                return nil
+            }
+            return "Root.MQMD.Priority = \(priority)"
+        }
+
+        return nil
+    }
+}
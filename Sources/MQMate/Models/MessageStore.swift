@@ -0,0 +1,517 @@
+import Foundation
+
+// MARK: - Message Store
+
+/// Columnar store of a browsed message list
+///
+/// Holds every message as a row across struct-of-arrays columns instead of one
+/// Message value per row: MsgId and CorrelId are stored inline in one byte
+/// column, strings that repeat across messages (format, put application,
+/// reply-to queue and queue manager) are interned and stored as table
+/// indexes, and all payloads share one byte arena. A row costs about 110 bytes
+/// of columns and 40 of MsgId lookup plus its payload bytes, and appending a
+/// browsed message allocates nothing of its own.
+///
+/// Payloads the spill policy selects, large ones or all of them once the arena
+/// has reached the memory budget, are written to a PayloadSpillFile instead
+/// and only read back from its mapping when their row is read. The file lives
+/// as long as the store, so replacing the store evicts it.
+///
+/// The store is a collection of Message: subscripting a row builds the Message
+/// from the columns, so only rows actually read (the visible rows of a list,
+/// the selected message) are materialised.
+public struct MessageStore: RandomAccessCollection, Sendable {
+
+    // MARK: - Types
+
+    /// A 24-byte MsgId as a hashable value, for looking rows up without a hex string
+    private struct MessageIdKey: Hashable, Sendable {
+        let high: UInt64
+        let middle: UInt64
+        let low: UInt64
+
+        /// Build a key from 24 bytes
+        init<C: Collection>(bytes: C) where C.Element == UInt8 {
+            // Accumulated in locals so building a key allocates nothing
+            var high: UInt64 = 0
+            var middle: UInt64 = 0
+            var low: UInt64 = 0
+            for (offset, byte) in bytes.prefix(MessageStore.idLength).enumerated() {
+                let shifted = UInt64(byte) << (UInt64(7 - offset % 8) * 8)
+                switch offset / 8 {
+                case 0: high |= shifted
+                case 1: middle |= shifted
+                default: low |= shifted
+                }
+            }
+            self.high = high
+            self.middle = middle
+            self.low = low
+        }
+
+        /// Parse the hex form used as Message.id
+        init?(hex: String) {
+            let utf8 = Array(hex.utf8)
+            guard utf8.count == MessageStore.idLength * 2 else { return nil }
+
+            var bytes: [UInt8] = []
+            bytes.reserveCapacity(MessageStore.idLength)
+            for index in stride(from: 0, to: utf8.count, by: 2) {
+                guard let high = Self.nibble(utf8[index]), let low = Self.nibble(utf8[index + 1]) else {
+                    return nil
+                }
+                bytes.append(high << 4 | low)
+            }
+            self.init(bytes: bytes)
+        }
+
+        private static func nibble(_ character: UInt8) -> UInt8? {
+            switch character {
+            case UInt8(ascii: "0")...UInt8(ascii: "9"): return character - UInt8(ascii: "0")
+            case UInt8(ascii: "A")...UInt8(ascii: "F"): return character - UInt8(ascii: "A") + 10
+            case UInt8(ascii: "a")...UInt8(ascii: "f"): return character - UInt8(ascii: "a") + 10
+            default: return nil
+            }
+        }
+    }
+
+    /// Interned strings, each stored once and referred to by index
+    private struct StringTable: Sendable {
+        private(set) var strings: [String] = [""]
+        private var indexes: [String: Int32] = ["": 0]
+
+        /// Index of a string, adding it on first use
+        mutating func intern(_ string: String) -> Int32 {
+            if let index = indexes[string] {
+                return index
+            }
+            let index = Int32(strings.count)
+            strings.append(string)
+            indexes[string] = index
+            return index
+        }
+
+        subscript(index: Int32) -> String {
+            strings[Int(index)]
+        }
+    }
+
+    /// Length of MsgId and CorrelId
+    private static let idLength = 24
+
+    // MARK: - Columns
+
+    /// MsgId followed by CorrelId, 48 bytes per row
+    private var identifiers: [UInt8] = []
+
+    /// Interned format, put application, reply-to queue and reply-to queue manager names
+    private var strings = StringTable()
+    private var formats: [Int32] = []
+    private var putApplicationNames: [Int32] = []
+    private var replyToQueues: [Int32] = []
+    private var replyToQueueManagers: [Int32] = []
+
+    /// Put time as seconds since the reference date; NaN if unknown
+    private var putTimes: [Double] = []
+
+    /// Full length of every message on the queue
+    private var payloadLengths: [Int] = []
+
+    /// Start and length in the arena, or in the spill file, of the payload bytes held for every row
+    private var payloadOffsets: [Int] = []
+    private var payloadCounts: [Int32] = []
+
+    /// Whether the payload of a row is in the spill file rather than the arena
+    private var payloadSpilled: [Bool] = []
+
+    /// Payload bytes of every row kept in memory, back to back
+    private var arena: [UInt8] = []
+
+    /// Payload bytes of spilled rows, created by the first spill
+    private var spillFile: PayloadSpillFile?
+
+    /// Which payloads are spilled
+    public let spillPolicy: PayloadSpillPolicy
+
+    /// Raw MQMD values
+    private var priorities: [Int32] = []
+    private var messageSequenceNumbers: [Int32] = []
+    private var codedCharSetIds: [Int32] = []
+    private var encodings: [Int32] = []
+    private var messageTypes: [Int8] = []
+    private var persistences: [Int8] = []
+
+    /// Position of every row in the queue
+    private var positions: [Int] = []
+
+    /// Row of every MsgId; the first row wins when MsgIds repeat
+    private var rowsByMessageId: [MessageIdKey: Int] = [:]
+
+    /// Totals over every row, kept up to date by each change so summaries never scan the columns
+    public private(set) var totalPayloadSize: Int64 = 0
+    public private(set) var persistentCount = 0
+    public private(set) var requestCount = 0
+
+    // MARK: - Initialization
+
+    /// Create an empty store
+    /// - Parameter spillPolicy: Which payloads are moved to a spill file
+    public init(spillPolicy: PayloadSpillPolicy = .default) {
+        self.spillPolicy = spillPolicy
+    }
+
+    /// Create a store holding the given messages, in order
+    public init<S: Sequence>(_ messages: S, spillPolicy: PayloadSpillPolicy = .default) where S.Element == Message {
+        self.spillPolicy = spillPolicy
+        for message in messages {
+            append(message)
+        }
+    }
+
+    // MARK: - Collection
+
+    public var startIndex: Int { 0 }
+
+    public var endIndex: Int { positions.count }
+
+    /// Build the message of a row from the columns
+    public subscript(row: Int) -> Message {
+        let idStart = row * Self.idLength * 2
+        let putTime = putTimes[row]
+
+        return Message(
+            messageId: Array(identifiers[idStart..<idStart + Self.idLength]),
+            correlationId: Array(identifiers[idStart + Self.idLength..<idStart + Self.idLength * 2]),
+            format: strings[formats[row]],
+            payload: payload(at: row),
+            payloadLength: payloadLengths[row],
+            putDateTime: putTime.isNaN ? nil : Date(timeIntervalSinceReferenceDate: putTime),
+            putApplicationName: strings[putApplicationNames[row]],
+            messageType: MessageType(rawValue: Int32(messageTypes[row])),
+            persistence: MessagePersistence(rawValue: Int32(persistences[row])),
+            priority: priorities[row],
+            replyToQueue: strings[replyToQueues[row]],
+            replyToQueueManager: strings[replyToQueueManagers[row]],
+            messageSequenceNumber: messageSequenceNumbers[row],
+            position: positions[row],
+            codedCharSetId: codedCharSetIds[row],
+            encoding: encodings[row]
+        )
+    }
+
+    // MARK: - Column Access
+
+    /// Payload bytes held for a row, read from the spill file if it was spilled
+    public func payload(at row: Int) -> Data {
+        let offset = payloadOffsets[row]
+        let count = Int(payloadCounts[row])
+        if payloadSpilled[row] {
+            return spillFile?.read(offset: offset, count: count) ?? Data()
+        }
+        return Data(arena[offset..<offset + count])
+    }
+
+    /// Payload bytes held in memory rather than in the spill file
+    public var residentPayloadBytes: Int {
+        arena.count
+    }
+
+    /// Queue position of a row
+    public func position(at row: Int) -> Int {
+        positions[row]
+    }
+
+    /// Put time of a row
+    public func putDateTime(at row: Int) -> Date? {
+        let putTime = putTimes[row]
+        return putTime.isNaN ? nil : Date(timeIntervalSinceReferenceDate: putTime)
+    }
+
+    /// Full payload size of a row
+    public func payloadSize(at row: Int) -> Int {
+        payloadLengths[row]
+    }
+
+    /// Priority of a row
+    public func priority(at row: Int) -> Int32 {
+        priorities[row]
+    }
+
+    /// Message type of a row
+    public func messageType(at row: Int) -> MessageType {
+        MessageType(rawValue: Int32(messageTypes[row]))
+    }
+
+    /// Persistence of a row
+    public func persistence(at row: Int) -> MessagePersistence {
+        MessagePersistence(rawValue: Int32(persistences[row]))
+    }
+
+    /// Whether the MsgId of one row sorts before that of another, byte by byte like their hex forms
+    public func messageIdPrecedes(_ row: Int, _ otherRow: Int) -> Bool {
+        let start = row * Self.idLength * 2
+        let otherStart = otherRow * Self.idLength * 2
+        return identifiers[start..<start + Self.idLength]
+            .lexicographicallyPrecedes(identifiers[otherStart..<otherStart + Self.idLength])
+    }
+
+    /// Row of the message with an id (hex MsgId)
+    /// - Parameter id: Message.id of the message
+    /// - Returns: The row, or nil if no message has the id
+    public func row(forId id: String) -> Int? {
+        MessageIdKey(hex: id).flatMap { rowsByMessageId[$0] }
+    }
+
+    // MARK: - Appending
+
+    /// Append a browsed message without building a Message for it
+    /// - Parameters:
+    ///   - message: Message returned by a browse
+    ///   - position: Position to record instead of the one reported by the browse
+    public mutating func append(_ message: MQService.MQMessage, position: Int? = nil) {
+        appendRow(
+            messageId: message.messageId,
+            correlationId: message.correlationId,
+            format: message.format,
+            payload: message.payload,
+            payloadLength: message.totalLength,
+            putDateTime: message.putDateTime,
+            putApplicationName: message.putApplicationName,
+            messageType: message.messageType.rawValue,
+            persistence: message.persistence.rawValue,
+            priority: message.priority,
+            replyToQueue: message.replyToQueue,
+            replyToQueueManager: message.replyToQueueManager,
+            messageSequenceNumber: message.messageSequenceNumber,
+            position: position ?? message.position,
+            codedCharSetId: message.codedCharSetId,
+            encoding: message.encoding
+        )
+    }
+
+    /// Append browsed messages, keeping their positions
+    public mutating func append<S: Sequence>(contentsOf messages: S) where S.Element == MQService.MQMessage {
+        for message in messages {
+            append(message)
+        }
+    }
+
+    /// Append a message
+    public mutating func append(_ message: Message) {
+        appendRow(
+            messageId: message.messageId,
+            correlationId: message.correlationId,
+            format: message.format,
+            payload: message.payload,
+            payloadLength: message.payloadLength,
+            putDateTime: message.putDateTime,
+            putApplicationName: message.putApplicationName,
+            messageType: message.messageType.rawValue,
+            persistence: message.persistence.rawValue,
+            priority: message.priority,
+            replyToQueue: message.replyToQueue,
+            replyToQueueManager: message.replyToQueueManager,
+            messageSequenceNumber: message.messageSequenceNumber,
+            position: message.position,
+            codedCharSetId: message.codedCharSetId,
+            encoding: message.encoding
+        )
+    }
+
+    /// Write one row into every column
+    private mutating func appendRow(
+        messageId: [UInt8],
+        correlationId: [UInt8],
+        format: String,
+        payload: Data,
+        payloadLength: Int,
+        putDateTime: Date?,
+        putApplicationName: String,
+        messageType: Int32,
+        persistence: Int32,
+        priority: Int32,
+        replyToQueue: String,
+        replyToQueueManager: String,
+        messageSequenceNumber: Int32,
+        position: Int,
+        codedCharSetId: Int32,
+        encoding: Int32
+    ) {
+        let row = positions.count
+        appendIdentifier(messageId)
+        appendIdentifier(correlationId)
+
+        let key = MessageIdKey(bytes: messageId)
+        if rowsByMessageId[key] == nil {
+            rowsByMessageId[key] = row
+        }
+
+        formats.append(strings.intern(format))
+        putApplicationNames.append(strings.intern(putApplicationName))
+        replyToQueues.append(strings.intern(replyToQueue))
+        replyToQueueManagers.append(strings.intern(replyToQueueManager))
+
+        putTimes.append(putDateTime?.timeIntervalSinceReferenceDate ?? .nan)
+        payloadLengths.append(max(payloadLength, payload.count))
+        let location = storePayload(payload)
+        payloadOffsets.append(location.offset)
+        payloadCounts.append(Int32(payload.count))
+        payloadSpilled.append(location.isSpilled)
+
+        priorities.append(priority)
+        messageSequenceNumbers.append(messageSequenceNumber)
+        codedCharSetIds.append(codedCharSetId)
+        encodings.append(encoding)
+        messageTypes.append(Int8(clamping: messageType))
+        persistences.append(Int8(clamping: persistence))
+        positions.append(position)
+        addToTotals(row: row)
+    }
+
+    /// Count a row into the totals
+    private mutating func addToTotals(row: Int) {
+        totalPayloadSize += Int64(payloadLengths[row])
+        if Int32(persistences[row]) == MessagePersistence.persistent.rawValue {
+            persistentCount += 1
+        }
+        if Int32(messageTypes[row]) == MessageType.request.rawValue {
+            requestCount += 1
+        }
+    }
+
+    /// Append an ID to the identifier column, padded or cut to 24 bytes
+    private mutating func appendIdentifier(_ id: [UInt8]) {
+        identifiers.append(contentsOf: id.prefix(Self.idLength))
+        if id.count < Self.idLength {
+            identifiers.append(contentsOf: repeatElement(0, count: Self.idLength - id.count))
+        }
+    }
+
+    // MARK: - Updating
+
+    /// Replace the payload of a row, e.g. with the complete body of a previewed message
+    /// The new bytes are added to the arena or spill file; the old ones stay there until the list is replaced
+    /// - Parameters:
+    ///   - row: Row to update
+    ///   - payload: The payload bytes now held
+    ///   - payloadLength: Full length of the message on the queue
+    public mutating func replacePayload(at row: Int, with payload: Data, payloadLength: Int) {
+        let location = storePayload(payload)
+        payloadOffsets[row] = location.offset
+        payloadCounts[row] = Int32(payload.count)
+        payloadSpilled[row] = location.isSpilled
+        totalPayloadSize -= Int64(payloadLengths[row])
+        payloadLengths[row] = max(payloadLength, payload.count)
+        totalPayloadSize += Int64(payloadLengths[row])
+    }
+
+    /// Add payload bytes to the spill file if the policy spills them, otherwise to the arena
+    /// A payload that cannot be written to the spill file is kept in memory
+    private mutating func storePayload(_ payload: Data) -> (offset: Int, isSpilled: Bool) {
+        if spillPolicy.spills(count: payload.count, residentBytes: arena.count) {
+            if spillFile == nil {
+                spillFile = PayloadSpillFile()
+            }
+            if let offset = spillFile?.append(payload) {
+                return (offset, true)
+            }
+        }
+
+        let offset = arena.count
+        arena.append(contentsOf: payload)
+        return (offset, false)
+    }
+
+    /// Remove the rows whose MsgId is the given one
+    /// Columns are compacted; the payload bytes stay in the arena or spill file until the list is replaced
+    /// - Parameter messageId: MsgId of the rows to remove
+    public mutating func removeAll(messageId: [UInt8]) {
+        removeAll(messageIds: [messageId])
+    }
+
+    /// Remove the rows whose MsgId is any of the given ones
+    /// Every column is compacted once, however many rows are removed; the
+    /// payload bytes stay in the arena or spill file until the list is replaced
+    /// - Parameter messageIds: MsgIds of the rows to remove
+    public mutating func removeAll<S: Sequence>(messageIds: S) where S.Element == [UInt8] {
+        let keys = Set(messageIds.map { MessageIdKey(bytes: $0) })
+        guard !keys.isEmpty else { return }
+
+        let kept = indices.filter { !keys.contains(messageIdKey(ofRow: $0)) }
+        guard kept.count < count else { return }
+
+        func compacted<T>(_ column: [T]) -> [T] {
+            kept.map { column[$0] }
+        }
+
+        var keptIdentifiers: [UInt8] = []
+        keptIdentifiers.reserveCapacity(kept.count * Self.idLength * 2)
+        for row in kept {
+            let start = row * Self.idLength * 2
+            keptIdentifiers.append(contentsOf: identifiers[start..<start + Self.idLength * 2])
+        }
+        identifiers = keptIdentifiers
+
+        formats = compacted(formats)
+        putApplicationNames = compacted(putApplicationNames)
+        replyToQueues = compacted(replyToQueues)
+        replyToQueueManagers = compacted(replyToQueueManagers)
+        putTimes = compacted(putTimes)
+        payloadLengths = compacted(payloadLengths)
+        payloadOffsets = compacted(payloadOffsets)
+        payloadCounts = compacted(payloadCounts)
+        payloadSpilled = compacted(payloadSpilled)
+        priorities = compacted(priorities)
+        messageSequenceNumbers = compacted(messageSequenceNumbers)
+        codedCharSetIds = compacted(codedCharSetIds)
+        encodings = compacted(encodings)
+        messageTypes = compacted(messageTypes)
+        persistences = compacted(persistences)
+        positions = compacted(positions)
+
+        // Rows after the removed ones have moved up
+        rowsByMessageId = [:]
+        totalPayloadSize = 0
+        persistentCount = 0
+        requestCount = 0
+        for row in indices {
+            let rowKey = messageIdKey(ofRow: row)
+            if rowsByMessageId[rowKey] == nil {
+                rowsByMessageId[rowKey] = row
+            }
+            addToTotals(row: row)
+        }
+    }
+
+    /// MsgId of a row as a lookup key
+    private func messageIdKey(ofRow row: Int) -> MessageIdKey {
+        let start = row * Self.idLength * 2
+        return MessageIdKey(bytes: identifiers[start..<start + Self.idLength])
+    }
+}
+
+// MARK: - Message Rows
+
+/// Rows of a MessageStore in a chosen order, e.g. the filtered and sorted display list
+/// Messages are built from the store as they are read
+public struct MessageRows: RandomAccessCollection, Sendable {
+
+    /// Store the rows belong to
+    public let store: MessageStore
+
+    /// Rows in display order
+    public let rows: [Int]
+
+    public init(store: MessageStore, rows: [Int]) {
+        self.store = store
+        self.rows = rows
+    }
+
+    public var startIndex: Int { 0 }
+
+    public var endIndex: Int { rows.count }
+
+    public subscript(index: Int) -> Message {
+        store[rows[index]]
+    }
+}
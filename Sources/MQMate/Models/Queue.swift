@@ -80,6 +80,35 @@ public struct Queue: Identifiable, Sendable, Equatable, Hashable {
         self.lastRefreshedAt = lastRefreshedAt
     }
 
+    // MARK: - State Mutations
+
+    /// Create a copy with a newly read depth and open counts
+    /// - Parameters:
+    ///   - depth: Current message depth
+    ///   - openInputCount: Number of input openers
+    ///   - openOutputCount: Number of output openers
+    ///   - refreshedAt: When the values were read
+    /// - Returns: A new Queue with the other attributes unchanged
+    public func withStatus(
+        depth: Int32,
+        openInputCount: Int32,
+        openOutputCount: Int32,
+        refreshedAt: Date = Date()
+    ) -> Queue {
+        Queue(
+            name: name,
+            queueType: queueType,
+            depth: depth,
+            maxDepth: maxDepth,
+            queueDescription: queueDescription,
+            getInhibited: getInhibited,
+            putInhibited: putInhibited,
+            openInputCount: openInputCount,
+            openOutputCount: openOutputCount,
+            lastRefreshedAt: refreshedAt
+        )
+    }
+
     // MARK: - Computed Properties
 
     /// Depth as a percentage of max depth (0.0 to 1.0)
@@ -0,0 +1,96 @@
+import Foundation
+
+// MARK: - Queue Depth History
+
+/// Fixed-size ring buffer of the most recent depth samples of one queue
+/// Filled by QueueDepthMonitor as it polls, so sparklines and rates are drawn
+/// from memory without further MQ calls. Once full, each new sample overwrites
+/// the oldest one.
+public struct QueueDepthHistory: Sendable, Equatable {
+
+    // MARK: - Types
+
+    /// Depth of a queue at one point in time
+    public struct Sample: Sendable, Equatable {
+        /// When the depth was read
+        public let time: Date
+
+        /// Number of messages on the queue
+        public let depth: Int32
+
+        public init(time: Date, depth: Int32) {
+            self.time = time
+            self.depth = depth
+        }
+    }
+
+    // MARK: - Properties
+
+    /// Maximum number of samples kept
+    public let capacity: Int
+
+    /// Sample storage; grows to capacity, then wraps
+    private var storage: [Sample] = []
+
+    /// Index in storage of the oldest sample once storage is full
+    private var head = 0
+
+    // MARK: - Initialization
+
+    /// Create an empty history
+    /// - Parameter capacity: Maximum number of samples kept (at least 2)
+    public init(capacity: Int = 120) {
+        self.capacity = max(capacity, 2)
+        storage.reserveCapacity(self.capacity)
+    }
+
+    // MARK: - Recording
+
+    /// Record a sample, dropping the oldest one if the history is full
+    public mutating func append(_ sample: Sample) {
+        if storage.count < capacity {
+            storage.append(sample)
+        } else {
+            storage[head] = sample
+            head = (head + 1) % capacity
+        }
+    }
+
+    // MARK: - Reading
+
+    /// Number of samples held
+    public var count: Int {
+        storage.count
+    }
+
+    /// Samples from oldest to newest
+    public var samples: [Sample] {
+        Array(storage[head...] + storage[..<head])
+    }
+
+    /// Depths from oldest to newest, for a sparkline
+    public var depths: [Int32] {
+        samples.map(\.depth)
+    }
+
+    /// Most recent sample
+    public var latest: Sample? {
+        guard !storage.isEmpty else { return nil }
+        return storage[(head + storage.count - 1) % storage.count]
+    }
+
+    /// Oldest sample held
+    public var oldest: Sample? {
+        guard !storage.isEmpty else { return nil }
+        return storage[head % storage.count]
+    }
+
+    /// Net change in depth per second across the samples held
+    /// Positive when messages arrive faster than they are consumed; nil with fewer than two samples
+    public var rate: Double? {
+        guard let oldest, let latest else { return nil }
+        let elapsed = latest.time.timeIntervalSince(oldest.time)
+        guard elapsed > 0 else { return nil }
+        return Double(latest.depth - oldest.depth) / elapsed
+    }
+}
@@ -181,6 +181,18 @@ public struct QueueManager: Identifiable, Sendable, Equatable, Hashable {
         return copy
     }
 
+    /// Create a copy with some queues replaced
+    /// Queues are matched by ID; updates for queues not in the list are ignored
+    /// - Parameter updatedQueues: The queues that changed
+    /// - Returns: A new QueueManager with the other queues unchanged
+    public func withUpdatedQueues(_ updatedQueues: [Queue]) -> QueueManager {
+        var copy = self
+        let updates = Dictionary(updatedQueues.map { ($0.id, $0) }, uniquingKeysWith: { _, last in last })
+        copy.queues = queues.map { updates[$0.id] ?? $0 }
+        copy.lastRefreshedAt = Date()
+        return copy
+    }
+
     /// Create a copy with an error message
     /// - Parameter error: The error message
     /// - Returns: A new QueueManager with the error state
@@ -0,0 +1,206 @@
+import Foundation
+
+// MARK: - Audit File Sink
+
+/// Durable, append-only audit log on disk as JSON Lines, rotated by size
+///
+/// Entries are appended in batches, one compact JSON object per line, to
+/// `audit.jsonl`. Once that file passes maxFileSize it becomes `audit.1.jsonl`,
+/// older files move up by one and the oldest beyond maxFileCount is deleted.
+/// Exports read the files back in chunks, so the log is never held in memory
+/// as a whole.
+///
+/// Not thread-safe: AuditService only uses it from its writer queue.
+public final class AuditFileSink: @unchecked Sendable {
+
+    // MARK: - Properties
+
+    /// Directory holding the log files
+    public let directory: URL
+
+    /// Size in bytes after which the current file is rotated
+    public let maxFileSize: Int
+
+    /// Number of files kept, including the current one
+    public let maxFileCount: Int
+
+    /// Handle of the current file, opened on the first append
+    private var handle: FileHandle?
+
+    /// Size of the current file
+    private var currentSize = 0
+
+    /// Bytes read per chunk when streaming the log back
+    private static let readChunkSize = 64 * 1024
+
+    // MARK: - Initialization
+
+    /// Create a sink; nothing is written until the first append
+    /// - Parameters:
+    ///   - directory: Directory of the log files (defaults to the app's Application Support folder)
+    ///   - maxFileSize: Size in bytes after which a file is rotated (default: 4 MB)
+    ///   - maxFileCount: Number of files kept, including the current one (default: 5)
+    public init(directory: URL? = nil, maxFileSize: Int = 4 * 1024 * 1024, maxFileCount: Int = 5) {
+        self.directory = directory ?? FileManager.default
+            .urls(for: .applicationSupportDirectory, in: .userDomainMask)[0]
+            .appendingPathComponent("MQMate", isDirectory: true)
+            .appendingPathComponent("Audit", isDirectory: true)
+        self.maxFileSize = max(maxFileSize, 1)
+        self.maxFileCount = max(maxFileCount, 1)
+    }
+
+    deinit {
+        try? handle?.close()
+    }
+
+    // MARK: - Writing
+
+    /// Append entries to the current file, rotating it once it is full
+    /// - Parameter entries: Entries in the order they were logged
+    /// - Throws: A file or encoding error; entries of a failed batch are not retried
+    public func append(_ entries: [AuditEntry]) throws {
+        guard !entries.isEmpty else { return }
+
+        let lines = try Self.jsonLines(for: entries)
+        let handle = try openCurrentFile()
+        try handle.write(contentsOf: lines)
+        currentSize += lines.count
+
+        if currentSize >= maxFileSize {
+            try rotate()
+        }
+    }
+
+    /// Delete every log file
+    public func removeAll() {
+        try? handle?.close()
+        handle = nil
+        currentSize = 0
+        for url in fileURLs {
+            try? FileManager.default.removeItem(at: url)
+        }
+    }
+
+    /// Encode entries as JSON Lines
+    /// - Parameter entries: The entries to encode
+    /// - Returns: One compact JSON object per entry, each followed by a newline
+    static func jsonLines(for entries: [AuditEntry]) throws -> Data {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.sortedKeys]
+        encoder.dateEncodingStrategy = .iso8601
+
+        var lines = Data()
+        for entry in entries {
+            lines.append(try encoder.encode(entry))
+            lines.append(UInt8(ascii: "\n"))
+        }
+        return lines
+    }
+
+    // MARK: - Reading
+
+    /// Existing log files, oldest first
+    public var fileURLs: [URL] {
+        (0..<maxFileCount).reversed()
+            .map(fileURL(generation:))
+            .filter { FileManager.default.fileExists(atPath: $0.path) }
+    }
+
+    /// Stream the logged entries as a JSON array, oldest first
+    /// - Parameter write: Receives the array chunk by chunk
+    /// - Returns: Number of entries written
+    /// - Throws: A file error, or any error thrown by write
+    @discardableResult
+    public func writeJSONArray(to write: (Data) throws -> Void) throws -> Int {
+        try handle?.synchronize()
+
+        return try Self.writeJSONArray(to: write) { element in
+            for url in fileURLs {
+                try forEachLine(in: url) { line in
+                    // Skip a line cut short by a crash while it was written
+                    guard line.first == UInt8(ascii: "{"), line.last == UInt8(ascii: "}") else { return }
+                    try element(line)
+                }
+            }
+        }
+    }
+
+    /// Write a JSON array whose elements are produced one at a time
+    /// - Parameters:
+    ///   - write: Receives the array chunk by chunk
+    ///   - elements: Calls its argument with each encoded element, in order
+    /// - Returns: Number of elements written
+    @discardableResult
+    static func writeJSONArray(
+        to write: (Data) throws -> Void,
+        elements: ((Data) throws -> Void) throws -> Void
+    ) throws -> Int {
+        var count = 0
+        try write(Data("[".utf8))
+        try elements { element in
+            try write(Data((count == 0 ? "\n  " : ",\n  ").utf8))
+            try write(element)
+            count += 1
+        }
+        try write(Data((count == 0 ? "]\n" : "\n]\n").utf8))
+        return count
+    }
+
+    /// Read a file chunk by chunk and hand out its lines without the newline
+    private func forEachLine(in url: URL, _ body: (Data) throws -> Void) throws {
+        let reader = try FileHandle(forReadingFrom: url)
+        defer { try? reader.close() }
+
+        var carry = Data()
+        while let chunk = try reader.read(upToCount: Self.readChunkSize), !chunk.isEmpty {
+            carry.append(chunk)
+            var lineStart = carry.startIndex
+            while let newline = carry[lineStart...].firstIndex(of: UInt8(ascii: "\n")) {
+                try body(carry[lineStart..<newline])
+                lineStart = carry.index(after: newline)
+            }
+            carry = Data(carry[lineStart...])
+        }
+        if !carry.isEmpty {
+            try body(carry)
+        }
+    }
+
+    // MARK: - Private Methods
+
+    /// URL of a file by age: 0 is the current file, 1 the one rotated last
+    private func fileURL(generation: Int) -> URL {
+        directory.appendingPathComponent(generation == 0 ? "audit.jsonl" : "audit.\(generation).jsonl")
+    }
+
+    /// Handle of the current file, opening or creating it positioned at its end
+    private func openCurrentFile() throws -> FileHandle {
+        if let handle {
+            return handle
+        }
+
+        let url = fileURL(generation: 0)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        if !FileManager.default.fileExists(atPath: url.path) {
+            FileManager.default.createFile(atPath: url.path, contents: nil)
+        }
+        let handle = try FileHandle(forWritingTo: url)
+        currentSize = Int(try handle.seekToEnd())
+        self.handle = handle
+        return handle
+    }
+
+    /// Close the current file and shift every file one generation older
+    private func rotate() throws {
+        try handle?.close()
+        handle = nil
+        currentSize = 0
+
+        try? FileManager.default.removeItem(at: fileURL(generation: maxFileCount - 1))
+        for generation in (0..<(maxFileCount - 1)).reversed() {
+            let url = fileURL(generation: generation)
+            guard FileManager.default.fileExists(atPath: url.path) else { continue }
+            try FileManager.default.moveItem(at: url, to: fileURL(generation: generation + 1))
+        }
+    }
+}
@@ -0,0 +1,119 @@
+import Foundation
+import CMQC
+
+// MARK: - Audit Ring Buffer
+
+/// Fixed-capacity, lock-free queue handing audit entries from any thread to one consumer
+///
+/// Producers claim a slot with a single compare-and-swap on the enqueue
+/// position and publish it by advancing the slot's sequence number, so a log
+/// call never takes a lock and never waits for the consumer. The consumer
+/// (AuditService's writer queue) takes entries in order and hands a slot back
+/// by moving its sequence number one lap ahead. This is Dmitry Vyukov's
+/// bounded queue, using the atomics of the CMQC shim.
+final class AuditRingBuffer: @unchecked Sendable {
+
+    // MARK: - Properties
+
+    /// Number of slots, a power of two
+    let capacity: Int
+
+    /// Maps a position to its slot
+    private let mask: UInt64
+
+    /// Per-slot sequence numbers: equal to the position when the slot is free
+    /// for it, one past the position once the entry is published
+    private let sequences: UnsafeMutablePointer<UInt64>
+
+    /// Entries in flight
+    private let slots: UnsafeMutablePointer<AuditEntry?>
+
+    /// Next position a producer claims
+    private let enqueuePosition: UnsafeMutablePointer<UInt64>
+
+    /// Next position the consumer takes; only touched by the consumer
+    private var dequeuePosition: UInt64 = 0
+
+    // MARK: - Initialization
+
+    /// Create an empty buffer
+    /// - Parameter capacity: Minimum number of entries held; rounded up to a power of two
+    init(capacity: Int) {
+        var size = 2
+        while size < capacity {
+            size <<= 1
+        }
+        self.capacity = size
+        self.mask = UInt64(size - 1)
+
+        sequences = .allocate(capacity: size)
+        for index in 0..<size {
+            (sequences + index).initialize(to: UInt64(index))
+        }
+        slots = .allocate(capacity: size)
+        slots.initialize(repeating: nil, count: size)
+        enqueuePosition = .allocate(capacity: 1)
+        enqueuePosition.initialize(to: 0)
+    }
+
+    deinit {
+        slots.deinitialize(count: capacity)
+        slots.deallocate()
+        sequences.deallocate()
+        enqueuePosition.deallocate()
+    }
+
+    // MARK: - Producers
+
+    /// Add an entry; safe to call from any number of threads at once
+    /// - Parameter entry: The entry to add
+    /// - Returns: false if the buffer is full and the consumer has to catch up first
+    func enqueue(_ entry: AuditEntry) -> Bool {
+        var position = mqmate_atomic_load_relaxed(enqueuePosition)
+        while true {
+            let slot = Int(position & mask)
+            let lag = Int64(bitPattern: mqmate_atomic_load_acquire(sequences + slot) &- position)
+
+            if lag == 0 {
+                // The slot is free for this position; claim it, or retry from
+                // the position another producer moved it to
+                if mqmate_atomic_compare_exchange(enqueuePosition, &position, position &+ 1) {
+                    slots[slot] = entry
+                    mqmate_atomic_store_release(sequences + slot, position &+ 1)
+                    return true
+                }
+            } else if lag < 0 {
+                // The slot still holds the entry of the previous lap
+                return false
+            } else {
+                position = mqmate_atomic_load_relaxed(enqueuePosition)
+            }
+        }
+    }
+
+    // MARK: - Consumer
+
+    /// Take the oldest published entry; call from the single consumer only
+    /// - Returns: The entry, or nil if none is published yet
+    func dequeue() -> AuditEntry? {
+        let slot = Int(dequeuePosition & mask)
+        guard mqmate_atomic_load_acquire(sequences + slot) == dequeuePosition &+ 1 else {
+            return nil
+        }
+
+        let entry = slots[slot]
+        slots[slot] = nil
+        mqmate_atomic_store_release(sequences + slot, dequeuePosition &+ UInt64(capacity))
+        dequeuePosition &+= 1
+        return entry
+    }
+
+    /// Take every published entry, oldest first; call from the single consumer only
+    func drain() -> [AuditEntry] {
+        var entries: [AuditEntry] = []
+        while let entry = dequeue() {
+            entries.append(entry)
+        }
+        return entries
+    }
+}
@@ -1,4 +1,5 @@
 import Foundation
+import CMQC
 
 // MARK: - AuditService Protocol
 
@@ -59,16 +60,32 @@ public protocol AuditServiceProtocol: Sendable {
 // MARK: - AuditService Implementation
 
 /// Service for logging and tracking all destructive operations in MQMate
-/// Maintains an in-memory log with optional file export for compliance and debugging
+///
+/// Logging is lock-free: an entry is put in a fixed-capacity ring buffer and a
+/// background writer takes it from there in batches, so a bulk operation that
+/// logs thousands of entries is not slowed down by formatting or file I/O.
+/// The writer keeps the most recent entries in memory, echoes them to stderr
+/// and appends them to an optional rotating file log. Reads and exports first
+/// let the writer catch up, so they always include every entry logged before.
 public final class AuditService: AuditServiceProtocol, @unchecked Sendable {
 
     // MARK: - Properties
 
-    /// In-memory storage for audit entries
-    private var entries: [AuditEntry] = []
+    /// Entries logged but not yet taken by the writer
+    private let pending: AuditRingBuffer
 
-    /// Lock for thread-safe access to entries
-    private let lock = NSLock()
+    /// Most recent entries; once maxEntries is reached the oldest, at
+    /// recentHead, is overwritten. Owned by the writer queue
+    private var recent: [AuditEntry] = []
+
+    /// Index of the oldest entry in recent once it is full
+    private var recentHead = 0
+
+    /// Serial queue of the background writer
+    private let writerQueue = DispatchQueue(label: "com.mqmate.audit", qos: .utility)
+
+    /// 1 while a drain is scheduled on the writer queue, so bursts schedule one drain
+    private let drainScheduled: UnsafeMutablePointer<UInt64>
 
     /// Maximum number of entries to retain in memory (0 = unlimited)
     public let maxEntries: Int
@@ -76,8 +93,11 @@ public final class AuditService: AuditServiceProtocol, @unchecked Sendable {
     /// Whether to output entries to console/stderr
     public let consoleOutput: Bool
 
-    /// Shared instance for app-wide audit logging
-    public static let shared = AuditService()
+    /// Durable log the writer appends to (nil = memory only)
+    public let fileSink: AuditFileSink?
+
+    /// Shared instance for app-wide audit logging, also written to disk
+    public static let shared = AuditService(fileSink: AuditFileSink())
 
     // MARK: - Initialization
 
@@ -85,31 +105,37 @@ public final class AuditService: AuditServiceProtocol, @unchecked Sendable {
     /// - Parameters:
     ///   - maxEntries: Maximum entries to retain (0 = unlimited, default: 1000)
     ///   - consoleOutput: Whether to log to console (default: true)
-    public init(maxEntries: Int = 1000, consoleOutput: Bool = true) {
+    ///   - fileSink: Durable log to append entries to (default: none)
+    ///   - bufferCapacity: Entries that can be logged before the writer has to catch up (default: 4096)
+    public init(
+        maxEntries: Int = 1000,
+        consoleOutput: Bool = true,
+        fileSink: AuditFileSink? = nil,
+        bufferCapacity: Int = 4096
+    ) {
         self.maxEntries = maxEntries
         self.consoleOutput = consoleOutput
+        self.fileSink = fileSink
+        self.pending = AuditRingBuffer(capacity: bufferCapacity)
+        self.drainScheduled = .allocate(capacity: 1)
+        self.drainScheduled.initialize(to: 0)
+    }
+
+    deinit {
+        drainScheduled.deallocate()
     }
 
     // MARK: - Public Methods
 
     /// Log a new audit entry
+    /// Returns once the entry is queued; the writer records it shortly after
     /// - Parameter entry: The audit entry to log
     public func log(_ entry: AuditEntry) {
-        lock.lock()
-        defer { lock.unlock() }
-
-        // Add entry to the beginning (most recent first)
-        entries.insert(entry, at: 0)
-
-        // Trim if exceeding max entries
-        if maxEntries > 0 && entries.count > maxEntries {
-            entries = Array(entries.prefix(maxEntries))
-        }
-
-        // Output to console if enabled
-        if consoleOutput {
-            outputToConsole(entry)
+        while !pending.enqueue(entry) {
+            // The writer fell a whole buffer behind; catch up on this thread
+            writerQueue.sync { drainPending() }
         }
+        scheduleDrain()
     }
 
     /// Log a new audit entry with individual parameters
@@ -139,20 +165,17 @@ public final class AuditService: AuditServiceProtocol, @unchecked Sendable {
     /// Get all audit log entries
     /// - Returns: Array of audit entries, most recent first
     public func getAuditLog() -> [AuditEntry] {
-        lock.lock()
-        defer { lock.unlock() }
-
-        return entries
+        writerQueue.sync {
+            drainPending()
+            return recentEntries
+        }
     }
 
     /// Get audit log entries filtered by action type
     /// - Parameter actionType: The action type to filter by
     /// - Returns: Array of matching audit entries
     public func getAuditLog(for actionType: AuditEntry.ActionType) -> [AuditEntry] {
-        lock.lock()
-        defer { lock.unlock() }
-
-        return entries.filter { $0.actionType == actionType }
+        getAuditLog().filter { $0.actionType == actionType }
     }
 
     /// Get audit log entries filtered by date range
@@ -161,43 +184,47 @@ public final class AuditService: AuditServiceProtocol, @unchecked Sendable {
     ///   - endDate: End of the date range
     /// - Returns: Array of matching audit entries
     public func getAuditLog(from startDate: Date, to endDate: Date) -> [AuditEntry] {
-        lock.lock()
-        defer { lock.unlock() }
-
-        return entries.filter { entry in
+        getAuditLog().filter { entry in
             entry.timestamp >= startDate && entry.timestamp <= endDate
         }
     }
 
+    /// Wait until every entry logged so far has been recorded and written
+    public func flush() {
+        writerQueue.sync { drainPending() }
+    }
+
     /// Export audit log to a file
+    /// The log is streamed from disk chunk by chunk when there is a file sink
     /// - Parameter url: File URL to export to
     /// - Throws: Error if export fails
     public func exportAuditLog(to url: URL) throws {
-        let data = try exportAuditLogAsJSON()
-        try data.write(to: url, options: .atomic)
+        FileManager.default.createFile(atPath: url.path, contents: nil)
+        let output = try FileHandle(forWritingTo: url)
+        do {
+            try writeJSONArray { try output.write(contentsOf: $0) }
+            try output.close()
+        } catch {
+            try? output.close()
+            try? FileManager.default.removeItem(at: url)
+            throw error
+        }
     }
 
     /// Export audit log as JSON data
-    /// - Returns: JSON-encoded audit log data
+    /// Holds the whole export in memory; prefer exportAuditLog(to:) for large logs
+    /// - Returns: JSON array of the entries, oldest first
     /// - Throws: Error if encoding fails
     public func exportAuditLogAsJSON() throws -> Data {
-        lock.lock()
-        let entriesToExport = entries
-        lock.unlock()
-
-        let encoder = JSONEncoder()
-        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
-        encoder.dateEncodingStrategy = .iso8601
-
-        return try encoder.encode(entriesToExport)
+        var data = Data()
+        try writeJSONArray { data.append($0) }
+        return data
     }
 
     /// Export audit log as formatted text
     /// - Returns: Human-readable audit log text
     public func exportAuditLogAsText() -> String {
-        lock.lock()
-        let entriesToExport = entries
-        lock.unlock()
+        let entriesToExport = getAuditLog()
 
         var lines: [String] = [
             "MQMate Audit Log",
@@ -221,20 +248,22 @@ public final class AuditService: AuditServiceProtocol, @unchecked Sendable {
         return lines.joined(separator: "\n")
     }
 
-    /// Clear all audit log entries
+    /// Clear all audit log entries, including the file log
     public func clearAuditLog() {
-        lock.lock()
-        defer { lock.unlock() }
-
-        entries.removeAll()
+        writerQueue.sync {
+            drainPending()
+            recent.removeAll()
+            recentHead = 0
+            fileSink?.removeAll()
+        }
     }
 
     /// Get the count of audit entries
     public var entryCount: Int {
-        lock.lock()
-        defer { lock.unlock() }
-
-        return entries.count
+        writerQueue.sync {
+            drainPending()
+            return recent.count
+        }
     }
 
     // MARK: - Convenience Logging Methods
@@ -344,17 +373,89 @@ public final class AuditService: AuditServiceProtocol, @unchecked Sendable {
 
     // MARK: - Private Methods
 
-    /// Output an audit entry to console
-    /// - Parameter entry: The entry to output
-    private func outputToConsole(_ entry: AuditEntry) {
-        let prefix = entry.actionType.isDestructive ? "[AUDIT-DESTRUCTIVE]" : "[AUDIT]"
-        let message = "\(prefix) \(entry.logDescription)"
+    /// Have the writer drain the buffer unless a drain is already scheduled
+    private func scheduleDrain() {
+        guard mqmate_atomic_exchange(drainScheduled, 1) == 0 else { return }
 
-        // Use FileHandle for stderr output (appropriate for audit logs)
-        if let data = (message + "\n").data(using: .utf8) {
-            FileHandle.standardError.write(data)
+        writerQueue.async { [self] in
+            // Cleared before draining, so entries logged meanwhile schedule another drain
+            mqmate_atomic_store_release(drainScheduled, 0)
+            drainPending()
+        }
+    }
+
+    /// Record every queued entry; runs on the writer queue
+    private func drainPending() {
+        let batch = pending.drain()
+        guard !batch.isEmpty else { return }
+
+        remember(batch)
+
+        if consoleOutput {
+            outputToConsole(batch)
+        }
+
+        do {
+            try fileSink?.append(batch)
+        } catch {
+            // Entries stay in memory; report the lost write where audit output goes
+            FileHandle.standardError.write(Data("[AUDIT] Could not write audit log: \(error.localizedDescription)\n".utf8))
+        }
+    }
+
+    /// Add entries to the in-memory store, overwriting the oldest once it is full
+    private func remember(_ batch: [AuditEntry]) {
+        guard maxEntries > 0 else {
+            recent.append(contentsOf: batch)
+            return
+        }
+
+        for entry in batch.suffix(maxEntries) {
+            if recent.count < maxEntries {
+                recent.append(entry)
+            } else {
+                recent[recentHead] = entry
+                recentHead = (recentHead + 1) % maxEntries
+            }
         }
     }
+
+    /// In-memory entries, most recent first; read on the writer queue
+    private var recentEntries: [AuditEntry] {
+        Array((recent[recentHead...] + recent[..<recentHead]).reversed())
+    }
+
+    /// Stream the log as a JSON array, oldest first, from disk or else from memory
+    private func writeJSONArray(to write: (Data) throws -> Void) throws {
+        try writerQueue.sync {
+            drainPending()
+
+            if let fileSink {
+                try fileSink.writeJSONArray(to: write)
+                return
+            }
+
+            let lines = try AuditFileSink.jsonLines(for: recentEntries.reversed())
+            try AuditFileSink.writeJSONArray(to: write) { element in
+                for line in lines.split(separator: UInt8(ascii: "\n")) {
+                    try element(Data(line))
+                }
+            }
+        }
+    }
+
+    /// Output a batch of audit entries to console in one write
+    /// - Parameter entries: The entries to output
+    private func outputToConsole(_ entries: [AuditEntry]) {
+        var text = ""
+        for entry in entries {
+            let prefix = entry.actionType.isDestructive ? "[AUDIT-DESTRUCTIVE]" : "[AUDIT]"
+            text += "\(prefix) \(entry.logDescription)\n"
+        }
+
+        // Use FileHandle for stderr output (appropriate for audit logs)
+        FileHandle.standardError.write(Data(text.utf8))
+    }
 }
 
 // MARK: - Mock AuditService for Testing
@@ -0,0 +1,676 @@
+import Foundation
+import CMQC
+
+// MARK: - Browse Cursor
+
+/// Persistent browse position on a single queue
+///
+/// Keeps the queue open with MQOO_BROWSE between calls, so each page continues
+/// from the queue manager's browse cursor with MQGMO_BROWSE_NEXT instead of
+/// re-reading every earlier message from MQGMO_BROWSE_FIRST. Messages that are
+/// only skipped over are read with a zero-length buffer, so moving the cursor
+/// forward transfers message descriptors but no payloads.
+///
+/// A read-ahead cursor opens the queue with MQOO_READ_AHEAD, so the queue
+/// manager streams non-persistent messages to the client and most MQGETs are
+/// served locally. Read-ahead only serves sequential reads with unchanged
+/// options, so such a cursor is meant for nextPage(maxMessages:) alone and
+/// sizes its buffer for the full payload limit up front.
+///
+/// A cursor with a selector only moves over matching messages: the selection
+/// string is given to MQOPEN and the IDs are matched by every MQGET, so the
+/// queue manager filters and messages that do not match are never transferred.
+/// Positions then count matching messages only.
+///
+/// A cursor is not thread-safe and must only be used on the thread of the
+/// MQConnection its handle belongs to.
+final class BrowseCursor {
+
+    // MARK: - Properties
+
+    /// Connection the cursor's handle belongs to
+    let connectionHandle: MQHCONN
+
+    /// Name of the browsed queue
+    let queueName: String
+
+    /// Largest payload returned per message; longer messages are truncated
+    /// A small limit turns the cursor into a preview browse: descriptors plus
+    /// the first bytes of each payload
+    let maxMessageSize: Int
+
+    /// Whether the queue was opened with MQOO_READ_AHEAD
+    let usesReadAhead: Bool
+
+    /// Criteria every browsed message must match
+    let selector: MQService.MessageSelector
+
+    /// Whether payloads are converted to the client's CCSID and encoding (MQGMO_CONVERT)
+    /// An archive takes messages exactly as they are stored on the queue
+    let convertsData: Bool
+
+    /// Initial size of the payload buffer; grown only for messages that need it
+    private static let initialBufferSize = 64 * 1024
+
+    /// Browse handle to the queue
+    private(set) var objectHandle: MQHOBJ = MQHO_UNUSABLE_HOBJ
+
+    /// Payload buffer, allocated on the first read and reused for every message
+    private var buffer: [UInt8] = []
+
+    /// Whether the queue manager's browse cursor is positioned on a message;
+    /// false until the first read and after rewind(), so the next read uses BROWSE_FIRST
+    private(set) var isPositioned = false
+
+    /// Position (0-based) of the message the next read will return
+    private(set) var nextPosition = 0
+
+    /// Whether the last read reached the end of the queue
+    private(set) var isExhausted = false
+
+    /// Whether the queue is open and the cursor can be used
+    var isOpen: Bool {
+        return objectHandle != MQHO_UNUSABLE_HOBJ
+    }
+
+    // MARK: - Initialization
+
+    /// Open a queue for browsing
+    /// - Parameters:
+    ///   - connectionHandle: Handle of an established connection
+    ///   - queueName: Name of the queue to browse
+    ///   - maxMessageSize: Largest payload returned per message in bytes
+    ///   - readAhead: Whether to open the queue with MQOO_READ_AHEAD
+    ///   - selector: Criteria every browsed message must match
+    ///   - convertsData: Whether payloads are converted with MQGMO_CONVERT
+    /// - Throws: MQError if the queue cannot be opened or the selection string is invalid
+    init(
+        connectionHandle: MQHCONN,
+        queueName: String,
+        maxMessageSize: Int,
+        readAhead: Bool = false,
+        selector: MQService.MessageSelector = MQService.MessageSelector(),
+        convertsData: Bool = true
+    ) throws {
+        self.connectionHandle = connectionHandle
+        self.queueName = queueName
+        self.maxMessageSize = maxMessageSize
+        self.usesReadAhead = readAhead
+        self.selector = selector
+        self.convertsData = convertsData
+        try openQueue()
+    }
+
+    deinit {
+        close()
+    }
+
+    /// Close the browse handle. Safe to call more than once
+    func close() {
+        guard objectHandle != MQHO_UNUSABLE_HOBJ else { return }
+
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        let call = MQInstrumentation.shared.begin(.close)
+        MQCLOSE(connectionHandle, &objectHandle, MQCO_NONE, &compCode, &reason)
+        MQInstrumentation.shared.end(call, .close, connection: connectionHandle, queue: queueName, compCode: compCode, reason: reason)
+        objectHandle = MQHO_UNUSABLE_HOBJ
+    }
+
+    // MARK: - Navigation
+
+    /// Move back to the start of the queue; the next read uses BROWSE_FIRST
+    /// and therefore also sees messages put since the cursor was opened
+    func rewind() {
+        isPositioned = false
+        nextPosition = 0
+        isExhausted = false
+    }
+
+    /// Read the next page of messages
+    /// - Parameter maxMessages: Maximum number of messages to return
+    /// - Returns: Up to maxMessages messages; fewer once the end of the queue is reached
+    /// - Throws: MQError if browsing fails
+    func nextPage(maxMessages: Int) throws -> [MQService.MQMessage] {
+        var messages: [MQService.MQMessage] = []
+        messages.reserveCapacity(max(min(maxMessages, 1000), 0))
+
+        while messages.count < maxMessages {
+            guard let message = try browseNext() else {
+                break
+            }
+            messages.append(message)
+        }
+
+        return messages
+    }
+
+    /// Read the next messages with their complete descriptors, for an archive
+    /// - Parameter maxMessages: Maximum number of messages to return
+    /// - Returns: Up to maxMessages records; fewer once the end of the queue is reached
+    /// - Throws: MQError if browsing fails
+    func nextRecords(maxMessages: Int) throws -> [QueueArchive.Record] {
+        var records: [QueueArchive.Record] = []
+        records.reserveCapacity(max(min(maxMessages, 1000), 0))
+
+        while records.count < maxMessages {
+            var messageDescriptor = MQMD.template
+            var getOptions = MQGMO.template
+            guard let result = try browse(
+                options: isPositioned ? MQGMO_BROWSE_NEXT : MQGMO_BROWSE_FIRST,
+                messageDescriptor: &messageDescriptor,
+                getOptions: &getOptions,
+                payloadLimit: maxMessageSize
+            ) else {
+                break
+            }
+            records.append(QueueArchive.Record(
+                descriptor: messageDescriptor,
+                payload: Data(buffer.prefix(result.receivedLength))
+            ))
+        }
+
+        return records
+    }
+
+    /// Move forward over messages without transferring their payloads
+    /// - Parameter count: Number of messages to skip
+    /// - Returns: Number of messages actually skipped (fewer at the end of the queue)
+    /// - Throws: MQError if browsing fails
+    @discardableResult
+    func skip(_ count: Int) throws -> Int {
+        var skipped = 0
+        while skipped < count {
+            var messageDescriptor = MQMD.template
+            var getOptions = MQGMO.template
+            guard try browse(
+                options: isPositioned ? MQGMO_BROWSE_NEXT : MQGMO_BROWSE_FIRST,
+                messageDescriptor: &messageDescriptor,
+                getOptions: &getOptions,
+                payloadLimit: 0
+            ) != nil else {
+                break
+            }
+            skipped += 1
+        }
+        return skipped
+    }
+
+    /// Position the cursor on the message with the given MsgId and return it
+    /// Subsequent pages continue with the messages after it
+    /// - Parameters:
+    ///   - messageId: MsgId of the message (24 bytes)
+    ///   - position: Known position of the message, used for the positions of
+    ///     the messages returned afterwards
+    /// - Returns: The message, or nil if it is no longer on the queue
+    /// - Throws: MQError if browsing fails
+    func seek(messageId: [UInt8], position: Int) throws -> MQService.MQMessage? {
+        var messageDescriptor = MQMD.template
+        MQIField.setBytes(messageId, in: &messageDescriptor.MsgId)
+
+        var getOptions = MQGMO.template
+        getOptions.MatchOptions = MQMO_MATCH_MSG_ID
+
+        return try seek(position: position, messageDescriptor: &messageDescriptor, getOptions: &getOptions)
+    }
+
+    /// Position the cursor on the message with the given MsgToken and return it
+    /// A MsgToken identifies one physical message even when MsgIds are not unique
+    /// - Parameters:
+    ///   - messageToken: MsgToken returned by an earlier browse (16 bytes)
+    ///   - position: Known position of the message
+    /// - Returns: The message, or nil if it is no longer on the queue
+    /// - Throws: MQError if browsing fails
+    func seek(messageToken: [UInt8], position: Int) throws -> MQService.MQMessage? {
+        var messageDescriptor = MQMD.template
+
+        var getOptions = MQGMO.template
+        getOptions.MatchOptions = MQMO_MATCH_MSG_TOKEN
+        MQIField.setBytes(messageToken, in: &getOptions.MsgToken)
+
+        return try seek(position: position, messageDescriptor: &messageDescriptor, getOptions: &getOptions)
+    }
+
+    // MARK: - MQGET
+
+    /// Outcome of one browse MQGET
+    private struct BrowseResult {
+        /// Number of payload bytes received into the buffer
+        let receivedLength: Int
+
+        /// Full length of the message data on the queue
+        let totalLength: Int
+    }
+
+    /// Browse the next message under the cursor, including its payload
+    private func browseNext() throws -> MQService.MQMessage? {
+        var messageDescriptor = MQMD.template
+        var getOptions = MQGMO.template
+        guard let result = try browse(
+            options: isPositioned ? MQGMO_BROWSE_NEXT : MQGMO_BROWSE_FIRST,
+            messageDescriptor: &messageDescriptor,
+            getOptions: &getOptions,
+            payloadLimit: maxMessageSize
+        ) else {
+            return nil
+        }
+        return makeMessage(messageDescriptor: messageDescriptor, getOptions: getOptions, result: result, position: nextPosition - 1)
+    }
+
+    /// Browse the first message matching the prepared descriptor and options
+    private func seek(
+        position: Int,
+        messageDescriptor: inout MQMD,
+        getOptions: inout MQGMO
+    ) throws -> MQService.MQMessage? {
+        guard let result = try browse(
+            options: MQGMO_BROWSE_FIRST,
+            messageDescriptor: &messageDescriptor,
+            getOptions: &getOptions,
+            payloadLimit: maxMessageSize
+        ) else {
+            // Do not rely on where a failed match leaves the queue manager's
+            // cursor; the next page starts again from the beginning
+            rewind()
+            return nil
+        }
+
+        nextPosition = position + 1
+        return makeMessage(messageDescriptor: messageDescriptor, getOptions: getOptions, result: result, position: position)
+    }
+
+    /// Issue one browse MQGET and advance the cursor bookkeeping
+    /// Payloads are read into a buffer that starts small; when a message is
+    /// longer than the buffer but within payloadLimit, the buffer is grown and
+    /// the same message is read again with MQGMO_BROWSE_MSG_UNDER_CURSOR
+    /// - Parameters:
+    ///   - options: MQGMO_BROWSE_FIRST or MQGMO_BROWSE_NEXT
+    ///   - messageDescriptor: Descriptor with any match fields already set
+    ///   - getOptions: Options with any MatchOptions/MsgToken already set
+    ///   - payloadLimit: Maximum number of payload bytes to transfer (0 to skip the payload)
+    /// - Returns: Received and total payload lengths, or nil at the end of the queue
+    /// - Throws: MQError if MQGET fails
+    private func browse(
+        options: MQLONG,
+        messageDescriptor: inout MQMD,
+        getOptions: inout MQGMO,
+        payloadLimit: Int
+    ) throws -> BrowseResult? {
+        guard isOpen else {
+            throw MQError.handleError(message: "Browse cursor for \(queueName) is closed")
+        }
+
+        // Read-ahead cannot serve MQGMO_BROWSE_MSG_UNDER_CURSOR, so never re-read
+        let initialLength = usesReadAhead ? payloadLimit : min(payloadLimit, Self.initialBufferSize)
+        if initialLength > buffer.count {
+            buffer = [UInt8](repeating: 0, count: initialLength)
+        }
+
+        var bufferLength = min(payloadLimit, buffer.count)
+        var dataLength = try get(
+            options: options,
+            messageDescriptor: &messageDescriptor,
+            getOptions: &getOptions,
+            bufferLength: bufferLength
+        )
+
+        guard let totalLength = dataLength else {
+            isExhausted = true
+            return nil
+        }
+
+        isPositioned = true
+        isExhausted = false
+        nextPosition += 1
+
+        if totalLength > bufferLength && bufferLength < payloadLimit {
+            // Read the same message again with a buffer large enough for it.
+            // A fresh descriptor keeps the previous output (Encoding/CCSID)
+            // from being taken as the conversion target
+            bufferLength = min(totalLength, payloadLimit)
+            buffer = [UInt8](repeating: 0, count: bufferLength)
+            messageDescriptor = MQMD.template
+            getOptions.MatchOptions = MQMO_NONE
+            dataLength = try get(
+                options: MQGMO_BROWSE_MSG_UNDER_CURSOR,
+                messageDescriptor: &messageDescriptor,
+                getOptions: &getOptions,
+                bufferLength: bufferLength
+            )
+        }
+
+        let finalLength = dataLength ?? totalLength
+        return BrowseResult(receivedLength: min(finalLength, bufferLength), totalLength: finalLength)
+    }
+
+    /// Call MQGET once with browse options
+    /// - Returns: DataLength (the full message length, even when truncated), or nil if no message
+    /// - Throws: MQError on any failure other than truncation
+    private func get(
+        options: MQLONG,
+        messageDescriptor: inout MQMD,
+        getOptions: inout MQGMO,
+        bufferLength: Int
+    ) throws -> Int? {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        // Reads that match nothing else of their own are limited to the selector's IDs;
+        // a re-read under the cursor already has its message
+        if getOptions.MatchOptions == MQMO_NONE && options != MQGMO_BROWSE_MSG_UNDER_CURSOR {
+            applySelectorIds(to: &messageDescriptor, getOptions: &getOptions)
+        }
+
+        // Version 3 returns the MsgToken of every message browsed
+        getOptions.Version = MQGMO_VERSION_3
+        getOptions.Options = options | MQGMO_NO_SYNCPOINT | MQGMO_ACCEPT_TRUNCATED_MSG | MQGMO_FAIL_IF_QUIESCING
+        if convertsData {
+            getOptions.Options |= MQGMO_CONVERT
+        }
+        getOptions.WaitInterval = 0
+
+        var dataLength: MQLONG = 0
+
+        let call = MQInstrumentation.shared.begin(.get)
+        buffer.withUnsafeMutableBytes { raw in
+            MQGET(
+                connectionHandle,
+                objectHandle,
+                &messageDescriptor,
+                &getOptions,
+                MQLONG(bufferLength),
+                bufferLength > 0 ? raw.baseAddress : nil,
+                &dataLength,
+                &compCode,
+                &reason
+            )
+        }
+        MQInstrumentation.shared.end(
+            call,
+            .get,
+            connection: connectionHandle,
+            queue: queueName,
+            bytes: min(Int(dataLength), bufferLength),
+            compCode: compCode,
+            reason: reason
+        )
+
+        if reason == MQRC_NO_MSG_AVAILABLE {
+            return nil
+        }
+
+        // A truncated payload is expected for previews, skips and oversized messages
+        if compCode == MQCC_FAILED && reason != MQRC_TRUNCATED_MSG_FAILED {
+            throw MQError.operationFailed(
+                operation: "MQGET(browse \(queueName))",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+
+        return Int(dataLength)
+    }
+
+    /// Set the selector's MsgId and CorrelId as match fields of an MQGET
+    private func applySelectorIds(to messageDescriptor: inout MQMD, getOptions: inout MQGMO) {
+        if let messageId = selector.messageId {
+            MQIField.setBytes(messageId, in: &messageDescriptor.MsgId)
+        }
+        if let correlationId = selector.correlationId {
+            MQIField.setBytes(correlationId, in: &messageDescriptor.CorrelId)
+        }
+        getOptions.MatchOptions = selector.matchOptions
+    }
+
+    /// Build a message from the descriptor and the received payload
+    private func makeMessage(
+        messageDescriptor: MQMD,
+        getOptions: MQGMO,
+        result: BrowseResult,
+        position: Int
+    ) -> MQService.MQMessage {
+        MQService.MQMessage(
+            messageDescriptor: messageDescriptor,
+            payload: Data(buffer.prefix(result.receivedLength)),
+            totalLength: result.totalLength,
+            messageToken: MQIField.bytes(of: getOptions.MsgToken),
+            position: position
+        )
+    }
+
+    // MARK: - Queue Handling
+
+    /// Open the queue for browsing
+    private func openQueue() throws {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        var objectDescriptor = MQOD.template
+        MQIField.setString(queueName, in: &objectDescriptor.ObjectName)
+
+        let readAheadOption = usesReadAhead ? MQOO_READ_AHEAD : MQOO_READ_AHEAD_AS_Q_DEF
+
+        // MQOPEN copies the selection string, so it only has to live for the call
+        let selectionString = selector.selectionString ?? ""
+        let call = MQInstrumentation.shared.begin(.open)
+        selectionString.withCString { selectionChars in
+            if !selectionString.isEmpty {
+                objectDescriptor.SelectionString.VSPtr = UnsafeMutableRawPointer(mutating: selectionChars)
+                objectDescriptor.SelectionString.VSLength = MQVS_NUL_TERMINATED
+                objectDescriptor.SelectionString.VSCCSID = MQCCSI_APPL
+            }
+
+            MQOPEN(
+                connectionHandle,
+                &objectDescriptor,
+                MQOO_BROWSE | MQOO_FAIL_IF_QUIESCING | readAheadOption,
+                &objectHandle,
+                &compCode,
+                &reason
+            )
+        }
+        MQInstrumentation.shared.end(call, .open, connection: connectionHandle, queue: queueName, compCode: compCode, reason: reason)
+
+        guard compCode != MQCC_FAILED else {
+            objectHandle = MQHO_UNUSABLE_HOBJ
+            throw MQError.operationFailed(
+                operation: "MQOPEN(\(queueName))",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+    }
+}
+
+// MARK: - Browse Page Source
+
+/// Reads the pages of a browse stream from a cursor the stream owns
+///
+/// Every page is read on the connection thread, and AsyncThrowingStream(unfolding:)
+/// asks for the next element only after the previous one has been consumed, so
+/// the cursor is only ever used by that thread, one page at a time. The cursor
+/// is opened by the first page and closed as soon as the end of the queue or an
+/// error is reached, and otherwise when the stream (and with it this source) is
+/// released.
+///
+/// With a read-ahead depth the cursor uses MQOO_READ_AHEAD, and pages are read
+/// ahead of the consumer, one connection-thread job per page, until that many
+/// messages are waiting. The consumer then takes pages that are already there
+/// and the reads overlap with its processing; a read error is passed on after
+/// the pages read before it.
+final class BrowsePageSource: @unchecked Sendable {
+
+    /// Connection the cursor is opened on and the pages are read through
+    let connection: MQConnection
+
+    /// Name of the browsed queue
+    private let queueName: String
+
+    /// Payload limit of the cursor
+    private let maxMessageSize: Int
+
+    /// Size of the first page
+    private let firstPageSize: Int
+
+    /// Size of every following page
+    private let pageSize: Int
+
+    /// Number of messages to keep read ahead of the consumer; 0 reads on demand only
+    private let readAheadDepth: Int
+
+    /// Criteria the browsed messages must match
+    private let selector: MQService.MessageSelector
+
+    /// Whether payloads are converted with MQGMO_CONVERT
+    private let convertsData: Bool
+
+    /// Cursor the pages are read from; nil before the first page and once finished
+    private var cursor: BrowseCursor?
+
+    /// Whether the end of the queue or an error has been reached
+    private var isFinished = false
+
+    /// Pages read ahead and not yet taken by the consumer
+    private var readAheadPages: [[MQService.MQMessage]] = []
+
+    /// Number of messages in readAheadPages
+    private var readAheadCount = 0
+
+    /// Error of a read-ahead, passed on once the pages before it are taken
+    private var readAheadError: Error?
+
+    /// Whether a read-ahead job is queued on the connection thread
+    private var isReadAheadScheduled = false
+
+    /// Create a source; no MQI call is made until the first page is requested
+    /// - Parameters:
+    ///   - connection: Connection to browse on
+    ///   - queueName: Name of the queue to browse
+    ///   - maxMessageSize: Largest payload returned per message in bytes
+    ///   - firstPageSize: Maximum number of messages in the first page
+    ///   - pageSize: Maximum number of messages in later pages
+    ///   - readAheadDepth: Messages to read ahead of the consumer (0 for none)
+    ///   - selector: Criteria the browsed messages must match
+    ///   - convertsData: Whether payloads are converted with MQGMO_CONVERT
+    init(
+        connection: MQConnection,
+        queueName: String,
+        maxMessageSize: Int,
+        firstPageSize: Int,
+        pageSize: Int,
+        readAheadDepth: Int = 0,
+        selector: MQService.MessageSelector = MQService.MessageSelector(),
+        convertsData: Bool = true
+    ) {
+        self.connection = connection
+        self.queueName = queueName
+        self.maxMessageSize = maxMessageSize
+        self.firstPageSize = max(firstPageSize, 1)
+        self.pageSize = max(pageSize, 1)
+        self.readAheadDepth = max(readAheadDepth, 0)
+        self.selector = selector
+        self.convertsData = convertsData
+    }
+
+    deinit {
+        // Close on the connection thread rather than wherever the stream was released
+        if let cursor {
+            connection.execute { _ in
+                cursor.close()
+            }
+        }
+    }
+
+    /// Read the next page on the connection thread
+    /// - Returns: The next non-empty page, or nil at the end of the queue
+    /// - Throws: MQError if browsing fails
+    func nextPage() async throws -> [MQService.MQMessage]? {
+        return try await connection.perform { connection in
+            defer { self.scheduleReadAhead() }
+            return try self.takePage(on: connection)
+        }
+    }
+
+    /// Take the oldest page read ahead, or read one now
+    private func takePage(on connection: MQConnection) throws -> [MQService.MQMessage]? {
+        if !readAheadPages.isEmpty {
+            let page = readAheadPages.removeFirst()
+            readAheadCount -= page.count
+            return page
+        }
+
+        if let error = readAheadError {
+            readAheadError = nil
+            throw error
+        }
+
+        return try readPage(on: connection)
+    }
+
+    /// Queue the read of one more page if fewer than readAheadDepth messages are waiting
+    /// Each job reads a single page and queues the next, so other work on the
+    /// connection runs in between
+    private func scheduleReadAhead() {
+        guard readAheadDepth > 0, !isReadAheadScheduled, !isFinished,
+              readAheadError == nil, readAheadCount < readAheadDepth else {
+            return
+        }
+
+        isReadAheadScheduled = true
+        // Weak, so a released stream stops reading ahead
+        connection.execute { [weak self] connection in
+            guard let self else { return }
+            self.isReadAheadScheduled = false
+
+            do {
+                if let page = try self.readPage(on: connection) {
+                    self.readAheadPages.append(page)
+                    self.readAheadCount += page.count
+                }
+            } catch {
+                self.readAheadError = error
+            }
+
+            self.scheduleReadAhead()
+        }
+    }
+
+    /// Read the next page, opening the cursor first if needed
+    private func readPage(on connection: MQConnection) throws -> [MQService.MQMessage]? {
+        guard !isFinished else {
+            return nil
+        }
+
+        let size = cursor == nil ? firstPageSize : pageSize
+
+        let page: [MQService.MQMessage]
+        do {
+            let cursor = try self.cursor ?? BrowseCursor(
+                connectionHandle: connection.handle,
+                queueName: queueName,
+                maxMessageSize: maxMessageSize,
+                readAhead: readAheadDepth > 0,
+                selector: selector,
+                convertsData: convertsData
+            )
+            self.cursor = cursor
+            page = try cursor.nextPage(maxMessages: size)
+        } catch {
+            finish()
+            throw error
+        }
+
+        if page.count < size {
+            finish()
+        }
+        return page.isEmpty ? nil : page
+    }
+
+    /// Close the cursor; later pages are empty
+    private func finish() {
+        isFinished = true
+        cursor?.close()
+        cursor = nil
+    }
+}
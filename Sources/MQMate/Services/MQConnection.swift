@@ -0,0 +1,613 @@
+import Foundation
+import CMQC
+
+// MARK: - MQ Connection Thread
+
+/// Dedicated thread that runs the MQI calls of one connection
+///
+/// Jobs run one at a time in submission order, so calls on a connection handle
+/// never overlap and always come from the same thread. MQI calls block until
+/// the queue manager answers; running them here keeps a slow channel from
+/// holding up the main actor or any other connection.
+final class MQConnectionThread: Thread {
+
+    // MARK: - Properties
+
+    /// Guards jobs and isStopping, and wakes the thread when work arrives
+    private let condition = NSCondition()
+
+    /// Jobs waiting to run, oldest first
+    private var jobs: [() -> Void] = []
+
+    /// Whether stop() was called; queued jobs still run, new ones are rejected
+    private var isStopping = false
+
+    /// Whether the caller is running on this thread
+    var isCurrent: Bool {
+        return Thread.current === self
+    }
+
+    // MARK: - Initialization
+
+    /// Create a thread; call start() before submitting jobs
+    /// - Parameter name: Thread name shown in debuggers and crash reports
+    init(name: String) {
+        super.init()
+        self.name = name
+        self.qualityOfService = .userInitiated
+    }
+
+    // MARK: - Jobs
+
+    /// Queue a job to run after every job submitted before it
+    /// - Parameter job: Work to run on the thread
+    /// - Returns: false if the thread is stopping and the job was not queued
+    @discardableResult
+    func enqueue(_ job: @escaping () -> Void) -> Bool {
+        condition.lock()
+        defer { condition.unlock() }
+
+        guard !isStopping else {
+            return false
+        }
+        jobs.append(job)
+        condition.signal()
+        return true
+    }
+
+    /// Let the thread exit once the jobs already queued have run
+    func stop() {
+        condition.lock()
+        isStopping = true
+        condition.signal()
+        condition.unlock()
+    }
+
+    override func main() {
+        while true {
+            condition.lock()
+            while jobs.isEmpty && !isStopping {
+                condition.wait()
+            }
+            // Take the whole backlog so submitters are not blocked while it runs
+            let batch = jobs
+            jobs.removeAll(keepingCapacity: true)
+            let shouldExit = batch.isEmpty && isStopping
+            condition.unlock()
+
+            if shouldExit {
+                return
+            }
+            for job in batch {
+                job()
+            }
+        }
+    }
+}
+
+// MARK: - MQ Connection
+
+/// One queue manager connection and the MQI state that belongs to it
+///
+/// Every MQI call for the connection runs on its own MQConnectionThread through
+/// perform(_:), from MQCONNX to MQDISC. The connection handle, PCF session,
+/// browse cursors and cached queue handles are only touched from inside those
+/// jobs, which is what makes
+/// the @unchecked Sendable conformance sound; callers hand work to the
+/// connection rather than reading its state.
+///
+/// Independent connections have independent threads, so they make progress in
+/// parallel while the work on each one stays serial.
+final class MQConnection: @unchecked Sendable {
+
+    // MARK: - Properties
+
+    /// Name of the connected queue manager
+    let queueManager: String
+
+    /// Connection handle; MQHC_UNUSABLE_HCONN before MQCONNX and after MQDISC
+    private(set) var handle: MQHCONN = MQHC_UNUSABLE_HCONN
+
+    /// PCF command session, opened on the first admin command
+    private var pcfSession: PCFSession?
+
+    /// Open browse cursors used for paging, keyed by queue name
+    var browseCursors: [String: BrowseCursor] = [:]
+
+    /// Open browse cursors used for single-message lookups, keyed by queue name
+    /// Kept apart from the paging cursors so a detail view does not move the list's position
+    var lookupCursors: [String: BrowseCursor] = [:]
+
+    /// Queue handles kept open between operations, keyed by queue name and options
+    private var queueHandles: QueueHandleCache
+
+    /// Thread every MQI call of this connection runs on
+    private let thread: MQConnectionThread
+
+    /// Whether the handle is usable (only meaningful on the connection thread)
+    var isConnected: Bool {
+        return handle != MQHC_UNUSABLE_HCONN
+    }
+
+    // MARK: - Initialization
+
+    private init(queueManager: String, queueHandleCacheSize: Int) {
+        self.queueManager = queueManager
+        self.queueHandles = QueueHandleCache(capacity: queueHandleCacheSize)
+        self.thread = MQConnectionThread(name: "MQMate.MQConnection.\(queueManager)")
+        thread.start()
+    }
+
+    /// Connect to a queue manager with MQCONNX on a new connection thread
+    /// - Parameters:
+    ///   - queueManager: Name of the queue manager to connect to
+    ///   - channel: Server connection channel name
+    ///   - host: Hostname or IP address of the queue manager
+    ///   - port: Port number for the connection
+    ///   - username: Optional username for authentication
+    ///   - password: Optional password for authentication
+    ///   - queueHandleCacheSize: Number of queue handles withQueue keeps open (0 disables the cache)
+    /// - Returns: The established connection
+    /// - Throws: MQError if the connection fails
+    static func connect(
+        queueManager: String,
+        channel: String,
+        host: String,
+        port: Int,
+        username: String?,
+        password: String?,
+        queueHandleCacheSize: Int = 32
+    ) async throws -> MQConnection {
+        let connection = MQConnection(queueManager: queueManager, queueHandleCacheSize: queueHandleCacheSize)
+        do {
+            try await connection.perform { connection in
+                try connection.connectHandle(
+                    channel: channel,
+                    host: host,
+                    port: port,
+                    username: username,
+                    password: password
+                )
+            }
+        } catch {
+            connection.thread.stop()
+            throw error
+        }
+        return connection
+    }
+
+    deinit {
+        thread.stop()
+    }
+
+    // MARK: - Running MQI Calls
+
+    /// Run an operation on the connection thread and wait for its result
+    /// Operations run in the order they are submitted, one at a time
+    /// - Parameter body: Operation to run; receives this connection
+    /// - Returns: The result of body
+    /// - Throws: The error thrown by body, or MQError.notConnected once the
+    ///   connection has been disconnected
+    func perform<T>(_ body: @escaping (MQConnection) throws -> T) async throws -> T {
+        return try await withCheckedThrowingContinuation { continuation in
+            let queued = thread.enqueue {
+                continuation.resume(with: Result { try body(self) })
+            }
+            if !queued {
+                continuation.resume(throwing: MQError.notConnected)
+            }
+        }
+    }
+
+    /// Queue an operation on the connection thread without waiting for it
+    /// Used for cleanup such as closing handles from deinit; dropped once the
+    /// connection has been disconnected, when MQDISC has released every handle
+    /// - Parameter body: Operation to run; receives this connection
+    func execute(_ body: @escaping (MQConnection) -> Void) {
+        thread.enqueue {
+            body(self)
+        }
+    }
+
+    /// Close every handle, disconnect with MQDISC and let the thread exit
+    /// Returns immediately; operations queued earlier still run first and
+    /// operations submitted afterwards fail with MQError.notConnected
+    func disconnect() {
+        thread.enqueue {
+            self.disconnectHandle()
+        }
+        thread.stop()
+    }
+
+    // MARK: - Per-Connection State
+
+    /// Get the PCF session, opening it on first use
+    /// - Returns: A session with the command and reply queues open
+    /// - Throws: MQError if not connected or the session queues cannot be opened
+    func commandSession() throws -> PCFSession {
+        guard isConnected else {
+            throw MQError.notConnected
+        }
+
+        if let session = pcfSession, session.isOpen {
+            return session
+        }
+
+        let session = try PCFSession(connectionHandle: handle)
+        pcfSession = session
+        return session
+    }
+
+    /// Close the PCF session (if any) so the next command opens a fresh one
+    func closeCommandSession() {
+        pcfSession?.close()
+        pcfSession = nil
+    }
+
+    /// Close the browse cursors of a queue
+    /// - Parameter queueName: Name of the queue
+    func closeBrowseCursors(queueName: String) {
+        browseCursors.removeValue(forKey: queueName)?.close()
+        lookupCursors.removeValue(forKey: queueName)?.close()
+    }
+
+    /// Close every browse cursor
+    func closeAllBrowseCursors() {
+        for cursor in browseCursors.values {
+            cursor.close()
+        }
+        for cursor in lookupCursors.values {
+            cursor.close()
+        }
+        browseCursors.removeAll()
+        lookupCursors.removeAll()
+    }
+
+    // MARK: - Queue Handles
+
+    /// Run an operation on an open queue handle, reusing a cached one when possible
+    /// The handle stays open for the next operation with the same queue and
+    /// options, until it is evicted as least recently used. A failure that
+    /// invalidates the handle closes it, so the next call opens the queue again.
+    /// Handles opened for input are never cached and are closed when body returns
+    /// - Parameters:
+    ///   - queueName: Name of the queue
+    ///   - options: MQOO_* options the handle needs
+    ///   - body: Operation to run with the handle; must not close it
+    /// - Returns: The result of body
+    /// - Throws: MQError if the queue cannot be opened or body fails
+    func withQueue<T>(queueName: String, options: MQLONG, _ body: (MQHOBJ) throws -> T) throws -> T {
+        let key = QueueHandleCache.Key(queueName: queueName, options: options)
+        let isCacheable = QueueHandleCache.isCacheable(options: options)
+
+        var objectHandle: MQHOBJ
+        if isCacheable, let cached = queueHandles.handle(for: key) {
+            objectHandle = cached
+        } else {
+            objectHandle = try openQueue(queueName: queueName, options: options)
+            if isCacheable {
+                for var released in queueHandles.insert(objectHandle, for: key) where released != objectHandle {
+                    closeQueue(&released)
+                }
+            }
+        }
+
+        // With caching disabled, or for input, the handle is not kept
+        defer {
+            if !isCacheable || queueHandles.capacity == 0 {
+                closeQueue(&objectHandle)
+            }
+        }
+
+        do {
+            return try body(objectHandle)
+        } catch let error as MQError where error.invalidatesObjectHandle {
+            if var stale = queueHandles.remove(key) {
+                closeQueue(&stale)
+            }
+            throw error
+        }
+    }
+
+    /// Close the cached handles of a queue, e.g. before the queue is deleted
+    /// - Parameter queueName: Name of the queue
+    func closeQueueHandles(queueName: String) {
+        for var objectHandle in queueHandles.removeAll(queueName: queueName) {
+            closeQueue(&objectHandle)
+        }
+    }
+
+    /// Close every cached queue handle
+    func closeAllQueueHandles() {
+        for var objectHandle in queueHandles.removeAll() {
+            closeQueue(&objectHandle)
+        }
+    }
+
+    /// Open a queue for the specified operations
+    /// - Parameters:
+    ///   - queueName: Name of the queue to open
+    ///   - options: MQOO_* options for opening the queue
+    /// - Returns: Object handle for the opened queue
+    /// - Throws: MQError if the queue cannot be opened
+    func openQueue(queueName: String, options: MQLONG) throws -> MQHOBJ {
+        guard isConnected else {
+            throw MQError.notConnected
+        }
+
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+        var objectHandle: MQHOBJ = MQHO_UNUSABLE_HOBJ
+
+        // Object Descriptor (MQOD) for a queue; the name is space-padded to 48 characters
+        var objectDescriptor = MQOD.template
+        MQIField.setString(queueName, in: &objectDescriptor.ObjectName)
+
+        // Call MQOPEN
+        let call = MQInstrumentation.shared.begin(.open)
+        MQOPEN(
+            handle,
+            &objectDescriptor,
+            options,
+            &objectHandle,
+            &compCode,
+            &reason
+        )
+        MQInstrumentation.shared.end(call, .open, connection: handle, queue: queueName, compCode: compCode, reason: reason)
+
+        guard compCode != MQCC_FAILED else {
+            throw MQError.operationFailed(
+                operation: "MQOPEN(\(queueName))",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+
+        return objectHandle
+    }
+
+    /// Close an open queue
+    /// - Parameter objectHandle: Handle returned from openQueue
+    func closeQueue(_ objectHandle: inout MQHOBJ) {
+        guard objectHandle != MQHO_UNUSABLE_HOBJ else { return }
+
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        let call = MQInstrumentation.shared.begin(.close)
+        MQCLOSE(
+            handle,
+            &objectHandle,
+            MQCO_NONE,
+            &compCode,
+            &reason
+        )
+        MQInstrumentation.shared.end(call, .close, connection: handle, compCode: compCode, reason: reason)
+
+        objectHandle = MQHO_UNUSABLE_HOBJ
+    }
+
+    // MARK: - Units of Work
+
+    /// Commit the MQGETs and MQPUTs made under syncpoint since the last commit
+    /// - Throws: MQError if MQCMIT fails; the unit of work is then backed out
+    func commit() throws {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        let call = MQInstrumentation.shared.begin(.commit)
+        MQCMIT(handle, &compCode, &reason)
+        MQInstrumentation.shared.end(call, .commit, connection: handle, compCode: compCode, reason: reason)
+
+        guard compCode != MQCC_FAILED else {
+            throw MQError.operationFailed(
+                operation: "MQCMIT",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+    }
+
+    /// Back out the MQGETs and MQPUTs made under syncpoint since the last commit
+    /// Failures are ignored: a unit of work that cannot be backed out explicitly
+    /// is backed out by the queue manager when the connection ends
+    func backOut() {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        let call = MQInstrumentation.shared.begin(.backOut)
+        MQBACK(handle, &compCode, &reason)
+        MQInstrumentation.shared.end(call, .backOut, connection: handle, compCode: compCode, reason: reason)
+    }
+
+    // MARK: - Asynchronous Put Status
+
+    /// Collect the outcome of the asynchronous puts made since the last call
+    /// MQSTAT resets the counts, so every call covers only the puts made after the previous one
+    /// - Returns: Put counts and the first error or warning
+    /// - Throws: MQError if MQSTAT fails
+    func asyncPutStatus() throws -> MQSTS {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        var status = MQSTS.template
+
+        let call = MQInstrumentation.shared.begin(.status)
+        MQSTAT(handle, MQSTAT_TYPE_ASYNC_ERROR, &status, &compCode, &reason)
+        MQInstrumentation.shared.end(call, .status, connection: handle, compCode: compCode, reason: reason)
+
+        guard compCode != MQCC_FAILED else {
+            throw MQError.operationFailed(
+                operation: "MQSTAT",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+        return status
+    }
+
+    // MARK: - Health Check
+
+    /// Check that the connection still reaches the queue manager
+    /// Opens and closes the queue manager object for inquiry, one round trip each
+    /// - Returns: false if the connection is lost and should be replaced
+    func ping() -> Bool {
+        guard isConnected else {
+            return false
+        }
+
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+        var objectHandle: MQHOBJ = MQHO_UNUSABLE_HOBJ
+
+        // A blank ObjectName with MQOT_Q_MGR refers to the connected queue manager
+        var objectDescriptor = MQOD.template
+        objectDescriptor.ObjectType = MQOT_Q_MGR
+
+        let call = MQInstrumentation.shared.begin(.open)
+        MQOPEN(handle, &objectDescriptor, MQOO_INQUIRE | MQOO_FAIL_IF_QUIESCING, &objectHandle, &compCode, &reason)
+        MQInstrumentation.shared.end(call, .open, connection: handle, compCode: compCode, reason: reason)
+
+        guard compCode != MQCC_FAILED else {
+            // Not being authorized to inquire still proves the connection works
+            let error = MQError.operationFailed(operation: "MQOPEN(queue manager)", completionCode: compCode, reasonCode: reason)
+            return !error.isConnectionLost
+        }
+
+        closeQueue(&objectHandle)
+        return true
+    }
+
+    // MARK: - Connect and Disconnect
+
+    /// Perform the MQCONNX call (runs on the connection thread)
+    private func connectHandle(
+        channel: String,
+        host: String,
+        port: Int,
+        username: String?,
+        password: String?
+    ) throws {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        // Initialize Channel Descriptor (MQCD)
+        var channelDescriptor = MQCD()
+        channelDescriptor.Version = MQCD_VERSION_11
+        channelDescriptor.ChannelType = MQCHT_CLNTCONN
+        channelDescriptor.TransportType = MQXPT_TCP
+
+        // Set channel name (max 20 characters, space-padded)
+        MQIField.setString(channel, in: &channelDescriptor.ChannelName)
+
+        // Set connection name (host(port))
+        MQIField.setString("\(host)(\(port))", in: &channelDescriptor.ConnectionName)
+
+        // Initialize Connection Options (MQCNO)
+        // The handle is only ever used from the connection thread; HANDLE_SHARE_BLOCK
+        // additionally serializes any call that does reach it from elsewhere
+        var connectOptions = MQCNO()
+        connectOptions.Version = MQCNO_VERSION_5
+        connectOptions.Options = MQCNO_HANDLE_SHARE_BLOCK
+
+        // Set the channel definition pointer
+        withUnsafeMutablePointer(to: &channelDescriptor) { cdPtr in
+            connectOptions.ClientConnPtr = UnsafeMutableRawPointer(cdPtr)
+        }
+
+        // Configure authentication if credentials provided
+        var securityParams = MQCSP()
+        if let username = username, !username.isEmpty,
+           let password = password, !password.isEmpty {
+            securityParams.Version = MQCSP_VERSION_1
+            securityParams.AuthenticationType = MQCSP_AUTH_USER_ID_AND_PWD
+
+            // Set user ID
+            let userIdData = username.data(using: .utf8)!
+            userIdData.withUnsafeBytes { rawBuffer in
+                if let baseAddress = rawBuffer.baseAddress {
+                    securityParams.CSPUserIdPtr = UnsafeMutableRawPointer(mutating: baseAddress)
+                    securityParams.CSPUserIdLength = MQLONG(username.utf8.count)
+                }
+            }
+
+            // Set password
+            let passwordData = password.data(using: .utf8)!
+            passwordData.withUnsafeBytes { rawBuffer in
+                if let baseAddress = rawBuffer.baseAddress {
+                    securityParams.CSPPasswordPtr = UnsafeMutableRawPointer(mutating: baseAddress)
+                    securityParams.CSPPasswordLength = MQLONG(password.utf8.count)
+                }
+            }
+
+            withUnsafeMutablePointer(to: &securityParams) { cspPtr in
+                connectOptions.SecurityParmsPtr = UnsafeMutableRawPointer(cspPtr)
+            }
+        }
+
+        // Prepare queue manager name (space-padded to 48 characters)
+        var qmNameChars = queueManager.toMQCharArray(length: Int(MQ_Q_MGR_NAME_LENGTH))
+
+        // Call MQCONNX to connect to the queue manager
+        let call = MQInstrumentation.shared.begin(.connect)
+        qmNameChars.withUnsafeMutableBufferPointer { qmBuffer in
+            withUnsafeMutablePointer(to: &connectOptions) { cnoPtr in
+                MQCONNX(
+                    qmBuffer.baseAddress,
+                    cnoPtr,
+                    &handle,
+                    &compCode,
+                    &reason
+                )
+            }
+        }
+
+        // The handle is only known once MQCONNX returns; name it for the statistics
+        if compCode != MQCC_FAILED {
+            MQInstrumentation.shared.registerConnection(handle, queueManager: queueManager)
+        }
+        MQInstrumentation.shared.end(
+            call,
+            .connect,
+            connection: compCode != MQCC_FAILED ? handle : nil,
+            compCode: compCode,
+            reason: reason
+        )
+
+        // Check result
+        guard compCode != MQCC_FAILED else {
+            handle = MQHC_UNUSABLE_HCONN
+            throw MQError.connectionFailed(
+                reasonCode: reason,
+                queueManager: queueManager
+            )
+        }
+    }
+
+    /// Close every handle and call MQDISC (runs on the connection thread)
+    private func disconnectHandle() {
+        guard handle != MQHC_UNUSABLE_HCONN else {
+            // Already disconnected, nothing to do
+            return
+        }
+
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        // Close the browse cursors, cached queue handles and the PCF session's
+        // queues before the connection goes away
+        closeAllBrowseCursors()
+        closeAllQueueHandles()
+        closeCommandSession()
+
+        // Call MQDISC to disconnect from the queue manager; it resets the handle, so keep a copy
+        let disconnectedHandle = handle
+        let call = MQInstrumentation.shared.begin(.disconnect)
+        MQDISC(&handle, &compCode, &reason)
+        MQInstrumentation.shared.end(call, .disconnect, connection: disconnectedHandle, compCode: compCode, reason: reason)
+
+        // Reset handle regardless of result to ensure we don't try to reuse it
+        // Note: We don't report disconnect failure - cleanup always completes
+        handle = MQHC_UNUSABLE_HCONN
+    }
+}
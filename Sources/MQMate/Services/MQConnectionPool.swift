@@ -0,0 +1,508 @@
+import Foundation
+
+// MARK: - MQ Connection Pool
+
+/// Connections to one queue manager endpoint, shared by the operations of an MQService
+///
+/// Every connection has its own hconn (MQCONNX with MQCNO_HANDLE_SHARE_BLOCK) and
+/// its own thread, so work on different connections runs concurrently. The pool
+/// hands connections out in two ways:
+/// - Roles (admin, browse) get a connection pinned to them, because their state
+///   (the PCF session, the browse cursors) lives on that connection.
+/// - Leases give a one-shot operation (purge, put, delete) exclusive use of an
+///   unpinned connection, so a long purge holds up neither the queue list nor a browse.
+///
+/// Connections are opened on demand up to maximumConnections. At the limit, leases
+/// wait for a connection to be returned and roles share an existing connection.
+/// A periodic health check pings the connections that are not leased, replaces
+/// the lost ones and keeps at least minimumConnections open. A pinned
+/// connection an operation finds lost is discarded at once, like a leased one.
+@MainActor
+public final class MQConnectionPool {
+
+    // MARK: - Types
+
+    /// Queue manager endpoint a pool connects to
+    /// The ConnectionConfig fields that identify a client conversation; display
+    /// name and timestamps do not affect which pool a configuration uses
+    struct Endpoint: Hashable, Sendable {
+        let queueManager: String
+        let channel: String
+        let host: String
+        let port: Int
+        let username: String?
+
+        init(queueManager: String, channel: String, host: String, port: Int, username: String?) {
+            self.queueManager = queueManager
+            self.channel = channel
+            self.host = host
+            self.port = port
+            self.username = username
+        }
+
+        init(config: ConnectionConfig) {
+            self.init(
+                queueManager: config.queueManager,
+                channel: config.channel,
+                host: config.hostname,
+                port: config.port,
+                username: config.username
+            )
+        }
+    }
+
+    /// Pool sizing and health check settings
+    public struct Configuration: Sendable, Equatable {
+        /// Connections kept open at all times (at least 1)
+        public var minimumConnections: Int
+
+        /// Upper limit on open connections (at least minimumConnections)
+        public var maximumConnections: Int
+
+        /// Seconds between health checks; nil disables them
+        public var healthCheckInterval: TimeInterval?
+
+        /// Queue handles each connection keeps open between operations (0 disables the cache)
+        public var queueHandleCacheSize: Int
+
+        public init(
+            minimumConnections: Int = 1,
+            maximumConnections: Int = 4,
+            healthCheckInterval: TimeInterval? = 60,
+            queueHandleCacheSize: Int = 32
+        ) {
+            self.minimumConnections = max(minimumConnections, 1)
+            self.maximumConnections = max(maximumConnections, self.minimumConnections)
+            self.healthCheckInterval = healthCheckInterval
+            self.queueHandleCacheSize = max(queueHandleCacheSize, 0)
+        }
+    }
+
+    /// Long-lived uses that keep state on their connection
+    enum Role: CaseIterable {
+        /// PCF commands; the connection holds the PCF session
+        case admin
+        /// Browsing; the connection holds the browse cursors
+        case browse
+    }
+
+    // MARK: - Properties
+
+    /// Endpoint every connection of the pool is opened to
+    let endpoint: Endpoint
+
+    /// Sizing and health check settings
+    let configuration: Configuration
+
+    /// Password for opening further connections, kept only for the pool's lifetime
+    private let password: String?
+
+    /// Every open connection
+    private var connections: [MQConnection] = []
+
+    /// Connections pinned to a role; several roles may share one at the limit
+    private var pinned: [Role: MQConnection] = [:]
+
+    /// Role assignments in progress, so concurrent callers share one
+    private var pendingRoles: [Role: Task<MQConnection, Error>] = [:]
+
+    /// Unpinned connections available for leasing
+    private var idle: [MQConnection] = []
+
+    /// Unpinned connections currently leased
+    private var leased: [ObjectIdentifier: MQConnection] = [:]
+
+    /// Leases waiting for a connection to be returned, oldest first
+    private var waiters: [CheckedContinuation<MQConnection, Error>] = []
+
+    /// Number of MQCONNX calls in flight, counted against maximumConnections
+    private var openingCount = 0
+
+    /// Periodic health check, cancelled when the pool is closed
+    private var healthCheckTask: Task<Void, Never>?
+
+    /// Whether close() has been called
+    private(set) var isClosed = false
+
+    /// Number of open connections
+    var connectionCount: Int {
+        return connections.count
+    }
+
+    /// Connection for synchronous callers that cannot wait for a role or lease
+    var primaryConnection: MQConnection? {
+        return pinned[.admin] ?? connections.first
+    }
+
+    /// Whether another connection may be opened
+    private var canOpenConnection: Bool {
+        return connections.count + openingCount < configuration.maximumConnections
+    }
+
+    // MARK: - Initialization
+
+    private init(endpoint: Endpoint, password: String?, configuration: Configuration) {
+        self.endpoint = endpoint
+        self.password = password
+        self.configuration = configuration
+    }
+
+    /// Open a pool with its minimum number of connections
+    /// - Parameters:
+    ///   - endpoint: Queue manager endpoint to connect to
+    ///   - password: Optional password for authentication
+    ///   - configuration: Pool sizing and health check settings
+    /// - Returns: The open pool
+    /// - Throws: MQError if the first connection fails
+    static func open(
+        endpoint: Endpoint,
+        password: String?,
+        configuration: Configuration = Configuration()
+    ) async throws -> MQConnectionPool {
+        let pool = MQConnectionPool(endpoint: endpoint, password: password, configuration: configuration)
+
+        // The first connection proves the endpoint and credentials; the rest of
+        // the minimum is opened in parallel and may fail without failing the pool
+        pool.idle.append(try await pool.openConnection())
+        await pool.fillToMinimum()
+        pool.startHealthChecks()
+        return pool
+    }
+
+    /// Disconnect every connection
+    /// Waiting leases fail with MQError.notConnected, and connections still
+    /// being opened are disconnected as soon as MQCONNX returns
+    func close() {
+        guard !isClosed else { return }
+        isClosed = true
+
+        healthCheckTask?.cancel()
+        healthCheckTask = nil
+
+        let waiting = waiters
+        waiters.removeAll()
+        for waiter in waiting {
+            waiter.resume(throwing: MQError.notConnected)
+        }
+
+        for connection in connections {
+            connection.disconnect()
+        }
+        connections.removeAll()
+        pinned.removeAll()
+        idle.removeAll()
+        leased.removeAll()
+    }
+
+    // MARK: - Roles
+
+    /// Get the connection pinned to a role, assigning one on first use
+    /// Takes an idle connection or opens a new one; at the limit the role
+    /// shares a connection with another role
+    /// - Parameter role: The role to get the connection for
+    /// - Returns: The role's connection
+    /// - Throws: MQError.notConnected if the pool is closed
+    func connection(for role: Role) async throws -> MQConnection {
+        try checkOpen()
+
+        if let connection = pinned[role] {
+            return connection
+        }
+        if let pending = pendingRoles[role] {
+            return try await pending.value
+        }
+
+        let assignment = Task { try await self.assignConnection(to: role) }
+        pendingRoles[role] = assignment
+        defer { pendingRoles[role] = nil }
+        return try await assignment.value
+    }
+
+    /// Run an operation on the connection pinned to a role
+    /// A connection the operation finds lost is unpinned and discarded, so the
+    /// role gets a new connection on its next use instead of the broken one
+    /// - Parameters:
+    ///   - role: The role whose connection to use
+    ///   - body: Operation to run on the connection
+    /// - Returns: The result of body
+    /// - Throws: The error thrown by body, or MQError.notConnected if the pool is closed
+    func withConnection<T>(for role: Role, _ body: (MQConnection) async throws -> T) async throws -> T {
+        let connection = try await connection(for: role)
+        do {
+            return try await body(connection)
+        } catch let error as MQError where error.isConnectionLost {
+            discardLost(connection)
+            throw error
+        }
+    }
+
+    /// Discard a connection an operation found lost
+    /// Roles pinned to it get a new connection on their next use; a connection
+    /// already discarded is left alone
+    /// - Parameter connection: A connection handed out by the pool
+    func discardLost(_ connection: MQConnection) {
+        discard(connection)
+    }
+
+    /// Get the connection pinned to a role without assigning one
+    /// - Parameter role: The role
+    /// - Returns: The role's connection, or nil if it has none yet
+    func pinnedConnection(for role: Role) -> MQConnection? {
+        return pinned[role]
+    }
+
+    /// Pick and pin a connection for a role
+    private func assignConnection(to role: Role) async throws -> MQConnection {
+        let connection: MQConnection
+        if let available = idle.popLast() {
+            connection = available
+        } else if canOpenConnection {
+            do {
+                connection = try await openConnection()
+            } catch let error as MQError where !error.isConnectionLost && !connections.isEmpty {
+                // E.g. MQRC_MAX_CONNS_LIMIT_REACHED: share rather than fail
+                connection = try sharedConnection()
+            }
+        } else {
+            connection = try sharedConnection()
+        }
+
+        try checkOpen()
+        pinned[role] = connection
+        return connection
+    }
+
+    /// Connection to share when no new one can be opened
+    private func sharedConnection() throws -> MQConnection {
+        guard let connection = pinned[.admin] ?? pinned[.browse] ?? connections.first else {
+            throw MQError.notConnected
+        }
+        return connection
+    }
+
+    // MARK: - Leases
+
+    /// Run an operation with exclusive use of a connection
+    /// Waits for a connection to be returned when all are leased and the pool
+    /// is at its limit. A connection the operation finds lost is discarded
+    /// rather than returned to the pool
+    /// - Parameter body: Operation to run on the leased connection
+    /// - Returns: The result of body
+    /// - Throws: The error thrown by body, or MQError if no connection can be had
+    func withLease<T>(_ body: (MQConnection) async throws -> T) async throws -> T {
+        let connection = try await acquire()
+        do {
+            let result = try await body(connection)
+            release(connection, isLost: false)
+            return result
+        } catch {
+            release(connection, isLost: (error as? MQError)?.isConnectionLost ?? false)
+            throw error
+        }
+    }
+
+    /// Whether a connection is leased to a single holder
+    /// False for a pinned connection shared by a lease because every connection is pinned
+    /// - Parameter connection: A connection handed to a withLease(_:) operation
+    func isExclusivelyLeased(_ connection: MQConnection) -> Bool {
+        return leased[ObjectIdentifier(connection)] != nil
+    }
+
+    /// Take an unpinned connection for a lease
+    private func acquire() async throws -> MQConnection {
+        try checkOpen()
+
+        if let connection = idle.popLast() {
+            leased[ObjectIdentifier(connection)] = connection
+            return connection
+        }
+
+        if canOpenConnection {
+            do {
+                let connection = try await openConnection()
+                leased[ObjectIdentifier(connection)] = connection
+                return connection
+            } catch let error as MQError where !error.isConnectionLost && !connections.isEmpty {
+                // Fall through to waiting or sharing
+            }
+        }
+
+        // Every connection is pinned: share one, the connection thread keeps
+        // the operations serial
+        guard !leased.isEmpty else {
+            return try sharedConnection()
+        }
+
+        return try await withCheckedThrowingContinuation { continuation in
+            waiters.append(continuation)
+        }
+    }
+
+    /// Return a leased connection to the pool or hand it to the next waiter
+    /// - Parameters:
+    ///   - connection: The connection returned by acquire()
+    ///   - isLost: Whether the connection must be discarded
+    private func release(_ connection: MQConnection, isLost: Bool) {
+        // Shared connections were never counted as leased
+        guard leased.removeValue(forKey: ObjectIdentifier(connection)) != nil else {
+            if isLost {
+                discard(connection)
+            }
+            return
+        }
+
+        if isLost {
+            discard(connection)
+            serveNextWaiterWithNewConnection()
+        } else if !waiters.isEmpty {
+            let waiter = waiters.removeFirst()
+            leased[ObjectIdentifier(connection)] = connection
+            waiter.resume(returning: connection)
+        } else {
+            idle.append(connection)
+        }
+    }
+
+    /// Open a replacement connection for the oldest waiter after a discard
+    private func serveNextWaiterWithNewConnection() {
+        guard !waiters.isEmpty, canOpenConnection else { return }
+        let waiter = waiters.removeFirst()
+
+        Task {
+            do {
+                let connection = try await self.openConnection()
+                self.leased[ObjectIdentifier(connection)] = connection
+                waiter.resume(returning: connection)
+            } catch {
+                waiter.resume(throwing: error)
+            }
+        }
+    }
+
+    // MARK: - Queue Handles
+
+    /// Close every handle the pool's connections hold on a queue
+    /// Closes the browse cursors and the cached queue handles on each
+    /// connection, waiting behind operations already running on it
+    /// - Parameter queueName: Name of the queue
+    func closeQueueHandles(queueName: String) async {
+        for connection in connections {
+            _ = try? await connection.perform { connection in
+                connection.closeBrowseCursors(queueName: queueName)
+                connection.closeQueueHandles(queueName: queueName)
+            }
+        }
+    }
+
+    // MARK: - Health Checks
+
+    /// Ping every connection that is not leased, discard the lost ones and
+    /// top up to the minimum. Runs periodically when healthCheckInterval is set
+    func checkHealth() async {
+        var candidates: [ObjectIdentifier: MQConnection] = [:]
+        for connection in idle + Array(pinned.values) {
+            candidates[ObjectIdentifier(connection)] = connection
+        }
+
+        for connection in candidates.values {
+            let isAlive = (try? await connection.perform { $0.ping() }) ?? false
+            if !isAlive && !isClosed {
+                discard(connection)
+            }
+        }
+
+        await fillToMinimum()
+    }
+
+    /// Start the periodic health check
+    private func startHealthChecks() {
+        guard let interval = configuration.healthCheckInterval, interval > 0 else { return }
+
+        healthCheckTask = Task { [weak self] in
+            while !Task.isCancelled {
+                try? await Task.sleep(nanoseconds: UInt64(interval * 1_000_000_000))
+                guard !Task.isCancelled, let pool = self else { return }
+                await pool.checkHealth()
+            }
+        }
+    }
+
+    // MARK: - Opening and Discarding
+
+    /// Open the idle connections missing from minimumConnections in parallel
+    private func fillToMinimum() async {
+        let missing = configuration.minimumConnections - connections.count - openingCount
+        guard missing > 0, !isClosed else { return }
+
+        await withTaskGroup(of: Void.self) { group in
+            for _ in 0..<missing {
+                group.addTask {
+                    await self.openIdleConnection()
+                }
+            }
+        }
+    }
+
+    /// Open one connection and make it available for leasing
+    /// Failures are ignored; the next health check tries again
+    private func openIdleConnection() async {
+        guard let connection = try? await openConnection() else { return }
+
+        if !waiters.isEmpty {
+            let waiter = waiters.removeFirst()
+            leased[ObjectIdentifier(connection)] = connection
+            waiter.resume(returning: connection)
+        } else {
+            idle.append(connection)
+        }
+    }
+
+    /// Connect a new connection to the endpoint and add it to the pool
+    private func openConnection() async throws -> MQConnection {
+        try checkOpen()
+
+        openingCount += 1
+        defer { openingCount -= 1 }
+
+        let connection = try await MQConnection.connect(
+            queueManager: endpoint.queueManager,
+            channel: endpoint.channel,
+            host: endpoint.host,
+            port: endpoint.port,
+            username: endpoint.username,
+            password: password,
+            queueHandleCacheSize: configuration.queueHandleCacheSize
+        )
+
+        guard !isClosed else {
+            connection.disconnect()
+            throw MQError.notConnected
+        }
+
+        connections.append(connection)
+        return connection
+    }
+
+    /// Remove a connection from the pool and disconnect it
+    /// Roles pinned to it get a new connection on their next use
+    private func discard(_ connection: MQConnection) {
+        let id = ObjectIdentifier(connection)
+        guard connections.contains(where: { ObjectIdentifier($0) == id }) else { return }
+
+        connections.removeAll { ObjectIdentifier($0) == id }
+        idle.removeAll { ObjectIdentifier($0) == id }
+        leased[id] = nil
+        for (role, pinnedConnection) in pinned where ObjectIdentifier(pinnedConnection) == id {
+            pinned[role] = nil
+        }
+
+        connection.disconnect()
+    }
+
+    /// Throw if the pool has been closed
+    private func checkOpen() throws {
+        guard !isClosed else {
+            throw MQError.notConnected
+        }
+    }
+}
@@ -0,0 +1,114 @@
+import Foundation
+import CMQC
+
+// MARK: - MQI Structure Templates
+
+// Default structures built once from the MQxx_DEFAULT initialisers of cmqc.h.
+// A call copies its template and sets only its own fields, so a descriptor
+// always starts with a valid StrucId and the documented defaults (for
+// example Expiry MQEI_UNLIMITED and Format MQFMT_NONE) instead of zeros.
+
+extension MQMD {
+    /// MQMD_DEFAULT at version 2
+    static let template: MQMD = {
+        var messageDescriptor = mqmate_md_default()
+        messageDescriptor.Version = MQMD_VERSION_2
+        return messageDescriptor
+    }()
+}
+
+extension MQGMO {
+    /// MQGMO_DEFAULT at version 2, matching no fields
+    /// MQGMO_DEFAULT matches on MsgId and CorrelId; a get here opts in to the
+    /// fields it matches on, so a reused MQMD never restricts it by accident
+    static let template: MQGMO = {
+        var getOptions = mqmate_gmo_default()
+        getOptions.Version = MQGMO_VERSION_2
+        getOptions.MatchOptions = MQMO_NONE
+        return getOptions
+    }()
+}
+
+extension MQPMO {
+    /// MQPMO_DEFAULT at version 2
+    static let template: MQPMO = {
+        var putOptions = mqmate_pmo_default()
+        putOptions.Version = MQPMO_VERSION_2
+        return putOptions
+    }()
+}
+
+extension MQOD {
+    /// MQOD_DEFAULT at version 4, for a queue
+    static let template: MQOD = {
+        var objectDescriptor = mqmate_od_default()
+        objectDescriptor.Version = MQOD_VERSION_4
+        objectDescriptor.ObjectType = MQOT_Q
+        return objectDescriptor
+    }()
+}
+
+extension MQSTS {
+    /// MQSTS_DEFAULT at version 1, the fields MQSTAT_TYPE_ASYNC_ERROR reports
+    static let template: MQSTS = {
+        var status = mqmate_sts_default()
+        status.Version = MQSTS_VERSION_1
+        return status
+    }()
+}
+
+// MARK: - MQI Field Marshalling
+
+/// Reads and writes the fixed-length fields of MQI structures
+///
+/// Swift imports `MQCHAR[n]` and `MQBYTE[n]` fields as tuples. These work on
+/// a field's bytes as a whole through the CMQC marshalling helpers: one copy
+/// per field, without per-element loops or intermediate arrays.
+enum MQIField {
+
+    // MARK: - Character Fields
+
+    /// Write a string into a character field, blank-padded and cut at the field length
+    /// - Parameters:
+    ///   - value: The string, written as UTF-8
+    ///   - field: A character field such as ObjectName or ReplyToQ
+    static func setString<Field>(_ value: String, in field: inout Field) {
+        var value = value
+        value.withUTF8 { utf8 in
+            withUnsafeMutableBytes(of: &field) { buffer in
+                mqmate_set_chars(buffer.baseAddress, buffer.count, utf8.baseAddress, utf8.count)
+            }
+        }
+    }
+
+    /// Read a character field
+    /// - Parameter field: A character field such as PutApplName
+    /// - Returns: The field's text without trailing blanks and nulls
+    static func string<Field>(of field: Field) -> String {
+        withUnsafeBytes(of: field) { buffer in
+            let length = mqmate_chars_length(buffer.baseAddress, buffer.count)
+            return String(decoding: UnsafeRawBufferPointer(rebasing: buffer.prefix(length)), as: UTF8.self)
+        }
+    }
+
+    // MARK: - Byte Fields
+
+    /// Write bytes into a byte field, zero-padded and cut at the field length
+    /// - Parameters:
+    ///   - bytes: The bytes, such as a MsgId
+    ///   - field: A byte field such as MsgId, CorrelId or MsgToken
+    static func setBytes<Field>(_ bytes: [UInt8], in field: inout Field) {
+        bytes.withUnsafeBytes { source in
+            withUnsafeMutableBytes(of: &field) { buffer in
+                mqmate_set_bytes(buffer.baseAddress, buffer.count, source.baseAddress, source.count)
+            }
+        }
+    }
+
+    /// Read a byte field
+    /// - Parameter field: A byte field such as MsgId
+    /// - Returns: All of the field's bytes
+    static func bytes<Field>(of field: Field) -> [UInt8] {
+        withUnsafeBytes(of: field) { Array($0) }
+    }
+}
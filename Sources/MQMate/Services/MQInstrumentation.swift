@@ -0,0 +1,657 @@
+import Foundation
+import CMQC
+import os
+
+// MARK: - MQI Instrumentation
+
+/// Counts, times and traces the MQI calls the app makes
+///
+/// Call sites bracket each MQI call with begin(_:) and end(_:_:connection:queue:bytes:compCode:reason:).
+/// While recording is off, begin is one relaxed atomic load that returns an
+/// inert interval and end returns at once, so the calls cost next to nothing
+/// when nobody is looking. While recording is on, each call:
+/// - adds its latency to its verb's MQLatencyHistogram, without taking a lock
+/// - adds to the call, warning, failure, byte and time counters of its verb,
+///   its connection and its queue
+/// - is an os_signpost interval in the "MQI" category, for Instruments
+///
+/// A few client-side stages (PCF response decoding, the queue list conversion)
+/// are timed the same way, so a slow refresh can be split into MQI time, PCF wait
+/// (the MQGETs on the reply queue) and the work done with the results.
+///
+/// Recording starts off unless the MQMATE_INSTRUMENTATION environment variable
+/// is 1, which lets a profile cover the connect. The per-connection and
+/// per-queue tables are looked up under a lock, and only while recording.
+final class MQInstrumentation: @unchecked Sendable {
+
+    // MARK: - Verbs
+
+    /// What a measurement is of: an MQI verb or a client-side stage
+    enum Verb: Int, CaseIterable, Sendable {
+        case connect
+        case disconnect
+        case open
+        case close
+        case get
+        case put
+        case inquire
+        case commit
+        case backOut
+        case status
+        case callback
+        case control
+        /// Decoding the responses of a PCF command, between the MQGETs of the reply queue
+        case pcfDecode
+        /// Turning a queue listing into the queue list's models
+        case queueListUpdate
+
+        /// Name shown in the diagnostics panel and exports
+        var name: String {
+            return String(describing: signpostName)
+        }
+
+        /// Name of the signpost interval
+        var signpostName: StaticString {
+            switch self {
+            case .connect: return "MQCONNX"
+            case .disconnect: return "MQDISC"
+            case .open: return "MQOPEN"
+            case .close: return "MQCLOSE"
+            case .get: return "MQGET"
+            case .put: return "MQPUT"
+            case .inquire: return "MQINQ"
+            case .commit: return "MQCMIT"
+            case .backOut: return "MQBACK"
+            case .status: return "MQSTAT"
+            case .callback: return "MQCB"
+            case .control: return "MQCTL"
+            case .pcfDecode: return "PCF decode"
+            case .queueListUpdate: return "Queue list update"
+            }
+        }
+    }
+
+    /// An MQI call in progress, returned by begin(_:)
+    struct Interval {
+        /// Uptime in nanoseconds when the call started; 0 when recording is off
+        fileprivate let start: UInt64
+
+        /// Open signpost interval, nil when recording is off
+        fileprivate let signpost: OSSignpostIntervalState?
+
+        /// Interval of a call made while recording is off
+        fileprivate static let inert = Interval(start: 0, signpost: nil)
+    }
+
+    // MARK: - Properties
+
+    /// Instrumentation shared by every connection
+    static let shared = MQInstrumentation(
+        isEnabled: ProcessInfo.processInfo.environment["MQMATE_INSTRUMENTATION"] == "1"
+    )
+
+    /// Nonzero while recording; read with one relaxed load on every call
+    private let recording: UnsafeMutablePointer<UInt64>
+
+    /// Latency histogram of each verb, indexed by Verb.rawValue
+    private let histograms: [MQLatencyHistogram]
+
+    /// Counters of each verb over all connections and queues
+    private let totals = MQICallCounters()
+
+    /// Guards connectionNames, connections and queues
+    private let lock = NSLock()
+
+    /// Display name of each connection handle, registered by MQConnection
+    private var connectionNames: [MQHCONN: String] = [:]
+
+    /// Counters per connection handle
+    private var connections: [MQHCONN: (name: String, counters: MQICallCounters)] = [:]
+
+    /// Counters per queue name
+    private var queues: [String: MQICallCounters] = [:]
+
+    /// Signposts of the MQI calls, shown by Instruments' os_signpost instrument
+    private let signposter = OSSignposter(subsystem: "com.mqmate", category: "MQI")
+
+    /// Whether calls are being recorded
+    var isEnabled: Bool {
+        get {
+            return mqmate_atomic_load_relaxed(recording) != 0
+        }
+        set {
+            mqmate_atomic_store_release(recording, newValue ? 1 : 0)
+        }
+    }
+
+    // MARK: - Initialization
+
+    /// Create an instrumentation layer with empty statistics
+    /// - Parameter isEnabled: Whether recording starts on
+    init(isEnabled: Bool = false) {
+        recording = .allocate(capacity: 1)
+        recording.initialize(to: isEnabled ? 1 : 0)
+        histograms = Verb.allCases.map { _ in MQLatencyHistogram() }
+    }
+
+    deinit {
+        recording.deallocate()
+    }
+
+    // MARK: - Recording
+
+    /// Start timing a call
+    /// - Parameter verb: The verb about to be called
+    /// - Returns: The interval to pass to end once the call returns
+    @inline(__always)
+    func begin(_ verb: Verb) -> Interval {
+        guard mqmate_atomic_load_relaxed(recording) != 0 else {
+            return .inert
+        }
+        return beginRecording(verb)
+    }
+
+    /// Finish timing a call and record it
+    /// - Parameters:
+    ///   - interval: The interval begin returned
+    ///   - verb: The verb that was called
+    ///   - connection: Connection handle the call was made on, nil for client-side stages
+    ///   - queue: Queue the call was made on, nil if it is not about a queue
+    ///   - bytes: Message bytes put or received
+    ///   - compCode: Completion code of the call
+    ///   - reason: Reason code of the call
+    @inline(__always)
+    func end(
+        _ interval: Interval,
+        _ verb: Verb,
+        connection: MQHCONN?,
+        queue: String? = nil,
+        bytes: Int = 0,
+        compCode: MQLONG = MQCC_OK,
+        reason: MQLONG = MQRC_NONE
+    ) {
+        guard interval.start != 0 else {
+            return
+        }
+        endRecording(interval, verb, connection: connection, queue: queue, bytes: bytes, compCode: compCode, reason: reason)
+    }
+
+    /// Time a client-side stage
+    /// - Parameters:
+    ///   - verb: The stage
+    ///   - body: The work to time
+    /// - Returns: The result of body
+    @inline(__always)
+    func measure<T>(_ verb: Verb, _ body: () throws -> T) rethrows -> T {
+        let interval = begin(verb)
+        defer { end(interval, verb, connection: nil) }
+        return try body()
+    }
+
+    /// Name a connection handle in the statistics
+    /// Called on every MQCONNX, so the name is known when recording is turned on later
+    /// - Parameters:
+    ///   - handle: The connection handle
+    ///   - queueManager: Name of the queue manager it is connected to
+    func registerConnection(_ handle: MQHCONN, queueManager: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        connectionNames[handle] = "\(queueManager) (hconn \(handle))"
+    }
+
+    @inline(never)
+    private func beginRecording(_ verb: Verb) -> Interval {
+        let signpost = signposter.beginInterval(verb.signpostName, id: signposter.makeSignpostID())
+        return Interval(start: max(DispatchTime.now().uptimeNanoseconds, 1), signpost: signpost)
+    }
+
+    @inline(never)
+    private func endRecording(
+        _ interval: Interval,
+        _ verb: Verb,
+        connection: MQHCONN?,
+        queue: String?,
+        bytes: Int,
+        compCode: MQLONG,
+        reason: MQLONG
+    ) {
+        let elapsed = DispatchTime.now().uptimeNanoseconds &- interval.start
+        let byteCount = UInt64(max(bytes, 0))
+
+        if let signpost = interval.signpost {
+            signposter.endInterval(
+                verb.signpostName,
+                signpost,
+                "\(queue ?? "", privacy: .public) CC=\(compCode) RC=\(reason) \(byteCount) bytes"
+            )
+        }
+
+        histograms[verb.rawValue].record(elapsed)
+        totals.add(verb, nanoseconds: elapsed, bytes: byteCount, compCode: compCode)
+
+        guard connection != nil || queue != nil else {
+            return
+        }
+        let (connectionCounters, queueCounters) = scopeCounters(connection: connection, queue: queue)
+        connectionCounters?.add(verb, nanoseconds: elapsed, bytes: byteCount, compCode: compCode)
+        queueCounters?.add(verb, nanoseconds: elapsed, bytes: byteCount, compCode: compCode)
+    }
+
+    /// Look up, or create, the counters of a connection and a queue
+    private func scopeCounters(connection: MQHCONN?, queue: String?) -> (MQICallCounters?, MQICallCounters?) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        var connectionCounters: MQICallCounters?
+        if let connection {
+            if let entry = connections[connection] {
+                connectionCounters = entry.counters
+            } else {
+                let counters = MQICallCounters()
+                connections[connection] = (connectionNames[connection] ?? "hconn \(connection)", counters)
+                connectionCounters = counters
+            }
+        }
+
+        var queueCounters: MQICallCounters?
+        if let queue {
+            if let counters = queues[queue] {
+                queueCounters = counters
+            } else {
+                let counters = MQICallCounters()
+                queues[queue] = counters
+                queueCounters = counters
+            }
+        }
+        return (connectionCounters, queueCounters)
+    }
+
+    // MARK: - Statistics
+
+    /// Latency histogram of a verb
+    /// - Parameter verb: The verb
+    /// - Returns: The histogram its calls are recorded in
+    func histogram(for verb: Verb) -> MQLatencyHistogram {
+        return histograms[verb.rawValue]
+    }
+
+    /// Copy the statistics recorded so far
+    /// Counters keep moving while the copy is taken, so totals of different
+    /// rows can be a few calls apart
+    /// - Returns: Rows for every verb, connection and queue with at least one call
+    func snapshot() -> MQInstrumentationSnapshot {
+        let verbs: [MQInstrumentationSnapshot.VerbRow] = Verb.allCases.compactMap { verb in
+            let calls = totals.value(.calls, for: verb)
+            guard calls > 0 else { return nil }
+            let latency = histograms[verb.rawValue].summary()
+            return MQInstrumentationSnapshot.VerbRow(
+                verb: verb.name,
+                calls: calls,
+                warnings: totals.value(.warnings, for: verb),
+                failures: totals.value(.failures, for: verb),
+                bytes: totals.value(.bytes, for: verb),
+                totalMicroseconds: Double(totals.value(.nanoseconds, for: verb)) / 1_000,
+                meanMicroseconds: latency.mean / 1_000,
+                p50Microseconds: Double(latency.p50) / 1_000,
+                p90Microseconds: Double(latency.p90) / 1_000,
+                p99Microseconds: Double(latency.p99) / 1_000,
+                p999Microseconds: Double(latency.p999) / 1_000,
+                maxMicroseconds: Double(latency.max) / 1_000
+            )
+        }
+
+        lock.lock()
+        let connectionScopes = connections.values.map { ($0.name, $0.counters) }
+        let queueScopes = queues.map { ($0.key, $0.value) }
+        lock.unlock()
+
+        return MQInstrumentationSnapshot(
+            capturedAt: Date(),
+            isRecording: isEnabled,
+            verbs: verbs,
+            connections: Self.scopeRows(connectionScopes),
+            queues: Self.scopeRows(queueScopes)
+        )
+    }
+
+    /// Clear every counter and histogram; connection names are kept
+    func reset() {
+        for histogram in histograms {
+            histogram.reset()
+        }
+        totals.reset()
+
+        lock.lock()
+        connections.removeAll()
+        queues.removeAll()
+        lock.unlock()
+    }
+
+    /// One row per scope and verb with calls, sorted by scope then verb
+    private static func scopeRows(_ scopes: [(String, MQICallCounters)]) -> [MQInstrumentationSnapshot.ScopeRow] {
+        return scopes.sorted { $0.0 < $1.0 }.flatMap { name, counters in
+            Verb.allCases.compactMap { verb -> MQInstrumentationSnapshot.ScopeRow? in
+                let calls = counters.value(.calls, for: verb)
+                guard calls > 0 else { return nil }
+                let nanoseconds = counters.value(.nanoseconds, for: verb)
+                return MQInstrumentationSnapshot.ScopeRow(
+                    scope: name,
+                    verb: verb.name,
+                    calls: calls,
+                    warnings: counters.value(.warnings, for: verb),
+                    failures: counters.value(.failures, for: verb),
+                    bytes: counters.value(.bytes, for: verb),
+                    totalMicroseconds: Double(nanoseconds) / 1_000,
+                    meanMicroseconds: Double(nanoseconds) / Double(calls) / 1_000
+                )
+            }
+        }
+    }
+}
+
+// MARK: - Call Counters
+
+/// Call, warning, failure, byte and time totals of each verb, for one connection, queue or overall
+///
+/// The totals are plain 64-bit cells in one allocation, updated with relaxed
+/// atomic adds from any connection thread.
+final class MQICallCounters: @unchecked Sendable {
+
+    /// A total kept for each verb
+    enum Field: Int, CaseIterable {
+        case calls
+        case warnings
+        case failures
+        case bytes
+        case nanoseconds
+    }
+
+    private static let cellCount = MQInstrumentation.Verb.allCases.count * Field.allCases.count
+
+    /// Totals, Field.allCases.count cells per verb
+    private let cells: UnsafeMutablePointer<UInt64>
+
+    init() {
+        cells = .allocate(capacity: Self.cellCount)
+        cells.initialize(repeating: 0, count: Self.cellCount)
+    }
+
+    deinit {
+        cells.deallocate()
+    }
+
+    private func cell(_ field: Field, for verb: MQInstrumentation.Verb) -> UnsafeMutablePointer<UInt64> {
+        return cells + verb.rawValue * Field.allCases.count + field.rawValue
+    }
+
+    /// Count one call
+    /// - Parameters:
+    ///   - verb: The verb called
+    ///   - nanoseconds: How long the call took
+    ///   - bytes: Message bytes moved
+    ///   - compCode: Completion code; MQCC_WARNING and MQCC_FAILED are counted apart
+    func add(_ verb: MQInstrumentation.Verb, nanoseconds: UInt64, bytes: UInt64, compCode: MQLONG) {
+        mqmate_atomic_fetch_add(cell(.calls, for: verb), 1)
+        mqmate_atomic_fetch_add(cell(.nanoseconds, for: verb), nanoseconds)
+        if bytes > 0 {
+            mqmate_atomic_fetch_add(cell(.bytes, for: verb), bytes)
+        }
+        if compCode == MQCC_WARNING {
+            mqmate_atomic_fetch_add(cell(.warnings, for: verb), 1)
+        } else if compCode == MQCC_FAILED {
+            mqmate_atomic_fetch_add(cell(.failures, for: verb), 1)
+        }
+    }
+
+    /// Read a total
+    func value(_ field: Field, for verb: MQInstrumentation.Verb) -> UInt64 {
+        return mqmate_atomic_load_relaxed(cell(field, for: verb))
+    }
+
+    /// Set every total back to zero
+    func reset() {
+        for index in 0..<Self.cellCount {
+            mqmate_atomic_store_release(cells + index, 0)
+        }
+    }
+}
+
+// MARK: - Latency Histogram
+
+/// Lock-free latency histogram with HDR-style log-linear buckets
+///
+/// Values below 32 ns have a bucket each; above that every power of two is
+/// split into 32 equal buckets, so a bucket is never wider than 1/32 of its
+/// values (about 3% relative error) while 1,184 buckets cover 1 ns to 37
+/// minutes. Recording is a bucket index computed from the leading zero count
+/// and a few relaxed atomic adds, so any number of threads can record at once.
+final class MQLatencyHistogram: @unchecked Sendable {
+
+    /// Percentiles and totals of the recorded values, in nanoseconds
+    struct Summary: Equatable, Sendable {
+        let count: UInt64
+        let mean: Double
+        let p50: UInt64
+        let p90: UInt64
+        let p99: UInt64
+        let p999: UInt64
+        let max: UInt64
+    }
+
+    // MARK: - Bucket Layout
+
+    /// log2 of the buckets per power of two
+    static let subBucketBits = 5
+
+    /// Buckets per power of two
+    static let subBucketCount = 1 << subBucketBits
+
+    /// Largest power of two with its own buckets; longer values go in the last bucket
+    static let highestExponent = 40
+
+    /// Number of buckets
+    static let bucketCount = (highestExponent - subBucketBits + 2) * subBucketCount
+
+    /// Bucket a value is counted in
+    /// - Parameter value: A value in nanoseconds
+    /// - Returns: Index of its bucket
+    static func bucketIndex(of value: UInt64) -> Int {
+        guard value >= UInt64(subBucketCount) else {
+            return Int(value)
+        }
+        let exponent = 63 - value.leadingZeroBitCount
+        guard exponent <= highestExponent else {
+            return bucketCount - 1
+        }
+        let shift = exponent - subBucketBits
+        return (shift + 1) * subBucketCount + Int(value >> UInt64(shift)) - subBucketCount
+    }
+
+    /// Largest value counted in a bucket, which percentiles report
+    /// - Parameter index: Index of the bucket
+    /// - Returns: Its highest value in nanoseconds
+    static func highestValue(inBucket index: Int) -> UInt64 {
+        guard index >= subBucketCount else {
+            return UInt64(index)
+        }
+        let shift = UInt64(index / subBucketCount - 1)
+        let mantissa = UInt64(index % subBucketCount + subBucketCount)
+        return ((mantissa + 1) << shift) - 1
+    }
+
+    // MARK: - Properties
+
+    /// Count of each bucket
+    private let buckets: UnsafeMutablePointer<UInt64>
+
+    /// Sum of the recorded values
+    private let sum: UnsafeMutablePointer<UInt64>
+
+    /// Largest recorded value
+    private let maximum: UnsafeMutablePointer<UInt64>
+
+    // MARK: - Initialization
+
+    init() {
+        buckets = .allocate(capacity: Self.bucketCount)
+        buckets.initialize(repeating: 0, count: Self.bucketCount)
+        sum = .allocate(capacity: 1)
+        sum.initialize(to: 0)
+        maximum = .allocate(capacity: 1)
+        maximum.initialize(to: 0)
+    }
+
+    deinit {
+        buckets.deallocate()
+        sum.deallocate()
+        maximum.deallocate()
+    }
+
+    // MARK: - Recording
+
+    /// Record a value; safe to call from any number of threads at once
+    /// - Parameter nanoseconds: The latency to record
+    func record(_ nanoseconds: UInt64) {
+        mqmate_atomic_fetch_add(buckets + Self.bucketIndex(of: nanoseconds), 1)
+        mqmate_atomic_fetch_add(sum, nanoseconds)
+        mqmate_atomic_store_max(maximum, nanoseconds)
+    }
+
+    /// Set every bucket back to zero
+    /// Values recorded while the reset runs may survive it
+    func reset() {
+        for index in 0..<Self.bucketCount {
+            mqmate_atomic_store_release(buckets + index, 0)
+        }
+        mqmate_atomic_store_release(sum, 0)
+        mqmate_atomic_store_release(maximum, 0)
+    }
+
+    // MARK: - Reading
+
+    /// Compute the percentiles of the values recorded so far
+    /// - Returns: The summary; all zero if nothing was recorded
+    func summary() -> Summary {
+        var counts = [UInt64](repeating: 0, count: Self.bucketCount)
+        var count: UInt64 = 0
+        for index in 0..<Self.bucketCount {
+            counts[index] = mqmate_atomic_load_relaxed(buckets + index)
+            count += counts[index]
+        }
+        let maximum = mqmate_atomic_load_relaxed(self.maximum)
+
+        guard count > 0 else {
+            return Summary(count: 0, mean: 0, p50: 0, p90: 0, p99: 0, p999: 0, max: 0)
+        }
+
+        /// Highest value of the bucket holding the value at the percentile (nearest rank)
+        func value(atPercentile percentile: Double) -> UInt64 {
+            let rank = max(UInt64((percentile / 100 * Double(count)).rounded(.up)), 1)
+            var seen: UInt64 = 0
+            for index in 0..<Self.bucketCount {
+                seen += counts[index]
+                if seen >= rank {
+                    return min(Self.highestValue(inBucket: index), maximum)
+                }
+            }
+            return maximum
+        }
+
+        return Summary(
+            count: count,
+            mean: Double(mqmate_atomic_load_relaxed(sum)) / Double(count),
+            p50: value(atPercentile: 50),
+            p90: value(atPercentile: 90),
+            p99: value(atPercentile: 99),
+            p999: value(atPercentile: 99.9),
+            max: maximum
+        )
+    }
+}
+
+// MARK: - Snapshot
+
+/// Statistics copied out of MQInstrumentation, for the diagnostics panel and exports
+struct MQInstrumentationSnapshot: Codable, Sendable {
+
+    /// Totals and latency percentiles of one verb over every connection
+    struct VerbRow: Codable, Sendable, Identifiable {
+        let verb: String
+        let calls: UInt64
+        let warnings: UInt64
+        let failures: UInt64
+        let bytes: UInt64
+        let totalMicroseconds: Double
+        let meanMicroseconds: Double
+        let p50Microseconds: Double
+        let p90Microseconds: Double
+        let p99Microseconds: Double
+        let p999Microseconds: Double
+        let maxMicroseconds: Double
+
+        var id: String { verb }
+    }
+
+    /// Totals of one verb on one connection or queue
+    struct ScopeRow: Codable, Sendable, Identifiable {
+        let scope: String
+        let verb: String
+        let calls: UInt64
+        let warnings: UInt64
+        let failures: UInt64
+        let bytes: UInt64
+        let totalMicroseconds: Double
+        let meanMicroseconds: Double
+
+        var id: String { "\(scope)|\(verb)" }
+    }
+
+    let capturedAt: Date
+    let isRecording: Bool
+    let verbs: [VerbRow]
+    let connections: [ScopeRow]
+    let queues: [ScopeRow]
+
+    /// The snapshot as pretty-printed JSON with ISO 8601 dates
+    func jsonData() throws -> Data {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        encoder.dateEncodingStrategy = .iso8601
+        return try encoder.encode(self)
+    }
+
+    /// The snapshot as CSV: one line per verb, connection and queue row,
+    /// the first column telling which table it belongs to
+    func csv() -> String {
+        var lines = ["table,scope,verb,calls,warnings,failures,bytes,total_us,mean_us,p50_us,p90_us,p99_us,p999_us,max_us"]
+
+        func field(_ text: String) -> String {
+            guard text.contains(where: { $0 == "," || $0 == "\"" || $0 == "\n" }) else {
+                return text
+            }
+            return "\"\(text.replacingOccurrences(of: "\"", with: "\"\""))\""
+        }
+
+        func number(_ value: Double) -> String {
+            return String(format: "%.3f", value)
+        }
+
+        for row in verbs {
+            lines.append([
+                "verb", "", field(row.verb), "\(row.calls)", "\(row.warnings)", "\(row.failures)", "\(row.bytes)",
+                number(row.totalMicroseconds), number(row.meanMicroseconds), number(row.p50Microseconds),
+                number(row.p90Microseconds), number(row.p99Microseconds), number(row.p999Microseconds),
+                number(row.maxMicroseconds)
+            ].joined(separator: ","))
+        }
+        for (table, rows) in [("connection", connections), ("queue", queues)] {
+            for row in rows {
+                lines.append([
+                    table, field(row.scope), field(row.verb), "\(row.calls)", "\(row.warnings)", "\(row.failures)",
+                    "\(row.bytes)", number(row.totalMicroseconds), number(row.meanMicroseconds), "", "", "", "", ""
+                ].joined(separator: ","))
+            }
+        }
+        return lines.joined(separator: "\n") + "\n"
+    }
+}
@@ -23,11 +23,14 @@ public protocol MQServiceProtocol {
     func disconnect()
 
     /// Get information about a specific queue
-    func getQueueInfo(queueName: String) throws -> MQService.QueueInfo
+    func getQueueInfo(queueName: String) async throws -> MQService.QueueInfo
 
     /// List all queues in the connected queue manager
     func listQueues(filter: String) async throws -> [MQService.QueueInfo]
 
+    /// Read only the depth and open counts of the local queues matching a filter
+    func inquireQueueDepths(filter: String) async throws -> [MQService.QueueDepthStatus]
+
     /// Create a new queue in the connected queue manager
     func createQueue(queueName: String, queueType: MQQueueType, maxDepth: Int32?) async throws
 
@@ -37,6 +40,13 @@ public protocol MQServiceProtocol {
     /// Purge all messages from a queue using destructive MQGET
     func purgeQueue(queueName: String) async throws -> Int
 
+    /// Purge all messages from a queue with a chosen strategy, reporting progress as messages are removed
+    func purgeQueue(
+        queueName: String,
+        options: MQService.PurgeOptions,
+        progress: (@MainActor (Int) -> Void)?
+    ) async throws -> MQService.PurgeResult
+
     /// Send a message to a queue using MQPUT
     func sendMessage(
         queueName: String,
@@ -48,29 +58,399 @@ public protocol MQServiceProtocol {
         priority: Int32?
     ) async throws -> [UInt8]
 
+    /// Send a sequence of messages to a queue in batches, reporting the outcome of every batch
+    func sendMessages(
+        queueName: String,
+        batch messages: [MQService.OutgoingMessage],
+        commitInterval: Int,
+        responseMode: MQService.PutResponseMode,
+        progress: (@MainActor (MQService.SendBatchResult) -> Void)?
+    ) async throws -> [MQService.SendBatchResult]
+
+    /// Write every message of a queue, descriptor and payload, to an archive file
+    func dumpQueue(
+        queueName: String,
+        to url: URL,
+        compressed: Bool,
+        progress: (@MainActor (Int) -> Void)?
+    ) async throws -> Int
+
+    /// Put every message of an archive file to a queue in batches, reporting the outcome of every batch
+    func loadQueue(
+        queueName: String,
+        from url: URL,
+        commitInterval: Int,
+        restoresContext: Bool,
+        progress: (@MainActor (MQService.SendBatchResult) -> Void)?
+    ) async throws -> [MQService.SendBatchResult]
+
     /// Delete a specific message from a queue using destructive MQGET with message ID match
     func deleteMessage(queueName: String, messageId: [UInt8]) async throws
+
+    /// Delete, move or copy a set of messages by MsgId, committing every commitInterval messages
+    func processMessages(
+        queueName: String,
+        messageIds: [[UInt8]],
+        action: MQService.BulkMessageAction,
+        commitInterval: Int,
+        progress: (@MainActor (MQService.BulkBatchResult) -> Void)?
+    ) async throws -> [MQService.BulkBatchResult]
+
+    /// Browse the first page of messages in a queue, restarting its browse cursor
+    func browseMessages(queueName: String, maxMessages: Int) async throws -> [MQService.MQMessage]
+
+    /// Browse the page of messages following the last page returned for a queue
+    func browseNextMessages(queueName: String, maxMessages: Int) async throws -> [MQService.MQMessage]
+
+    /// Browse one message with its complete payload by MsgId
+    func browseMessage(queueName: String, messageId: [UInt8]) async throws -> MQService.MQMessage?
+
+    /// Browse a queue as a stream of message pages, read as the consumer asks for them
+    func browseMessageStream(queueName: String, pageSize: Int) -> AsyncThrowingStream<[MQService.MQMessage], Error>
+
+    /// Stream the messages of a queue that match a selector applied by the queue manager
+    func browseMessageStream(
+        queueName: String,
+        pageSize: Int,
+        selector: MQService.MessageSelector
+    ) -> AsyncThrowingStream<[MQService.MQMessage], Error>
+
+    /// Close the browse cursors kept open for a queue
+    func closeBrowseCursor(queueName: String)
+
+    /// Set how many messages browse streams read ahead of their consumer (0 for none)
+    func setBrowseReadAheadDepth(_ depth: Int)
+
+    /// Set whether browses ask the queue manager to convert payloads (MQGMO_CONVERT)
+    func setBrowseDataConversion(_ converts: Bool)
+
+    /// Stream the messages arriving on a queue as they land, in batches coalesced per UI frame
+    func tailMessageStream(queueName: String, mode: MQService.TailMode) -> AsyncThrowingStream<[MQService.MQMessage], Error>
+}
+
+// MARK: - MQ Service Protocol Defaults
+
+public extension MQServiceProtocol {
+    /// Default implementation for services that cannot browse
+    func browseMessages(queueName: String, maxMessages: Int) async throws -> [MQService.MQMessage] {
+        throw MQError.notConnected
+    }
+
+    /// Default implementation for services without browse cursors: no further pages
+    func browseNextMessages(queueName: String, maxMessages: Int) async throws -> [MQService.MQMessage] {
+        return []
+    }
+
+    /// Default implementation built on the page-based browse requirements
+    func browseMessageStream(queueName: String, pageSize: Int) -> AsyncThrowingStream<[MQService.MQMessage], Error> {
+        let source = ServicePageSource(service: self, queueName: queueName, pageSize: pageSize)
+        return AsyncThrowingStream {
+            try await source.nextPage()
+        }
+    }
+
+    /// Default implementation for services without server-side selection: IDs are
+    /// matched on the client, pages that keep no message are skipped, and
+    /// selection strings are rejected since only a queue manager can evaluate them
+    func browseMessageStream(
+        queueName: String,
+        pageSize: Int,
+        selector: MQService.MessageSelector
+    ) -> AsyncThrowingStream<[MQService.MQMessage], Error> {
+        guard selector.selectionString == nil else {
+            return AsyncThrowingStream { continuation in
+                continuation.finish(throwing: MQError.invalidOptions(message: "Selection strings need a queue manager connection"))
+            }
+        }
+
+        var iterator = browseMessageStream(queueName: queueName, pageSize: pageSize).makeAsyncIterator()
+        return AsyncThrowingStream {
+            while let page = try await iterator.next() {
+                let matching = page.filter { selector.matchesIds(of: $0) }
+                if !matching.isEmpty {
+                    return matching
+                }
+            }
+            return nil
+        }
+    }
+
+    /// Default implementation for services that only list complete messages
+    func browseMessage(queueName: String, messageId: [UInt8]) async throws -> MQService.MQMessage? {
+        return nil
+    }
+
+    /// Default implementation for services without browse cursors
+    func closeBrowseCursor(queueName: String) {
+        // Nothing to close
+    }
+
+    /// Default implementation for services that always browse on demand
+    func setBrowseReadAheadDepth(_ depth: Int) {
+        // Nothing to read ahead
+    }
+
+    /// Default implementation for services that do not browse through the MQI
+    func setBrowseDataConversion(_ converts: Bool) {
+        // Nothing to convert
+    }
+
+    /// Default implementation for services without asynchronous consume: a tail that delivers nothing
+    func tailMessageStream(queueName: String, mode: MQService.TailMode) -> AsyncThrowingStream<[MQService.MQMessage], Error> {
+        return AsyncThrowingStream { continuation in
+            continuation.finish()
+        }
+    }
+
+    /// Default implementation built on sendMessage, one put per message and no units of work:
+    /// messages put before a failure stay on the queue and are listed in the failed batch.
+    /// Every put is synchronous, whatever the response mode
+    func sendMessages(
+        queueName: String,
+        batch messages: [MQService.OutgoingMessage],
+        commitInterval: Int,
+        responseMode: MQService.PutResponseMode,
+        progress: (@MainActor (MQService.SendBatchResult) -> Void)?
+    ) async throws -> [MQService.SendBatchResult] {
+        let batchSize = max(commitInterval, 1)
+        var results: [MQService.SendBatchResult] = []
+
+        for startIndex in stride(from: 0, to: messages.count, by: batchSize) {
+            let startTime = Date()
+            let batch = messages[startIndex..<min(startIndex + batchSize, messages.count)]
+            var messageIds: [[UInt8]] = []
+            var failure: MQError?
+
+            for message in batch {
+                do {
+                    messageIds.append(try await sendMessage(
+                        queueName: queueName,
+                        payload: message.payload,
+                        correlationId: message.correlationId,
+                        replyToQueue: message.replyToQueue,
+                        messageType: message.messageType,
+                        persistence: message.persistence,
+                        priority: message.priority
+                    ))
+                } catch {
+                    failure = (error as? MQError) ?? .unknown(reasonCode: MQRC_UNEXPECTED_ERROR)
+                    break
+                }
+            }
+
+            let result = MQService.SendBatchResult(
+                startIndex: startIndex,
+                messageCount: batch.count,
+                messageIds: messageIds,
+                duration: Date().timeIntervalSince(startTime),
+                error: failure
+            )
+            results.append(result)
+            await progress?(result)
+
+            if failure != nil || Task.isCancelled {
+                break
+            }
+        }
+
+        return results
+    }
+
+    /// Default implementation built on deleteMessage, browseMessage and sendMessage, one call per
+    /// message and no units of work: messages handled before a failure stay handled and are listed
+    /// in the failed batch. Moved and copied messages get new MsgIds and context
+    func processMessages(
+        queueName: String,
+        messageIds: [[UInt8]],
+        action: MQService.BulkMessageAction,
+        commitInterval: Int,
+        progress: (@MainActor (MQService.BulkBatchResult) -> Void)?
+    ) async throws -> [MQService.BulkBatchResult] {
+        let batchSize = max(commitInterval, 1)
+        var results: [MQService.BulkBatchResult] = []
+
+        for startIndex in stride(from: 0, to: messageIds.count, by: batchSize) {
+            let startTime = Date()
+            let batch = messageIds[startIndex..<min(startIndex + batchSize, messageIds.count)]
+            var processedIds: [[UInt8]] = []
+            var missingIds: [[UInt8]] = []
+            var failure: MQError?
+
+            for messageId in batch {
+                do {
+                    if let targetQueue = action.targetQueue {
+                        guard let message = try await browseMessage(queueName: queueName, messageId: messageId) else {
+                            missingIds.append(messageId)
+                            continue
+                        }
+                        _ = try await sendMessage(
+                            queueName: targetQueue,
+                            payload: message.payload,
+                            correlationId: message.correlationId,
+                            replyToQueue: message.replyToQueue.isEmpty ? nil : message.replyToQueue,
+                            messageType: message.messageType,
+                            persistence: message.persistence,
+                            priority: message.priority
+                        )
+                    }
+                    if action.removesMessages {
+                        try await deleteMessage(queueName: queueName, messageId: messageId)
+                    }
+                    processedIds.append(messageId)
+                } catch let error as MQError where error.isNoMessageAvailable {
+                    missingIds.append(messageId)
+                } catch {
+                    failure = (error as? MQError) ?? .unknown(reasonCode: MQRC_UNEXPECTED_ERROR)
+                    break
+                }
+            }
+
+            let result = MQService.BulkBatchResult(
+                startIndex: startIndex,
+                messageCount: batch.count,
+                processedIds: processedIds,
+                missingIds: missingIds,
+                duration: Date().timeIntervalSince(startTime),
+                error: failure
+            )
+            results.append(result)
+            await progress?(result)
+
+            if failure != nil || Task.isCancelled {
+                break
+            }
+        }
+
+        return results
+    }
+
+    /// Default implementation for services without raw descriptor access: archives are not supported
+    func dumpQueue(
+        queueName: String,
+        to url: URL,
+        compressed: Bool,
+        progress: (@MainActor (Int) -> Void)?
+    ) async throws -> Int {
+        throw MQError.invalidOptions(message: "Queue archives are not supported by this service")
+    }
+
+    /// Default implementation for services without raw descriptor access: archives are not supported
+    func loadQueue(
+        queueName: String,
+        from url: URL,
+        commitInterval: Int,
+        restoresContext: Bool,
+        progress: (@MainActor (MQService.SendBatchResult) -> Void)?
+    ) async throws -> [MQService.SendBatchResult] {
+        throw MQError.invalidOptions(message: "Queue archives are not supported by this service")
+    }
+
+    /// Default implementation built on the full queue listing
+    func inquireQueueDepths(filter: String) async throws -> [MQService.QueueDepthStatus] {
+        try await listQueues(filter: filter)
+            .filter { $0.queueType == .local }
+            .map { info in
+                MQService.QueueDepthStatus(
+                    name: info.name,
+                    currentDepth: info.currentDepth,
+                    openInputCount: info.openInputCount,
+                    openOutputCount: info.openOutputCount
+                )
+            }
+    }
+
+    /// Default implementation built on the single-call purge: one progress report at the end
+    func purgeQueue(
+        queueName: String,
+        options: MQService.PurgeOptions,
+        progress: (@MainActor (Int) -> Void)?
+    ) async throws -> MQService.PurgeResult {
+        let removedCount = try await purgeQueue(queueName: queueName)
+        await progress?(removedCount)
+        return MQService.PurgeResult(removedCount: removedCount, strategy: .destructiveGet)
+    }
+}
+
+/// Page state for the default browseMessageStream implementation
+/// The stream asks for one page at a time, so the state is never accessed concurrently
+private final class ServicePageSource: @unchecked Sendable {
+    private let service: MQServiceProtocol
+    private let queueName: String
+    private let pageSize: Int
+    private var isFirstPage = true
+    private var isFinished = false
+
+    init(service: MQServiceProtocol, queueName: String, pageSize: Int) {
+        self.service = service
+        self.queueName = queueName
+        self.pageSize = pageSize
+    }
+
+    func nextPage() async throws -> [MQService.MQMessage]? {
+        guard !isFinished else { return nil }
+
+        let page: [MQService.MQMessage]
+        if isFirstPage {
+            isFirstPage = false
+            page = try await service.browseMessages(queueName: queueName, maxMessages: pageSize)
+        } else {
+            page = try await service.browseNextMessages(queueName: queueName, maxMessages: pageSize)
+        }
+
+        isFinished = page.count < pageSize
+        return page.isEmpty ? nil : page
+    }
 }
 
 // MARK: - MQ Service Implementation
 
 /// Service for interacting with IBM MQ queue managers
 /// Provides connect/disconnect functionality using the IBM MQ C client library
+/// The service lives on the main actor, but the blocking MQI calls do not: each
+/// connection runs them on its own thread (see MQConnection)
 @MainActor
 public final class MQService: MQServiceProtocol {
 
     // MARK: - Properties
 
-    /// Connection handle for the current queue manager connection
-    /// Initialized to MQHC_UNUSABLE_HCONN to indicate no active connection
-    private var connectionHandle: MQHCONN = MQHC_UNUSABLE_HCONN
+    /// Connections to the current queue manager, nil when not connected
+    /// Admin commands, browsing and destructive operations each get their own
+    /// connection, so they run concurrently; every MQI call is handed to one
+    /// with perform(_:) and runs on that connection's thread
+    private var pool: MQConnectionPool?
+
+    /// Sizing and health check settings of the connection pool
+    /// Applies to the next connect
+    public var poolConfiguration = MQConnectionPool.Configuration()
 
     /// Name of the currently connected queue manager
     private(set) var connectedQueueManager: String?
 
+    /// Largest payload returned per browsed message; longer messages are truncated
+    /// Applies to cursors opened after it is changed
+    public var maxBrowseMessageSize = 4 * 1024 * 1024
+
+    /// Number of payload bytes transferred per message when paging through a queue
+    /// Pages then carry descriptors plus a preview, and the full payload is fetched
+    /// with browseMessage(queueName:messageId:) when needed. nil transfers
+    /// complete payloads (up to maxBrowseMessageSize) in every page
+    public var browsePreviewLength: Int? = 4 * 1024
+
+    /// Number of messages a browse stream reads ahead of its consumer; 0 reads on demand
+    /// Above 0 the stream's cursor opens the queue with MQOO_READ_AHEAD, so
+    /// non-persistent messages arrive without a round trip per MQGET. Applies
+    /// to streams started after it is changed
+    public var browseReadAheadDepth = 0
+
+    /// Whether browses ask the queue manager to convert payloads (MQGMO_CONVERT)
+    /// When false, payloads arrive as they are stored and are decoded on the
+    /// client by their CodedCharSetId and Encoding, and only when shown; see
+    /// CharacterSetConverter. Applies to cursors opened after it is changed
+    public var convertsBrowsedData = true
+
     /// Check if currently connected to a queue manager
     public var isConnected: Bool {
-        return connectionHandle != MQHC_UNUSABLE_HCONN
+        return pool != nil
     }
 
     // MARK: - Initialization
@@ -123,175 +503,94 @@ public final class MQService: MQServiceProtocol {
             throw MQError.invalidConfiguration(message: "Port must be between 1 and 65535")
         }
 
-        // Perform connection on background thread to avoid blocking UI
-        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
-            Task.detached { [self] in
-                do {
-                    try await MainActor.run {
-                        try self.performConnect(
-                            queueManager: queueManager,
-                            channel: channel,
-                            host: host,
-                            port: port,
-                            username: username,
-                            password: password
-                        )
-                    }
-                    continuation.resume()
-                } catch {
-                    continuation.resume(throwing: error)
-                }
-            }
-        }
-    }
-
-    /// Perform the actual MQ connection (must be called on main actor)
-    private func performConnect(
-        queueManager: String,
-        channel: String,
-        host: String,
-        port: Int,
-        username: String?,
-        password: String?
-    ) throws {
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
-
-        // Initialize Channel Descriptor (MQCD)
-        var channelDescriptor = MQCD()
-        channelDescriptor.Version = MQCD_VERSION_11
-        channelDescriptor.ChannelType = MQCHT_CLNTCONN
-        channelDescriptor.TransportType = MQXPT_TCP
-
-        // Set channel name (max 20 characters, space-padded)
-        let channelChars = channel.toMQCharArray(length: Int(MQ_CHANNEL_NAME_LENGTH))
-        withUnsafeMutablePointer(to: &channelDescriptor.ChannelName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_CHANNEL_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_CHANNEL_NAME_LENGTH) {
-                bound[i] = channelChars[i]
-            }
-        }
-
-        // Set connection name (host(port))
-        let connectionName = "\(host)(\(port))"
-        let connectionChars = connectionName.toMQCharArray(length: Int(MQ_CONN_NAME_LENGTH))
-        withUnsafeMutablePointer(to: &channelDescriptor.ConnectionName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_CONN_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_CONN_NAME_LENGTH) {
-                bound[i] = connectionChars[i]
-            }
-        }
-
-        // Initialize Connection Options (MQCNO)
-        var connectOptions = MQCNO()
-        connectOptions.Version = MQCNO_VERSION_5
-        connectOptions.Options = MQCNO_HANDLE_SHARE_BLOCK
-
-        // Set the channel definition pointer
-        withUnsafeMutablePointer(to: &channelDescriptor) { cdPtr in
-            connectOptions.ClientConnPtr = UnsafeMutableRawPointer(cdPtr)
-        }
-
-        // Configure authentication if credentials provided
-        var securityParams = MQCSP()
-        if let username = username, !username.isEmpty,
-           let password = password, !password.isEmpty {
-            securityParams.Version = MQCSP_VERSION_1
-            securityParams.AuthenticationType = MQCSP_AUTH_USER_ID_AND_PWD
-
-            // Set user ID
-            let userIdData = username.data(using: .utf8)!
-            userIdData.withUnsafeBytes { rawBuffer in
-                if let baseAddress = rawBuffer.baseAddress {
-                    securityParams.CSPUserIdPtr = UnsafeMutableRawPointer(mutating: baseAddress)
-                    securityParams.CSPUserIdLength = MQLONG(username.utf8.count)
-                }
-            }
-
-            // Set password
-            let passwordData = password.data(using: .utf8)!
-            passwordData.withUnsafeBytes { rawBuffer in
-                if let baseAddress = rawBuffer.baseAddress {
-                    securityParams.CSPPasswordPtr = UnsafeMutableRawPointer(mutating: baseAddress)
-                    securityParams.CSPPasswordLength = MQLONG(password.utf8.count)
-                }
-            }
-
-            withUnsafeMutablePointer(to: &securityParams) { cspPtr in
-                connectOptions.SecurityParmsPtr = UnsafeMutableRawPointer(cspPtr)
-            }
-        }
-
-        // Prepare queue manager name (space-padded to 48 characters)
-        var qmNameChars = queueManager.toMQCharArray(length: Int(MQ_Q_MGR_NAME_LENGTH))
-
-        // Call MQCONNX to connect to the queue manager
-        qmNameChars.withUnsafeMutableBufferPointer { qmBuffer in
-            withUnsafeMutablePointer(to: &connectOptions) { cnoPtr in
-                MQCONNX(
-                    qmBuffer.baseAddress,
-                    cnoPtr,
-                    &connectionHandle,
-                    &compCode,
-                    &reason
-                )
-            }
-        }
-
-        // Check result
-        guard compCode != MQCC_FAILED else {
-            connectionHandle = MQHC_UNUSABLE_HCONN
-            throw MQError.connectionFailed(
-                reasonCode: reason,
-                queueManager: queueManager
-            )
-        }
+        // MQCONNX runs on each new connection's own thread, so a slow channel
+        // never blocks the main actor
+        let pool = try await MQConnectionPool.open(
+            endpoint: MQConnectionPool.Endpoint(
+                queueManager: queueManager,
+                channel: channel,
+                host: host,
+                port: port,
+                username: username
+            ),
+            password: password,
+            configuration: poolConfiguration
+        )
 
-        // Store connected queue manager name
+        // A concurrent connect may have finished while this one was waiting
+        self.pool?.close()
+        self.pool = pool
         connectedQueueManager = queueManager
     }
 
     /// Disconnect from the current queue manager
-    /// Safe to call even if not connected
+    /// Safe to call even if not connected. Returns without waiting for MQDISC,
+    /// which runs after the MQI calls already queued on each connection
     public func disconnect() {
-        disconnectSync()
-    }
-
-    /// Synchronous disconnect implementation
-    /// Used by both public disconnect() and deinit
-    private func disconnectSync() {
-        guard connectionHandle != MQHC_UNUSABLE_HCONN else {
+        guard let pool else {
             // Already disconnected, nothing to do
             return
         }
 
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
-
-        // Call MQDISC to disconnect from the queue manager
-        MQDISC(&connectionHandle, &compCode, &reason)
-
-        // Reset handle regardless of result to ensure we don't try to reuse it
-        connectionHandle = MQHC_UNUSABLE_HCONN
+        self.pool = nil
         connectedQueueManager = nil
 
-        // Note: We don't throw on disconnect failure - just log if needed
-        // This ensures cleanup always completes
-        if compCode == MQCC_FAILED {
-            // In production, consider logging this error
-            // For now, we silently handle it to ensure cleanup
-        }
+        // Closes the browse cursors and the PCF session's queues, then calls MQDISC
+        pool.close()
     }
 
     // MARK: - Internal Accessors
 
-    /// Get the current connection handle (for use by other MQ operations)
-    /// - Returns: The connection handle or throws if not connected
-    internal func getConnectionHandle() throws -> MQHCONN {
-        guard connectionHandle != MQHC_UNUSABLE_HCONN else {
+    /// Get the connection pool of the current queue manager
+    /// - Returns: The pool to take connections from
+    /// - Throws: MQError.notConnected if not connected
+    internal func getConnectionPool() throws -> MQConnectionPool {
+        guard let pool else {
+            throw MQError.notConnected
+        }
+        return pool
+    }
+
+    /// Get a connection for synchronous callers (for use by other MQ operations)
+    /// - Returns: The connection, whose MQI calls must go through perform(_:)
+    /// - Throws: MQError.notConnected if not connected
+    internal func getConnection() throws -> MQConnection {
+        guard let connection = try getConnectionPool().primaryConnection else {
             throw MQError.notConnected
         }
-        return connectionHandle
+        return connection
+    }
+
+    /// Run an operation on a connection leased for its duration
+    /// - Parameters:
+    ///   - pool: Pool to lease the connection from
+    ///   - body: Operation to run on the connection thread
+    /// - Returns: The result of body
+    /// - Throws: MQError if no connection is available or the operation fails
+    private func withLeasedConnection<T>(
+        from pool: MQConnectionPool,
+        _ body: @escaping (MQConnection) throws -> T
+    ) async throws -> T {
+        return try await pool.withLease { connection in
+            try await connection.perform(body)
+        }
+    }
+
+    /// Run an operation on the connection pinned to a role
+    /// - Parameters:
+    ///   - role: Role whose connection keeps the operation's state
+    ///   - pool: Pool the role's connection comes from
+    ///   - body: Operation to run on the connection thread
+    /// - Returns: The result of body
+    /// - Throws: MQError if no connection is available or the operation fails
+    private func withPinnedConnection<T>(
+        for role: MQConnectionPool.Role,
+        from pool: MQConnectionPool,
+        _ body: @escaping (MQConnection) throws -> T
+    ) async throws -> T {
+        return try await pool.withConnection(for: role) { connection in
+            try await connection.perform(body)
+        }
     }
 
     // MARK: - Queue Operations
@@ -330,84 +629,18 @@ public final class MQService: MQServiceProtocol {
         }
     }
 
-    /// Open a queue for the specified operations
-    /// - Parameters:
-    ///   - queueName: Name of the queue to open
-    ///   - options: MQOO_* options for opening the queue
-    /// - Returns: Object handle for the opened queue
-    /// - Throws: MQError if the queue cannot be opened
-    private func openQueue(queueName: String, options: MQLONG) throws -> MQHOBJ {
-        guard isConnected else {
-            throw MQError.notConnected
-        }
-
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
-        var objectHandle: MQHOBJ = MQHO_UNUSABLE_HOBJ
-
-        // Initialize Object Descriptor (MQOD)
-        var objectDescriptor = MQOD()
-        objectDescriptor.Version = MQOD_VERSION_4
-
-        // Set object type to queue
-        objectDescriptor.ObjectType = MQOT_Q
-
-        // Set queue name (max 48 characters, space-padded)
-        let queueNameChars = queueName.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-        withUnsafeMutablePointer(to: &objectDescriptor.ObjectName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                bound[i] = queueNameChars[i]
-            }
-        }
-
-        // Call MQOPEN
-        MQOPEN(
-            connectionHandle,
-            &objectDescriptor,
-            options,
-            &objectHandle,
-            &compCode,
-            &reason
-        )
-
-        guard compCode != MQCC_FAILED else {
-            throw MQError.operationFailed(
-                operation: "MQOPEN(\(queueName))",
-                completionCode: compCode,
-                reasonCode: reason
-            )
-        }
-
-        return objectHandle
-    }
-
-    /// Close an open queue
-    /// - Parameter objectHandle: Handle returned from openQueue
-    private func closeQueue(_ objectHandle: inout MQHOBJ) {
-        guard objectHandle != MQHO_UNUSABLE_HOBJ else { return }
-
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
-
-        MQCLOSE(
-            connectionHandle,
-            &objectHandle,
-            MQCO_NONE,
-            &compCode,
-            &reason
-        )
-
-        objectHandle = MQHO_UNUSABLE_HOBJ
-    }
-
-    /// Inquire queue attributes using MQINQ
+    /// Inquire queue attributes using MQINQ (runs on the connection thread)
     /// - Parameters:
+    ///   - connection: Connection the queue was opened on
     ///   - objectHandle: Handle to an open queue
     ///   - queueName: Name of the queue (for constructing QueueInfo)
     /// - Returns: QueueInfo with the queue's attributes
     /// - Throws: MQError if inquiry fails
-    private func inquireQueueAttributes(objectHandle: MQHOBJ, queueName: String) throws -> QueueInfo {
+    nonisolated private func inquireQueueAttributes(
+        on connection: MQConnection,
+        objectHandle: MQHOBJ,
+        queueName: String
+    ) throws -> QueueInfo {
         var compCode: MQLONG = MQCC_OK
         var reason: MQLONG = MQRC_NONE
 
@@ -429,8 +662,9 @@ public final class MQService: MQServiceProtocol {
         let charAttrLength: MQLONG = 0
         var charAttrs = [MQCHAR]()
 
+        let call = MQInstrumentation.shared.begin(.inquire)
         MQINQ(
-            connectionHandle,
+            connection.handle,
             objectHandle,
             MQLONG(selectors.count),
             &selectors,
@@ -441,6 +675,7 @@ public final class MQService: MQServiceProtocol {
             &compCode,
             &reason
         )
+        MQInstrumentation.shared.end(call, .inquire, connection: connection.handle, queue: queueName, compCode: compCode, reason: reason)
 
         guard compCode != MQCC_FAILED else {
             throw MQError.operationFailed(
@@ -472,388 +707,345 @@ public final class MQService: MQServiceProtocol {
     }
 
     /// Get information about a specific queue
+    /// The MQINQ runs on the admin connection's thread while the caller is suspended
     /// - Parameter queueName: Name of the queue to inquire
     /// - Returns: QueueInfo with the queue's attributes
     /// - Throws: MQError if the queue cannot be accessed
-    public func getQueueInfo(queueName: String) throws -> QueueInfo {
-        guard isConnected else {
-            throw MQError.notConnected
-        }
-
-        // Open queue for inquiry
-        var objectHandle = try openQueue(
-            queueName: queueName,
-            options: MQOO_INQUIRE | MQOO_FAIL_IF_QUIESCING
-        )
-
-        defer {
-            closeQueue(&objectHandle)
+    public func getQueueInfo(queueName: String) async throws -> QueueInfo {
+        return try await withPinnedConnection(for: .admin, from: getConnectionPool()) { connection in
+            // Inquire attributes on a cached inquiry handle
+            try connection.withQueue(queueName: queueName, options: MQOO_INQUIRE | MQOO_FAIL_IF_QUIESCING) { objectHandle in
+                try self.inquireQueueAttributes(on: connection, objectHandle: objectHandle, queueName: queueName)
+            }
         }
-
-        // Inquire attributes
-        return try inquireQueueAttributes(objectHandle: objectHandle, queueName: queueName)
     }
 
     /// List all queues in the connected queue manager
-    /// Uses PCF (Programmable Command Format) to discover queue names
+    /// Uses a single PCF (Programmable Command Format) MQCMD_INQUIRE_Q request that
+    /// returns every matching queue together with its attributes, so listing N queues
+    /// costs one round trip instead of N MQOPEN/MQINQ/MQCLOSE sequences
     /// - Parameter filter: Optional filter pattern (e.g., "DEV.*" or "*"). Defaults to "*"
     /// - Returns: Array of QueueInfo for all discovered queues
     /// - Throws: MQError if listing fails
     public func listQueues(filter: String = "*") async throws -> [QueueInfo] {
-        guard isConnected else {
-            throw MQError.notConnected
+        // Build and send PCF inquiry command; attributes are decoded from the response
+        let queues = try await withPinnedConnection(for: .admin, from: getConnectionPool()) { connection in
+            try self.sendPCFInquireQueue(on: connection, filter: filter)
         }
 
-        // Build and send PCF inquiry command to discover queue names
-        let queueNames = try sendPCFInquireQueue(filter: filter)
+        return queues.sorted { $0.name < $1.name }
+    }
+
+    /// Queue attributes requested through MQIACF_Q_ATTRS in MQCMD_INQUIRE_Q
+    /// These mirror the selectors used by inquireQueueAttributes so both paths
+    /// produce identical QueueInfo values
+    nonisolated private static let pcfQueueAttributeSelectors: [MQLONG] = [
+        MQCA_Q_NAME,
+        MQIA_Q_TYPE,
+        MQIA_CURRENT_Q_DEPTH,
+        MQIA_MAX_Q_DEPTH,
+        MQIA_OPEN_INPUT_COUNT,
+        MQIA_OPEN_OUTPUT_COUNT,
+        MQIA_INHIBIT_GET,
+        MQIA_INHIBIT_PUT
+    ]
+
+    /// Send a PCF MQCMD_INQUIRE_Q command to discover queues and their attributes
+    /// - Parameters:
+    ///   - connection: Connection whose PCF session sends the command
+    ///   - filter: Filter pattern for queue names
+    /// - Returns: Array of QueueInfo decoded from the PCF responses
+    /// - Throws: MQError if the PCF command fails
+    nonisolated private func sendPCFInquireQueue(on connection: MQConnection, filter: String) throws -> [QueueInfo] {
+        let command = buildPCFInquireQueueCommand(filter: filter)
 
-        // Get detailed info for each discovered queue
+        // Send the PCF command and decode every response message in place
         var queues: [QueueInfo] = []
-        for name in queueNames {
-            do {
-                let info = try getQueueInfo(queueName: name)
-                queues.append(info)
-            } catch {
-                // Skip queues we can't access (e.g., authorization issues)
-                // but continue with others
-                continue
+        try executePCFCommand(command, on: connection, waitInterval: 5000) { response in // 5 second timeout
+            if let queue = try parsePCFQueueResponse(response) {
+                queues.append(queue)
             }
         }
+        return queues
+    }
 
-        return queues.sorted { $0.name < $1.name }
+    /// Build a PCF MQCMD_INQUIRE_Q command
+    /// Requests the queue name filter, all queue types, and the attribute list in
+    /// pcfQueueAttributeSelectors so the response carries everything QueueInfo needs
+    nonisolated private func buildPCFInquireQueueCommand(filter: String) -> PCFCommand {
+        var command = PCFCommand(command: MQCMD_INQUIRE_Q)
+
+        // Add MQCA_Q_NAME parameter (string parameter for queue name filter)
+        command.appendString(parameter: MQCA_Q_NAME, value: filter, length: Int(MQ_Q_NAME_LENGTH))
+
+        // Add MQIA_Q_TYPE parameter (integer parameter requesting all queue types)
+        command.appendInteger(parameter: MQIA_Q_TYPE, value: MQQT_ALL)
+
+        // Add MQIACF_Q_ATTRS parameter (integer list of the attributes to return)
+        command.appendIntegerList(parameter: MQIACF_Q_ATTRS, values: Self.pcfQueueAttributeSelectors)
+
+        return command
     }
 
-    /// Send a PCF MQCMD_INQUIRE_Q command to discover queue names
-    /// - Parameter filter: Filter pattern for queue names
-    /// - Returns: Array of queue names matching the filter
-    /// - Throws: MQError if the PCF command fails
-    private func sendPCFInquireQueue(filter: String) throws -> [String] {
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
+    // MARK: - Queue Status
 
-        // Open the command queue for sending PCF commands
-        var adminObjectHandle = try openQueue(
-            queueName: "SYSTEM.ADMIN.COMMAND.QUEUE",
-            options: MQOO_OUTPUT | MQOO_FAIL_IF_QUIESCING
-        )
+    /// Depth and open counts of one local queue, as reported by MQCMD_INQUIRE_Q_STATUS
+    public struct QueueDepthStatus: Equatable, Sendable {
+        public let name: String
+        public let currentDepth: Int32
+        public let openInputCount: Int32
+        public let openOutputCount: Int32
 
-        defer {
-            closeQueue(&adminObjectHandle)
+        public init(name: String, currentDepth: Int32, openInputCount: Int32, openOutputCount: Int32) {
+            self.name = name
+            self.currentDepth = currentDepth
+            self.openInputCount = openInputCount
+            self.openOutputCount = openOutputCount
         }
+    }
 
-        // Generate a unique reply queue name
-        let replyQueueModel = "SYSTEM.DEFAULT.MODEL.QUEUE"
-        let replyQueuePrefix = "MQMATE.REPLY.*"
+    /// Read only the depth and open counts of the local queues matching a filter
+    /// Uses one PCF MQCMD_INQUIRE_Q_STATUS request asking for three attributes,
+    /// so it is far cheaper than listQueues and suited to polling
+    /// - Parameter filter: Filter pattern for queue names (e.g., "DEV.*" or "*")
+    /// - Returns: The status of every matching local queue
+    /// - Throws: MQError if the inquiry fails
+    public func inquireQueueDepths(filter: String = "*") async throws -> [QueueDepthStatus] {
+        return try await withPinnedConnection(for: .admin, from: getConnectionPool()) { connection in
+            try self.sendPCFInquireQueueStatus(on: connection, filter: filter)
+        }
+    }
 
-        // Open a dynamic reply queue
-        var replyObjectDescriptor = MQOD()
-        replyObjectDescriptor.Version = MQOD_VERSION_4
-        replyObjectDescriptor.ObjectType = MQOT_Q
+    /// Queue status attributes requested through MQIACF_Q_STATUS_ATTRS
+    nonisolated private static let pcfQueueStatusSelectors: [MQLONG] = [
+        MQCA_Q_NAME,
+        MQIA_CURRENT_Q_DEPTH,
+        MQIA_OPEN_INPUT_COUNT,
+        MQIA_OPEN_OUTPUT_COUNT
+    ]
 
-        // Set model queue name
-        let modelQueueChars = replyQueueModel.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-        withUnsafeMutablePointer(to: &replyObjectDescriptor.ObjectName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                bound[i] = modelQueueChars[i]
+    /// Send a PCF MQCMD_INQUIRE_Q_STATUS command for the queue status of every matching queue
+    /// - Parameters:
+    ///   - connection: Connection whose PCF session sends the command
+    ///   - filter: Filter pattern for queue names
+    /// - Returns: The status decoded from every response message
+    /// - Throws: MQError if the PCF command fails
+    nonisolated private func sendPCFInquireQueueStatus(on connection: MQConnection, filter: String) throws -> [QueueDepthStatus] {
+        var command = PCFCommand(command: MQCMD_INQUIRE_Q_STATUS)
+        command.appendString(parameter: MQCA_Q_NAME, value: filter, length: Int(MQ_Q_NAME_LENGTH))
+        command.appendInteger(parameter: MQIACF_Q_STATUS_TYPE, value: MQIACF_Q_STATUS)
+        command.appendIntegerList(parameter: MQIACF_Q_STATUS_ATTRS, values: Self.pcfQueueStatusSelectors)
+
+        var statuses: [QueueDepthStatus] = []
+        try executePCFCommand(command, on: connection, waitInterval: 5000) { response in // 5 second timeout
+            if let status = try parsePCFQueueStatusResponse(response) {
+                statuses.append(status)
             }
         }
+        return statuses
+    }
 
-        // Set dynamic queue name prefix
-        let dynamicQueueChars = replyQueuePrefix.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-        withUnsafeMutablePointer(to: &replyObjectDescriptor.DynamicQName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                bound[i] = dynamicQueueChars[i]
+    /// Parse a PCF MQCMD_INQUIRE_Q_STATUS response message
+    /// - Parameter response: One PCF response message, decoded in place
+    /// - Returns: The decoded status, or nil if the message carries no queue
+    /// - Throws: MQError if the command server reported a failure
+    nonisolated private func parsePCFQueueStatusResponse(_ response: PCFResponse) throws -> QueueDepthStatus? {
+        if response.compCode == MQCC_FAILED {
+            // No local queue matched the filter - an empty result, not an error
+            if response.reason == MQRC_UNKNOWN_OBJECT_NAME {
+                return nil
             }
-        }
-
-        var replyObjectHandle: MQHOBJ = MQHO_UNUSABLE_HOBJ
-        MQOPEN(
-            connectionHandle,
-            &replyObjectDescriptor,
-            MQOO_INPUT_EXCLUSIVE | MQOO_FAIL_IF_QUIESCING,
-            &replyObjectHandle,
-            &compCode,
-            &reason
-        )
-
-        guard compCode != MQCC_FAILED else {
             throw MQError.operationFailed(
-                operation: "MQOPEN(reply queue)",
-                completionCode: compCode,
-                reasonCode: reason
+                operation: "PCF INQUIRE_Q_STATUS",
+                completionCode: response.compCode,
+                reasonCode: response.reason
             )
         }
 
-        defer {
-            var handle = replyObjectHandle
-            closeQueue(&handle)
-        }
-
-        // Extract the actual dynamic queue name
-        var replyQueueName = [MQCHAR](repeating: 0x20, count: Int(MQ_Q_NAME_LENGTH))
-        withUnsafePointer(to: &replyObjectDescriptor.ObjectName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                replyQueueName[i] = bound[i]
+        var name: String?
+        var currentDepth: MQLONG = 0
+        var openInputCount: MQLONG = 0
+        var openOutputCount: MQLONG = 0
+
+        for parameter in response.parameters {
+            switch parameter {
+            case .string(MQCA_Q_NAME, let value):
+                name = value.string
+            case .integer(MQIA_CURRENT_Q_DEPTH, let value):
+                currentDepth = value
+            case .integer(MQIA_OPEN_INPUT_COUNT, let value):
+                openInputCount = value
+            case .integer(MQIA_OPEN_OUTPUT_COUNT, let value):
+                openOutputCount = value
+            default:
+                continue
             }
         }
 
-        // Build PCF message for MQCMD_INQUIRE_Q
-        let pcfMessage = try buildPCFInquireQueueMessage(
-            filter: filter,
-            replyQueueName: replyQueueName
-        )
+        guard let name, !name.isEmpty else {
+            return nil
+        }
 
-        // Send the PCF command
-        try sendPCFMessage(
-            objectHandle: adminObjectHandle,
-            message: pcfMessage,
-            replyQueueName: replyQueueName
+        return QueueDepthStatus(
+            name: name,
+            currentDepth: currentDepth,
+            openInputCount: openInputCount,
+            openOutputCount: openOutputCount
         )
-
-        // Receive and parse the response(s)
-        return try receivePCFResponse(replyObjectHandle: replyObjectHandle)
     }
 
-    /// Build a PCF MQCMD_INQUIRE_Q message
-    private func buildPCFInquireQueueMessage(
-        filter: String,
-        replyQueueName: [MQCHAR]
-    ) throws -> Data {
-        // PCF Header structure
-        var pcfHeader = MQCFH()
-        pcfHeader.Type = MQCFT_COMMAND
-        pcfHeader.StrucLength = MQCFH_STRUC_LENGTH
-        pcfHeader.Version = MQCFH_VERSION_1
-        pcfHeader.Command = MQCMD_INQUIRE_Q
-        pcfHeader.MsgSeqNumber = 1
-        pcfHeader.Control = MQCFC_LAST
-        pcfHeader.ParameterCount = 2 // Queue name filter + queue type
-
-        var message = Data()
-
-        // Append header
-        withUnsafeBytes(of: &pcfHeader) { buffer in
-            message.append(contentsOf: buffer)
-        }
-
-        // Add MQCACF_Q_NAME parameter (string parameter for queue name filter)
-        var qNameParam = MQCFST()
-        qNameParam.Type = MQCFT_STRING
-        qNameParam.StrucLength = MQCFST_STRUC_LENGTH_FIXED + Int32(MQ_Q_NAME_LENGTH)
-        qNameParam.Parameter = MQCA_Q_NAME
-        qNameParam.CodedCharSetId = MQCCSI_DEFAULT
-        qNameParam.StringLength = Int32(MQ_Q_NAME_LENGTH)
+    // MARK: - PCF Command Execution
 
-        withUnsafeBytes(of: &qNameParam) { buffer in
-            // Only append up to the String field (before the actual string data)
-            message.append(contentsOf: buffer.prefix(MemoryLayout<MQCFST>.size - MemoryLayout<MQCHAR>.size))
+    /// Execute a PCF command on the connection's session
+    /// Drops the session when the failure means its handles are no longer usable
+    /// - Parameters:
+    ///   - command: The command to execute
+    ///   - connection: Connection whose session runs the command
+    ///   - waitInterval: Maximum wait for each response message in milliseconds
+    ///   - body: Called once per response with a view valid only during the call
+    /// - Throws: MQError if the command fails
+    nonisolated private func executePCFCommand(
+        _ command: PCFCommand,
+        on connection: MQConnection,
+        waitInterval: MQLONG,
+        _ body: (PCFResponse) throws -> Void
+    ) throws {
+        let session = try connection.commandSession()
+        do {
+            try session.execute(command, waitInterval: waitInterval, body)
+        } catch {
+            invalidateCommandSessionIfNeeded(on: connection, after: error)
+            throw error
         }
+    }
 
-        // Append the filter string (space-padded to 48 chars)
-        let filterChars = filter.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-        message.append(contentsOf: filterChars.map { UInt8(bitPattern: $0) })
-
-        // Add MQIA_Q_TYPE parameter (integer parameter requesting all queue types)
-        var qTypeParam = MQCFIN()
-        qTypeParam.Type = MQCFT_INTEGER
-        qTypeParam.StrucLength = MQCFIN_STRUC_LENGTH
-        qTypeParam.Parameter = MQIA_Q_TYPE
-        qTypeParam.Value = MQQT_ALL
-
-        withUnsafeBytes(of: &qTypeParam) { buffer in
-            message.append(contentsOf: buffer)
+    /// Close the PCF session if an error indicates its handles are broken
+    /// - Parameters:
+    ///   - connection: Connection owning the session
+    ///   - error: Error raised by a session operation
+    nonisolated private func invalidateCommandSessionIfNeeded(on connection: MQConnection, after error: Error) {
+        if let error = error as? MQError, error.invalidatesObjectHandle {
+            connection.closeCommandSession()
         }
-
-        return message
     }
 
-    /// Send a PCF message to the admin queue
-    private func sendPCFMessage(
-        objectHandle: MQHOBJ,
-        message: Data,
-        replyQueueName: [MQCHAR]
-    ) throws {
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
-
-        // Message descriptor
-        var messageDescriptor = MQMD()
-        messageDescriptor.Version = MQMD_VERSION_2
-        messageDescriptor.Format = (
-            MQCHAR(0x4D), MQCHAR(0x51), MQCHAR(0x48), MQCHAR(0x52),
-            MQCHAR(0x46), MQCHAR(0x32), MQCHAR(0x20), MQCHAR(0x20)
-        )  // "MQHRF2  "
-        messageDescriptor.MsgType = MQMT_REQUEST
-        messageDescriptor.Expiry = 300 * 10 // 5 minutes in tenths of a second
-
-        // Set reply-to queue name
-        withUnsafeMutablePointer(to: &messageDescriptor.ReplyToQ) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                bound[i] = replyQueueName[i]
+    /// Parse a PCF MQCMD_INQUIRE_Q response message into a QueueInfo
+    /// Integer attributes the queue type does not define (e.g. depth for an alias
+    /// queue) are absent from the response and keep their QueueInfo defaults.
+    /// Internal rather than private so the benchmarks can decode responses directly
+    /// - Parameter response: One PCF response message, decoded in place
+    /// - Returns: The decoded queue, or nil if the message carries no queue
+    /// - Throws: MQError if the command server reported a failure
+    nonisolated func parsePCFQueueResponse(_ response: PCFResponse) throws -> QueueInfo? {
+        if response.compCode == MQCC_FAILED {
+            // No queue matched the filter - an empty result, not an error
+            if response.reason == MQRC_UNKNOWN_OBJECT_NAME {
+                return nil
             }
-        }
-
-        // Put message options
-        var putOptions = MQPMO()
-        putOptions.Version = MQPMO_VERSION_2
-        putOptions.Options = MQPMO_NO_SYNCPOINT | MQPMO_NEW_MSG_ID | MQPMO_NEW_CORREL_ID
-
-        // Put the message
-        var messageData = [UInt8](message)
-        var messageLength = MQLONG(messageData.count)
-
-        MQPUT(
-            connectionHandle,
-            objectHandle,
-            &messageDescriptor,
-            &putOptions,
-            messageLength,
-            &messageData,
-            &compCode,
-            &reason
-        )
-
-        guard compCode != MQCC_FAILED else {
             throw MQError.operationFailed(
-                operation: "MQPUT(PCF command)",
-                completionCode: compCode,
-                reasonCode: reason
+                operation: "PCF INQUIRE_Q",
+                completionCode: response.compCode,
+                reasonCode: response.reason
             )
         }
-    }
-
-    /// Receive and parse PCF response messages
-    private func receivePCFResponse(replyObjectHandle: MQHOBJ) throws -> [String] {
-        var queueNames: [String] = []
-        var hasMoreMessages = true
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
-
-        while hasMoreMessages {
-            // Message descriptor
-            var messageDescriptor = MQMD()
-            messageDescriptor.Version = MQMD_VERSION_2
-
-            // Get message options
-            var getOptions = MQGMO()
-            getOptions.Version = MQGMO_VERSION_2
-            getOptions.Options = MQGMO_NO_SYNCPOINT | MQGMO_WAIT | MQGMO_CONVERT
-            getOptions.WaitInterval = 5000 // 5 second timeout
-            getOptions.MatchOptions = MQMO_NONE
-
-            // Buffer for response
-            var buffer = [UInt8](repeating: 0, count: 65536)
-            var dataLength: MQLONG = 0
-
-            MQGET(
-                connectionHandle,
-                replyObjectHandle,
-                &messageDescriptor,
-                &getOptions,
-                MQLONG(buffer.count),
-                &buffer,
-                &dataLength,
-                &compCode,
-                &reason
-            )
-
-            if reason == MQRC_NO_MSG_AVAILABLE {
-                hasMoreMessages = false
-                break
-            }
 
-            guard compCode != MQCC_FAILED else {
-                if reason == MQRC_NO_MSG_AVAILABLE {
-                    break
-                }
-                throw MQError.operationFailed(
-                    operation: "MQGET(PCF response)",
-                    completionCode: compCode,
-                    reasonCode: reason
-                )
+        var name: String?
+        var queueType = MQQueueType.unknown
+        var currentDepth: MQLONG = 0
+        var maxDepth: MQLONG = 0
+        var openInputCount: MQLONG = 0
+        var openOutputCount: MQLONG = 0
+        var inhibitGet = false
+        var inhibitPut = false
+
+        for parameter in response.parameters {
+            switch parameter {
+            case .string(MQCA_Q_NAME, let value):
+                name = value.string
+            case .integer(MQIA_Q_TYPE, let value):
+                queueType = MQQueueType(rawValue: value)
+            case .integer(MQIA_CURRENT_Q_DEPTH, let value):
+                currentDepth = value
+            case .integer(MQIA_MAX_Q_DEPTH, let value):
+                maxDepth = value
+            case .integer(MQIA_OPEN_INPUT_COUNT, let value):
+                openInputCount = value
+            case .integer(MQIA_OPEN_OUTPUT_COUNT, let value):
+                openOutputCount = value
+            case .integer(MQIA_INHIBIT_GET, let value):
+                inhibitGet = value == MQQA_GET_INHIBITED
+            case .integer(MQIA_INHIBIT_PUT, let value):
+                inhibitPut = value == MQQA_PUT_INHIBITED
+            default:
+                continue
             }
+        }
 
-            // Parse the PCF response to extract queue names
-            let responseData = Data(buffer.prefix(Int(dataLength)))
-            let names = parsePCFQueueResponse(data: responseData)
-            queueNames.append(contentsOf: names)
-
-            // Check if this is the last message in the response
-            if responseData.count >= MemoryLayout<MQCFH>.size {
-                let control: Int32 = responseData.withUnsafeBytes { ptr in
-                    // Control field is at offset 20 in MQCFH
-                    ptr.load(fromByteOffset: 20, as: Int32.self)
-                }
-                if control == MQCFC_LAST {
-                    hasMoreMessages = false
-                }
-            }
+        guard let name, !name.isEmpty else {
+            return nil
         }
 
-        return queueNames
+        return QueueInfo(
+            name: name,
+            queueType: queueType,
+            currentDepth: currentDepth,
+            maxDepth: maxDepth,
+            openInputCount: openInputCount,
+            openOutputCount: openOutputCount,
+            inhibitGet: inhibitGet,
+            inhibitPut: inhibitPut
+        )
     }
 
-    /// Parse a PCF response message to extract queue names
-    private func parsePCFQueueResponse(data: Data) -> [String] {
-        var names: [String] = []
-        var offset = 0
-
-        guard data.count >= MemoryLayout<MQCFH>.size else {
-            return names
-        }
-
-        // Read PCF header
-        let headerSize = Int(MemoryLayout<MQCFH>.size)
-        offset = headerSize
+    // MARK: - Message Browsing Operations
 
-        // Parse parameters
-        while offset + 12 < data.count {
-            let paramType: Int32 = data.withUnsafeBytes { ptr in
-                ptr.load(fromByteOffset: offset, as: Int32.self)
+    /// Criteria the queue manager applies when browsing, so only matching messages are transferred
+    /// IDs are matched by MQGET with MQMO_MATCH_MSG_ID/MQMO_MATCH_CORREL_ID; the
+    /// selection string is a message selector set in MQOD.SelectionString at MQOPEN
+    public struct MessageSelector: Equatable, Sendable {
+        /// MsgId to match, padded with zeros to 24 bytes
+        public var messageId: [UInt8]?
+        /// CorrelId to match, padded with zeros to 24 bytes
+        public var correlationId: [UInt8]?
+        /// Message selector, e.g. "Root.MQMD.Priority > 5"
+        public var selectionString: String?
+
+        public init(messageId: [UInt8]? = nil, correlationId: [UInt8]? = nil, selectionString: String? = nil) {
+            self.messageId = messageId.map(Self.padded)
+            self.correlationId = correlationId.map(Self.padded)
+            self.selectionString = selectionString.flatMap { $0.isEmpty ? nil : $0 }
+        }
+
+        /// Whether every message matches
+        public var isEmpty: Bool {
+            messageId == nil && correlationId == nil && selectionString == nil
+        }
+
+        /// MQMO_* options for the IDs to match
+        var matchOptions: MQLONG {
+            var options = MQMO_NONE
+            if messageId != nil {
+                options |= MQMO_MATCH_MSG_ID
             }
-            let strucLength: Int32 = data.withUnsafeBytes { ptr in
-                ptr.load(fromByteOffset: offset + 4, as: Int32.self)
+            if correlationId != nil {
+                options |= MQMO_MATCH_CORREL_ID
             }
-            let parameter: Int32 = data.withUnsafeBytes { ptr in
-                ptr.load(fromByteOffset: offset + 8, as: Int32.self)
-            }
-
-            if paramType == MQCFT_STRING && parameter == MQCA_Q_NAME {
-                // String parameter - extract queue name
-                let stringLength: Int32 = data.withUnsafeBytes { ptr in
-                    ptr.load(fromByteOffset: offset + 16, as: Int32.self)
-                }
-                let stringOffset = offset + 20
-                let stringEnd = min(stringOffset + Int(stringLength), data.count)
-
-                if stringOffset < stringEnd {
-                    let stringData = data[stringOffset..<stringEnd]
-                    if let name = String(data: stringData, encoding: .utf8)?
-                        .trimmingCharacters(in: .whitespaces) {
-                        if !name.isEmpty {
-                            names.append(name)
-                        }
-                    }
-                }
-            }
-
-            offset += Int(strucLength)
+            return options
+        }
 
-            // Safety check to prevent infinite loop
-            if strucLength <= 0 {
-                break
-            }
+        /// Whether a message matches the IDs; selection strings can only be evaluated by the queue manager
+        public func matchesIds(of message: MQMessage) -> Bool {
+            return (messageId == nil || messageId == message.messageId)
+                && (correlationId == nil || correlationId == message.correlationId)
         }
 
-        return names
+        /// Pad or cut an ID to the 24 bytes of MsgId and CorrelId
+        private static func padded(_ id: [UInt8]) -> [UInt8] {
+            let length = Int(MQ_MSG_ID_LENGTH)
+            return Array(id.prefix(length)) + [UInt8](repeating: 0, count: max(length - id.count, 0))
+        }
     }
 
-    // MARK: - Message Browsing Operations
-
     /// Message information returned from MQGET browse operations
     public struct MQMessage: Identifiable, Sendable {
         /// Unique identifier for the message (hex-encoded message ID)
@@ -864,10 +1056,14 @@ public final class MQService: MQServiceProtocol {
         public let correlationId: [UInt8]
         /// Message format (e.g., "MQSTR", "MQHRF2")
         public let format: String
-        /// Message payload as raw data
+        /// Message payload as raw data (only the first bytes for a preview browse)
         public let payload: Data
-        /// Message payload as string (if decodable as UTF-8)
-        public let payloadString: String?
+        /// Full length of the message data on the queue
+        public let totalLength: Int
+        /// CodedCharSetId of the payload
+        public let codedCharSetId: Int32
+        /// Encoding of the payload
+        public let encoding: Int32
         /// Put timestamp (when message was put to queue)
         public let putDateTime: Date?
         /// Put application name
@@ -886,12 +1082,16 @@ public final class MQService: MQServiceProtocol {
         public let messageSequenceNumber: Int32
         /// Message position (index in browse cursor, 0-based)
         public let position: Int
+        /// MsgToken assigned by the queue manager (16 bytes, empty if unknown)
+        /// Identifies this physical message for a later browse seek
+        public let messageToken: [UInt8]
 
         public init(
             messageId: [UInt8],
             correlationId: [UInt8],
             format: String,
             payload: Data,
+            totalLength: Int? = nil,
             putDateTime: Date?,
             putApplicationName: String,
             messageType: MQMessageType,
@@ -900,14 +1100,19 @@ public final class MQService: MQServiceProtocol {
             replyToQueue: String,
             replyToQueueManager: String,
             messageSequenceNumber: Int32,
-            position: Int
+            position: Int,
+            messageToken: [UInt8] = [],
+            codedCharSetId: Int32 = CharacterSetConverter.utf8CCSID,
+            encoding: Int32 = CharacterSetConverter.nativeEncoding
         ) {
             self.messageId = messageId
             self.correlationId = correlationId
             self.id = messageId.map { String(format: "%02X", $0) }.joined()
             self.format = format
             self.payload = payload
-            self.payloadString = String(data: payload, encoding: .utf8)
+            self.totalLength = max(totalLength ?? payload.count, payload.count)
+            self.codedCharSetId = codedCharSetId
+            self.encoding = encoding
             self.putDateTime = putDateTime
             self.putApplicationName = putApplicationName
             self.messageType = messageType
@@ -917,6 +1122,21 @@ public final class MQService: MQServiceProtocol {
             self.replyToQueueManager = replyToQueueManager
             self.messageSequenceNumber = messageSequenceNumber
             self.position = position
+            self.messageToken = messageToken
+        }
+
+        /// Whether only part of the payload was transferred
+        public var isTruncated: Bool {
+            totalLength > payload.count
+        }
+
+        /// Payload as a string, decoded by its CCSID (nil if not decodable)
+        /// Converted on each access, so messages that are never shown are never converted
+        public var payloadString: String? {
+            guard let converter = CharacterSetConverter.converter(ccsid: codedCharSetId, encoding: encoding) else {
+                return String(data: payload, encoding: .utf8)
+            }
+            return converter.decode(payload)
         }
 
         /// Correlation ID as hex string
@@ -993,280 +1213,333 @@ public final class MQService: MQServiceProtocol {
         }
     }
 
-    /// Browse messages in a queue without removing them
-    /// Uses MQGET with MQGMO_BROWSE_FIRST and MQGMO_BROWSE_NEXT options
+    /// Browse the first page of messages in a queue without removing them
+    /// Rewinds the queue's browse cursor to MQGMO_BROWSE_FIRST; the cursor stays
+    /// open afterwards so browseNextMessages continues where this page ends.
+    /// With browsePreviewLength set, payloads are truncated to the preview
+    /// (MQMessage.isTruncated) and totalLength reports the real size
     /// - Parameters:
     ///   - queueName: Name of the queue to browse
     ///   - maxMessages: Maximum number of messages to retrieve (default: 100)
-    ///   - maxMessageSize: Maximum size per message in bytes (default: 4MB)
     /// - Returns: Array of MQMessage objects
     /// - Throws: MQError if browsing fails
     public func browseMessages(
         queueName: String,
-        maxMessages: Int = 100,
-        maxMessageSize: Int = 4 * 1024 * 1024
+        maxMessages: Int = 100
     ) async throws -> [MQMessage] {
-        guard isConnected else {
-            throw MQError.notConnected
+        return try await withBrowseCursor(queueName: queueName, in: \.browseCursors, maxMessageSize: pagingMessageSize) { cursor in
+            cursor.rewind()
+            return try cursor.nextPage(maxMessages: maxMessages)
         }
+    }
 
-        // Open queue for browsing
-        var objectHandle = try openQueue(
-            queueName: queueName,
-            options: MQOO_BROWSE | MQOO_FAIL_IF_QUIESCING
-        )
-
-        defer {
-            closeQueue(&objectHandle)
+    /// Browse the page of messages following the last page returned for a queue
+    /// Continues from the open browse cursor with MQGMO_BROWSE_NEXT, so earlier
+    /// messages are not transferred again. Starts at the first message if the
+    /// queue has no cursor yet
+    /// - Parameters:
+    ///   - queueName: Name of the queue to browse
+    ///   - maxMessages: Maximum number of messages to retrieve
+    /// - Returns: The next messages; empty once the end of the queue is reached
+    /// - Throws: MQError if browsing fails
+    public func browseNextMessages(queueName: String, maxMessages: Int) async throws -> [MQMessage] {
+        return try await withBrowseCursor(queueName: queueName, in: \.browseCursors, maxMessageSize: pagingMessageSize) { cursor in
+            try cursor.nextPage(maxMessages: maxMessages)
         }
-
-        return try performBrowseMessages(
-            objectHandle: objectHandle,
-            queueName: queueName,
-            maxMessages: maxMessages,
-            maxMessageSize: maxMessageSize
-        )
     }
 
-    /// Perform the actual message browsing operation
-    private func performBrowseMessages(
-        objectHandle: MQHOBJ,
-        queueName: String,
-        maxMessages: Int,
-        maxMessageSize: Int
-    ) throws -> [MQMessage] {
-        var messages: [MQMessage] = []
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
-        var isFirstMessage = true
-        var position = 0
-
-        // Buffer for message data
-        var buffer = [UInt8](repeating: 0, count: maxMessageSize)
-
-        while messages.count < maxMessages {
-            // Initialize message descriptor for each MQGET call
-            var messageDescriptor = MQMD()
-            messageDescriptor.Version = MQMD_VERSION_2
-
-            // Initialize get message options
-            var getOptions = MQGMO()
-            getOptions.Version = MQGMO_VERSION_2
-
-            // Use BROWSE_FIRST for the first message, BROWSE_NEXT for subsequent
-            if isFirstMessage {
-                getOptions.Options = MQGMO_BROWSE_FIRST | MQGMO_NO_SYNCPOINT | MQGMO_CONVERT | MQGMO_ACCEPT_TRUNCATED_MSG | MQGMO_FAIL_IF_QUIESCING
-                isFirstMessage = false
-            } else {
-                getOptions.Options = MQGMO_BROWSE_NEXT | MQGMO_NO_SYNCPOINT | MQGMO_CONVERT | MQGMO_ACCEPT_TRUNCATED_MSG | MQGMO_FAIL_IF_QUIESCING
-            }
-
-            // No wait - return immediately if no message
-            getOptions.WaitInterval = 0
-            getOptions.MatchOptions = MQMO_NONE
+    /// Position the queue's browse cursor on a message and return it
+    /// Subsequent calls to browseNextMessages continue with the messages after it
+    /// - Parameters:
+    ///   - queueName: Name of the queue to browse
+    ///   - messageId: MsgId of the message to seek to
+    ///   - position: Known position of the message in the queue
+    /// - Returns: The message, or nil if it is no longer on the queue
+    /// - Throws: MQError if browsing fails
+    public func seekBrowseCursor(queueName: String, messageId: [UInt8], position: Int) async throws -> MQMessage? {
+        return try await withBrowseCursor(queueName: queueName, in: \.browseCursors, maxMessageSize: pagingMessageSize) { cursor in
+            try cursor.seek(messageId: messageId, position: position)
+        }
+    }
 
-            var dataLength: MQLONG = 0
+    /// Position the queue's browse cursor on a message identified by its MsgToken
+    /// - Parameters:
+    ///   - queueName: Name of the queue to browse
+    ///   - messageToken: MsgToken returned with an earlier browsed message
+    ///   - position: Known position of the message in the queue
+    /// - Returns: The message, or nil if it is no longer on the queue
+    /// - Throws: MQError if browsing fails
+    public func seekBrowseCursor(queueName: String, messageToken: [UInt8], position: Int) async throws -> MQMessage? {
+        return try await withBrowseCursor(queueName: queueName, in: \.browseCursors, maxMessageSize: pagingMessageSize) { cursor in
+            try cursor.seek(messageToken: messageToken, position: position)
+        }
+    }
 
-            // Call MQGET to browse the message
-            MQGET(
-                connectionHandle,
-                objectHandle,
-                &messageDescriptor,
-                &getOptions,
-                MQLONG(buffer.count),
-                &buffer,
-                &dataLength,
-                &compCode,
-                &reason
-            )
+    /// Browse a single message by its MsgId without moving the paging cursor
+    /// Uses MQMO_MATCH_MSG_ID on the lookup cursor and returns the complete
+    /// payload (up to maxBrowseMessageSize), so it is how a message listed
+    /// from a preview page gets its full body
+    /// - Parameters:
+    ///   - queueName: Name of the queue to browse
+    ///   - messageId: MsgId of the message
+    /// - Returns: The message, or nil if it is no longer on the queue
+    /// - Throws: MQError if browsing fails
+    public func browseMessage(queueName: String, messageId: [UInt8]) async throws -> MQMessage? {
+        return try await withBrowseCursor(queueName: queueName, in: \.lookupCursors, maxMessageSize: maxBrowseMessageSize) { cursor in
+            let message = try cursor.seek(messageId: messageId, position: 0)
+            // The message's real position is unknown; forget it so browseMessageAt
+            // does not skip relative to it
+            cursor.rewind()
+            return message
+        }
+    }
 
-            // Check for no more messages
-            if reason == MQRC_NO_MSG_AVAILABLE {
-                break
+    /// Browse a single message at a specific position
+    /// Messages before the position are skipped with zero-length browses, so only
+    /// their descriptors are transferred. The lookup cursor is reused between
+    /// calls and only rewound when the position lies behind it
+    /// - Parameters:
+    ///   - queueName: Name of the queue to browse
+    ///   - position: Position of the message (0-based index)
+    /// - Returns: MQMessage at the specified position, or nil if not found
+    /// - Throws: MQError if browsing fails
+    public func browseMessageAt(queueName: String, position: Int) async throws -> MQMessage? {
+        return try await withBrowseCursor(queueName: queueName, in: \.lookupCursors, maxMessageSize: maxBrowseMessageSize) { cursor in
+            if position < cursor.nextPosition {
+                cursor.rewind()
             }
 
-            // Check for errors (allow truncated messages)
-            if compCode == MQCC_FAILED && reason != MQRC_TRUNCATED_MSG_FAILED {
-                throw MQError.operationFailed(
-                    operation: "MQGET(browse \(queueName))",
-                    completionCode: compCode,
-                    reasonCode: reason
-                )
+            let distance = position - cursor.nextPosition
+            guard try cursor.skip(distance) == distance else {
+                return nil
             }
 
-            // Extract message data from descriptor
-            let message = extractMessageFromDescriptor(
-                messageDescriptor: messageDescriptor,
-                buffer: buffer,
-                dataLength: dataLength,
-                position: position
-            )
-            messages.append(message)
-            position += 1
+            return try cursor.nextPage(maxMessages: 1).first
         }
+    }
 
-        return messages
+    /// Number of messages in the first page of a browse stream
+    /// Kept small so the first rows appear after a handful of MQGETs
+    public static let browseStreamFirstPageSize = 25
+
+    /// Browse a queue as a stream of message pages
+    ///
+    /// Each page is read only when the consumer asks for it, so a consumer that
+    /// stops iterating stops the MQGETs and memory stays bounded by what it has
+    /// taken. Like every other MQI call the pages are read on the connection
+    /// thread, so iterating never blocks the main actor.
+    ///
+    /// The stream has its own browse cursor, independent of browseMessages and
+    /// browseNextMessages, which is closed when the stream ends or is released.
+    /// The first page holds at most browseStreamFirstPageSize messages so the
+    /// first rows can be shown quickly; later pages hold pageSize messages.
+    /// With browseReadAheadDepth set, pages are read ahead of the consumer on
+    /// a read-ahead handle, so a long scan is limited by bandwidth.
+    /// - Parameters:
+    ///   - queueName: Name of the queue to browse
+    ///   - pageSize: Maximum number of messages per page
+    /// - Returns: Stream of non-empty pages; it finishes at the end of the queue
+    ///   and throws MQError if browsing fails
+    public func browseMessageStream(queueName: String, pageSize: Int) -> AsyncThrowingStream<[MQMessage], Error> {
+        return browseMessageStream(queueName: queueName, pageSize: pageSize, selector: MessageSelector())
     }
 
-    /// Extract message information from MQMD and payload buffer
-    private func extractMessageFromDescriptor(
-        messageDescriptor: MQMD,
-        buffer: [UInt8],
-        dataLength: MQLONG,
-        position: Int
-    ) -> MQMessage {
-        // Extract message ID (24 bytes)
-        var messageId = [UInt8](repeating: 0, count: Int(MQ_MSG_ID_LENGTH))
-        withUnsafePointer(to: messageDescriptor.MsgId) { ptr in
-            let bound = ptr.withMemoryRebound(to: UInt8.self, capacity: Int(MQ_MSG_ID_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_MSG_ID_LENGTH) {
-                messageId[i] = bound[i]
+    /// Stream the messages of a queue that match a selector
+    /// The queue manager applies the selector, so messages that do not match
+    /// are never transferred; otherwise the same as browseMessageStream(queueName:pageSize:)
+    /// - Parameters:
+    ///   - queueName: Name of the queue to browse
+    ///   - pageSize: Maximum number of messages per page
+    ///   - selector: Criteria the messages must match
+    /// - Returns: A stream of pages that ends after the last matching message
+    public func browseMessageStream(
+        queueName: String,
+        pageSize: Int,
+        selector: MessageSelector
+    ) -> AsyncThrowingStream<[MQMessage], Error> {
+        guard let pool else {
+            return AsyncThrowingStream { continuation in
+                continuation.finish(throwing: MQError.notConnected)
             }
         }
 
-        // Extract correlation ID (24 bytes)
-        var correlationId = [UInt8](repeating: 0, count: Int(MQ_CORREL_ID_LENGTH))
-        withUnsafePointer(to: messageDescriptor.CorrelId) { ptr in
-            let bound = ptr.withMemoryRebound(to: UInt8.self, capacity: Int(MQ_CORREL_ID_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_CORREL_ID_LENGTH) {
-                correlationId[i] = bound[i]
-            }
+        // Resolving the browse connection may have to open it, so it is
+        // awaited by the first page rather than here
+        let maxMessageSize = pagingMessageSize
+        let firstPageSize = min(pageSize, Self.browseStreamFirstPageSize)
+        let readAheadDepth = browseReadAheadDepth
+        let convertsData = convertsBrowsedData
+        let source = Task {
+            BrowsePageSource(
+                connection: try await pool.connection(for: .browse),
+                queueName: queueName,
+                maxMessageSize: maxMessageSize,
+                firstPageSize: firstPageSize,
+                pageSize: pageSize,
+                readAheadDepth: readAheadDepth,
+                selector: selector,
+                convertsData: convertsData
+            )
         }
 
-        // Extract format string (8 characters)
-        var formatChars = [MQCHAR](repeating: 0x20, count: Int(MQ_FORMAT_LENGTH))
-        withUnsafePointer(to: messageDescriptor.Format) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_FORMAT_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_FORMAT_LENGTH) {
-                formatChars[i] = bound[i]
+        return AsyncThrowingStream {
+            let source = try await source.value
+            do {
+                return try await source.nextPage()
+            } catch let error as MQError where error.isConnectionLost {
+                // The browse role gets a new connection for the next stream
+                await pool.discardLost(source.connection)
+                throw error
             }
         }
-        let format = String(bytes: formatChars.map { UInt8(bitPattern: $0) }, encoding: .utf8)?
-            .trimmingCharacters(in: .whitespaces) ?? ""
+    }
 
-        // Extract put application name (28 characters)
-        var putApplNameChars = [MQCHAR](repeating: 0x20, count: Int(MQ_PUT_APPL_NAME_LENGTH))
-        withUnsafePointer(to: messageDescriptor.PutApplName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_PUT_APPL_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_PUT_APPL_NAME_LENGTH) {
-                putApplNameChars[i] = bound[i]
-            }
-        }
-        let putApplicationName = String(bytes: putApplNameChars.map { UInt8(bitPattern: $0) }, encoding: .utf8)?
-            .trimmingCharacters(in: .whitespaces) ?? ""
+    /// Set how many messages browse streams read ahead of their consumer
+    /// - Parameter depth: Number of messages; 0 reads on demand
+    public func setBrowseReadAheadDepth(_ depth: Int) {
+        browseReadAheadDepth = max(depth, 0)
+    }
 
-        // Extract reply-to queue name (48 characters)
-        var replyToQChars = [MQCHAR](repeating: 0x20, count: Int(MQ_Q_NAME_LENGTH))
-        withUnsafePointer(to: messageDescriptor.ReplyToQ) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                replyToQChars[i] = bound[i]
-            }
-        }
-        let replyToQueue = String(bytes: replyToQChars.map { UInt8(bitPattern: $0) }, encoding: .utf8)?
-            .trimmingCharacters(in: .whitespaces) ?? ""
+    /// Set whether browses ask the queue manager to convert payloads
+    /// - Parameter converts: false to receive payloads as stored and decode them on the client
+    public func setBrowseDataConversion(_ converts: Bool) {
+        convertsBrowsedData = converts
+    }
+
+    // MARK: - Live Tail
+
+    /// How a live tail consumes the messages arriving on a queue
+    public enum TailMode: String, Sendable, CaseIterable {
+        /// Arrivals are browsed and stay on the queue
+        case browse
+        /// Arrivals are removed from the queue as they are delivered
+        case destructive
+    }
 
-        // Extract reply-to queue manager name (48 characters)
-        var replyToQMgrChars = [MQCHAR](repeating: 0x20, count: Int(MQ_Q_MGR_NAME_LENGTH))
-        withUnsafePointer(to: messageDescriptor.ReplyToQMgr) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_MGR_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_MGR_NAME_LENGTH) {
-                replyToQMgrChars[i] = bound[i]
+    /// Stream the messages arriving on a queue as they land
+    /// The queue manager pushes arrivals to an MQCB message consumer, and the
+    /// stream yields them in batches coalesced per UI frame. Browse mode skips
+    /// the messages already on the queue. The tail holds a leased connection of
+    /// its own until the stream is cancelled or delivery fails
+    /// - Parameters:
+    ///   - queueName: Name of the queue to tail
+    ///   - mode: Whether arrivals are browsed or removed
+    /// - Returns: A stream of message batches that only ends with cancellation or an error
+    public func tailMessageStream(queueName: String, mode: TailMode) -> AsyncThrowingStream<[MQMessage], Error> {
+        guard let pool else {
+            return AsyncThrowingStream { continuation in
+                continuation.finish(throwing: MQError.notConnected)
             }
         }
-        let replyToQueueManager = String(bytes: replyToQMgrChars.map { UInt8(bitPattern: $0) }, encoding: .utf8)?
-            .trimmingCharacters(in: .whitespaces) ?? ""
 
-        // Parse put date/time
-        let putDateTime = parsePutDateTime(messageDescriptor: messageDescriptor)
+        let maxMessageSize = pagingMessageSize
+        let convertsData = convertsBrowsedData
+        return AsyncThrowingStream { continuation in
+            let tail = QueueTail(
+                queueName: queueName,
+                mode: mode,
+                maxMessageSize: maxMessageSize,
+                convertsData: convertsData
+            ) { messages in
+                continuation.yield(messages)
+            }
 
-        // Extract payload
-        let payloadSize = min(Int(dataLength), buffer.count)
-        let payload = Data(buffer.prefix(payloadSize))
+            let task = Task { @MainActor in
+                do {
+                    try await pool.withLease { connection in
+                        // A started connection serves no other MQI calls, so it cannot be a shared one
+                        guard pool.isExclusivelyLeased(connection) else {
+                            throw MQError.invalidConfiguration(
+                                message: "A live tail needs a connection of its own; allow more connections in the pool"
+                            )
+                        }
 
-        return MQMessage(
-            messageId: messageId,
-            correlationId: correlationId,
-            format: format,
-            payload: payload,
-            putDateTime: putDateTime,
-            putApplicationName: putApplicationName,
-            messageType: MQMessageType(rawValue: messageDescriptor.MsgType),
-            persistence: MQMessagePersistence(rawValue: messageDescriptor.Persistence),
-            priority: messageDescriptor.Priority,
-            replyToQueue: replyToQueue,
-            replyToQueueManager: replyToQueueManager,
-            messageSequenceNumber: messageDescriptor.MsgSeqNumber,
-            position: position
-        )
-    }
+                        try await connection.perform { connection in
+                            try tail.start(on: connection)
+                        }
 
-    /// Parse put date and time from MQMD fields
-    private func parsePutDateTime(messageDescriptor: MQMD) -> Date? {
-        // Extract PutDate (8 characters: YYYYMMDD)
-        var putDateChars = [MQCHAR](repeating: 0x20, count: Int(MQ_PUT_DATE_LENGTH))
-        withUnsafePointer(to: messageDescriptor.PutDate) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_PUT_DATE_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_PUT_DATE_LENGTH) {
-                putDateChars[i] = bound[i]
+                        // Stopped before the lease ends, whether delivery failed or the stream was cancelled
+                        do {
+                            try await withTaskCancellationHandler {
+                                try await tail.waitUntilEnded()
+                            } onCancel: {
+                                tail.end()
+                            }
+                        } catch {
+                            try? await connection.perform { tail.stop(on: $0) }
+                            throw error
+                        }
+                        try? await connection.perform { tail.stop(on: $0) }
+                    }
+                    continuation.finish()
+                } catch {
+                    continuation.finish(throwing: error)
+                }
             }
-        }
-        let putDateString = String(bytes: putDateChars.map { UInt8(bitPattern: $0) }, encoding: .utf8)?
-            .trimmingCharacters(in: .whitespaces) ?? ""
 
-        // Extract PutTime (8 characters: HHMMSSTH)
-        var putTimeChars = [MQCHAR](repeating: 0x20, count: Int(MQ_PUT_TIME_LENGTH))
-        withUnsafePointer(to: messageDescriptor.PutTime) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_PUT_TIME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_PUT_TIME_LENGTH) {
-                putTimeChars[i] = bound[i]
+            continuation.onTermination = { _ in
+                task.cancel()
             }
         }
-        let putTimeString = String(bytes: putTimeChars.map { UInt8(bitPattern: $0) }, encoding: .utf8)?
-            .trimmingCharacters(in: .whitespaces) ?? ""
+    }
 
-        // Parse date and time
-        guard putDateString.count >= 8, putTimeString.count >= 6 else {
-            return nil
+    /// Close the browse cursors of a queue
+    /// The next browse of the queue starts again from the first message
+    /// - Parameter queueName: Name of the queue
+    public func closeBrowseCursor(queueName: String) {
+        // Queued behind any browse in flight, so the next browse sees the cursor closed
+        pool?.pinnedConnection(for: .browse)?.execute { connection in
+            connection.closeBrowseCursors(queueName: queueName)
         }
-
-        let dateFormatter = DateFormatter()
-        dateFormatter.dateFormat = "yyyyMMddHHmmss"
-        dateFormatter.timeZone = TimeZone(identifier: "UTC")
-
-        let dateTimeString = String(putDateString.prefix(8)) + String(putTimeString.prefix(6))
-        return dateFormatter.date(from: dateTimeString)
     }
 
-    /// Browse a single message at a specific position
+    /// Run an operation on one of the queue's browse cursors, opening it on first use
+    /// The operation runs on the browse connection's thread. Drops the cursor when a
+    /// failure means its handle is no longer usable
     /// - Parameters:
     ///   - queueName: Name of the queue to browse
-    ///   - position: Position of the message (0-based index)
-    ///   - maxMessageSize: Maximum size per message in bytes (default: 4MB)
-    /// - Returns: MQMessage at the specified position, or nil if not found
-    /// - Throws: MQError if browsing fails
-    public func browseMessageAt(
+    ///   - cursors: The cursor table to use (paging or lookup)
+    ///   - maxMessageSize: Payload limit for a newly opened cursor
+    ///   - body: Operation to run on the cursor
+    /// - Returns: The result of body
+    /// - Throws: MQError if the cursor cannot be opened or the operation fails
+    private func withBrowseCursor<T>(
         queueName: String,
-        position: Int,
-        maxMessageSize: Int = 4 * 1024 * 1024
-    ) async throws -> MQMessage? {
-        guard isConnected else {
-            throw MQError.notConnected
-        }
-
-        // Browse messages up to and including the specified position
-        let messages = try await browseMessages(
-            queueName: queueName,
-            maxMessages: position + 1,
-            maxMessageSize: maxMessageSize
-        )
+        in cursors: ReferenceWritableKeyPath<MQConnection, [String: BrowseCursor]>,
+        maxMessageSize: Int,
+        _ body: @escaping (BrowseCursor) throws -> T
+    ) async throws -> T {
+        let convertsData = convertsBrowsedData
+
+        return try await withPinnedConnection(for: .browse, from: getConnectionPool()) { connection in
+            let cursor: BrowseCursor
+            let existing = connection[keyPath: cursors][queueName]
+            if let existing, existing.isOpen, existing.convertsData == convertsData {
+                cursor = existing
+            } else {
+                existing?.close()
+                cursor = try BrowseCursor(
+                    connectionHandle: connection.handle,
+                    queueName: queueName,
+                    maxMessageSize: maxMessageSize,
+                    convertsData: convertsData
+                )
+                connection[keyPath: cursors][queueName] = cursor
+            }
 
-        // Return the message at the specified position if it exists
-        guard position < messages.count else {
-            return nil
+            do {
+                return try body(cursor)
+            } catch let error as MQError where error.invalidatesObjectHandle {
+                cursor.close()
+                connection[keyPath: cursors][queueName] = nil
+                throw error
+            }
         }
+    }
 
-        return messages[position]
+    /// Payload limit of the paging cursors: the preview length if previews are enabled
+    private var pagingMessageSize: Int {
+        return min(browsePreviewLength ?? maxBrowseMessageSize, maxBrowseMessageSize)
     }
 
     /// Get the count of messages currently in a queue
@@ -1274,8 +1547,8 @@ public final class MQService: MQServiceProtocol {
     /// - Parameter queueName: Name of the queue
     /// - Returns: Number of messages in the queue
     /// - Throws: MQError if inquiry fails
-    public func getMessageCount(queueName: String) throws -> Int32 {
-        let queueInfo = try getQueueInfo(queueName: queueName)
+    public func getMessageCount(queueName: String) async throws -> Int32 {
+        let queueInfo = try await getQueueInfo(queueName: queueName)
         return queueInfo.currentDepth
     }
 
@@ -1293,9 +1566,7 @@ public final class MQService: MQServiceProtocol {
         queueType: MQQueueType = .local,
         maxDepth: Int32? = nil
     ) async throws {
-        guard isConnected else {
-            throw MQError.notConnected
-        }
+        let pool = try getConnectionPool()
 
         // Validate queue name
         guard !queueName.isEmpty else {
@@ -1307,278 +1578,141 @@ public final class MQService: MQServiceProtocol {
         }
 
         // Send PCF create queue command
-        try sendPCFCreateQueue(
-            queueName: queueName,
-            queueType: queueType,
-            maxDepth: maxDepth
-        )
+        try await withPinnedConnection(for: .admin, from: pool) { connection in
+            try self.sendPCFCreateQueue(
+                on: connection,
+                queueName: queueName,
+                queueType: queueType,
+                maxDepth: maxDepth
+            )
+        }
+    }
+
+    /// Definition of a queue for bulk creation with createQueues(_:)
+    public struct QueueDefinition: Sendable {
+        public let name: String
+        public let queueType: MQQueueType
+        public let maxDepth: Int32?
+
+        public init(name: String, queueType: MQQueueType = .local, maxDepth: Int32? = nil) {
+            self.name = name
+            self.queueType = queueType
+            self.maxDepth = maxDepth
+        }
+    }
+
+    /// Create several queues with all MQCMD_CREATE_Q commands in flight at once
+    /// Every command shares the connection's PCF session, so provisioning many
+    /// queues pays the session setup cost only once
+    /// - Parameter definitions: Queues to create
+    /// - Returns: Names of the queues that could not be created, with the reason
+    /// - Throws: MQError if not connected or the PCF session cannot be opened
+    public func createQueues(_ definitions: [QueueDefinition]) async throws -> [String: MQError] {
+        let pool = try getConnectionPool()
+
+        var failures: [String: MQError] = [:]
+        var commands: [PCFCommand] = []
+        var commandQueueNames: [String] = []
+
+        for definition in definitions {
+            guard !definition.name.isEmpty, definition.name.count <= Int(MQ_Q_NAME_LENGTH) else {
+                failures[definition.name] = .invalidConfiguration(
+                    message: "Queue name must be between 1 and 48 characters"
+                )
+                continue
+            }
+            commands.append(buildPCFCreateQueueCommand(
+                queueName: definition.name,
+                queueType: definition.queueType,
+                maxDepth: definition.maxDepth
+            ))
+            commandQueueNames.append(definition.name)
+        }
+
+        let commandFailures = try await withPinnedConnection(for: .admin, from: pool) { [commands, commandQueueNames] connection in
+            let session = try connection.commandSession()
+            let results = session.execute(commands, waitInterval: 30000) { index, response in // 30 second timeout
+                try self.validatePCFResponse(response, operation: "Create queue \(commandQueueNames[index])")
+            }
+
+            var commandFailures: [String: MQError] = [:]
+            for (queueName, result) in zip(commandQueueNames, results) {
+                do {
+                    try result.get()
+                } catch {
+                    self.invalidateCommandSessionIfNeeded(on: connection, after: error)
+                    commandFailures[queueName] = (error as? MQError) ?? .unknown(reasonCode: MQRC_UNEXPECTED_ERROR)
+                }
+            }
+            return commandFailures
+        }
+
+        return failures.merging(commandFailures) { _, commandFailure in commandFailure }
     }
 
     /// Send a PCF MQCMD_CREATE_Q command to create a new queue
     /// - Parameters:
+    ///   - connection: Connection whose PCF session sends the command
     ///   - queueName: Name of the queue to create
     ///   - queueType: Type of queue to create
     ///   - maxDepth: Maximum depth of the queue (optional)
     /// - Throws: MQError if the PCF command fails
-    private func sendPCFCreateQueue(
+    nonisolated private func sendPCFCreateQueue(
+        on connection: MQConnection,
         queueName: String,
         queueType: MQQueueType,
         maxDepth: Int32?
     ) throws {
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
-
-        // Open the command queue for sending PCF commands
-        var adminObjectHandle = try openQueue(
-            queueName: "SYSTEM.ADMIN.COMMAND.QUEUE",
-            options: MQOO_OUTPUT | MQOO_FAIL_IF_QUIESCING
-        )
-
-        defer {
-            closeQueue(&adminObjectHandle)
-        }
-
-        // Generate a unique reply queue name
-        let replyQueueModel = "SYSTEM.DEFAULT.MODEL.QUEUE"
-        let replyQueuePrefix = "MQMATE.REPLY.*"
-
-        // Open a dynamic reply queue
-        var replyObjectDescriptor = MQOD()
-        replyObjectDescriptor.Version = MQOD_VERSION_4
-        replyObjectDescriptor.ObjectType = MQOT_Q
-
-        // Set model queue name
-        let modelQueueChars = replyQueueModel.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-        withUnsafeMutablePointer(to: &replyObjectDescriptor.ObjectName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                bound[i] = modelQueueChars[i]
-            }
-        }
-
-        // Set dynamic queue name prefix
-        let dynamicQueueChars = replyQueuePrefix.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-        withUnsafeMutablePointer(to: &replyObjectDescriptor.DynamicQName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                bound[i] = dynamicQueueChars[i]
-            }
-        }
-
-        var replyObjectHandle: MQHOBJ = MQHO_UNUSABLE_HOBJ
-        MQOPEN(
-            connectionHandle,
-            &replyObjectDescriptor,
-            MQOO_INPUT_EXCLUSIVE | MQOO_FAIL_IF_QUIESCING,
-            &replyObjectHandle,
-            &compCode,
-            &reason
-        )
-
-        guard compCode != MQCC_FAILED else {
-            throw MQError.operationFailed(
-                operation: "MQOPEN(reply queue for create)",
-                completionCode: compCode,
-                reasonCode: reason
-            )
-        }
-
-        defer {
-            var handle = replyObjectHandle
-            closeQueue(&handle)
-        }
-
-        // Extract the actual dynamic queue name
-        var replyQueueName = [MQCHAR](repeating: 0x20, count: Int(MQ_Q_NAME_LENGTH))
-        withUnsafePointer(to: &replyObjectDescriptor.ObjectName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                replyQueueName[i] = bound[i]
-            }
-        }
-
-        // Build PCF message for MQCMD_CREATE_Q
-        let pcfMessage = try buildPCFCreateQueueMessage(
+        let command = buildPCFCreateQueueCommand(
             queueName: queueName,
             queueType: queueType,
-            maxDepth: maxDepth,
-            replyQueueName: replyQueueName
-        )
-
-        // Send the PCF command
-        try sendPCFMessage(
-            objectHandle: adminObjectHandle,
-            message: pcfMessage,
-            replyQueueName: replyQueueName
+            maxDepth: maxDepth
         )
 
-        // Receive and check the response for errors
-        try receivePCFCreateQueueResponse(replyObjectHandle: replyObjectHandle)
+        // Send the PCF command and check the response for errors
+        try executePCFCommand(command, on: connection, waitInterval: 30000) { response in // 30 second timeout for admin commands
+            try validatePCFResponse(response, operation: "Create queue")
+        }
     }
 
-    /// Build a PCF MQCMD_CREATE_Q message
+    /// Build a PCF MQCMD_CREATE_Q command
     /// - Parameters:
     ///   - queueName: Name of the queue to create
     ///   - queueType: Type of queue to create
     ///   - maxDepth: Maximum depth of the queue (optional)
-    ///   - replyQueueName: Reply queue name for response
-    /// - Returns: PCF message data
-    private func buildPCFCreateQueueMessage(
+    /// - Returns: PCF command ready to send
+    nonisolated private func buildPCFCreateQueueCommand(
         queueName: String,
         queueType: MQQueueType,
-        maxDepth: Int32?,
-        replyQueueName: [MQCHAR]
-    ) throws -> Data {
-        // Determine parameter count based on optional parameters
-        var parameterCount: Int32 = 2 // Queue name + queue type (required)
-        if maxDepth != nil {
-            parameterCount += 1
-        }
-
-        // PCF Header structure
-        var pcfHeader = MQCFH()
-        pcfHeader.Type = MQCFT_COMMAND
-        pcfHeader.StrucLength = MQCFH_STRUC_LENGTH
-        pcfHeader.Version = MQCFH_VERSION_1
-        pcfHeader.Command = MQCMD_CREATE_Q
-        pcfHeader.MsgSeqNumber = 1
-        pcfHeader.Control = MQCFC_LAST
-        pcfHeader.ParameterCount = parameterCount
-
-        var message = Data()
-
-        // Append header
-        withUnsafeBytes(of: &pcfHeader) { buffer in
-            message.append(contentsOf: buffer)
-        }
+        maxDepth: Int32?
+    ) -> PCFCommand {
+        var command = PCFCommand(command: MQCMD_CREATE_Q)
 
         // Add MQCA_Q_NAME parameter (string parameter for queue name)
-        var qNameParam = MQCFST()
-        qNameParam.Type = MQCFT_STRING
-        qNameParam.StrucLength = MQCFST_STRUC_LENGTH_FIXED + Int32(MQ_Q_NAME_LENGTH)
-        qNameParam.Parameter = MQCA_Q_NAME
-        qNameParam.CodedCharSetId = MQCCSI_DEFAULT
-        qNameParam.StringLength = Int32(MQ_Q_NAME_LENGTH)
-
-        withUnsafeBytes(of: &qNameParam) { buffer in
-            // Only append up to the String field (before the actual string data)
-            message.append(contentsOf: buffer.prefix(MemoryLayout<MQCFST>.size - MemoryLayout<MQCHAR>.size))
-        }
-
-        // Append the queue name string (space-padded to 48 chars)
-        let queueNameChars = queueName.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-        message.append(contentsOf: queueNameChars.map { UInt8(bitPattern: $0) })
+        command.appendString(parameter: MQCA_Q_NAME, value: queueName, length: Int(MQ_Q_NAME_LENGTH))
 
         // Add MQIA_Q_TYPE parameter (integer parameter for queue type)
-        var qTypeParam = MQCFIN()
-        qTypeParam.Type = MQCFT_INTEGER
-        qTypeParam.StrucLength = MQCFIN_STRUC_LENGTH
-        qTypeParam.Parameter = MQIA_Q_TYPE
-        qTypeParam.Value = queueType.rawValue
-
-        withUnsafeBytes(of: &qTypeParam) { buffer in
-            message.append(contentsOf: buffer)
-        }
+        command.appendInteger(parameter: MQIA_Q_TYPE, value: queueType.rawValue)
 
         // Add MQIA_MAX_Q_DEPTH parameter if specified
         if let maxDepth = maxDepth {
-            var maxDepthParam = MQCFIN()
-            maxDepthParam.Type = MQCFT_INTEGER
-            maxDepthParam.StrucLength = MQCFIN_STRUC_LENGTH
-            maxDepthParam.Parameter = MQIA_MAX_Q_DEPTH
-            maxDepthParam.Value = maxDepth
-
-            withUnsafeBytes(of: &maxDepthParam) { buffer in
-                message.append(contentsOf: buffer)
-            }
-        }
-
-        return message
-    }
-
-    /// Receive and validate PCF response for queue creation
-    /// - Parameter replyObjectHandle: Handle to the reply queue
-    /// - Throws: MQError if the queue creation failed
-    private func receivePCFCreateQueueResponse(replyObjectHandle: MQHOBJ) throws {
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
-
-        // Message descriptor
-        var messageDescriptor = MQMD()
-        messageDescriptor.Version = MQMD_VERSION_2
-
-        // Get message options
-        var getOptions = MQGMO()
-        getOptions.Version = MQGMO_VERSION_2
-        getOptions.Options = MQGMO_NO_SYNCPOINT | MQGMO_WAIT | MQGMO_CONVERT
-        getOptions.WaitInterval = 30000 // 30 second timeout for admin commands
-        getOptions.MatchOptions = MQMO_NONE
-
-        // Buffer for response
-        var buffer = [UInt8](repeating: 0, count: 65536)
-        var dataLength: MQLONG = 0
-
-        MQGET(
-            connectionHandle,
-            replyObjectHandle,
-            &messageDescriptor,
-            &getOptions,
-            MQLONG(buffer.count),
-            &buffer,
-            &dataLength,
-            &compCode,
-            &reason
-        )
-
-        if reason == MQRC_NO_MSG_AVAILABLE {
-            throw MQError.operationFailed(
-                operation: "Create queue (no response received)",
-                completionCode: MQCC_FAILED,
-                reasonCode: reason
-            )
-        }
-
-        guard compCode != MQCC_FAILED else {
-            throw MQError.operationFailed(
-                operation: "MQGET(PCF create queue response)",
-                completionCode: compCode,
-                reasonCode: reason
-            )
+            command.appendInteger(parameter: MQIA_MAX_Q_DEPTH, value: maxDepth)
         }
 
-        // Parse the PCF response header to check for errors
-        let responseData = Data(buffer.prefix(Int(dataLength)))
-        try validatePCFResponse(data: responseData, operation: "Create queue")
+        return command
     }
 
     /// Validate a PCF response for success or error
     /// - Parameters:
-    ///   - data: The PCF response data
+    ///   - response: The PCF response, decoded in place
     ///   - operation: Description of the operation for error messages
     /// - Throws: MQError if the PCF response indicates failure
-    private func validatePCFResponse(data: Data, operation: String) throws {
-        guard data.count >= MemoryLayout<MQCFH>.size else {
-            throw MQError.operationFailed(
-                operation: operation,
-                completionCode: MQCC_FAILED,
-                reasonCode: MQRC_UNEXPECTED_ERROR
-            )
-        }
-
-        // Read the completion code and reason from the PCF header
-        // CompCode is at offset 24, Reason is at offset 28 in MQCFH
-        let pcfCompCode: Int32 = data.withUnsafeBytes { ptr in
-            ptr.load(fromByteOffset: 24, as: Int32.self)
-        }
-        let pcfReason: Int32 = data.withUnsafeBytes { ptr in
-            ptr.load(fromByteOffset: 28, as: Int32.self)
-        }
-
-        guard pcfCompCode != MQCC_FAILED else {
+    nonisolated private func validatePCFResponse(_ response: PCFResponse, operation: String) throws {
+        guard response.compCode != MQCC_FAILED else {
             throw MQError.operationFailed(
                 operation: operation,
-                completionCode: pcfCompCode,
-                reasonCode: pcfReason
+                completionCode: response.compCode,
+                reasonCode: response.reason
             )
         }
     }
@@ -1588,9 +1722,7 @@ public final class MQService: MQServiceProtocol {
     /// - Parameter queueName: Name of the queue to delete (max 48 characters)
     /// - Throws: MQError if queue deletion fails
     public func deleteQueue(queueName: String) async throws {
-        guard isConnected else {
-            throw MQError.notConnected
-        }
+        let pool = try getConnectionPool()
 
         // Validate queue name
         guard !queueName.isEmpty else {
@@ -1601,267 +1733,277 @@ public final class MQService: MQServiceProtocol {
             throw MQError.invalidConfiguration(message: "Queue name cannot exceed 48 characters")
         }
 
+        // Our own browse and cached handles would make the delete fail with
+        // MQRC_OBJECT_IN_USE, so close them on every connection first
+        await pool.closeQueueHandles(queueName: queueName)
+
         // Send PCF delete queue command
-        try sendPCFDeleteQueue(queueName: queueName)
+        try await withPinnedConnection(for: .admin, from: pool) { connection in
+            try self.sendPCFDeleteQueue(on: connection, queueName: queueName)
+        }
     }
 
     /// Send a PCF MQCMD_DELETE_Q command to delete a queue
-    /// - Parameter queueName: Name of the queue to delete
+    /// - Parameters:
+    ///   - connection: Connection whose PCF session sends the command
+    ///   - queueName: Name of the queue to delete
     /// - Throws: MQError if the PCF command fails
-    private func sendPCFDeleteQueue(queueName: String) throws {
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
+    nonisolated private func sendPCFDeleteQueue(on connection: MQConnection, queueName: String) throws {
+        var command = PCFCommand(command: MQCMD_DELETE_Q)
 
-        // Open the command queue for sending PCF commands
-        var adminObjectHandle = try openQueue(
-            queueName: "SYSTEM.ADMIN.COMMAND.QUEUE",
-            options: MQOO_OUTPUT | MQOO_FAIL_IF_QUIESCING
-        )
+        // Add MQCA_Q_NAME parameter (string parameter for queue name)
+        command.appendString(parameter: MQCA_Q_NAME, value: queueName, length: Int(MQ_Q_NAME_LENGTH))
 
-        defer {
-            closeQueue(&adminObjectHandle)
+        // Send the PCF command and check the response for errors
+        try executePCFCommand(command, on: connection, waitInterval: 30000) { response in // 30 second timeout for admin commands
+            try validatePCFResponse(response, operation: "Delete queue")
         }
+    }
 
-        // Generate a unique reply queue name
-        let replyQueueModel = "SYSTEM.DEFAULT.MODEL.QUEUE"
-        let replyQueuePrefix = "MQMATE.REPLY.*"
-
-        // Open a dynamic reply queue
-        var replyObjectDescriptor = MQOD()
-        replyObjectDescriptor.Version = MQOD_VERSION_4
-        replyObjectDescriptor.ObjectType = MQOT_Q
-
-        // Set model queue name
-        let modelQueueChars = replyQueueModel.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-        withUnsafeMutablePointer(to: &replyObjectDescriptor.ObjectName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                bound[i] = modelQueueChars[i]
-            }
-        }
+    // MARK: - Queue Purge Operations
 
-        // Set dynamic queue name prefix
-        let dynamicQueueChars = replyQueuePrefix.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-        withUnsafeMutablePointer(to: &replyObjectDescriptor.DynamicQName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                bound[i] = dynamicQueueChars[i]
-            }
-        }
+    /// How purgeQueue(queueName:options:progress:) removes the messages of a queue
+    public enum PurgeStrategy: String, Sendable, CaseIterable {
+        /// Try MQCMD_CLEAR_Q, and drain the queue with MQGET if the command cannot be carried out
+        case automatic
+        /// Only clear the queue with the PCF MQCMD_CLEAR_Q command
+        case clearCommand
+        /// Only drain the queue with destructive MQGETs under syncpoint
+        case destructiveGet
+    }
 
-        var replyObjectHandle: MQHOBJ = MQHO_UNUSABLE_HOBJ
-        MQOPEN(
-            connectionHandle,
-            &replyObjectDescriptor,
-            MQOO_INPUT_EXCLUSIVE | MQOO_FAIL_IF_QUIESCING,
-            &replyObjectHandle,
-            &compCode,
-            &reason
-        )
+    /// Settings for a purge
+    public struct PurgeOptions: Sendable, Equatable {
+        /// How the messages are removed
+        public var strategy: PurgeStrategy
+        /// Messages removed per unit of work when draining with MQGET (at least 1)
+        public var batchSize: Int
+        /// Pooled connections draining the queue at once (at least 1, at most the pool size)
+        public var parallelism: Int
 
-        guard compCode != MQCC_FAILED else {
-            throw MQError.operationFailed(
-                operation: "MQOPEN(reply queue for delete)",
-                completionCode: compCode,
-                reasonCode: reason
-            )
+        public init(strategy: PurgeStrategy = .automatic, batchSize: Int = 500, parallelism: Int = 1) {
+            self.strategy = strategy
+            self.batchSize = max(batchSize, 1)
+            self.parallelism = max(parallelism, 1)
         }
+    }
 
-        defer {
-            var handle = replyObjectHandle
-            closeQueue(&handle)
-        }
+    /// Outcome of a purge
+    public struct PurgeResult: Sendable, Equatable {
+        /// Messages removed; for MQCMD_CLEAR_Q, the queue depth just before the clear
+        public let removedCount: Int
+        /// Strategy that removed the messages, never .automatic
+        public let strategy: PurgeStrategy
+        /// Whether the purge stopped early because its task was cancelled
+        public let wasCancelled: Bool
 
-        // Extract the actual dynamic queue name
-        var replyQueueName = [MQCHAR](repeating: 0x20, count: Int(MQ_Q_NAME_LENGTH))
-        withUnsafePointer(to: &replyObjectDescriptor.ObjectName) { ptr in
-            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                replyQueueName[i] = bound[i]
-            }
+        public init(removedCount: Int, strategy: PurgeStrategy, wasCancelled: Bool = false) {
+            self.removedCount = removedCount
+            self.strategy = strategy
+            self.wasCancelled = wasCancelled
         }
+    }
 
-        // Build PCF message for MQCMD_DELETE_Q
-        let pcfMessage = try buildPCFDeleteQueueMessage(
-            queueName: queueName,
-            replyQueueName: replyQueueName
-        )
-
-        // Send the PCF command
-        try sendPCFMessage(
-            objectHandle: adminObjectHandle,
-            message: pcfMessage,
-            replyQueueName: replyQueueName
-        )
-
-        // Receive and check the response for errors
-        try receivePCFDeleteQueueResponse(replyObjectHandle: replyObjectHandle)
+    /// Purge all messages from a queue
+    /// - Parameter queueName: Name of the queue to purge
+    /// - Returns: Number of messages purged
+    /// - Throws: MQError if purging fails
+    public func purgeQueue(queueName: String) async throws -> Int {
+        return try await purgeQueue(queueName: queueName, options: PurgeOptions(), progress: nil).removedCount
     }
 
-    /// Build a PCF MQCMD_DELETE_Q message
+    /// Purge all messages from a queue
+    /// With the automatic strategy the queue is cleared with one MQCMD_CLEAR_Q
+    /// command, and drained with batched destructive MQGETs only when the
+    /// command cannot be carried out (see MQError.isCommandUnavailable); other
+    /// errors, such as MQRC_NOT_AUTHORIZED, are thrown. Draining commits every options.batchSize
+    /// messages and stops between batches when the calling task is cancelled,
+    /// so the messages already committed stay removed.
     /// - Parameters:
-    ///   - queueName: Name of the queue to delete
-    ///   - replyQueueName: Reply queue name for response
-    /// - Returns: PCF message data
-    private func buildPCFDeleteQueueMessage(
+    ///   - queueName: Name of the queue to purge
+    ///   - options: Strategy, batch size and parallelism
+    ///   - progress: Called with the total number of messages removed after every commit
+    /// - Returns: Number of messages removed and how
+    /// - Throws: MQError if purging fails; messages committed before the failure
+    ///   have already been reported to progress
+    public func purgeQueue(
         queueName: String,
-        replyQueueName: [MQCHAR]
-    ) throws -> Data {
-        // PCF Header structure
-        var pcfHeader = MQCFH()
-        pcfHeader.Type = MQCFT_COMMAND
-        pcfHeader.StrucLength = MQCFH_STRUC_LENGTH
-        pcfHeader.Version = MQCFH_VERSION_1
-        pcfHeader.Command = MQCMD_DELETE_Q
-        pcfHeader.MsgSeqNumber = 1
-        pcfHeader.Control = MQCFC_LAST
-        pcfHeader.ParameterCount = 1 // Only queue name required
-
-        var message = Data()
+        options: PurgeOptions,
+        progress: (@MainActor (Int) -> Void)?
+    ) async throws -> PurgeResult {
+        let pool = try getConnectionPool()
 
-        // Append header
-        withUnsafeBytes(of: &pcfHeader) { buffer in
-            message.append(contentsOf: buffer)
+        // Validate queue name
+        guard !queueName.isEmpty else {
+            throw MQError.invalidConfiguration(message: "Queue name cannot be empty")
         }
 
-        // Add MQCA_Q_NAME parameter (string parameter for queue name)
-        var qNameParam = MQCFST()
-        qNameParam.Type = MQCFT_STRING
-        qNameParam.StrucLength = MQCFST_STRUC_LENGTH_FIXED + Int32(MQ_Q_NAME_LENGTH)
-        qNameParam.Parameter = MQCA_Q_NAME
-        qNameParam.CodedCharSetId = MQCCSI_DEFAULT
-        qNameParam.StringLength = Int32(MQ_Q_NAME_LENGTH)
-
-        withUnsafeBytes(of: &qNameParam) { buffer in
-            // Only append up to the String field (before the actual string data)
-            message.append(contentsOf: buffer.prefix(MemoryLayout<MQCFST>.size - MemoryLayout<MQCHAR>.size))
+        if options.strategy != .destructiveGet {
+            do {
+                let removedCount = try await clearQueue(queueName: queueName, pool: pool)
+                progress?(removedCount)
+                return PurgeResult(removedCount: removedCount, strategy: .clearCommand)
+            } catch let error as MQError where options.strategy == .automatic && error.isCommandUnavailable {
+                // No command server, or CLEAR refused for an open queue; drain it instead
+            }
         }
 
-        // Append the queue name string (space-padded to 48 chars)
-        let queueNameChars = queueName.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-        message.append(contentsOf: queueNameChars.map { UInt8(bitPattern: $0) })
-
-        return message
+        return try await drainQueue(queueName: queueName, pool: pool, options: options, progress: progress)
     }
 
-    /// Receive and validate PCF response for queue deletion
-    /// - Parameter replyObjectHandle: Handle to the reply queue
-    /// - Throws: MQError if the queue deletion failed
-    private func receivePCFDeleteQueueResponse(replyObjectHandle: MQHOBJ) throws {
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
-
-        // Message descriptor
-        var messageDescriptor = MQMD()
-        messageDescriptor.Version = MQMD_VERSION_2
-
-        // Get message options
-        var getOptions = MQGMO()
-        getOptions.Version = MQGMO_VERSION_2
-        getOptions.Options = MQGMO_NO_SYNCPOINT | MQGMO_WAIT | MQGMO_CONVERT
-        getOptions.WaitInterval = 30000 // 30 second timeout for admin commands
-        getOptions.MatchOptions = MQMO_NONE
-
-        // Buffer for response
-        var buffer = [UInt8](repeating: 0, count: 65536)
-        var dataLength: MQLONG = 0
-
-        MQGET(
-            connectionHandle,
-            replyObjectHandle,
-            &messageDescriptor,
-            &getOptions,
-            MQLONG(buffer.count),
-            &buffer,
-            &dataLength,
-            &compCode,
-            &reason
-        )
-
-        if reason == MQRC_NO_MSG_AVAILABLE {
-            throw MQError.operationFailed(
-                operation: "Delete queue (no response received)",
-                completionCode: MQCC_FAILED,
-                reasonCode: reason
-            )
-        }
+    /// Clear a queue with the PCF MQCMD_CLEAR_Q command
+    /// - Parameters:
+    ///   - queueName: Name of the queue to clear
+    ///   - pool: Pool of the connected queue manager
+    /// - Returns: Queue depth just before the clear
+    /// - Throws: MQError if the depth cannot be inquired or the command fails
+    private func clearQueue(queueName: String, pool: MQConnectionPool) async throws -> Int {
+        // CLEAR fails with MQRC_OBJECT_IN_USE while any handle is open, our own included
+        await pool.closeQueueHandles(queueName: queueName)
+
+        return try await withPinnedConnection(for: .admin, from: pool) { connection in
+            // A short-lived inquiry handle, so the queue is closed again when the command runs
+            var objectHandle = try connection.openQueue(queueName: queueName, options: MQOO_INQUIRE | MQOO_FAIL_IF_QUIESCING)
+            let queueInfo: QueueInfo
+            do {
+                queueInfo = try self.inquireQueueAttributes(on: connection, objectHandle: objectHandle, queueName: queueName)
+            } catch {
+                connection.closeQueue(&objectHandle)
+                throw error
+            }
+            connection.closeQueue(&objectHandle)
 
-        guard compCode != MQCC_FAILED else {
-            throw MQError.operationFailed(
-                operation: "MQGET(PCF delete queue response)",
-                completionCode: compCode,
-                reasonCode: reason
-            )
+            try self.sendPCFClearQueue(on: connection, queueName: queueName)
+            return Int(queueInfo.currentDepth)
         }
-
-        // Parse the PCF response header to check for errors
-        let responseData = Data(buffer.prefix(Int(dataLength)))
-        try validatePCFResponse(data: responseData, operation: "Delete queue")
     }
 
-    // MARK: - Queue Purge Operations
+    /// Send a PCF MQCMD_CLEAR_Q command to remove every message from a queue
+    /// - Parameters:
+    ///   - connection: Connection whose PCF session sends the command
+    ///   - queueName: Name of the queue to clear
+    /// - Throws: MQError if the PCF command fails
+    nonisolated private func sendPCFClearQueue(on connection: MQConnection, queueName: String) throws {
+        var command = PCFCommand(command: MQCMD_CLEAR_Q)
 
-    /// Purge all messages from a queue using destructive MQGET
-    /// This method reads and discards all messages in the queue
-    /// - Parameter queueName: Name of the queue to purge
-    /// - Returns: Number of messages purged
-    /// - Throws: MQError if purging fails
-    public func purgeQueue(queueName: String) async throws -> Int {
-        guard isConnected else {
-            throw MQError.notConnected
+        // Add MQCA_Q_NAME parameter (string parameter for queue name)
+        command.appendString(parameter: MQCA_Q_NAME, value: queueName, length: Int(MQ_Q_NAME_LENGTH))
+
+        // Send the PCF command and check the response for errors
+        try executePCFCommand(command, on: connection, waitInterval: 30000) { response in // 30 second timeout for admin commands
+            try validatePCFResponse(response, operation: "Clear queue")
         }
+    }
 
-        // Validate queue name
-        guard !queueName.isEmpty else {
-            throw MQError.invalidConfiguration(message: "Queue name cannot be empty")
+    /// Drain a queue with batched destructive MQGETs on up to options.parallelism leased connections
+    /// - Parameters:
+    ///   - queueName: Name of the queue to drain
+    ///   - pool: Pool to lease the connections from
+    ///   - options: Batch size and parallelism
+    ///   - progress: Called with the total number of messages removed after every commit
+    /// - Returns: Number of messages removed
+    /// - Throws: MQError if a batch fails
+    private func drainQueue(
+        queueName: String,
+        pool: MQConnectionPool,
+        options: PurgeOptions,
+        progress: (@MainActor (Int) -> Void)?
+    ) async throws -> PurgeResult {
+        let tally = PurgeTally(progress: progress)
+        let workerCount = min(options.parallelism, pool.configuration.maximumConnections)
+
+        let drainedCount = try await withThrowingTaskGroup(of: Bool.self) { group in
+            for _ in 0..<workerCount {
+                group.addTask {
+                    try await self.drainQueueWorker(queueName: queueName, pool: pool, batchSize: options.batchSize, tally: tally)
+                }
+            }
+            return try await group.reduce(0) { count, isDrained in isDrained ? count + 1 : count }
         }
 
-        // Open queue for destructive input
-        var objectHandle = try openQueue(
-            queueName: queueName,
-            options: MQOO_INPUT_SHARED | MQOO_FAIL_IF_QUIESCING
+        return PurgeResult(
+            removedCount: tally.removedCount,
+            strategy: .destructiveGet,
+            wasCancelled: drainedCount == 0
         )
+    }
 
-        defer {
-            closeQueue(&objectHandle)
+    /// Remove batches of messages on one leased connection until the queue is empty
+    /// - Parameters:
+    ///   - queueName: Name of the queue to drain
+    ///   - pool: Pool to lease the connection from
+    ///   - batchSize: Messages removed per unit of work
+    ///   - tally: Running total shared by the workers of one purge
+    /// - Returns: true if the queue was found empty, false if the task was cancelled first
+    /// - Throws: MQError if a batch fails
+    private func drainQueueWorker(
+        queueName: String,
+        pool: MQConnectionPool,
+        batchSize: Int,
+        tally: PurgeTally
+    ) async throws -> Bool {
+        return try await pool.withLease { connection in
+            var isQueueEmpty = false
+            while !isQueueEmpty && !Task.isCancelled {
+                let batch = try await connection.perform { connection in
+                    // Destructive input handle, reused if the connection has one open
+                    try connection.withQueue(queueName: queueName, options: MQOO_INPUT_SHARED | MQOO_FAIL_IF_QUIESCING) { objectHandle in
+                        try self.performPurgeBatch(
+                            on: connection,
+                            objectHandle: objectHandle,
+                            queueName: queueName,
+                            batchSize: batchSize
+                        )
+                    }
+                }
+                tally.add(batch.removedCount)
+                isQueueEmpty = batch.isQueueEmpty
+            }
+            return isQueueEmpty
         }
-
-        return try performPurgeQueue(objectHandle: objectHandle, queueName: queueName)
     }
 
-    /// Perform the destructive MQGET loop to purge all messages
+    /// Destructively get up to batchSize messages in one unit of work (runs on the connection thread)
+    /// The messages are committed together, or backed out together if a get fails
     /// - Parameters:
+    ///   - connection: Connection the queue was opened on
     ///   - objectHandle: Handle to the open queue
     ///   - queueName: Name of the queue (for error messages)
-    /// - Returns: Number of messages purged
-    /// - Throws: MQError if purging fails
-    private func performPurgeQueue(objectHandle: MQHOBJ, queueName: String) throws -> Int {
+    ///   - batchSize: Maximum number of messages to get
+    /// - Returns: Number of messages committed, and whether the queue ran out of messages
+    /// - Throws: MQError if a get or the commit fails
+    nonisolated private func performPurgeBatch(
+        on connection: MQConnection,
+        objectHandle: MQHOBJ,
+        queueName: String,
+        batchSize: Int
+    ) throws -> (removedCount: Int, isQueueEmpty: Bool) {
         var compCode: MQLONG = MQCC_OK
         var reason: MQLONG = MQRC_NONE
-        var purgedCount = 0
+        var removedCount = 0
+        var isQueueEmpty = false
 
         // Small buffer - we don't need the actual message content
         // We just need to destructively read each message
         var buffer = [UInt8](repeating: 0, count: 1)
 
-        while true {
-            // Initialize message descriptor for each MQGET call
-            var messageDescriptor = MQMD()
-            messageDescriptor.Version = MQMD_VERSION_2
+        // Get message options are not changed by MQGET, so one set serves the batch
+        var getOptions = MQGMO.template
+        // Use SYNCPOINT so the batch costs one commit, ACCEPT_TRUNCATED_MSG since we don't care about content
+        getOptions.Options = MQGMO_SYNCPOINT | MQGMO_ACCEPT_TRUNCATED_MSG | MQGMO_FAIL_IF_QUIESCING
+        getOptions.WaitInterval = 0 // No wait - return immediately if no message
+        getOptions.MatchOptions = MQMO_NONE
 
-            // Initialize get message options
-            var getOptions = MQGMO()
-            getOptions.Version = MQGMO_VERSION_2
-            // Use NO_SYNCPOINT for immediate removal, ACCEPT_TRUNCATED_MSG since we don't care about content
-            getOptions.Options = MQGMO_NO_SYNCPOINT | MQGMO_ACCEPT_TRUNCATED_MSG | MQGMO_FAIL_IF_QUIESCING
-            getOptions.WaitInterval = 0 // No wait - return immediately if no message
-            getOptions.MatchOptions = MQMO_NONE
+        while removedCount < batchSize {
+            // Initialize message descriptor for each MQGET call
+            var messageDescriptor = MQMD.template
 
             var dataLength: MQLONG = 0
 
             // Call MQGET to destructively read the message
+            let call = MQInstrumentation.shared.begin(.get)
             MQGET(
-                connectionHandle,
+                connection.handle,
                 objectHandle,
                 &messageDescriptor,
                 &getOptions,
@@ -1871,21 +2013,30 @@ public final class MQService: MQServiceProtocol {
                 &compCode,
                 &reason
             )
+            MQInstrumentation.shared.end(
+                call,
+                .get,
+                connection: connection.handle,
+                queue: queueName,
+                bytes: min(Int(dataLength), buffer.count),
+                compCode: compCode,
+                reason: reason
+            )
 
             // Check for no more messages
             if reason == MQRC_NO_MSG_AVAILABLE {
+                isQueueEmpty = true
                 break
             }
 
-            // Handle truncation - this is expected since our buffer is minimal
-            if compCode == MQCC_WARNING && reason == MQRC_TRUNCATED_MSG_ACCEPTED {
-                // Message was successfully removed, just truncated in buffer
-                purgedCount += 1
-                continue
+            // The queue manager's MAXUMSGS is smaller than the batch; commit what we have
+            if reason == MQError.MQRC_SYNCPOINT_LIMIT_REACHED && removedCount > 0 {
+                break
             }
 
-            // Check for other errors
+            // Truncation is expected since our buffer is minimal; anything else failing undoes the batch
             if compCode == MQCC_FAILED {
+                connection.backOut()
                 throw MQError.operationFailed(
                     operation: "MQGET(purge \(queueName))",
                     completionCode: compCode,
@@ -1893,11 +2044,15 @@ public final class MQService: MQServiceProtocol {
                 )
             }
 
-            // Message successfully removed
-            purgedCount += 1
+            // Message removed once the unit of work is committed
+            removedCount += 1
         }
 
-        return purgedCount
+        if removedCount > 0 {
+            try connection.commit()
+        }
+
+        return (removedCount, isQueueEmpty)
     }
 
     // MARK: - Message Send Operations
@@ -1922,131 +2077,392 @@ public final class MQService: MQServiceProtocol {
         persistence: MQMessagePersistence = .asQueueDef,
         priority: Int32? = nil
     ) async throws -> [UInt8] {
-        guard isConnected else {
-            throw MQError.notConnected
-        }
+        let pool = try getConnectionPool()
 
         // Validate queue name
         guard !queueName.isEmpty else {
             throw MQError.invalidConfiguration(message: "Queue name cannot be empty")
         }
 
-        // Open queue for output
-        var objectHandle = try openQueue(
-            queueName: queueName,
-            options: MQOO_OUTPUT | MQOO_FAIL_IF_QUIESCING
-        )
+        return try await withLeasedConnection(from: pool) { connection in
+            // Output handle, reused if the connection has one open
+            try connection.withQueue(queueName: queueName, options: MQOO_OUTPUT | MQOO_FAIL_IF_QUIESCING) { objectHandle in
+                var template = MessageDescriptorTemplate()
+                var messageDescriptor = template.descriptor(
+                    messageType: messageType,
+                    persistence: persistence,
+                    priority: priority,
+                    correlationId: correlationId,
+                    replyToQueue: replyToQueue
+                )
 
-        defer {
-            closeQueue(&objectHandle)
+                // Initialize put message options
+                var putOptions = MQPMO.template
+                putOptions.Options = MQPMO_NO_SYNCPOINT | MQPMO_NEW_MSG_ID
+
+                return try self.performPutMessage(
+                    on: connection,
+                    objectHandle: objectHandle,
+                    queueName: queueName,
+                    messageDescriptor: &messageDescriptor,
+                    putOptions: &putOptions,
+                    payload: payload
+                )
+            }
         }
-
-        return try performSendMessage(
-            objectHandle: objectHandle,
-            queueName: queueName,
-            payload: payload,
-            correlationId: correlationId,
-            replyToQueue: replyToQueue,
-            messageType: messageType,
-            persistence: persistence,
-            priority: priority
-        )
     }
 
-    /// Perform the actual MQPUT operation
+    /// How MQPUT waits for the queue manager in sendMessages(queueName:batch:commitInterval:responseMode:progress:)
+    public enum PutResponseMode: String, Sendable, CaseIterable {
+        /// Every put waits for the queue manager's reply (MQPMO_SYNC_RESPONSE)
+        case synchronous
+        /// Puts return at once and failures are collected with MQSTAT when the
+        /// batch ends (MQPMO_ASYNC_RESPONSE); meant for non-persistent messages
+        /// over high-latency client channels
+        case asynchronous
+
+        /// MQPMO_* response option for this mode
+        var putOption: MQLONG {
+            switch self {
+            case .synchronous:
+                return MQPMO_SYNC_RESPONSE
+            case .asynchronous:
+                return MQPMO_ASYNC_RESPONSE
+            }
+        }
+    }
+
+    /// Outcome of the asynchronous puts of one batch, as reported by MQSTAT
+    public struct AsyncPutStatus: Sendable {
+        /// Puts that succeeded
+        public let successCount: Int
+        /// Puts that succeeded with a warning
+        public let warningCount: Int
+        /// Puts that failed
+        public let failureCount: Int
+        /// First failure or warning, nil if every put succeeded
+        public let firstError: MQError?
+
+        public init(successCount: Int, warningCount: Int, failureCount: Int, firstError: MQError? = nil) {
+            self.successCount = successCount
+            self.warningCount = warningCount
+            self.failureCount = failureCount
+            self.firstError = firstError
+        }
+
+        /// Read the counts of an MQSTS returned by MQSTAT
+        /// - Parameters:
+        ///   - status: Status information for asynchronous errors
+        ///   - queueName: Name of the queue (for error messages)
+        init(status: MQSTS, queueName: String) {
+            self.successCount = Int(status.PutSuccessCount)
+            self.warningCount = Int(status.PutWarningCount)
+            self.failureCount = Int(status.PutFailureCount)
+            self.firstError = status.CompCode == MQCC_OK ? nil : MQError.operationFailed(
+                operation: "MQPUT(async \(queueName))",
+                completionCode: status.CompCode,
+                reasonCode: status.Reason
+            )
+        }
+    }
+
+    /// A message to send with sendMessages(queueName:batch:commitInterval:responseMode:progress:)
+    public struct OutgoingMessage: Sendable {
+        public let payload: Data
+        public let correlationId: [UInt8]?
+        public let replyToQueue: String?
+        public let messageType: MQMessageType
+        public let persistence: MQMessagePersistence
+        public let priority: Int32?
+
+        public init(
+            payload: Data,
+            correlationId: [UInt8]? = nil,
+            replyToQueue: String? = nil,
+            messageType: MQMessageType = .datagram,
+            persistence: MQMessagePersistence = .asQueueDef,
+            priority: Int32? = nil
+        ) {
+            self.payload = payload
+            self.correlationId = correlationId
+            self.replyToQueue = replyToQueue
+            self.messageType = messageType
+            self.persistence = persistence
+            self.priority = priority
+        }
+    }
+
+    /// Outcome of one unit of work of sendMessages(queueName:batch:commitInterval:responseMode:progress:)
+    public struct SendBatchResult: Sendable {
+        /// Index in the sent messages of the batch's first message
+        public let startIndex: Int
+        /// Number of messages the batch tried to put
+        public let messageCount: Int
+        /// MsgIds of the committed messages in order; empty if the batch was backed out
+        public let messageIds: [[UInt8]]
+        /// Time from the first MQPUT to the end of the MQCMIT or MQBACK
+        public let duration: TimeInterval
+        /// Why the batch was backed out, nil if it was committed
+        public let error: MQError?
+        /// Aggregated outcome of the puts in asynchronous response mode, nil otherwise
+        public let asyncStatus: AsyncPutStatus?
+
+        public init(
+            startIndex: Int,
+            messageCount: Int,
+            messageIds: [[UInt8]],
+            duration: TimeInterval,
+            error: MQError? = nil,
+            asyncStatus: AsyncPutStatus? = nil
+        ) {
+            self.startIndex = startIndex
+            self.messageCount = messageCount
+            self.messageIds = messageIds
+            self.duration = duration
+            self.error = error
+            self.asyncStatus = asyncStatus
+        }
+
+        /// Whether every message of the batch was committed
+        public var isCommitted: Bool {
+            return error == nil
+        }
+    }
+
+    /// Send a sequence of messages to a queue, committing every commitInterval messages
+    /// The queue is opened once and the messages are put under syncpoint, so
+    /// each batch costs one MQCMIT instead of an MQOPEN/MQPUT/MQCLOSE per message.
+    /// A batch whose put or commit fails is backed out and ends the send, as
+    /// does cancelling the calling task; batches already committed stay on the queue.
+    /// In asynchronous response mode the puts do not wait for the queue manager;
+    /// MQSTAT collects their failures before the commit, and a batch with any
+    /// failed put is backed out.
     /// - Parameters:
-    ///   - objectHandle: Handle to the open queue
-    ///   - queueName: Name of the queue (for error messages)
-    ///   - payload: Message payload as Data
-    ///   - correlationId: Optional correlation ID
-    ///   - replyToQueue: Optional reply-to queue name
-    ///   - messageType: Type of message
-    ///   - persistence: Message persistence setting
-    ///   - priority: Optional message priority
-    /// - Returns: The message ID assigned to the sent message
-    /// - Throws: MQError if MQPUT fails
-    private func performSendMessage(
-        objectHandle: MQHOBJ,
+    ///   - queueName: Name of the queue to send to
+    ///   - messages: Messages to put, in order
+    ///   - commitInterval: Messages per unit of work (at least 1)
+    ///   - responseMode: Whether puts wait for the queue manager's reply
+    ///   - progress: Called with the result of every batch as it completes
+    /// - Returns: Result of every batch attempted, in order
+    /// - Throws: MQError if not connected or the queue cannot be opened
+    public func sendMessages(
         queueName: String,
-        payload: Data,
-        correlationId: [UInt8]?,
-        replyToQueue: String?,
-        messageType: MQMessageType,
-        persistence: MQMessagePersistence,
-        priority: Int32?
-    ) throws -> [UInt8] {
-        var compCode: MQLONG = MQCC_OK
-        var reason: MQLONG = MQRC_NONE
+        batch messages: [OutgoingMessage],
+        commitInterval: Int = 100,
+        responseMode: PutResponseMode = .synchronous,
+        progress: (@MainActor (SendBatchResult) -> Void)? = nil
+    ) async throws -> [SendBatchResult] {
+        let pool = try getConnectionPool()
 
-        // Initialize message descriptor
-        var messageDescriptor = MQMD()
-        messageDescriptor.Version = MQMD_VERSION_2
-
-        // Set format to MQSTR (string) for text messages
-        // Format is an 8-character field: "MQSTR   "
-        let formatChars: (MQCHAR, MQCHAR, MQCHAR, MQCHAR, MQCHAR, MQCHAR, MQCHAR, MQCHAR) = (
-            MQCHAR(0x4D), MQCHAR(0x51), MQCHAR(0x53), MQCHAR(0x54),
-            MQCHAR(0x52), MQCHAR(0x20), MQCHAR(0x20), MQCHAR(0x20)
-        )  // "MQSTR   "
-        messageDescriptor.Format = formatChars
-
-        // Set message type
-        messageDescriptor.MsgType = messageType.mqValue
-
-        // Set persistence
-        messageDescriptor.Persistence = persistence.rawValue
-
-        // Set priority (-1 means use queue default per MQPRI_PRIORITY_AS_Q_DEF)
-        if let priority = priority {
-            messageDescriptor.Priority = priority
-        } else {
-            messageDescriptor.Priority = -1 // MQPRI_PRIORITY_AS_Q_DEF
-        }
-
-        // Set correlation ID if provided
-        if let correlationId = correlationId {
-            withUnsafeMutablePointer(to: &messageDescriptor.CorrelId) { ptr in
-                let bound = ptr.withMemoryRebound(to: UInt8.self, capacity: Int(MQ_CORREL_ID_LENGTH)) { $0 }
-                for i in 0..<Int(MQ_CORREL_ID_LENGTH) {
-                    if i < correlationId.count {
-                        bound[i] = correlationId[i]
-                    } else {
-                        bound[i] = 0x00
+        // Validate queue name
+        guard !queueName.isEmpty else {
+            throw MQError.invalidConfiguration(message: "Queue name cannot be empty")
+        }
+
+        let batchSize = max(commitInterval, 1)
+
+        return try await pool.withLease { connection in
+            var results: [SendBatchResult] = []
+            // One template for the whole send; its reply-to conversion carries over between batches
+            var template = MessageDescriptorTemplate()
+            var startIndex = 0
+
+            while startIndex < messages.count && !Task.isCancelled {
+                let batchRange = startIndex..<min(startIndex + batchSize, messages.count)
+                let (result, usedTemplate) = try await connection.perform { [template] connection in
+                    var template = template
+                    // Output handle opened once and reused by every batch
+                    let result = try connection.withQueue(queueName: queueName, options: MQOO_OUTPUT | MQOO_FAIL_IF_QUIESCING) { objectHandle in
+                        self.performPutBatch(
+                            on: connection,
+                            objectHandle: objectHandle,
+                            queueName: queueName,
+                            messages: messages[batchRange],
+                            startIndex: batchRange.lowerBound,
+                            responseMode: responseMode,
+                            template: &template
+                        )
                     }
+                    return (result, template)
+                }
+                template = usedTemplate
+
+                results.append(result)
+                progress?(result)
+
+                guard result.isCommitted else {
+                    // Treat a lost connection like any failure here: the pool sees it on the next lease
+                    break
                 }
+                startIndex = batchRange.upperBound
             }
+
+            return results
+        }
+    }
+
+    /// Put a batch of messages in one unit of work (runs on the connection thread)
+    /// The messages are committed together, or backed out together if a put fails
+    /// - Parameters:
+    ///   - connection: Connection the queue was opened on
+    ///   - objectHandle: Handle to the open queue
+    ///   - queueName: Name of the queue (for error messages)
+    ///   - messages: Messages of the batch
+    ///   - startIndex: Index of the first message in the whole send
+    ///   - responseMode: Whether puts wait for the queue manager's reply
+    ///   - template: Descriptor template shared by the whole send
+    /// - Returns: MsgIds of the committed messages, or the error that backed the batch out
+    nonisolated private func performPutBatch(
+        on connection: MQConnection,
+        objectHandle: MQHOBJ,
+        queueName: String,
+        messages: ArraySlice<OutgoingMessage>,
+        startIndex: Int,
+        responseMode: PutResponseMode,
+        template: inout MessageDescriptorTemplate
+    ) -> SendBatchResult {
+        // Initialize put message options, shared by every put of the batch
+        var putOptions = MQPMO.template
+        putOptions.Options = MQPMO_SYNCPOINT | MQPMO_NEW_MSG_ID | MQPMO_FAIL_IF_QUIESCING | responseMode.putOption
+
+        return performPutUnitOfWork(
+            on: connection,
+            objectHandle: objectHandle,
+            queueName: queueName,
+            messageCount: messages.count,
+            startIndex: startIndex,
+            responseMode: responseMode,
+            putOptions: &putOptions
+        ) { offset in
+            let message = messages[messages.startIndex + offset]
+            let messageDescriptor = template.descriptor(
+                messageType: message.messageType,
+                persistence: message.persistence,
+                priority: message.priority,
+                correlationId: message.correlationId,
+                replyToQueue: message.replyToQueue
+            )
+            return (messageDescriptor, message.payload)
         }
+    }
+
+    /// Put messages in one unit of work and commit it (runs on the connection thread)
+    /// The messages are committed together, or backed out together if a put fails
+    /// - Parameters:
+    ///   - connection: Connection the queue was opened on
+    ///   - objectHandle: Handle to the open queue
+    ///   - queueName: Name of the queue (for error messages)
+    ///   - messageCount: Number of messages to put
+    ///   - startIndex: Index of the first message in the whole send
+    ///   - responseMode: Whether puts wait for the queue manager's reply
+    ///   - putOptions: Put message options, including MQPMO_SYNCPOINT
+    ///   - message: Descriptor and payload of the message at an offset in the batch
+    /// - Returns: MsgIds of the committed messages, or the error that backed the batch out
+    nonisolated private func performPutUnitOfWork(
+        on connection: MQConnection,
+        objectHandle: MQHOBJ,
+        queueName: String,
+        messageCount: Int,
+        startIndex: Int,
+        responseMode: PutResponseMode,
+        putOptions: inout MQPMO,
+        message: (Int) -> (descriptor: MQMD, payload: Data)
+    ) -> SendBatchResult {
+        let startTime = Date()
+
+        var messageIds: [[UInt8]] = []
+        messageIds.reserveCapacity(messageCount)
+        var asyncStatus: AsyncPutStatus?
+
+        do {
+            for offset in 0..<messageCount {
+                let next = message(offset)
+                var messageDescriptor = next.descriptor
+                messageIds.append(try performPutMessage(
+                    on: connection,
+                    objectHandle: objectHandle,
+                    queueName: queueName,
+                    messageDescriptor: &messageDescriptor,
+                    putOptions: &putOptions,
+                    payload: next.payload
+                ))
+            }
 
-        // Set reply-to queue if provided
-        if let replyToQueue = replyToQueue, !replyToQueue.isEmpty {
-            let replyToQueueChars = replyToQueue.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH))
-            withUnsafeMutablePointer(to: &messageDescriptor.ReplyToQ) { ptr in
-                let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: Int(MQ_Q_NAME_LENGTH)) { $0 }
-                for i in 0..<Int(MQ_Q_NAME_LENGTH) {
-                    bound[i] = replyToQueueChars[i]
+            // Asynchronous puts only report their failures through MQSTAT
+            if responseMode == .asynchronous {
+                let status = AsyncPutStatus(status: try connection.asyncPutStatus(), queueName: queueName)
+                asyncStatus = status
+                if status.failureCount > 0 {
+                    throw status.firstError ?? .unknown(reasonCode: MQRC_UNEXPECTED_ERROR)
                 }
             }
+
+            try connection.commit()
+        } catch {
+            connection.backOut()
+            return SendBatchResult(
+                startIndex: startIndex,
+                messageCount: messageCount,
+                messageIds: [],
+                duration: Date().timeIntervalSince(startTime),
+                error: (error as? MQError) ?? .unknown(reasonCode: MQRC_UNEXPECTED_ERROR),
+                asyncStatus: asyncStatus
+            )
         }
 
-        // Initialize put message options
-        var putOptions = MQPMO()
-        putOptions.Version = MQPMO_VERSION_2
-        putOptions.Options = MQPMO_NO_SYNCPOINT | MQPMO_NEW_MSG_ID
+        return SendBatchResult(
+            startIndex: startIndex,
+            messageCount: messageCount,
+            messageIds: messageIds,
+            duration: Date().timeIntervalSince(startTime),
+            asyncStatus: asyncStatus
+        )
+    }
 
-        // Prepare message data
-        var messageData = [UInt8](payload)
-        let messageLength = MQLONG(messageData.count)
+    /// Perform the actual MQPUT operation (runs on the connection thread)
+    /// The payload bytes are passed to MQPUT in place, without copying them
+    /// - Parameters:
+    ///   - connection: Connection the queue was opened on
+    ///   - objectHandle: Handle to the open queue
+    ///   - queueName: Name of the queue (for error messages)
+    ///   - messageDescriptor: Descriptor of the message; MQPUT fills in its MsgId
+    ///   - putOptions: Put message options
+    ///   - payload: Message payload as Data
+    /// - Returns: The message ID assigned to the sent message
+    /// - Throws: MQError if MQPUT fails
+    nonisolated private func performPutMessage(
+        on connection: MQConnection,
+        objectHandle: MQHOBJ,
+        queueName: String,
+        messageDescriptor: inout MQMD,
+        putOptions: inout MQPMO,
+        payload: Data
+    ) throws -> [UInt8] {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
 
-        // Call MQPUT to send the message
-        MQPUT(
-            connectionHandle,
-            objectHandle,
-            &messageDescriptor,
-            &putOptions,
-            messageLength,
-            &messageData,
-            &compCode,
-            &reason
+        // MQPUT only reads the buffer, so Data's own storage can be handed over
+        let call = MQInstrumentation.shared.begin(.put)
+        payload.withUnsafeBytes { buffer in
+            MQPUT(
+                connection.handle,
+                objectHandle,
+                &messageDescriptor,
+                &putOptions,
+                MQLONG(buffer.count),
+                UnsafeMutableRawPointer(mutating: buffer.baseAddress),
+                &compCode,
+                &reason
+            )
+        }
+        MQInstrumentation.shared.end(
+            call,
+            .put,
+            connection: connection.handle,
+            queue: queueName,
+            bytes: compCode == MQCC_FAILED ? 0 : payload.count,
+            compCode: compCode,
+            reason: reason
         )
 
         guard compCode != MQCC_FAILED else {
@@ -2058,15 +2474,167 @@ public final class MQService: MQServiceProtocol {
         }
 
         // Extract and return the assigned message ID
-        var messageId = [UInt8](repeating: 0, count: Int(MQ_MSG_ID_LENGTH))
-        withUnsafePointer(to: messageDescriptor.MsgId) { ptr in
-            let bound = ptr.withMemoryRebound(to: UInt8.self, capacity: Int(MQ_MSG_ID_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_MSG_ID_LENGTH) {
-                messageId[i] = bound[i]
+        return MQIField.bytes(of: messageDescriptor.MsgId)
+    }
+
+    // MARK: - Queue Archive Operations
+
+    /// Write every message of a queue to an archive file, as dmpmqmsg does
+    /// The queue is browsed without data conversion, so each message's MQMD and
+    /// payload are stored exactly as they are on the queue. Records are written
+    /// block by block as the browse cursor returns them, so memory use does not
+    /// grow with the queue. A dump that fails or is cancelled removes the file.
+    /// See QueueArchive for the file layout
+    /// - Parameters:
+    ///   - queueName: Name of the queue to dump
+    ///   - url: File to write; replaced if it exists
+    ///   - compressed: Whether blocks are LZFSE-compressed
+    ///   - progress: Called with the number of messages written after every block of reads
+    /// - Returns: Number of messages written
+    /// - Throws: MQError if not connected or browsing fails, or a file error
+    public func dumpQueue(
+        queueName: String,
+        to url: URL,
+        compressed: Bool = true,
+        progress: (@MainActor (Int) -> Void)? = nil
+    ) async throws -> Int {
+        let pool = try getConnectionPool()
+
+        // Validate queue name
+        guard !queueName.isEmpty else {
+            throw MQError.invalidConfiguration(message: "Queue name cannot be empty")
+        }
+
+        // Messages are at most 100 MB (MAXMSGL); the cursor's buffer only grows as far as needed
+        let maxMessageSize = 100 * 1024 * 1024
+        let messagesPerRead = 1000
+
+        return try await pool.withLease { connection in
+            let (cursor, writer) = try await connection.perform { connection in
+                let cursor = try BrowseCursor(
+                    connectionHandle: connection.handle,
+                    queueName: queueName,
+                    maxMessageSize: maxMessageSize,
+                    convertsData: false
+                )
+                return (cursor, try QueueArchiveWriter(url: url, compressed: compressed))
             }
+
+            do {
+                var messageCount = 0
+                while true {
+                    try Task.checkCancellation()
+
+                    // Browsing and writing both run on the connection thread, off the main actor
+                    let readCount = try await connection.perform { _ in
+                        let records = try cursor.nextRecords(maxMessages: messagesPerRead)
+                        for record in records {
+                            try writer.append(record)
+                        }
+                        return records.count
+                    }
+                    guard readCount > 0 else { break }
+
+                    messageCount += readCount
+                    progress?(messageCount)
+                }
+
+                try await connection.perform { _ in
+                    cursor.close()
+                    try writer.finish()
+                }
+                return messageCount
+            } catch {
+                connection.execute { _ in
+                    cursor.close()
+                }
+                try? FileManager.default.removeItem(at: url)
+                throw error
+            }
+        }
+    }
+
+    /// Put every message of an archive file to a queue, committing every commitInterval messages
+    /// Blocks are read one at a time and put through the same units of work as
+    /// sendMessages(queueName:batch:commitInterval:responseMode:progress:). Each
+    /// message keeps its archived MsgId and CorrelId. With restoresContext its
+    /// identity and origin context are restored too (MQPMO_SET_ALL_CONTEXT,
+    /// which needs set-all-context authority on the queue); otherwise the
+    /// queue manager sets them. A batch that fails is backed out and ends the
+    /// load, as does cancelling the calling task
+    /// - Parameters:
+    ///   - queueName: Name of the queue to load
+    ///   - url: Archive written by dumpQueue(queueName:to:compressed:progress:)
+    ///   - commitInterval: Messages per unit of work (at least 1)
+    ///   - restoresContext: Whether the archived context fields are put as well
+    ///   - progress: Called with the result of every batch as it completes
+    /// - Returns: Result of every batch attempted, in order
+    /// - Throws: MQError if not connected, the file is not an archive or the queue cannot be opened
+    public func loadQueue(
+        queueName: String,
+        from url: URL,
+        commitInterval: Int = 100,
+        restoresContext: Bool = true,
+        progress: (@MainActor (SendBatchResult) -> Void)? = nil
+    ) async throws -> [SendBatchResult] {
+        let pool = try getConnectionPool()
+
+        // Validate queue name
+        guard !queueName.isEmpty else {
+            throw MQError.invalidConfiguration(message: "Queue name cannot be empty")
         }
 
-        return messageId
+        let reader = try QueueArchiveReader(url: url)
+        let batchSize = max(commitInterval, 1)
+        let openOptions = MQOO_OUTPUT | MQOO_FAIL_IF_QUIESCING | (restoresContext ? MQOO_SET_ALL_CONTEXT : 0)
+        let contextOption = restoresContext ? MQPMO_SET_ALL_CONTEXT : MQPMO_DEFAULT_CONTEXT
+
+        return try await pool.withLease { connection in
+            var results: [SendBatchResult] = []
+            var blockStart = 0
+
+            blocks: for block in reader.blocks.indices {
+                let records = try await connection.perform { _ in
+                    try reader.records(inBlock: block)
+                }
+
+                var batchStart = 0
+                while batchStart < records.count {
+                    guard !Task.isCancelled else { break blocks }
+
+                    let batchRange = batchStart..<min(batchStart + batchSize, records.count)
+                    let result = try await connection.perform { connection in
+                        try connection.withQueue(queueName: queueName, options: openOptions) { objectHandle in
+                            // No MQPMO_NEW_MSG_ID: every message is put with its archived MsgId
+                            var putOptions = MQPMO.template
+                            putOptions.Options = MQPMO_SYNCPOINT | MQPMO_FAIL_IF_QUIESCING | contextOption
+
+                            return self.performPutUnitOfWork(
+                                on: connection,
+                                objectHandle: objectHandle,
+                                queueName: queueName,
+                                messageCount: batchRange.count,
+                                startIndex: blockStart + batchRange.lowerBound,
+                                responseMode: .synchronous,
+                                putOptions: &putOptions
+                            ) { offset in
+                                let record = records[batchRange.lowerBound + offset]
+                                return (record.descriptor, record.payload)
+                            }
+                        }
+                    }
+
+                    results.append(result)
+                    progress?(result)
+
+                    guard result.isCommitted else { break blocks }
+                    batchStart = batchRange.upperBound
+                }
+                blockStart += records.count
+            }
+
+            return results
+        }
     }
 
     // MARK: - Message Delete Operations
@@ -2077,9 +2645,7 @@ public final class MQService: MQServiceProtocol {
     ///   - messageId: The message ID of the message to delete (24 bytes)
     /// - Throws: MQError if deletion fails or message not found
     public func deleteMessage(queueName: String, messageId: [UInt8]) async throws {
-        guard isConnected else {
-            throw MQError.notConnected
-        }
+        let pool = try getConnectionPool()
 
         // Validate queue name
         guard !queueName.isEmpty else {
@@ -2091,30 +2657,28 @@ public final class MQService: MQServiceProtocol {
             throw MQError.invalidConfiguration(message: "Message ID cannot be empty")
         }
 
-        // Open queue for destructive input
-        var objectHandle = try openQueue(
-            queueName: queueName,
-            options: MQOO_INPUT_SHARED | MQOO_FAIL_IF_QUIESCING
-        )
-
-        defer {
-            closeQueue(&objectHandle)
+        try await withLeasedConnection(from: pool) { connection in
+            // Destructive input handle, shared with purges on the same connection
+            try connection.withQueue(queueName: queueName, options: MQOO_INPUT_SHARED | MQOO_FAIL_IF_QUIESCING) { objectHandle in
+                try self.performDeleteMessage(
+                    on: connection,
+                    objectHandle: objectHandle,
+                    queueName: queueName,
+                    messageId: messageId
+                )
+            }
         }
-
-        try performDeleteMessage(
-            objectHandle: objectHandle,
-            queueName: queueName,
-            messageId: messageId
-        )
     }
 
-    /// Perform the destructive MQGET with message ID matching
+    /// Perform the destructive MQGET with message ID matching (runs on the connection thread)
     /// - Parameters:
+    ///   - connection: Connection the queue was opened on
     ///   - objectHandle: Handle to the open queue
     ///   - queueName: Name of the queue (for error messages)
     ///   - messageId: The message ID to match
     /// - Throws: MQError if deletion fails or message not found
-    private func performDeleteMessage(
+    nonisolated private func performDeleteMessage(
+        on connection: MQConnection,
         objectHandle: MQHOBJ,
         queueName: String,
         messageId: [UInt8]
@@ -2123,25 +2687,13 @@ public final class MQService: MQServiceProtocol {
         var reason: MQLONG = MQRC_NONE
 
         // Initialize message descriptor
-        var messageDescriptor = MQMD()
-        messageDescriptor.Version = MQMD_VERSION_2
+        var messageDescriptor = MQMD.template
 
         // Set the message ID to match
-        // Pad or truncate to exactly MQ_MSG_ID_LENGTH (24 bytes)
-        withUnsafeMutablePointer(to: &messageDescriptor.MsgId) { ptr in
-            let bound = ptr.withMemoryRebound(to: UInt8.self, capacity: Int(MQ_MSG_ID_LENGTH)) { $0 }
-            for i in 0..<Int(MQ_MSG_ID_LENGTH) {
-                if i < messageId.count {
-                    bound[i] = messageId[i]
-                } else {
-                    bound[i] = 0x00
-                }
-            }
-        }
+        MQIField.setBytes(messageId, in: &messageDescriptor.MsgId)
 
         // Initialize get message options
-        var getOptions = MQGMO()
-        getOptions.Version = MQGMO_VERSION_2
+        var getOptions = MQGMO.template
         // Use NO_SYNCPOINT for immediate removal, ACCEPT_TRUNCATED_MSG since we don't care about content
         getOptions.Options = MQGMO_NO_SYNCPOINT | MQGMO_ACCEPT_TRUNCATED_MSG | MQGMO_FAIL_IF_QUIESCING
         getOptions.WaitInterval = 0 // No wait - return immediately if no message
@@ -2153,8 +2705,9 @@ public final class MQService: MQServiceProtocol {
         var dataLength: MQLONG = 0
 
         // Call MQGET to destructively read the message
+        let call = MQInstrumentation.shared.begin(.get)
         MQGET(
-            connectionHandle,
+            connection.handle,
             objectHandle,
             &messageDescriptor,
             &getOptions,
@@ -2164,6 +2717,15 @@ public final class MQService: MQServiceProtocol {
             &compCode,
             &reason
         )
+        MQInstrumentation.shared.end(
+            call,
+            .get,
+            connection: connection.handle,
+            queue: queueName,
+            bytes: min(Int(dataLength), buffer.count),
+            compCode: compCode,
+            reason: reason
+        )
 
         // Check for message not found
         if reason == MQRC_NO_MSG_AVAILABLE {
@@ -2191,6 +2753,456 @@ public final class MQService: MQServiceProtocol {
 
         // Message successfully removed
     }
+
+    // MARK: - Bulk Message Operations
+
+    /// What processMessages(queueName:messageIds:action:commitInterval:progress:) does with each message
+    public enum BulkMessageAction: Sendable, Equatable {
+        /// Remove the messages
+        case delete
+        /// Put the messages to another queue and remove them, keeping MsgId and context
+        case move(toQueue: String)
+        /// Put copies of the messages to another queue, keeping MsgId; the originals stay
+        case copy(toQueue: String)
+
+        /// Queue the messages are put to, nil for a delete
+        public var targetQueue: String? {
+            switch self {
+            case .delete:
+                return nil
+            case .move(let queueName), .copy(let queueName):
+                return queueName
+            }
+        }
+
+        /// Whether the messages leave the source queue
+        public var removesMessages: Bool {
+            switch self {
+            case .delete, .move:
+                return true
+            case .copy:
+                return false
+            }
+        }
+
+        /// Open options of the source queue; a move saves the context it passes on
+        var sourceOpenOptions: MQLONG {
+            switch self {
+            case .delete:
+                return MQOO_INPUT_SHARED | MQOO_FAIL_IF_QUIESCING
+            case .move:
+                return MQOO_INPUT_SHARED | MQOO_SAVE_ALL_CONTEXT | MQOO_FAIL_IF_QUIESCING
+            case .copy:
+                return MQOO_BROWSE | MQOO_FAIL_IF_QUIESCING
+            }
+        }
+
+        /// Open options of the target queue
+        var targetOpenOptions: MQLONG {
+            switch self {
+            case .move:
+                return MQOO_OUTPUT | MQOO_PASS_ALL_CONTEXT | MQOO_FAIL_IF_QUIESCING
+            case .delete, .copy:
+                return MQOO_OUTPUT | MQOO_FAIL_IF_QUIESCING
+            }
+        }
+    }
+
+    /// Outcome of one unit of work of a bulk message operation
+    public struct BulkBatchResult: Sendable, Equatable {
+        /// Index in the whole operation of the batch's first MsgId
+        public let startIndex: Int
+        /// Number of MsgIds in the batch
+        public let messageCount: Int
+        /// MsgIds of the messages deleted, moved or copied; empty if the batch was backed out
+        public let processedIds: [[UInt8]]
+        /// MsgIds no longer on the queue, e.g. consumed since they were browsed
+        public let missingIds: [[UInt8]]
+        /// Time the gets, puts and commit took
+        public let duration: TimeInterval
+        /// Why the batch was backed out, nil if it was committed
+        public let error: MQError?
+
+        public init(
+            startIndex: Int,
+            messageCount: Int,
+            processedIds: [[UInt8]],
+            missingIds: [[UInt8]] = [],
+            duration: TimeInterval,
+            error: MQError? = nil
+        ) {
+            self.startIndex = startIndex
+            self.messageCount = messageCount
+            self.processedIds = processedIds
+            self.missingIds = missingIds
+            self.duration = duration
+            self.error = error
+        }
+
+        /// Whether every message of the batch was committed
+        public var isCommitted: Bool {
+            return error == nil
+        }
+    }
+
+    /// Delete, move or copy a set of messages by MsgId, committing every commitInterval messages
+    /// Source and target queue are opened once for the whole operation. Each
+    /// batch gets its messages by MsgId and puts them to the target under
+    /// syncpoint, then commits, so a batch costs one MQGET (and MQPUT) per
+    /// message plus one MQCMIT, and a move never loses or duplicates a message.
+    /// Moved messages keep their MsgId, CorrelId and all context
+    /// (MQPMO_PASS_ALL_CONTEXT, which needs pass-all-context authority on the
+    /// target); copies keep MsgId and CorrelId and get new context. MsgIds no
+    /// longer on the queue are reported as missing rather than failing the
+    /// batch. A batch that fails is backed out and ends the operation, as does
+    /// cancelling the calling task; batches already committed stay done.
+    /// - Parameters:
+    ///   - queueName: Name of the queue holding the messages
+    ///   - messageIds: MsgIds of the messages, in the order they are handled
+    ///   - action: Whether the messages are deleted, moved or copied
+    ///   - commitInterval: Messages per unit of work (at least 1)
+    ///   - progress: Called with the result of every batch as it completes
+    /// - Returns: Result of every batch attempted, in order
+    /// - Throws: MQError if not connected, the target is the source or a queue cannot be opened
+    public func processMessages(
+        queueName: String,
+        messageIds: [[UInt8]],
+        action: BulkMessageAction,
+        commitInterval: Int = 100,
+        progress: (@MainActor (BulkBatchResult) -> Void)? = nil
+    ) async throws -> [BulkBatchResult] {
+        let pool = try getConnectionPool()
+
+        // Validate queue names
+        guard !queueName.isEmpty else {
+            throw MQError.invalidConfiguration(message: "Queue name cannot be empty")
+        }
+        if let targetQueue = action.targetQueue {
+            guard !targetQueue.isEmpty, targetQueue != queueName else {
+                throw MQError.invalidConfiguration(message: "Target queue must be another queue")
+            }
+        }
+
+        let batchSize = max(commitInterval, 1)
+
+        return try await pool.withLease { connection in
+            // Opened for this operation only: a move passes the context saved on its own source handle
+            let (sourceHandle, targetHandle) = try await connection.perform { connection -> (MQHOBJ, MQHOBJ?) in
+                var sourceHandle = try connection.openQueue(queueName: queueName, options: action.sourceOpenOptions)
+                guard let targetQueue = action.targetQueue else {
+                    return (sourceHandle, nil)
+                }
+                do {
+                    return (sourceHandle, try connection.openQueue(queueName: targetQueue, options: action.targetOpenOptions))
+                } catch {
+                    connection.closeQueue(&sourceHandle)
+                    throw error
+                }
+            }
+            let closeQueues = { (connection: MQConnection) in
+                var sourceHandle = sourceHandle
+                connection.closeQueue(&sourceHandle)
+                if var targetHandle {
+                    connection.closeQueue(&targetHandle)
+                }
+            }
+
+            var results: [BulkBatchResult] = []
+            do {
+                var startIndex = 0
+                while startIndex < messageIds.count && !Task.isCancelled {
+                    let batchRange = startIndex..<min(startIndex + batchSize, messageIds.count)
+                    let result = try await connection.perform { connection in
+                        self.performBulkBatch(
+                            on: connection,
+                            sourceHandle: sourceHandle,
+                            targetHandle: targetHandle,
+                            queueName: queueName,
+                            action: action,
+                            messageIds: messageIds[batchRange],
+                            startIndex: batchRange.lowerBound
+                        )
+                    }
+
+                    results.append(result)
+                    progress?(result)
+
+                    guard result.isCommitted else { break }
+                    startIndex = batchRange.upperBound
+                }
+            } catch {
+                connection.execute(closeQueues)
+                throw error
+            }
+
+            try await connection.perform(closeQueues)
+            return results
+        }
+    }
+
+    /// Get, put and commit one batch of a bulk message operation (runs on the connection thread)
+    /// The batch is committed together, or backed out together if a get or put fails
+    /// - Parameters:
+    ///   - connection: Connection the queues were opened on
+    ///   - sourceHandle: Handle to the source queue
+    ///   - targetHandle: Handle to the target queue, nil for a delete
+    ///   - queueName: Name of the source queue (for error messages)
+    ///   - action: Whether the messages are deleted, moved or copied
+    ///   - messageIds: MsgIds of the batch
+    ///   - startIndex: Index of the batch's first MsgId in the whole operation
+    /// - Returns: MsgIds handled and missing, or the error that backed the batch out
+    nonisolated private func performBulkBatch(
+        on connection: MQConnection,
+        sourceHandle: MQHOBJ,
+        targetHandle: MQHOBJ?,
+        queueName: String,
+        action: BulkMessageAction,
+        messageIds: ArraySlice<[UInt8]>,
+        startIndex: Int
+    ) -> BulkBatchResult {
+        let startTime = Date()
+        var processedIds: [[UInt8]] = []
+        processedIds.reserveCapacity(messageIds.count)
+        var missingIds: [[UInt8]] = []
+
+        // A delete only needs the get to succeed; moves and copies need the whole message
+        var buffer = [UInt8](repeating: 0, count: action.targetQueue == nil ? 1 : 64 * 1024)
+        var getOptions: MQLONG = MQGMO_FAIL_IF_QUIESCING
+        switch action {
+        case .delete:
+            getOptions |= MQGMO_SYNCPOINT | MQGMO_ACCEPT_TRUNCATED_MSG
+        case .move:
+            getOptions |= MQGMO_SYNCPOINT
+        case .copy:
+            getOptions |= MQGMO_BROWSE_FIRST
+        }
+
+        // Put message options, shared by every put of the batch; no MQPMO_NEW_MSG_ID
+        var putOptions = MQPMO.template
+        putOptions.Options = MQPMO_SYNCPOINT | MQPMO_FAIL_IF_QUIESCING
+        if case .move = action {
+            putOptions.Options |= MQPMO_PASS_ALL_CONTEXT
+            putOptions.Context = sourceHandle
+        }
+
+        do {
+            for messageId in messageIds {
+                guard let message = try performMatchedGet(
+                    on: connection,
+                    objectHandle: sourceHandle,
+                    queueName: queueName,
+                    messageId: messageId,
+                    options: getOptions,
+                    buffer: &buffer
+                ) else {
+                    missingIds.append(messageId)
+                    continue
+                }
+
+                if let targetHandle, let targetQueue = action.targetQueue {
+                    var messageDescriptor = message.descriptor
+                    _ = try performPutMessage(
+                        on: connection,
+                        objectHandle: targetHandle,
+                        queueName: targetQueue,
+                        messageDescriptor: &messageDescriptor,
+                        putOptions: &putOptions,
+                        payload: Data(buffer[0..<message.dataLength])
+                    )
+                }
+                processedIds.append(messageId)
+            }
+
+            if !processedIds.isEmpty {
+                try connection.commit()
+            }
+        } catch {
+            connection.backOut()
+            return BulkBatchResult(
+                startIndex: startIndex,
+                messageCount: messageIds.count,
+                processedIds: [],
+                duration: Date().timeIntervalSince(startTime),
+                error: (error as? MQError) ?? .unknown(reasonCode: MQRC_UNEXPECTED_ERROR)
+            )
+        }
+
+        return BulkBatchResult(
+            startIndex: startIndex,
+            messageCount: messageIds.count,
+            processedIds: processedIds,
+            missingIds: missingIds,
+            duration: Date().timeIntervalSince(startTime)
+        )
+    }
+
+    /// Get or browse the message with a MsgId, growing the buffer until the message fits
+    /// - Parameters:
+    ///   - connection: Connection the queue was opened on
+    ///   - objectHandle: Handle to the open queue
+    ///   - queueName: Name of the queue (for error messages)
+    ///   - messageId: The message ID to match
+    ///   - options: Get message options
+    ///   - buffer: Receives the message data; replaced by a larger one if the message does not fit
+    /// - Returns: Descriptor and data length of the message, or nil if no message has the MsgId
+    /// - Throws: MQError if the get fails
+    nonisolated private func performMatchedGet(
+        on connection: MQConnection,
+        objectHandle: MQHOBJ,
+        queueName: String,
+        messageId: [UInt8],
+        options: MQLONG,
+        buffer: inout [UInt8]
+    ) throws -> (descriptor: MQMD, dataLength: Int)? {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        var getOptions = MQGMO.template
+        getOptions.Options = options
+        getOptions.WaitInterval = 0 // No wait - return immediately if no message
+        getOptions.MatchOptions = MQMO_MATCH_MSG_ID
+
+        while true {
+            var messageDescriptor = MQMD.template
+            MQIField.setBytes(messageId, in: &messageDescriptor.MsgId)
+
+            var dataLength: MQLONG = 0
+            let call = MQInstrumentation.shared.begin(.get)
+            MQGET(
+                connection.handle,
+                objectHandle,
+                &messageDescriptor,
+                &getOptions,
+                MQLONG(buffer.count),
+                &buffer,
+                &dataLength,
+                &compCode,
+                &reason
+            )
+            MQInstrumentation.shared.end(
+                call,
+                .get,
+                connection: connection.handle,
+                queue: queueName,
+                bytes: min(Int(dataLength), buffer.count),
+                compCode: compCode,
+                reason: reason
+            )
+
+            if reason == MQRC_NO_MSG_AVAILABLE {
+                return nil
+            }
+
+            // The message stays on the queue; get it again with room for all of it
+            if reason == MQRC_TRUNCATED_MSG_FAILED && Int(dataLength) > buffer.count {
+                buffer = [UInt8](repeating: 0, count: Int(dataLength))
+                continue
+            }
+
+            if compCode == MQCC_FAILED {
+                throw MQError.operationFailed(
+                    operation: "MQGET(\(queueName))",
+                    completionCode: compCode,
+                    reasonCode: reason
+                )
+            }
+
+            return (messageDescriptor, min(Int(dataLength), buffer.count))
+        }
+    }
 }
 
-// Note: toMQCharArray extension is defined in MQBridge/MQTypes.swift
+// MARK: - Purge Tally
+
+/// Running total of the messages removed by the workers of one purge
+/// Isolated to the main actor, where every worker records its commits
+@MainActor
+private final class PurgeTally {
+    private let progress: (@MainActor (Int) -> Void)?
+    private(set) var removedCount = 0
+
+    init(progress: (@MainActor (Int) -> Void)?) {
+        self.progress = progress
+    }
+
+    /// Record a committed batch and report the new total
+    func add(_ count: Int) {
+        guard count > 0 else { return }
+        removedCount += count
+        progress?(removedCount)
+    }
+}
+
+// MARK: - MQMessage Decoding
+
+extension MQService.MQMessage {
+
+    /// Create a message from the MQMD and payload returned by a browse MQGET
+    /// - Parameters:
+    ///   - messageDescriptor: Message descriptor filled in by MQGET
+    ///   - payload: Received message data (possibly truncated)
+    ///   - totalLength: Full message length reported by MQGET (defaults to the payload size)
+    ///   - messageToken: MsgToken returned in the MQGMO (version 3 and later)
+    ///   - position: Position of the message in the browse cursor
+    init(
+        messageDescriptor: MQMD,
+        payload: Data,
+        totalLength: Int? = nil,
+        messageToken: [UInt8] = [],
+        position: Int
+    ) {
+        // Each fixed field is copied out whole; names drop their blank padding
+        let messageId = MQIField.bytes(of: messageDescriptor.MsgId)
+        let correlationId = MQIField.bytes(of: messageDescriptor.CorrelId)
+        let format = MQIField.string(of: messageDescriptor.Format)
+        let putApplicationName = MQIField.string(of: messageDescriptor.PutApplName)
+        let replyToQueue = MQIField.string(of: messageDescriptor.ReplyToQ)
+        let replyToQueueManager = MQIField.string(of: messageDescriptor.ReplyToQMgr)
+
+        // Parse put date/time
+        let putDateTime = Self.parsePutDateTime(messageDescriptor: messageDescriptor)
+
+        self.init(
+            messageId: messageId,
+            correlationId: correlationId,
+            format: format,
+            payload: payload,
+            totalLength: totalLength,
+            putDateTime: putDateTime,
+            putApplicationName: putApplicationName,
+            messageType: MQService.MQMessageType(rawValue: messageDescriptor.MsgType),
+            persistence: MQService.MQMessagePersistence(rawValue: messageDescriptor.Persistence),
+            priority: messageDescriptor.Priority,
+            replyToQueue: replyToQueue,
+            replyToQueueManager: replyToQueueManager,
+            messageSequenceNumber: messageDescriptor.MsgSeqNumber,
+            position: position,
+            messageToken: messageToken,
+            codedCharSetId: messageDescriptor.CodedCharSetId,
+            encoding: messageDescriptor.Encoding
+        )
+    }
+
+    /// Formatter for the MQMD PutDate/PutTime fields, shared by every browsed message
+    private static let putDateTimeFormatter: DateFormatter = {
+        let dateFormatter = DateFormatter()
+        dateFormatter.dateFormat = "yyyyMMddHHmmss"
+        dateFormatter.timeZone = TimeZone(identifier: "UTC")
+        return dateFormatter
+    }()
+
+    /// Parse put date and time from MQMD fields
+    private static func parsePutDateTime(messageDescriptor: MQMD) -> Date? {
+        // PutDate is YYYYMMDD, PutTime HHMMSSTH
+        let putDateString = MQIField.string(of: messageDescriptor.PutDate)
+        let putTimeString = MQIField.string(of: messageDescriptor.PutTime)
+
+        // Parse date and time
+        guard putDateString.count >= 8, putTimeString.count >= 6 else {
+            return nil
+        }
+
+        let dateTimeString = String(putDateString.prefix(8)) + String(putTimeString.prefix(6))
+        return putDateTimeFormatter.date(from: dateTimeString)
+    }
+}
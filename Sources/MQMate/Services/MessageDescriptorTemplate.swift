@@ -0,0 +1,79 @@
+import Foundation
+import CMQC
+
+// MARK: - Message Descriptor Template
+
+/// MQMD prepared once and copied for every message put
+///
+/// The fields shared by all messages (version, format, reply-to queue) are
+/// filled in once; each descriptor is a copy of the template with only the
+/// per-message fields set. Copying also resets the fields MQPUT writes back,
+/// such as MsgId, so one template serves a whole sequence of puts.
+struct MessageDescriptorTemplate {
+
+    // MARK: - Properties
+
+    /// Descriptor the per-message copies start from
+    private var base: MQMD
+
+    /// Reply-to queue currently written into base
+    private var replyToQueue = ""
+
+    // MARK: - Initialization
+
+    /// Create a template for MQSTR messages
+    init() {
+        base = MQMD.template
+
+        // Format is an 8-character field: "MQSTR   "
+        base.Format = (
+            MQCHAR(0x4D), MQCHAR(0x51), MQCHAR(0x53), MQCHAR(0x54),
+            MQCHAR(0x52), MQCHAR(0x20), MQCHAR(0x20), MQCHAR(0x20)
+        )
+    }
+
+    // MARK: - Descriptors
+
+    /// Build the descriptor for one message
+    /// - Parameters:
+    ///   - messageType: Type of message
+    ///   - persistence: Message persistence setting
+    ///   - priority: Message priority, nil to use the queue default
+    ///   - correlationId: Correlation ID, padded with zeros to 24 bytes
+    ///   - replyToQueue: Reply-to queue name
+    /// - Returns: A descriptor ready for MQPUT
+    mutating func descriptor(
+        messageType: MQService.MQMessageType,
+        persistence: MQService.MQMessagePersistence,
+        priority: Int32?,
+        correlationId: [UInt8]?,
+        replyToQueue: String?
+    ) -> MQMD {
+        // Messages of one send usually share a reply-to queue, so it is only converted when it changes
+        setReplyToQueue(replyToQueue ?? "")
+
+        var messageDescriptor = base
+        messageDescriptor.MsgType = messageType.mqValue
+        messageDescriptor.Persistence = persistence.rawValue
+        messageDescriptor.Priority = priority ?? -1 // MQPRI_PRIORITY_AS_Q_DEF
+
+        if let correlationId {
+            MQIField.setBytes(correlationId, in: &messageDescriptor.CorrelId)
+        }
+
+        return messageDescriptor
+    }
+
+    /// Write a reply-to queue name into the template
+    /// - Parameter queueName: Queue name; empty leaves ReplyToQ unset
+    private mutating func setReplyToQueue(_ queueName: String) {
+        guard queueName != replyToQueue else { return }
+        replyToQueue = queueName
+
+        if queueName.isEmpty {
+            base.ReplyToQ = MQMD.template.ReplyToQ
+        } else {
+            MQIField.setString(queueName, in: &base.ReplyToQ)
+        }
+    }
+}
@@ -0,0 +1,328 @@
+import Foundation
+import CMQC
+
+// MARK: - PCF Response
+
+/// Borrowed view of one PCF response message
+///
+/// The view walks the MQCFH header and the MQCFIN/MQCFST/MQCFIL/MQCFSL
+/// structures that follow it in place, without copying the message. It is only
+/// valid while the memory it was created over is alive and unchanged - for
+/// responses handed out by PCFSession, that is for the duration of the handler
+/// call. Copy out anything that must outlive it (e.g. with PCFString.string).
+struct PCFResponse {
+
+    /// Raw bytes of the whole message, MQCFH first
+    let bytes: UnsafeRawBufferPointer
+
+    /// Create a view over a PCF message
+    /// - Parameter bytes: Message bytes (at least one MQCFH)
+    /// - Returns: nil if the buffer is too short to hold a PCF header
+    init?(bytes: UnsafeRawBufferPointer) {
+        guard bytes.count >= Int(MQCFH_STRUC_LENGTH) else {
+            return nil
+        }
+        self.bytes = bytes
+    }
+
+    // MARK: - MQCFH Fields
+
+    /// Structure type (MQCFT_RESPONSE for command server replies)
+    var type: MQLONG { field(at: 0) }
+
+    /// Command code the response belongs to
+    var command: MQLONG { field(at: 12) }
+
+    /// Sequence number of this message within the response set
+    var msgSeqNumber: MQLONG { field(at: 16) }
+
+    /// MQCFC_LAST on the final message of a response set
+    var control: MQLONG { field(at: 20) }
+
+    /// Completion code reported by the command server
+    var compCode: MQLONG { field(at: 24) }
+
+    /// Reason code reported by the command server
+    var reason: MQLONG { field(at: 28) }
+
+    /// Number of parameter structures following the header
+    var parameterCount: MQLONG { field(at: 32) }
+
+    /// Whether this is the last message of the response set
+    var isLast: Bool {
+        return control == MQCFC_LAST
+    }
+
+    /// The parameter structures following the header
+    var parameters: PCFParameterSequence {
+        let headerLength = max(Int(field(at: 4)), Int(MQCFH_STRUC_LENGTH))
+        let start = min(headerLength, bytes.count)
+        return PCFParameterSequence(bytes: UnsafeRawBufferPointer(rebasing: bytes[start...]))
+    }
+
+    private func field(at offset: Int) -> MQLONG {
+        return bytes.loadUnaligned(fromByteOffset: offset, as: MQLONG.self)
+    }
+}
+
+// MARK: - PCF Parameters
+
+/// A single PCF parameter structure, borrowed from the response buffer
+enum PCFParameter {
+    /// MQCFIN - integer parameter
+    case integer(parameter: MQLONG, value: MQLONG)
+    /// MQCFST - string parameter
+    case string(parameter: MQLONG, value: PCFString)
+    /// MQCFIL - integer list parameter
+    case integerList(parameter: MQLONG, values: PCFIntegerList)
+    /// MQCFSL - string list parameter
+    case stringList(parameter: MQLONG, values: PCFStringList)
+    /// Any other structure type (group, byte string, filter...), skipped by the decoder
+    case other(type: MQLONG, parameter: MQLONG)
+
+    /// Parameter identifier (MQIA_*, MQCA_*, MQIACF_*...)
+    var parameter: MQLONG {
+        switch self {
+        case .integer(let parameter, _),
+             .string(let parameter, _),
+             .integerList(let parameter, _),
+             .stringList(let parameter, _),
+             .other(_, let parameter):
+            return parameter
+        }
+    }
+}
+
+/// Borrowed view of an MQCFST string value
+struct PCFString {
+
+    /// Raw string bytes as received (blank-padded by the queue manager)
+    let bytes: UnsafeRawBufferPointer
+
+    /// Coded character set of the string
+    let codedCharSetId: MQLONG
+
+    /// Length of the value with trailing blanks and NULs removed
+    var trimmedLength: Int {
+        var length = bytes.count
+        while length > 0 && (bytes[length - 1] == 0x20 || bytes[length - 1] == 0x00) {
+            length -= 1
+        }
+        return length
+    }
+
+    /// Copy the value into a String, trimming the MQ blank padding
+    var string: String {
+        let trimmed = UnsafeRawBufferPointer(rebasing: bytes[0..<trimmedLength])
+        return String(decoding: trimmed, as: UTF8.self)
+    }
+
+    /// Compare against a String without allocating
+    /// - Parameter other: String to compare with (unpadded)
+    /// - Returns: true if the trimmed value has the same UTF-8 bytes
+    func equals(_ other: String) -> Bool {
+        let length = trimmedLength
+        var utf8 = other.utf8.makeIterator()
+        for index in 0..<length {
+            guard let byte = utf8.next(), byte == bytes[index] else {
+                return false
+            }
+        }
+        return utf8.next() == nil
+    }
+}
+
+/// Borrowed view of an MQCFIL integer list
+struct PCFIntegerList: RandomAccessCollection {
+
+    /// Raw bytes of the Values array
+    let bytes: UnsafeRawBufferPointer
+
+    var startIndex: Int { 0 }
+    var endIndex: Int { bytes.count / MemoryLayout<MQLONG>.size }
+
+    subscript(position: Int) -> MQLONG {
+        return bytes.loadUnaligned(fromByteOffset: position * MemoryLayout<MQLONG>.size, as: MQLONG.self)
+    }
+}
+
+/// Borrowed view of an MQCFSL string list
+struct PCFStringList: RandomAccessCollection {
+
+    /// Raw bytes of the Strings array
+    let bytes: UnsafeRawBufferPointer
+
+    /// Length of each (blank-padded) string in the list
+    let stringLength: Int
+
+    /// Coded character set of the strings
+    let codedCharSetId: MQLONG
+
+    var startIndex: Int { 0 }
+    var endIndex: Int { stringLength > 0 ? bytes.count / stringLength : 0 }
+
+    subscript(position: Int) -> PCFString {
+        let start = position * stringLength
+        return PCFString(
+            bytes: UnsafeRawBufferPointer(rebasing: bytes[start..<(start + stringLength)]),
+            codedCharSetId: codedCharSetId
+        )
+    }
+}
+
+// MARK: - Parameter Iteration
+
+/// Sequence over the parameter structures of a PCF message
+struct PCFParameterSequence: Sequence {
+
+    /// Bytes following the MQCFH header
+    let bytes: UnsafeRawBufferPointer
+
+    func makeIterator() -> PCFParameterIterator {
+        return PCFParameterIterator(bytes: bytes)
+    }
+}
+
+/// Iterator that decodes one PCF parameter structure per step
+/// Iteration stops at the end of the buffer or at the first structure whose
+/// StrucLength is invalid, so a malformed message can never read out of bounds
+struct PCFParameterIterator: IteratorProtocol {
+
+    private let bytes: UnsafeRawBufferPointer
+    private var offset = 0
+
+    init(bytes: UnsafeRawBufferPointer) {
+        self.bytes = bytes
+    }
+
+    mutating func next() -> PCFParameter? {
+        // Every structure starts with Type, StrucLength and Parameter
+        guard offset + 12 <= bytes.count else {
+            return nil
+        }
+
+        let type = load(at: offset)
+        let strucLength = Int(load(at: offset + 4))
+        let parameter = load(at: offset + 8)
+
+        guard strucLength >= 12, offset + strucLength <= bytes.count else {
+            offset = bytes.count
+            return nil
+        }
+
+        let structure = UnsafeRawBufferPointer(rebasing: bytes[offset..<(offset + strucLength)])
+        offset += strucLength
+
+        switch type {
+        case MQCFT_INTEGER where strucLength >= Int(MQCFIN_STRUC_LENGTH):
+            return .integer(parameter: parameter, value: load(structure, at: 12))
+
+        case MQCFT_STRING where strucLength >= Int(MQCFST_STRUC_LENGTH_FIXED):
+            let ccsid = load(structure, at: 12)
+            let stringLength = Int(load(structure, at: 16))
+            let start = Int(MQCFST_STRUC_LENGTH_FIXED)
+            let end = start + min(max(stringLength, 0), strucLength - start)
+            return .string(
+                parameter: parameter,
+                value: PCFString(
+                    bytes: UnsafeRawBufferPointer(rebasing: structure[start..<end]),
+                    codedCharSetId: ccsid
+                )
+            )
+
+        case MQCFT_INTEGER_LIST where strucLength >= Int(MQCFIL_STRUC_LENGTH_FIXED):
+            let count = Int(load(structure, at: 12))
+            let start = Int(MQCFIL_STRUC_LENGTH_FIXED)
+            let available = (strucLength - start) / MemoryLayout<MQLONG>.size
+            let end = start + min(max(count, 0), available) * MemoryLayout<MQLONG>.size
+            return .integerList(
+                parameter: parameter,
+                values: PCFIntegerList(bytes: UnsafeRawBufferPointer(rebasing: structure[start..<end]))
+            )
+
+        case MQCFT_STRING_LIST where strucLength >= Int(MQCFSL_STRUC_LENGTH_FIXED):
+            let ccsid = load(structure, at: 12)
+            let count = Int(load(structure, at: 16))
+            let stringLength = Int(load(structure, at: 20))
+            let start = Int(MQCFSL_STRUC_LENGTH_FIXED)
+            let available = stringLength > 0 ? (strucLength - start) / stringLength : 0
+            let end = start + min(max(count, 0), available) * max(stringLength, 0)
+            return .stringList(
+                parameter: parameter,
+                values: PCFStringList(
+                    bytes: UnsafeRawBufferPointer(rebasing: structure[start..<end]),
+                    stringLength: max(stringLength, 0),
+                    codedCharSetId: ccsid
+                )
+            )
+
+        default:
+            return .other(type: type, parameter: parameter)
+        }
+    }
+
+    private func load(at offset: Int) -> MQLONG {
+        return bytes.loadUnaligned(fromByteOffset: offset, as: MQLONG.self)
+    }
+
+    private func load(_ structure: UnsafeRawBufferPointer, at offset: Int) -> MQLONG {
+        return structure.loadUnaligned(fromByteOffset: offset, as: MQLONG.self)
+    }
+}
+
+// MARK: - Receive Buffer
+
+/// Reusable receive buffer for PCF responses
+/// Allocated once per PCFSession and grown when a response does not fit, so
+/// receiving a response set performs no per-message allocation
+final class PCFReceiveBuffer {
+
+    /// Start of the buffer
+    private(set) var baseAddress: UnsafeMutableRawPointer
+
+    /// Current size of the buffer in bytes
+    private(set) var capacity: Int
+
+    /// Create a buffer
+    /// - Parameter capacity: Initial size in bytes
+    init(capacity: Int) {
+        self.capacity = max(capacity, Int(MQCFH_STRUC_LENGTH))
+        self.baseAddress = UnsafeMutableRawPointer.allocate(
+            byteCount: self.capacity,
+            alignment: MemoryLayout<MQLONG>.alignment
+        )
+    }
+
+    deinit {
+        baseAddress.deallocate()
+    }
+
+    /// Grow the buffer so it holds at least the given number of bytes
+    /// Existing contents are not preserved
+    /// - Parameter minimumCapacity: Required size in bytes
+    func reserve(_ minimumCapacity: Int) {
+        guard minimumCapacity > capacity else {
+            return
+        }
+
+        // Round up to the next power of two to avoid repeated regrowth
+        var newCapacity = capacity
+        while newCapacity < minimumCapacity {
+            newCapacity *= 2
+        }
+
+        baseAddress.deallocate()
+        baseAddress = UnsafeMutableRawPointer.allocate(
+            byteCount: newCapacity,
+            alignment: MemoryLayout<MQLONG>.alignment
+        )
+        capacity = newCapacity
+    }
+
+    /// View of the first `count` bytes of the buffer
+    /// - Parameter count: Number of valid bytes
+    /// - Returns: Borrowed view valid until the next receive or reserve
+    func bytes(count: Int) -> UnsafeRawBufferPointer {
+        return UnsafeRawBufferPointer(start: baseAddress, count: min(count, capacity))
+    }
+}
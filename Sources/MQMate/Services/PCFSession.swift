@@ -0,0 +1,547 @@
+import Foundation
+import CMQC
+
+// MARK: - PCF Command
+
+/// A PCF (Programmable Command Format) command message under construction
+/// Parameters are encoded as they are appended; the MQCFH header is written
+/// when the command is encoded for sending
+struct PCFCommand {
+
+    /// MQCMD_* command code
+    let command: MQLONG
+
+    /// Number of parameter structures appended so far
+    private(set) var parameterCount: MQLONG = 0
+
+    /// Encoded parameter structures that follow the MQCFH header
+    private(set) var parameters = Data()
+
+    init(command: MQLONG) {
+        self.command = command
+    }
+
+    // MARK: - Parameter Encoding
+
+    /// Append an MQCFST string parameter
+    /// Only the fixed part of MQCFST is written before the string data, so the
+    /// encoded length always matches StrucLength regardless of struct padding
+    /// - Parameters:
+    ///   - parameter: MQCA_* / MQCACF_* parameter identifier
+    ///   - value: String value (space-padded or truncated to length)
+    ///   - length: Encoded string length in bytes
+    mutating func appendString(parameter: MQLONG, value: String, length: Int) {
+        let fixedPart: [MQLONG] = [
+            MQCFT_STRING,
+            MQCFST_STRUC_LENGTH_FIXED + MQLONG(length),
+            parameter,
+            MQCCSI_DEFAULT,
+            MQLONG(length)
+        ]
+        fixedPart.withUnsafeBytes { buffer in
+            parameters.append(contentsOf: buffer)
+        }
+
+        // Blank-padded in place at the end of the parameters
+        let start = parameters.count
+        parameters.append(contentsOf: repeatElement(0, count: length))
+        var value = value
+        value.withUTF8 { utf8 in
+            parameters.withUnsafeMutableBytes { buffer in
+                mqmate_set_chars(buffer.baseAddress! + start, length, utf8.baseAddress, utf8.count)
+            }
+        }
+        parameterCount += 1
+    }
+
+    /// Append an MQCFIN integer parameter
+    /// - Parameters:
+    ///   - parameter: MQIA_* / MQIACF_* parameter identifier
+    ///   - value: Integer value
+    mutating func appendInteger(parameter: MQLONG, value: MQLONG) {
+        var param = MQCFIN()
+        param.Type = MQCFT_INTEGER
+        param.StrucLength = MQCFIN_STRUC_LENGTH
+        param.Parameter = parameter
+        param.Value = value
+
+        withUnsafeBytes(of: &param) { buffer in
+            parameters.append(contentsOf: buffer)
+        }
+        parameterCount += 1
+    }
+
+    /// Append an MQCFIL integer list parameter
+    /// - Parameters:
+    ///   - parameter: MQIACF_* parameter identifier
+    ///   - values: Integer values of the list
+    mutating func appendIntegerList(parameter: MQLONG, values: [MQLONG]) {
+        let fixedPart: [MQLONG] = [
+            MQCFT_INTEGER_LIST,
+            MQCFIL_STRUC_LENGTH_FIXED + MQLONG(values.count * MemoryLayout<MQLONG>.size),
+            parameter,
+            MQLONG(values.count)
+        ]
+        fixedPart.withUnsafeBytes { buffer in
+            parameters.append(contentsOf: buffer)
+        }
+        values.withUnsafeBytes { buffer in
+            parameters.append(contentsOf: buffer)
+        }
+        parameterCount += 1
+    }
+
+    /// Encode the complete message: MQCFH header followed by the parameters
+    /// - Returns: PCF message data ready for MQPUT
+    func encoded() -> Data {
+        var pcfHeader = MQCFH()
+        pcfHeader.Type = MQCFT_COMMAND
+        pcfHeader.StrucLength = MQCFH_STRUC_LENGTH
+        pcfHeader.Version = MQCFH_VERSION_1
+        pcfHeader.Command = command
+        pcfHeader.MsgSeqNumber = 1
+        pcfHeader.Control = MQCFC_LAST
+        pcfHeader.ParameterCount = parameterCount
+
+        var message = Data(capacity: Int(MQCFH_STRUC_LENGTH) + parameters.count)
+        withUnsafeBytes(of: &pcfHeader) { buffer in
+            message.append(contentsOf: buffer)
+        }
+        message.append(parameters)
+        return message
+    }
+}
+
+// MARK: - PCF Session
+
+/// Long-lived PCF command session for a single queue manager connection
+///
+/// Keeps SYSTEM.ADMIN.COMMAND.QUEUE open for output and one temporary dynamic
+/// reply queue open for input, so an admin command costs one MQPUT plus the
+/// MQGETs for its responses instead of two MQOPENs, a dynamic queue creation
+/// and two MQCLOSEs.
+///
+/// Responses are matched to their command by CorrelId: the command server copies
+/// the request MsgId into the CorrelId of every response, and the session reads
+/// with MQMO_MATCH_CORREL_ID. Several commands can therefore be in flight on the
+/// same reply queue at once.
+///
+/// A session is not thread-safe and must only be used on the thread of the
+/// MQConnection its handle belongs to.
+final class PCFSession {
+
+    // MARK: - Types
+
+    /// A command that has been put to the command queue but whose responses
+    /// have not been collected yet
+    struct PendingCommand: Hashable, Sendable {
+        /// MsgId assigned by the queue manager; responses carry it as their CorrelId
+        let messageId: [UInt8]
+
+        /// MQCMD_* command code (for error messages)
+        let command: MQLONG
+    }
+
+    // MARK: - Constants
+
+    /// Queue the command server reads PCF commands from
+    static let commandQueueName = "SYSTEM.ADMIN.COMMAND.QUEUE"
+
+    /// Model queue used to create the temporary dynamic reply queue
+    static let replyModelQueueName = "SYSTEM.DEFAULT.MODEL.QUEUE"
+
+    /// Name prefix for the dynamic reply queue
+    static let replyQueuePrefix = "MQMATE.REPLY.*"
+
+    /// Initial size of the response receive buffer; grown on demand
+    private static let initialResponseBufferSize = 65536
+
+    // MARK: - Properties
+
+    /// Connection the session's handles belong to
+    let connectionHandle: MQHCONN
+
+    /// Output handle to SYSTEM.ADMIN.COMMAND.QUEUE
+    private var commandObjectHandle: MQHOBJ = MQHO_UNUSABLE_HOBJ
+
+    /// Input handle to the dynamic reply queue
+    private var replyObjectHandle: MQHOBJ = MQHO_UNUSABLE_HOBJ
+
+    /// Resolved name of the dynamic reply queue, kept as the fixed-length
+    /// field MQOPEN returns so each command assigns it to ReplyToQ as is
+    private var replyQueueName = MQMD.template.ReplyToQ
+
+    /// Buffer every response is received and decoded in
+    private let receiveBuffer = PCFReceiveBuffer(capacity: PCFSession.initialResponseBufferSize)
+
+    /// Whether both queues are open and the session can execute commands
+    var isOpen: Bool {
+        return commandObjectHandle != MQHO_UNUSABLE_HOBJ && replyObjectHandle != MQHO_UNUSABLE_HOBJ
+    }
+
+    // MARK: - Initialization
+
+    /// Open the command queue and create the dynamic reply queue
+    /// - Parameter connectionHandle: Handle of an established connection
+    /// - Throws: MQError if either queue cannot be opened
+    init(connectionHandle: MQHCONN) throws {
+        self.connectionHandle = connectionHandle
+
+        do {
+            try openCommandQueue()
+            try openReplyQueue()
+        } catch {
+            close()
+            throw error
+        }
+    }
+
+    deinit {
+        close()
+    }
+
+    /// Close both queues; the temporary dynamic reply queue is deleted by the
+    /// queue manager when it is closed. Safe to call more than once
+    func close() {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        if replyObjectHandle != MQHO_UNUSABLE_HOBJ {
+            let call = MQInstrumentation.shared.begin(.close)
+            MQCLOSE(connectionHandle, &replyObjectHandle, MQCO_NONE, &compCode, &reason)
+            MQInstrumentation.shared.end(
+                call,
+                .close,
+                connection: connectionHandle,
+                queue: Self.replyModelQueueName,
+                compCode: compCode,
+                reason: reason
+            )
+            replyObjectHandle = MQHO_UNUSABLE_HOBJ
+        }
+
+        if commandObjectHandle != MQHO_UNUSABLE_HOBJ {
+            let call = MQInstrumentation.shared.begin(.close)
+            MQCLOSE(connectionHandle, &commandObjectHandle, MQCO_NONE, &compCode, &reason)
+            MQInstrumentation.shared.end(
+                call,
+                .close,
+                connection: connectionHandle,
+                queue: Self.commandQueueName,
+                compCode: compCode,
+                reason: reason
+            )
+            commandObjectHandle = MQHO_UNUSABLE_HOBJ
+        }
+    }
+
+    // MARK: - Command Execution
+
+    /// Put a command to the command queue without waiting for its responses
+    /// - Parameters:
+    ///   - command: The command to send
+    ///   - expiry: Message expiry in tenths of a second
+    /// - Returns: Token used to collect the command's responses
+    /// - Throws: MQError if the MQPUT fails
+    func send(_ command: PCFCommand, expiry: MQLONG = 300 * 10) throws -> PendingCommand {
+        guard isOpen else {
+            throw MQError.handleError(message: "PCF session is closed")
+        }
+
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        // Message descriptor
+        var messageDescriptor = MQMD.template
+        messageDescriptor.Format = (
+            MQCHAR(0x4D), MQCHAR(0x51), MQCHAR(0x41), MQCHAR(0x44),
+            MQCHAR(0x4D), MQCHAR(0x49), MQCHAR(0x4E), MQCHAR(0x20)
+        )  // "MQADMIN "
+        messageDescriptor.MsgType = MQMT_REQUEST
+        messageDescriptor.Persistence = MQPER_NOT_PERSISTENT
+        messageDescriptor.Expiry = expiry
+
+        messageDescriptor.ReplyToQ = replyQueueName
+
+        // Put message options; the queue manager generates the MsgId we correlate on
+        var putOptions = MQPMO.template
+        putOptions.Options = MQPMO_NO_SYNCPOINT | MQPMO_NEW_MSG_ID
+
+        var messageData = command.encoded()
+        let messageLength = MQLONG(messageData.count)
+
+        let call = MQInstrumentation.shared.begin(.put)
+        messageData.withUnsafeMutableBytes { buffer in
+            MQPUT(
+                connectionHandle,
+                commandObjectHandle,
+                &messageDescriptor,
+                &putOptions,
+                messageLength,
+                buffer.baseAddress,
+                &compCode,
+                &reason
+            )
+        }
+        MQInstrumentation.shared.end(
+            call,
+            .put,
+            connection: connectionHandle,
+            queue: Self.commandQueueName,
+            bytes: compCode == MQCC_FAILED ? 0 : messageData.count,
+            compCode: compCode,
+            reason: reason
+        )
+
+        guard compCode != MQCC_FAILED else {
+            throw MQError.operationFailed(
+                operation: "MQPUT(PCF command \(command.command))",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+
+        let messageId = MQIField.bytes(of: messageDescriptor.MsgId)
+        return PendingCommand(messageId: messageId, command: command.command)
+    }
+
+    /// Collect all responses for a previously sent command
+    /// Reads only messages whose CorrelId matches the command's MsgId, until the
+    /// response flagged MQCFC_LAST arrives. Each response is decoded in place in
+    /// the session's receive buffer, which grows when a response does not fit
+    /// - Parameters:
+    ///   - pending: Token returned by send(_:expiry:)
+    ///   - waitInterval: Maximum wait for each response message in milliseconds
+    ///   - body: Called once per response; the view is only valid during the call.
+    ///     If it throws, the remaining responses are still drained from the reply
+    ///     queue before the error is rethrown
+    /// - Throws: MQError if a response is not received in time or MQGET fails.
+    ///   A wait that runs out before the MQCFC_LAST response throws
+    ///   MQRC_NO_MSG_AVAILABLE instead of returning the responses read so far,
+    ///   so a listing cut short by a slow or stopped command server never
+    ///   passes for a complete one
+    func receive(
+        _ pending: PendingCommand,
+        waitInterval: MQLONG,
+        _ body: (PCFResponse) throws -> Void
+    ) throws {
+        guard isOpen else {
+            throw MQError.handleError(message: "PCF session is closed")
+        }
+
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+        var bodyError: Error?
+
+        while true {
+            // Message descriptor - CorrelId selects this command's responses
+            var messageDescriptor = MQMD.template
+            MQIField.setBytes(pending.messageId, in: &messageDescriptor.CorrelId)
+
+            // Get message options - no ACCEPT_TRUNCATED_MSG, so an oversized
+            // response stays on the queue and is read again after growing the buffer
+            var getOptions = MQGMO.template
+            getOptions.Options = MQGMO_NO_SYNCPOINT | MQGMO_WAIT | MQGMO_CONVERT | MQGMO_FAIL_IF_QUIESCING
+            getOptions.WaitInterval = waitInterval
+            getOptions.MatchOptions = MQMO_MATCH_CORREL_ID
+
+            var dataLength: MQLONG = 0
+
+            // The time spent here is the PCF wait; the reply queue is recorded
+            // under its model queue, as every session's dynamic queue has a new name
+            let call = MQInstrumentation.shared.begin(.get)
+            MQGET(
+                connectionHandle,
+                replyObjectHandle,
+                &messageDescriptor,
+                &getOptions,
+                MQLONG(receiveBuffer.capacity),
+                receiveBuffer.baseAddress,
+                &dataLength,
+                &compCode,
+                &reason
+            )
+            MQInstrumentation.shared.end(
+                call,
+                .get,
+                connection: connectionHandle,
+                queue: Self.replyModelQueueName,
+                bytes: min(Int(dataLength), receiveBuffer.capacity),
+                compCode: compCode,
+                reason: reason
+            )
+
+            if reason == MQRC_TRUNCATED_MSG_FAILED && Int(dataLength) > receiveBuffer.capacity {
+                // DataLength holds the full message length; grow and read it again
+                receiveBuffer.reserve(Int(dataLength))
+                continue
+            }
+
+            // The response set is incomplete; see the Throws note above
+            if reason == MQRC_NO_MSG_AVAILABLE {
+                throw MQError.operationFailed(
+                    operation: "PCF command \(pending.command) (no response received)",
+                    completionCode: MQCC_FAILED,
+                    reasonCode: reason
+                )
+            }
+
+            guard compCode != MQCC_FAILED else {
+                throw MQError.operationFailed(
+                    operation: "MQGET(PCF response)",
+                    completionCode: compCode,
+                    reasonCode: reason
+                )
+            }
+
+            // A message too short for an MQCFH cannot continue the response set
+            guard let response = PCFResponse(bytes: receiveBuffer.bytes(count: Int(dataLength))) else {
+                break
+            }
+
+            if bodyError == nil {
+                do {
+                    try MQInstrumentation.shared.measure(.pcfDecode) {
+                        try body(response)
+                    }
+                } catch {
+                    bodyError = error
+                }
+            }
+
+            // Stop at the last message of the response set
+            if response.isLast {
+                break
+            }
+        }
+
+        if let bodyError {
+            throw bodyError
+        }
+    }
+
+    /// Send a command and handle all of its responses
+    /// - Parameters:
+    ///   - command: The command to execute
+    ///   - waitInterval: Maximum wait for each response message in milliseconds
+    ///   - body: Called once per response with a view valid only during the call
+    /// - Throws: MQError if the command cannot be sent or its responses received,
+    ///   or any error thrown by body
+    func execute(
+        _ command: PCFCommand,
+        waitInterval: MQLONG,
+        _ body: (PCFResponse) throws -> Void
+    ) throws {
+        let pending = try send(command)
+        try receive(pending, waitInterval: waitInterval, body)
+    }
+
+    /// Execute several commands with all of them in flight at once
+    /// Every command is put before any response is read, so the command server
+    /// can work through them back to back
+    /// - Parameters:
+    ///   - commands: The commands to execute
+    ///   - waitInterval: Maximum wait for each response message in milliseconds
+    ///   - body: Called with the command's index and each of its responses
+    /// - Returns: One result per command, in the same order
+    func execute(
+        _ commands: [PCFCommand],
+        waitInterval: MQLONG,
+        _ body: (Int, PCFResponse) throws -> Void
+    ) -> [Result<Void, Error>] {
+        let pending: [Result<PendingCommand, Error>] = commands.map { command in
+            Result { try send(command) }
+        }
+
+        return pending.enumerated().map { index, result in
+            result.flatMap { pendingCommand in
+                Result {
+                    try receive(pendingCommand, waitInterval: waitInterval) { response in
+                        try body(index, response)
+                    }
+                }
+            }
+        }
+    }
+
+    // MARK: - Queue Handling
+
+    /// Open SYSTEM.ADMIN.COMMAND.QUEUE for output
+    private func openCommandQueue() throws {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        var objectDescriptor = MQOD.template
+
+        MQIField.setString(Self.commandQueueName, in: &objectDescriptor.ObjectName)
+
+        let call = MQInstrumentation.shared.begin(.open)
+        MQOPEN(
+            connectionHandle,
+            &objectDescriptor,
+            MQOO_OUTPUT | MQOO_FAIL_IF_QUIESCING,
+            &commandObjectHandle,
+            &compCode,
+            &reason
+        )
+        MQInstrumentation.shared.end(
+            call,
+            .open,
+            connection: connectionHandle,
+            queue: Self.commandQueueName,
+            compCode: compCode,
+            reason: reason
+        )
+
+        guard compCode != MQCC_FAILED else {
+            commandObjectHandle = MQHO_UNUSABLE_HOBJ
+            throw MQError.operationFailed(
+                operation: "MQOPEN(\(Self.commandQueueName))",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+    }
+
+    /// Create and open the temporary dynamic reply queue for exclusive input
+    private func openReplyQueue() throws {
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        var objectDescriptor = MQOD.template
+
+        // Model queue name and dynamic queue name prefix
+        MQIField.setString(Self.replyModelQueueName, in: &objectDescriptor.ObjectName)
+        MQIField.setString(Self.replyQueuePrefix, in: &objectDescriptor.DynamicQName)
+
+        let call = MQInstrumentation.shared.begin(.open)
+        MQOPEN(
+            connectionHandle,
+            &objectDescriptor,
+            MQOO_INPUT_EXCLUSIVE | MQOO_FAIL_IF_QUIESCING,
+            &replyObjectHandle,
+            &compCode,
+            &reason
+        )
+        MQInstrumentation.shared.end(
+            call,
+            .open,
+            connection: connectionHandle,
+            queue: Self.replyModelQueueName,
+            compCode: compCode,
+            reason: reason
+        )
+
+        guard compCode != MQCC_FAILED else {
+            replyObjectHandle = MQHO_UNUSABLE_HOBJ
+            throw MQError.operationFailed(
+                operation: "MQOPEN(reply queue)",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+
+        // MQOPEN returns the generated dynamic queue name in ObjectName
+        replyQueueName = objectDescriptor.ObjectName
+    }
+}
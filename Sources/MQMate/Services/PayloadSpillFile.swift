@@ -0,0 +1,152 @@
+import Foundation
+
+// MARK: - Payload Spill Policy
+
+/// When message payloads are moved out of memory into a spill file
+public struct PayloadSpillPolicy: Equatable, Sendable {
+
+    /// Payloads of at least this many bytes are always spilled
+    public var payloadThreshold: Int
+
+    /// Once the payloads held in memory reach this many bytes, every further payload is spilled
+    public var memoryBudget: Int
+
+    public init(payloadThreshold: Int, memoryBudget: Int) {
+        self.payloadThreshold = payloadThreshold
+        self.memoryBudget = memoryBudget
+    }
+
+    /// 64 KB payloads and 256 MB of payloads in memory
+    public static let `default` = PayloadSpillPolicy(payloadThreshold: 64 * 1024, memoryBudget: 256 * 1024 * 1024)
+
+    /// Keep every payload in memory
+    public static let disabled = PayloadSpillPolicy(payloadThreshold: .max, memoryBudget: .max)
+
+    /// Whether a payload is spilled
+    /// - Parameters:
+    ///   - count: Size of the payload
+    ///   - residentBytes: Payload bytes already held in memory
+    func spills(count: Int, residentBytes: Int) -> Bool {
+        count > 0 && (count >= payloadThreshold || residentBytes + count > memoryBudget)
+    }
+}
+
+// MARK: - Payload Spill File
+
+/// Append-only file of message payloads, read back through a memory mapping
+///
+/// Payloads are written to the end of the file with pwrite and read by
+/// copying from a read-only shared mapping of the file, so the bytes live in
+/// the page cache rather than the process heap. The kernel can evict those
+/// pages whenever memory is short without swapping. The mapping is extended
+/// when a read reaches past it.
+///
+/// The file is unlinked as soon as it is created, so it is removed when the
+/// last reference closes it, even if the app is terminated. One file backs one
+/// browse session and goes away with its MessageStore.
+final class PayloadSpillFile: @unchecked Sendable {
+
+    // MARK: - Properties
+
+    /// Descriptor of the unlinked file
+    private let fileDescriptor: Int32
+
+    /// Guards the fields below; reads may come from any thread
+    private let lock = NSLock()
+
+    /// Bytes written
+    private var length = 0
+
+    /// Read-only mapping of the file, nil until the first read
+    private var mapping: UnsafeMutableRawPointer?
+
+    /// Length of the mapping
+    private var mappedLength = 0
+
+    // MARK: - Initialization
+
+    /// Create an empty spill file in the temporary directory
+    /// - Returns: nil if the file cannot be created
+    init?() {
+        let path = FileManager.default.temporaryDirectory
+            .appendingPathComponent("MQMate-payloads-\(UUID().uuidString)")
+            .path
+
+        let fileDescriptor = open(path, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR)
+        guard fileDescriptor >= 0 else { return nil }
+        unlink(path)
+        self.fileDescriptor = fileDescriptor
+    }
+
+    deinit {
+        if let mapping {
+            munmap(mapping, mappedLength)
+        }
+        close(fileDescriptor)
+    }
+
+    // MARK: - Writing
+
+    /// Write a payload to the end of the file
+    /// - Parameter payload: Bytes to write
+    /// - Returns: Offset of the payload in the file, or nil if it could not be written
+    func append(_ payload: Data) -> Int? {
+        lock.lock()
+        defer { lock.unlock() }
+
+        let offset = length
+        let isWritten = payload.withUnsafeBytes { buffer -> Bool in
+            var written = 0
+            while written < buffer.count {
+                let result = pwrite(
+                    fileDescriptor,
+                    buffer.baseAddress! + written,
+                    buffer.count - written,
+                    off_t(offset + written)
+                )
+                guard result > 0 else { return false }
+                written += result
+            }
+            return true
+        }
+        guard isWritten else { return nil }
+
+        length += payload.count
+        return offset
+    }
+
+    // MARK: - Reading
+
+    /// Read a payload back
+    /// - Parameters:
+    ///   - offset: Offset returned by append(_:)
+    ///   - count: Size of the payload
+    /// - Returns: A copy of the bytes; empty if the file cannot be mapped
+    func read(offset: Int, count: Int) -> Data {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard count > 0, offset + count <= length else { return Data() }
+
+        if offset + count > mappedLength {
+            remap()
+        }
+        guard let mapping, offset + count <= mappedLength else { return Data() }
+
+        return Data(bytes: mapping + offset, count: count)
+    }
+
+    /// Map everything written so far, replacing the previous mapping
+    private func remap() {
+        if let mapping {
+            munmap(mapping, mappedLength)
+            self.mapping = nil
+            mappedLength = 0
+        }
+
+        guard let address = mmap(nil, length, PROT_READ, MAP_SHARED, fileDescriptor, 0),
+              address != MAP_FAILED else { return }
+        mapping = address
+        mappedLength = length
+    }
+}
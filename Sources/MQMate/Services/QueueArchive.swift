@@ -0,0 +1,427 @@
+import Foundation
+import CMQC
+
+// MARK: - Queue Archive
+
+/// Binary snapshot of a queue: the raw MQMD and payload of every message
+///
+/// Layout, all integers little-endian:
+/// - Header: magic `MQMA`, format version (UInt16), flags (UInt16), size of
+///   the MQMD struct the descriptors were written with (UInt32)
+/// - Blocks of records, written as the browse produces them. Each block
+///   starts with its stored length, raw length and message count (UInt32
+///   each) and a flags word (UInt32; bit 0 = LZFSE-compressed), followed by
+///   the records: descriptor length and bytes, payload length and bytes
+/// - Index: file offset (UInt64), first message (UInt64) and message count
+///   (UInt32, plus 4 reserved bytes) of every block
+/// - Trailer: index offset (UInt64), message count (UInt64), block count
+///   (UInt32) and magic `MQMX`
+///
+/// A reader finds the index from the fixed-size trailer, so any block, and
+/// with it any message, can be read without scanning the file. Descriptors
+/// are stored as the C struct, so an archive is only read back by a client
+/// with the same MQMD layout; the header records its size to check this.
+enum QueueArchive {
+
+    // MARK: - Format
+
+    /// Magic at the start of the file
+    static let headerMagic: [UInt8] = Array("MQMA".utf8)
+
+    /// Magic at the end of the file
+    static let trailerMagic: [UInt8] = Array("MQMX".utf8)
+
+    /// Format version written and understood
+    static let formatVersion: UInt16 = 1
+
+    /// Length of the header
+    static let headerLength = 12
+
+    /// Length of the header of every block
+    static let blockHeaderLength = 16
+
+    /// Length of one index entry
+    static let indexEntryLength = 24
+
+    /// Length of the trailer
+    static let trailerLength = 24
+
+    /// Block flag: the records are LZFSE-compressed
+    static let compressedFlag: UInt32 = 1
+
+    /// Raw record bytes collected before a block is written
+    static let targetBlockLength = 1024 * 1024
+
+    /// Size of the descriptors in this build
+    static var descriptorLength: Int {
+        MemoryLayout<MQMD>.size
+    }
+
+    // MARK: - Types
+
+    /// One archived message
+    struct Record {
+        /// Message descriptor exactly as browsed
+        var descriptor: MQMD
+
+        /// Complete payload
+        var payload: Data
+    }
+
+    /// Location of one block, from the index
+    struct BlockEntry: Equatable, Sendable {
+        /// Offset of the block header in the file
+        let offset: UInt64
+        /// Index in the archive of the block's first message
+        let firstMessage: UInt64
+        /// Number of messages in the block
+        let messageCount: UInt32
+    }
+
+    // MARK: - Encoding
+
+    /// Append an integer in little-endian byte order
+    static func append<T: FixedWidthInteger>(_ value: T, to data: inout Data) {
+        withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+    }
+
+    /// Read a little-endian integer at an offset of a byte buffer
+    static func read<T: FixedWidthInteger>(_: T.Type, from bytes: UnsafeRawBufferPointer, at offset: Int) -> T {
+        var value: T = 0
+        withUnsafeMutableBytes(of: &value) { target in
+            target.copyMemory(from: UnsafeRawBufferPointer(rebasing: bytes[offset..<offset + MemoryLayout<T>.size]))
+        }
+        return T(littleEndian: value)
+    }
+
+    /// Error for a file that is not a readable archive
+    static func invalidArchive(_ reason: String) -> MQError {
+        .invalidConfiguration(message: "Not a readable queue archive: \(reason)")
+    }
+}
+
+// MARK: - Queue Archive Writer
+
+/// Writes an archive block by block as records are appended
+/// Not thread-safe; a dump uses it from one connection thread only
+final class QueueArchiveWriter {
+
+    // MARK: - Properties
+
+    /// Whether blocks are compressed
+    let isCompressed: Bool
+
+    /// File the archive is written to
+    private let fileHandle: FileHandle
+
+    /// Records of the block being collected
+    private var pendingBlock = Data()
+
+    /// Number of records in the pending block
+    private var pendingCount: UInt32 = 0
+
+    /// Location of every block written
+    private var blocks: [QueueArchive.BlockEntry] = []
+
+    /// Offset the next block is written at
+    private var offset: UInt64 = 0
+
+    /// Number of records appended
+    private(set) var messageCount: UInt64 = 0
+
+    // MARK: - Initialization
+
+    /// Create or truncate the file and write the header
+    /// - Parameters:
+    ///   - url: File to write
+    ///   - compressed: Whether blocks are LZFSE-compressed
+    /// - Throws: A file error if the file cannot be created or written
+    init(url: URL, compressed: Bool) throws {
+        guard FileManager.default.createFile(atPath: url.path, contents: nil) else {
+            throw CocoaError(.fileWriteUnknown, userInfo: [NSFilePathErrorKey: url.path])
+        }
+        self.fileHandle = try FileHandle(forWritingTo: url)
+        self.isCompressed = compressed
+
+        var header = Data(QueueArchive.headerMagic)
+        QueueArchive.append(QueueArchive.formatVersion, to: &header)
+        QueueArchive.append(UInt16(0), to: &header)
+        QueueArchive.append(UInt32(QueueArchive.descriptorLength), to: &header)
+        try write(header)
+    }
+
+    deinit {
+        try? fileHandle.close()
+    }
+
+    // MARK: - Writing
+
+    /// Add a record, writing the pending block once it is large enough
+    /// - Throws: A file error if the block cannot be written
+    func append(_ record: QueueArchive.Record) throws {
+        var descriptor = record.descriptor
+        QueueArchive.append(UInt32(QueueArchive.descriptorLength), to: &pendingBlock)
+        withUnsafeBytes(of: &descriptor) { pendingBlock.append(contentsOf: $0) }
+        QueueArchive.append(UInt32(record.payload.count), to: &pendingBlock)
+        pendingBlock.append(record.payload)
+
+        pendingCount += 1
+        messageCount += 1
+
+        if pendingBlock.count >= QueueArchive.targetBlockLength {
+            try writeBlock()
+        }
+    }
+
+    /// Write the last block, the index and the trailer, and close the file
+    /// - Throws: A file error if the file cannot be written
+    func finish() throws {
+        try writeBlock()
+
+        let indexOffset = offset
+        var index = Data()
+        index.reserveCapacity(blocks.count * QueueArchive.indexEntryLength + QueueArchive.trailerLength)
+        for block in blocks {
+            QueueArchive.append(block.offset, to: &index)
+            QueueArchive.append(block.firstMessage, to: &index)
+            QueueArchive.append(block.messageCount, to: &index)
+            QueueArchive.append(UInt32(0), to: &index)
+        }
+
+        QueueArchive.append(indexOffset, to: &index)
+        QueueArchive.append(messageCount, to: &index)
+        QueueArchive.append(UInt32(blocks.count), to: &index)
+        index.append(contentsOf: QueueArchive.trailerMagic)
+        try write(index)
+        try fileHandle.close()
+    }
+
+    /// Write the pending block, compressed if that makes it smaller
+    private func writeBlock() throws {
+        guard pendingCount > 0 else { return }
+
+        var stored = pendingBlock
+        var flags: UInt32 = 0
+        if isCompressed,
+           let compressed = try? (pendingBlock as NSData).compressed(using: .lzfse) as Data,
+           compressed.count < pendingBlock.count {
+            stored = compressed
+            flags |= QueueArchive.compressedFlag
+        }
+
+        var block = Data()
+        block.reserveCapacity(QueueArchive.blockHeaderLength + stored.count)
+        QueueArchive.append(UInt32(stored.count), to: &block)
+        QueueArchive.append(UInt32(pendingBlock.count), to: &block)
+        QueueArchive.append(pendingCount, to: &block)
+        QueueArchive.append(flags, to: &block)
+        block.append(stored)
+
+        blocks.append(QueueArchive.BlockEntry(
+            offset: offset,
+            firstMessage: messageCount - UInt64(pendingCount),
+            messageCount: pendingCount
+        ))
+        try write(block)
+
+        pendingBlock.removeAll(keepingCapacity: true)
+        pendingCount = 0
+    }
+
+    /// Write bytes at the end of the file
+    private func write(_ data: Data) throws {
+        try fileHandle.write(contentsOf: data)
+        offset += UInt64(data.count)
+    }
+}
+
+// MARK: - Queue Archive Reader
+
+/// Reads an archive block by block, or from any message through the trailing index
+final class QueueArchiveReader {
+
+    // MARK: - Properties
+
+    /// Location of every block
+    let blocks: [QueueArchive.BlockEntry]
+
+    /// Number of messages in the archive
+    let messageCount: Int
+
+    /// File the archive is read from
+    private let fileHandle: FileHandle
+
+    // MARK: - Initialization
+
+    /// Open an archive and read its index
+    /// - Parameter url: File to read
+    /// - Throws: MQError.invalidConfiguration if the file is not a readable archive, or a file error
+    init(url: URL) throws {
+        let fileHandle = try FileHandle(forReadingFrom: url)
+        self.fileHandle = fileHandle
+
+        let header = try fileHandle.read(upToCount: QueueArchive.headerLength) ?? Data()
+        guard header.count == QueueArchive.headerLength,
+              Array(header.prefix(4)) == QueueArchive.headerMagic else {
+            throw QueueArchive.invalidArchive("missing header")
+        }
+        let (version, descriptorLength) = header.withUnsafeBytes { bytes in
+            (QueueArchive.read(UInt16.self, from: bytes, at: 4), QueueArchive.read(UInt32.self, from: bytes, at: 8))
+        }
+        guard version == QueueArchive.formatVersion else {
+            throw QueueArchive.invalidArchive("format version \(version)")
+        }
+        guard Int(descriptorLength) == QueueArchive.descriptorLength else {
+            throw QueueArchive.invalidArchive("written with a \(descriptorLength)-byte MQMD")
+        }
+
+        let fileLength = try fileHandle.seekToEnd()
+        guard fileLength >= UInt64(QueueArchive.headerLength + QueueArchive.trailerLength) else {
+            throw QueueArchive.invalidArchive("missing trailer")
+        }
+        try fileHandle.seek(toOffset: fileLength - UInt64(QueueArchive.trailerLength))
+        let trailer = try fileHandle.read(upToCount: QueueArchive.trailerLength) ?? Data()
+        guard trailer.count == QueueArchive.trailerLength,
+              Array(trailer.suffix(4)) == QueueArchive.trailerMagic else {
+            throw QueueArchive.invalidArchive("missing trailer, the dump may not have finished")
+        }
+        let (indexOffset, messageCount, blockCount) = trailer.withUnsafeBytes { bytes in
+            (
+                QueueArchive.read(UInt64.self, from: bytes, at: 0),
+                QueueArchive.read(UInt64.self, from: bytes, at: 8),
+                QueueArchive.read(UInt32.self, from: bytes, at: 16)
+            )
+        }
+
+        let indexLength = Int(blockCount) * QueueArchive.indexEntryLength
+        guard indexOffset + UInt64(indexLength) + UInt64(QueueArchive.trailerLength) == fileLength else {
+            throw QueueArchive.invalidArchive("index does not match the file length")
+        }
+        try fileHandle.seek(toOffset: indexOffset)
+        let index = try fileHandle.read(upToCount: indexLength) ?? Data()
+        guard index.count == indexLength else {
+            throw QueueArchive.invalidArchive("truncated index")
+        }
+
+        self.blocks = index.withUnsafeBytes { bytes in
+            (0..<Int(blockCount)).map { block in
+                let entry = block * QueueArchive.indexEntryLength
+                return QueueArchive.BlockEntry(
+                    offset: QueueArchive.read(UInt64.self, from: bytes, at: entry),
+                    firstMessage: QueueArchive.read(UInt64.self, from: bytes, at: entry + 8),
+                    messageCount: QueueArchive.read(UInt32.self, from: bytes, at: entry + 16)
+                )
+            }
+        }
+        self.messageCount = Int(messageCount)
+    }
+
+    deinit {
+        try? fileHandle.close()
+    }
+
+    // MARK: - Reading
+
+    /// Read every record of a block
+    /// - Parameter block: Index of the block
+    /// - Throws: MQError.invalidConfiguration if the block is damaged, or a file error
+    func records(inBlock block: Int) throws -> [QueueArchive.Record] {
+        let entry = blocks[block]
+        try fileHandle.seek(toOffset: entry.offset)
+
+        let header = try fileHandle.read(upToCount: QueueArchive.blockHeaderLength) ?? Data()
+        guard header.count == QueueArchive.blockHeaderLength else {
+            throw QueueArchive.invalidArchive("truncated block \(block)")
+        }
+        let (storedLength, rawLength, count, flags) = header.withUnsafeBytes { bytes in
+            (
+                Int(QueueArchive.read(UInt32.self, from: bytes, at: 0)),
+                Int(QueueArchive.read(UInt32.self, from: bytes, at: 4)),
+                Int(QueueArchive.read(UInt32.self, from: bytes, at: 8)),
+                QueueArchive.read(UInt32.self, from: bytes, at: 12)
+            )
+        }
+
+        var body = try fileHandle.read(upToCount: storedLength) ?? Data()
+        guard body.count == storedLength else {
+            throw QueueArchive.invalidArchive("truncated block \(block)")
+        }
+        if flags & QueueArchive.compressedFlag != 0 {
+            guard let decompressed = try? (body as NSData).decompressed(using: .lzfse) as Data else {
+                throw QueueArchive.invalidArchive("block \(block) cannot be decompressed")
+            }
+            body = decompressed
+        }
+        guard body.count == rawLength else {
+            throw QueueArchive.invalidArchive("block \(block) has the wrong length")
+        }
+
+        return try body.withUnsafeBytes { bytes in
+            try Self.decodeRecords(count: count, from: bytes, block: block)
+        }
+    }
+
+    /// Read the records from a message to the end of its block
+    /// The block is found through the index, so nothing before it is read
+    /// - Parameter message: Index of the message in the archive
+    /// - Returns: The block's records from the message on, empty past the end of the archive
+    func records(from message: Int) throws -> [QueueArchive.Record] {
+        guard let block = block(containing: message) else { return [] }
+        return Array(try records(inBlock: block).dropFirst(message - Int(blocks[block].firstMessage)))
+    }
+
+    /// Index of the block holding a message
+    func block(containing message: Int) -> Int? {
+        guard message >= 0, message < messageCount else { return nil }
+
+        // Binary search for the last block starting at or before the message
+        var low = 0
+        var high = blocks.count - 1
+        while low < high {
+            let middle = (low + high + 1) / 2
+            if blocks[middle].firstMessage <= UInt64(message) {
+                low = middle
+            } else {
+                high = middle - 1
+            }
+        }
+        return low
+    }
+
+    /// Decode the records of a block body
+    private static func decodeRecords(
+        count: Int,
+        from bytes: UnsafeRawBufferPointer,
+        block: Int
+    ) throws -> [QueueArchive.Record] {
+        var records: [QueueArchive.Record] = []
+        records.reserveCapacity(count)
+        var offset = 0
+
+        for _ in 0..<count {
+            guard offset + 4 <= bytes.count else { throw QueueArchive.invalidArchive("damaged block \(block)") }
+            let descriptorLength = Int(QueueArchive.read(UInt32.self, from: bytes, at: offset))
+            offset += 4
+            guard descriptorLength == QueueArchive.descriptorLength, offset + descriptorLength + 4 <= bytes.count else {
+                throw QueueArchive.invalidArchive("damaged block \(block)")
+            }
+
+            var descriptor = MQMD()
+            withUnsafeMutableBytes(of: &descriptor) { target in
+                target.copyMemory(from: UnsafeRawBufferPointer(rebasing: bytes[offset..<offset + descriptorLength]))
+            }
+            offset += descriptorLength
+
+            let payloadLength = Int(QueueArchive.read(UInt32.self, from: bytes, at: offset))
+            offset += 4
+            guard offset + payloadLength <= bytes.count else {
+                throw QueueArchive.invalidArchive("damaged block \(block)")
+            }
+            let payload = Data(UnsafeRawBufferPointer(rebasing: bytes[offset..<offset + payloadLength]))
+            offset += payloadLength
+
+            records.append(QueueArchive.Record(descriptor: descriptor, payload: payload))
+        }
+        return records
+    }
+}
@@ -0,0 +1,233 @@
+import Foundation
+
+// MARK: - Queue Depth Monitor
+
+/// Background poller of the depth and open counts of the local queues of one queue manager
+///
+/// Each tick sends one PCF MQCMD_INQUIRE_Q_STATUS request (see
+/// MQServiceProtocol.inquireQueueDepths) instead of relisting every queue with
+/// all its attributes. Every queue has its own poll interval: a queue whose
+/// values changed is polled again after the minimum interval, and each poll
+/// that finds it unchanged doubles the interval up to the maximum. A tick asks
+/// only for the queues that are due, naming the one queue or the generic
+/// prefix they share, so busy queues are followed closely while idle ones cost
+/// almost nothing.
+///
+/// Only queues whose values changed are handed to onUpdate, so a list can
+/// replace just those rows. Every poll also adds a sample to the queue's
+/// QueueDepthHistory, which feeds sparklines and rates without further MQ calls.
+@MainActor
+public final class QueueDepthMonitor {
+
+    // MARK: - Types
+
+    /// Poll intervals and history size
+    public struct Policy: Equatable, Sendable {
+        /// Interval of a queue whose values just changed, in seconds
+        public var minimumInterval: TimeInterval
+
+        /// Longest interval an idle queue backs off to, in seconds
+        public var maximumInterval: TimeInterval
+
+        /// Samples kept per queue
+        public var historyCapacity: Int
+
+        public init(minimumInterval: TimeInterval = 2, maximumInterval: TimeInterval = 60, historyCapacity: Int = 120) {
+            self.minimumInterval = max(minimumInterval, 0.1)
+            self.maximumInterval = max(maximumInterval, self.minimumInterval)
+            self.historyCapacity = historyCapacity
+        }
+    }
+
+    /// When a queue is polled next
+    private struct Schedule {
+        var interval: TimeInterval
+        var nextPoll: Date
+    }
+
+    // MARK: - Properties
+
+    /// Poll intervals and history size
+    public let policy: Policy
+
+    /// Called on the main actor with the queues whose depth or open counts changed
+    public var onUpdate: (([Queue]) -> Void)?
+
+    /// Error of the last poll, nil once a poll succeeds
+    public private(set) var lastError: Error?
+
+    /// Depth samples of every monitored queue, keyed by queue name
+    public private(set) var histories: [String: QueueDepthHistory] = [:]
+
+    /// Last published state of every monitored queue, keyed by queue name
+    private var queues: [String: Queue] = [:]
+
+    /// Poll schedule of every monitored queue, keyed by queue name
+    private var schedules: [String: Schedule] = [:]
+
+    /// Polling loop, nil when stopped
+    private var task: Task<Void, Never>?
+
+    // MARK: - Dependencies
+
+    /// MQ service the depths are read through
+    private let mqService: MQServiceProtocol
+
+    // MARK: - Initialization
+
+    /// Create a stopped monitor
+    /// - Parameters:
+    ///   - mqService: MQ service connected to the queue manager
+    ///   - policy: Poll intervals and history size
+    public init(mqService: MQServiceProtocol, policy: Policy = Policy()) {
+        self.mqService = mqService
+        self.policy = policy
+    }
+
+    // MARK: - Lifecycle
+
+    /// Whether the polling loop is running
+    public var isRunning: Bool {
+        task != nil
+    }
+
+    /// Start, or restart, monitoring the local queues of a freshly listed queue set
+    /// Histories of queues still in the set are kept; every queue is first polled after the minimum interval.
+    /// With no local queues in the set the loop ends at once, and the next start begins a new one
+    /// - Parameter queues: Queues as last listed
+    public func start(with queues: [Queue]) {
+        track(queues, from: Date())
+        guard task == nil else { return }
+
+        task = Task { [weak self] in
+            while !Task.isCancelled {
+                guard let delay = self?.delayUntilNextPoll() else {
+                    // Nothing to poll; a cancelled loop may already have been replaced
+                    if !Task.isCancelled {
+                        self?.task = nil
+                    }
+                    return
+                }
+                if delay > 0 {
+                    try? await Task.sleep(nanoseconds: UInt64(delay * 1_000_000_000))
+                }
+                guard !Task.isCancelled, let self else { return }
+                await self.tick()
+            }
+        }
+    }
+
+    /// Stop polling; histories are kept until the monitor is released
+    public func stop() {
+        task?.cancel()
+        task = nil
+    }
+
+    /// Replace the monitored queue set
+    /// - Parameters:
+    ///   - queues: Queues as last listed; only local queues have a depth
+    ///   - now: Time the first poll is scheduled from
+    func track(_ queues: [Queue], from now: Date) {
+        let localQueues = queues.filter { $0.queueType == .local }
+        self.queues = Dictionary(localQueues.map { ($0.name, $0) }, uniquingKeysWith: { _, last in last })
+
+        let firstPoll = now.addingTimeInterval(policy.minimumInterval)
+        schedules = self.queues.mapValues { _ in
+            Schedule(interval: policy.minimumInterval, nextPoll: firstPoll)
+        }
+        histories = histories.filter { self.queues[$0.key] != nil }
+    }
+
+    /// Seconds until the first queue is due, nil if there is nothing to poll
+    private func delayUntilNextPoll() -> TimeInterval? {
+        guard let nextPoll = schedules.values.map(\.nextPoll).min() else { return nil }
+        return nextPoll.timeIntervalSinceNow
+    }
+
+    /// Poll once and publish the changes
+    private func tick() async {
+        do {
+            let changed = try await poll(at: Date())
+            lastError = nil
+            if !changed.isEmpty {
+                onUpdate?(changed)
+            }
+        } catch MQError.notConnected {
+            stop()
+        } catch {
+            // Try again once the longest interval has passed
+            lastError = error
+            let retry = Date().addingTimeInterval(policy.maximumInterval)
+            for name in schedules.keys {
+                schedules[name]?.nextPoll = retry
+            }
+        }
+    }
+
+    // MARK: - Polling
+
+    /// Read the depth of every queue due at a point in time and reschedule it
+    /// - Parameter now: Time of the poll
+    /// - Returns: The queues whose depth or open counts changed, in their new state
+    /// - Throws: MQError if the inquiry fails
+    func poll(at now: Date) async throws -> [Queue] {
+        let due = schedules.filter { $0.value.nextPoll <= now }.map(\.key)
+        guard !due.isEmpty else { return [] }
+
+        let statuses = try await mqService.inquireQueueDepths(filter: Self.filter(covering: due))
+
+        var changed: [Queue] = []
+        var polled = Set<String>()
+        for status in statuses {
+            // Queues created since the last listing are picked up by the next full refresh
+            guard let queue = queues[status.name], polled.insert(status.name).inserted else { continue }
+
+            histories[status.name, default: QueueDepthHistory(capacity: policy.historyCapacity)]
+                .append(QueueDepthHistory.Sample(time: now, depth: status.currentDepth))
+
+            let isChanged = queue.depth != status.currentDepth
+                || queue.openInputCount != status.openInputCount
+                || queue.openOutputCount != status.openOutputCount
+            reschedule(status.name, isChanged: isChanged, at: now)
+
+            if isChanged {
+                let updated = queue.withStatus(
+                    depth: status.currentDepth,
+                    openInputCount: status.openInputCount,
+                    openOutputCount: status.openOutputCount,
+                    refreshedAt: now
+                )
+                queues[status.name] = updated
+                changed.append(updated)
+            }
+        }
+
+        // Due queues missing from the response were deleted or are no longer local
+        for name in due where !polled.contains(name) {
+            schedules[name] = Schedule(interval: policy.maximumInterval, nextPoll: now.addingTimeInterval(policy.maximumInterval))
+        }
+
+        return changed.sorted { $0.name < $1.name }
+    }
+
+    /// Poll a changed queue again soon and back an unchanged one off
+    private func reschedule(_ name: String, isChanged: Bool, at now: Date) {
+        let previous = schedules[name]?.interval ?? policy.minimumInterval
+        let interval = isChanged ? policy.minimumInterval : min(previous * 2, policy.maximumInterval)
+        schedules[name] = Schedule(interval: interval, nextPoll: now.addingTimeInterval(interval))
+    }
+
+    /// The narrowest queue name filter matching every given name
+    /// One name is inquired by itself; several by the generic name of their common prefix
+    /// - Parameter names: Names of the queues to inquire
+    static func filter(covering names: [String]) -> String {
+        guard let first = names.first else { return "*" }
+        guard names.count > 1 else { return first }
+
+        var prefix = first
+        for name in names.dropFirst() where !prefix.isEmpty {
+            prefix = prefix.commonPrefix(with: name)
+        }
+        return prefix + "*"
+    }
+}
@@ -0,0 +1,135 @@
+import Foundation
+import CMQC
+
+// MARK: - Queue Handle Cache
+
+/// Least-recently-used table of open queue handles, keyed by queue name and open options
+///
+/// Lets repeated operations on the same queue reuse one MQOPEN instead of an
+/// MQOPEN/MQCLOSE pair per call. The cache only does the bookkeeping: handles
+/// it evicts or removes are returned to the caller, which closes them with
+/// MQCLOSE on the connection they belong to.
+///
+/// Only handles opened for inquire, output or browse are cached. A handle
+/// kept open for input would raise the queue's IPPROCS, make other
+/// applications' MQOO_INPUT_EXCLUSIVE opens fail with MQRC_OBJECT_IN_USE and
+/// block CLEAR QLOCAL, so input handles are closed after each operation.
+///
+/// A cache is not thread-safe and must only be used on the thread of the
+/// MQConnection its handles belong to.
+struct QueueHandleCache {
+
+    // MARK: - Types
+
+    /// Queue and MQOO_* options a handle was opened with
+    struct Key: Hashable {
+        let queueName: String
+        let options: MQLONG
+    }
+
+    /// A cached handle and when it was last used
+    private struct Entry {
+        let objectHandle: MQHOBJ
+        var lastUse: UInt64
+    }
+
+    // MARK: - Properties
+
+    /// Maximum number of open handles kept; 0 disables caching
+    let capacity: Int
+
+    /// Cached handles
+    private var entries: [Key: Entry] = [:]
+
+    /// Monotonic use counter ordering the entries by recency
+    private var useCounter: UInt64 = 0
+
+    /// Number of cached handles
+    var count: Int {
+        return entries.count
+    }
+
+    // MARK: - Initialization
+
+    /// Create an empty cache
+    /// - Parameter capacity: Maximum number of open handles kept
+    init(capacity: Int) {
+        self.capacity = max(capacity, 0)
+    }
+
+    // MARK: - Lookup and Insertion
+
+    /// Whether handles opened with these options may stay open between operations
+    /// - Parameter options: MQOO_* options of the handle
+    /// - Returns: false for any of the MQOO_INPUT_* options
+    static func isCacheable(options: MQLONG) -> Bool {
+        return options & (MQOO_INPUT_AS_Q_DEF | MQOO_INPUT_SHARED | MQOO_INPUT_EXCLUSIVE) == 0
+    }
+
+    /// Get the cached handle for a queue and mark it as most recently used
+    /// - Parameter key: Queue name and open options
+    /// - Returns: The open handle, or nil if none is cached
+    mutating func handle(for key: Key) -> MQHOBJ? {
+        guard var entry = entries[key] else {
+            return nil
+        }
+        useCounter += 1
+        entry.lastUse = useCounter
+        entries[key] = entry
+        return entry.objectHandle
+    }
+
+    /// Cache a newly opened handle
+    /// Evicts the least recently used handle when the cache is full
+    /// - Parameters:
+    ///   - objectHandle: Handle returned by MQOPEN
+    ///   - key: Queue name and options it was opened with
+    /// - Returns: Handles the caller must now close: the evicted one, a handle
+    ///   previously cached under the same key, or objectHandle itself if
+    ///   caching is disabled
+    mutating func insert(_ objectHandle: MQHOBJ, for key: Key) -> [MQHOBJ] {
+        guard capacity > 0 else {
+            return [objectHandle]
+        }
+
+        var released: [MQHOBJ] = []
+        if let replaced = entries.removeValue(forKey: key) {
+            released.append(replaced.objectHandle)
+        }
+
+        if entries.count >= capacity,
+           let oldest = entries.min(by: { $0.value.lastUse < $1.value.lastUse }) {
+            entries[oldest.key] = nil
+            released.append(oldest.value.objectHandle)
+        }
+
+        useCounter += 1
+        entries[key] = Entry(objectHandle: objectHandle, lastUse: useCounter)
+        return released
+    }
+
+    // MARK: - Removal
+
+    /// Remove the handle cached for a key
+    /// - Parameter key: Queue name and open options
+    /// - Returns: The handle to close, or nil if none was cached
+    mutating func remove(_ key: Key) -> MQHOBJ? {
+        return entries.removeValue(forKey: key)?.objectHandle
+    }
+
+    /// Remove every handle of a queue, whatever its open options
+    /// - Parameter queueName: Name of the queue
+    /// - Returns: The handles to close
+    mutating func removeAll(queueName: String) -> [MQHOBJ] {
+        let keys = entries.keys.filter { $0.queueName == queueName }
+        return keys.compactMap { entries.removeValue(forKey: $0)?.objectHandle }
+    }
+
+    /// Remove every handle
+    /// - Returns: The handles to close
+    mutating func removeAll() -> [MQHOBJ] {
+        let handles = entries.values.map(\.objectHandle)
+        entries.removeAll()
+        return handles
+    }
+}
@@ -0,0 +1,185 @@
+import Foundation
+
+// MARK: - Queue Snapshot
+
+/// Last known queue list of one connection, as saved by QueueSnapshotCache
+public struct QueueSnapshot: Sendable, Equatable {
+    /// When the queue list was saved
+    public let savedAt: Date
+
+    /// Queues and their attributes at that time
+    public let queues: [Queue]
+
+    public init(savedAt: Date, queues: [Queue]) {
+        self.savedAt = savedAt
+        self.queues = queues
+    }
+}
+
+// MARK: - Queue Snapshot Cache
+
+/// Per-connection files holding the last known queue list, read at startup
+///
+/// Lets the queue list of a connection be shown before it has connected.
+/// Layout, all integers little-endian:
+/// - Header: magic `MQQS`, format version (UInt16), reserved (UInt16), queue
+///   count (UInt32), reserved (UInt32), save time as the bit pattern of a
+///   Double of seconds since the reference date (UInt64)
+/// - One fixed-size 24-byte record per queue: name offset (UInt32) and length
+///   (UInt8) in the name area, flags (UInt8; bit 0 = get inhibited, bit 1 =
+///   put inhibited), queue type (Int16), depth, maximum depth, open input and
+///   open output counts (Int32 each)
+/// - Name area: the UTF-8 queue names back to back
+///
+/// Files are read through a memory mapping and written atomically, so a
+/// snapshot is either the previous or the new one, never a mix.
+public struct QueueSnapshotCache: Sendable {
+
+    // MARK: - Format
+
+    /// Magic at the start of the file
+    static let magic: [UInt8] = Array("MQQS".utf8)
+
+    /// Format version written and understood
+    static let formatVersion: UInt16 = 1
+
+    /// Length of the header
+    static let headerLength = 24
+
+    /// Length of one queue record
+    static let recordLength = 24
+
+    /// Record flag: gets are inhibited
+    static let getInhibitedFlag: UInt8 = 1
+
+    /// Record flag: puts are inhibited
+    static let putInhibitedFlag: UInt8 = 2
+
+    // MARK: - Properties
+
+    /// Directory holding one file per connection
+    public let directory: URL
+
+    // MARK: - Initialization
+
+    /// Create a cache over a directory, created on the first save
+    /// - Parameter directory: Directory of the snapshot files (defaults to the app's Application Support folder)
+    public init(directory: URL? = nil) {
+        self.directory = directory ?? FileManager.default
+            .urls(for: .applicationSupportDirectory, in: .userDomainMask)[0]
+            .appendingPathComponent("MQMate", isDirectory: true)
+            .appendingPathComponent("QueueSnapshots", isDirectory: true)
+    }
+
+    // MARK: - Access
+
+    /// Read the snapshot of a connection
+    /// - Parameter id: The connection configuration ID
+    /// - Returns: The snapshot, or nil if there is none or the file is not readable
+    public func snapshot(for id: UUID) -> QueueSnapshot? {
+        guard let data = try? Data(contentsOf: fileURL(for: id), options: .alwaysMapped) else {
+            return nil
+        }
+        return Self.decode(data)
+    }
+
+    /// Replace the snapshot of a connection
+    /// - Parameters:
+    ///   - queues: The queue list to save
+    ///   - id: The connection configuration ID
+    ///   - date: When the queue list was read
+    /// - Throws: A file error if the snapshot cannot be written
+    public func save(_ queues: [Queue], for id: UUID, at date: Date = Date()) throws {
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        try Self.encode(queues, savedAt: date).write(to: fileURL(for: id), options: .atomic)
+    }
+
+    /// Delete the snapshot of a connection, if any
+    /// - Parameter id: The connection configuration ID
+    public func removeSnapshot(for id: UUID) {
+        try? FileManager.default.removeItem(at: fileURL(for: id))
+    }
+
+    /// File of a connection's snapshot
+    private func fileURL(for id: UUID) -> URL {
+        directory.appendingPathComponent("\(id.uuidString).mqsnap")
+    }
+
+    // MARK: - Encoding
+
+    /// Encode a queue list in the snapshot format
+    static func encode(_ queues: [Queue], savedAt: Date) -> Data {
+        var records = Data()
+        records.reserveCapacity(queues.count * recordLength)
+        var names = Data()
+
+        for queue in queues {
+            let name = Data(queue.name.utf8.prefix(Int(UInt8.max)))
+            var flags: UInt8 = 0
+            if queue.getInhibited { flags |= getInhibitedFlag }
+            if queue.putInhibited { flags |= putInhibitedFlag }
+
+            QueueArchive.append(UInt32(names.count), to: &records)
+            QueueArchive.append(UInt8(name.count), to: &records)
+            QueueArchive.append(flags, to: &records)
+            QueueArchive.append(Int16(clamping: queue.queueType.rawValue), to: &records)
+            QueueArchive.append(queue.depth, to: &records)
+            QueueArchive.append(queue.maxDepth, to: &records)
+            QueueArchive.append(queue.openInputCount, to: &records)
+            QueueArchive.append(queue.openOutputCount, to: &records)
+            names.append(name)
+        }
+
+        var data = Data(magic)
+        QueueArchive.append(formatVersion, to: &data)
+        QueueArchive.append(UInt16(0), to: &data)
+        QueueArchive.append(UInt32(queues.count), to: &data)
+        QueueArchive.append(UInt32(0), to: &data)
+        QueueArchive.append(savedAt.timeIntervalSinceReferenceDate.bitPattern, to: &data)
+        data.append(records)
+        data.append(names)
+        return data
+    }
+
+    /// Decode a snapshot file
+    /// - Returns: The snapshot, or nil if the data is not a complete snapshot of this version
+    static func decode(_ data: Data) -> QueueSnapshot? {
+        data.withUnsafeBytes { bytes -> QueueSnapshot? in
+            guard bytes.count >= headerLength,
+                  Array(bytes.prefix(4)) == magic,
+                  QueueArchive.read(UInt16.self, from: bytes, at: 4) == formatVersion else {
+                return nil
+            }
+
+            let count = Int(QueueArchive.read(UInt32.self, from: bytes, at: 8))
+            let savedAt = Date(timeIntervalSinceReferenceDate: Double(
+                bitPattern: QueueArchive.read(UInt64.self, from: bytes, at: 16)
+            ))
+            let namesStart = headerLength + count * recordLength
+            guard namesStart <= bytes.count else { return nil }
+
+            var queues: [Queue] = []
+            queues.reserveCapacity(count)
+            for index in 0..<count {
+                let record = headerLength + index * recordLength
+                let nameStart = namesStart + Int(QueueArchive.read(UInt32.self, from: bytes, at: record))
+                let nameEnd = nameStart + Int(QueueArchive.read(UInt8.self, from: bytes, at: record + 4))
+                guard nameEnd <= bytes.count else { return nil }
+
+                let flags = QueueArchive.read(UInt8.self, from: bytes, at: record + 5)
+                queues.append(Queue(
+                    name: String(decoding: UnsafeRawBufferPointer(rebasing: bytes[nameStart..<nameEnd]), as: UTF8.self),
+                    queueType: MQQueueType(rawValue: Int32(QueueArchive.read(Int16.self, from: bytes, at: record + 6))),
+                    depth: QueueArchive.read(Int32.self, from: bytes, at: record + 8),
+                    maxDepth: QueueArchive.read(Int32.self, from: bytes, at: record + 12),
+                    getInhibited: flags & getInhibitedFlag != 0,
+                    putInhibited: flags & putInhibitedFlag != 0,
+                    openInputCount: QueueArchive.read(Int32.self, from: bytes, at: record + 16),
+                    openOutputCount: QueueArchive.read(Int32.self, from: bytes, at: record + 20),
+                    lastRefreshedAt: savedAt
+                ))
+            }
+            return QueueSnapshot(savedAt: savedAt, queues: queues)
+        }
+    }
+}
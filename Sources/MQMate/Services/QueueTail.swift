@@ -0,0 +1,424 @@
+import Foundation
+import CMQC
+
+// MARK: - Queue Tail
+
+/// Live tail of one queue built on the MQ asynchronous consume API
+///
+/// Registers a message consumer with MQCB and starts it with MQCTL, so the
+/// queue manager pushes every newly arrived message to a callback instead of
+/// the client polling with MQGET. In browse mode the queue is opened for
+/// browsing and the cursor is first moved past the messages already on the
+/// queue, so only arrivals are reported and nothing is removed. In destructive
+/// mode the queue is opened for input and every delivered message is removed.
+///
+/// Callbacks run on threads owned by the MQ client. Messages are collected
+/// under a lock and handed on at most once per frame interval, so a burst of
+/// arrivals becomes a single UI update rather than one per message.
+///
+/// Moving past the existing messages reads their descriptors, one MQGET each,
+/// so starting a browse tail on a deep queue takes as long as skipping that
+/// many messages does. The count is the CURDEPTH inquired at start, so messages
+/// arriving while the cursor moves are delivered rather than skipped as well.
+///
+/// Once started, the connection handle may only be used for MQCTL until the
+/// consumer is stopped, so a tail needs a connection of its own.
+/// start(on:) and stop(on:) must run on that connection's thread.
+final class QueueTail: @unchecked Sendable {
+
+    // MARK: - Properties
+
+    /// Name of the tailed queue
+    let queueName: String
+
+    /// Whether arrivals are browsed or removed
+    let mode: MQService.TailMode
+
+    /// Largest payload delivered per message; longer messages are truncated
+    let maxMessageSize: Int
+
+    /// Whether payloads are converted with MQGMO_CONVERT
+    let convertsData: Bool
+
+    /// Interval over which arrivals are coalesced into one batch
+    static let frameInterval: TimeInterval = 1.0 / 60
+
+    /// Receives every coalesced batch of messages
+    private let onMessages: @Sendable ([MQService.MQMessage]) -> Void
+
+    /// Browse cursor in browse mode; the consumer continues from its position
+    private var cursor: BrowseCursor?
+
+    /// Queue handle the consumer is registered on
+    private var objectHandle: MQHOBJ = MQHO_UNUSABLE_HOBJ
+
+    /// Whether the consumer is registered, holding a reference to the tail
+    private var isRegistered = false
+
+    /// Whether message delivery has been started
+    private var isStarted = false
+
+    /// Position of the next delivered message; only touched by callbacks,
+    /// which the MQ client delivers one at a time
+    private var nextPosition = 0
+
+    /// Guards the fields below, shared between callback and caller threads
+    private let lock = NSLock()
+
+    /// Messages delivered since the last batch was handed on
+    private var pending: [MQService.MQMessage] = []
+
+    /// Whether a flush of pending is already scheduled
+    private var isFlushScheduled = false
+
+    /// Error reported by the queue manager; ends the tail
+    private var failure: MQError?
+
+    /// Resumed once the tail has failed or been ended
+    private var endContinuation: CheckedContinuation<Void, Never>?
+
+    /// Whether the tail has failed or been ended
+    private var isEnded = false
+
+    // MARK: - Initialization
+
+    /// Create a tail; nothing is opened until start(on:)
+    /// - Parameters:
+    ///   - queueName: Name of the queue to tail
+    ///   - mode: Whether arrivals are browsed or removed
+    ///   - maxMessageSize: Largest payload delivered per message in bytes
+    ///   - convertsData: Whether payloads are converted with MQGMO_CONVERT
+    ///   - onMessages: Receives every coalesced batch, on an arbitrary thread
+    init(
+        queueName: String,
+        mode: MQService.TailMode,
+        maxMessageSize: Int,
+        convertsData: Bool = true,
+        onMessages: @escaping @Sendable ([MQService.MQMessage]) -> Void
+    ) {
+        self.queueName = queueName
+        self.mode = mode
+        self.maxMessageSize = maxMessageSize
+        self.convertsData = convertsData
+        self.onMessages = onMessages
+    }
+
+    // MARK: - Lifecycle
+
+    /// Open the queue, register the consumer and start message delivery
+    /// - Parameter connection: Connection the tail owns; must be called on its thread
+    /// - Throws: MQError if the queue cannot be opened or the consumer cannot be started
+    func start(on connection: MQConnection) throws {
+        switch mode {
+        case .browse:
+            // Arrivals are messages after those on the queue now, so the cursor skips those first.
+            // Skipping to the end instead would never finish while messages keep arriving
+            let depth = try currentDepth(on: connection)
+            let cursor = try BrowseCursor(connectionHandle: connection.handle, queueName: queueName, maxMessageSize: 0)
+            nextPosition = try cursor.skip(depth)
+            self.cursor = cursor
+            objectHandle = cursor.objectHandle
+        case .destructive:
+            objectHandle = try connection.openQueue(
+                queueName: queueName,
+                options: MQOO_INPUT_SHARED | MQOO_FAIL_IF_QUIESCING
+            )
+        }
+
+        do {
+            try register(on: connection)
+            try control(MQOP_START, on: connection)
+        } catch {
+            stop(on: connection)
+            throw error
+        }
+        isStarted = true
+    }
+
+    /// Stop message delivery and close the queue. Safe to call more than once
+    /// Messages still pending are handed on before returning
+    /// - Parameter connection: Connection the tail was started on; must be called on its thread
+    func stop(on connection: MQConnection) {
+        if isStarted {
+            isStarted = false
+
+            // MQCTL STOP waits for a callback in progress, so none runs after it returns
+            try? control(MQOP_STOP, on: connection)
+        }
+        closeQueue(on: connection)
+
+        // Closing the handle deregistered the consumer
+        if isRegistered {
+            isRegistered = false
+            Unmanaged.passUnretained(self).release()
+        }
+        flush()
+    }
+
+    /// Wait until the tail fails or end() is called
+    /// - Throws: The MQError that ended delivery, if any
+    func waitUntilEnded() async throws {
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            lock.lock()
+            if isEnded {
+                lock.unlock()
+                continuation.resume()
+            } else {
+                endContinuation = continuation
+                lock.unlock()
+            }
+        }
+
+        lock.lock()
+        let failure = failure
+        lock.unlock()
+        if let failure {
+            throw failure
+        }
+    }
+
+    /// End the tail; waitUntilEnded() returns
+    func end() {
+        finish(with: nil)
+    }
+
+    // MARK: - MQI Calls
+
+    /// Number of messages on the queue, inquired with MQINQ
+    private func currentDepth(on connection: MQConnection) throws -> Int {
+        var objectHandle = try connection.openQueue(
+            queueName: queueName,
+            options: MQOO_INQUIRE | MQOO_FAIL_IF_QUIESCING
+        )
+        defer { connection.closeQueue(&objectHandle) }
+
+        var selectors: [MQLONG] = [MQIA_CURRENT_Q_DEPTH]
+        var intAttrs: [MQLONG] = [0]
+        var charAttrs = [MQCHAR]()
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        let call = MQInstrumentation.shared.begin(.inquire)
+        MQINQ(connection.handle, objectHandle, 1, &selectors, 1, &intAttrs, 0, &charAttrs, &compCode, &reason)
+        MQInstrumentation.shared.end(call, .inquire, connection: connection.handle, queue: queueName, compCode: compCode, reason: reason)
+
+        guard compCode != MQCC_FAILED else {
+            throw MQError.operationFailed(
+                operation: "MQINQ(\(queueName))",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+        return Int(intAttrs[0])
+    }
+
+    /// Register the message consumer on the queue handle with MQCB
+    private func register(on connection: MQConnection) throws {
+        var callbackDescriptor = MQCBD()
+        callbackDescriptor.Version = MQCBD_VERSION_1
+        callbackDescriptor.CallbackType = MQCBT_MESSAGE_CONSUMER
+        callbackDescriptor.Options = MQCBDO_FAIL_IF_QUIESCING
+        callbackDescriptor.CallbackFunction = unsafeBitCast(queueTailCallback, to: UnsafeMutableRawPointer.self)
+        callbackDescriptor.MaxMsgLength = MQLONG(clamping: maxMessageSize)
+
+        // The registration holds a reference, released in stop(on:), so callbacks never see a freed tail
+        callbackDescriptor.CallbackArea = Unmanaged.passRetained(self).toOpaque()
+
+        var messageDescriptor = MQMD.template
+
+        // Version 3 returns the MsgToken of every delivered message
+        var getOptions = MQGMO.template
+        getOptions.Version = MQGMO_VERSION_3
+        getOptions.Options = MQGMO_WAIT | MQGMO_NO_SYNCPOINT
+            | MQGMO_ACCEPT_TRUNCATED_MSG | MQGMO_FAIL_IF_QUIESCING
+        if convertsData {
+            getOptions.Options |= MQGMO_CONVERT
+        }
+        if mode == .browse {
+            getOptions.Options |= MQGMO_BROWSE_NEXT
+        }
+        getOptions.WaitInterval = MQWI_UNLIMITED
+
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        let call = MQInstrumentation.shared.begin(.callback)
+        MQCB(
+            connection.handle,
+            MQOP_REGISTER,
+            &callbackDescriptor,
+            objectHandle,
+            &messageDescriptor,
+            &getOptions,
+            &compCode,
+            &reason
+        )
+        MQInstrumentation.shared.end(call, .callback, connection: connection.handle, queue: queueName, compCode: compCode, reason: reason)
+
+        guard compCode != MQCC_FAILED else {
+            Unmanaged.passUnretained(self).release()
+            throw MQError.operationFailed(
+                operation: "MQCB(\(queueName))",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+        isRegistered = true
+    }
+
+    /// Start or stop message delivery on the connection with MQCTL
+    private func control(_ operation: MQLONG, on connection: MQConnection) throws {
+        var controlOptions = MQCTLO()
+        controlOptions.Version = MQCTLO_VERSION_1
+        controlOptions.Options = MQCTLO_FAIL_IF_QUIESCING
+
+        var compCode: MQLONG = MQCC_OK
+        var reason: MQLONG = MQRC_NONE
+
+        let call = MQInstrumentation.shared.begin(.control)
+        MQCTL(connection.handle, operation, &controlOptions, &compCode, &reason)
+        MQInstrumentation.shared.end(call, .control, connection: connection.handle, queue: queueName, compCode: compCode, reason: reason)
+
+        guard compCode != MQCC_FAILED else {
+            throw MQError.operationFailed(
+                operation: "MQCTL(\(queueName))",
+                completionCode: compCode,
+                reasonCode: reason
+            )
+        }
+    }
+
+    /// Close the queue handle, which also deregisters the consumer
+    private func closeQueue(on connection: MQConnection) {
+        if let cursor {
+            cursor.close()
+            self.cursor = nil
+            objectHandle = MQHO_UNUSABLE_HOBJ
+        } else {
+            connection.closeQueue(&objectHandle)
+        }
+    }
+
+    // MARK: - Callbacks
+
+    /// Handle one callback invocation; runs on an MQ client thread
+    fileprivate func receive(
+        messageDescriptor: UnsafeMutableRawPointer?,
+        getOptions: UnsafeMutableRawPointer?,
+        buffer: UnsafeMutableRawPointer?,
+        context: MQCBC
+    ) {
+        switch context.CallType {
+        case MQCBCT_MSG_REMOVED, MQCBCT_MSG_NOT_REMOVED:
+            // A truncated payload is expected: MaxMsgLength limits what is delivered
+            if context.CompCode == MQCC_FAILED && context.Reason != MQRC_TRUNCATED_MSG_FAILED {
+                fail(context)
+                return
+            }
+            guard let messageDescriptor, let getOptions else { return }
+
+            let receivedLength = max(min(Int(context.DataLength), Int(context.BufferLength)), 0)
+            let payload = buffer.map { Data(bytes: $0, count: receivedLength) } ?? Data()
+
+            let getMessageOptions = getOptions.assumingMemoryBound(to: MQGMO.self).pointee
+            let messageToken = withUnsafeBytes(of: getMessageOptions.MsgToken) { Array($0) }
+
+            let message = MQService.MQMessage(
+                messageDescriptor: messageDescriptor.assumingMemoryBound(to: MQMD.self).pointee,
+                payload: payload,
+                totalLength: Int(context.DataLength),
+                messageToken: messageToken,
+                position: nextPosition
+            )
+            nextPosition += 1
+            enqueue(message)
+
+        case MQCBCT_EVENT_CALL:
+            // Event calls report connection-level conditions such as a broken or quiescing connection
+            if context.CompCode == MQCC_FAILED {
+                fail(context)
+            }
+
+        default:
+            break
+        }
+    }
+
+    /// Record a failure reported to a callback and end the tail
+    private func fail(_ context: MQCBC) {
+        finish(with: MQError.operationFailed(
+            operation: "MQCB(\(queueName))",
+            completionCode: context.CompCode,
+            reasonCode: context.Reason
+        ))
+    }
+
+    /// Mark the tail ended and wake the waiter
+    private func finish(with error: MQError?) {
+        lock.lock()
+        guard !isEnded else {
+            lock.unlock()
+            return
+        }
+        isEnded = true
+        failure = error
+        let continuation = endContinuation
+        endContinuation = nil
+        lock.unlock()
+
+        continuation?.resume()
+    }
+
+    // MARK: - Coalescing
+
+    /// Add a message to the pending batch, scheduling a flush if none is due
+    private func enqueue(_ message: MQService.MQMessage) {
+        lock.lock()
+        pending.append(message)
+        let needsFlush = !isFlushScheduled
+        isFlushScheduled = true
+        lock.unlock()
+
+        if needsFlush {
+            DispatchQueue.global(qos: .userInitiated).asyncAfter(deadline: .now() + Self.frameInterval) { [weak self] in
+                self?.flush()
+            }
+        }
+    }
+
+    /// Hand on every pending message as one batch
+    private func flush() {
+        lock.lock()
+        let batch = pending
+        pending = []
+        isFlushScheduled = false
+        lock.unlock()
+
+        if !batch.isEmpty {
+            onMessages(batch)
+        }
+    }
+}
+
+// MARK: - Callback Entry Point
+
+/// Message consumer registered with MQCB
+/// A C function pointer cannot capture context, so the tail is recovered from
+/// the CallbackArea of the callback context
+private let queueTailCallback: @convention(c) (
+    MQHCONN,
+    UnsafeMutableRawPointer?,
+    UnsafeMutableRawPointer?,
+    UnsafeMutableRawPointer?,
+    UnsafeMutablePointer<MQCBC>?
+) -> Void = { _, messageDescriptor, getOptions, buffer, context in
+    guard let context, let callbackArea = context.pointee.CallbackArea else { return }
+
+    let tail = Unmanaged<QueueTail>.fromOpaque(callbackArea).takeUnretainedValue()
+    tail.receive(
+        messageDescriptor: messageDescriptor,
+        getOptions: getOptions,
+        buffer: buffer,
+        context: context.pointee
+    )
+}
@@ -29,14 +29,40 @@ public final class ConnectionManager {
     /// Show error alert flag
     public var showErrorAlert: Bool = false
 
+    /// Poll intervals and history size of the depth monitors started on connect
+    public var depthMonitorPolicy = QueueDepthMonitor.Policy()
+
+    /// Called with the queues of a connection whose depth or open counts changed
+    /// Only the changed queues are passed, so a list can replace just those rows
+    @ObservationIgnored
+    public var onQueuesUpdated: ((UUID, [Queue]) -> Void)?
+
+    /// Background depth monitors of the connected queue managers
+    @ObservationIgnored
+    private var depthMonitors: [UUID: QueueDepthMonitor] = [:]
+
+    /// MQ services of the queue managers, one per connection so each has its own pool
+    @ObservationIgnored
+    private var services: [UUID: MQServiceProtocol] = [:]
+
+    /// Last known queue lists read from or written to the snapshot cache, keyed by connection
+    @ObservationIgnored
+    private var snapshots: [UUID: QueueSnapshot?] = [:]
+
     // MARK: - Dependencies
 
-    /// MQ service for actual IBM MQ operations
-    private let mqService: MQServiceProtocol
+    /// Creates the MQ service of a connection
+    private let makeService: @MainActor () -> MQServiceProtocol
 
     /// Keychain service for credential storage
     private let keychainService: KeychainServiceProtocol
 
+    /// On-disk queue lists shown before a connection is open; nil disables them
+    private let snapshotCache: QueueSnapshotCache?
+
+    /// Serial queue of the snapshot file writes, so saves and removals land in the order they were made
+    private let snapshotWriter = DispatchQueue(label: "com.mqmate.snapshots", qos: .utility)
+
     /// User defaults key for saved connections
     private let savedConnectionsKey = "mqmate.savedConnections"
 
@@ -80,16 +106,25 @@ public final class ConnectionManager {
 
     /// Create a new ConnectionManager with dependencies
     /// - Parameters:
-    ///   - mqService: MQ service for IBM MQ operations (defaults to new instance)
+    ///   - mqService: MQ service shared by every connection (defaults to a new instance per connection)
     ///   - keychainService: Keychain service for credentials (defaults to new instance)
+    ///   - serviceFactory: Creates the MQ service of each connection when no shared service is given
+    ///   - snapshotCache: Cache of the last known queue lists (defaults to the app's; nil disables it)
     public init(
         mqService: MQServiceProtocol? = nil,
-        keychainService: KeychainServiceProtocol? = nil
+        keychainService: KeychainServiceProtocol? = nil,
+        serviceFactory: (@MainActor () -> MQServiceProtocol)? = nil,
+        snapshotCache: QueueSnapshotCache? = QueueSnapshotCache()
     ) {
-        // Note: MQService is @MainActor, so we need to handle this carefully
-        // For production, we'll create the service lazily or pass it in
-        self.mqService = mqService ?? MQService()
+        // An MQService holds the pool of one queue manager, so connections only
+        // share a service when one is injected (previews and tests)
+        if let mqService {
+            self.makeService = { mqService }
+        } else {
+            self.makeService = serviceFactory ?? { MQService() }
+        }
         self.keychainService = keychainService ?? KeychainService()
+        self.snapshotCache = snapshotCache
 
         // Load saved connections
         loadSavedConnections()
@@ -121,6 +156,11 @@ public final class ConnectionManager {
             // Retrieve password from keychain
             let password = try keychainService.retrieve(for: config.keychainKey)
 
+            // Browse settings of this connection apply to the streams it starts
+            let mqService = service(for: id)
+            mqService.setBrowseReadAheadDepth(config.readAheadDepth ?? 0)
+            mqService.setBrowseDataConversion(config.convertsBrowsedData ?? true)
+
             // Perform connection
             try await mqService.connect(
                 queueManager: config.queueManager,
@@ -164,8 +204,14 @@ public final class ConnectionManager {
         queueManager = queueManager.withConnectionState(.disconnecting)
         queueManagers[id] = queueManager
 
+        // Stop polling before the connection goes away
+        depthMonitors.removeValue(forKey: id)?.stop()
+
+        // Keep the queue list as last seen, including the monitor's updates
+        saveSnapshot(of: queueManager.queues, for: id)
+
         // Perform disconnect
-        mqService.disconnect()
+        service(for: id).disconnect()
 
         // Update to disconnected state
         queueManager = queueManager.disconnected()
@@ -200,12 +246,14 @@ public final class ConnectionManager {
     /// Refresh queues for a connected queue manager
     /// - Parameter id: The connection configuration ID
     public func refreshQueues(for id: UUID) async throws {
-        guard var queueManager = queueManagers[id],
-              queueManager.isConnected else {
+        guard queueManagers[id]?.isConnected == true else {
             return
         }
 
-        let queues = try await mqService.listQueues(filter: "*")
+        let queues = try await service(for: id).listQueues(filter: "*")
+
+        // The connection may have been disconnected or deleted while the queues were listed
+        guard let current = queueManagers[id], current.isConnected else { return }
 
         // Convert QueueInfo to Queue model
         let queueModels = queues.map { info in
@@ -221,8 +269,237 @@ public final class ConnectionManager {
             )
         }
 
-        queueManager = queueManager.withQueues(queueModels)
-        queueManagers[id] = queueManager
+        queueManagers[id] = current.withQueues(queueModels)
+        saveSnapshot(of: queueModels, for: id)
+
+        // Follow depth changes between full refreshes
+        depthMonitor(for: id).start(with: queueModels)
+    }
+
+    // MARK: - Queue Snapshots
+
+    /// Last known queue list of a connection, from this session or a previous one
+    /// Shown as stale data until the connection is open and its queues are listed
+    /// - Parameter id: The connection configuration ID
+    /// - Returns: The snapshot, or nil if the connection's queues were never listed
+    public func queueSnapshot(for id: UUID) -> QueueSnapshot? {
+        if let snapshot = snapshots[id] {
+            return snapshot
+        }
+
+        let snapshot = snapshotCache?.snapshot(for: id)
+        snapshots[id] = snapshot
+        return snapshot
+    }
+
+    /// Remember a queue list and write it to the cache on the snapshot writer queue
+    private func saveSnapshot(of queues: [Queue], for id: UUID) {
+        guard let snapshotCache, !queues.isEmpty else { return }
+
+        let snapshot = QueueSnapshot(savedAt: Date(), queues: queues)
+        snapshots[id] = snapshot
+        snapshotWriter.async {
+            try? snapshotCache.save(snapshot.queues, for: id, at: snapshot.savedAt)
+        }
+    }
+
+    /// Forget a connection's queue list and delete its file after any save still being written
+    private func removeSnapshot(for id: UUID) {
+        snapshots.removeValue(forKey: id)
+        guard let snapshotCache else { return }
+
+        snapshotWriter.async {
+            snapshotCache.removeSnapshot(for: id)
+        }
+    }
+
+    /// Wait until every snapshot save and removal made so far has reached the disk
+    func flushSnapshotWrites() {
+        snapshotWriter.sync {}
+    }
+
+    // MARK: - Depth Monitoring
+
+    /// Depth samples of a queue recorded by the connection's depth monitor
+    /// - Parameters:
+    ///   - id: The connection configuration ID
+    ///   - queueName: Name of the queue
+    /// - Returns: The samples, or nil if the queue is not monitored
+    public func depthHistory(for id: UUID, queueName: String) -> QueueDepthHistory? {
+        depthMonitors[id]?.histories[queueName]
+    }
+
+    /// Depth samples of every monitored queue of a connection, keyed by queue name
+    /// - Parameter id: The connection configuration ID
+    public func depthHistories(for id: UUID) -> [String: QueueDepthHistory] {
+        depthMonitors[id]?.histories ?? [:]
+    }
+
+    /// The depth monitor of a connection, created on first use
+    private func depthMonitor(for id: UUID) -> QueueDepthMonitor {
+        if let monitor = depthMonitors[id] {
+            return monitor
+        }
+
+        let monitor = QueueDepthMonitor(mqService: service(for: id), policy: depthMonitorPolicy)
+        monitor.onUpdate = { [weak self] changed in
+            self?.applyQueueUpdates(changed, for: id)
+        }
+        depthMonitors[id] = monitor
+        return monitor
+    }
+
+    /// Merge queues reported changed by a depth monitor and pass them on
+    private func applyQueueUpdates(_ changed: [Queue], for id: UUID) {
+        guard let queueManager = queueManagers[id], queueManager.isConnected else { return }
+        queueManagers[id] = queueManager.withUpdatedQueues(changed)
+        onQueuesUpdated?(id, changed)
+    }
+
+    // MARK: - Fan-Out
+
+    /// Outcome of one queue manager's part of a fan-out operation
+    public struct FanOutResult<Value: Sendable>: Sendable {
+        /// The connection configuration ID
+        public let connectionId: UUID
+
+        /// Name of the queue manager
+        public let queueManager: String
+
+        /// Value returned for the queue manager, or the error it failed with
+        public let result: Result<Value, Error>
+    }
+
+    /// Queue managers a fan-out operation works on at the same time by default
+    public static let defaultFanOutWidth = 8
+
+    /// Run an operation against several queue managers concurrently
+    /// At most maxConcurrent operations run at once; each result is delivered as
+    /// soon as its queue manager responds, so slow or unreachable queue managers
+    /// do not hold back the others. Ending the iteration cancels the rest.
+    /// - Parameters:
+    ///   - ids: Connection configuration IDs to run the operation for
+    ///   - maxConcurrent: Maximum number of operations in flight
+    ///   - operation: Work for one connection, given its ID and MQ service
+    /// - Returns: A stream of one result per connection, in completion order
+    public func fanOut<Value: Sendable>(
+        to ids: [UUID],
+        maxConcurrent: Int = ConnectionManager.defaultFanOutWidth,
+        _ operation: @escaping @Sendable @MainActor (UUID, MQServiceProtocol) async throws -> Value
+    ) -> AsyncStream<FanOutResult<Value>> {
+        let width = max(maxConcurrent, 1)
+
+        return AsyncStream { continuation in
+            let task = Task { @MainActor in
+                await withTaskGroup(of: FanOutResult<Value>.self) { group in
+                    // Start the first batch, then one more as each finishes
+                    for id in ids.prefix(width) {
+                        group.addTask { await self.run(operation, for: id) }
+                    }
+                    var remaining = ids.dropFirst(width)
+                    for await result in group {
+                        continuation.yield(result)
+                        if !Task.isCancelled, let id = remaining.popFirst() {
+                            group.addTask { await self.run(operation, for: id) }
+                        }
+                    }
+                }
+                continuation.finish()
+            }
+            continuation.onTermination = { _ in
+                task.cancel()
+            }
+        }
+    }
+
+    /// Run a fan-out operation for one connection, capturing its error
+    private func run<Value: Sendable>(
+        _ operation: @MainActor (UUID, MQServiceProtocol) async throws -> Value,
+        for id: UUID
+    ) async -> FanOutResult<Value> {
+        let queueManager = savedConnections.first { $0.id == id }?.queueManager ?? ""
+        do {
+            let value = try await operation(id, service(for: id))
+            return FanOutResult(connectionId: id, queueManager: queueManager, result: .success(value))
+        } catch {
+            return FanOutResult(connectionId: id, queueManager: queueManager, result: .failure(error))
+        }
+    }
+
+    /// Connect to several queue managers concurrently, listing the queues of each
+    /// - Parameters:
+    ///   - ids: Connection configuration IDs; defaults to every saved connection not yet connected
+    ///   - maxConcurrent: Maximum number of connections opened at once
+    /// - Returns: A stream of one result per connection, in completion order
+    public func connectAll(
+        ids: [UUID]? = nil,
+        maxConcurrent: Int = ConnectionManager.defaultFanOutWidth
+    ) -> AsyncStream<FanOutResult<Void>> {
+        let targets = ids ?? savedConnections.map(\.id).filter { !isConnected(id: $0) }
+        return fanOut(to: targets, maxConcurrent: maxConcurrent) { [weak self] id, _ in
+            try await self?.connect(id: id)
+        }
+    }
+
+    /// Refresh the queues of several connected queue managers concurrently
+    /// - Parameters:
+    ///   - ids: Connection configuration IDs; defaults to every connected queue manager
+    ///   - maxConcurrent: Maximum number of refreshes in flight
+    /// - Returns: A stream of one result per connection, in completion order
+    public func refreshAll(
+        ids: [UUID]? = nil,
+        maxConcurrent: Int = ConnectionManager.defaultFanOutWidth
+    ) -> AsyncStream<FanOutResult<Void>> {
+        let targets = ids ?? connectedIds
+        return fanOut(to: targets, maxConcurrent: maxConcurrent) { [weak self] id, _ in
+            try await self?.refreshQueues(for: id)
+        }
+    }
+
+    /// Look for queues on every connected queue manager
+    /// - Parameters:
+    ///   - filter: Queue name or generic name (e.g., "APP.ORDERS" or "APP.*")
+    ///   - maxConcurrent: Maximum number of inquiries in flight
+    /// - Returns: A stream of the matching queues of each queue manager, in completion order
+    public func findQueues(
+        matching filter: String,
+        maxConcurrent: Int = ConnectionManager.defaultFanOutWidth
+    ) -> AsyncStream<FanOutResult<[Queue]>> {
+        fanOut(to: connectedIds, maxConcurrent: maxConcurrent) { _, service in
+            try await service.listQueues(filter: filter).map { info in
+                Queue(
+                    name: info.name,
+                    queueType: info.queueType,
+                    depth: info.currentDepth,
+                    maxDepth: info.maxDepth,
+                    getInhibited: info.inhibitGet,
+                    putInhibited: info.inhibitPut,
+                    openInputCount: info.openInputCount,
+                    openOutputCount: info.openOutputCount
+                )
+            }
+        }
+    }
+
+    /// Read the depth of matching local queues on every connected queue manager
+    /// Sum the values as they arrive for the total across a cluster
+    /// - Parameters:
+    ///   - filter: Queue name or generic name
+    ///   - maxConcurrent: Maximum number of inquiries in flight
+    /// - Returns: A stream of the total depth of the matching queues of each queue manager
+    public func totalDepth(
+        ofQueuesMatching filter: String,
+        maxConcurrent: Int = ConnectionManager.defaultFanOutWidth
+    ) -> AsyncStream<FanOutResult<Int64>> {
+        fanOut(to: connectedIds, maxConcurrent: maxConcurrent) { _, service in
+            try await service.inquireQueueDepths(filter: filter)
+                .reduce(Int64(0)) { total, status in total + Int64(status.currentDepth) }
+        }
+    }
+
+    /// IDs of the connected queue managers, in saved order
+    private var connectedIds: [UUID] {
+        savedConnections.map(\.id).filter { isConnected(id: $0) }
     }
 
     // MARK: - Connection Configuration Management
@@ -315,6 +592,8 @@ public final class ConnectionManager {
 
         // Remove queue manager instance
         queueManagers.removeValue(forKey: id)
+        services.removeValue(forKey: id)
+        removeSnapshot(for: id)
 
         // Clear selection if this was selected
         if selectedConnectionId == id {
@@ -400,6 +679,17 @@ public final class ConnectionManager {
 
     // MARK: - Private Methods
 
+    /// The MQ service of a connection, created on first use
+    private func service(for id: UUID) -> MQServiceProtocol {
+        if let service = services[id] {
+            return service
+        }
+
+        let service = makeService()
+        services[id] = service
+        return service
+    }
+
     /// Update the last connected timestamp for a connection
     private func updateConnectionLastUsed(id: UUID) {
         guard let index = savedConnections.firstIndex(where: { $0.id == id }) else {
@@ -479,7 +769,8 @@ extension ConnectionManager {
     public static var preview: ConnectionManager {
         let manager = ConnectionManager(
             mqService: MockMQService(),
-            keychainService: MockKeychainService()
+            keychainService: MockKeychainService(),
+            snapshotCache: nil
         )
 
         // Add sample connections
@@ -507,6 +798,18 @@ public final class MockMQService: MQServiceProtocol {
     public var shouldFailConnect: Bool = false
     public var simulatedQueues: [MQService.QueueInfo] = []
 
+    /// Messages returned by browse operations, keyed by queue name
+    public var simulatedMessages: [String: [MQService.MQMessage]] = [:]
+
+    /// Number of browse page requests served
+    public private(set) var browseCallCount = 0
+
+    /// Queue name filters of the depth inquiries served, in order
+    public private(set) var depthInquiryFilters: [String] = []
+
+    /// Simulated browse cursor positions, keyed by queue name
+    private var browseOffsets: [String: Int] = [:]
+
     public init() {
         // Set up default simulated queues
         simulatedQueues = [
@@ -538,7 +841,7 @@ public final class MockMQService: MQServiceProtocol {
         isConnected = false
     }
 
-    public func getQueueInfo(queueName: String) throws -> MQService.QueueInfo {
+    public func getQueueInfo(queueName: String) async throws -> MQService.QueueInfo {
         if let queue = simulatedQueues.first(where: { $0.name == queueName }) {
             return queue
         }
@@ -546,13 +849,13 @@ public final class MockMQService: MQServiceProtocol {
     }
 
     public func listQueues(filter: String) async throws -> [MQService.QueueInfo] {
-        // Simulate network delay
-        try await Task.sleep(nanoseconds: 300_000_000) // 0.3 seconds
-
         guard isConnected else {
             throw MQError.notConnected
         }
 
+        // Simulate network delay; a listing already sent still answers after a disconnect
+        try await Task.sleep(nanoseconds: 300_000_000) // 0.3 seconds
+
         return simulatedQueues
     }
 
@@ -668,4 +971,104 @@ public final class MockMQService: MQServiceProtocol {
 
         // Mock implementation - pretend message was deleted successfully
     }
+
+    public func processMessages(
+        queueName: String,
+        messageIds: [[UInt8]],
+        action: MQService.BulkMessageAction,
+        commitInterval: Int,
+        progress: (@MainActor (MQService.BulkBatchResult) -> Void)?
+    ) async throws -> [MQService.BulkBatchResult] {
+        guard isConnected else {
+            throw MQError.notConnected
+        }
+
+        // Acts on the simulated messages, one simulated unit of work per batch
+        let batchSize = max(commitInterval, 1)
+        var results: [MQService.BulkBatchResult] = []
+        for startIndex in stride(from: 0, to: messageIds.count, by: batchSize) {
+            let batch = messageIds[startIndex..<min(startIndex + batchSize, messageIds.count)]
+            var processedIds: [[UInt8]] = []
+            var missingIds: [[UInt8]] = []
+
+            for messageId in batch {
+                guard let index = simulatedMessages[queueName]?.firstIndex(where: { $0.messageId == messageId }),
+                      let message = simulatedMessages[queueName]?[index] else {
+                    missingIds.append(messageId)
+                    continue
+                }
+                if let targetQueue = action.targetQueue {
+                    simulatedMessages[targetQueue, default: []].append(message)
+                }
+                if action.removesMessages {
+                    simulatedMessages[queueName]?.remove(at: index)
+                }
+                processedIds.append(messageId)
+            }
+
+            let result = MQService.BulkBatchResult(
+                startIndex: startIndex,
+                messageCount: batch.count,
+                processedIds: processedIds,
+                missingIds: missingIds,
+                duration: 0
+            )
+            results.append(result)
+            progress?(result)
+        }
+        return results
+    }
+
+    public func browseMessages(queueName: String, maxMessages: Int) async throws -> [MQService.MQMessage] {
+        guard isConnected else {
+            throw MQError.notConnected
+        }
+
+        browseOffsets[queueName] = 0
+        return try await browseNextMessages(queueName: queueName, maxMessages: maxMessages)
+    }
+
+    public func browseNextMessages(queueName: String, maxMessages: Int) async throws -> [MQService.MQMessage] {
+        guard isConnected else {
+            throw MQError.notConnected
+        }
+
+        // Continue from the simulated cursor position
+        let messages = simulatedMessages[queueName] ?? []
+        let start = min(browseOffsets[queueName] ?? 0, messages.count)
+        let end = min(start + maxMessages, messages.count)
+        browseOffsets[queueName] = end
+        browseCallCount += 1
+        return Array(messages[start..<end])
+    }
+
+    public func closeBrowseCursor(queueName: String) {
+        browseOffsets.removeValue(forKey: queueName)
+    }
+
+    public func inquireQueueDepths(filter: String) async throws -> [MQService.QueueDepthStatus] {
+        guard isConnected else {
+            throw MQError.notConnected
+        }
+
+        // Generic names end in a single asterisk
+        depthInquiryFilters.append(filter)
+        let prefix = filter.hasSuffix("*") ? String(filter.dropLast()) : nil
+        return simulatedQueues
+            .filter { info in
+                guard info.queueType == .local else { return false }
+                if let prefix {
+                    return info.name.hasPrefix(prefix)
+                }
+                return info.name == filter
+            }
+            .map { info in
+                MQService.QueueDepthStatus(
+                    name: info.name,
+                    currentDepth: info.currentDepth,
+                    openInputCount: info.openInputCount,
+                    openOutputCount: info.openOutputCount
+                )
+            }
+    }
 }
@@ -0,0 +1,349 @@
+import Foundation
+
+// MARK: - MessageListIndex
+
+/// In-memory index over the message list of a MessageViewModel
+///
+/// Rows are rows of the view model's MessageStore. The index keeps a
+/// position→row dictionary, one presorted row order per sort order (built on
+/// first use from the store's columns and merged with appended rows
+/// afterwards), and the rows
+/// matching the last filter. A filter whose text contains the previous text
+/// only tests the previous matches plus any rows appended since, so typing
+/// into the filter bar narrows the result instead of rescanning the list.
+///
+/// Rows are only ever appended, replaced in place or reindexed as a whole;
+/// every change must be reported so the index stays in step with the list.
+struct MessageListIndex {
+
+    // MARK: - Types
+
+    /// Column a sort order compares
+    private enum SortField: Hashable {
+        case position
+        case putDateTime
+        case payloadSize
+        case priority
+        case messageId
+    }
+
+    /// Key of a presorted row order
+    private struct SortKey: Hashable {
+        let field: SortField
+        let isDescending: Bool
+    }
+
+    /// Rows matching one filter
+    private struct FilterResult {
+        /// Lowercased free text of the filter
+        let text: String
+        /// IDs matched on the client, nil if none were
+        let selector: MQService.MessageSelector?
+        /// Number of rows the filter was applied to
+        let rowCount: Int
+        /// Matching rows, in ascending order
+        let rows: [Int]
+    }
+
+    /// Display list of one filter and sort order
+    private struct DisplayResult {
+        let searchText: String
+        let serverSelector: MQService.MessageSelector
+        let sortOrder: MessageSortOrder
+        let rowCount: Int
+        let revision: Int
+        let messages: MessageRows
+    }
+
+    // MARK: - Properties
+
+    /// Row of every message by queue position
+    private var rowsByPosition: [Int: Int] = [:]
+
+    /// Number of indexed rows
+    private(set) var rowCount = 0
+
+    /// Incremented whenever a row is replaced, so results derived from its old contents are dropped
+    private var revision = 0
+
+    /// Presorted rows per sort key; ties keep row order in either direction
+    private var sortedRows: [SortKey: [Int]] = [:]
+
+    /// Lowercased searchable text of every row, built by the first text filter
+    private var searchKeys: [String] = []
+
+    /// Rows matching the last filter with text or client-matched IDs
+    private var lastFilter: FilterResult?
+
+    /// Display list of the last read
+    private var lastDisplay: DisplayResult?
+
+    /// Display index of every row, -1 if not displayed; built on first lookup
+    private var displayIndexesByRow: [Int]?
+
+    // MARK: - Maintenance
+
+    /// Index a whole list, dropping everything indexed before
+    /// - Parameter messages: The complete message list
+    mutating func reset(_ messages: MessageStore) {
+        let revision = self.revision
+        self = MessageListIndex()
+        self.revision = revision + 1
+        appendRows(in: messages)
+    }
+
+    /// Index the messages appended to the end of the list since the last call
+    /// Presorted orders are merged with the new rows rather than sorted again
+    /// - Parameter messages: The complete message list, ending with the new messages
+    mutating func appendRows(in messages: MessageStore) {
+        let startRow = rowCount
+        guard messages.count > startRow else { return }
+
+        for row in startRow..<messages.count {
+            rowsByPosition[messages.position(at: row)] = row
+        }
+        if !searchKeys.isEmpty {
+            searchKeys.append(contentsOf: messages[startRow...].map(MessageFilter.searchKey(for:)))
+        }
+
+        for (key, rows) in sortedRows {
+            let appendedRows = Array(startRow..<messages.count).sorted { lhs, rhs in
+                Self.precedes(lhs, rhs, in: messages, by: key)
+            }
+            sortedRows[key] = Self.merge(rows, appendedRows, in: messages, by: key)
+        }
+        rowCount = messages.count
+    }
+
+    /// Reindex a row whose message was replaced by a fuller copy with the same id and position
+    /// - Parameters:
+    ///   - row: Row of the replaced message
+    ///   - messages: The complete message list, already holding the new message
+    mutating func replaceRow(_ row: Int, in messages: MessageStore) {
+        if row < searchKeys.count {
+            searchKeys[row] = MessageFilter.searchKey(for: messages[row])
+        }
+
+        // A complete payload changes the size and the searchable text, nothing else
+        sortedRows = sortedRows.filter { $0.key.field != .payloadSize }
+        lastFilter = nil
+        revision += 1
+    }
+
+    // MARK: - Lookups
+
+    /// Row of a message by queue position
+    func row(forPosition position: Int) -> Int? {
+        rowsByPosition[position]
+    }
+
+    /// Index of a message in the display list of the last read
+    /// - Parameter id: Message id
+    /// - Returns: The index, or nil if the message is not displayed
+    mutating func displayIndex(ofId id: String) -> Int? {
+        guard let display = lastDisplay, let row = display.messages.store.row(forId: id) else { return nil }
+        if displayIndexesByRow == nil {
+            var indexes = [Int](repeating: -1, count: rowCount)
+            for (displayIndex, displayedRow) in display.messages.rows.enumerated() {
+                indexes[displayedRow] = displayIndex
+            }
+            displayIndexesByRow = indexes
+        }
+        guard let displayIndex = displayIndexesByRow?[row], displayIndex >= 0 else { return nil }
+        return displayIndex
+    }
+
+    // MARK: - Display List
+
+    /// Messages matching the search text, in the sort order
+    /// Cached until the list, the text or the order changes; messages are
+    /// only built from the store as the returned rows are read
+    /// - Parameters:
+    ///   - messages: The complete message list
+    ///   - searchText: Text of the filter bar
+    ///   - serverSelector: Selector the list was browsed with
+    ///   - sortOrder: Order of the display list
+    /// - Returns: The display list
+    mutating func displayMessages(
+        in messages: MessageStore,
+        searchText: String,
+        serverSelector: MQService.MessageSelector,
+        sortOrder: MessageSortOrder
+    ) -> MessageRows {
+        if let display = lastDisplay, display.searchText == searchText, display.serverSelector == serverSelector,
+           display.sortOrder == sortOrder, display.rowCount == rowCount, display.revision == revision {
+            return display.messages
+        }
+
+        let filter = MessageFilter(searchText: searchText)
+
+        // IDs the list was not browsed with are matched here until it is browsed again
+        let hasIds = filter.selector.messageId != nil || filter.selector.correlationId != nil
+        let idSelector = hasIds && filter.selector != serverSelector ? filter.selector : nil
+
+        let order = rows(sortedBy: sortOrder, in: messages)
+        let displayed: MessageRows
+        if filter.text.isEmpty && idSelector == nil {
+            displayed = MessageRows(store: messages, rows: order)
+        } else {
+            var isMatch = [Bool](repeating: false, count: rowCount)
+            for row in matchingRows(filter, idSelector: idSelector, in: messages) {
+                isMatch[row] = true
+            }
+            displayed = MessageRows(store: messages, rows: order.filter { isMatch[$0] })
+        }
+
+        lastDisplay = DisplayResult(
+            searchText: searchText,
+            serverSelector: serverSelector,
+            sortOrder: sortOrder,
+            rowCount: rowCount,
+            revision: revision,
+            messages: displayed
+        )
+        displayIndexesByRow = nil
+        return displayed
+    }
+
+    /// Rows matching a filter, narrowing the last result when only the text grew
+    private mutating func matchingRows(
+        _ filter: MessageFilter,
+        idSelector: MQService.MessageSelector?,
+        in messages: MessageStore
+    ) -> [Int] {
+        if searchKeys.count < rowCount {
+            searchKeys = messages.map(MessageFilter.searchKey(for:))
+        }
+
+        // Every row matching the longer text also matched the shorter one
+        let text = filter.text.lowercased()
+        let candidates: [Int]
+        if let last = lastFilter, last.selector == idSelector, text.contains(last.text) {
+            candidates = last.rows + Array(last.rowCount..<rowCount)
+        } else {
+            candidates = Array(0..<rowCount)
+        }
+
+        let rows = candidates.filter { row in
+            (idSelector == nil || filter.matchesIds(messages[row]))
+                && (text.isEmpty || searchKeys[row].contains(text))
+        }
+
+        lastFilter = FilterResult(text: text, selector: idSelector, rowCount: rowCount, rows: rows)
+        return rows
+    }
+
+    // MARK: - Sorting
+
+    /// Rows in a sort order, building the presorted order of its key on first use
+    private mutating func rows(sortedBy sortOrder: MessageSortOrder, in messages: MessageStore) -> [Int] {
+        let key = Self.sortKey(for: sortOrder)
+
+        if let rows = sortedRows[key] {
+            return rows
+        }
+        let rows = Array(0..<rowCount).sorted { lhs, rhs in
+            Self.precedes(lhs, rhs, in: messages, by: key)
+        }
+        sortedRows[key] = rows
+        return rows
+    }
+
+    /// Field and direction of a sort order
+    private static func sortKey(for sortOrder: MessageSortOrder) -> SortKey {
+        switch sortOrder {
+        case .position:
+            return SortKey(field: .position, isDescending: false)
+        case .positionDescending:
+            return SortKey(field: .position, isDescending: true)
+        case .dateTime:
+            return SortKey(field: .putDateTime, isDescending: false)
+        case .dateTimeDescending:
+            return SortKey(field: .putDateTime, isDescending: true)
+        case .size:
+            return SortKey(field: .payloadSize, isDescending: true)
+        case .sizeAscending:
+            return SortKey(field: .payloadSize, isDescending: false)
+        case .priority:
+            return SortKey(field: .priority, isDescending: true)
+        case .messageId:
+            return SortKey(field: .messageId, isDescending: false)
+        }
+    }
+
+    /// Whether one row comes before another in a sort order
+    /// Equal keys keep row order whatever the direction
+    private static func precedes(_ lhs: Int, _ rhs: Int, in messages: MessageStore, by key: SortKey) -> Bool {
+        guard let ascending = ascendingOrder(lhs, rhs, in: messages, by: key.field) else {
+            return lhs < rhs
+        }
+        return ascending != key.isDescending
+    }
+
+    /// Whether one row's field is below another's, or nil if the two are equal
+    /// Reads only the field's column, so no message is built while sorting
+    /// Messages without a put time sort after all others in ascending order
+    private static func ascendingOrder(_ lhs: Int, _ rhs: Int, in messages: MessageStore, by field: SortField) -> Bool? {
+        switch field {
+        case .position:
+            let p1 = messages.position(at: lhs), p2 = messages.position(at: rhs)
+            if p1 != p2 { return p1 < p2 }
+        case .putDateTime:
+            switch (messages.putDateTime(at: lhs), messages.putDateTime(at: rhs)) {
+            case let (d1?, d2?) where d1 != d2:
+                return d1 < d2
+            case (.some, nil):
+                return true
+            case (nil, .some):
+                return false
+            default:
+                break
+            }
+        case .payloadSize:
+            let s1 = messages.payloadSize(at: lhs), s2 = messages.payloadSize(at: rhs)
+            if s1 != s2 { return s1 < s2 }
+        case .priority:
+            let p1 = messages.priority(at: lhs), p2 = messages.priority(at: rhs)
+            if p1 != p2 { return p1 < p2 }
+        case .messageId:
+            if messages.messageIdPrecedes(lhs, rhs) { return true }
+            if messages.messageIdPrecedes(rhs, lhs) { return false }
+        }
+        return nil
+    }
+
+    /// Merge two row orders sorted by the same key
+    private static func merge(_ rows: [Int], _ appendedRows: [Int], in messages: MessageStore, by key: SortKey) -> [Int] {
+        // Browsed pages usually continue the order, so most merges are a plain append
+        if let last = rows.last, let first = appendedRows.first, precedes(last, first, in: messages, by: key) {
+            return rows + appendedRows
+        }
+
+        var merged: [Int] = []
+        merged.reserveCapacity(rows.count + appendedRows.count)
+
+        var existing = rows.makeIterator()
+        var appended = appendedRows.makeIterator()
+        var nextExisting = existing.next()
+        var nextAppended = appended.next()
+
+        while let row = nextExisting, let appendedRow = nextAppended {
+            if precedes(appendedRow, row, in: messages, by: key) {
+                merged.append(appendedRow)
+                nextAppended = appended.next()
+            } else {
+                merged.append(row)
+                nextExisting = existing.next()
+            }
+        }
+        while let row = nextExisting {
+            merged.append(row)
+            nextExisting = existing.next()
+        }
+        while let appendedRow = nextAppended {
+            merged.append(appendedRow)
+            nextAppended = appended.next()
+        }
+        return merged
+    }
+}
@@ -12,7 +12,8 @@ public final class MessageViewModel {
     // MARK: - Properties
 
     /// All messages loaded from the queue (via browse operation)
-    public private(set) var messages: [Message] = []
+    /// Held column-wise; a Message is only built for a row when it is read
+    public private(set) var messages = MessageStore()
 
     /// Currently selected message ID
     public var selectedMessageId: String?
@@ -20,21 +21,38 @@ public final class MessageViewModel {
     /// Loading state for message browse operations
     public private(set) var isLoading: Bool = false
 
+    /// Loading state for fetching the next page of messages
+    public private(set) var isLoadingMore: Bool = false
+
+    /// Whether the last page was full, so more messages may follow it on the queue
+    public private(set) var hasMoreMessages: Bool = false
+
+    /// Loading state for fetching the full payload of the selected message
+    public private(set) var isLoadingPayload: Bool = false
+
     /// Name of the currently browsed queue
     public private(set) var currentQueueName: String?
 
     /// Search/filter text for filtering the message list
+    /// Terms the queue manager can evaluate take effect with applyFilter(); see MessageFilter
     public var searchText: String = ""
 
+    /// Selector the current list was browsed with
+    public private(set) var serverSelector = MQService.MessageSelector()
+
     /// Current sort order for the message list
     public var sortOrder: MessageSortOrder = .position
 
     /// Whether to show message payload preview in the list
     public var showPayloadPreview: Bool = true
 
-    /// Maximum number of messages to browse at once
+    /// Maximum number of messages to browse at once (one page)
     public var maxMessagesToLoad: Int = 100
 
+    /// Which payloads of a browse are moved to an on-disk spill file
+    /// Takes effect with the next browse; the spill file is removed with the list
+    public var payloadSpillPolicy: PayloadSpillPolicy = .default
+
     /// Last error encountered during operations
     public private(set) var lastError: Error?
 
@@ -44,44 +62,61 @@ public final class MessageViewModel {
     /// Timestamp of the last successful message refresh
     public private(set) var lastRefreshDate: Date?
 
+    /// Mode of the running live tail, nil when the queue is not tailed
+    public private(set) var tailMode: MQService.TailMode?
+
     // MARK: - Dependencies
 
     /// MQ service for message operations
     private let mqService: MQServiceProtocol
 
+    /// Audit log of bulk operations, one entry per committed batch (nil = not audited)
+    private let auditService: AuditServiceProtocol?
+
+    // MARK: - Browse State
+
+    /// Iterator of the current browse stream, kept to load further messages
+    @ObservationIgnored
+    private var pageIterator: AsyncThrowingStream<[MQService.MQMessage], Error>.Iterator?
+
+    /// Incremented for every new browse, so pages of an abandoned browse are dropped
+    @ObservationIgnored
+    private var browseGeneration = 0
+
+    /// Task consuming the live tail stream
+    @ObservationIgnored
+    private var tailTask: Task<Void, Never>?
+
+    // MARK: - List Index
+
+    /// Lookups, sort orders and filter results over messages
+    /// Every change to messages goes through replaceMessages(_:) or is reported to it
+    @ObservationIgnored
+    private var index = MessageListIndex()
+
+    /// Decoded payloads of listed messages, for the list rows and the detail view
+    public let payloadRepresentations = PayloadRepresentationCache()
+
     // MARK: - Computed Properties
 
     /// Currently selected message
     public var selectedMessage: Message? {
         guard let id = selectedMessageId else { return nil }
-        return messages.first { $0.id == id }
+        return message(withId: id)
     }
 
     /// Filtered and sorted messages for display
-    public var filteredMessages: [Message] {
-        var result = messages
-
-        // Filter by search text
-        if !searchText.isEmpty {
-            let searchLower = searchText.lowercased()
-            result = result.filter { message in
-                // Search in message ID
-                message.messageIdHex.lowercased().contains(searchLower) ||
-                // Search in payload (if text)
-                (message.payloadString?.lowercased().contains(searchLower) ?? false) ||
-                // Search in put application name
-                message.putApplicationName.lowercased().contains(searchLower) ||
-                // Search in format
-                message.format.lowercased().contains(searchLower) ||
-                // Search in reply-to queue
-                message.replyToQueue.lowercased().contains(searchLower)
-            }
-        }
-
-        // Apply sort order
-        result = sortMessages(result)
-
-        return result
+    /// Free text is matched here; IDs are matched here too until the list has
+    /// been browsed again with them, while selection strings only apply once it has.
+    /// Served from the list index, so repeated reads are free and a longer
+    /// filter text only narrows the previous result
+    public var filteredMessages: MessageRows {
+        index.displayMessages(
+            in: messages,
+            searchText: searchText,
+            serverSelector: serverSelector,
+            sortOrder: sortOrder
+        )
     }
 
     /// Number of messages matching current filters
@@ -96,7 +131,7 @@ public final class MessageViewModel {
 
     /// Total payload size across all messages
     public var totalPayloadSize: Int64 {
-        messages.reduce(0) { $0 + Int64($1.payloadSize) }
+        messages.totalPayloadSize
     }
 
     /// Formatted total payload size for display
@@ -106,12 +141,12 @@ public final class MessageViewModel {
 
     /// Number of persistent messages
     public var persistentMessageCount: Int {
-        messages.filter { $0.persistence == .persistent }.count
+        messages.persistentCount
     }
 
     /// Number of request messages (waiting for reply)
     public var requestMessageCount: Int {
-        messages.filter { $0.messageType == .request }.count
+        messages.requestCount
     }
 
     /// Check if the message list is empty
@@ -124,6 +159,16 @@ public final class MessageViewModel {
         !messages.isEmpty && filteredMessages.isEmpty
     }
 
+    /// Whether a live tail is running
+    public var isTailing: Bool {
+        tailMode != nil
+    }
+
+    /// Whether the list was browsed with criteria applied by the queue manager
+    public var isServerFiltered: Bool {
+        !serverSelector.isEmpty
+    }
+
     /// Check if currently browsing a queue
     public var hasBrowsedQueue: Bool {
         currentQueueName != nil
@@ -156,101 +201,327 @@ public final class MessageViewModel {
     /// Index of the currently selected message in the filtered list
     public var selectedMessageIndex: Int? {
         guard let id = selectedMessageId else { return nil }
-        return filteredMessages.firstIndex { $0.id == id }
+        // Brings the index's display list up to date before looking the id up in it
+        _ = filteredMessages
+        return index.displayIndex(ofId: id)
     }
 
     // MARK: - Initialization
 
     /// Create a new MessageViewModel with dependencies
-    /// - Parameter mqService: MQ service for message operations (defaults to new instance)
-    public init(mqService: MQServiceProtocol? = nil) {
+    /// - Parameters:
+    ///   - mqService: MQ service for message operations (defaults to new instance)
+    ///   - auditService: Audit log of bulk operations (defaults to none)
+    public init(mqService: MQServiceProtocol? = nil, auditService: AuditServiceProtocol? = nil) {
         self.mqService = mqService ?? MQService()
+        self.auditService = auditService
     }
 
     // MARK: - Message Browsing
 
     /// Browse messages in a queue without removing them
+    /// Messages are read as a stream of pages and appended as each page arrives,
+    /// so the first rows are shown before the rest of the window has been read.
+    /// Reading stops once the window is full; loadMoreMessages() resumes the
+    /// same stream without re-reading what has already been loaded
     /// - Parameters:
     ///   - queueName: Name of the queue to browse
-    ///   - maxMessages: Maximum number of messages to browse (defaults to maxMessagesToLoad)
+    ///   - maxMessages: Size of the window to load (defaults to maxMessagesToLoad)
     /// - Throws: MQError if browsing fails
     public func browseMessages(queueName: String, maxMessages: Int? = nil) async throws {
         guard !isLoading else { return }
 
+        // A new browse replaces the list the tail appends to
+        stopTail()
+
+        // Release the cursor of the queue we are leaving; its selector does not carry over
+        if let previousQueueName = currentQueueName, previousQueueName != queueName {
+            mqService.closeBrowseCursor(queueName: previousQueueName)
+            serverSelector = MQService.MessageSelector()
+        }
+
+        browseGeneration += 1
+        let generation = browseGeneration
+
         isLoading = true
         lastError = nil
         currentQueueName = queueName
+        replaceMessages(MessageStore(spillPolicy: payloadSpillPolicy))
+        hasMoreMessages = false
+        pageIterator = nil
 
         defer {
-            isLoading = false
+            if generation == browseGeneration {
+                isLoading = false
+                isLoadingMore = false
+            }
         }
 
         do {
             let limit = maxMessages ?? maxMessagesToLoad
-            let mqMessages = try await mqService.browseMessages(
+            var iterator = mqService.browseMessageStream(
                 queueName: queueName,
-                maxMessages: limit
+                pageSize: maxMessagesToLoad,
+                selector: serverSelector
+            ).makeAsyncIterator()
+
+            let isExhausted = try await appendPages(from: &iterator, until: limit, generation: generation)
+
+            // A newer browse has replaced this one
+            guard generation == browseGeneration else { return }
+
+            pageIterator = isExhausted ? nil : iterator
+            hasMoreMessages = !isExhausted
+            lastRefreshDate = Date()
+
+        } catch {
+            guard generation == browseGeneration else { return }
+            lastError = error
+            showErrorAlert = true
+            throw error
+        }
+    }
+
+    /// Load the next window of messages and append it to the list
+    /// Continues the current browse stream, so only the new messages are transferred
+    /// - Throws: MQError if browsing fails
+    public func loadMoreMessages() async throws {
+        guard hasMoreMessages, var iterator = pageIterator, !isLoading, !isLoadingMore else { return }
+
+        let generation = browseGeneration
+        pageIterator = nil
+        isLoadingMore = true
+        lastError = nil
+
+        defer {
+            if generation == browseGeneration {
+                isLoadingMore = false
+            }
+        }
+
+        do {
+            let isExhausted = try await appendPages(
+                from: &iterator,
+                until: messages.count + maxMessagesToLoad,
+                generation: generation
             )
 
-            // Convert MQService.MQMessage to Message model
-            let messageModels = mqMessages.map { mqMessage in
-                Message(
-                    messageId: mqMessage.messageId,
-                    correlationId: mqMessage.correlationId,
-                    format: mqMessage.format,
-                    payload: mqMessage.payload,
-                    putDateTime: mqMessage.putDateTime,
-                    putApplicationName: mqMessage.putApplicationName,
-                    messageType: MessageType(rawValue: mqMessage.messageType.rawValue),
-                    persistence: MessagePersistence(rawValue: mqMessage.persistence.rawValue),
-                    priority: mqMessage.priority,
-                    replyToQueue: mqMessage.replyToQueue,
-                    replyToQueueManager: mqMessage.replyToQueueManager,
-                    messageSequenceNumber: mqMessage.messageSequenceNumber,
-                    position: mqMessage.position
-                )
+            // Ignore the result if the user moved to another queue meanwhile
+            guard generation == browseGeneration else { return }
+
+            pageIterator = isExhausted ? nil : iterator
+            hasMoreMessages = !isExhausted
+        } catch {
+            guard generation == browseGeneration else { return }
+            hasMoreMessages = false
+            lastError = error
+            showErrorAlert = true
+            throw error
+        }
+    }
+
+    /// Pull pages from a browse stream and append them until the list holds
+    /// the requested number of messages
+    /// The next page is only requested after the previous one has been appended,
+    /// so the stream never reads ahead of the list
+    /// - Parameters:
+    ///   - iterator: Iterator of the browse stream
+    ///   - total: Number of messages the list should hold afterwards
+    ///   - generation: Browse generation the pages belong to
+    /// - Returns: true if the stream reached the end of the queue
+    /// - Throws: MQError if browsing fails
+    private func appendPages(
+        from iterator: inout AsyncThrowingStream<[MQService.MQMessage], Error>.Iterator,
+        until total: Int,
+        generation: Int
+    ) async throws -> Bool {
+        while messages.count < total {
+            guard let page = try await iterator.next() else {
+                return true
+            }
+            guard generation == browseGeneration else {
+                return false
             }
 
-            messages = messageModels
-            lastRefreshDate = Date()
+            messages.append(contentsOf: page)
+            index.appendRows(in: messages)
+
+            // Show the list as soon as the first rows are in
+            if isLoading {
+                isLoading = false
+                isLoadingMore = true
+            }
 
             // Auto-select first message if nothing is selected
-            if selectedMessageId == nil && !messages.isEmpty {
+            if selectedMessageId == nil {
                 selectedMessageId = messages.first?.id
             }
+        }
+        return false
+    }
 
+    /// Browse the current queue again with the server-side terms of the search text
+    /// Does nothing when they are those the list was browsed with, so only a
+    /// changed selector costs a browse; free text keeps filtering on the client
+    /// - Throws: MQError if browsing fails, e.g. for an invalid selection string;
+    ///   the previous selector is then restored, so a refresh does not fail the same way
+    public func applyFilter() async throws {
+        let selector = MessageFilter(searchText: searchText).selector
+        guard selector != serverSelector else { return }
+
+        let previousSelector = serverSelector
+        serverSelector = selector
+        guard let queueName = currentQueueName else { return }
+        do {
+            try await browseMessages(queueName: queueName)
         } catch {
-            lastError = error
-            showErrorAlert = true
+            // A newer filter or queue may have replaced the selector meanwhile
+            if serverSelector == selector {
+                serverSelector = previousSelector
+            }
             throw error
         }
     }
 
     /// Refresh messages for the current queue
+    /// Re-browses the first window only; further messages are loaded again on demand
     /// - Throws: MQError if refresh fails
     public func refresh() async throws {
         guard let queueName = currentQueueName else { return }
         try await browseMessages(queueName: queueName)
     }
 
+    // MARK: - Live Tail
+
+    /// Start appending the messages that arrive on the current queue as they land
+    /// The arrivals are pushed by the queue manager and appended in batches of
+    /// one UI frame, until stopTail() is called or another queue is browsed.
+    /// In destructive mode every arrival is removed from the queue
+    /// - Parameter mode: Whether arrivals are browsed or removed
+    public func startTail(mode: MQService.TailMode) {
+        guard let queueName = currentQueueName, !isTailing else { return }
+
+        let generation = browseGeneration
+        let stream = mqService.tailMessageStream(queueName: queueName, mode: mode)
+        tailMode = mode
+
+        tailTask = Task { [weak self] in
+            do {
+                for try await batch in stream {
+                    guard let self, generation == self.browseGeneration else { return }
+                    self.appendTailedMessages(batch, mode: mode)
+                }
+            } catch {
+                guard let self, !Task.isCancelled, generation == self.browseGeneration else { return }
+                self.lastError = error
+                self.showErrorAlert = true
+            }
+
+            // The stream ended by itself rather than through stopTail()
+            guard let self, !Task.isCancelled else { return }
+            self.tailTask = nil
+            self.tailMode = nil
+        }
+    }
+
+    /// Stop the live tail; messages already appended stay in the list
+    public func stopTail() {
+        tailTask?.cancel()
+        tailTask = nil
+        tailMode = nil
+    }
+
+    /// Append a batch of tailed messages to the list
+    /// An arrival may already be listed when the browse window reached the end
+    /// of the queue after the tail started, so listed messages are skipped
+    private func appendTailedMessages(_ batch: [MQService.MQMessage], mode: MQService.TailMode) {
+        for mqMessage in batch where messages.row(forId: mqMessage.id) == nil {
+            // Removed arrivals have no queue position, so they are numbered in list order
+            let position = mode == .destructive ? messages.count : mqMessage.position
+            messages.append(mqMessage, position: position)
+        }
+        index.appendRows(in: messages)
+
+        if selectedMessageId == nil {
+            selectedMessageId = messages.first?.id
+        }
+        lastRefreshDate = Date()
+    }
+
+    /// Replace the selected message's preview with its complete payload
+    /// Pages are browsed with payload previews only; the full body is fetched
+    /// from the queue by MsgId when a truncated message is selected
+    /// - Throws: MQError if the message cannot be browsed
+    public func loadSelectedMessagePayload() async throws {
+        guard let queueName = currentQueueName,
+              let selected = selectedMessage,
+              selected.isPayloadTruncated else { return }
+
+        isLoadingPayload = true
+
+        defer {
+            isLoadingPayload = false
+        }
+
+        do {
+            guard let mqMessage = try await mqService.browseMessage(
+                queueName: queueName,
+                messageId: selected.messageId
+            ) else {
+                // The message has been removed from the queue since it was listed
+                return
+            }
+
+            // The list may have been reloaded while the payload was in flight
+            guard currentQueueName == queueName,
+                  let row = messages.row(forId: selected.id) else { return }
+
+            messages.replacePayload(at: row, with: mqMessage.payload, payloadLength: mqMessage.totalLength)
+            index.replaceRow(row, in: messages)
+        } catch {
+            lastError = error
+            showErrorAlert = true
+            throw error
+        }
+    }
+
     /// Set messages directly (useful for testing and preview)
     /// - Parameters:
     ///   - messages: Array of Message objects
     ///   - queueName: Optional queue name to set as current
     public func setMessages(_ messages: [Message], queueName: String? = nil) {
-        self.messages = messages
+        replaceMessages(MessageStore(messages, spillPolicy: payloadSpillPolicy))
         self.currentQueueName = queueName
         self.lastRefreshDate = Date()
     }
 
     /// Clear all messages and reset state
     public func clearMessages() {
-        messages = []
+        stopTail()
+        if let queueName = currentQueueName {
+            mqService.closeBrowseCursor(queueName: queueName)
+        }
+        browseGeneration += 1
+        pageIterator = nil
+
+        // Dropping the store evicts its payloads, the spill file included
+        replaceMessages(MessageStore())
+        payloadRepresentations.removeAll()
+        hasMoreMessages = false
+        isLoading = false
+        isLoadingMore = false
         selectedMessageId = nil
         currentQueueName = nil
         lastRefreshDate = nil
     }
 
+    /// Replace the whole message list and reindex it
+    /// - Parameter messages: The new list
+    private func replaceMessages(_ messages: MessageStore) {
+        self.messages = messages
+        index.reset(messages)
+    }
+
     // MARK: - Selection Management
 
     /// Select a message by ID
@@ -272,8 +543,7 @@ public final class MessageViewModel {
         let filtered = filteredMessages
         guard !filtered.isEmpty else { return }
 
-        if let currentId = selectedMessageId,
-           let currentIndex = filtered.firstIndex(where: { $0.id == currentId }) {
+        if let currentIndex = selectedMessageIndex {
             let nextIndex = (currentIndex + 1) % filtered.count
             selectedMessageId = filtered[nextIndex].id
         } else {
@@ -286,8 +556,7 @@ public final class MessageViewModel {
         let filtered = filteredMessages
         guard !filtered.isEmpty else { return }
 
-        if let currentId = selectedMessageId,
-           let currentIndex = filtered.firstIndex(where: { $0.id == currentId }) {
+        if let currentIndex = selectedMessageIndex {
             let previousIndex = currentIndex == 0 ? filtered.count - 1 : currentIndex - 1
             selectedMessageId = filtered[previousIndex].id
         } else {
@@ -352,38 +621,6 @@ public final class MessageViewModel {
 
     // MARK: - Sorting
 
-    /// Apply the current sort order to an array of messages
-    /// - Parameter messages: Messages to sort
-    /// - Returns: Sorted array of messages
-    private func sortMessages(_ messages: [Message]) -> [Message] {
-        switch sortOrder {
-        case .position:
-            return messages.sorted { $0.position < $1.position }
-        case .positionDescending:
-            return messages.sorted { $0.position > $1.position }
-        case .dateTime:
-            return messages.sorted { (m1, m2) in
-                guard let d1 = m1.putDateTime else { return false }
-                guard let d2 = m2.putDateTime else { return true }
-                return d1 < d2
-            }
-        case .dateTimeDescending:
-            return messages.sorted { (m1, m2) in
-                guard let d1 = m1.putDateTime else { return true }
-                guard let d2 = m2.putDateTime else { return false }
-                return d1 > d2
-            }
-        case .size:
-            return messages.sorted { $0.payloadSize > $1.payloadSize }
-        case .sizeAscending:
-            return messages.sorted { $0.payloadSize < $1.payloadSize }
-        case .priority:
-            return messages.sorted { $0.priority > $1.priority }
-        case .messageId:
-            return messages.sorted { $0.messageIdHex < $1.messageIdHex }
-        }
-    }
-
     /// Cycle to the next sort order
     public func cycleSortOrder() {
         sortOrder = sortOrder.next
@@ -395,14 +632,14 @@ public final class MessageViewModel {
     /// - Parameter position: Position in the queue (0-based)
     /// - Returns: Message at the position, or nil if not found
     public func message(atPosition position: Int) -> Message? {
-        messages.first { $0.position == position }
+        index.row(forPosition: position).map { messages[$0] }
     }
 
     /// Get message by ID
     /// - Parameter id: Message ID (hex string)
     /// - Returns: Message with the ID, or nil if not found
     public func message(withId id: String) -> Message? {
-        messages.first { $0.id == id }
+        messages.row(forId: id).map { messages[$0] }
     }
 
     // MARK: - Message Operations
@@ -419,8 +656,10 @@ public final class MessageViewModel {
         do {
             try await mqService.deleteMessage(queueName: queueName, messageId: messageId)
 
-            // Remove the message from the local array
-            messages.removeAll { $0.messageId == messageId }
+            // Remove the message from the local list
+            var remaining = messages
+            remaining.removeAll(messageId: messageId)
+            replaceMessages(remaining)
 
             // If the deleted message was selected, clear selection
             let deletedId = messageId.map { String(format: "%02X", $0) }.joined()
@@ -435,6 +674,96 @@ public final class MessageViewModel {
         }
     }
 
+    /// Delete, move or copy a set of messages of the current queue
+    /// The service handles them in batched units of work; afterwards the
+    /// messages no longer on the queue are removed from the list in one pass
+    /// instead of browsing the queue again. Every committed batch gets one
+    /// audit entry
+    /// - Parameters:
+    ///   - messageIds: MsgIds of the messages, e.g. the selected rows
+    ///   - action: Whether the messages are deleted, moved or copied
+    ///   - commitInterval: Messages per unit of work
+    ///   - progress: Called with the result of every batch as it completes
+    /// - Returns: Result of every batch attempted, in order
+    /// - Throws: MQError if the operation cannot start
+    @discardableResult
+    public func processMessages(
+        messageIds: [[UInt8]],
+        action: MQService.BulkMessageAction,
+        commitInterval: Int = 100,
+        progress: (@MainActor (MQService.BulkBatchResult) -> Void)? = nil
+    ) async throws -> [MQService.BulkBatchResult] {
+        guard let queueName = currentQueueName else {
+            throw MQError.notConnected
+        }
+
+        do {
+            let results = try await mqService.processMessages(
+                queueName: queueName,
+                messageIds: messageIds,
+                action: action,
+                commitInterval: commitInterval
+            ) { [weak self] result in
+                self?.audit(result, action: action, queueName: queueName)
+                progress?(result)
+            }
+
+            // Deleted and moved messages are gone, and so are those found missing
+            let removedIds = results.flatMap { result in
+                action.removesMessages ? result.processedIds + result.missingIds : result.missingIds
+            }
+            if !removedIds.isEmpty {
+                var remaining = messages
+                remaining.removeAll(messageIds: removedIds)
+                replaceMessages(remaining)
+
+                if let selectedId = selectedMessageId, messages.row(forId: selectedId) == nil {
+                    selectedMessageId = nil
+                }
+            }
+
+            if let failure = results.last?.error {
+                lastError = failure
+                showErrorAlert = true
+            }
+            return results
+
+        } catch {
+            lastError = error
+            showErrorAlert = true
+            throw error
+        }
+    }
+
+    /// Record a committed batch of a bulk operation in the audit log
+    private func audit(_ result: MQService.BulkBatchResult, action: MQService.BulkMessageAction, queueName: String) {
+        guard let auditService, result.isCommitted, !result.processedIds.isEmpty else { return }
+
+        let count = result.processedIds.count
+        let countText = "\(count) message\(count == 1 ? "" : "s")"
+        let actionType: AuditEntry.ActionType
+        let details: String
+        switch action {
+        case .delete:
+            actionType = .messageDeleted
+            details = "Deleted \(countText)"
+        case .move(let targetQueue):
+            actionType = .messagesMoved
+            details = "Moved \(countText) to \(targetQueue)"
+        case .copy(let targetQueue):
+            actionType = .messagesCopied
+            details = "Copied \(countText) to \(targetQueue)"
+        }
+
+        auditService.log(
+            actionType: actionType,
+            resource: queueName,
+            details: details + " (batch at \(result.startIndex))",
+            queueManager: nil,
+            username: nil
+        )
+    }
+
     /// Send a message to the current queue
     /// - Parameters:
     ///   - payload: The message payload data
@@ -477,6 +806,145 @@ public final class MessageViewModel {
         }
     }
 
+    /// Send a sequence of payloads to the current queue in units of work
+    /// For replaying captured messages and load tests; the queue is opened once
+    /// and committed every commitInterval messages
+    /// - Parameters:
+    ///   - payloads: The message payloads, in order
+    ///   - messageType: The type of every message
+    ///   - persistence: Message persistence option
+    ///   - priority: Message priority (0-9)
+    ///   - commitInterval: Messages per unit of work
+    ///   - responseMode: Whether puts wait for the queue manager's reply
+    ///   - progress: Called with the result of every batch as it completes
+    /// - Returns: Result of every batch attempted, in order
+    /// - Throws: MQError if the send cannot start
+    @discardableResult
+    public func sendMessages(
+        payloads: [Data],
+        messageType: MessageType,
+        persistence: MessagePersistence,
+        priority: Int32,
+        commitInterval: Int = 100,
+        responseMode: MQService.PutResponseMode = .synchronous,
+        progress: (@MainActor (MQService.SendBatchResult) -> Void)? = nil
+    ) async throws -> [MQService.SendBatchResult] {
+        guard let queueName = currentQueueName else {
+            throw MQError.notConnected
+        }
+
+        let messages = payloads.map { payload in
+            MQService.OutgoingMessage(
+                payload: payload,
+                messageType: MQService.MQMessageType(rawValue: messageType.rawValue),
+                persistence: MQService.MQMessagePersistence(rawValue: persistence.rawValue),
+                priority: priority
+            )
+        }
+
+        do {
+            let results = try await mqService.sendMessages(
+                queueName: queueName,
+                batch: messages,
+                commitInterval: commitInterval,
+                responseMode: responseMode,
+                progress: progress
+            )
+
+            // Refresh messages to show the new messages
+            try? await refresh()
+
+            if let failure = results.last?.error {
+                lastError = failure
+                showErrorAlert = true
+            }
+            return results
+
+        } catch {
+            lastError = error
+            showErrorAlert = true
+            throw error
+        }
+    }
+
+    // MARK: - Queue Archives
+
+    /// Whether a queue dump or load is running
+    public private(set) var isArchiving: Bool = false
+
+    /// Write every message of the current queue to an archive file
+    /// - Parameters:
+    ///   - url: File to write
+    ///   - compressed: Whether blocks are compressed
+    /// - Returns: Number of messages written
+    /// - Throws: MQError if the dump fails
+    @discardableResult
+    public func exportQueue(to url: URL, compressed: Bool = true) async throws -> Int {
+        guard let queueName = currentQueueName else {
+            throw MQError.notConnected
+        }
+
+        isArchiving = true
+        defer {
+            isArchiving = false
+        }
+
+        do {
+            return try await mqService.dumpQueue(queueName: queueName, to: url, compressed: compressed, progress: nil)
+        } catch {
+            lastError = error
+            showErrorAlert = true
+            throw error
+        }
+    }
+
+    /// Put every message of an archive file to the current queue
+    /// - Parameters:
+    ///   - url: Archive written by exportQueue(to:compressed:)
+    ///   - restoresContext: Whether the archived context fields are put as well
+    ///   - commitInterval: Messages per unit of work
+    /// - Returns: Result of every batch attempted, in order
+    /// - Throws: MQError if the load cannot start
+    @discardableResult
+    public func importArchive(
+        from url: URL,
+        restoresContext: Bool = true,
+        commitInterval: Int = 100
+    ) async throws -> [MQService.SendBatchResult] {
+        guard let queueName = currentQueueName else {
+            throw MQError.notConnected
+        }
+
+        isArchiving = true
+        defer {
+            isArchiving = false
+        }
+
+        do {
+            let results = try await mqService.loadQueue(
+                queueName: queueName,
+                from: url,
+                commitInterval: commitInterval,
+                restoresContext: restoresContext,
+                progress: nil
+            )
+
+            // Refresh messages to show the loaded messages
+            try? await refresh()
+
+            if let failure = results.last?.error {
+                lastError = failure
+                showErrorAlert = true
+            }
+            return results
+
+        } catch {
+            lastError = error
+            showErrorAlert = true
+            throw error
+        }
+    }
+
     // MARK: - Error Handling
 
     /// Clear the last error
@@ -538,9 +1006,7 @@ extension MessageViewModel {
     /// Create a MessageViewModel with sample data for SwiftUI previews
     public static var preview: MessageViewModel {
         let viewModel = MessageViewModel(mqService: PreviewMessageMQService())
-        viewModel.messages = Message.samples
-        viewModel.currentQueueName = "DEV.QUEUE.1"
-        viewModel.lastRefreshDate = Date()
+        viewModel.setMessages(Message.samples, queueName: "DEV.QUEUE.1")
         viewModel.selectedMessageId = Message.samples.first?.id
         return viewModel
     }
@@ -548,8 +1014,7 @@ extension MessageViewModel {
     /// Create a MessageViewModel in loading state for SwiftUI previews
     public static var previewLoading: MessageViewModel {
         let viewModel = MessageViewModel(mqService: PreviewMessageMQService())
-        viewModel.messages = []
-        viewModel.currentQueueName = "DEV.QUEUE.1"
+        viewModel.setMessages([], queueName: "DEV.QUEUE.1")
         // Note: isLoading cannot be directly set; for previews, use the view's state
         return viewModel
     }
@@ -557,8 +1022,7 @@ extension MessageViewModel {
     /// Create an empty MessageViewModel for SwiftUI previews
     public static var previewEmpty: MessageViewModel {
         let viewModel = MessageViewModel(mqService: PreviewMessageMQService())
-        viewModel.messages = []
-        viewModel.currentQueueName = "DEV.QUEUE.1"
+        viewModel.setMessages([], queueName: "DEV.QUEUE.1")
         return viewModel
     }
 
@@ -573,8 +1037,7 @@ extension MessageViewModel {
     /// Create a MessageViewModel with no queue selected for SwiftUI previews
     public static var previewNoQueue: MessageViewModel {
         let viewModel = MessageViewModel(mqService: PreviewMessageMQService())
-        viewModel.messages = []
-        viewModel.currentQueueName = nil
+        viewModel.setMessages([])
         return viewModel
     }
 }
@@ -602,7 +1065,7 @@ private final class PreviewMessageMQService: MQServiceProtocol {
         isConnected = false
     }
 
-    func getQueueInfo(queueName: String) throws -> MQService.QueueInfo {
+    func getQueueInfo(queueName: String) async throws -> MQService.QueueInfo {
         MQService.QueueInfo(
             name: queueName,
             queueType: .local,
@@ -665,7 +1128,9 @@ private final class PreviewMessageMQService: MQServiceProtocol {
                 replyToQueue: message.replyToQueue,
                 replyToQueueManager: message.replyToQueueManager,
                 messageSequenceNumber: message.messageSequenceNumber,
-                position: message.position
+                position: message.position,
+                codedCharSetId: message.codedCharSetId,
+                encoding: message.encoding
             )
         }
     }
@@ -674,13 +1139,3 @@ private final class PreviewMessageMQService: MQServiceProtocol {
         // Mock implementation - does nothing
     }
 }
-
-// MARK: - MQServiceProtocol Extension
-
-extension MQServiceProtocol {
-    /// Default implementation of browseMessages for protocols that don't implement it
-    func browseMessages(queueName: String, maxMessages: Int) async throws -> [MQService.MQMessage] {
-        // Default implementation throws notConnected
-        throw MQError.notConnected
-    }
-}
@@ -0,0 +1,323 @@
+import Foundation
+
+// MARK: - PayloadRepresentation
+
+/// Everything the message views show of a payload, decoded once
+///
+/// Decoding by CCSID and the binary heuristic each walk the whole payload, so
+/// they are done once when the representation is built instead of whenever a
+/// view reads them. Pretty-printed JSON and hex dump pages are only needed by
+/// the detail view; PayloadRepresentationCache builds them on demand.
+public struct PayloadRepresentation: Sendable, Equatable {
+
+    // MARK: - Properties
+
+    /// Payload decoded by its CCSID (see Message.payloadString)
+    public let text: String?
+
+    /// Whether the payload looks binary (see Message.isBinaryPayload)
+    public let isBinary: Bool
+
+    /// Short preview: text or hex (see Message.payloadPreview)
+    public let preview: String
+
+    /// First non-empty line of a text payload, at most 100 characters, for list rows
+    public let linePreview: String?
+
+    /// Number of payload bytes the representation was built from
+    public let byteCount: Int
+
+    /// Payload bytes per hex dump page (256 lines)
+    public static let hexDumpPageSize = 4096
+
+    // MARK: - Initialization
+
+    /// Decode a message's payload; reads the whole payload, so call off the main thread for large ones
+    /// - Parameter message: The message
+    public init(message: Message) {
+        let text = message.payloadString
+        let isBinary = Message.isBinary(decoded: text)
+
+        self.text = text
+        self.isBinary = isBinary
+        self.preview = Message.preview(of: message.payload, text: isBinary ? nil : text)
+        self.linePreview = isBinary ? nil : text.flatMap(Self.firstLine(of:))
+        self.byteCount = message.payload.count
+    }
+
+    // MARK: - Hex Dump Pages
+
+    /// Number of hex dump pages of the payload
+    public var hexDumpPageCount: Int {
+        Self.hexDumpPageCount(byteCount: byteCount)
+    }
+
+    /// Number of hex dump pages of a payload of a given size
+    static func hexDumpPageCount(byteCount: Int) -> Int {
+        (byteCount + hexDumpPageSize - 1) / hexDumpPageSize
+    }
+
+    /// Payload bytes shown on a hex dump page
+    static func hexDumpRange(page: Int, byteCount: Int) -> Range<Int> {
+        let start = min(page * hexDumpPageSize, byteCount)
+        return start..<min(start + hexDumpPageSize, byteCount)
+    }
+
+    // MARK: - Helpers
+
+    /// First meaningful line of a text, nil if there is none
+    private static func firstLine(of text: String) -> String? {
+        let trimmed = text.trimmingCharacters(in: .whitespacesAndNewlines)
+        let firstLine = trimmed.components(separatedBy: .newlines).first ?? trimmed
+        let preview = String(firstLine.prefix(100))
+
+        return preview.isEmpty ? nil : preview
+    }
+
+    /// Pretty-print a JSON object or array, nil if the text is anything else
+    static func formatAsJSON(_ text: String) -> String? {
+        // Skip the parse for text that cannot be a JSON document
+        guard let first = text.first(where: { !$0.isWhitespace }), first == "{" || first == "[" else {
+            return nil
+        }
+        guard let json = try? JSONSerialization.jsonObject(with: Data(text.utf8)),
+              let prettyData = try? JSONSerialization.data(withJSONObject: json, options: [.prettyPrinted, .sortedKeys]),
+              let prettyString = String(data: prettyData, encoding: .utf8) else {
+            return nil
+        }
+        return prettyString
+    }
+}
+
+// MARK: - PayloadRepresentationCache
+
+/// Memory-bounded LRU cache of payload representations, keyed by message ID
+///
+/// Small payloads are decoded inline on first access. Larger ones are decoded
+/// by a background-priority task; until it finishes, representation(for:)
+/// returns nil and views show a placeholder. The task's completion bumps
+/// revision, so views that asked redraw. Formatted JSON and hex dump pages
+/// are added to an entry as they are first shown.
+///
+/// Entries are keyed by message ID and payload size, so loading the full
+/// payload of a preview yields a new entry; the preview's ages out. Once the
+/// entries' estimated size passes memoryLimit, the least recently used are
+/// evicted down to three quarters of it.
+@Observable
+@MainActor
+public final class PayloadRepresentationCache {
+
+    // MARK: - Types
+
+    /// Identity of a decoded payload
+    private struct Key: Hashable, Sendable {
+        let messageId: String
+        let byteCount: Int
+
+        init(_ message: Message) {
+            self.messageId = message.id
+            self.byteCount = message.payload.count
+        }
+    }
+
+    /// A cached representation and the views of it built so far
+    private struct Entry {
+        let representation: PayloadRepresentation
+        /// Outer nil until built; inner nil if the payload is not JSON
+        var formattedJSON: String?? = nil
+        var hexDumpPages: [Int: String] = [:]
+        var cost: Int
+        var lastUse: UInt64
+    }
+
+    // MARK: - Properties
+
+    /// Estimated size in bytes of the strings held before entries are evicted
+    public let memoryLimit: Int
+
+    /// Payload size up to which payloads are decoded inline
+    public let inlineDecodeLimit: Int
+
+    /// Incremented whenever a background decode finishes
+    public private(set) var revision = 0
+
+    /// Cached entries
+    @ObservationIgnored
+    private var entries: [Key: Entry] = [:]
+
+    /// Sum of the entries' costs
+    @ObservationIgnored
+    private(set) var totalCost = 0
+
+    /// Use counter, giving each access its LRU order
+    @ObservationIgnored
+    private var useCounter: UInt64 = 0
+
+    /// Payloads being decoded in the background
+    @ObservationIgnored
+    private var pendingKeys: Set<Key> = []
+
+    /// Incremented by removeAll(), so decodes started before are dropped
+    @ObservationIgnored
+    private var generation = 0
+
+    /// Fixed cost of an entry on top of its strings
+    private static let entryOverhead = 256
+
+    // MARK: - Initialization
+
+    /// Create an empty cache
+    /// - Parameters:
+    ///   - memoryLimit: Estimated size in bytes of the strings held (default: 64 MB)
+    ///   - inlineDecodeLimit: Payload size up to which payloads are decoded inline (default: 4 KB)
+    public init(memoryLimit: Int = 64 * 1024 * 1024, inlineDecodeLimit: Int = 4096) {
+        self.memoryLimit = max(memoryLimit, 0)
+        self.inlineDecodeLimit = inlineDecodeLimit
+    }
+
+    // MARK: - Access
+
+    /// Number of cached representations
+    public var count: Int {
+        entries.count
+    }
+
+    /// Representation of a message's payload
+    /// - Parameter message: The message
+    /// - Returns: The representation, or nil while it is decoded in the background
+    public func representation(for message: Message) -> PayloadRepresentation? {
+        // Read so that views calling this redraw when a background decode finishes
+        _ = revision
+
+        let key = Key(message)
+        if let representation = touch(key)?.representation {
+            return representation
+        }
+
+        guard message.payload.count > inlineDecodeLimit else {
+            let representation = PayloadRepresentation(message: message)
+            insert(representation, for: key)
+            return representation
+        }
+
+        decodeInBackground(message, key: key)
+        return nil
+    }
+
+    /// A message's payload pretty-printed as JSON, built on first access
+    /// - Parameter message: The message
+    /// - Returns: The JSON, or nil if the payload is not a JSON object or array,
+    ///   or is still being decoded
+    public func formattedJSON(for message: Message) -> String? {
+        guard let representation = representation(for: message) else { return nil }
+
+        let key = Key(message)
+        if let formatted = entries[key]?.formattedJSON {
+            return formatted
+        }
+
+        let formatted = representation.text.flatMap(PayloadRepresentation.formatAsJSON)
+        if entries[key] != nil {
+            entries[key]?.formattedJSON = .some(formatted)
+            addCost(formatted?.utf8.count ?? 0, to: key)
+        }
+        return formatted
+    }
+
+    /// One page of a message's hex dump, built on first access
+    /// - Parameters:
+    ///   - page: Page number, from 0 to PayloadRepresentation.hexDumpPageCount - 1
+    ///   - message: The message
+    /// - Returns: The page's lines
+    public func hexDumpPage(_ page: Int, of message: Message) -> String {
+        let key = Key(message)
+        if let dump = touch(key)?.hexDumpPages[page] {
+            return dump
+        }
+
+        let range = PayloadRepresentation.hexDumpRange(page: page, byteCount: message.payload.count)
+        let dump = Message.hexDump(of: message.payload, in: range)
+        if entries[key] != nil {
+            entries[key]?.hexDumpPages[page] = dump
+            addCost(dump.utf8.count, to: key)
+        }
+        return dump
+    }
+
+    /// Drop every entry, and the results of decodes still running
+    public func removeAll() {
+        entries.removeAll()
+        pendingKeys.removeAll()
+        totalCost = 0
+        generation += 1
+    }
+
+    // MARK: - Private Methods
+
+    /// Entry of a key, marked as most recently used
+    private func touch(_ key: Key) -> Entry? {
+        guard entries[key] != nil else { return nil }
+        useCounter += 1
+        entries[key]?.lastUse = useCounter
+        return entries[key]
+    }
+
+    /// Decode a payload on a background-priority task and cache the result
+    private func decodeInBackground(_ message: Message, key: Key) {
+        guard pendingKeys.insert(key).inserted else { return }
+
+        let generation = generation
+        Task.detached(priority: .background) { [weak self] in
+            let representation = PayloadRepresentation(message: message)
+            await self?.finishDecode(representation, for: key, generation: generation)
+        }
+    }
+
+    /// Cache the result of a background decode and let views redraw
+    private func finishDecode(_ representation: PayloadRepresentation, for key: Key, generation: Int) {
+        guard generation == self.generation else { return }
+        pendingKeys.remove(key)
+        insert(representation, for: key)
+        revision += 1
+    }
+
+    /// Add an entry as the most recently used
+    private func insert(_ representation: PayloadRepresentation, for key: Key) {
+        let cost = Self.entryOverhead
+            + (representation.text?.utf8.count ?? 0)
+            + representation.preview.utf8.count
+            + (representation.linePreview?.utf8.count ?? 0)
+
+        useCounter += 1
+        if let replaced = entries.updateValue(
+            Entry(representation: representation, cost: cost, lastUse: useCounter),
+            forKey: key
+        ) {
+            totalCost -= replaced.cost
+        }
+        totalCost += cost
+        evictIfNeeded(keeping: key)
+    }
+
+    /// Account for a string added to an entry
+    private func addCost(_ cost: Int, to key: Key) {
+        entries[key]?.cost += cost
+        totalCost += cost
+        evictIfNeeded(keeping: key)
+    }
+
+    /// Evict least recently used entries down to three quarters of the limit
+    /// - Parameter kept: Entry just used, never evicted, so that an entry larger
+    ///   than the limit is not decoded again on every access
+    private func evictIfNeeded(keeping kept: Key) {
+        guard totalCost > memoryLimit else { return }
+
+        let target = memoryLimit / 4 * 3
+        for (key, entry) in entries.sorted(by: { $0.value.lastUse < $1.value.lastUse }) {
+            guard totalCost > target else { break }
+            guard key != kept else { continue }
+            entries[key] = nil
+            totalCost -= entry.cost
+        }
+    }
+}
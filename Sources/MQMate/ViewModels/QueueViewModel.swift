@@ -38,9 +38,27 @@ public final class QueueViewModel {
     /// Timestamp of the last successful queue refresh
     public private(set) var lastRefreshDate: Date?
 
+    /// Recent depth samples of the monitored queues, keyed by queue name
+    public private(set) var depthHistories: [String: QueueDepthHistory] = [:]
+
+    /// When the shown queue list was saved, while it is a snapshot rather than live data
+    public private(set) var snapshotDate: Date?
+
+    /// Settings used when purging queues
+    public var purgeOptions = MQService.PurgeOptions()
+
+    /// Name of the queue being purged, if any
+    public private(set) var purgingQueueName: String?
+
+    /// Messages removed so far by the current or last purge
+    public private(set) var purgedMessageCount: Int = 0
+
     /// Reference to the active queue manager ID
     private var activeQueueManagerId: UUID?
 
+    /// Task running the current purge, cancelled by cancelPurge()
+    private var purgeTask: Task<MQService.PurgeResult, Error>?
+
     // MARK: - Dependencies
 
     /// MQ service for queue operations
@@ -165,21 +183,21 @@ public final class QueueViewModel {
         do {
             let queueInfoList = try await mqService.listQueues(filter: filter)
 
-            // Convert QueueInfo to Queue model
-            let queueModels = queueInfoList.map { info in
-                Queue(
-                    name: info.name,
-                    queueType: info.queueType,
-                    depth: info.currentDepth,
-                    maxDepth: info.maxDepth,
-                    getInhibited: info.inhibitGet,
-                    putInhibited: info.inhibitPut,
-                    openInputCount: info.openInputCount,
-                    openOutputCount: info.openOutputCount
-                )
+            // Convert QueueInfo to Queue model; timed with the list update it triggers
+            MQInstrumentation.shared.measure(.queueListUpdate) {
+                queues = queueInfoList.map { info in
+                    Queue(
+                        name: info.name,
+                        queueType: info.queueType,
+                        depth: info.currentDepth,
+                        maxDepth: info.maxDepth,
+                        getInhibited: info.inhibitGet,
+                        putInhibited: info.inhibitPut,
+                        openInputCount: info.openInputCount,
+                        openOutputCount: info.openOutputCount
+                    )
+                }
             }
-
-            queues = queueModels
             lastRefreshDate = Date()
 
         } catch {
@@ -196,15 +214,94 @@ public final class QueueViewModel {
     }
 
     /// Set queues directly (useful for testing and when loading from ConnectionManager)
-    /// - Parameter queues: Array of Queue objects
-    public func setQueues(_ queues: [Queue]) {
+    /// - Parameters:
+    ///   - queues: Array of Queue objects
+    ///   - histories: Depth samples of the queues; nil keeps those of queues still listed
+    public func setQueues(_ queues: [Queue], histories: [String: QueueDepthHistory]? = nil) {
         self.queues = queues
         self.lastRefreshDate = Date()
+        self.snapshotDate = nil
+        if let histories {
+            depthHistories = histories
+        } else {
+            let names = Set(queues.map(\.id))
+            depthHistories = depthHistories.filter { names.contains($0.key) }
+        }
+    }
+
+    /// Show the last known queue list of a connection that is not open yet
+    /// The list is marked stale until live queues are set or reconciled
+    /// - Parameter snapshot: The saved queue list
+    public func showSnapshot(_ snapshot: QueueSnapshot) {
+        queues = snapshot.queues
+        depthHistories = [:]
+        lastRefreshDate = snapshot.savedAt
+        snapshotDate = snapshot.savedAt
+    }
+
+    /// Replace the shown queues with live ones, touching as few rows as possible
+    /// When the live list has the same queues in the same order, only the rows
+    /// whose values differ are replaced; otherwise the list is replaced
+    /// - Parameters:
+    ///   - liveQueues: Queues as just listed
+    ///   - histories: Depth samples of the queues
+    public func reconcileQueues(_ liveQueues: [Queue], histories: [String: QueueDepthHistory] = [:]) {
+        guard liveQueues.map(\.id) == queues.map(\.id) else {
+            setQueues(liveQueues, histories: histories)
+            return
+        }
+
+        let changedQueues = zip(queues, liveQueues).compactMap { shown, live in
+            Self.hasSameState(shown, live) ? nil : live
+        }
+        updateQueues(changedQueues, histories: histories)
+        lastRefreshDate = Date()
+        snapshotDate = nil
+    }
+
+    /// Whether two entries of a queue would draw the same row
+    private static func hasSameState(_ lhs: Queue, _ rhs: Queue) -> Bool {
+        lhs.queueType == rhs.queueType
+            && lhs.depth == rhs.depth
+            && lhs.maxDepth == rhs.maxDepth
+            && lhs.getInhibited == rhs.getInhibited
+            && lhs.putInhibited == rhs.putInhibited
+            && lhs.openInputCount == rhs.openInputCount
+            && lhs.openOutputCount == rhs.openOutputCount
+            && lhs.queueDescription == rhs.queueDescription
+    }
+
+    /// Replace only the queues whose state changed, e.g. as reported by a depth monitor
+    /// Unchanged entries are left alone so their rows are not redrawn
+    /// - Parameters:
+    ///   - changedQueues: The queues that changed, matched by ID
+    ///   - histories: Depth samples of the changed queues
+    public func updateQueues(_ changedQueues: [Queue], histories: [String: QueueDepthHistory] = [:]) {
+        guard !changedQueues.isEmpty else { return }
+
+        var indexesById: [String: Int] = [:]
+        for (index, queue) in queues.enumerated() {
+            indexesById[queue.id] = index
+        }
+        var updatedQueues = queues
+        var updatedHistories = depthHistories
+        for queue in changedQueues {
+            guard let index = indexesById[queue.id], updatedQueues[index] != queue else { continue }
+            updatedQueues[index] = queue
+            updatedHistories[queue.id] = histories[queue.id] ?? updatedHistories[queue.id]
+        }
+
+        // One assignment each, so observers are notified once per update
+        queues = updatedQueues
+        depthHistories = updatedHistories
+        lastRefreshDate = Date()
     }
 
     /// Clear all queues
     public func clearQueues() {
         queues = []
+        depthHistories = [:]
+        snapshotDate = nil
         selectedQueueId = nil
         lastRefreshDate = nil
     }
@@ -324,13 +421,30 @@ public final class QueueViewModel {
     // MARK: - Queue Operations
 
     /// Purge all messages from a queue
+    /// purgedMessageCount follows the messages removed while the purge runs, and
+    /// still holds the committed count if the purge fails part way
     /// - Parameter queueName: Name of the queue to purge
-    /// - Returns: Number of messages removed
+    /// - Returns: Number of messages removed and whether the purge was cancelled
     /// - Throws: MQError if the operation fails
-    public func purgeQueue(queueName: String) async throws -> Int {
+    public func purgeQueue(queueName: String) async throws -> MQService.PurgeResult {
+        purgingQueueName = queueName
+        purgedMessageCount = 0
+        defer {
+            purgingQueueName = nil
+            purgeTask = nil
+        }
+
+        let task = Task { [mqService, purgeOptions] in
+            try await mqService.purgeQueue(queueName: queueName, options: purgeOptions) { [weak self] removedCount in
+                self?.purgedMessageCount = removedCount
+            }
+        }
+        purgeTask = task
+
         do {
-            let messageCount = try await mqService.purgeQueue(queueName: queueName)
-            return messageCount
+            let result = try await task.value
+            purgedMessageCount = result.removedCount
+            return result
         } catch {
             lastError = error
             showErrorAlert = true
@@ -338,6 +452,11 @@ public final class QueueViewModel {
         }
     }
 
+    /// Stop the current purge after its batch in progress; removed messages stay removed
+    public func cancelPurge() {
+        purgeTask?.cancel()
+    }
+
     /// Delete a queue
     /// - Parameter queueName: Name of the queue to delete
     /// - Throws: MQError if the operation fails
@@ -489,7 +608,7 @@ private final class PreviewMQService: MQServiceProtocol {
         isConnected = false
     }
 
-    func getQueueInfo(queueName: String) throws -> MQService.QueueInfo {
+    func getQueueInfo(queueName: String) async throws -> MQService.QueueInfo {
         MQService.QueueInfo(
             name: queueName,
             queueType: .local,
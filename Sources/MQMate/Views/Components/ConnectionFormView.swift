@@ -69,6 +69,12 @@ struct ConnectionFormView: View {
     /// Password (stored in Keychain)
     @State private var password: String = ""
 
+    /// Messages a browse stream reads ahead (0 for none)
+    @State private var readAheadDepth: Int = 0
+
+    /// Whether browses ask the queue manager to convert payloads
+    @State private var convertsBrowsedData: Bool = true
+
     /// Whether password field has been modified (for edit mode)
     @State private var passwordModified: Bool = false
 
@@ -141,6 +147,7 @@ struct ConnectionFormView: View {
             Form {
                 connectionDetailsSection
                 authenticationSection
+                browsingSection
             }
             .formStyle(.grouped)
             .scrollContentBackground(.hidden)
@@ -312,6 +319,30 @@ struct ConnectionFormView: View {
         }
     }
 
+    /// Browsing performance section
+    private var browsingSection: some View {
+        Section {
+            LabeledContent("Read-Ahead") {
+                Stepper(
+                    readAheadDepth == 0 ? "Off" : "\(readAheadDepth) messages",
+                    value: $readAheadDepth,
+                    in: 0...10_000,
+                    step: 250
+                )
+            }
+            .accessibilityLabel("Read-ahead depth")
+            .accessibilityHint("Number of messages read ahead when scrolling through a queue")
+
+            Toggle("Convert payloads on the queue manager", isOn: $convertsBrowsedData)
+                .help("When off, payloads arrive as stored and are decoded on this Mac by their character set, only when shown")
+        } header: {
+            Text("Browsing")
+        } footer: {
+            Text("Read-ahead streams non-persistent messages before they are shown, so large queues load at the speed of the network rather than one round trip per message.")
+                .font(.caption)
+        }
+    }
+
     /// Form footer with action buttons
     private var formFooter: some View {
         HStack {
@@ -356,6 +387,8 @@ struct ConnectionFormView: View {
             portString = String(config.port)
             channel = config.channel
             username = config.username ?? ""
+            readAheadDepth = config.readAheadDepth ?? 0
+            convertsBrowsedData = config.convertsBrowsedData ?? true
             password = ""
             passwordModified = false
         }
@@ -372,7 +405,9 @@ struct ConnectionFormView: View {
                 hostname: hostname.trimmingCharacters(in: .whitespaces),
                 port: port,
                 channel: channel.trimmingCharacters(in: .whitespaces).uppercased(),
-                username: username.trimmingCharacters(in: .whitespaces).isEmpty ? nil : username.trimmingCharacters(in: .whitespaces)
+                username: username.trimmingCharacters(in: .whitespaces).isEmpty ? nil : username.trimmingCharacters(in: .whitespaces),
+                readAheadDepth: readAheadDepth > 0 ? readAheadDepth : nil,
+                convertsBrowsedData: convertsBrowsedData ? nil : false
             )
             // Note: createdAt and other dates are set in the init, but we'll handle this in ConnectionManager
             return config
@@ -384,7 +419,9 @@ struct ConnectionFormView: View {
                 hostname: hostname.trimmingCharacters(in: .whitespaces),
                 port: port,
                 channel: channel.trimmingCharacters(in: .whitespaces).uppercased(),
-                username: username.trimmingCharacters(in: .whitespaces).isEmpty ? nil : username.trimmingCharacters(in: .whitespaces)
+                username: username.trimmingCharacters(in: .whitespaces).isEmpty ? nil : username.trimmingCharacters(in: .whitespaces),
+                readAheadDepth: readAheadDepth > 0 ? readAheadDepth : nil,
+                convertsBrowsedData: convertsBrowsedData ? nil : false
             )
         }
     }
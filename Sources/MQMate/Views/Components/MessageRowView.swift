@@ -14,6 +14,9 @@ struct MessageRowView: View {
     /// Whether to show payload preview
     var showPayloadPreview: Bool = true
 
+    /// Cache of decoded payloads (nil = decode inline on every redraw)
+    var payloadRepresentations: PayloadRepresentationCache? = nil
+
     // MARK: - Body
 
     var body: some View {
@@ -141,18 +144,12 @@ struct MessageRowView: View {
     }
 
     /// Payload preview text (first line of text payload)
+    /// nil while a large payload is still being decoded in the background
     private var payloadPreviewText: String? {
-        guard !message.isBinaryPayload,
-              let text = message.payloadString else {
-            return nil
+        guard let payloadRepresentations else {
+            return PayloadRepresentation(message: message).linePreview
         }
-
-        // Get first meaningful line
-        let trimmed = text.trimmingCharacters(in: .whitespacesAndNewlines)
-        let firstLine = trimmed.components(separatedBy: .newlines).first ?? trimmed
-        let preview = String(firstLine.prefix(100))
-
-        return preview.isEmpty ? nil : preview
+        return payloadRepresentations.representation(for: message)?.linePreview
     }
 
     /// Accessibility hint for the row
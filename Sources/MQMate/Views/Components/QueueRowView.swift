@@ -11,6 +11,9 @@ struct QueueRowView: View {
     /// Queue to display
     let queue: Queue
 
+    /// Recent depth samples from the depth monitor, if the queue is monitored
+    var history: QueueDepthHistory? = nil
+
     // MARK: - Body
 
     var body: some View {
@@ -41,6 +44,13 @@ struct QueueRowView: View {
 
             Spacer()
 
+            // Recent depth trend
+            if let history, history.count > 1 {
+                DepthSparkline(depths: history.depths)
+                    .frame(width: 40, height: 16)
+                    .help(rateDescription(history.rate))
+            }
+
             // Depth indicator
             depthIndicator
         }
@@ -107,6 +117,12 @@ struct QueueRowView: View {
         }
     }
 
+    /// Tooltip for the sparkline, e.g. "+12.5 msg/s"
+    private func rateDescription(_ rate: Double?) -> String {
+        guard let rate else { return "No rate yet" }
+        return String(format: "%+.1f msg/s", rate)
+    }
+
     /// Accessibility hint for the row
     private var accessibilityHint: String {
         if queue.isBrowsable {
@@ -180,6 +196,43 @@ struct CapacityBar: View {
     }
 }
 
+// MARK: - DepthSparkline
+
+/// Line of recent queue depths, scaled to the highest depth shown
+struct DepthSparkline: View {
+
+    // MARK: - Properties
+
+    /// Depths from oldest to newest
+    let depths: [Int32]
+
+    // MARK: - Body
+
+    var body: some View {
+        GeometryReader { geometry in
+            Path { path in
+                guard depths.count > 1 else { return }
+                let highest = Double(max(depths.max() ?? 0, 1))
+                let step = geometry.size.width / Double(depths.count - 1)
+
+                for (index, depth) in depths.enumerated() {
+                    let point = CGPoint(
+                        x: Double(index) * step,
+                        y: geometry.size.height * (1 - Double(depth) / highest)
+                    )
+                    if index == 0 {
+                        path.move(to: point)
+                    } else {
+                        path.addLine(to: point)
+                    }
+                }
+            }
+            .stroke(.secondary, lineWidth: 1)
+        }
+        .accessibilityHidden(true)
+    }
+}
+
 // MARK: - Previews
 
 #Preview("Queue Row - Normal") {
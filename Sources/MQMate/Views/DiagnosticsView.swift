@@ -0,0 +1,175 @@
+import SwiftUI
+import AppKit
+
+// MARK: - DiagnosticsView
+
+/// MQI diagnostics window: call counts, bytes and latency percentiles per
+/// verb, connection and queue, as recorded by MQInstrumentation
+/// Refreshes once a second while open; the statistics can be exported as JSON or CSV
+struct DiagnosticsView: View {
+
+    // MARK: - Table
+
+    /// Which statistics the table shows
+    enum Scope: String, CaseIterable {
+        case verbs = "MQI Calls"
+        case connections = "Connections"
+        case queues = "Queues"
+    }
+
+    // MARK: - State
+
+    /// Statistics shown, copied from the instrumentation every second
+    @State private var snapshot = MQInstrumentation.shared.snapshot()
+
+    /// Whether calls are being recorded
+    @State private var isRecording = MQInstrumentation.shared.isEnabled
+
+    /// Table currently shown
+    @State private var scope: Scope = .verbs
+
+    // MARK: - Body
+
+    var body: some View {
+        VStack(spacing: 0) {
+            Group {
+                switch scope {
+                case .verbs:
+                    verbTable
+                case .connections:
+                    scopeTable(snapshot.connections, title: "Connection")
+                case .queues:
+                    scopeTable(snapshot.queues, title: "Queue")
+                }
+            }
+            .overlay {
+                if snapshot.verbs.isEmpty {
+                    EmptyStateView(
+                        systemImage: "stopwatch",
+                        title: isRecording ? "No MQI Calls Yet" : "Recording Is Off",
+                        description: isRecording
+                            ? "Calls appear here as the app talks to its queue managers."
+                            : "Turn on recording to count and time every MQI call."
+                    )
+                }
+            }
+        }
+        .toolbar {
+            ToolbarItemGroup {
+                Picker("Table", selection: $scope) {
+                    ForEach(Scope.allCases, id: \.self) { scope in
+                        Text(scope.rawValue).tag(scope)
+                    }
+                }
+                .pickerStyle(.segmented)
+
+                Toggle(isOn: $isRecording) {
+                    Label("Record", systemImage: isRecording ? "record.circle.fill" : "record.circle")
+                }
+                .help(isRecording ? "Stop Recording MQI Calls" : "Record MQI Calls")
+
+                Button {
+                    MQInstrumentation.shared.reset()
+                    snapshot = MQInstrumentation.shared.snapshot()
+                } label: {
+                    Image(systemName: "arrow.counterclockwise")
+                }
+                .help("Reset Statistics")
+
+                Menu {
+                    Button("Export as JSON…") {
+                        export(as: "json")
+                    }
+                    Button("Export as CSV…") {
+                        export(as: "csv")
+                    }
+                } label: {
+                    Image(systemName: "square.and.arrow.up")
+                }
+                .help("Export Statistics")
+                .disabled(snapshot.verbs.isEmpty)
+            }
+        }
+        .navigationTitle("MQI Diagnostics")
+        .frame(minWidth: 760, minHeight: 320)
+        .onChange(of: isRecording) { _, newValue in
+            MQInstrumentation.shared.isEnabled = newValue
+        }
+        .task {
+            while !Task.isCancelled {
+                snapshot = MQInstrumentation.shared.snapshot()
+                isRecording = snapshot.isRecording
+                try? await Task.sleep(for: .seconds(1))
+            }
+        }
+    }
+
+    // MARK: - Tables
+
+    /// Totals and latency percentiles of each verb
+    private var verbTable: some View {
+        Table(snapshot.verbs) {
+            TableColumn("Call", value: \.verb)
+            TableColumn("Calls") { row in Text("\(row.calls)").monospacedDigit() }
+            TableColumn("Warnings") { row in Text("\(row.warnings)").monospacedDigit() }
+            TableColumn("Failures") { row in Text("\(row.failures)").monospacedDigit() }
+            TableColumn("Bytes") { row in Text(Self.formatBytes(row.bytes)) }
+            TableColumn("Mean") { row in Text(Self.formatLatency(row.meanMicroseconds)).monospacedDigit() }
+            TableColumn("p50") { row in Text(Self.formatLatency(row.p50Microseconds)).monospacedDigit() }
+            TableColumn("p99") { row in Text(Self.formatLatency(row.p99Microseconds)).monospacedDigit() }
+            TableColumn("p99.9") { row in Text(Self.formatLatency(row.p999Microseconds)).monospacedDigit() }
+            TableColumn("Max") { row in Text(Self.formatLatency(row.maxMicroseconds)).monospacedDigit() }
+        }
+    }
+
+    /// Totals of each verb on each connection or queue
+    private func scopeTable(_ rows: [MQInstrumentationSnapshot.ScopeRow], title: String) -> some View {
+        Table(rows) {
+            TableColumn(title, value: \.scope)
+            TableColumn("Call", value: \.verb)
+            TableColumn("Calls") { row in Text("\(row.calls)").monospacedDigit() }
+            TableColumn("Warnings") { row in Text("\(row.warnings)").monospacedDigit() }
+            TableColumn("Failures") { row in Text("\(row.failures)").monospacedDigit() }
+            TableColumn("Bytes") { row in Text(Self.formatBytes(row.bytes)) }
+            TableColumn("Total") { row in Text(Self.formatLatency(row.totalMicroseconds)).monospacedDigit() }
+            TableColumn("Mean") { row in Text(Self.formatLatency(row.meanMicroseconds)).monospacedDigit() }
+        }
+    }
+
+    // MARK: - Export
+
+    /// Ask for a file and write the current statistics to it
+    /// - Parameter format: "json" or "csv"
+    private func export(as format: String) {
+        let exported = MQInstrumentation.shared.snapshot()
+        let panel = NSSavePanel()
+        panel.nameFieldStringValue = "mqi-diagnostics.\(format)"
+        guard panel.runModal() == .OK, let url = panel.url else { return }
+
+        let data = format == "json" ? try? exported.jsonData() : Data(exported.csv().utf8)
+        try? data?.write(to: url, options: .atomic)
+    }
+
+    // MARK: - Formatting
+
+    /// A latency in the largest unit that keeps it above 1
+    static func formatLatency(_ microseconds: Double) -> String {
+        if microseconds >= 1_000_000 {
+            return String(format: "%.2f s", microseconds / 1_000_000)
+        } else if microseconds >= 1_000 {
+            return String(format: "%.2f ms", microseconds / 1_000)
+        }
+        return String(format: "%.1f µs", microseconds)
+    }
+
+    /// A byte count such as "1.2 MB"
+    static func formatBytes(_ bytes: UInt64) -> String {
+        return ByteCountFormatter.string(fromByteCount: Int64(clamping: bytes), countStyle: .file)
+    }
+}
+
+// MARK: - Preview
+
+#Preview {
+    DiagnosticsView()
+}
@@ -1,4 +1,5 @@
 import SwiftUI
+import AppKit
 
 // MARK: - MessageBrowserView
 
@@ -59,10 +60,26 @@ struct MessageBrowserView: View {
             placement: .toolbar,
             prompt: "Filter messages"
         )
+        .onSubmit(of: .search) {
+            // Terms such as msgid: or where: are evaluated by the queue manager
+            Task {
+                try? await messageViewModel.applyFilter()
+            }
+        }
+        .onChange(of: messageViewModel.searchText) { _, newValue in
+            // Clearing the filter bar lists the whole queue again
+            if newValue.isEmpty && messageViewModel.isServerFiltered {
+                Task {
+                    try? await messageViewModel.applyFilter()
+                }
+            }
+        }
         .toolbar {
             ToolbarItemGroup(placement: .primaryAction) {
                 sendMessageButton
                 sortButton
+                tailButton
+                archiveButton
                 refreshButton
                 inspectorToggle
             }
@@ -80,6 +97,10 @@ struct MessageBrowserView: View {
         .onChange(of: selection) { _, newValue in
             messageViewModel.selectMessage(id: newValue)
         }
+        .task(id: messageViewModel.selectedMessageId) {
+            // Rows carry only a payload preview; fetch the body of the selected message
+            try? await messageViewModel.loadSelectedMessagePayload()
+        }
         .onChange(of: messageViewModel.selectedMessageId) { _, newValue in
             if selection != newValue {
                 selection = newValue
@@ -133,12 +154,16 @@ struct MessageBrowserView: View {
     private var messageListView: some View {
         List(selection: $selection) {
             ForEach(messageViewModel.filteredMessages) { message in
-                MessageRowView(message: message)
+                MessageRowView(message: message, payloadRepresentations: messageViewModel.payloadRepresentations)
                     .tag(message.id)
                     .contextMenu {
                         messageContextMenu(for: message)
                     }
             }
+
+            if messageViewModel.hasMoreMessages {
+                loadMoreRow
+            }
         }
         .listStyle(.inset)
         .refreshable {
@@ -149,6 +174,27 @@ struct MessageBrowserView: View {
         }
     }
 
+    /// Row at the end of the list that loads the next page of messages
+    private var loadMoreRow: some View {
+        HStack {
+            Spacer()
+            if messageViewModel.isLoadingMore {
+                ProgressView()
+                    .controlSize(.small)
+            } else {
+                Button("Load More Messages") {
+                    Task {
+                        try? await messageViewModel.loadMoreMessages()
+                    }
+                }
+                .buttonStyle(.link)
+            }
+            Spacer()
+        }
+        .padding(.vertical, 4)
+        .selectionDisabled()
+    }
+
     /// Loading indicator
     private var loadingView: some View {
         LoadingView("Loading messages...")
@@ -177,7 +223,11 @@ struct MessageBrowserView: View {
     @ViewBuilder
     private var messageDetailView: some View {
         if let message = messageViewModel.selectedMessage {
-            MessageDetailView(message: message)
+            MessageDetailView(
+                message: message,
+                isLoadingPayload: messageViewModel.isLoadingPayload,
+                payloadRepresentations: messageViewModel.payloadRepresentations
+            )
         } else {
             ContentUnavailableView {
                 Label("No Message Selected", systemImage: "doc.text")
@@ -249,6 +299,71 @@ struct MessageBrowserView: View {
         .disabled(messageViewModel.isLoading)
     }
 
+    /// Live tail button: a menu of tail modes, or a stop button while tailing
+    @ViewBuilder
+    private var tailButton: some View {
+        if messageViewModel.isTailing {
+            Button {
+                messageViewModel.stopTail()
+            } label: {
+                Image(systemName: "stop.circle")
+            }
+            .help("Stop Live Tail")
+        } else {
+            Menu {
+                Button("Watch New Messages") {
+                    messageViewModel.startTail(mode: .browse)
+                }
+                Button("Watch and Remove New Messages") {
+                    messageViewModel.startTail(mode: .destructive)
+                }
+            } label: {
+                Image(systemName: "dot.radiowaves.left.and.right")
+            }
+            .help("Live Tail")
+            .disabled(!messageViewModel.hasBrowsedQueue || messageViewModel.isLoading)
+        }
+    }
+
+    /// Queue archive menu: dump the queue to a file or load a file into it
+    private var archiveButton: some View {
+        Menu {
+            Button("Export Queue…") {
+                exportQueue()
+            }
+            Button("Import Archive…") {
+                importArchive()
+            }
+        } label: {
+            Image(systemName: "archivebox")
+        }
+        .help("Export or Import Messages")
+        .disabled(!messageViewModel.hasBrowsedQueue || messageViewModel.isArchiving)
+    }
+
+    /// Ask for a file and dump the current queue to it
+    private func exportQueue() {
+        let panel = NSSavePanel()
+        panel.nameFieldStringValue = "\(messageViewModel.currentQueueName ?? "queue").mqarchive"
+        guard panel.runModal() == .OK, let url = panel.url else { return }
+
+        Task {
+            try? await messageViewModel.exportQueue(to: url)
+        }
+    }
+
+    /// Ask for an archive and load it into the current queue
+    private func importArchive() {
+        let panel = NSOpenPanel()
+        panel.allowsMultipleSelection = false
+        panel.canChooseDirectories = false
+        guard panel.runModal() == .OK, let url = panel.url else { return }
+
+        Task {
+            try? await messageViewModel.importArchive(from: url)
+        }
+    }
+
     /// Toggle inspector visibility
     private var inspectorToggle: some View {
         Button {
@@ -288,7 +403,8 @@ struct MessageBrowserView: View {
             Label("Copy Message ID", systemImage: "doc.on.doc")
         }
 
-        if let payloadString = message.payloadString, !message.isBinaryPayload {
+        if let representation = messageViewModel.payloadRepresentations.representation(for: message),
+           let payloadString = representation.text, !representation.isBinary {
             Button {
                 copyToClipboard(payloadString)
             } label: {
@@ -415,6 +531,12 @@ struct MessageDetailView: View {
     /// The message to display details for
     let message: Message
 
+    /// Whether the complete payload is being fetched to replace a preview
+    var isLoadingPayload: Bool = false
+
+    /// Cache of decoded payloads (nil = decode inline on every redraw)
+    var payloadRepresentations: PayloadRepresentationCache? = nil
+
     /// Currently selected payload view mode
     @State private var payloadViewMode: PayloadViewMode = .text
 
@@ -570,6 +692,15 @@ struct MessageDetailView: View {
                 Text("Payload")
                     .font(.headline)
 
+                if isLoadingPayload {
+                    ProgressView()
+                        .controlSize(.small)
+                } else if message.isPayloadTruncated {
+                    Text("Preview of \(message.payloadSizeFormatted)")
+                        .font(.caption)
+                        .foregroundStyle(.secondary)
+                }
+
                 Spacer()
 
                 Picker("View Mode", selection: $payloadViewMode) {
@@ -588,9 +719,20 @@ struct MessageDetailView: View {
     /// Payload content based on selected view mode
     @ViewBuilder
     private var payloadContentView: some View {
+        if let representation {
+            payloadContentView(representation)
+        } else {
+            ProgressView("Decoding \(message.payloadSizeFormatted)...")
+                .frame(maxWidth: .infinity, minHeight: 100)
+        }
+    }
+
+    /// Payload content of a decoded payload
+    @ViewBuilder
+    private func payloadContentView(_ representation: PayloadRepresentation) -> some View {
         switch payloadViewMode {
         case .text:
-            if let text = message.payloadString, !message.isBinaryPayload {
+            if let text = representation.text, !representation.isBinary {
                 TextEditor(text: .constant(text))
                     .font(.system(.body, design: .monospaced))
                     .frame(minHeight: 200)
@@ -609,17 +751,22 @@ struct MessageDetailView: View {
             }
 
         case .hex:
+            // One text per page, built as it scrolls into view
             ScrollView([.horizontal, .vertical]) {
-                Text(message.payloadHexDump)
-                    .font(.system(.caption, design: .monospaced))
-                    .textSelection(.enabled)
+                LazyVStack(alignment: .leading, spacing: 0) {
+                    ForEach(0..<representation.hexDumpPageCount, id: \.self) { page in
+                        Text(hexDumpPage(page))
+                            .font(.system(.caption, design: .monospaced))
+                            .textSelection(.enabled)
+                    }
+                }
             }
             .frame(minHeight: 200)
             .background(Color(nsColor: .textBackgroundColor))
             .border(Color.gray.opacity(0.3))
 
         case .json:
-            if let jsonText = formatAsJSON(message.payloadString) {
+            if let jsonText = formattedJSON(representation) {
                 TextEditor(text: .constant(jsonText))
                     .font(.system(.body, design: .monospaced))
                     .frame(minHeight: 200)
@@ -641,16 +788,29 @@ struct MessageDetailView: View {
 
     // MARK: - Helpers
 
-    /// Attempt to format string as pretty-printed JSON
-    private func formatAsJSON(_ text: String?) -> String? {
-        guard let text = text,
-              let data = text.data(using: .utf8),
-              let json = try? JSONSerialization.jsonObject(with: data),
-              let prettyData = try? JSONSerialization.data(withJSONObject: json, options: [.prettyPrinted, .sortedKeys]),
-              let prettyString = String(data: prettyData, encoding: .utf8) else {
-            return nil
+    /// Decoded payload, nil while it is decoded in the background
+    private var representation: PayloadRepresentation? {
+        guard let payloadRepresentations else {
+            return PayloadRepresentation(message: message)
+        }
+        return payloadRepresentations.representation(for: message)
+    }
+
+    /// The payload pretty-printed as JSON, nil if it is not JSON
+    private func formattedJSON(_ representation: PayloadRepresentation) -> String? {
+        if let payloadRepresentations {
+            return payloadRepresentations.formattedJSON(for: message)
+        }
+        return representation.text.flatMap(PayloadRepresentation.formatAsJSON)
+    }
+
+    /// One page of the payload's hex dump
+    private func hexDumpPage(_ page: Int) -> String {
+        if let payloadRepresentations {
+            return payloadRepresentations.hexDumpPage(page, of: message)
         }
-        return prettyString
+        let range = PayloadRepresentation.hexDumpRange(page: page, byteCount: message.payload.count)
+        return Message.hexDump(of: message.payload, in: range)
     }
 }
 
@@ -52,6 +52,11 @@ struct QueueListView: View {
                 queueListView
             }
         }
+        .safeAreaInset(edge: .bottom) {
+            if let queueName = queueViewModel.purgingQueueName {
+                purgeProgressView(queueName: queueName)
+            }
+        }
         .navigationTitle("Queues")
         .searchable(
             text: $queueViewModel.searchText,
@@ -115,11 +120,30 @@ struct QueueListView: View {
 
     // MARK: - Subviews
 
+    /// Progress of a running purge, with a button to stop it
+    private func purgeProgressView(queueName: String) -> some View {
+        HStack(spacing: 8) {
+            ProgressView()
+                .controlSize(.small)
+            Text("Purging \"\(queueName)\": \(queueViewModel.purgedMessageCount) removed")
+                .font(.callout)
+                .foregroundStyle(.secondary)
+            Spacer()
+            Button("Stop") {
+                queueViewModel.cancelPurge()
+            }
+            .controlSize(.small)
+        }
+        .padding(.horizontal)
+        .padding(.vertical, 6)
+        .background(.bar)
+    }
+
     /// Main queue list
     private var queueListView: some View {
         List(selection: $selection) {
             ForEach(queueViewModel.filteredQueues) { queue in
-                QueueRowView(queue: queue)
+                QueueRowView(queue: queue, history: queueViewModel.depthHistories[queue.id])
                     .tag(queue.id)
                     .contextMenu {
                         queueContextMenu(for: queue)
@@ -163,7 +187,12 @@ struct QueueListView: View {
 
             Spacer()
 
-            if let date = queueViewModel.lastRefreshDate {
+            if let date = queueViewModel.snapshotDate {
+                Label("Last known, saved \(date, style: .relative) ago", systemImage: "clock.arrow.circlepath")
+                    .font(.caption)
+                    .foregroundStyle(.tertiary)
+                    .help("Shown from the saved queue list until the connection is open")
+            } else if let date = queueViewModel.lastRefreshDate {
                 Text("Updated \(date, style: .relative)")
                     .font(.caption)
                     .foregroundStyle(.tertiary)
@@ -330,21 +359,30 @@ struct QueueListView: View {
         defer { isOperationInProgress = false }
 
         do {
-            let messageCount = try await queueViewModel.purgeQueue(queueName: queue.name)
+            let result = try await queueViewModel.purgeQueue(queueName: queue.name)
 
             // Log to audit service
             AuditService.shared.logQueuePurged(
                 queueName: queue.name,
-                messageCount: messageCount,
+                messageCount: result.removedCount,
                 queueManager: queueManagerName,
                 username: nil
             )
-
-            // Refresh queue list to reflect changes
-            try? await queueViewModel.refresh()
         } catch {
             // Error is already handled by QueueViewModel (sets lastError and showErrorAlert)
+            // Messages committed before the failure are gone, so they are still audited
+            if queueViewModel.purgedMessageCount > 0 {
+                AuditService.shared.logQueuePurged(
+                    queueName: queue.name,
+                    messageCount: queueViewModel.purgedMessageCount,
+                    queueManager: queueManagerName,
+                    username: nil
+                )
+            }
         }
+
+        // Refresh queue list to reflect changes
+        try? await queueViewModel.refresh()
     }
 
     /// Perform queue delete with audit logging
@@ -0,0 +1,462 @@
+import Foundation
+import CMQC
+import CAllocationCounter
+@testable import MQMate
+
+// MARK: - Environment
+
+/// Settings of a benchmark run, read from the environment
+///
+/// Benchmarks only run with MQMATE_BENCHMARK=1, so a plain `swift test` skips
+/// them. Run them in release mode:
+///
+///     MQMATE_BENCHMARK=1 swift test -c release --filter MQMateBenchmarks
+struct BenchmarkEnvironment {
+
+    /// Queue manager measured instead of the simulator
+    struct QueueManagerEndpoint {
+        let name: String
+        let channel: String
+        let host: String
+        let port: Int
+        let username: String?
+        let password: String?
+    }
+
+    /// Whether the benchmarks run at all (MQMATE_BENCHMARK)
+    let isEnabled: Bool
+
+    /// Multiplier of every scenario's size (MQMATE_BENCHMARK_SCALE, default 1)
+    let scale: Double
+
+    /// Round-trip latency the simulator adds to each MQI call (MQMATE_BENCHMARK_LATENCY_US, default 0)
+    let latencyMicroseconds: Int32
+
+    /// File the results are written to (MQMATE_BENCHMARK_OUTPUT, default .build/benchmarks/latest.json)
+    let outputURL: URL
+
+    /// Results of an earlier run to compare against (MQMATE_BENCHMARK_BASELINE)
+    let baselineURL: URL?
+
+    /// Fraction by which a metric may get worse before it is a regression (MQMATE_BENCHMARK_TOLERANCE, default 0.1)
+    let tolerance: Double
+
+    /// Queue manager to measure (MQMATE_BENCHMARK_QMGR, _CHANNEL, _HOST, _PORT, _USER, _PASSWORD);
+    /// nil measures the in-process simulator
+    let queueManager: QueueManagerEndpoint?
+
+    static let current = BenchmarkEnvironment(environment: ProcessInfo.processInfo.environment)
+
+    init(environment: [String: String]) {
+        isEnabled = environment["MQMATE_BENCHMARK"].map { !$0.isEmpty && $0 != "0" } ?? false
+        scale = environment["MQMATE_BENCHMARK_SCALE"].flatMap(Double.init).map { max($0, 0.0001) } ?? 1
+        latencyMicroseconds = environment["MQMATE_BENCHMARK_LATENCY_US"].flatMap(Int32.init) ?? 0
+        outputURL = URL(fileURLWithPath: environment["MQMATE_BENCHMARK_OUTPUT"] ?? ".build/benchmarks/latest.json")
+        baselineURL = environment["MQMATE_BENCHMARK_BASELINE"].map { URL(fileURLWithPath: $0) }
+        tolerance = environment["MQMATE_BENCHMARK_TOLERANCE"].flatMap(Double.init) ?? 0.1
+
+        if let name = environment["MQMATE_BENCHMARK_QMGR"], !name.isEmpty {
+            queueManager = QueueManagerEndpoint(
+                name: name,
+                channel: environment["MQMATE_BENCHMARK_CHANNEL"] ?? "DEV.APP.SVRCONN",
+                host: environment["MQMATE_BENCHMARK_HOST"] ?? "localhost",
+                port: environment["MQMATE_BENCHMARK_PORT"].flatMap(Int.init) ?? 1414,
+                username: environment["MQMATE_BENCHMARK_USER"],
+                password: environment["MQMATE_BENCHMARK_PASSWORD"]
+            )
+        } else {
+            queueManager = nil
+        }
+    }
+
+    /// Size of a scenario scaled by MQMATE_BENCHMARK_SCALE
+    /// - Parameter base: Size at scale 1
+    /// - Returns: The scaled size, at least 1
+    func count(_ base: Int) -> Int {
+        return max(1, Int((Double(base) * scale).rounded()))
+    }
+}
+
+// MARK: - Latency Samples
+
+/// Latencies of the operations a scenario repeats
+final class LatencySamples {
+
+    private(set) var nanoseconds: [UInt64] = []
+
+    /// Record the latency of one operation
+    func record(nanoseconds value: UInt64) {
+        nanoseconds.append(value)
+    }
+
+    /// Record the latency of one operation
+    func record(seconds value: TimeInterval) {
+        nanoseconds.append(UInt64(max(value, 0) * 1_000_000_000))
+    }
+
+    /// Run an operation and record its latency
+    @discardableResult
+    func time<T>(_ body: () async throws -> T) async rethrows -> T {
+        let start = DispatchTime.now().uptimeNanoseconds
+        let result = try await body()
+        nanoseconds.append(DispatchTime.now().uptimeNanoseconds - start)
+        return result
+    }
+
+    /// Summary of the recorded latencies, in microseconds
+    var summary: LatencySummary {
+        let sorted = nanoseconds.sorted()
+        guard !sorted.isEmpty else {
+            return LatencySummary(p50: 0, p90: 0, p99: 0, max: 0, mean: 0)
+        }
+
+        // Nearest-rank percentile
+        func percentile(_ fraction: Double) -> Double {
+            let rank = Int((fraction * Double(sorted.count)).rounded(.up))
+            return Double(sorted[min(max(rank, 1), sorted.count) - 1]) / 1_000
+        }
+        let total = sorted.reduce(0.0) { $0 + Double($1) }
+        return LatencySummary(
+            p50: percentile(0.50),
+            p90: percentile(0.90),
+            p99: percentile(0.99),
+            max: Double(sorted[sorted.count - 1]) / 1_000,
+            mean: total / Double(sorted.count) / 1_000
+        )
+    }
+}
+
+// MARK: - Results
+
+/// Latency percentiles of one scenario's operations, in microseconds
+struct LatencySummary: Codable, Equatable {
+    let p50: Double
+    let p90: Double
+    let p99: Double
+    let max: Double
+    let mean: Double
+}
+
+/// Measurements of one benchmark scenario
+struct BenchmarkResult: Codable {
+    /// Stable scenario name, the key results are compared by
+    let scenario: String
+    /// Queues or messages processed
+    let items: Int
+    /// What items counts, e.g. "messages"
+    let unit: String
+    /// Operations timed, e.g. listQueues calls or browsed pages
+    let operations: Int
+    let seconds: Double
+    let itemsPerSecond: Double
+    /// Latency of one operation
+    let operationLatency: LatencySummary
+    /// MQI calls per operation by verb; nil where the backend cannot count them
+    let mqiCallsPerOperation: [String: Double]?
+    /// Heap allocations of the whole process per item; nil where they cannot be counted
+    let allocationsPerItem: Double?
+    /// Peak resident set of the process so far, including the simulator's queues
+    let peakResidentBytes: UInt64
+}
+
+/// Results of one run, written as JSON
+struct BenchmarkReport: Codable {
+    static let currentSchemaVersion = 1
+
+    var schemaVersion = BenchmarkReport.currentSchemaVersion
+    let date: Date
+    /// "simulator" or "queue-manager"
+    let backend: String
+    let roundTripLatencyMicroseconds: Int32
+    let scale: Double
+    let operatingSystem: String
+    var results: [BenchmarkResult] = []
+
+    /// Metrics of a result that got worse than in a baseline by more than tolerance
+    /// - Parameters:
+    ///   - result: A result of this run
+    ///   - tolerance: Fraction by which a metric may get worse
+    /// - Returns: A description of every regressed metric
+    func regressions(of result: BenchmarkResult, tolerance: Double) -> [String] {
+        guard let baseline = results.first(where: { $0.scenario == result.scenario }) else {
+            return []
+        }
+        var regressions: [String] = []
+        func check(_ metric: String, _ current: Double, _ previous: Double, higherIsBetter: Bool) {
+            guard previous > 0 else {
+                return
+            }
+            let change = (current - previous) / previous
+            if higherIsBetter ? change < -tolerance : change > tolerance {
+                regressions.append(String(format: "%@ %@: %.2f -> %.2f (%+.1f%%)", result.scenario, metric, previous, current, change * 100))
+            }
+        }
+        check("items/s", result.itemsPerSecond, baseline.itemsPerSecond, higherIsBetter: true)
+        check("p99 µs", result.operationLatency.p99, baseline.operationLatency.p99, higherIsBetter: false)
+        if let current = result.allocationsPerItem, let previous = baseline.allocationsPerItem {
+            check("allocations/item", current, previous, higherIsBetter: false)
+        }
+        return regressions
+    }
+}
+
+/// Collects the results of a run and rewrites the report after every scenario
+@MainActor
+final class BenchmarkRecorder {
+
+    static let shared = BenchmarkRecorder(environment: .current)
+
+    private let environment: BenchmarkEnvironment
+    private var report: BenchmarkReport
+    private lazy var baseline: BenchmarkReport? = environment.baselineURL.flatMap { url in
+        try? Self.decoder.decode(BenchmarkReport.self, from: Data(contentsOf: url))
+    }
+
+    private static let decoder: JSONDecoder = {
+        let decoder = JSONDecoder()
+        decoder.dateDecodingStrategy = .iso8601
+        return decoder
+    }()
+
+    private static let encoder: JSONEncoder = {
+        let encoder = JSONEncoder()
+        encoder.dateEncodingStrategy = .iso8601
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        return encoder
+    }()
+
+    init(environment: BenchmarkEnvironment) {
+        self.environment = environment
+        self.report = BenchmarkReport(
+            date: Date(),
+            backend: environment.queueManager == nil ? "simulator" : "queue-manager",
+            roundTripLatencyMicroseconds: environment.queueManager == nil ? environment.latencyMicroseconds : 0,
+            scale: environment.scale,
+            operatingSystem: ProcessInfo.processInfo.operatingSystemVersionString
+        )
+    }
+
+    /// Add a result to the report and write it out
+    /// - Parameter result: Measurements of a scenario
+    /// - Returns: Regressions against the baseline, empty without one
+    func record(_ result: BenchmarkResult) throws -> [String] {
+        report.results.removeAll { $0.scenario == result.scenario }
+        report.results.append(result)
+
+        let directory = environment.outputURL.deletingLastPathComponent()
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        try Self.encoder.encode(report).write(to: environment.outputURL, options: .atomic)
+
+        print(String(
+            format: "[benchmark] %@: %.0f %@/s, p50 %.1f µs, p99 %.1f µs, %@ allocations/item, peak RSS %.1f MB",
+            result.scenario, result.itemsPerSecond, result.unit,
+            result.operationLatency.p50, result.operationLatency.p99,
+            result.allocationsPerItem.map { String(format: "%.2f", $0) } ?? "n/a",
+            Double(result.peakResidentBytes) / 1_048_576
+        ))
+        return baseline?.regressions(of: result, tolerance: environment.tolerance) ?? []
+    }
+}
+
+// MARK: - Harness
+
+/// A connected MQService and the queue manager behind it, simulated or real
+@MainActor
+final class BenchmarkHarness {
+
+    let environment: BenchmarkEnvironment
+    let service = MQService()
+
+    /// Queues the scenarios defined, removed again on a real queue manager
+    private var definedQueues: [String] = []
+
+    private var usesSimulator: Bool {
+        return environment.queueManager == nil
+    }
+
+    /// MQI verbs counted by the simulator, by the names the results use
+    private static let simulatorVerbs: [(name: String, call: MQLONG)] = [
+        ("MQCONNX", MQMATE_SIM_CALL_CONNX), ("MQDISC", MQMATE_SIM_CALL_DISC),
+        ("MQOPEN", MQMATE_SIM_CALL_OPEN), ("MQCLOSE", MQMATE_SIM_CALL_CLOSE),
+        ("MQGET", MQMATE_SIM_CALL_GET), ("MQPUT", MQMATE_SIM_CALL_PUT),
+        ("MQINQ", MQMATE_SIM_CALL_INQ), ("MQCMIT", MQMATE_SIM_CALL_CMIT),
+        ("MQBACK", MQMATE_SIM_CALL_BACK), ("MQSTAT", MQMATE_SIM_CALL_STAT),
+        ("MQCB", MQMATE_SIM_CALL_CB), ("MQCTL", MQMATE_SIM_CALL_CTL)
+    ]
+
+    private init(environment: BenchmarkEnvironment) {
+        self.environment = environment
+    }
+
+    /// Start the simulator (or use the configured queue manager) and connect
+    /// - Parameter environment: Settings of the run
+    /// - Returns: A connected harness
+    /// - Throws: MQError if the connection fails, or when the simulator is
+    ///   wanted but MQI calls go to the IBM MQ client
+    static func connect(environment: BenchmarkEnvironment) async throws -> BenchmarkHarness {
+        let harness = BenchmarkHarness(environment: environment)
+        if let endpoint = environment.queueManager {
+            try await harness.service.connect(
+                queueManager: endpoint.name,
+                channel: endpoint.channel,
+                host: endpoint.host,
+                port: endpoint.port,
+                username: endpoint.username,
+                password: endpoint.password
+            )
+        } else {
+            guard mqmate_sim_enable("QM1") else {
+                throw MQError.invalidConfiguration(
+                    message: "The IBM MQ client is installed; set MQMATE_BENCHMARK_QMGR to benchmark a queue manager"
+                )
+            }
+            mqmate_sim_set_latency(environment.latencyMicroseconds, 0)
+            try await harness.service.connect(
+                queueManager: "QM1",
+                channel: "DEV.APP.SVRCONN",
+                host: "localhost",
+                port: 1414,
+                username: nil,
+                password: nil
+            )
+        }
+        return harness
+    }
+
+    /// Disconnect, removing the queues defined on a real queue manager
+    func close() async {
+        if !usesSimulator {
+            for queueName in definedQueues {
+                _ = try? await service.purgeQueue(queueName: queueName)
+                try? await service.deleteQueue(queueName: queueName)
+            }
+        }
+        definedQueues = []
+        service.disconnect()
+        if usesSimulator {
+            mqmate_sim_disable()
+        }
+    }
+
+    // MARK: - Setup
+
+    /// Define local queues for a scenario, outside the measurement
+    /// - Parameters:
+    ///   - names: Queue names
+    ///   - maxDepth: MAXDEPTH of each queue
+    func defineQueues(_ names: [String], maxDepth: Int32 = 5000) async throws {
+        definedQueues += names
+        if usesSimulator {
+            for name in names {
+                let reason = mqmate_sim_define_queue(name, MQQT_LOCAL, maxDepth)
+                guard reason == MQRC_NONE else {
+                    throw MQError.from(reasonCode: reason, context: name)
+                }
+            }
+        } else {
+            let failures = try await service.createQueues(
+                names.map { MQService.QueueDefinition(name: $0, queueType: .local, maxDepth: maxDepth) }
+            )
+            if let failure = failures.first {
+                throw failure.value
+            }
+        }
+    }
+
+    /// Put identical messages on a queue, outside the measurement
+    func putMessages(_ count: Int, payload: Data, on queueName: String) async throws {
+        if usesSimulator {
+            let reason = payload.withUnsafeBytes { bytes in
+                mqmate_sim_put_messages(queueName, MQLONG(count), bytes.baseAddress, MQLONG(bytes.count), nil)
+            }
+            guard reason == MQRC_NONE else {
+                throw MQError.from(reasonCode: reason, context: queueName)
+            }
+        } else {
+            let messages = [MQService.OutgoingMessage](repeating: MQService.OutgoingMessage(payload: payload), count: count)
+            let results = try await service.sendMessages(queueName: queueName, batch: messages, commitInterval: 1_000)
+            if let error = results.lazy.compactMap(\.error).first {
+                throw error
+            }
+        }
+    }
+
+    // MARK: - Measurement
+
+    /// MQI calls answered so far by verb; nil on a real queue manager
+    private func mqiCallCounts() -> [String: UInt64]? {
+        guard usesSimulator else {
+            return nil
+        }
+        var counts: [String: UInt64] = [:]
+        for verb in Self.simulatorVerbs {
+            counts[verb.name] = mqmate_sim_call_count(verb.call)
+        }
+        return counts
+    }
+
+    /// Peak resident set size of the process in bytes
+    static func peakResidentBytes() -> UInt64 {
+        var usage = rusage()
+        getrusage(RUSAGE_SELF, &usage)
+        #if os(macOS)
+        return UInt64(usage.ru_maxrss)
+        #else
+        return UInt64(usage.ru_maxrss) * 1_024
+        #endif
+    }
+
+    /// Measure a scenario
+    /// - Parameters:
+    ///   - scenario: Stable name of the scenario
+    ///   - items: Queues or messages the body processes
+    ///   - unit: What items counts
+    ///   - body: The measured work; records the latency of each operation it repeats
+    /// - Returns: The scenario's measurements
+    func measure(
+        _ scenario: String,
+        items: Int,
+        unit: String,
+        _ body: (LatencySamples) async throws -> Void
+    ) async throws -> BenchmarkResult {
+        let samples = LatencySamples()
+        let callsBefore = mqiCallCounts()
+        let countsAllocations = mqmate_allocation_counter_start()
+        let start = DispatchTime.now().uptimeNanoseconds
+
+        do {
+            try await body(samples)
+        } catch {
+            mqmate_allocation_counter_stop()
+            throw error
+        }
+
+        let seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+        let allocations = mqmate_allocation_count()
+        mqmate_allocation_counter_stop()
+
+        let operations = max(samples.nanoseconds.count, 1)
+        var callsPerOperation: [String: Double]?
+        if let callsBefore, let callsAfter = mqiCallCounts() {
+            callsPerOperation = callsAfter.reduce(into: [:]) { result, entry in
+                let calls = entry.value - (callsBefore[entry.key] ?? 0)
+                if calls > 0 {
+                    result[entry.key] = Double(calls) / Double(operations)
+                }
+            }
+        }
+
+        return BenchmarkResult(
+            scenario: scenario,
+            items: items,
+            unit: unit,
+            operations: samples.nanoseconds.count,
+            seconds: seconds,
+            itemsPerSecond: seconds > 0 ? Double(items) / seconds : 0,
+            operationLatency: samples.summary,
+            mqiCallsPerOperation: callsPerOperation,
+            allocationsPerItem: countsAllocations ? Double(allocations) / Double(max(items, 1)) : nil,
+            peakResidentBytes: Self.peakResidentBytes()
+        )
+    }
+}
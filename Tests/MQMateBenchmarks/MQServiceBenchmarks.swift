@@ -0,0 +1,228 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Benchmarks of the MQService hot paths: queue listing, browsing, bulk put, purge and PCF decoding
+///
+/// Each scenario writes its measurements to the JSON report and fails when a
+/// baseline report is given and a metric regressed past the tolerance. See
+/// BenchmarkEnvironment for the settings
+@MainActor
+final class MQServiceBenchmarks: XCTestCase {
+
+    var harness: BenchmarkHarness!
+
+    private var environment: BenchmarkEnvironment {
+        return harness.environment
+    }
+
+    private var service: MQService {
+        return harness.service
+    }
+
+    override func setUp() async throws {
+        try await super.setUp()
+        try XCTSkipUnless(BenchmarkEnvironment.current.isEnabled, "Set MQMATE_BENCHMARK=1 to run the benchmarks")
+        harness = try await BenchmarkHarness.connect(environment: .current)
+    }
+
+    override func tearDown() async throws {
+        await harness?.close()
+        harness = nil
+        try await super.tearDown()
+    }
+
+    // MARK: - Helpers
+
+    /// A 256-byte text payload, the size of a typical small business message
+    private let payload = Data(String(repeating: "0123456789ABCDEF", count: 16).utf8)
+
+    /// Record a result and fail on every regression against the baseline
+    private func report(_ result: BenchmarkResult) throws {
+        for regression in try BenchmarkRecorder.shared.record(result) {
+            XCTFail("Regression: \(regression)")
+        }
+    }
+
+    /// Encode MQLONG values as raw bytes
+    private func bytes(_ values: [MQLONG]) -> [UInt8] {
+        return values.withUnsafeBytes { Array($0) }
+    }
+
+    /// One MQCMD_INQUIRE_Q response message for a local queue, as a command server sends it
+    private func inquireQueueResponse(queueName: String, depth: MQLONG, last: Bool) -> [UInt8] {
+        var message = bytes([
+            MQCFT_RESPONSE, MQCFH_STRUC_LENGTH, MQCFH_VERSION_1, MQCMD_INQUIRE_Q,
+            1, last ? MQCFC_LAST : MQCFC_NOT_LAST, MQCC_OK, MQRC_NONE, 8
+        ])
+        message += bytes([MQCFT_STRING, MQCFST_STRUC_LENGTH_FIXED + MQ_Q_NAME_LENGTH, MQCA_Q_NAME, 1208, MQ_Q_NAME_LENGTH])
+        message += queueName.toMQCharArray(length: Int(MQ_Q_NAME_LENGTH)).map { UInt8(bitPattern: $0) }
+        let attributes: [(MQLONG, MQLONG)] = [
+            (MQIA_Q_TYPE, MQQT_LOCAL), (MQIA_CURRENT_Q_DEPTH, depth), (MQIA_MAX_Q_DEPTH, 5000),
+            (MQIA_OPEN_INPUT_COUNT, 1), (MQIA_OPEN_OUTPUT_COUNT, 2),
+            (MQIA_INHIBIT_GET, MQQA_GET_ALLOWED), (MQIA_INHIBIT_PUT, MQQA_PUT_ALLOWED)
+        ]
+        for (parameter, value) in attributes {
+            message += bytes([MQCFT_INTEGER, MQCFIN_STRUC_LENGTH, parameter, value])
+        }
+        return message
+    }
+
+    // MARK: - Queue Listing
+
+    func testQueueListing() async throws {
+        // Given - 10,000 queues, listed with one MQCMD_INQUIRE_Q per pass
+        let queueCount = environment.count(10_000)
+        let passes = 5
+        let names = (0..<queueCount).map { String(format: "MQMATE.BENCH.Q%06d", $0) }
+        try await harness.defineQueues(names)
+
+        // When
+        let result = try await harness.measure("queue-listing", items: queueCount * passes, unit: "queues") { samples in
+            for _ in 0..<passes {
+                let queues = try await samples.time {
+                    try await self.service.listQueues(filter: "MQMATE.BENCH.*")
+                }
+                XCTAssertEqual(queues.count, queueCount)
+            }
+        }
+
+        // Then
+        try report(result)
+    }
+
+    // MARK: - Browse
+
+    func testBrowse() async throws {
+        // Given - 100,000 messages, browsed a page of 1,000 at a time
+        let messageCount = environment.count(100_000)
+        let queueName = "MQMATE.BENCH.BROWSE"
+        try await harness.defineQueues([queueName], maxDepth: MQLONG(messageCount))
+        try await harness.putMessages(messageCount, payload: payload, on: queueName)
+
+        // When
+        var browsed = 0
+        let result = try await harness.measure("browse", items: messageCount, unit: "messages") { samples in
+            var page = try await samples.time {
+                try await self.service.browseMessages(queueName: queueName, maxMessages: 1_000)
+            }
+            while !page.isEmpty {
+                browsed += page.count
+                page = try await samples.time {
+                    try await self.service.browseNextMessages(queueName: queueName, maxMessages: 1_000)
+                }
+            }
+        }
+
+        // Then
+        XCTAssertEqual(browsed, messageCount)
+        try report(result)
+    }
+
+    // MARK: - Bulk Put
+
+    func testBulkPut() async throws {
+        try await measureBulkPut(scenario: "bulk-put", responseMode: .synchronous)
+    }
+
+    func testBulkPutWithAsynchronousResponses() async throws {
+        try await measureBulkPut(scenario: "bulk-put-async", responseMode: .asynchronous)
+    }
+
+    /// Put 20,000 messages in units of work of 500; each commit is one operation
+    private func measureBulkPut(scenario: String, responseMode: MQService.PutResponseMode) async throws {
+        // Given
+        let messageCount = environment.count(20_000)
+        let queueName = "MQMATE.BENCH.PUT"
+        try await harness.defineQueues([queueName], maxDepth: MQLONG(messageCount))
+        let messages = [MQService.OutgoingMessage](
+            repeating: MQService.OutgoingMessage(payload: payload, persistence: .notPersistent),
+            count: messageCount
+        )
+
+        // When
+        let result = try await harness.measure(scenario, items: messageCount, unit: "messages") { samples in
+            let batches = try await self.service.sendMessages(
+                queueName: queueName,
+                batch: messages,
+                commitInterval: 500,
+                responseMode: responseMode
+            )
+            for batch in batches {
+                XCTAssertTrue(batch.isCommitted)
+                samples.record(seconds: batch.duration)
+            }
+        }
+
+        // Then
+        let info = try await service.listQueues(filter: queueName).first
+        XCTAssertEqual(info?.currentDepth, MQLONG(messageCount))
+        try report(result)
+    }
+
+    // MARK: - Purge
+
+    func testPurge() async throws {
+        // Given - 100,000 messages, drained with destructive gets in units of work of 500
+        let messageCount = environment.count(100_000)
+        let queueName = "MQMATE.BENCH.PURGE"
+        try await harness.defineQueues([queueName], maxDepth: MQLONG(messageCount))
+        try await harness.putMessages(messageCount, payload: payload, on: queueName)
+
+        // When - each commit reported by progress ends one operation
+        var removed = 0
+        let result = try await harness.measure("purge", items: messageCount, unit: "messages") { samples in
+            var lastCommit = DispatchTime.now().uptimeNanoseconds
+            let purge = try await self.service.purgeQueue(
+                queueName: queueName,
+                options: MQService.PurgeOptions(strategy: .destructiveGet, batchSize: 500),
+                progress: { _ in
+                    let now = DispatchTime.now().uptimeNanoseconds
+                    samples.record(nanoseconds: now - lastCommit)
+                    lastCommit = now
+                }
+            )
+            removed = purge.removedCount
+        }
+
+        // Then
+        XCTAssertEqual(removed, messageCount)
+        try report(result)
+    }
+
+    // MARK: - PCF Decoding
+
+    func testPCFDecoding() async throws {
+        // Given - a listing's worth of INQUIRE_Q responses, decoded without a queue manager
+        let messageCount = environment.count(10_000)
+        let passes = 10
+        let messages = (0..<messageCount).map { index in
+            inquireQueueResponse(
+                queueName: String(format: "MQMATE.BENCH.Q%06d", index),
+                depth: MQLONG(index),
+                last: index == messageCount - 1
+            )
+        }
+        let service = self.service
+
+        // When
+        var decoded = 0
+        let result = try await harness.measure("pcf-decoding", items: messageCount * passes, unit: "messages") { samples in
+            for _ in 0..<passes {
+                try await samples.time {
+                    for message in messages {
+                        try message.withUnsafeBytes { raw in
+                            if let response = PCFResponse(bytes: raw), try service.parsePCFQueueResponse(response) != nil {
+                                decoded += 1
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Then
+        XCTAssertEqual(decoded, messageCount * passes)
+        try report(result)
+    }
+}
@@ -0,0 +1,50 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Unit tests for put response modes and MQSTAT result aggregation
+final class AsyncPutStatusTests: XCTestCase {
+
+    // MARK: - Response Mode Tests
+
+    func testResponseModePutOptions() {
+        XCTAssertEqual(MQService.PutResponseMode.synchronous.putOption, MQPMO_SYNC_RESPONSE)
+        XCTAssertEqual(MQService.PutResponseMode.asynchronous.putOption, MQPMO_ASYNC_RESPONSE)
+    }
+
+    // MARK: - Status Tests
+
+    func testStatusWithoutErrors() {
+        // Given
+        var status = MQSTS()
+        status.PutSuccessCount = 500
+
+        // When
+        let putStatus = MQService.AsyncPutStatus(status: status, queueName: "DEV.QUEUE.1")
+
+        // Then
+        XCTAssertEqual(putStatus.successCount, 500)
+        XCTAssertEqual(putStatus.failureCount, 0)
+        XCTAssertNil(putStatus.firstError)
+    }
+
+    func testStatusReportsFirstFailure() {
+        // Given
+        var status = MQSTS()
+        status.CompCode = MQCC_FAILED
+        status.Reason = MQError.MQRC_Q_FULL
+        status.PutSuccessCount = 480
+        status.PutFailureCount = 20
+
+        // When
+        let putStatus = MQService.AsyncPutStatus(status: status, queueName: "DEV.QUEUE.1")
+
+        // Then
+        XCTAssertEqual(putStatus.successCount, 480)
+        XCTAssertEqual(putStatus.failureCount, 20)
+        guard case .operationFailed(_, _, let reasonCode)? = putStatus.firstError else {
+            return XCTFail("Expected the first failed put")
+        }
+        XCTAssertEqual(reasonCode, MQError.MQRC_Q_FULL)
+    }
+}
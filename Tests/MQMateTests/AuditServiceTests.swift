@@ -0,0 +1,94 @@
+import XCTest
+@testable import MQMate
+
+/// Unit tests for AuditService: lock-free buffering, in-memory retention and the rotating file log
+final class AuditServiceTests: XCTestCase {
+
+    // MARK: - Properties
+
+    private var directory: URL!
+
+    // MARK: - Setup/Teardown
+
+    override func setUp() {
+        super.setUp()
+        directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("AuditServiceTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        directory = nil
+        super.tearDown()
+    }
+
+    // MARK: - Buffer Tests
+
+    func testConcurrentLoggingKeepsEveryEntry() {
+        // Given
+        let service = AuditService(maxEntries: 0, consoleOutput: false, bufferCapacity: 64)
+
+        // When
+        DispatchQueue.concurrentPerform(iterations: 8) { thread in
+            for index in 0..<1_000 {
+                service.log(actionType: .messageDeleted, resource: "Q\(thread)", details: "\(index)")
+            }
+        }
+
+        // Then
+        let entries = service.getAuditLog()
+        XCTAssertEqual(entries.count, 8_000, "A full buffer makes producers wait for the writer, never drop")
+        XCTAssertEqual(Set(entries.map(\.id)).count, 8_000)
+        for thread in 0..<8 {
+            let details = entries.filter { $0.resource == "Q\(thread)" }.compactMap(\.details)
+            XCTAssertEqual(details, (0..<1_000).reversed().map(String.init), "Each thread's entries keep their order")
+        }
+    }
+
+    func testMaxEntriesKeepsTheMostRecent() {
+        // Given
+        let service = AuditService(maxEntries: 3, consoleOutput: false)
+
+        // When
+        for index in 1...5 {
+            service.log(actionType: .messageSent, resource: "DEV.QUEUE.\(index)")
+        }
+
+        // Then
+        XCTAssertEqual(service.entryCount, 3)
+        XCTAssertEqual(service.getAuditLog().map(\.resource), ["DEV.QUEUE.5", "DEV.QUEUE.4", "DEV.QUEUE.3"])
+    }
+
+    // MARK: - File Sink Tests
+
+    func testFileLogRotatesAndExportStreamsEveryKeptEntry() throws {
+        // Given
+        let sink = AuditFileSink(directory: directory, maxFileSize: 1_024, maxFileCount: 3)
+        let service = AuditService(maxEntries: 10, consoleOutput: false, fileSink: sink)
+
+        // When
+        for index in 0..<40 {
+            service.log(actionType: .queuePurged, resource: "APP.QUEUE", details: "Batch \(index)")
+            service.flush()
+        }
+        let exportURL = directory.appendingPathComponent("export.json")
+        try service.exportAuditLog(to: exportURL)
+
+        // Then
+        XCTAssertEqual(sink.fileURLs.count, 3, "Files beyond maxFileCount are deleted")
+        let decoder = JSONDecoder()
+        decoder.dateDecodingStrategy = .iso8601
+        let exported = try decoder.decode([AuditEntry].self, from: Data(contentsOf: exportURL))
+        XCTAssertGreaterThan(exported.count, 10, "The file log keeps more than the in-memory entries")
+        let batches = exported.compactMap { $0.details.flatMap { Int($0.dropFirst("Batch ".count)) } }
+        XCTAssertEqual(batches, Array((40 - batches.count)..<40), "The newest entries are exported, oldest first")
+        XCTAssertEqual(try service.exportAuditLogAsJSON(), try Data(contentsOf: exportURL))
+
+        // When
+        service.clearAuditLog()
+
+        // Then
+        XCTAssertTrue(sink.fileURLs.isEmpty)
+        XCTAssertEqual(try decoder.decode([AuditEntry].self, from: service.exportAuditLogAsJSON()), [])
+    }
+}
@@ -0,0 +1,76 @@
+import XCTest
+@testable import MQMate
+
+/// Unit tests for client-side character set conversion by CCSID and Encoding
+final class CharacterSetConverterTests: XCTestCase {
+
+    // MARK: - EBCDIC Tests
+
+    func testEBCDICCodePagesDecodeTheirOwnPunctuation() throws {
+        // Given
+        let codePage500 = try XCTUnwrap(CharacterSetConverter.converter(ccsid: 500, encoding: 785))
+        let codePage037 = try XCTUnwrap(CharacterSetConverter.converter(ccsid: 37, encoding: 785))
+
+        // When
+        let international = codePage500.decode(Data([0xC8, 0x85, 0x93, 0x93, 0x96, 0x4F]))
+        let american = codePage037.decode(Data([0xC8, 0x85, 0x93, 0x93, 0x96, 0x5A]))
+
+        // Then
+        XCTAssertEqual(international, "Hello!")
+        XCTAssertEqual(american, "Hello!")
+    }
+
+    func testEBCDICRoundTripsAccentedTextAndTheEuroSign() throws {
+        // Given
+        let codePage500 = try XCTUnwrap(CharacterSetConverter.converter(ccsid: 500, encoding: 785))
+        let codePage1148 = try XCTUnwrap(CharacterSetConverter.converter(ccsid: 1148, encoding: 785))
+
+        // When
+        let accented = try XCTUnwrap(codePage500.encode("[café]"))
+        let euro = try XCTUnwrap(codePage1148.encode("€5"))
+
+        // Then
+        XCTAssertEqual(accented, Data([0x4A, 0x83, 0x81, 0x86, 0x51, 0x5A]))
+        XCTAssertEqual(codePage500.decode(accented), "[café]")
+        XCTAssertEqual(euro, Data([0x9F, 0xF5]))
+        XCTAssertEqual(codePage1148.decode(euro), "€5")
+        XCTAssertNil(codePage500.encode("€"), "CCSID 500 has no euro sign")
+    }
+
+    // MARK: - Encoding Tests
+
+    func testUTF16ByteOrderFollowsTheIntegerEncoding() throws {
+        // Given
+        let reversed = try XCTUnwrap(CharacterSetConverter.converter(ccsid: 1200, encoding: CharacterSetConverter.nativeEncoding))
+        let normal = try XCTUnwrap(CharacterSetConverter.converter(ccsid: 1200, encoding: 273))
+
+        // When
+        let littleEndian = reversed.decode(Data([0x48, 0x00, 0x69, 0x00]))
+        let bigEndian = normal.decode(Data([0x00, 0x48, 0x00, 0x69]))
+
+        // Then
+        XCTAssertEqual(littleEndian, "Hi")
+        XCTAssertEqual(bigEndian, "Hi")
+    }
+
+    func testMessagePayloadIsDecodedByItsCCSID() {
+        // Given
+        let message = Message(
+            messageId: [UInt8](repeating: 1, count: 24),
+            correlationId: [UInt8](repeating: 0, count: 24),
+            format: "MQSTR",
+            payload: Data([0xC8, 0x85, 0x93, 0x93, 0x96]),
+            putDateTime: nil,
+            putApplicationName: "Mainframe",
+            codedCharSetId: 500,
+            encoding: 785
+        )
+
+        // When
+        let unsupported = CharacterSetConverter.converter(ccsid: 9999, encoding: 546)
+
+        // Then
+        XCTAssertEqual(message.payloadString, "Hello")
+        XCTAssertNil(unsupported)
+    }
+}
@@ -20,7 +20,8 @@ final class ConnectionManagerTests: XCTestCase {
         mockKeychain = MockKeychainService()
         connectionManager = ConnectionManager(
             mqService: mockMQService,
-            keychainService: mockKeychain
+            keychainService: mockKeychain,
+            snapshotCache: nil
         )
         // Clear any persisted data
         UserDefaults.standard.removeObject(forKey: "mqmate.savedConnections")
@@ -594,6 +595,75 @@ final class ConnectionManagerTests: XCTestCase {
         XCTAssertTrue(connectionManager.queues(for: config.id).isEmpty)
     }
 
+    func testRefreshQueuesDisconnectedMidListingKeepsDisconnectedState() async throws {
+        // Given - a refresh waiting on the listing
+        let config = createTestConfig(name: "Test")
+        try connectionManager.addConnection(config, password: "test")
+        try await connectionManager.connect(id: config.id)
+        let refresh = Task { try await connectionManager.refreshQueues(for: config.id) }
+        try await Task.sleep(nanoseconds: 50_000_000)
+
+        // When - the connection is dropped before the listing answers
+        connectionManager.disconnect(id: config.id)
+        try await refresh.value
+
+        // Then - the late listing does not bring the queues back
+        XCTAssertFalse(connectionManager.isConnected(id: config.id))
+        XCTAssertTrue(connectionManager.queues(for: config.id).isEmpty)
+    }
+
+    // MARK: - Fan-Out Tests
+
+    func testConnectAllOpensEveryConnectionOnItsOwnService() async throws {
+        // Given
+        var services: [MockMQService] = []
+        let manager = ConnectionManager(
+            keychainService: mockKeychain,
+            serviceFactory: {
+                let service = MockMQService()
+                services.append(service)
+                return service
+            },
+            snapshotCache: nil
+        )
+        let configs = ["A", "B", "C"].map(createTestConfig)
+        for config in configs {
+            try manager.addConnection(config, password: "test")
+        }
+
+        // When
+        var connectedIds: [UUID] = []
+        for await result in manager.connectAll(maxConcurrent: 2) {
+            if case .success = result.result {
+                connectedIds.append(result.connectionId)
+            }
+        }
+
+        // Then
+        XCTAssertEqual(Set(connectedIds), Set(configs.map(\.id)))
+        XCTAssertEqual(services.count, 3, "Each queue manager gets its own service")
+        XCTAssertTrue(services.allSatisfy(\.isConnected))
+        XCTAssertTrue(configs.allSatisfy { !manager.queues(for: $0.id).isEmpty }, "Queues are listed as each connects")
+    }
+
+    func testTotalDepthStreamsOneResultPerQueueManager() async throws {
+        // Given
+        let config = createTestConfig(name: "Test")
+        try connectionManager.addConnection(config, password: "test")
+        try await connectionManager.connect(id: config.id)
+
+        // When
+        var results: [ConnectionManager.FanOutResult<Int64>] = []
+        for await result in connectionManager.totalDepth(ofQueuesMatching: "DEV.*") {
+            results.append(result)
+        }
+
+        // Then
+        XCTAssertEqual(results.count, 1)
+        XCTAssertEqual(results.first?.queueManager, config.queueManager)
+        XCTAssertEqual(try results.first?.result.get(), 147)
+    }
+
     // MARK: - Has Password Tests
 
     func testHasPasswordReturnsTrue() throws {
@@ -1074,24 +1144,29 @@ final class MockMQServiceTests: XCTestCase {
         }
     }
 
-    func testMockMQServiceGetQueueInfo() throws {
+    func testMockMQServiceGetQueueInfo() async throws {
         // Given
         let mock = MockMQService()
         let queueName = mock.simulatedQueues.first!.name
 
         // When
-        let info = try mock.getQueueInfo(queueName: queueName)
+        let info = try await mock.getQueueInfo(queueName: queueName)
 
         // Then
         XCTAssertEqual(info.name, queueName)
     }
 
-    func testMockMQServiceGetQueueInfoNotFound() {
+    func testMockMQServiceGetQueueInfoNotFound() async {
         // Given
         let mock = MockMQService()
 
         // When/Then
-        XCTAssertThrowsError(try mock.getQueueInfo(queueName: "NON.EXISTENT.QUEUE"))
+        do {
+            _ = try await mock.getQueueInfo(queueName: "NON.EXISTENT.QUEUE")
+            XCTFail("getQueueInfo should have thrown")
+        } catch {
+            XCTAssertNotNil(error as? MQError)
+        }
     }
 
     func testMockMQServiceCustomQueues() async throws {
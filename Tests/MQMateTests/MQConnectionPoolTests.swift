@@ -0,0 +1,112 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Unit tests for connection pool settings and connection-loss classification
+@MainActor
+final class MQConnectionPoolTests: XCTestCase {
+
+    // MARK: - Configuration Tests
+
+    func testConfigurationDefaults() {
+        // When
+        let configuration = MQConnectionPool.Configuration()
+
+        // Then
+        XCTAssertEqual(configuration.minimumConnections, 1)
+        XCTAssertEqual(configuration.maximumConnections, 4)
+        XCTAssertEqual(configuration.healthCheckInterval, 60)
+    }
+
+    func testConfigurationKeepsLimitsConsistent() {
+        // When
+        let configuration = MQConnectionPool.Configuration(minimumConnections: 0, maximumConnections: 0)
+        let inverted = MQConnectionPool.Configuration(minimumConnections: 3, maximumConnections: 2)
+
+        // Then
+        XCTAssertEqual(configuration.minimumConnections, 1, "A pool always keeps one connection")
+        XCTAssertEqual(configuration.maximumConnections, 1)
+        XCTAssertEqual(inverted.maximumConnections, 3, "The maximum is raised to the minimum")
+    }
+
+    // MARK: - Endpoint Tests
+
+    func testEndpointIgnoresDisplayFields() {
+        // Given
+        let config = ConnectionConfig(
+            name: "Development",
+            queueManager: "QM1",
+            hostname: "localhost",
+            channel: "DEV.APP.SVRCONN",
+            username: "app"
+        )
+        var renamed = config
+        renamed.name = "Dev (renamed)"
+        var otherChannel = config
+        otherChannel.channel = "DEV.ADMIN.SVRCONN"
+
+        // Then
+        XCTAssertEqual(MQConnectionPool.Endpoint(config: config), MQConnectionPool.Endpoint(config: renamed))
+        XCTAssertNotEqual(MQConnectionPool.Endpoint(config: config), MQConnectionPool.Endpoint(config: otherChannel))
+    }
+
+    // MARK: - Connection Loss Tests
+
+    func testConnectionLossReasonCodes() {
+        // Given
+        let broken = MQError.operationFailed(operation: "MQGET", completionCode: 2, reasonCode: MQError.MQRC_CONNECTION_BROKEN)
+        let badHandle = MQError.operationFailed(operation: "MQPUT", completionCode: 2, reasonCode: MQError.MQRC_HCONN_ERROR)
+        let queueFull = MQError.operationFailed(operation: "MQPUT", completionCode: 2, reasonCode: MQError.MQRC_Q_FULL)
+
+        // Then
+        XCTAssertTrue(broken.isConnectionLost)
+        XCTAssertTrue(badHandle.isConnectionLost)
+        XCTAssertTrue(MQError.connectionBroken.isConnectionLost)
+        XCTAssertFalse(queueFull.isConnectionLost, "Queue errors leave the connection usable")
+        XCTAssertFalse(MQError.notConnected.isConnectionLost)
+    }
+
+    func testObjectHandleInvalidation() {
+        // Given
+        let changed = MQError.operationFailed(operation: "MQPUT", completionCode: 2, reasonCode: MQError.MQRC_OBJECT_CHANGED)
+        let deleted = MQError.operationFailed(operation: "MQGET", completionCode: 2, reasonCode: MQError.MQRC_Q_DELETED)
+        let inhibited = MQError.operationFailed(operation: "MQPUT", completionCode: 2, reasonCode: MQError.MQRC_PUT_INHIBITED)
+
+        // Then
+        XCTAssertTrue(changed.invalidatesObjectHandle)
+        XCTAssertTrue(deleted.invalidatesObjectHandle)
+        XCTAssertTrue(MQError.connectionBroken.invalidatesObjectHandle)
+        XCTAssertFalse(inhibited.invalidatesObjectHandle, "An inhibited queue can be used again once enabled")
+        XCTAssertFalse(changed.isConnectionLost)
+    }
+
+    // MARK: - Role Tests
+
+    func testLostRoleConnectionIsReplacedOnItsNextUse() async throws {
+        // Given - a pool on the simulator without health checks
+        try XCTSkipUnless(mqmate_sim_enable("QM1"), "MQI calls go to the IBM MQ client")
+        defer { mqmate_sim_disable() }
+        let pool = try await MQConnectionPool.open(
+            endpoint: MQConnectionPool.Endpoint(queueManager: "QM1", channel: "DEV.APP.SVRCONN", host: "localhost", port: 1414, username: nil),
+            password: nil,
+            configuration: MQConnectionPool.Configuration(healthCheckInterval: nil)
+        )
+        defer { pool.close() }
+        let broken = try await pool.connection(for: .admin)
+
+        // When
+        do {
+            try await pool.withConnection(for: .admin) { _ in
+                throw MQError.operationFailed(operation: "MQPUT", completionCode: MQCC_FAILED, reasonCode: MQError.MQRC_CONNECTION_BROKEN)
+            }
+            XCTFail("Expected the operation's error")
+        } catch let error as MQError {
+            XCTAssertTrue(error.isConnectionLost)
+        }
+        let replacement = try await pool.connection(for: .admin)
+
+        // Then
+        XCTAssertNotIdentical(replacement, broken, "The broken connection is not handed out again")
+        XCTAssertEqual(pool.connectionCount, 1)
+    }
+}
@@ -0,0 +1,109 @@
+import XCTest
+@testable import MQMate
+
+/// Unit tests for the per-connection MQI thread
+final class MQConnectionThreadTests: XCTestCase {
+
+    // MARK: - Properties
+
+    private var thread: MQConnectionThread!
+
+    // MARK: - Setup
+
+    override func setUp() {
+        super.setUp()
+        thread = MQConnectionThread(name: "MQMateTests.MQConnectionThread")
+        thread.start()
+    }
+
+    override func tearDown() {
+        thread.stop()
+        thread = nil
+        super.tearDown()
+    }
+
+    // MARK: - Job Tests
+
+    func testJobsRunInSubmissionOrder() {
+        // Given
+        let done = expectation(description: "All jobs ran")
+        let lock = NSLock()
+        var order: [Int] = []
+
+        // When
+        for index in 0..<100 {
+            thread.enqueue {
+                lock.lock()
+                order.append(index)
+                lock.unlock()
+                if index == 99 {
+                    done.fulfill()
+                }
+            }
+        }
+
+        // Then
+        wait(for: [done], timeout: 5)
+        XCTAssertEqual(order, Array(0..<100))
+    }
+
+    func testJobsRunOnTheConnectionThread() {
+        // Given
+        let done = expectation(description: "Job ran")
+        var ranOnConnectionThread = false
+        var ranOnMainThread = true
+
+        // When
+        thread.enqueue { [thread] in
+            ranOnConnectionThread = thread?.isCurrent ?? false
+            ranOnMainThread = Thread.isMainThread
+            done.fulfill()
+        }
+
+        // Then
+        wait(for: [done], timeout: 5)
+        XCTAssertTrue(ranOnConnectionThread)
+        XCTAssertFalse(ranOnMainThread, "MQI calls must not run on the main thread")
+        XCTAssertFalse(thread.isCurrent)
+    }
+
+    func testIndependentThreadsRunInParallel() {
+        // Given - a job on one thread that blocks until a job on another thread runs
+        let other = MQConnectionThread(name: "MQMateTests.MQConnectionThread.Other")
+        other.start()
+        defer { other.stop() }
+        let unblocked = DispatchSemaphore(value: 0)
+        let done = expectation(description: "Blocked job finished")
+
+        // When
+        thread.enqueue {
+            if unblocked.wait(timeout: .now() + 5) == .success {
+                done.fulfill()
+            }
+        }
+        other.enqueue {
+            unblocked.signal()
+        }
+
+        // Then
+        wait(for: [done], timeout: 5)
+    }
+
+    func testStopRunsQueuedJobsAndRejectsNewOnes() {
+        // Given
+        let done = expectation(description: "Queued job ran")
+        thread.enqueue {
+            done.fulfill()
+        }
+
+        // When
+        thread.stop()
+        let accepted = thread.enqueue {
+            XCTFail("A job submitted after stop() should not run")
+        }
+
+        // Then
+        wait(for: [done], timeout: 5)
+        XCTAssertFalse(accepted)
+    }
+}
@@ -0,0 +1,65 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Unit tests for the MQI structure templates and fixed-length field marshalling
+final class MQIMarshallingTests: XCTestCase {
+
+    // MARK: - Template Tests
+
+    func testTemplatesHoldTheDefaultStructures() {
+        // Given
+        let messageDescriptor = MQMD.template
+        let getOptions = MQGMO.template
+        let objectDescriptor = MQOD.template
+
+        // Then
+        XCTAssertEqual(MQIField.string(of: messageDescriptor.StrucId), "MD")
+        XCTAssertEqual(messageDescriptor.Version, MQMD_VERSION_2)
+        XCTAssertEqual(messageDescriptor.Expiry, MQEI_UNLIMITED)
+        XCTAssertEqual(messageDescriptor.Priority, MQPRI_PRIORITY_AS_Q_DEF)
+        XCTAssertEqual(MQIField.bytes(of: messageDescriptor.Format), Array("        ".utf8), "MQFMT_NONE")
+        XCTAssertEqual(MQIField.string(of: getOptions.StrucId), "GMO")
+        XCTAssertEqual(getOptions.MatchOptions, MQMO_NONE, "Gets opt in to the fields they match on")
+        XCTAssertEqual(MQIField.string(of: MQPMO.template.StrucId), "PMO")
+        XCTAssertEqual(objectDescriptor.Version, MQOD_VERSION_4)
+        XCTAssertEqual(objectDescriptor.ObjectType, MQOT_Q)
+        XCTAssertEqual(MQIField.string(of: objectDescriptor.DynamicQName), "AMQ.*")
+        XCTAssertEqual(MQIField.string(of: MQSTS.template.StrucId), "STAT")
+        XCTAssertEqual(MQSTS.template.Version, MQSTS_VERSION_1)
+    }
+
+    // MARK: - Field Tests
+
+    func testCharacterFieldsAreBlankPaddedAndTrimmed() {
+        // Given
+        var objectDescriptor = MQOD.template
+
+        // When
+        MQIField.setString("DEV.QUEUE.1", in: &objectDescriptor.ObjectName)
+
+        // Then
+        let bytes = MQIField.bytes(of: objectDescriptor.ObjectName)
+        XCTAssertEqual(bytes, Array("DEV.QUEUE.1".utf8) + [UInt8](repeating: 0x20, count: 37))
+        XCTAssertEqual(MQIField.string(of: objectDescriptor.ObjectName), "DEV.QUEUE.1")
+        XCTAssertEqual(MQIField.string(of: MQMD.template.ReplyToQ), "", "Null padding is trimmed as well")
+
+        // When - longer than the field
+        MQIField.setString(String(repeating: "Q", count: 60), in: &objectDescriptor.ObjectName)
+
+        // Then
+        XCTAssertEqual(MQIField.string(of: objectDescriptor.ObjectName), String(repeating: "Q", count: 48))
+    }
+
+    func testByteFieldsAreZeroPadded() {
+        // Given
+        var messageDescriptor = MQMD.template
+        MQIField.setBytes([UInt8](repeating: 0xFF, count: 24), in: &messageDescriptor.MsgId)
+
+        // When
+        MQIField.setBytes([0x01, 0x02, 0x03], in: &messageDescriptor.MsgId)
+
+        // Then
+        XCTAssertEqual(MQIField.bytes(of: messageDescriptor.MsgId), [0x01, 0x02, 0x03] + [UInt8](repeating: 0, count: 21))
+    }
+}
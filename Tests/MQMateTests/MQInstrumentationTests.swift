@@ -0,0 +1,100 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Unit tests for the MQI call instrumentation and its latency histograms
+final class MQInstrumentationTests: XCTestCase {
+
+    // MARK: - Histogram Tests
+
+    func testHistogramPercentilesStayWithinOneBucket() {
+        // Given - 1 µs to 1 ms in 1 µs steps
+        let histogram = MQLatencyHistogram()
+        for microseconds in 1...1_000 {
+            histogram.record(UInt64(microseconds) * 1_000)
+        }
+
+        // When
+        let summary = histogram.summary()
+
+        // Then - a bucket is at most 1/32 of its values wide
+        XCTAssertEqual(summary.count, 1_000)
+        XCTAssertEqual(summary.mean, 500_500, accuracy: 0.5)
+        XCTAssertEqual(summary.max, 1_000_000)
+        for (percentile, exact) in [(summary.p50, 500_000.0), (summary.p99, 990_000.0), (summary.p999, 999_000.0)] {
+            XCTAssertGreaterThanOrEqual(Double(percentile), exact)
+            XCTAssertLessThanOrEqual(Double(percentile), exact * (1 + 1.0 / 32))
+        }
+        XCTAssertEqual(MQLatencyHistogram.bucketIndex(of: 31), 31, "Small values have a bucket each")
+        XCTAssertEqual(MQLatencyHistogram.bucketIndex(of: UInt64.max), MQLatencyHistogram.bucketCount - 1)
+    }
+
+    // MARK: - Recording Tests
+
+    func testNothingIsRecordedWhileDisabled() {
+        // Given
+        let instrumentation = MQInstrumentation(isEnabled: false)
+
+        // When
+        let call = instrumentation.begin(.get)
+        instrumentation.end(call, .get, connection: 1, queue: "DEV.QUEUE.1", bytes: 100)
+        instrumentation.measure(.pcfDecode) {}
+
+        // Then
+        let snapshot = instrumentation.snapshot()
+        XCTAssertFalse(snapshot.isRecording)
+        XCTAssertTrue(snapshot.verbs.isEmpty)
+        XCTAssertTrue(snapshot.connections.isEmpty)
+        XCTAssertTrue(snapshot.queues.isEmpty)
+        XCTAssertEqual(instrumentation.histogram(for: .get).summary().count, 0)
+    }
+
+    func testCallsAreCountedPerVerbConnectionAndQueue() throws {
+        // Given
+        let instrumentation = MQInstrumentation(isEnabled: true)
+        instrumentation.registerConnection(7, queueManager: "QM1")
+
+        // When - two gets, one of them failing, a put and a commit
+        for (bytes, compCode) in [(120, MQCC_OK), (0, MQCC_FAILED)] {
+            let call = instrumentation.begin(.get)
+            instrumentation.end(call, .get, connection: 7, queue: "DEV.QUEUE.1", bytes: bytes, compCode: compCode)
+        }
+        let put = instrumentation.begin(.put)
+        instrumentation.end(put, .put, connection: 7, queue: "DEV.QUEUE.2", bytes: 80, compCode: MQCC_WARNING)
+        let commit = instrumentation.begin(.commit)
+        instrumentation.end(commit, .commit, connection: 7)
+
+        // Then
+        let snapshot = instrumentation.snapshot()
+        XCTAssertEqual(snapshot.verbs.map(\.verb), ["MQGET", "MQPUT", "MQCMIT"])
+        let get = try XCTUnwrap(snapshot.verbs.first)
+        XCTAssertEqual(get.calls, 2)
+        XCTAssertEqual(get.failures, 1)
+        XCTAssertEqual(get.bytes, 120)
+
+        XCTAssertEqual(Set(snapshot.connections.map(\.scope)), ["QM1 (hconn 7)"])
+        XCTAssertEqual(snapshot.connections.map(\.calls).reduce(0, +), 4)
+        XCTAssertEqual(snapshot.queues.map(\.id), ["DEV.QUEUE.1|MQGET", "DEV.QUEUE.2|MQPUT"], "Calls without a queue are not in the queue table")
+        XCTAssertEqual(snapshot.queues.last?.warnings, 1)
+
+        let decoded = try JSONDecoder.withISO8601Dates.decode(MQInstrumentationSnapshot.self, from: snapshot.jsonData())
+        XCTAssertEqual(decoded.verbs.map(\.calls), [2, 1, 1])
+        XCTAssertEqual(snapshot.csv().split(separator: "\n").count, 1 + 3 + 3 + 2, "Header, then verb, connection and queue rows")
+
+        // When
+        instrumentation.reset()
+
+        // Then
+        XCTAssertTrue(instrumentation.snapshot().verbs.isEmpty)
+    }
+}
+
+// MARK: - Helpers
+
+private extension JSONDecoder {
+    static var withISO8601Dates: JSONDecoder {
+        let decoder = JSONDecoder()
+        decoder.dateDecodingStrategy = .iso8601
+        return decoder
+    }
+}
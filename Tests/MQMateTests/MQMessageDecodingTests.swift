@@ -0,0 +1,110 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Unit tests for building browsed messages from an MQMD
+final class MQMessageDecodingTests: XCTestCase {
+
+    // MARK: - Helpers
+
+    /// Copy ASCII text into a fixed-size MQCHAR field of a descriptor
+    private func setField<T>(_ field: inout T, _ value: String, length: Int) {
+        let chars = value.toMQCharArray(length: length)
+        withUnsafeMutablePointer(to: &field) { ptr in
+            let bound = ptr.withMemoryRebound(to: MQCHAR.self, capacity: length) { $0 }
+            for i in 0..<length {
+                bound[i] = chars[i]
+            }
+        }
+    }
+
+    /// Build a descriptor as MQGET would return it for a browsed message
+    private func makeDescriptor() -> MQMD {
+        var messageDescriptor = MQMD()
+        withUnsafeMutablePointer(to: &messageDescriptor.MsgId) { ptr in
+            let bound = ptr.withMemoryRebound(to: UInt8.self, capacity: Int(MQ_MSG_ID_LENGTH)) { $0 }
+            for i in 0..<Int(MQ_MSG_ID_LENGTH) {
+                bound[i] = UInt8(i)
+            }
+        }
+        setField(&messageDescriptor.Format, "MQSTR", length: Int(MQ_FORMAT_LENGTH))
+        setField(&messageDescriptor.PutApplName, "OrderService", length: Int(MQ_PUT_APPL_NAME_LENGTH))
+        setField(&messageDescriptor.ReplyToQ, "DEV.REPLY", length: Int(MQ_Q_NAME_LENGTH))
+        setField(&messageDescriptor.PutDate, "20240115", length: Int(MQ_PUT_DATE_LENGTH))
+        setField(&messageDescriptor.PutTime, "10304500", length: Int(MQ_PUT_TIME_LENGTH))
+        messageDescriptor.MsgType = MQMT_REQUEST
+        messageDescriptor.Persistence = MQPER_PERSISTENT
+        messageDescriptor.Priority = 7
+        return messageDescriptor
+    }
+
+    // MARK: - Decoding Tests
+
+    func testDescriptorFieldsAreDecoded() {
+        // Given
+        let messageDescriptor = makeDescriptor()
+        let token = [UInt8](repeating: 0xAB, count: Int(MQ_MSG_TOKEN_LENGTH))
+
+        // When
+        let message = MQService.MQMessage(
+            messageDescriptor: messageDescriptor,
+            payload: Data("Hello".utf8),
+            messageToken: token,
+            position: 3
+        )
+
+        // Then
+        XCTAssertEqual(message.messageId, (0..<24).map { UInt8($0) })
+        XCTAssertEqual(message.format, "MQSTR")
+        XCTAssertEqual(message.putApplicationName, "OrderService")
+        XCTAssertEqual(message.replyToQueue, "DEV.REPLY")
+        XCTAssertEqual(message.messageType, .request)
+        XCTAssertEqual(message.persistence, .persistent)
+        XCTAssertEqual(message.priority, 7)
+        XCTAssertEqual(message.payloadString, "Hello")
+        XCTAssertEqual(message.messageToken, token)
+        XCTAssertEqual(message.position, 3)
+    }
+
+    func testPutDateTimeIsParsedAsUTC() {
+        // Given
+        let messageDescriptor = makeDescriptor()
+
+        // When
+        let message = MQService.MQMessage(messageDescriptor: messageDescriptor, payload: Data(), position: 0)
+
+        // Then
+        var calendar = Calendar(identifier: .gregorian)
+        calendar.timeZone = TimeZone(identifier: "UTC")!
+        let expected = calendar.date(from: DateComponents(year: 2024, month: 1, day: 15, hour: 10, minute: 30, second: 45))
+        XCTAssertEqual(message.putDateTime, expected)
+    }
+
+    func testTotalLengthMarksTruncatedPayload() {
+        // Given
+        let messageDescriptor = makeDescriptor()
+
+        // When
+        let preview = MQService.MQMessage(messageDescriptor: messageDescriptor, payload: Data("Hel".utf8), totalLength: 5, position: 0)
+        let complete = MQService.MQMessage(messageDescriptor: messageDescriptor, payload: Data("Hello".utf8), position: 0)
+
+        // Then
+        XCTAssertTrue(preview.isTruncated)
+        XCTAssertEqual(preview.totalLength, 5)
+        XCTAssertFalse(complete.isTruncated)
+        XCTAssertEqual(complete.totalLength, 5)
+    }
+
+    func testMissingPutDateTimeIsNil() {
+        // Given
+        var messageDescriptor = makeDescriptor()
+        setField(&messageDescriptor.PutDate, "", length: Int(MQ_PUT_DATE_LENGTH))
+
+        // When
+        let message = MQService.MQMessage(messageDescriptor: messageDescriptor, payload: Data(), position: 0)
+
+        // Then
+        XCTAssertNil(message.putDateTime)
+        XCTAssertTrue(message.messageToken.isEmpty)
+    }
+}
@@ -0,0 +1,310 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Tests of MQService against the in-process MQI simulator: PCF listing, browse and purge
+/// without a queue manager. Skipped when the IBM MQ client is installed
+@MainActor
+final class MQSimulatorTests: XCTestCase {
+
+    var mqService: MQService!
+
+    override func setUp() async throws {
+        try await super.setUp()
+        try XCTSkipUnless(mqmate_sim_enable("QM1"), "MQI calls go to the IBM MQ client")
+        mqService = MQService()
+        try await mqService.connect(
+            queueManager: "QM1",
+            channel: "DEV.APP.SVRCONN",
+            host: "localhost",
+            port: 1414,
+            username: nil,
+            password: nil
+        )
+    }
+
+    override func tearDown() async throws {
+        mqService?.disconnect()
+        mqService = nil
+        mqmate_sim_disable()
+        try await super.tearDown()
+    }
+
+    // MARK: - Helpers
+
+    private func putMessages(_ text: String, count: Int32, on queueName: String) {
+        let payload = Array(text.utf8)
+        XCTAssertEqual(mqmate_sim_put_messages(queueName, count, payload, MQLONG(payload.count), nil), MQRC_NONE)
+    }
+
+    private func waitUntil(_ condition: () -> Bool) async throws {
+        let deadline = Date().addingTimeInterval(2)
+        while !condition() {
+            guard Date() < deadline else {
+                return XCTFail("Timed out waiting for the simulator")
+            }
+            try await Task.sleep(nanoseconds: 10_000_000)
+        }
+    }
+
+    // MARK: - Command Server Tests
+
+    func testCreatedQueuesAreListedWithTheirDepth() async throws {
+        // Given
+        try await mqService.createQueue(queueName: "APP.ORDERS", queueType: .local, maxDepth: 20_000)
+        XCTAssertEqual(mqmate_sim_define_queue("APP.INVOICES", MQQT_LOCAL, 0), MQRC_NONE)
+        putMessages("order", count: 3, on: "APP.ORDERS")
+
+        // When
+        let queues = try await mqService.listQueues(filter: "APP.*")
+
+        // Then
+        XCTAssertEqual(queues.map(\.name), ["APP.INVOICES", "APP.ORDERS"], "Responses come sorted by name")
+        let orders = try XCTUnwrap(queues.last)
+        XCTAssertEqual(orders.queueType, .local)
+        XCTAssertEqual(orders.currentDepth, 3)
+        XCTAssertEqual(orders.maxDepth, 20_000)
+        XCTAssertEqual(mqmate_sim_queue_depth("SYSTEM.ADMIN.COMMAND.QUEUE"), 0, "The command server consumed each request")
+    }
+
+    func testCreatingAnExistingQueueFails() async throws {
+        // Given
+        try await mqService.createQueue(queueName: "APP.ORDERS", queueType: .local, maxDepth: nil)
+
+        // When / Then
+        do {
+            try await mqService.createQueue(queueName: "APP.ORDERS", queueType: .local, maxDepth: nil)
+            XCTFail("Expected the second create to fail")
+        } catch MQError.operationFailed(_, let completionCode, let reasonCode) {
+            XCTAssertEqual(completionCode, MQCC_FAILED)
+            XCTAssertEqual(reasonCode, MQRC_OBJECT_ALREADY_EXISTS)
+        }
+    }
+
+    func testUnansweredCommandFailsRatherThanEndingTheResponses() async throws {
+        // Given - a command server that never answers
+        mqmate_sim_set_command_server_running(false)
+        let connection = try await MQConnection.connect(
+            queueManager: "QM1",
+            channel: "DEV.APP.SVRCONN",
+            host: "localhost",
+            port: 1414,
+            username: nil,
+            password: nil
+        )
+        defer { connection.disconnect() }
+        var command = PCFCommand(command: MQCMD_INQUIRE_Q)
+        command.appendString(parameter: MQCA_Q_NAME, value: "*", length: Int(MQ_Q_NAME_LENGTH))
+
+        // When / Then
+        do {
+            try await connection.perform { connection in
+                try connection.commandSession().execute(command, waitInterval: 100) { _ in
+                    XCTFail("No response was sent")
+                }
+            }
+            XCTFail("Expected the reply wait to fail")
+        } catch MQError.operationFailed(_, let completionCode, let reasonCode) {
+            XCTAssertEqual(completionCode, MQCC_FAILED)
+            XCTAssertEqual(reasonCode, MQRC_NO_MSG_AVAILABLE, "A timed-out wait is not the end of the response set")
+        }
+    }
+
+    // MARK: - Message Tests
+
+    func testBrowseThenPurgeEmptiesTheQueue() async throws {
+        // Given
+        XCTAssertEqual(mqmate_sim_define_queue("APP.EVENTS", MQQT_LOCAL, 0), MQRC_NONE)
+        putMessages("event", count: 25, on: "APP.EVENTS")
+        let messageId = try await mqService.sendMessage(queueName: "APP.EVENTS", payload: Data("last".utf8))
+
+        // When
+        let messages = try await mqService.browseMessages(queueName: "APP.EVENTS", maxMessages: 100)
+        let removed = try await mqService.purgeQueue(queueName: "APP.EVENTS")
+
+        // Then
+        XCTAssertEqual(messages.count, 26)
+        XCTAssertEqual(messages.first?.payload, Data("event".utf8))
+        XCTAssertEqual(messages.last?.messageId, messageId, "Messages are browsed in the order they were put")
+        XCTAssertEqual(messages.last?.format, "MQSTR")
+        XCTAssertEqual(removed, 26)
+        XCTAssertEqual(mqmate_sim_queue_depth("APP.EVENTS"), 0)
+        XCTAssertGreaterThan(mqmate_sim_call_count(MQMATE_SIM_CALL_GET), 0)
+    }
+
+    func testBrowsesConvertPayloadsUnlessTheConnectionTurnsItOff() async throws {
+        // Given
+        XCTAssertEqual(mqmate_sim_define_queue("APP.EVENTS", MQQT_LOCAL, 0), MQRC_NONE)
+        putMessages("event", count: 3, on: "APP.EVENTS")
+
+        for converts in [true, false] {
+            // When
+            mqService.setBrowseDataConversion(converts)
+            var browsed = 0
+            for try await page in mqService.browseMessageStream(queueName: "APP.EVENTS", pageSize: 10) {
+                browsed += page.count
+            }
+
+            // Then
+            XCTAssertEqual(browsed, 3)
+            XCTAssertEqual(mqmate_sim_last_get_options() & MQGMO_CONVERT != 0, converts)
+            mqService.closeBrowseCursor(queueName: "APP.EVENTS")
+        }
+    }
+
+    func testDrainingAQueueLeavesNoInputHandleOpen() async throws {
+        // Given
+        XCTAssertEqual(mqmate_sim_define_queue("APP.EVENTS", MQQT_LOCAL, 0), MQRC_NONE)
+        putMessages("event", count: 10, on: "APP.EVENTS")
+
+        // When - destructive gets open the queue for input
+        let purge = try await mqService.purgeQueue(
+            queueName: "APP.EVENTS",
+            options: MQService.PurgeOptions(strategy: .destructiveGet, batchSize: 4),
+            progress: nil
+        )
+
+        // Then - an input handle left open would show in IPPROCS and block exclusive opens
+        XCTAssertEqual(purge.removedCount, 10)
+        let queues = try await mqService.listQueues(filter: "APP.EVENTS")
+        let info = try XCTUnwrap(queues.first)
+        XCTAssertEqual(info.openInputCount, 0)
+    }
+
+    // MARK: - Browse Cursor Tests
+
+    private func putNumberedMessages(_ count: Int, on queueName: String) {
+        XCTAssertEqual(mqmate_sim_define_queue(queueName, MQQT_LOCAL, 0), MQRC_NONE)
+        for index in 0..<count {
+            putMessages("message \(index)", count: 1, on: queueName)
+        }
+    }
+
+    private func texts(of messages: [MQService.MQMessage]) -> [String] {
+        return messages.map { String(decoding: $0.payload, as: UTF8.self) }
+    }
+
+    func testPagesContinueFromTheCursorUntilTheQueueEnds() async throws {
+        // Given
+        putNumberedMessages(10, on: "APP.EVENTS")
+
+        // When
+        let first = try await mqService.browseMessages(queueName: "APP.EVENTS", maxMessages: 4)
+        let getsForFirstPage = mqmate_sim_call_count(MQMATE_SIM_CALL_GET)
+        let second = try await mqService.browseNextMessages(queueName: "APP.EVENTS", maxMessages: 4)
+        let getsForSecondPage = mqmate_sim_call_count(MQMATE_SIM_CALL_GET) - getsForFirstPage
+        let last = try await mqService.browseNextMessages(queueName: "APP.EVENTS", maxMessages: 4)
+        let beyond = try await mqService.browseNextMessages(queueName: "APP.EVENTS", maxMessages: 4)
+
+        // Then
+        XCTAssertEqual(texts(of: first), (0..<4).map { "message \($0)" })
+        XCTAssertEqual(texts(of: second), (4..<8).map { "message \($0)" })
+        XCTAssertEqual(second.map(\.position), Array(4..<8))
+        XCTAssertEqual(getsForSecondPage, 4, "The next page does not read the first one again")
+        XCTAssertEqual(texts(of: last), ["message 8", "message 9"])
+        XCTAssertTrue(beyond.isEmpty)
+    }
+
+    func testFirstPageRestartsFromTheStartOfTheQueue() async throws {
+        // Given
+        putNumberedMessages(6, on: "APP.EVENTS")
+        _ = try await mqService.browseMessages(queueName: "APP.EVENTS", maxMessages: 4)
+        _ = try await mqService.browseNextMessages(queueName: "APP.EVENTS", maxMessages: 4)
+        putMessages("message 6", count: 1, on: "APP.EVENTS")
+
+        // When
+        let restarted = try await mqService.browseMessages(queueName: "APP.EVENTS", maxMessages: 10)
+
+        // Then
+        XCTAssertEqual(texts(of: restarted), (0..<7).map { "message \($0)" }, "A restart also sees messages put since")
+        XCTAssertEqual(restarted.map(\.position), Array(0..<7))
+    }
+
+    func testPagingContinuesWhenTheMessageUnderTheCursorIsRemoved() async throws {
+        // Given - the cursor rests on message 2
+        putNumberedMessages(6, on: "APP.EVENTS")
+        let first = try await mqService.browseMessages(queueName: "APP.EVENTS", maxMessages: 3)
+        let underCursor = try XCTUnwrap(first.last)
+
+        // When
+        try await mqService.deleteMessage(queueName: "APP.EVENTS", messageId: underCursor.messageId)
+        let next = try await mqService.browseNextMessages(queueName: "APP.EVENTS", maxMessages: 10)
+
+        // Then
+        XCTAssertEqual(texts(of: next), ["message 3", "message 4", "message 5"])
+    }
+
+    func testClosedCursorStartsAgainAtTheFirstMessage() async throws {
+        // Given
+        putNumberedMessages(5, on: "APP.EVENTS")
+        _ = try await mqService.browseMessages(queueName: "APP.EVENTS", maxMessages: 3)
+
+        // When
+        mqService.closeBrowseCursor(queueName: "APP.EVENTS")
+        let next = try await mqService.browseNextMessages(queueName: "APP.EVENTS", maxMessages: 2)
+
+        // Then
+        XCTAssertEqual(texts(of: next), ["message 0", "message 1"])
+        XCTAssertEqual(next.map(\.position), [0, 1])
+    }
+
+    func testCursorOfARestartedQueueManagerFailsAsConnectionLost() async throws {
+        // Given
+        putNumberedMessages(5, on: "APP.EVENTS")
+        _ = try await mqService.browseMessages(queueName: "APP.EVENTS", maxMessages: 3)
+
+        // When - the queue manager restarts, so the connection and its browse handle are gone
+        mqmate_sim_disable()
+        XCTAssertTrue(mqmate_sim_enable("QM1"))
+
+        // Then
+        do {
+            _ = try await mqService.browseNextMessages(queueName: "APP.EVENTS", maxMessages: 3)
+            XCTFail("Expected the stale cursor to fail")
+        } catch let error as MQError {
+            XCTAssertTrue(error.isConnectionLost, "\(error)")
+            XCTAssertTrue(error.invalidatesObjectHandle)
+        }
+    }
+
+    // MARK: - Live Tail Tests
+
+    func testBrowseTailDeliversOnlyMessagesPutAfterItStarts() async throws {
+        // Given
+        XCTAssertEqual(mqmate_sim_define_queue("APP.EVENTS", MQQT_LOCAL, 0), MQRC_NONE)
+        putMessages("old", count: 5, on: "APP.EVENTS")
+        var tail = mqService.tailMessageStream(queueName: "APP.EVENTS", mode: .browse).makeAsyncIterator()
+        try await waitUntil { mqmate_sim_call_count(MQMATE_SIM_CALL_CTL) > 0 }
+
+        // When
+        putMessages("new", count: 2, on: "APP.EVENTS")
+        var received: [MQService.MQMessage] = []
+        while received.count < 2, let batch = try await tail.next() {
+            received += batch
+        }
+
+        // Then
+        XCTAssertEqual(received.map(\.payload), [Data("new".utf8), Data("new".utf8)])
+        XCTAssertEqual(received.map(\.position), [5, 6], "Positions continue after the skipped messages")
+        XCTAssertEqual(mqmate_sim_queue_depth("APP.EVENTS"), 7, "A browse tail removes nothing")
+    }
+
+    func testTailCoalescesABurstIntoFewBatches() async throws {
+        // Given
+        XCTAssertEqual(mqmate_sim_define_queue("APP.EVENTS", MQQT_LOCAL, 0), MQRC_NONE)
+        var tail = mqService.tailMessageStream(queueName: "APP.EVENTS", mode: .destructive).makeAsyncIterator()
+        try await waitUntil { mqmate_sim_call_count(MQMATE_SIM_CALL_CTL) > 0 }
+
+        // When
+        putMessages("burst", count: 50, on: "APP.EVENTS")
+        var batches: [[MQService.MQMessage]] = []
+        while batches.joined().count < 50, let batch = try await tail.next() {
+            batches.append(batch)
+        }
+
+        // Then
+        XCTAssertEqual(batches.joined().count, 50)
+        XCTAssertLessThan(batches.count, 50, "Arrivals within a frame are handed on together")
+        XCTAssertEqual(mqmate_sim_queue_depth("APP.EVENTS"), 0)
+    }
+}
@@ -0,0 +1,65 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Unit tests for the MQMD template shared by the messages of one send
+final class MessageDescriptorTemplateTests: XCTestCase {
+
+    // MARK: - Helpers
+
+    private func bytes<T>(of value: T) -> [UInt8] {
+        var value = value
+        return withUnsafeBytes(of: &value) { Array($0) }
+    }
+
+    // MARK: - Descriptor Tests
+
+    func testDescriptorSetsMessageFields() {
+        // Given
+        var template = MessageDescriptorTemplate()
+
+        // When
+        let descriptor = template.descriptor(
+            messageType: .request,
+            persistence: .persistent,
+            priority: nil,
+            correlationId: [0x01, 0x02],
+            replyToQueue: "DEV.REPLY"
+        )
+
+        // Then
+        XCTAssertEqual(descriptor.Version, MQMD_VERSION_2)
+        XCTAssertEqual(bytes(of: descriptor.Format), Array("MQSTR   ".utf8))
+        XCTAssertEqual(descriptor.MsgType, MQService.MQMessageType.request.mqValue)
+        XCTAssertEqual(descriptor.Persistence, MQService.MQMessagePersistence.persistent.rawValue)
+        XCTAssertEqual(descriptor.Priority, -1, "No priority uses the queue default")
+        XCTAssertEqual(bytes(of: descriptor.CorrelId), [0x01, 0x02] + [UInt8](repeating: 0, count: 22))
+        XCTAssertEqual(Array(bytes(of: descriptor.ReplyToQ).prefix(9)), Array("DEV.REPLY".utf8))
+    }
+
+    func testDescriptorsDoNotInheritPreviousMessage() {
+        // Given
+        var template = MessageDescriptorTemplate()
+        _ = template.descriptor(
+            messageType: .request,
+            persistence: .persistent,
+            priority: 5,
+            correlationId: [UInt8](repeating: 0xFF, count: 24),
+            replyToQueue: "DEV.REPLY"
+        )
+
+        // When
+        let descriptor = template.descriptor(
+            messageType: .datagram,
+            persistence: .notPersistent,
+            priority: nil,
+            correlationId: nil,
+            replyToQueue: nil
+        )
+
+        // Then
+        XCTAssertEqual(descriptor.Priority, -1)
+        XCTAssertEqual(bytes(of: descriptor.CorrelId), [UInt8](repeating: 0, count: 24))
+        XCTAssertEqual(bytes(of: descriptor.ReplyToQ), [UInt8](repeating: 0, count: 48))
+    }
+}
@@ -0,0 +1,50 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Unit tests for parsing the message filter bar into server-side criteria and free text
+final class MessageFilterTests: XCTestCase {
+
+    // MARK: - ID Tests
+
+    func testMessageIdIsPaddedToFullLength() {
+        // When
+        let filter = MessageFilter(searchText: "msgid:0A0B")
+
+        // Then
+        XCTAssertEqual(filter.selector.messageId, [0x0A, 0x0B] + [UInt8](repeating: 0, count: 22))
+        XCTAssertEqual(filter.selector.matchOptions, MQMO_MATCH_MSG_ID)
+        XCTAssertEqual(filter.text, "")
+    }
+
+    func testMalformedIdStaysFreeText() {
+        // When
+        let filter = MessageFilter(searchText: "correlid:XYZ order")
+
+        // Then
+        XCTAssertFalse(filter.hasServerCriteria)
+        XCTAssertEqual(filter.text, "correlid:XYZ order")
+    }
+
+    // MARK: - Selection String Tests
+
+    func testDescriptorTermsCompileToOneSelector() {
+        // When
+        let filter = MessageFilter(searchText: "type:request invoice priority:5")
+
+        // Then
+        XCTAssertEqual(filter.selector.selectionString, "Root.MQMD.MsgType = 1 AND Root.MQMD.Priority = 5")
+        XCTAssertEqual(filter.text, "invoice", "Free text is matched on the client")
+    }
+
+    func testWhereTakesTheRestOfTheText() {
+        // When
+        let filter = MessageFilter(searchText: "format:mqstr where: region = 'EU' AND amount > 100")
+
+        // Then
+        XCTAssertEqual(
+            filter.selector.selectionString,
+            "Root.MQMD.Format = 'MQSTR   ' AND (region = 'EU' AND amount > 100)"
+        )
+    }
+}
@@ -0,0 +1,98 @@
+import XCTest
+@testable import MQMate
+
+/// Unit tests for the message list index: lookups, maintained sort orders and narrowing filters
+final class MessageListIndexTests: XCTestCase {
+
+    // MARK: - Helpers
+
+    /// Build messages with distinct IDs, consecutive positions and the given payloads
+    private func makeMessages(_ payloads: [String], startingAt start: Int = 0) -> MessageStore {
+        MessageStore(payloads.enumerated().map { offset, payload in
+            var messageId = [UInt8](repeating: 0, count: 24)
+            messageId[23] = UInt8(start + offset)
+            return Message(
+                messageId: messageId,
+                correlationId: [UInt8](repeating: 0, count: 24),
+                format: "MQSTR",
+                payload: Data(payload.utf8),
+                putDateTime: nil,
+                putApplicationName: "Test",
+                position: start + offset
+            )
+        })
+    }
+
+    // MARK: - Sort Tests
+
+    func testAppendedRowsAreMergedIntoBuiltOrder() {
+        // Given
+        var messages = makeMessages(["ccc", "a", "bbbbb"])
+        var index = MessageListIndex()
+        index.reset(messages)
+        _ = index.displayMessages(in: messages, searchText: "", serverSelector: .init(), sortOrder: .sizeAscending)
+
+        // When
+        for message in makeMessages(["bb", "dddddd"], startingAt: 3) {
+            messages.append(message)
+        }
+        index.appendRows(in: messages)
+        let sorted = index.displayMessages(in: messages, searchText: "", serverSelector: .init(), sortOrder: .sizeAscending)
+
+        // Then
+        XCTAssertEqual(sorted.map(\.payloadSize), [1, 2, 3, 5, 6])
+        XCTAssertEqual(index.row(forPosition: 4), 4)
+    }
+
+    func testDescendingOrderKeepsRowOrderForEqualKeys() {
+        // Given - two pairs of equal sizes
+        var messages = makeMessages(["aa", "b", "cc", "d"])
+        var index = MessageListIndex()
+        index.reset(messages)
+
+        // When - sorted largest first, before and after an append
+        let sorted = index.displayMessages(in: messages, searchText: "", serverSelector: .init(), sortOrder: .size)
+        for message in makeMessages(["ee"], startingAt: 4) {
+            messages.append(message)
+        }
+        index.appendRows(in: messages)
+        let merged = index.displayMessages(in: messages, searchText: "", serverSelector: .init(), sortOrder: .size)
+
+        // Then
+        XCTAssertEqual(sorted.map(\.position), [0, 2, 1, 3])
+        XCTAssertEqual(merged.map(\.position), [0, 2, 4, 1, 3])
+    }
+
+    // MARK: - Filter Tests
+
+    func testLongerTextNarrowsAndShorterTextWidens() {
+        // Given
+        let messages = makeMessages(["order 1", "order 12", "invoice 1", "order 2"])
+        var index = MessageListIndex()
+        index.reset(messages)
+
+        // When
+        let narrowed = index.displayMessages(in: messages, searchText: "order 1", serverSelector: .init(), sortOrder: .position)
+        let narrower = index.displayMessages(in: messages, searchText: "order 12", serverSelector: .init(), sortOrder: .position)
+        let widened = index.displayMessages(in: messages, searchText: "1", serverSelector: .init(), sortOrder: .position)
+
+        // Then
+        XCTAssertEqual(narrowed.map(\.position), [0, 1])
+        XCTAssertEqual(narrower.map(\.position), [1])
+        XCTAssertEqual(widened.map(\.position), [0, 1, 2], "A shorter text must rescan, not narrow")
+    }
+
+    func testDisplayIndexFollowsSortOrder() {
+        // Given
+        let messages = makeMessages(["a", "b", "c"])
+        var index = MessageListIndex()
+        index.reset(messages)
+
+        // When
+        _ = index.displayMessages(in: messages, searchText: "", serverSelector: .init(), sortOrder: .positionDescending)
+
+        // Then
+        XCTAssertEqual(index.displayIndex(ofId: messages[0].id), 2)
+        XCTAssertEqual(index.displayIndex(ofId: messages[2].id), 0)
+    }
+}
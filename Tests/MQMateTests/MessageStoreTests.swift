@@ -0,0 +1,107 @@
+import XCTest
+@testable import MQMate
+
+/// Unit tests for the columnar message store: row round trips, id lookups, payload updates and spilling
+final class MessageStoreTests: XCTestCase {
+
+    // MARK: - Helpers
+
+    /// Build a message whose MsgId ends with the given byte
+    private func makeMessage(_ idByte: UInt8, payload: String, payloadLength: Int? = nil, position: Int) -> Message {
+        var messageId = [UInt8](repeating: 0x41, count: 24)
+        messageId[23] = idByte
+        return Message(
+            messageId: messageId,
+            correlationId: [UInt8](repeating: idByte, count: 24),
+            format: "MQSTR",
+            payload: Data(payload.utf8),
+            payloadLength: payloadLength,
+            putDateTime: Date(timeIntervalSinceReferenceDate: 1_000 + Double(position)),
+            putApplicationName: "OrderService",
+            messageType: .request,
+            persistence: .persistent,
+            priority: 7,
+            replyToQueue: "REPLY.Q",
+            replyToQueueManager: "QM1",
+            messageSequenceNumber: 3,
+            position: position
+        )
+    }
+
+    // MARK: - Tests
+
+    func testRowsRoundTripAndAreFoundById() {
+        // Given
+        let messages = [
+            makeMessage(1, payload: "first", position: 0),
+            makeMessage(2, payload: "second", position: 1)
+        ]
+
+        // When
+        let store = MessageStore(messages)
+
+        // Then
+        XCTAssertEqual(Array(store), messages)
+        XCTAssertEqual(store.row(forId: messages[1].id), 1)
+        XCTAssertNil(store.row(forId: "00"), "A malformed id must not match a row")
+    }
+
+    func testReplacedPayloadAndRemovedRowsKeepOtherRowsIntact() {
+        // Given
+        var store = MessageStore([
+            makeMessage(1, payload: "pre", payloadLength: 8, position: 0),
+            makeMessage(2, payload: "other", position: 1),
+            makeMessage(3, payload: "last", position: 2)
+        ])
+
+        // When
+        store.replacePayload(at: 0, with: Data("complete".utf8), payloadLength: 8)
+        store.removeAll(messageId: store[1].messageId)
+
+        // Then
+        XCTAssertEqual(store.count, 2)
+        XCTAssertEqual(store[0].payloadString, "complete")
+        XCTAssertFalse(store[0].isPayloadTruncated)
+        XCTAssertEqual(store[1].payloadString, "last")
+        XCTAssertEqual(store.row(forId: store[1].id), 1, "Rows after a removed one move up")
+    }
+
+    func testTotalsFollowAppendsReplacementsAndRemovals() {
+        // Given
+        var store = MessageStore(Message.samples)
+        func assertTotalsMatchRows() {
+            XCTAssertEqual(store.totalPayloadSize, store.reduce(0) { $0 + Int64($1.payloadSize) })
+            XCTAssertEqual(store.persistentCount, store.filter { $0.persistence == .persistent }.count)
+            XCTAssertEqual(store.requestCount, store.filter { $0.messageType == .request }.count)
+        }
+        assertTotalsMatchRows()
+
+        // When
+        store.append(makeMessage(9, payload: "pre", payloadLength: 100, position: store.count))
+        store.replacePayload(at: 0, with: Data(repeating: 0x20, count: 2_000), payloadLength: 2_000)
+        store.removeAll(messageId: store[1].messageId)
+
+        // Then
+        assertTotalsMatchRows()
+        XCTAssertEqual(store.persistence(at: store.count - 1), .persistent)
+        XCTAssertEqual(store.messageType(at: store.count - 1), .request)
+    }
+
+    func testPayloadsOverThresholdOrBudgetAreSpilledAndReadBack() {
+        // Given
+        let policy = PayloadSpillPolicy(payloadThreshold: 100, memoryBudget: 10)
+        let large = String(repeating: "x", count: 200)
+
+        // When
+        let store = MessageStore([
+            makeMessage(1, payload: "small", position: 0),
+            makeMessage(2, payload: large, position: 1),
+            makeMessage(3, payload: "over budget", position: 2)
+        ], spillPolicy: policy)
+
+        // Then
+        XCTAssertEqual(store.residentPayloadBytes, 5, "Only the first small payload fits the budget")
+        XCTAssertEqual(store[1].payloadString, large)
+        XCTAssertEqual(store[2].payloadString, "over budget")
+    }
+}
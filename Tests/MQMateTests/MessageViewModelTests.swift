@@ -0,0 +1,263 @@
+import XCTest
+@testable import MQMate
+
+/// Unit tests for MessageViewModel browsing, paging, filtering, tailing and sending
+@MainActor
+final class MessageViewModelTests: XCTestCase {
+
+    // MARK: - Properties
+
+    private var mockMQService: MockMQService!
+    private var viewModel: MessageViewModel!
+
+    // MARK: - Setup
+
+    override func setUp() async throws {
+        try await super.setUp()
+        mockMQService = MockMQService()
+        mockMQService.isConnected = true
+        viewModel = MessageViewModel(mqService: mockMQService)
+        viewModel.maxMessagesToLoad = 100
+    }
+
+    override func tearDown() async throws {
+        viewModel = nil
+        mockMQService = nil
+        try await super.tearDown()
+    }
+
+    // MARK: - Helpers
+
+    /// Build simulated messages with distinct IDs and consecutive positions
+    private func makeMessages(count: Int) -> [MQService.MQMessage] {
+        (0..<count).map { index in
+            var messageId = [UInt8](repeating: 0, count: 24)
+            messageId[22] = UInt8(index / 256)
+            messageId[23] = UInt8(index % 256)
+            return MQService.MQMessage(
+                messageId: messageId,
+                correlationId: [UInt8](repeating: 0, count: 24),
+                format: "MQSTR",
+                payload: Data("Message \(index)".utf8),
+                putDateTime: nil,
+                putApplicationName: "Test",
+                messageType: .datagram,
+                persistence: .notPersistent,
+                priority: 0,
+                replyToQueue: "",
+                replyToQueueManager: "",
+                messageSequenceNumber: 1,
+                position: index
+            )
+        }
+    }
+
+    // MARK: - Browse Tests
+
+    func testBrowseLoadsOneWindow() async throws {
+        // Given
+        mockMQService.simulatedMessages["DEV.QUEUE.1"] = makeMessages(count: 250)
+
+        // When
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+
+        // Then
+        XCTAssertEqual(viewModel.messages.count, 100)
+        XCTAssertEqual(viewModel.messages.map(\.position), Array(0..<100))
+        XCTAssertTrue(viewModel.hasMoreMessages)
+        XCTAssertFalse(viewModel.isLoading)
+        XCTAssertEqual(viewModel.selectedMessageId, viewModel.messages.first?.id)
+    }
+
+    func testBrowseShortQueueHasNoMoreMessages() async throws {
+        // Given
+        mockMQService.simulatedMessages["DEV.QUEUE.1"] = makeMessages(count: 5)
+
+        // When
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+
+        // Then
+        XCTAssertEqual(viewModel.messages.count, 5)
+        XCTAssertFalse(viewModel.hasMoreMessages)
+    }
+
+    func testLoadMoreContinuesWithoutRereading() async throws {
+        // Given
+        mockMQService.simulatedMessages["DEV.QUEUE.1"] = makeMessages(count: 250)
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+        let callsAfterFirstWindow = mockMQService.browseCallCount
+
+        // When
+        try await viewModel.loadMoreMessages()
+
+        // Then
+        XCTAssertEqual(viewModel.messages.count, 200)
+        XCTAssertEqual(viewModel.messages.map(\.position), Array(0..<200))
+        XCTAssertEqual(mockMQService.browseCallCount, callsAfterFirstWindow + 1, "Only the next page should be read")
+
+        // When - the remaining messages
+        try await viewModel.loadMoreMessages()
+
+        // Then
+        XCTAssertEqual(viewModel.messages.count, 250)
+        XCTAssertFalse(viewModel.hasMoreMessages)
+    }
+
+    func testBrowseFailureSetsError() async {
+        // Given
+        mockMQService.isConnected = false
+
+        // When/Then
+        do {
+            try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+            XCTFail("Should have thrown")
+        } catch {
+            XCTAssertNotNil(viewModel.lastError)
+            XCTAssertTrue(viewModel.showErrorAlert)
+            XCTAssertFalse(viewModel.isLoading)
+        }
+    }
+
+    func testClearMessagesStopsPaging() async throws {
+        // Given
+        mockMQService.simulatedMessages["DEV.QUEUE.1"] = makeMessages(count: 250)
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+
+        // When
+        viewModel.clearMessages()
+        try await viewModel.loadMoreMessages()
+
+        // Then
+        XCTAssertTrue(viewModel.messages.isEmpty)
+        XCTAssertFalse(viewModel.hasMoreMessages)
+    }
+
+    // MARK: - Filter Tests
+
+    func testApplyFilterBrowsesOnlyMatchingMessage() async throws {
+        // Given
+        mockMQService.simulatedMessages["DEV.QUEUE.1"] = makeMessages(count: 250)
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+        viewModel.searchText = "msgid:" + String(repeating: "00", count: 22) + "0096"
+
+        // When
+        try await viewModel.applyFilter()
+
+        // Then
+        XCTAssertTrue(viewModel.isServerFiltered)
+        XCTAssertEqual(viewModel.messages.map(\.position), [150], "The match lies beyond the first window")
+        XCTAssertFalse(viewModel.hasMoreMessages)
+    }
+
+    func testRejectedSelectorIsNotKeptForLaterRefreshes() async throws {
+        // Given
+        mockMQService.simulatedMessages["DEV.QUEUE.1"] = makeMessages(count: 10)
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+        viewModel.searchText = "where: Root.MQMD.Priority > 4"
+
+        // When - the mock, like a queue manager given a bad selection string, rejects it
+        do {
+            try await viewModel.applyFilter()
+            XCTFail("Expected the selection string to be rejected")
+        } catch {
+            XCTAssertNotNil(viewModel.lastError)
+        }
+
+        // Then
+        XCTAssertFalse(viewModel.isServerFiltered, "The previous selector is back in place")
+        try await viewModel.refresh()
+        XCTAssertEqual(viewModel.messages.count, 10)
+    }
+
+    func testServerSelectorIsDroppedWhenTheQueueChanges() async throws {
+        // Given
+        mockMQService.simulatedMessages["DEV.QUEUE.1"] = makeMessages(count: 250)
+        mockMQService.simulatedMessages["DEV.QUEUE.2"] = makeMessages(count: 3)
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+        viewModel.searchText = "msgid:" + String(repeating: "00", count: 22) + "0096"
+        try await viewModel.applyFilter()
+        XCTAssertTrue(viewModel.isServerFiltered)
+
+        // When
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.2")
+
+        // Then
+        XCTAssertFalse(viewModel.isServerFiltered)
+        XCTAssertEqual(viewModel.messages.count, 3)
+    }
+
+    // MARK: - Tail Tests
+
+    func testBrowsingAnotherQueueStopsTail() async throws {
+        // Given
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+        viewModel.startTail(mode: .browse)
+        XCTAssertEqual(viewModel.tailMode, .browse)
+
+        // When
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.2")
+
+        // Then
+        XCTAssertFalse(viewModel.isTailing, "The tail belongs to the list it appended to")
+    }
+
+    // MARK: - Send Tests
+
+    func testSendMessagesReportsEveryBatch() async throws {
+        // Given
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+        let payloads = (0..<5).map { Data("message \($0)".utf8) }
+        var reportedStartIndexes: [Int] = []
+
+        // When
+        let results = try await viewModel.sendMessages(
+            payloads: payloads,
+            messageType: .datagram,
+            persistence: .notPersistent,
+            priority: 0,
+            commitInterval: 2
+        ) { result in
+            reportedStartIndexes.append(result.startIndex)
+        }
+
+        // Then
+        XCTAssertEqual(results.map(\.startIndex), [0, 2, 4])
+        XCTAssertEqual(results.map(\.messageCount), [2, 2, 1])
+        XCTAssertTrue(results.allSatisfy(\.isCommitted))
+        XCTAssertEqual(results.flatMap(\.messageIds).count, 5)
+        XCTAssertEqual(reportedStartIndexes, [0, 2, 4])
+    }
+
+    // MARK: - Bulk Operation Tests
+
+    func testMoveRemovesMovedAndMissingMessagesLocallyAndAuditsEveryBatch() async throws {
+        // Given
+        let auditService = MockAuditService()
+        viewModel = MessageViewModel(mqService: mockMQService, auditService: auditService)
+        let messages = makeMessages(count: 10)
+        mockMQService.simulatedMessages["DEV.QUEUE.1"] = messages
+        try await viewModel.browseMessages(queueName: "DEV.QUEUE.1")
+        let browseCount = mockMQService.browseCallCount
+
+        // One selected message is consumed by someone else before the move
+        mockMQService.simulatedMessages["DEV.QUEUE.1"]?.removeAll { $0.messageId == messages[4].messageId }
+        let selectedIds = messages[2..<7].map(\.messageId)
+
+        // When
+        let results = try await viewModel.processMessages(
+            messageIds: selectedIds,
+            action: .move(toQueue: "DEV.QUEUE.2"),
+            commitInterval: 2
+        )
+
+        // Then
+        XCTAssertEqual(results.map(\.startIndex), [0, 2, 4])
+        XCTAssertEqual(results.flatMap(\.processedIds).count, 4)
+        XCTAssertEqual(results.flatMap(\.missingIds), [messages[4].messageId])
+        XCTAssertEqual(viewModel.messages.map(\.position), [0, 1, 7, 8, 9])
+        XCTAssertEqual(mockMQService.simulatedMessages["DEV.QUEUE.2"]?.count, 4)
+        XCTAssertEqual(mockMQService.browseCallCount, browseCount, "The list is updated without browsing again")
+        XCTAssertEqual(auditService.logCallCount, 3, "One audit entry per committed batch")
+        XCTAssertTrue(auditService.hasLogged(actionType: .messagesMoved))
+    }
+}
@@ -882,6 +882,41 @@ final class ModelTests: XCTestCase {
         XCTAssertFalse(message.payloadSizeFormatted.isEmpty)
     }
 
+    func testMessageTruncatedPayloadPreview() {
+        // Given - the first 4 bytes of a 10 KB message
+        let message = Message(
+            messageId: Array(repeating: 0x41, count: 24),
+            correlationId: Array(repeating: 0, count: 24),
+            format: "MQSTR",
+            payload: Data("Test".utf8),
+            payloadLength: 10_240,
+            putDateTime: nil,
+            putApplicationName: "Test"
+        )
+
+        // Then
+        XCTAssertTrue(message.isPayloadTruncated)
+        XCTAssertEqual(message.payloadSize, 10_240, "Size should report the full message")
+        XCTAssertEqual(message.payloadString, "Test")
+    }
+
+    func testMessageTruncatedPreviewSplitsMultiByteCharacter() {
+        // Given - a preview cut after the first byte of "é" (0xC3 0xA9)
+        let message = Message(
+            messageId: Array(repeating: 0x41, count: 24),
+            correlationId: Array(repeating: 0, count: 24),
+            format: "MQSTR",
+            payload: Data([0x63, 0x61, 0x66, 0xC3]),
+            payloadLength: 100,
+            putDateTime: nil,
+            putApplicationName: "Test"
+        )
+
+        // Then
+        XCTAssertEqual(message.payloadString, "caf")
+        XCTAssertFalse(message.isBinaryPayload)
+    }
+
     func testMessageBinaryPayloadDetection() {
         // Given
         let binaryPayload = Data([0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07])
@@ -1255,8 +1290,8 @@ final class ModelTests: XCTestCase {
         XCTAssertEqual(MQQueueType.local.rawValue, 1)
         XCTAssertEqual(MQQueueType.alias.rawValue, 3)
         XCTAssertEqual(MQQueueType.remote.rawValue, 6)
-        XCTAssertEqual(MQQueueType.model.rawValue, 7)
-        XCTAssertEqual(MQQueueType.cluster.rawValue, 8)
+        XCTAssertEqual(MQQueueType.model.rawValue, 2)
+        XCTAssertEqual(MQQueueType.cluster.rawValue, 7)
     }
 
     func testMQQueueTypeInitFromRawValue() {
@@ -1264,8 +1299,8 @@ final class ModelTests: XCTestCase {
         XCTAssertEqual(MQQueueType(rawValue: 1), .local)
         XCTAssertEqual(MQQueueType(rawValue: 3), .alias)
         XCTAssertEqual(MQQueueType(rawValue: 6), .remote)
-        XCTAssertEqual(MQQueueType(rawValue: 7), .model)
-        XCTAssertEqual(MQQueueType(rawValue: 8), .cluster)
+        XCTAssertEqual(MQQueueType(rawValue: 2), .model)
+        XCTAssertEqual(MQQueueType(rawValue: 7), .cluster)
         XCTAssertEqual(MQQueueType(rawValue: 999), .unknown)
     }
 
@@ -1288,4 +1323,52 @@ final class ModelTests: XCTestCase {
         XCTAssertFalse(MQQueueType.cluster.systemImageName.isEmpty)
         XCTAssertFalse(MQQueueType.unknown.systemImageName.isEmpty)
     }
+
+    // MARK: - ConnectionConfig Read-Ahead Tests
+
+    func testConnectionConfigDecodesWithoutReadAhead() throws {
+        // Given - a configuration saved before read-ahead existed
+        var object = try JSONSerialization.jsonObject(
+            with: JSONEncoder().encode(ConnectionConfig.sample)
+        ) as! [String: Any]
+        object.removeValue(forKey: "readAheadDepth")
+        let data = try JSONSerialization.data(withJSONObject: object)
+
+        // When
+        let config = try JSONDecoder().decode(ConnectionConfig.self, from: data)
+
+        // Then
+        XCTAssertNil(config.readAheadDepth)
+        XCTAssertEqual(config.queueManager, ConnectionConfig.sample.queueManager)
+    }
+
+    func testConnectionConfigKeepsBrowseSettingsWhenSaved() throws {
+        // Given
+        var config = ConnectionConfig.sample
+        config.readAheadDepth = 50
+        config.convertsBrowsedData = false
+
+        // When
+        let decoded = try JSONDecoder().decode(ConnectionConfig.self, from: JSONEncoder().encode(config))
+
+        // Then
+        XCTAssertEqual(decoded.readAheadDepth, 50)
+        XCTAssertEqual(decoded.convertsBrowsedData, false)
+        XCTAssertEqual(config.duplicate().convertsBrowsedData, false)
+    }
+
+    func testConnectionConfigRejectsNegativeReadAhead() {
+        // Given
+        var config = ConnectionConfig.sample
+        config.readAheadDepth = -1
+
+        // Then
+        XCTAssertTrue(config.validate().errors.contains(.readAheadDepthInvalid))
+
+        // When
+        config.readAheadDepth = 1000
+
+        // Then
+        XCTAssertTrue(config.isValid)
+    }
 }
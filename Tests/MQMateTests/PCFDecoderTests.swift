@@ -0,0 +1,216 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Unit tests for the in-place PCF decoder and the PCF command encoder
+final class PCFDecoderTests: XCTestCase {
+
+    // MARK: - Helpers
+
+    /// Encode MQLONG values as raw bytes
+    private func bytes(_ values: [MQLONG]) -> [UInt8] {
+        return values.withUnsafeBytes { Array($0) }
+    }
+
+    /// Build a PCF response header
+    private func responseHeader(
+        control: MQLONG = MQCFC_LAST,
+        compCode: MQLONG = MQCC_OK,
+        reason: MQLONG = MQRC_NONE,
+        parameterCount: MQLONG
+    ) -> [UInt8] {
+        return bytes([
+            MQCFT_RESPONSE, MQCFH_STRUC_LENGTH, MQCFH_VERSION_1, MQCMD_INQUIRE_Q,
+            1, control, compCode, reason, parameterCount
+        ])
+    }
+
+    /// Build an MQCFST parameter with a blank-padded value
+    private func stringParameter(_ parameter: MQLONG, _ value: String, length: Int) -> [UInt8] {
+        var result = bytes([MQCFT_STRING, MQCFST_STRUC_LENGTH_FIXED + MQLONG(length), parameter, 1208, MQLONG(length)])
+        result.append(contentsOf: value.toMQCharArray(length: length).map { UInt8(bitPattern: $0) })
+        return result
+    }
+
+    /// Decode a message and collect its parameters
+    private func withResponse<T>(_ message: [UInt8], _ body: (PCFResponse) throws -> T) rethrows -> T? {
+        return try message.withUnsafeBytes { raw in
+            guard let response = PCFResponse(bytes: raw) else {
+                return nil
+            }
+            return try body(response)
+        }
+    }
+
+    // MARK: - Header Tests
+
+    func testHeaderFields() {
+        // Given
+        let message = responseHeader(control: MQCFC_NOT_LAST, compCode: MQCC_FAILED, reason: 2085, parameterCount: 0)
+
+        // When
+        let fields = withResponse(message) { response in
+            (response.command, response.control, response.compCode, response.reason, response.isLast)
+        }
+
+        // Then
+        XCTAssertEqual(fields?.0, MQCMD_INQUIRE_Q)
+        XCTAssertEqual(fields?.1, MQCFC_NOT_LAST)
+        XCTAssertEqual(fields?.2, MQCC_FAILED)
+        XCTAssertEqual(fields?.3, 2085)
+        XCTAssertEqual(fields?.4, false)
+    }
+
+    func testTooShortMessageIsRejected() {
+        // Given
+        let message = [UInt8](repeating: 0, count: Int(MQCFH_STRUC_LENGTH) - 1)
+
+        // When/Then
+        XCTAssertNil(withResponse(message) { _ in true }, "A message shorter than MQCFH should not decode")
+    }
+
+    // MARK: - Parameter Tests
+
+    func testIntegerAndStringParameters() {
+        // Given
+        var message = responseHeader(parameterCount: 2)
+        message += stringParameter(MQCA_Q_NAME, "DEV.QUEUE.1", length: Int(MQ_Q_NAME_LENGTH))
+        message += bytes([MQCFT_INTEGER, MQCFIN_STRUC_LENGTH, MQIA_CURRENT_Q_DEPTH, 42])
+
+        // When
+        let decoded = withResponse(message) { response -> (String?, MQLONG?) in
+            var name: String?
+            var depth: MQLONG?
+            for parameter in response.parameters {
+                switch parameter {
+                case .string(MQCA_Q_NAME, let value):
+                    name = value.string
+                    XCTAssertTrue(value.equals("DEV.QUEUE.1"))
+                    XCTAssertFalse(value.equals("DEV.QUEUE"))
+                    XCTAssertEqual(value.codedCharSetId, 1208)
+                case .integer(MQIA_CURRENT_Q_DEPTH, let value):
+                    depth = value
+                default:
+                    XCTFail("Unexpected parameter \(parameter.parameter)")
+                }
+            }
+            return (name, depth)
+        }
+
+        // Then
+        XCTAssertEqual(decoded?.0, "DEV.QUEUE.1", "String should be trimmed of blank padding")
+        XCTAssertEqual(decoded?.1, 42)
+    }
+
+    func testIntegerListParameter() {
+        // Given
+        var message = responseHeader(parameterCount: 1)
+        message += bytes([MQCFT_INTEGER_LIST, MQCFIL_STRUC_LENGTH_FIXED + 12, MQIACF_Q_ATTRS, 3, 3, 15, 20])
+
+        // When
+        let values = withResponse(message) { response -> [MQLONG] in
+            var iterator = response.parameters.makeIterator()
+            guard case .integerList(MQIACF_Q_ATTRS, let list)? = iterator.next() else {
+                return []
+            }
+            return Array(list)
+        }
+
+        // Then
+        XCTAssertEqual(values, [3, 15, 20])
+    }
+
+    func testStringListParameter() {
+        // Given
+        var message = responseHeader(parameterCount: 1)
+        message += bytes([MQCFT_STRING_LIST, MQCFSL_STRUC_LENGTH_FIXED + 16, 3011, 1208, 2, 8])
+        message += Array("Q.ONE   Q.TWO   ".utf8)
+
+        // When
+        let values = withResponse(message) { response -> [String] in
+            var iterator = response.parameters.makeIterator()
+            guard case .stringList(_, let list)? = iterator.next() else {
+                return []
+            }
+            return list.map { $0.string }
+        }
+
+        // Then
+        XCTAssertEqual(values, ["Q.ONE", "Q.TWO"])
+    }
+
+    func testUnknownStructureIsSkipped() {
+        // Given - a byte string (MQCFT_BYTE_STRING = 9) followed by an integer
+        var message = responseHeader(parameterCount: 2)
+        message += bytes([9, 20, 7001, 4]) + [0xAA, 0xBB, 0xCC, 0xDD]
+        message += bytes([MQCFT_INTEGER, MQCFIN_STRUC_LENGTH, MQIA_MAX_Q_DEPTH, 5000])
+
+        // When
+        let parameters = withResponse(message) { response in
+            Array(response.parameters).map { $0.parameter }
+        }
+
+        // Then
+        XCTAssertEqual(parameters, [7001, MQIA_MAX_Q_DEPTH])
+    }
+
+    func testMalformedLengthStopsIteration() {
+        // Given - StrucLength runs past the end of the message
+        var message = responseHeader(parameterCount: 2)
+        message += bytes([MQCFT_INTEGER, MQCFIN_STRUC_LENGTH, MQIA_Q_TYPE, MQQT_LOCAL])
+        message += bytes([MQCFT_INTEGER, 4096, MQIA_MAX_Q_DEPTH, 5000])
+
+        // When
+        let count = withResponse(message) { response in
+            Array(response.parameters).count
+        }
+
+        // Then
+        XCTAssertEqual(count, 1, "Decoding should stop at the first invalid structure")
+    }
+
+    // MARK: - Encoder Tests
+
+    func testCommandEncodingRoundTrip() {
+        // Given
+        var command = PCFCommand(command: MQCMD_INQUIRE_Q)
+        command.appendString(parameter: MQCA_Q_NAME, value: "DEV.*", length: Int(MQ_Q_NAME_LENGTH))
+        command.appendInteger(parameter: MQIA_Q_TYPE, value: MQQT_ALL)
+        command.appendIntegerList(parameter: MQIACF_Q_ATTRS, values: [MQIA_CURRENT_Q_DEPTH, MQIA_MAX_Q_DEPTH])
+
+        // When
+        let message = [UInt8](command.encoded())
+        let decoded = withResponse(message) { response -> (MQLONG, [MQLONG]) in
+            (response.parameterCount, Array(response.parameters).map { $0.parameter })
+        }
+
+        // Then
+        XCTAssertEqual(
+            message.count,
+            Int(MQCFH_STRUC_LENGTH) + Int(MQCFST_STRUC_LENGTH_FIXED) + Int(MQ_Q_NAME_LENGTH)
+                + Int(MQCFIN_STRUC_LENGTH) + Int(MQCFIL_STRUC_LENGTH_FIXED) + 8,
+            "Encoded length should match the sum of the StrucLength fields"
+        )
+        XCTAssertEqual(decoded?.0, 3)
+        XCTAssertEqual(decoded?.1, [MQCA_Q_NAME, MQIA_Q_TYPE, MQIACF_Q_ATTRS])
+    }
+
+    // MARK: - Receive Buffer Tests
+
+    func testReceiveBufferGrowsToPowerOfTwo() {
+        // Given
+        let buffer = PCFReceiveBuffer(capacity: 1024)
+
+        // When
+        buffer.reserve(3000)
+
+        // Then
+        XCTAssertEqual(buffer.capacity, 4096)
+
+        // When - a smaller request does not shrink the buffer
+        buffer.reserve(100)
+
+        // Then
+        XCTAssertEqual(buffer.capacity, 4096)
+    }
+}
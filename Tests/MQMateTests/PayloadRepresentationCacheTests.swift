@@ -0,0 +1,95 @@
+import XCTest
+@testable import MQMate
+
+/// Unit tests for the payload representation cache: decoded values, background decoding and LRU eviction
+@MainActor
+final class PayloadRepresentationCacheTests: XCTestCase {
+
+    // MARK: - Helpers
+
+    /// Build a message with a given ID byte and payload
+    private func makeMessage(id: UInt8, payload: Data) -> Message {
+        var messageId = [UInt8](repeating: 0, count: 24)
+        messageId[23] = id
+        return Message(
+            messageId: messageId,
+            correlationId: [UInt8](repeating: 0, count: 24),
+            format: "MQSTR",
+            payload: payload,
+            putDateTime: nil,
+            putApplicationName: "Test"
+        )
+    }
+
+    // MARK: - Representation Tests
+
+    func testRepresentationMatchesMessageProperties() throws {
+        // Given
+        let cache = PayloadRepresentationCache()
+        let json = makeMessage(id: 1, payload: Data("\n  {\"b\": 1, \"a\": [true]}\n".utf8))
+        let binary = makeMessage(id: 2, payload: Data((0..<10_000).map { UInt8(truncatingIfNeeded: $0) }))
+
+        // When
+        let representation = try XCTUnwrap(cache.representation(for: json))
+        let pages = (0..<PayloadRepresentation.hexDumpPageCount(byteCount: binary.payload.count))
+            .map { cache.hexDumpPage($0, of: binary) }
+
+        // Then
+        XCTAssertEqual(representation.text, json.payloadString)
+        XCTAssertEqual(representation.isBinary, json.isBinaryPayload)
+        XCTAssertEqual(representation.preview, json.payloadPreview)
+        XCTAssertEqual(representation.linePreview, "{\"b\": 1, \"a\": [true]}")
+        XCTAssertEqual(cache.formattedJSON(for: json), "{\n  \"a\" : [\n    true\n  ],\n  \"b\" : 1\n}")
+        XCTAssertEqual(pages.count, 3)
+        XCTAssertEqual(pages.joined(separator: "\n"), binary.payloadHexDump, "Pages continue each other's offsets")
+    }
+
+    func testLargePayloadIsDecodedInTheBackground() async throws {
+        // Given
+        let cache = PayloadRepresentationCache(inlineDecodeLimit: 1_024)
+        let message = makeMessage(id: 1, payload: Data(String(repeating: "line\n", count: 1_000).utf8))
+
+        // When
+        let first = cache.representation(for: message)
+        var decoded: PayloadRepresentation?
+        for _ in 0..<500 where decoded == nil {
+            try await Task.sleep(nanoseconds: 10_000_000)
+            decoded = cache.representation(for: message)
+        }
+
+        // Then
+        XCTAssertNil(first, "A large payload is not decoded on the calling thread")
+        XCTAssertEqual(decoded?.linePreview, "line")
+        XCTAssertEqual(cache.revision, 1)
+        XCTAssertEqual(cache.count, 1)
+    }
+
+    // MARK: - Eviction Tests
+
+    func testLeastRecentlyUsedEntriesAreEvictedPastTheMemoryLimit() {
+        // Given - each entry costs about 960 bytes
+        let cache = PayloadRepresentationCache(memoryLimit: 3_000)
+        let messages = (1...4).map { makeMessage(id: UInt8($0), payload: Data(String(repeating: "A", count: 500).utf8)) }
+        for message in messages.prefix(3) {
+            _ = cache.representation(for: message)
+        }
+        XCTAssertEqual(cache.count, 3)
+
+        // When
+        _ = cache.representation(for: messages[0])
+        _ = cache.representation(for: messages[3])
+
+        // Then
+        XCTAssertEqual(cache.count, 2, "Evicted down to three quarters of the limit")
+        XCTAssertLessThanOrEqual(cache.totalCost, 3_000 / 4 * 3)
+        _ = cache.representation(for: messages[0])
+        XCTAssertEqual(cache.count, 2, "The entry used again was kept")
+
+        // When
+        cache.removeAll()
+
+        // Then
+        XCTAssertEqual(cache.count, 0)
+        XCTAssertEqual(cache.totalCost, 0)
+    }
+}
@@ -0,0 +1,86 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Unit tests for the queue archive format: round trips, compression and indexed seeks
+final class QueueArchiveTests: XCTestCase {
+
+    // MARK: - Properties
+
+    private var archiveURL: URL!
+
+    // MARK: - Setup
+
+    override func setUp() {
+        super.setUp()
+        archiveURL = FileManager.default.temporaryDirectory
+            .appendingPathComponent("QueueArchiveTests-\(UUID().uuidString).mqarchive")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: archiveURL)
+        super.tearDown()
+    }
+
+    // MARK: - Helpers
+
+    /// Write records whose priority is their index and whose payload is large enough to span blocks
+    private func writeArchive(count: Int, compressed: Bool) throws {
+        let writer = try QueueArchiveWriter(url: archiveURL, compressed: compressed)
+        for index in 0..<count {
+            var descriptor = MQMD()
+            descriptor.Version = MQMD_VERSION_2
+            descriptor.Priority = MQLONG(index)
+            try writer.append(QueueArchive.Record(
+                descriptor: descriptor,
+                payload: Data(repeating: UInt8(index % 256), count: 100 * 1024)
+            ))
+        }
+        try writer.finish()
+    }
+
+    // MARK: - Tests
+
+    func testRecordsRoundTripAcrossBlocks() throws {
+        // Given
+        try writeArchive(count: 25, compressed: false)
+
+        // When
+        let reader = try QueueArchiveReader(url: archiveURL)
+        let records = try reader.blocks.indices.flatMap { try reader.records(inBlock: $0) }
+
+        // Then
+        XCTAssertEqual(reader.messageCount, 25)
+        XCTAssertGreaterThan(reader.blocks.count, 1, "1 MB blocks must split 2.5 MB of payloads")
+        XCTAssertEqual(records.map { Int($0.descriptor.Priority) }, Array(0..<25))
+        XCTAssertEqual(records[7].payload, Data(repeating: 7, count: 100 * 1024))
+    }
+
+    func testCompressedArchiveSeeksThroughIndex() throws {
+        // Given
+        try writeArchive(count: 25, compressed: true)
+
+        // When
+        let reader = try QueueArchiveReader(url: archiveURL)
+        let records = try reader.records(from: 17)
+
+        // Then
+        let fileSize = try FileManager.default.attributesOfItem(atPath: archiveURL.path)[.size] as? Int ?? 0
+        XCTAssertLessThan(fileSize, 25 * 100 * 1024 / 10, "Repeated bytes must compress")
+        XCTAssertEqual(records.first.map { Int($0.descriptor.Priority) }, 17)
+        XCTAssertTrue(try reader.records(from: 25).isEmpty)
+    }
+
+    func testUnfinishedArchiveIsRejected() throws {
+        // Given
+        let writer = try QueueArchiveWriter(url: archiveURL, compressed: false)
+        try writer.append(QueueArchive.Record(descriptor: MQMD(), payload: Data("partial".utf8)))
+
+        // When / Then
+        XCTAssertThrowsError(try QueueArchiveReader(url: archiveURL)) { error in
+            guard case MQError.invalidConfiguration = error else {
+                return XCTFail("Expected invalidConfiguration, got \(error)")
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+import XCTest
+@testable import MQMate
+
+/// Unit tests for the depth monitor: ring-buffer history, differential updates and adaptive polling
+@MainActor
+final class QueueDepthMonitorTests: XCTestCase {
+
+    // MARK: - History Tests
+
+    func testHistoryWrapsAndKeepsNewestSamples() {
+        // Given
+        var history = QueueDepthHistory(capacity: 3)
+        let start = Date(timeIntervalSinceReferenceDate: 0)
+
+        // When
+        for (second, depth) in [Int32(10), 20, 30, 40].enumerated() {
+            history.append(QueueDepthHistory.Sample(time: start.addingTimeInterval(Double(second)), depth: depth))
+        }
+
+        // Then
+        XCTAssertEqual(history.count, 3)
+        XCTAssertEqual(history.depths, [20, 30, 40], "The oldest sample is overwritten")
+        XCTAssertEqual(history.rate ?? 0, 10, accuracy: 0.001)
+    }
+
+    // MARK: - Polling Tests
+
+    func testOnlyChangedQueuesArePublishedAndPolledSooner() async throws {
+        // Given
+        let mockMQService = MockMQService()
+        mockMQService.isConnected = true
+        let monitor = QueueDepthMonitor(
+            mqService: mockMQService,
+            policy: QueueDepthMonitor.Policy(minimumInterval: 2, maximumInterval: 60)
+        )
+        let start = Date(timeIntervalSinceReferenceDate: 0)
+        monitor.track(mockMQService.simulatedQueues.map { Queue(name: $0.name, depth: $0.currentDepth) }, from: start)
+
+        // When
+        let idle = try await monitor.poll(at: start.addingTimeInterval(2))
+        mockMQService.simulatedQueues[0] = MQService.QueueInfo(name: "DEV.QUEUE.1", queueType: .local, currentDepth: 9)
+        let changed = try await monitor.poll(at: start.addingTimeInterval(6))
+        _ = try await monitor.poll(at: start.addingTimeInterval(8))
+
+        // Then
+        XCTAssertTrue(idle.isEmpty)
+        XCTAssertEqual(changed.map(\.name), ["DEV.QUEUE.1"])
+        XCTAssertEqual(changed.first?.depth, 9)
+        XCTAssertEqual(
+            mockMQService.depthInquiryFilters,
+            ["DEV.QUEUE.*", "DEV.QUEUE.*", "DEV.QUEUE.1"],
+            "Idle queues back off, so the last tick asks for the changed queue only"
+        )
+        XCTAssertEqual(monitor.histories["DEV.QUEUE.1"]?.depths, [5, 9, 9])
+        XCTAssertEqual(monitor.histories["DEV.QUEUE.2"]?.count, 2)
+    }
+
+    func testMonitorStartedWithoutLocalQueuesPollsOnceQueuesAreTracked() async throws {
+        // Given - a first listing without local queues ends the loop
+        let mockMQService = MockMQService()
+        mockMQService.isConnected = true
+        let monitor = QueueDepthMonitor(
+            mqService: mockMQService,
+            policy: QueueDepthMonitor.Policy(minimumInterval: 0.1, maximumInterval: 1)
+        )
+        monitor.start(with: [])
+        try await waitUntil { !monitor.isRunning }
+
+        // When
+        monitor.start(with: mockMQService.simulatedQueues.map { Queue(name: $0.name, depth: $0.currentDepth) })
+        try await waitUntil { !mockMQService.depthInquiryFilters.isEmpty }
+
+        // Then
+        XCTAssertTrue(monitor.isRunning)
+        XCTAssertEqual(mockMQService.depthInquiryFilters.first, "DEV.QUEUE.*")
+        monitor.stop()
+    }
+
+    func testFilterCoversDueQueuesWithTheirCommonPrefix() {
+        XCTAssertEqual(QueueDepthMonitor.filter(covering: ["APP.IN"]), "APP.IN")
+        XCTAssertEqual(QueueDepthMonitor.filter(covering: ["APP.IN", "APP.OUT"]), "APP.*")
+        XCTAssertEqual(QueueDepthMonitor.filter(covering: ["APP.IN", "DEV.QUEUE.1"]), "*")
+    }
+
+    // MARK: - Helpers
+
+    /// Wait up to two seconds for a condition set by the polling loop
+    private func waitUntil(_ condition: () -> Bool) async throws {
+        let deadline = Date().addingTimeInterval(2)
+        while !condition() {
+            guard Date() < deadline else {
+                return XCTFail("Timed out waiting for the polling loop")
+            }
+            try await Task.sleep(nanoseconds: 10_000_000)
+        }
+    }
+}
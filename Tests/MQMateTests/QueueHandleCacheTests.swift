@@ -0,0 +1,98 @@
+import XCTest
+import CMQC
+@testable import MQMate
+
+/// Unit tests for the LRU queue handle cache
+final class QueueHandleCacheTests: XCTestCase {
+
+    // MARK: - Helpers
+
+    private func key(_ queueName: String, _ options: MQLONG = MQOO_OUTPUT) -> QueueHandleCache.Key {
+        return QueueHandleCache.Key(queueName: queueName, options: options)
+    }
+
+    // MARK: - Lookup Tests
+
+    func testCachedHandleIsReturned() {
+        // Given
+        var cache = QueueHandleCache(capacity: 4)
+        XCTAssertEqual(cache.insert(101, for: key("DEV.QUEUE.1")), [])
+
+        // When/Then
+        XCTAssertEqual(cache.handle(for: key("DEV.QUEUE.1")), 101)
+        XCTAssertNil(cache.handle(for: key("DEV.QUEUE.1", MQOO_INQUIRE)), "Options are part of the key")
+        XCTAssertNil(cache.handle(for: key("DEV.QUEUE.2")))
+    }
+
+    // MARK: - Eviction Tests
+
+    func testLeastRecentlyUsedHandleIsEvicted() {
+        // Given
+        var cache = QueueHandleCache(capacity: 2)
+        _ = cache.insert(101, for: key("DEV.QUEUE.1"))
+        _ = cache.insert(102, for: key("DEV.QUEUE.2"))
+
+        // When - using queue 1 makes queue 2 the eviction candidate
+        _ = cache.handle(for: key("DEV.QUEUE.1"))
+        let released = cache.insert(103, for: key("DEV.QUEUE.3"))
+
+        // Then
+        XCTAssertEqual(released, [102])
+        XCTAssertEqual(cache.count, 2)
+        XCTAssertEqual(cache.handle(for: key("DEV.QUEUE.1")), 101)
+        XCTAssertNil(cache.handle(for: key("DEV.QUEUE.2")))
+    }
+
+    func testReplacingAKeyReleasesTheOldHandle() {
+        // Given
+        var cache = QueueHandleCache(capacity: 2)
+        _ = cache.insert(101, for: key("DEV.QUEUE.1"))
+
+        // When
+        let released = cache.insert(201, for: key("DEV.QUEUE.1"))
+
+        // Then
+        XCTAssertEqual(released, [101])
+        XCTAssertEqual(cache.handle(for: key("DEV.QUEUE.1")), 201)
+    }
+
+    func testZeroCapacityDisablesCaching() {
+        // Given
+        var cache = QueueHandleCache(capacity: 0)
+
+        // When
+        let released = cache.insert(101, for: key("DEV.QUEUE.1"))
+
+        // Then
+        XCTAssertEqual(released, [101], "The caller closes the handle right away")
+        XCTAssertEqual(cache.count, 0)
+    }
+
+    func testOnlyNonInputHandlesAreCacheable() {
+        // Then
+        XCTAssertTrue(QueueHandleCache.isCacheable(options: MQOO_INQUIRE | MQOO_FAIL_IF_QUIESCING))
+        XCTAssertTrue(QueueHandleCache.isCacheable(options: MQOO_OUTPUT | MQOO_SAVE_ALL_CONTEXT))
+        XCTAssertTrue(QueueHandleCache.isCacheable(options: MQOO_BROWSE))
+        XCTAssertFalse(QueueHandleCache.isCacheable(options: MQOO_INPUT_SHARED | MQOO_FAIL_IF_QUIESCING))
+        XCTAssertFalse(QueueHandleCache.isCacheable(options: MQOO_INPUT_EXCLUSIVE))
+        XCTAssertFalse(QueueHandleCache.isCacheable(options: MQOO_INPUT_AS_Q_DEF | MQOO_BROWSE))
+    }
+
+    // MARK: - Removal Tests
+
+    func testRemoveAllForQueueKeepsOtherQueues() {
+        // Given
+        var cache = QueueHandleCache(capacity: 4)
+        _ = cache.insert(101, for: key("DEV.QUEUE.1", MQOO_OUTPUT))
+        _ = cache.insert(102, for: key("DEV.QUEUE.1", MQOO_INQUIRE))
+        _ = cache.insert(201, for: key("DEV.QUEUE.2"))
+
+        // When
+        let released = cache.removeAll(queueName: "DEV.QUEUE.1")
+
+        // Then
+        XCTAssertEqual(Set(released), [101, 102])
+        XCTAssertEqual(cache.count, 1)
+        XCTAssertEqual(cache.handle(for: key("DEV.QUEUE.2")), 201)
+    }
+}
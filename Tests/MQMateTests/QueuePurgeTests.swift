@@ -0,0 +1,77 @@
+import XCTest
+@testable import MQMate
+
+/// Unit tests for purge settings and purge progress in the queue view model
+@MainActor
+final class QueuePurgeTests: XCTestCase {
+
+    // MARK: - Options Tests
+
+    func testPurgeOptionsDefaults() {
+        // When
+        let options = MQService.PurgeOptions()
+
+        // Then
+        XCTAssertEqual(options.strategy, .automatic)
+        XCTAssertEqual(options.batchSize, 500)
+        XCTAssertEqual(options.parallelism, 1)
+    }
+
+    func testPurgeOptionsClampToOne() {
+        // When
+        let options = MQService.PurgeOptions(strategy: .destructiveGet, batchSize: 0, parallelism: -2)
+
+        // Then
+        XCTAssertEqual(options.batchSize, 1, "Every unit of work removes at least one message")
+        XCTAssertEqual(options.parallelism, 1)
+    }
+
+    func testOnlyUnavailableCommandsFallBackToDraining() {
+        // Given
+        let unanswered = MQError.operationFailed(operation: "PCF command 9", completionCode: 2, reasonCode: MQError.MQRC_NO_MSG_AVAILABLE)
+        let inUse = MQError.operationFailed(operation: "Clear queue", completionCode: 2, reasonCode: MQError.MQRC_OBJECT_IN_USE)
+        let notAuthorized = MQError.operationFailed(operation: "Clear queue", completionCode: 2, reasonCode: MQError.MQRC_NOT_AUTHORIZED)
+        let unknownQueue = MQError.operationFailed(operation: "MQOPEN", completionCode: 2, reasonCode: MQError.MQRC_UNKNOWN_OBJECT_NAME)
+
+        // Then
+        XCTAssertTrue(unanswered.isCommandUnavailable, "No command server answered")
+        XCTAssertTrue(inUse.isCommandUnavailable, "CLEAR is refused while the queue is open")
+        XCTAssertFalse(notAuthorized.isCommandUnavailable)
+        XCTAssertFalse(unknownQueue.isCommandUnavailable)
+        XCTAssertFalse(MQError.connectionBroken.isCommandUnavailable)
+    }
+
+    // MARK: - View Model Tests
+
+    func testPurgeReportsRemovedCount() async throws {
+        // Given
+        let mockMQService = MockMQService()
+        mockMQService.isConnected = true
+        let viewModel = QueueViewModel(mqService: mockMQService)
+
+        // When
+        let result = try await viewModel.purgeQueue(queueName: "DEV.QUEUE.3")
+
+        // Then
+        XCTAssertEqual(result.removedCount, 142)
+        XCTAssertFalse(result.wasCancelled)
+        XCTAssertEqual(viewModel.purgedMessageCount, 142)
+        XCTAssertNil(viewModel.purgingQueueName, "The purge is over")
+    }
+
+    func testFailedPurgeKeepsNoCount() async {
+        // Given
+        let mockMQService = MockMQService()
+        let viewModel = QueueViewModel(mqService: mockMQService)
+
+        // When
+        do {
+            _ = try await viewModel.purgeQueue(queueName: "DEV.QUEUE.3")
+            XCTFail("Purging while disconnected should fail")
+        } catch {
+            // Then
+            XCTAssertEqual(viewModel.purgedMessageCount, 0)
+            XCTAssertTrue(viewModel.showErrorAlert)
+        }
+    }
+}
@@ -0,0 +1,125 @@
+import XCTest
+@testable import MQMate
+
+/// Unit tests for the persisted queue-list snapshots shown before a connection is open
+@MainActor
+final class QueueSnapshotCacheTests: XCTestCase {
+
+    // MARK: - Properties
+
+    private var directory: URL!
+
+    // MARK: - Setup/Teardown
+
+    override func setUp() async throws {
+        try await super.setUp()
+        directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("QueueSnapshotCacheTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDown() async throws {
+        try? FileManager.default.removeItem(at: directory)
+        directory = nil
+        try await super.tearDown()
+    }
+
+    // MARK: - Cache Tests
+
+    func testSavedSnapshotReadsBackEveryQueue() throws {
+        // Given
+        let cache = QueueSnapshotCache(directory: directory)
+        let id = UUID()
+        let savedAt = Date(timeIntervalSinceReferenceDate: 750_000_000.25)
+        let queues = [
+            Queue(name: "APP.REQUEST", queueType: .local, depth: 42, maxDepth: 5000,
+                  getInhibited: true, openInputCount: 2, openOutputCount: 1),
+            Queue(name: "APP.REPLY.ALIAS", queueType: .alias, putInhibited: true),
+            Queue(name: "SYSTEM.ADMIN.COMMAND.QUEUE", queueType: .local, depth: 0, maxDepth: 3000)
+        ]
+
+        // When
+        try cache.save(queues, for: id, at: savedAt)
+        let snapshot = try XCTUnwrap(cache.snapshot(for: id))
+
+        // Then
+        XCTAssertEqual(snapshot.savedAt, savedAt)
+        XCTAssertEqual(snapshot.queues.map(\.name), queues.map(\.name))
+        XCTAssertEqual(snapshot.queues.map(\.queueType), queues.map(\.queueType))
+        XCTAssertEqual(snapshot.queues.map(\.depth), [42, 0, 0])
+        XCTAssertEqual(snapshot.queues.map(\.maxDepth), [5000, 5000, 3000])
+        XCTAssertEqual(snapshot.queues.map(\.getInhibited), [true, false, false])
+        XCTAssertEqual(snapshot.queues.map(\.putInhibited), [false, true, false])
+        XCTAssertEqual(snapshot.queues[0].openInputCount, 2)
+        XCTAssertEqual(snapshot.queues[0].openOutputCount, 1)
+        XCTAssertNil(cache.snapshot(for: UUID()), "Connections never listed have no snapshot")
+    }
+
+    func testTruncatedOrForeignDataIsIgnored() {
+        // Given
+        let data = QueueSnapshotCache.encode([Queue(name: "DEV.QUEUE.1")], savedAt: Date())
+        var foreign = data
+        foreign[0] = UInt8(ascii: "X")
+
+        // Then
+        XCTAssertNotNil(QueueSnapshotCache.decode(data))
+        XCTAssertNil(QueueSnapshotCache.decode(data.prefix(data.count - 1)), "A cut-off name is rejected")
+        XCTAssertNil(QueueSnapshotCache.decode(data.prefix(QueueSnapshotCache.headerLength + 4)))
+        XCTAssertNil(QueueSnapshotCache.decode(foreign), "A file without the magic is rejected")
+    }
+
+    // MARK: - Startup Tests
+
+    func testRefreshedQueuesAreShownAsSnapshotUntilReconciled() async throws {
+        // Given
+        let mockMQService = MockMQService()
+        let manager = ConnectionManager(
+            mqService: mockMQService,
+            keychainService: MockKeychainService(),
+            snapshotCache: QueueSnapshotCache(directory: directory)
+        )
+        let config = ConnectionConfig(name: "Snapshot", queueManager: "QM1", hostname: "localhost", channel: "DEV.APP.SVRCONN")
+        try manager.addConnection(config, password: nil)
+        defer { manager.deleteConnection(id: config.id) }
+        try await manager.connect(id: config.id)
+        let listedNames = manager.queues(for: config.id).map(\.name)
+        manager.disconnect(id: config.id)
+        let viewModel = QueueViewModel(mqService: mockMQService)
+
+        // When
+        let snapshot = try XCTUnwrap(manager.queueSnapshot(for: config.id))
+        viewModel.showSnapshot(snapshot)
+
+        // Then
+        XCTAssertFalse(listedNames.isEmpty)
+        XCTAssertEqual(viewModel.queues.map(\.name), listedNames)
+        XCTAssertEqual(viewModel.snapshotDate, snapshot.savedAt)
+
+        // When
+        try await manager.connect(id: config.id)
+        viewModel.reconcileQueues(manager.queues(for: config.id))
+
+        // Then
+        XCTAssertNil(viewModel.snapshotDate, "Live queues replace the stale ones")
+        XCTAssertEqual(viewModel.queues.map(\.id), snapshot.queues.map(\.id))
+    }
+
+    func testDeletedConnectionKeepsNoSnapshot() async throws {
+        // Given - the disconnect inside the delete saves the queue list once more
+        let manager = ConnectionManager(
+            mqService: MockMQService(),
+            keychainService: MockKeychainService(),
+            snapshotCache: QueueSnapshotCache(directory: directory)
+        )
+        let config = ConnectionConfig(name: "Snapshot", queueManager: "QM1", hostname: "localhost", channel: "DEV.APP.SVRCONN")
+        try manager.addConnection(config, password: nil)
+        try await manager.connect(id: config.id)
+
+        // When
+        manager.deleteConnection(id: config.id)
+        manager.flushSnapshotWrites()
+
+        // Then
+        XCTAssertNil(QueueSnapshotCache(directory: directory).snapshot(for: config.id), "The removal ran after the last save")
+        XCTAssertNil(manager.queueSnapshot(for: config.id))
+    }
+}